@@ -0,0 +1,28 @@
+#include <benchmark/benchmark.h>
+
+#include "core/ring/vcb/vcb_dispatch.hpp"
+
+/**
+ * @brief   基准测试入口
+ * @note    1. 在JSON输出的context中记录默认向量计算后端（自动检测或MPMT_VCB环境变量指定），
+ *             rvector以外的基准均使用该后端；rvector基准按每个可用后端各注册一份，名称带后端后缀。
+ *          2. 常用参数：--benchmark_filter=<regex> --benchmark_out=<file> --benchmark_out_format=json
+ */
+int main(int argc, char** argv)
+{
+    benchmark::AddCustomContext("mpmt_vector_backend", mpmt::vcb_dispatch::name(mpmt::vcb_dispatch::active()));
+#if defined(MPMT_PROFILE)
+    benchmark::AddCustomContext("mpmt_profiler", "on");
+#else
+    benchmark::AddCustomContext("mpmt_profiler", "off");
+#endif
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
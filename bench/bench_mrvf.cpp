@@ -0,0 +1,143 @@
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "core/io/stream_impl/io_stream.hpp"
+#include "core/ring/mrvf/mrvf_handler.hpp"
+
+/**
+ * @brief   mrvf_handler读写的微基准
+ * @note    1. 参数0为向量长度，参数1为读写方式：0文件流，1内存映射，2直接读写（O_DIRECT + io_uring）。
+ *          2. 文件写入当前工作目录，可通过 MPMT_BENCH_DIR 环境变量指定其他目录。
+ *          3. 文件流与内存映射的读基准受页缓存影响，衡量的是解析与校验开销而非磁盘带宽；直接读写每次都访问设备。
+ *          4. bm_mrvf_load_range在1<<24个元素的v2文件中读取参数0个元素，起点逐次移动，对比整体载入的开销。
+ *          5. bm_mrvf_save_compressed比较逐块选择编码的写入开销：参数1为0时写入均匀随机数据（应全部保留RAW），
+ *             为1时写入取值小于1024的计数向量；存储比例以stored_ratio计数器输出。
+ */
+namespace
+{
+    std::string bench_path(const char* tag)
+    {
+        const char* dir = std::getenv("MPMT_BENCH_DIR");
+        return (dir != nullptr ? std::string(dir) + "/" : std::string()) + "mpmt_bench_" + tag + ".mrvf";
+    }
+
+    template <typename RT>
+    typename mpmt::mrvf_handler<RT>::config make_config(int64_t io)
+    {
+        typename mpmt::mrvf_handler<RT>::config cfg{ io == 1, false };
+        cfg.m_use_direct_io = (io == 2);
+        return cfg;
+    }
+
+    template <typename RT>
+    mpmt::mrvf<RT> make_mrvf(uint64_t size)
+    {
+        mpmt::rvector<RT> vec(size);
+        for (uint64_t i = 0; i < size; ++i)
+        {
+            vec[i] = static_cast<RT>(i * 2654435761ULL);
+        }
+        return mpmt::mrvf<RT>(std::move(vec));
+    }
+
+    template <typename RT>
+    void bm_mrvf_save(benchmark::State& state)
+    {
+        const uint64_t c_size = static_cast<uint64_t>(state.range(0));
+        const std::string c_path = bench_path("save");
+        const mpmt::mrvf<RT> obj = make_mrvf<RT>(c_size);
+        mpmt::mrvf_handler<RT> handler(make_config<RT>(state.range(1)));
+        for (auto _ : state)
+        {
+            handler.save(c_path, obj);
+        }
+        std::remove(c_path.c_str());
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0) * sizeof(RT));
+    }
+
+    template <typename RT>
+    void bm_mrvf_load(benchmark::State& state)
+    {
+        const uint64_t c_size = static_cast<uint64_t>(state.range(0));
+        const std::string c_path = bench_path("load");
+        mpmt::mrvf_handler<RT> handler(make_config<RT>(state.range(1)));
+        handler.save(c_path, make_mrvf<RT>(c_size));
+        for (auto _ : state)
+        {
+            mpmt::mrvf<RT> obj = handler.load(c_path);
+            benchmark::DoNotOptimize(obj.m_rvector.data());
+        }
+        std::remove(c_path.c_str());
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0) * sizeof(RT));
+    }
+
+    template <typename RT>
+    void bm_mrvf_save_compressed(benchmark::State& state)
+    {
+        const uint64_t c_size = static_cast<uint64_t>(state.range(0));
+        const std::string c_path = bench_path("compressed");
+        mpmt::rvector<RT> vec(c_size);
+        uint64_t x = 88172645463325252ULL;
+        for (uint64_t i = 0; i < c_size; ++i)
+        {
+            x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+            vec[i] = static_cast<RT>(state.range(1) == 0 ? x : x % 1024);
+        }
+        const mpmt::mrvf<RT> obj(std::move(vec));
+        typename mpmt::mrvf_handler<RT>::config cfg = make_config<RT>(0);
+        cfg.m_compress = true;
+        mpmt::mrvf_handler<RT> handler(cfg);
+        for (auto _ : state)
+        {
+            handler.save(c_path, obj);
+        }
+        {
+            mpmt::io_stream io(c_path, mpmt::io_mode::READ);
+            const mpmt::mrvf_block_file blocks(io, c_path);
+            state.counters["stored_ratio"] = static_cast<double>(blocks.stored_bytes()) / static_cast<double>(c_size * sizeof(RT));
+        }
+        std::remove(c_path.c_str());
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0) * sizeof(RT));
+    }
+
+    template <typename RT>
+    void bm_mrvf_load_range(benchmark::State& state)
+    {
+        constexpr uint64_t c_file_size = 1ULL << 24;
+        const uint64_t c_count = static_cast<uint64_t>(state.range(0));
+        const std::string c_path = bench_path("range");
+        mpmt::mrvf_handler<RT> handler(make_config<RT>(state.range(1)));
+        handler.save(c_path, make_mrvf<RT>(c_file_size));
+        uint64_t first = 0;
+        for (auto _ : state)
+        {
+            mpmt::rvector<RT> vec = handler.load_range(c_path, first, c_count);
+            benchmark::DoNotOptimize(vec.data());
+            first = (first + 7919ULL * 1024ULL) % (c_file_size - c_count);
+        }
+        std::remove(c_path.c_str());
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0) * sizeof(RT));
+    }
+}
+
+BENCHMARK_TEMPLATE(bm_mrvf_save, mpmt::ring32)
+    ->ArgNames({ "size", "io" })->ArgsProduct({ { 1 << 12, 1 << 18, 1 << 24 }, { 0, 1, 2 } })
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(bm_mrvf_save, mpmt::ring64)
+    ->ArgNames({ "size", "io" })->ArgsProduct({ { 1 << 12, 1 << 18, 1 << 24 }, { 0, 1, 2 } })
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(bm_mrvf_load, mpmt::ring32)
+    ->ArgNames({ "size", "io" })->ArgsProduct({ { 1 << 12, 1 << 18, 1 << 24 }, { 0, 1, 2 } })
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(bm_mrvf_load, mpmt::ring64)
+    ->ArgNames({ "size", "io" })->ArgsProduct({ { 1 << 12, 1 << 18, 1 << 24 }, { 0, 1, 2 } })
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(bm_mrvf_load_range, mpmt::ring32)
+    ->ArgNames({ "count", "io" })->ArgsProduct({ { 1 << 12, 1 << 18 }, { 0, 1, 2 } })
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(bm_mrvf_save_compressed, mpmt::ring64)
+    ->ArgNames({ "size", "counts" })->ArgsProduct({ { 1 << 18, 1 << 22 }, { 0, 1 } })
+    ->Unit(benchmark::kMicrosecond);
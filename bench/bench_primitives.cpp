@@ -0,0 +1,69 @@
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "core/crc/crc64.hpp"
+#include "core/rng/openssl_impl/rng_openssl.hpp"
+
+/**
+ * @brief   crc64与rng_openssl的微基准
+ * @note    参数为输入字节数或随机数个数。
+ */
+namespace
+{
+    void bm_crc64_compute(benchmark::State& state)
+    {
+        const uint64_t c_len = static_cast<uint64_t>(state.range(0));
+        std::vector<uint8_t> data(c_len);
+        for (uint64_t i = 0; i < c_len; ++i)
+        {
+            data[i] = static_cast<uint8_t>(i * 131 + 7);
+        }
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(mpmt::crc64::compute(data.data(), c_len));
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+    }
+
+    template <typename DT>
+    void bm_rng_bulk(benchmark::State& state)
+    {
+        const mpmt::rng_openssl<DT> rng;
+        for (auto _ : state)
+        {
+            mpmt::rng_array<DT> rands = rng.rand(static_cast<uint64_t>(state.range(0)));
+            benchmark::DoNotOptimize(rands.m_data.get());
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0) * sizeof(DT));
+    }
+
+    template <typename DT>
+    void bm_rng_bounded(benchmark::State& state)
+    {
+        // 非2的幂的区间长度，覆盖拒绝采样路径
+        const mpmt::rng_openssl<DT> rng;
+        const DT c_lb = 3;
+        const DT c_ub = static_cast<DT>(~DT(0) / 3 * 2);
+        for (auto _ : state)
+        {
+            mpmt::rng_array<DT> rands = rng.rand(c_lb, c_ub, static_cast<uint64_t>(state.range(0)));
+            benchmark::DoNotOptimize(rands.m_data.get());
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0) * sizeof(DT));
+    }
+}
+
+BENCHMARK(bm_crc64_compute)->RangeMultiplier(16)->Range(64, 1 << 26);
+
+BENCHMARK_TEMPLATE(bm_rng_bulk, uint8_t)->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(bm_rng_bulk, uint16_t)->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(bm_rng_bulk, uint32_t)->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(bm_rng_bulk, uint64_t)->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
+
+BENCHMARK_TEMPLATE(bm_rng_bounded, uint8_t)->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(bm_rng_bounded, uint16_t)->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(bm_rng_bounded, uint32_t)->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(bm_rng_bounded, uint64_t)->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
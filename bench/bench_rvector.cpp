@@ -0,0 +1,331 @@
+#include <array>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "core/ring/rvector.hpp"
+#include "core/ring/vcb/vcb_dispatch.hpp"
+#include "core/rng/openssl_impl/rng_openssl.hpp"
+
+/**
+ * @brief   rvector<RT>各运算符的微基准
+ * @note    1. 参数为向量长度。
+ *          2. ring8~ring64的每个基准按当前CPU与构建支持的每个向量计算后端各注册一份，名称后缀为后端名
+ *             （如bm_add_vector<ring32>/avx2/1024），同一次运行即可按后端对比。
+ *          3. ring1不经过向量内核，只注册一份。
+ */
+namespace
+{
+    template <typename RT>
+    mpmt::rvector<RT> random_rvector(uint64_t size)
+    {
+        mpmt::rvector<RT> vec(size);
+        if constexpr (std::is_same_v<RT, mpmt::ring1>)
+        {
+            // ring1每个元素占一字节，取值只能是0或1
+            const mpmt::rng_openssl<uint8_t> rng;
+            const mpmt::rng_array<uint8_t> rands = rng.rand(size);
+            for (uint64_t i = 0; i < size; ++i)
+            {
+                vec[i] = mpmt::ring1(rands.m_data[i]);
+            }
+        }
+        else
+        {
+            const mpmt::rng_openssl<RT> rng;
+            const mpmt::rng_array<RT> rands = rng.rand(size);
+            std::memcpy(vec.data(), rands.m_data.get(), size * sizeof(RT));
+        }
+        return vec;
+    }
+
+    template <typename RT>
+    void set_throughput(benchmark::State& state, uint64_t operands)
+    {
+        const int64_t c_items = static_cast<int64_t>(state.iterations()) * state.range(0);
+        state.SetItemsProcessed(c_items);
+        state.SetBytesProcessed(c_items * static_cast<int64_t>(operands * sizeof(RT)));
+    }
+
+    template <typename RT>
+    void bm_add_vector(benchmark::State& state)
+    {
+        mpmt::rvector<RT> lhs = random_rvector<RT>(state.range(0));
+        const mpmt::rvector<RT> rhs = random_rvector<RT>(state.range(0));
+        for (auto _ : state)
+        {
+            lhs += rhs;
+            benchmark::DoNotOptimize(lhs.data());
+            benchmark::ClobberMemory();
+        }
+        set_throughput<RT>(state, 2);
+    }
+
+    template <typename RT>
+    void bm_add_scalar(benchmark::State& state)
+    {
+        mpmt::rvector<RT> lhs = random_rvector<RT>(state.range(0));
+        for (auto _ : state)
+        {
+            lhs += RT(3);
+            benchmark::DoNotOptimize(lhs.data());
+            benchmark::ClobberMemory();
+        }
+        set_throughput<RT>(state, 1);
+    }
+
+    template <typename RT>
+    void bm_sub_vector(benchmark::State& state)
+    {
+        mpmt::rvector<RT> lhs = random_rvector<RT>(state.range(0));
+        const mpmt::rvector<RT> rhs = random_rvector<RT>(state.range(0));
+        for (auto _ : state)
+        {
+            lhs -= rhs;
+            benchmark::DoNotOptimize(lhs.data());
+            benchmark::ClobberMemory();
+        }
+        set_throughput<RT>(state, 2);
+    }
+
+    template <typename RT>
+    void bm_sub_scalar(benchmark::State& state)
+    {
+        mpmt::rvector<RT> lhs = random_rvector<RT>(state.range(0));
+        for (auto _ : state)
+        {
+            lhs -= RT(3);
+            benchmark::DoNotOptimize(lhs.data());
+            benchmark::ClobberMemory();
+        }
+        set_throughput<RT>(state, 1);
+    }
+
+    template <typename RT>
+    void bm_mul_vector(benchmark::State& state)
+    {
+        mpmt::rvector<RT> lhs = random_rvector<RT>(state.range(0));
+        const mpmt::rvector<RT> rhs = random_rvector<RT>(state.range(0));
+        for (auto _ : state)
+        {
+            lhs *= rhs;
+            benchmark::DoNotOptimize(lhs.data());
+            benchmark::ClobberMemory();
+        }
+        set_throughput<RT>(state, 2);
+    }
+
+    template <typename RT>
+    void bm_mul_scalar(benchmark::State& state)
+    {
+        mpmt::rvector<RT> lhs = random_rvector<RT>(state.range(0));
+        for (auto _ : state)
+        {
+            lhs *= RT(3);
+            benchmark::DoNotOptimize(lhs.data());
+            benchmark::ClobberMemory();
+        }
+        set_throughput<RT>(state, 1);
+    }
+
+    template <typename RT>
+    void bm_equal(benchmark::State& state)
+    {
+        const mpmt::rvector<RT> lhs = random_rvector<RT>(state.range(0));
+        const mpmt::rvector<RT> rhs(lhs);
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(lhs == rhs);
+        }
+        set_throughput<RT>(state, 2);
+    }
+
+    template <typename RT>
+    void bm_reduce(benchmark::State& state)
+    {
+        const mpmt::rvector<RT> vec = random_rvector<RT>(state.range(0));
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(vec.reduce());
+        }
+        set_throughput<RT>(state, 1);
+    }
+
+    template <typename RT>
+    std::vector<mpmt::rvector<RT>> random_terms(uint64_t size, uint64_t count)
+    {
+        std::vector<mpmt::rvector<RT>> terms;
+        for (uint64_t j = 0; j < count; ++j)
+        {
+            terms.push_back(random_rvector<RT>(size));
+        }
+        return terms;
+    }
+
+    template <typename RT>
+    void bm_add_sequential(benchmark::State& state)
+    {
+        // 基线：range(1)个加数逐个operator+=
+        mpmt::rvector<RT> acc = random_rvector<RT>(state.range(0));
+        const std::vector<mpmt::rvector<RT>> terms = random_terms<RT>(state.range(0), state.range(1));
+        for (auto _ : state)
+        {
+            for (const mpmt::rvector<RT>& term : terms)
+            {
+                acc += term;
+            }
+            benchmark::DoNotOptimize(acc.data());
+            benchmark::ClobberMemory();
+        }
+        set_throughput<RT>(state, state.range(1) + 1);
+    }
+
+    template <typename RT>
+    void bm_accumulate(benchmark::State& state)
+    {
+        // range(1)个加数一次融合累加
+        mpmt::rvector<RT> acc = random_rvector<RT>(state.range(0));
+        const std::vector<mpmt::rvector<RT>> terms = random_terms<RT>(state.range(0), state.range(1));
+        std::vector<const mpmt::rvector<RT>*> ptrs;
+        for (const mpmt::rvector<RT>& term : terms)
+        {
+            ptrs.push_back(&term);
+        }
+        for (auto _ : state)
+        {
+            acc.accumulate(ptrs);
+            benchmark::DoNotOptimize(acc.data());
+            benchmark::ClobberMemory();
+        }
+        set_throughput<RT>(state, state.range(1) + 1);
+    }
+
+    template <typename RT>
+    void bm_copy(benchmark::State& state)
+    {
+        const mpmt::rvector<RT> src = random_rvector<RT>(state.range(0));
+        mpmt::rvector<RT> dst(state.range(0));
+        for (auto _ : state)
+        {
+            dst = src;
+            benchmark::DoNotOptimize(dst.data());
+            benchmark::ClobberMemory();
+        }
+        set_throughput<RT>(state, 2);
+    }
+}
+
+namespace
+{
+    using bench_fn = void (*)(benchmark::State&);
+
+    /** @brief 基准运行期间切换到指定后端，结束后恢复，不影响其他基准所用的后端 */
+    class backend_scope
+    {
+    public:
+        explicit backend_scope(mpmt::vcb_isa isa) : mc_previous(mpmt::vcb_dispatch::active())
+        {
+            mpmt::vcb_dispatch::select(isa);
+        }
+
+        ~backend_scope()
+        {
+            mpmt::vcb_dispatch::select(mc_previous);
+        }
+
+        backend_scope(const backend_scope&) = delete;
+        backend_scope& operator=(const backend_scope&) = delete;
+
+    private:
+        const mpmt::vcb_isa mc_previous;
+    };
+
+    /** @brief 当前CPU与构建支持的全部后端，按指令集由低到高 */
+    std::vector<mpmt::vcb_isa> available_backends()
+    {
+        std::vector<mpmt::vcb_isa> backends;
+        for (mpmt::vcb_isa isa : { mpmt::vcb_isa::GENERIC, mpmt::vcb_isa::SSE42, mpmt::vcb_isa::AVX2, mpmt::vcb_isa::AVX512 })
+        {
+            if (mpmt::vcb_dispatch::supported(isa))
+            {
+                backends.push_back(isa);
+            }
+        }
+        return backends;
+    }
+
+    /** @brief 按后端注册一个基准，返回供设置参数的句柄 */
+    benchmark::internal::Benchmark* register_on(const std::string& name, bench_fn fn, mpmt::vcb_isa isa)
+    {
+        const std::string c_name = name + "/" + mpmt::vcb_dispatch::name(isa);
+        return benchmark::RegisterBenchmark(c_name.c_str(), [fn, isa](benchmark::State& state)
+        {
+            const backend_scope c_scope(isa);
+            fn(state);
+        });
+    }
+
+    // 向量长度：2^10 ~ 2^24
+    void sizes(benchmark::internal::Benchmark* b)
+    {
+        b->RangeMultiplier(16)->Range(1 << 10, 1 << 24);
+    }
+
+    // k路累加：向量长度2^16、2^20，加数个数4、16、64
+    void fuse_args(benchmark::internal::Benchmark* b)
+    {
+        b->Args({ 1 << 16, 4 })->Args({ 1 << 16, 16 })->Args({ 1 << 16, 64 })
+            ->Args({ 1 << 20, 4 })->Args({ 1 << 20, 16 })->Args({ 1 << 20, 64 });
+    }
+
+    const char* const c_WORD_RINGS[] = { "ring8", "ring16", "ring32", "ring64" };
+
+    /** @brief 注册一个运算在ring1（一份）与ring8~ring64（每个后端一份）上的基准 */
+    void register_op(const std::string& op, bench_fn ring1_fn, const std::array<bench_fn, 4>& word_fns)
+    {
+        sizes(benchmark::RegisterBenchmark((op + "<ring1>").c_str(), ring1_fn));
+        for (mpmt::vcb_isa isa : available_backends())
+        {
+            for (uint64_t r = 0; r < word_fns.size(); ++r)
+            {
+                sizes(register_on(op + "<" + c_WORD_RINGS[r] + ">", word_fns[r], isa));
+            }
+        }
+    }
+
+    /** @brief 注册k路累加的对比基准（ring32、ring64，每个后端一份） */
+    void register_fuse(const std::string& op, bench_fn ring32_fn, bench_fn ring64_fn)
+    {
+        for (mpmt::vcb_isa isa : available_backends())
+        {
+            fuse_args(register_on(op + "<ring32>", ring32_fn, isa));
+            fuse_args(register_on(op + "<ring64>", ring64_fn, isa));
+        }
+    }
+}
+
+#define MPMT_BENCH_RVECTOR_OP(fn)                                                   \
+    register_op(#fn, fn<mpmt::ring1>, { fn<mpmt::ring8>, fn<mpmt::ring16>, fn<mpmt::ring32>, fn<mpmt::ring64> })
+
+#define MPMT_BENCH_RVECTOR_FUSE(fn)                                                 \
+    register_fuse(#fn, fn<mpmt::ring32>, fn<mpmt::ring64>)
+
+// 在静态初始化阶段注册，与BENCHMARK宏注册的其他基准一同由bench_main运行
+static const bool s_rvector_registered = []
+{
+    MPMT_BENCH_RVECTOR_OP(bm_add_vector);
+    MPMT_BENCH_RVECTOR_OP(bm_add_scalar);
+    MPMT_BENCH_RVECTOR_OP(bm_sub_vector);
+    MPMT_BENCH_RVECTOR_OP(bm_sub_scalar);
+    MPMT_BENCH_RVECTOR_OP(bm_mul_vector);
+    MPMT_BENCH_RVECTOR_OP(bm_mul_scalar);
+    MPMT_BENCH_RVECTOR_OP(bm_equal);
+    MPMT_BENCH_RVECTOR_OP(bm_reduce);
+    MPMT_BENCH_RVECTOR_OP(bm_copy);
+    MPMT_BENCH_RVECTOR_FUSE(bm_add_sequential);
+    MPMT_BENCH_RVECTOR_FUSE(bm_accumulate);
+    return true;
+}();
@@ -0,0 +1,54 @@
+#include <benchmark/benchmark.h>
+
+#include "sim/local_sim.hpp"
+
+/**
+ * @brief   端到端宏基准：编码、分享、合并与查询
+ * @note    1. 参数0为编码向量长度，参数1为环位宽；每个持有方的集合大小取向量长度的1/16。
+ *          2. 各阶段耗时以counters输出（encode_s/merge_s/query_s），总耗时为一次完整模拟的墙钟时间。
+ */
+namespace
+{
+    void bm_share_merge_query(benchmark::State& state)
+    {
+        mpmt::local_sim::config cfg{};
+        cfg.m_num_holders = 4;
+        cfg.m_num_slots = static_cast<uint64_t>(state.range(0));
+        cfg.m_set_size = cfg.m_num_slots / 16;
+        cfg.m_num_hashes = 3;
+        cfg.m_ring_bits = static_cast<uint8_t>(state.range(1));
+        cfg.m_num_queries = 1024;
+        cfg.m_ingest_threads = 0;
+        const mpmt::local_sim sim(cfg);
+
+        double encode_seconds = 0;
+        double merge_seconds = 0;
+        double query_seconds = 0;
+        uint64_t upload_bytes = 0;
+        for (auto _ : state)
+        {
+            const mpmt::local_sim::report rep = sim.run();
+            encode_seconds += rep.m_encode_seconds;
+            merge_seconds += rep.m_merge_seconds;
+            query_seconds += rep.m_query_seconds;
+            upload_bytes = rep.m_holder_upload_bytes;
+        }
+
+        const double c_iters = static_cast<double>(state.iterations());
+        state.counters["encode_s"] = encode_seconds / c_iters;
+        state.counters["merge_s"] = merge_seconds / c_iters;
+        state.counters["query_s"] = query_seconds / c_iters;
+        state.counters["upload_bytes"] = static_cast<double>(upload_bytes);
+        state.counters["queries_per_s"] = benchmark::Counter
+        (
+            static_cast<double>(cfg.m_num_queries) * c_iters / query_seconds
+        );
+    }
+}
+
+BENCHMARK(bm_share_merge_query)
+    ->ArgNames({ "slots", "ring" })
+    ->ArgsProduct({ { 1 << 16, 1 << 20, 1 << 24 }, { 16, 32 } })
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime()
+    ->MeasureProcessCPUTime();
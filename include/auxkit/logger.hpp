@@ -1,15 +1,225 @@
 #ifndef LOGGER_HPP
 #define LOGGER_HPP
 
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <type_traits>
+
+/** @brief 日志级别数值，供编译期过滤使用 */
+#define MPMT_LOG_LEVEL_TRACE    0
+#define MPMT_LOG_LEVEL_DEBUG    1
+#define MPMT_LOG_LEVEL_INFO     2
+#define MPMT_LOG_LEVEL_WARN     3
+#define MPMT_LOG_LEVEL_ERROR    4
+#define MPMT_LOG_LEVEL_OFF      5
+
+/** @brief 编译期最低日志级别，低于该级别的日志宏展开为空 */
+#if !defined(MPMT_LOG_LEVEL)
+    #if defined(MPMT_DEBUG)
+        #define MPMT_LOG_LEVEL MPMT_LOG_LEVEL_DEBUG
+    #else
+        #define MPMT_LOG_LEVEL MPMT_LOG_LEVEL_INFO
+    #endif
+#endif
+
 /** @namespace 辅助工具命名空间。*/
 namespace utils
 {
     /**
      * @class 日志记录
+     * @note  1. 异步结构化日志：调用线程仅将定长记录写入本线程的SPSC环形队列，
+     *           后台线程负责格式化为JSON行并写出，热路径无锁、无系统调用，只读写本线程队列的缓存行；
+     *           队列槽位按段（256条）在首次写到时分配，此外无堆分配。
+     *        2. 队列满时丢弃新记录并计数，不阻塞调用方。线程退出后其队列由写出线程读空后释放，
+     *           反复创建的短生命周期线程不会使队列累积。
+     *        3. 消息、文件名与字段键须为静态字符串（只保存指针）；字段值支持整数、浮点与静态字符串，
+     *           每条记录最多mc_MAX_FIELDS个字段。
+     *        4. 通过MPMT_LOG_<LEVEL>宏记录，低于MPMT_LOG_LEVEL的调用在编译期消除。
+     *        5. fork()出的子进程中没有写出线程，子进程的记录被丢弃；子进程应以_exit()退出。
      */
     class logger
     {
+    public:
+        /** @brief 日志级别（ERR避免与<windows.h>中的ERROR宏冲突） */
+        enum class level : uint8_t
+        {
+            TRACE = MPMT_LOG_LEVEL_TRACE,
+            DEBUG = MPMT_LOG_LEVEL_DEBUG,
+            INFO = MPMT_LOG_LEVEL_INFO,
+            WARN = MPMT_LOG_LEVEL_WARN,
+            ERR = MPMT_LOG_LEVEL_ERROR,
+        };
+
+        /** @brief 结构化字段 */
+        struct field
+        {
+            enum class kind : uint8_t { NONE, INT, UINT, REAL, TEXT };
+
+            const char* m_key;
+            kind m_kind;
+            union
+            {
+                int64_t m_int;
+                uint64_t m_uint;
+                double m_real;
+                const char* m_text;
+            };
+        };
+
+        struct config
+        {
+            std::string m_path;         // 输出文件路径，空表示标准错误
+            level m_min_level;          // 运行期最低级别
+        };
+
+        static constexpr uint32_t mc_MAX_FIELDS = 4;            // 每条记录的最大字段数
+        static constexpr uint64_t mc_QUEUE_CAPACITY = 1 << 12;  // 每线程队列容量（2的幂）
+
+        /**
+         * @brief   启动后台写出线程
+         * @param   const config& cfg 日志配置
+         * @return  bool 是否启动成功（输出文件无法打开时返回false）
+         */
+        static bool start(const config& cfg);
+
+        /**
+         * @brief   写出全部剩余记录并停止后台线程
+         * @return  void
+         * @note    先停止接受新记录并等待进行中的write()完成，再做最后一次读空，stop()之前入队的记录不会丢失。
+         */
+        static void stop();
+
+        /**
+         * @class 日志作用域：析构时调用stop()，保证异常路径上后台线程同样被回收
+         */
+        class scope
+        {
+        public:
+            scope() = default;
+            ~scope() { stop(); }
+            scope(const scope&) = delete;
+            scope& operator=(const scope&) = delete;
+        };
+
+        /**
+         * @brief   记录一条日志（通常经由MPMT_LOG_<LEVEL>宏调用）
+         * @param   level lv 级别
+         * @param   const char* file 源文件
+         * @param   int line 行号
+         * @param   const char* msg 消息
+         * @param   const field* fields 字段数组
+         * @param   uint32_t num_fields 字段个数
+         * @return  void
+         */
+        static void write(level lv, const char* file, int line, const char* msg, const field* fields, uint32_t num_fields) noexcept;
+
+        /**
+         * @brief   获取因队列满而丢弃的记录数
+         * @return  uint64_t 丢弃数
+         */
+        static uint64_t dropped() noexcept;
+
+        /**
+         * @brief   获取全部线程队列已分配的槽位字节数
+         * @return  uint64_t 字节数
+         */
+        static uint64_t queue_bytes() noexcept;
+
+        /**
+         * @brief   构造字段
+         */
+        template <typename VT>
+        static field make_field(const char* key, VT value) noexcept
+        {
+            field f{};
+            f.m_key = key;
+            if constexpr (std::is_floating_point_v<VT>)
+            {
+                f.m_kind = field::kind::REAL;
+                f.m_real = static_cast<double>(value);
+            }
+            else if constexpr (std::is_same_v<VT, bool>)
+            {
+                f.m_kind = field::kind::UINT;
+                f.m_uint = value ? 1 : 0;
+            }
+            else if constexpr (std::is_integral_v<VT> && std::is_signed_v<VT>)
+            {
+                f.m_kind = field::kind::INT;
+                f.m_int = static_cast<int64_t>(value);
+            }
+            else if constexpr (std::is_integral_v<VT> || std::is_enum_v<VT>)
+            {
+                f.m_kind = field::kind::UINT;
+                f.m_uint = static_cast<uint64_t>(value);
+            }
+            else
+            {
+                static_assert(std::is_convertible_v<VT, const char*>, "log field value must be numeric or a static string.");
+                f.m_kind = field::kind::TEXT;
+                f.m_text = value;
+            }
+            return f;
+        }
+
+        /**
+         * @brief   以键值对形式记录
+         */
+        template <typename... KV>
+        static void log(level lv, const char* file, int line, const char* msg, KV... kv) noexcept
+        {
+            static_assert(sizeof...(KV) % 2 == 0, "log fields must be key/value pairs.");
+            static_assert(sizeof...(KV) / 2 <= mc_MAX_FIELDS, "too many log fields.");
+            field fields[mc_MAX_FIELDS + 1]{};
+            uint32_t n = 0;
+            collect(fields, n, kv...);
+            write(lv, file, line, msg, fields, n);
+        }
+
+    private:
+        static void collect(field*, uint32_t&) noexcept {}
+
+        template <typename VT, typename... Rest>
+        static void collect(field* fields, uint32_t& n, const char* key, VT value, Rest... rest) noexcept
+        {
+            fields[n++] = make_field(key, value);
+            collect(fields, n, rest...);
+        }
     };
 }
 
+#define MPMT_LOG_AT(lv, msg, ...) \
+    utils::logger::log(utils::logger::level::lv, __FILE__, __LINE__, msg, ##__VA_ARGS__)
+
+#if MPMT_LOG_LEVEL <= MPMT_LOG_LEVEL_TRACE
+    #define MPMT_LOG_TRACE(msg, ...) MPMT_LOG_AT(TRACE, msg, ##__VA_ARGS__)
+#else
+    #define MPMT_LOG_TRACE(msg, ...) ((void)0)
+#endif
+
+#if MPMT_LOG_LEVEL <= MPMT_LOG_LEVEL_DEBUG
+    #define MPMT_LOG_DEBUG(msg, ...) MPMT_LOG_AT(DEBUG, msg, ##__VA_ARGS__)
+#else
+    #define MPMT_LOG_DEBUG(msg, ...) ((void)0)
+#endif
+
+#if MPMT_LOG_LEVEL <= MPMT_LOG_LEVEL_INFO
+    #define MPMT_LOG_INFO(msg, ...) MPMT_LOG_AT(INFO, msg, ##__VA_ARGS__)
+#else
+    #define MPMT_LOG_INFO(msg, ...) ((void)0)
+#endif
+
+#if MPMT_LOG_LEVEL <= MPMT_LOG_LEVEL_WARN
+    #define MPMT_LOG_WARN(msg, ...) MPMT_LOG_AT(WARN, msg, ##__VA_ARGS__)
+#else
+    #define MPMT_LOG_WARN(msg, ...) ((void)0)
+#endif
+
+#if MPMT_LOG_LEVEL <= MPMT_LOG_LEVEL_ERROR
+    #define MPMT_LOG_ERROR(msg, ...) MPMT_LOG_AT(ERR, msg, ##__VA_ARGS__)
+#else
+    #define MPMT_LOG_ERROR(msg, ...) ((void)0)
+#endif
+
 #endif // !LOGGER_HPP
@@ -1,15 +1,144 @@
 #ifndef PROFILER_HPP
 #define PROFILER_HPP
 
+#include <atomic>
+#include <cstdint>
+#include <string>
+
 /** @namespace 辅助工具命名空间。*/
 namespace utils
 {
     /**
      * @class 性能分析器
+     * @note  1. 通过MPMT_PROF_SCOPE/MPMT_PROF_COUNT宏插桩，未定义MPMT_PROFILE时宏展开为空，零开销。
+     *        2. 每个线程首次记录时注册一块独立的事件缓存区，此后记录只写本线程缓存区，无锁无系统调用；
+     *           缓存区按需分段增长（首段256个事件，上限65536个），写满后丢弃新事件并计数。
+     *        3. 线程退出后其事件保留至导出；没有事件的缓存区立即回收，reset()回收其余已退出线程的缓存区，
+     *           新线程优先接管回收的缓存区，反复创建的线程不会使缓存区无限累积。
+     *        4. 计时基于std::chrono::steady_clock（纳秒），导出为Chrome Trace JSON（chrome://tracing、Perfetto）。
      */
     class profiler
     {
+    public:
+        /** @brief 命名计数器 */
+        enum class counter : uint8_t
+        {
+            BYTES_SENT = 0,         // 通信发送字节数
+            BYTES_RECEIVED,         // 通信接收字节数
+            RNG_BYTES,              // 随机数/伪随机数生成字节数
+            CRC_BYTES,              // CRC64校验字节数
+            RVECTOR_ELEMENTS,       // rvector运算处理的元素数
+            MRVF_RAW_BYTES,         // mrvf v2写入块的原始字节数
+            MRVF_STORED_BYTES,      // mrvf v2写入块编码后的字节数
+            COUNT_                  // 计数器个数（非计数器）
+        };
+
+        /**
+         * @class RAII作用域计时器
+         */
+        class scope
+        {
+        public:
+            explicit scope(const char* name) noexcept : m_name(name), m_begin(now()) {}
+            ~scope() { record(m_name, m_begin, now()); }
+
+        private:
+            const char* m_name;     // 作用域名称（需为静态字符串）
+            uint64_t m_begin;       // 起始时刻
+
+            scope(const scope&) = delete;
+            scope& operator=(const scope&) = delete;
+        };
+
+        /**
+         * @brief   获取当前时刻
+         * @return  uint64_t 自进程内固定起点的纳秒数
+         */
+        static uint64_t now() noexcept;
+
+        /**
+         * @brief   记录一个完整事件
+         * @param   const char* name 事件名称（需为静态字符串）
+         * @param   uint64_t begin_ns 起始时刻
+         * @param   uint64_t end_ns 结束时刻
+         * @return  void
+         */
+        static void record(const char* name, uint64_t begin_ns, uint64_t end_ns) noexcept;
+
+        /**
+         * @brief   累加命名计数器
+         * @param   counter c 计数器
+         * @param   uint64_t value 增量
+         * @return  void
+         */
+        static void add(counter c, uint64_t value) noexcept;
+
+        /**
+         * @brief   设置慢路径调用栈采样
+         * @param   uint64_t threshold_ns 耗时阈值（纳秒），0表示关闭采样
+         * @param   uint32_t period 每个线程每period个慢事件采集一次调用栈，0按1处理
+         * @return  void
+         */
+        static void set_stack_sampling(uint64_t threshold_ns, uint32_t period) noexcept;
+
+        /**
+         * @brief   汇总全部线程的计数器值
+         * @param   counter c 计数器
+         * @return  uint64_t 计数器值
+         */
+        static uint64_t counter_value(counter c) noexcept;
+
+        /**
+         * @brief   获取因缓存区写满或无法分配而丢弃的事件数
+         * @return  uint64_t 丢弃数
+         */
+        static uint64_t dropped_events() noexcept;
+
+        /**
+         * @brief   获取全部线程缓存区已分配的事件与调用栈存储字节数
+         * @return  uint64_t 字节数
+         */
+        static uint64_t buffer_bytes() noexcept;
+
+        /**
+         * @brief   导出Chrome Trace JSON
+         * @return  std::string JSON文本
+         */
+        static std::string export_chrome_trace();
+
+        /**
+         * @brief   导出Chrome Trace JSON到文件
+         * @param   const std::string& path 文件路径
+         * @return  bool 是否写入成功
+         */
+        static bool save_chrome_trace(const std::string& path);
+
+        /**
+         * @brief   清空全部线程的事件与计数器（需在无并发记录时调用）
+         * @return  void
+         */
+        static void reset() noexcept;
+
+        /**
+         * @brief   获取计数器名称
+         * @param   counter c 计数器
+         * @return  const char* 名称
+         */
+        static const char* counter_name(counter c) noexcept;
     };
 }
 
+#define MPMT_PROF_CONCAT_IMPL(a, b) a##b
+#define MPMT_PROF_CONCAT(a, b) MPMT_PROF_CONCAT_IMPL(a, b)
+
+#if defined(MPMT_PROFILE)
+    #define MPMT_PROF_SCOPE(name) \
+        utils::profiler::scope MPMT_PROF_CONCAT(mpmt_prof_scope_, __LINE__)(name)
+    #define MPMT_PROF_COUNT(c, value) \
+        utils::profiler::add(utils::profiler::counter::c, static_cast<uint64_t>(value))
+#else
+    #define MPMT_PROF_SCOPE(name)       ((void)0)
+    #define MPMT_PROF_COUNT(c, value)   ((void)0)
+#endif
+
 #endif // !PROFILER_HPP
@@ -1,18 +1,81 @@
 #ifndef STACK_TRACER_HPP
 #define STACK_TRACER_HPP
 
+#include <cstdint>
 #include <cstdio>
+#include <string>
+#include <vector>
 
 namespace utils
 {
     /**
      * @class 堆栈打印工具
+     * @note  1. 采集与符号化分离：capture()只记录返回地址，不分配内存、不加锁（Linux下预热后为异步信号安全），
+     *           可在热路径上按采样记录；symbolize()/print(const trace&)在之后的慢路径中解析符号。
+     *        2. install_crash_handlers()在SIGSEGV、SIGABRT等致命信号时输出原始调用栈，随后按默认行为终止进程。
+ *           处理函数内只采集返回地址并以write(2)/WriteFile输出，不做符号化、不分配内存，地址需离线符号化。
+     *        3. Linux下解析可执行文件内的函数名需以-rdynamic链接（CMake中ENABLE_EXPORTS），
+     *           输出同时给出模块内偏移，可离线用addr2line得到行号。
      */
     class stack_tracer
     {
     public:
+        static constexpr std::size_t mc_MAX_FRAMES = 64;    // 单次采集的最大帧数
+
+        /** @brief 原始调用栈：仅含返回地址，可按值拷贝 */
+        struct trace
+        {
+            void* m_frames[mc_MAX_FRAMES];
+            uint32_t m_size;
+        };
+
+        /**
+         * @brief   采集并立即打印当前调用栈到stderr
+         * @param   std::size_t max_frames 最大帧数
+         * @return  void
+         */
         static void print(std::size_t max_frames = 32) noexcept;
-        
+
+        /**
+         * @brief   采集当前调用栈的原始帧
+         * @param   trace& out 输出
+         * @param   std::size_t skip 跳过的最内层帧数（不含capture自身）
+         * @return  uint32_t 采集到的帧数
+         */
+        static uint32_t capture(trace& out, std::size_t skip = 0) noexcept;
+
+        /**
+         * @brief   符号化原始调用栈
+         * @param   const trace& tr 原始调用栈
+         * @return  std::vector<std::string> 每帧一行："函数+偏移 (模块+偏移)"，无法解析时为地址
+         */
+        static std::vector<std::string> symbolize(const trace& tr);
+
+        /**
+         * @brief   符号化并打印原始调用栈
+         * @param   const trace& tr 原始调用栈
+         * @param   FILE* out 输出流
+         * @return  void
+         */
+        static void print(const trace& tr, FILE* out = stderr) noexcept;
+
+        /**
+         * @brief   安装致命信号处理（SIGSEGV、SIGABRT、SIGBUS、SIGFPE、SIGILL）
+         * @return  bool 是否全部安装成功
+         * @note    重复调用无副作用；Linux下同时为调用线程设置备用信号栈以捕获栈溢出，其他线程见install_thread_alt_stack()。
+         */
+        static bool install_crash_handlers() noexcept;
+
+        /**
+         * @brief   为调用线程设置备用信号栈，线程退出时自动撤销并释放
+         * @return  bool 调用线程是否已有备用信号栈
+         * @note    1. 备用信号栈按线程设置。栈溢出的线程若没有备用信号栈，处理函数无栈可用，进程直接终止且没有输出。
+         *          2. 项目内的常驻线程（coro_pool与numa_pool工作线程、持有方编码/掩码流水线、检查点与日志写出线程、
+         *             模拟中的代理方服务线程）在入口处调用；短时并行循环（凭证编码、槽位指示）的线程不设置。
+         *          3. 尚未调用install_crash_handlers()时不设置，返回false；其之前已启动的线程不会补设。
+         *          4. Windows下栈溢出由结构化异常处理，不经过备用信号栈，恒返回false。
+         */
+        static bool install_thread_alt_stack() noexcept;
     };
 }
 
@@ -1,9 +1,12 @@
 #ifndef COMM_ADAPTER_HPP
 #define COMM_ADAPTER_HPP
 
+#include <functional>
 #include <type_traits>
 #include <vector>
 
+#include "core/comm/comm_packer.hpp"
+
 /** @namespace 项目命名空间。 */
 namespace mpmt
 {
@@ -70,6 +73,51 @@ namespace mpmt
          */
         virtual void receive(std::vector<DT> &recv_buf) = 0;
 
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        // 以下为压缩通信接口（基于上述通信接口实现，实现类无需重写）
+
+        /**
+         * @brief   向通信目标发送可压缩数据 (DT)。
+         * @param   const std::vector<DT>& send_buf 发送缓存的引用，用于只读访问。
+         * @param   bool allow_compress 是否允许压缩，公开值、比特向量、种子等低熵数据传入true，
+         *          均匀随机的秘密份额传入false。
+         * @note    报文头携带压缩标志，接收方必须使用receive_packed接收。
+         */
+        void send_packed(const std::vector<DT> &send_buf, bool allow_compress)
+        {
+            send(comm_packer<DT>::pack(send_buf, allow_compress));
+        }
+
+        /**
+         * @brief   从通信目标接收经send_packed发送的数据 (DT)。
+         * @param   std::vector<DT>& recv_buf 接收缓存的引用，用于写入访问。
+         * @note    需要保障recv_buf为空，内存分配由该接口完成。
+         */
+        void receive_packed(std::vector<DT> &recv_buf)
+        {
+            std::vector<DT> message;
+            receive(message);
+            recv_buf = comm_packer<DT>::unpack(message);
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        // 以下为非阻塞接收接口（供协程运行时使用，默认实现退化为阻塞接收）
+
+        /**
+         * @brief   尝试接收数据 (DT)，无数据时登记就绪回调而不阻塞。
+         * @param   std::vector<DT>& recv_buf 接收缓存的引用，返回true时写入报文。
+         * @param   std::function<void()> on_ready 返回false时登记的回调：有新报文或连接关闭时恰好调用一次，
+         *          调用方应随后再次尝试接收；回调可能在发送方线程上执行，不得阻塞。
+         * @return  bool 是否已接收到报文
+         * @note    默认实现直接调用阻塞的receive()并返回true，未重写的实现类在协程中会占用一个工作线程等待。
+         */
+        virtual bool try_receive(std::vector<DT> &recv_buf, std::function<void()> on_ready)
+        {
+            (void)on_ready;
+            receive(recv_buf);
+            return true;
+        }
+
         ////////////////////////////////////////////////////////////////////////////////////////////////////
         //
 
@@ -79,6 +127,8 @@ namespace mpmt
         virtual ~comm_adapter() = 0;
     };
 
+    template <typename DT>
+    comm_adapter<DT>::~comm_adapter() = default;
 }
 
 #endif // !COMM_ADAPTER_HPP
\ No newline at end of file
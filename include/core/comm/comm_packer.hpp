@@ -0,0 +1,82 @@
+#ifndef COMM_PACKER_HPP
+#define COMM_PACKER_HPP
+
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+/** @namespace 项目命名空间。 */
+namespace mpmt
+{
+    /**
+     * @class   通信报文压缩器，将低熵数据按最小位宽打包。
+     * @tparam  DT 传输数据类型，限定为 uint8_t, uint16_t uint32_t, uint64_t
+     * @note    1. 报文格式（以DT为单位）：[位宽标志][元素个数(64bit，按DT拆分)][载荷]。
+     *          2. 位宽标志为0表示未压缩，载荷即原始数据；否则载荷为每元素w位的紧凑位流。
+     *          3. ring1以uint8_t存储时取值仅为0/1，自动按1位打包；公开值按最大值的位宽打包。
+     *          4. 秘密份额为均匀随机数，位宽等于DT位宽，此时自动回退为不压缩。
+     */
+    template <typename DT>
+    class comm_packer
+    {
+    public:
+        /** @brief 断言限制模板类型 */
+        static_assert(
+            std::is_same_v<DT, uint8_t>
+            || std::is_same_v<DT, uint16_t>
+            || std::is_same_v<DT, uint32_t>
+            || std::is_same_v<DT, uint64_t>,
+            "DT must be uint8_t, uint16_t, uint32_t or uint64_t."
+        );
+
+        static constexpr uint8_t mc_DT_BITS = sizeof(DT) * 8;                          // DT位宽
+        static constexpr uint8_t mc_RAW_FLAG = 0;                                      // 未压缩标志
+        static constexpr uint64_t mc_COUNT_WORDS = sizeof(uint64_t) / sizeof(DT);      // 元素个数字段占用的DT个数
+        static constexpr uint64_t mc_HEADER_WORDS = 1 + mc_COUNT_WORDS;                // 报文头占用的DT个数
+
+        /**
+         * @brief   计算数据的最小位宽。
+         * @param   const std::vector<DT>& data 原始数据
+         * @return  uint8_t 位宽，范围[1, mc_DT_BITS]
+         */
+        static uint8_t min_width(const std::vector<DT>& data) noexcept;
+
+        /**
+         * @brief   打包报文。
+         * @param   const std::vector<DT>& data 原始数据
+         * @param   bool allow_compress 是否允许压缩（秘密份额应传入false以跳过位宽扫描）
+         * @return  std::vector<DT> 带报文头的报文
+         */
+        static std::vector<DT> pack(const std::vector<DT>& data, bool allow_compress);
+
+        /**
+         * @brief   解包报文。
+         * @param   const std::vector<DT>& message 带报文头的报文
+         * @return  std::vector<DT> 原始数据
+         * @throw   std::invalid_argument 报文头损坏或载荷长度不符
+         */
+        static std::vector<DT> unpack(const std::vector<DT>& message);
+
+        /**
+         * @brief   判断报文是否经过压缩。
+         * @param   const std::vector<DT>& message 带报文头的报文
+         * @return  bool 是否压缩
+         */
+        static bool is_compressed(const std::vector<DT>& message) noexcept;
+
+        /**
+         * @brief   计算按w位打包n个元素所需的DT个数。
+         * @param   uint64_t n 元素个数
+         * @param   uint8_t width 位宽
+         * @return  uint64_t DT个数
+         */
+        static constexpr uint64_t packed_words(uint64_t n, uint8_t width) noexcept
+        {
+            return (n * width + mc_DT_BITS - 1) / mc_DT_BITS;
+        }
+    };
+}
+
+#include "core/comm/comm_packer.tpp"
+
+#endif // !COMM_PACKER_HPP
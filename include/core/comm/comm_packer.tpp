@@ -0,0 +1,143 @@
+#ifndef COMM_PACKER_TPP
+#define COMM_PACKER_TPP
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+/** @namespace 项目命名空间。 */
+namespace mpmt
+{
+    template <typename DT>
+    uint8_t comm_packer<DT>::min_width(const std::vector<DT>& data) noexcept
+    {
+        // 对所有元素按位或，最高有效位即所需位宽
+        DT acc = 0;
+        for (const DT v : data)
+        {
+            acc |= v;
+        }
+
+        uint8_t width = 1;
+        while (width < mc_DT_BITS && (acc >> width) != 0)
+        {
+            ++width;
+        }
+        return width;
+    }
+
+    template <typename DT>
+    std::vector<DT> comm_packer<DT>::pack(const std::vector<DT>& data, bool allow_compress)
+    {
+        // 1-确定位宽，压缩无收益时回退为原始数据
+        const uint64_t n = data.size();
+        uint8_t width = allow_compress ? min_width(data) : mc_DT_BITS;
+        const uint8_t flag = (width >= mc_DT_BITS) ? mc_RAW_FLAG : width;
+        const uint64_t payload_words = (flag == mc_RAW_FLAG) ? n : packed_words(n, width);
+
+        // 2-写入报文头
+        std::vector<DT> message(mc_HEADER_WORDS + payload_words, 0);
+        message[0] = static_cast<DT>(flag);
+        for (uint64_t i = 0; i < mc_COUNT_WORDS; ++i)
+        {
+            message[1 + i] = static_cast<DT>(n >> (i * mc_DT_BITS));
+        }
+
+        // 3-写入载荷
+        DT* out = message.data() + mc_HEADER_WORDS;
+        if (flag == mc_RAW_FLAG)
+        {
+            std::copy(data.begin(), data.end(), out);
+            return message;
+        }
+
+        uint64_t bitpos = 0;
+        for (uint64_t i = 0; i < n; ++i, bitpos += width)
+        {
+            const uint64_t word = bitpos / mc_DT_BITS;
+            const uint8_t shift = static_cast<uint8_t>(bitpos % mc_DT_BITS);
+            out[word] |= static_cast<DT>(data[i] << shift);
+            // 跨越DT边界时写入高位剩余部分
+            if (shift + width > mc_DT_BITS)
+            {
+                out[word + 1] |= static_cast<DT>(data[i] >> (mc_DT_BITS - shift));
+            }
+        }
+        return message;
+    }
+
+    template <typename DT>
+    std::vector<DT> comm_packer<DT>::unpack(const std::vector<DT>& message)
+    {
+        // 1-解析报文头
+        if (message.size() < mc_HEADER_WORDS)
+        {
+            throw std::invalid_argument("comm_packer: message is shorter than its header.");
+        }
+        const uint8_t flag = static_cast<uint8_t>(message[0]);
+        if (flag >= mc_DT_BITS)
+        {
+            throw std::invalid_argument("comm_packer: invalid width flag=" + std::to_string(flag) + ".");
+        }
+        uint64_t n = 0;
+        for (uint64_t i = 0; i < mc_COUNT_WORDS; ++i)
+        {
+            n |= static_cast<uint64_t>(message[1 + i]) << (i * mc_DT_BITS);
+        }
+
+        // 2-校验载荷长度：每元素至少占1位，先以报文长度约束n，避免n * width回绕
+        const uint64_t c_available = message.size() - mc_HEADER_WORDS;
+        if (n > c_available * mc_DT_BITS)
+        {
+            throw std::invalid_argument
+            (
+                "comm_packer: element count " + std::to_string(n) + " exceeds the "
+                + std::to_string(c_available) + "-word payload."
+            );
+        }
+        const uint8_t width = (flag == mc_RAW_FLAG) ? mc_DT_BITS : flag;
+        const uint64_t payload_words = (flag == mc_RAW_FLAG) ? n : packed_words(n, width);
+        if (c_available != payload_words)
+        {
+            throw std::invalid_argument
+            (
+                "comm_packer: payload length mismatch, expected "
+                + std::to_string(payload_words)
+                + " word(s) but got "
+                + std::to_string(c_available)
+                + "."
+            );
+        }
+
+        // 3-还原数据
+        const DT* in = message.data() + mc_HEADER_WORDS;
+        if (flag == mc_RAW_FLAG)
+        {
+            return std::vector<DT>(in, in + n);
+        }
+
+        std::vector<DT> data(n);
+        const DT mask = static_cast<DT>((DT(1) << width) - 1);
+        uint64_t bitpos = 0;
+        for (uint64_t i = 0; i < n; ++i, bitpos += width)
+        {
+            const uint64_t word = bitpos / mc_DT_BITS;
+            const uint8_t shift = static_cast<uint8_t>(bitpos % mc_DT_BITS);
+            DT v = static_cast<DT>(in[word] >> shift);
+            if (shift + width > mc_DT_BITS)
+            {
+                v |= static_cast<DT>(in[word + 1] << (mc_DT_BITS - shift));
+            }
+            data[i] = static_cast<DT>(v & mask);
+        }
+        return data;
+    }
+
+    template <typename DT>
+    bool comm_packer<DT>::is_compressed(const std::vector<DT>& message) noexcept
+    {
+        return !message.empty() && static_cast<uint8_t>(message[0]) != mc_RAW_FLAG;
+    }
+}
+
+#endif // !COMM_PACKER_TPP
@@ -0,0 +1,87 @@
+#ifndef COMM_INPROC_HPP
+#define COMM_INPROC_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "core/comm/comm_adapter.hpp"
+
+/** @namespace 项目命名空间。 */
+namespace mpmt
+{
+    /**
+     * @class   进程内通信适配器，用于单进程多线程模拟各参与方
+     * @tparam  DT 传输数据类型，限定为 uint8_t, uint16_t uint32_t, uint64_t
+     * @note    1. 由make_pair()成对创建，两端各持有一条方向相反的有界消息队列，容量按未取走的字节数计。
+     *          2. send()在队列超出容量时阻塞直到对端取走消息（队列为空时单条消息不受容量限制），
+     *             对端析构后不再阻塞；receive()阻塞直到有消息或对端断开。
+     *          3. try_receive()无消息时登记就绪回调，由下一次send()或对端disconnect()在其线程上调用。
+     * @throw   throw mpmt::comm_exc 对端已断开或报文类型不匹配
+     */
+    template <typename DT>
+    class comm_inproc : public comm_adapter<DT>
+    {
+    public:
+        static constexpr uint64_t mc_DEFAULT_CAPACITY_BYTES = 64ULL << 20;  // 默认每个方向的队列容量
+
+        /**
+         * @brief   创建一对互联的端点
+         * @param   uint64_t capacity_bytes 每个方向的队列容量（字节），0视为不限制
+         * @return  std::pair<std::unique_ptr<comm_inproc<DT>>, std::unique_ptr<comm_inproc<DT>>>
+         */
+        static std::pair<std::unique_ptr<comm_inproc<DT>>, std::unique_ptr<comm_inproc<DT>>> make_pair
+        (
+            uint64_t capacity_bytes = mc_DEFAULT_CAPACITY_BYTES
+        );
+
+        void connect() override;
+        void disconnect() override;
+        void send(const DT send_number) override;
+        void receive(DT& recv_number) override;
+        void send(const std::vector<DT>& send_buf) override;
+        void receive(std::vector<DT>& recv_buf) override;
+        bool try_receive(std::vector<DT>& recv_buf, std::function<void()> on_ready) override;
+
+        /**
+         * @brief   获取本端累计发送的数据量
+         * @return  uint64_t 发送字节数
+         */
+        uint64_t bytes_sent() const noexcept { return m_bytes_sent; }
+
+        ~comm_inproc() override;
+
+    private:
+        struct channel
+        {
+            std::mutex m_mutex;
+            std::condition_variable m_cv;
+            std::condition_variable m_not_full; // 队列字节数回落到容量以下
+            std::deque<std::vector<DT>> m_queue;
+            uint64_t m_bytes = 0;               // 队列中的字节数
+            uint64_t m_capacity = 0;            // 容量（字节），0表示不限制
+            bool m_closed = false;
+            bool m_reader_gone = false;         // 接收端已析构
+            std::function<void()> m_waiter;     // try_receive()登记的就绪回调
+        };
+
+        std::shared_ptr<channel> m_in;      // 接收队列
+        std::shared_ptr<channel> m_out;     // 发送队列
+        uint64_t m_bytes_sent;              // 累计发送字节数
+
+        comm_inproc(std::shared_ptr<channel> in, std::shared_ptr<channel> out);
+
+        void push(std::vector<DT>&& message);
+        std::vector<DT> pop();
+
+        /** @brief 唤醒等待者：通知阻塞的receive()并调用登记的就绪回调（调用时不持有锁） */
+        static void wake(channel& ch, std::function<void()>&& waiter);
+    };
+}
+#include "core/comm/inproc_impl/comm_inproc.tpp"
+
+#endif // !COMM_INPROC_HPP
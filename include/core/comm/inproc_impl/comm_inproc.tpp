@@ -0,0 +1,174 @@
+#ifndef COMM_INPROC_TPP
+#define COMM_INPROC_TPP
+
+#include "auxkit/profiler.hpp"
+#include "core/exception/comm_exc.hpp"
+
+/** @namespace 项目命名空间。 */
+namespace mpmt
+{
+    template <typename DT>
+    comm_inproc<DT>::comm_inproc(std::shared_ptr<channel> in, std::shared_ptr<channel> out)
+        :
+        m_in(std::move(in)),
+        m_out(std::move(out)),
+        m_bytes_sent(0)
+    {}
+
+    template <typename DT>
+    std::pair<std::unique_ptr<comm_inproc<DT>>, std::unique_ptr<comm_inproc<DT>>> comm_inproc<DT>::make_pair
+    (
+        uint64_t capacity_bytes
+    )
+    {
+        auto a_to_b = std::make_shared<channel>();
+        auto b_to_a = std::make_shared<channel>();
+        a_to_b->m_capacity = capacity_bytes;
+        b_to_a->m_capacity = capacity_bytes;
+        return
+        {
+            std::unique_ptr<comm_inproc<DT>>(new comm_inproc<DT>(b_to_a, a_to_b)),
+            std::unique_ptr<comm_inproc<DT>>(new comm_inproc<DT>(a_to_b, b_to_a))
+        };
+    }
+
+    template <typename DT>
+    void comm_inproc<DT>::connect()
+    {
+        // 进程内通道创建即连通
+    }
+
+    template <typename DT>
+    void comm_inproc<DT>::disconnect()
+    {
+        // 关闭发送方向，对端读空队列后receive()将抛出异常
+        std::function<void()> waiter;
+        {
+            std::lock_guard<std::mutex> lock(m_out->m_mutex);
+            m_out->m_closed = true;
+            waiter = std::move(m_out->m_waiter);
+            m_out->m_waiter = nullptr;
+        }
+        m_out->m_not_full.notify_all();
+        wake(*m_out, std::move(waiter));
+    }
+
+    template <typename DT>
+    void comm_inproc<DT>::send(const DT send_number)
+    {
+        push(std::vector<DT>(1, send_number));
+    }
+
+    template <typename DT>
+    void comm_inproc<DT>::receive(DT& recv_number)
+    {
+        std::vector<DT> message = pop();
+        if (message.size() != 1)
+        {
+            throw comm_exc
+            (
+                comm_exc::exc_type::MESSAGE_MISMATCH,
+                "expected a single value but received " + std::to_string(message.size()) + " value(s)."
+            );
+        }
+        recv_number = message[0];
+    }
+
+    template <typename DT>
+    void comm_inproc<DT>::send(const std::vector<DT>& send_buf)
+    {
+        push(std::vector<DT>(send_buf));
+    }
+
+    template <typename DT>
+    void comm_inproc<DT>::receive(std::vector<DT>& recv_buf)
+    {
+        recv_buf = pop();
+    }
+
+    template <typename DT>
+    void comm_inproc<DT>::push(std::vector<DT>&& message)
+    {
+        const uint64_t c_bytes = message.size() * sizeof(DT);
+        m_bytes_sent += c_bytes;
+        MPMT_PROF_COUNT(BYTES_SENT, c_bytes);
+        std::function<void()> waiter;
+        {
+            std::unique_lock<std::mutex> lock(m_out->m_mutex);
+            channel& ch = *m_out;
+            ch.m_not_full.wait(lock, [&ch, c_bytes]
+            {
+                return ch.m_closed || ch.m_reader_gone || ch.m_capacity == 0 || ch.m_queue.empty()
+                    || ch.m_bytes + c_bytes <= ch.m_capacity;
+            });
+            if (ch.m_closed)
+            {
+                throw comm_exc(comm_exc::exc_type::CONNECTION_CLOSED, "send on a disconnected in-process channel.");
+            }
+            ch.m_bytes += c_bytes;
+            ch.m_queue.push_back(std::move(message));
+            waiter = std::move(m_out->m_waiter);
+            m_out->m_waiter = nullptr;
+        }
+        wake(*m_out, std::move(waiter));
+    }
+
+    template <typename DT>
+    bool comm_inproc<DT>::try_receive(std::vector<DT>& recv_buf, std::function<void()> on_ready)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_in->m_mutex);
+            if (m_in->m_queue.empty() && !m_in->m_closed)
+            {
+                // 登记与入队在同一把锁下完成，不会错过唤醒
+                m_in->m_waiter = std::move(on_ready);
+                return false;
+            }
+        }
+        recv_buf = pop();
+        return true;
+    }
+
+    template <typename DT>
+    void comm_inproc<DT>::wake(channel& ch, std::function<void()>&& waiter)
+    {
+        ch.m_cv.notify_all();
+        if (waiter)
+        {
+            waiter();
+        }
+    }
+
+    template <typename DT>
+    std::vector<DT> comm_inproc<DT>::pop()
+    {
+        std::unique_lock<std::mutex> lock(m_in->m_mutex);
+        m_in->m_cv.wait(lock, [this] { return !m_in->m_queue.empty() || m_in->m_closed; });
+        if (m_in->m_queue.empty())
+        {
+            throw comm_exc(comm_exc::exc_type::CONNECTION_CLOSED, "peer disconnected the in-process channel.");
+        }
+        std::vector<DT> message = std::move(m_in->m_queue.front());
+        m_in->m_queue.pop_front();
+        m_in->m_bytes -= message.size() * sizeof(DT);
+        lock.unlock();
+        m_in->m_not_full.notify_all();
+        MPMT_PROF_COUNT(BYTES_RECEIVED, message.size() * sizeof(DT));
+        return message;
+    }
+
+    template <typename DT>
+    comm_inproc<DT>::~comm_inproc()
+    {
+        disconnect();
+
+        // 不再接收：解除对端因队满而阻塞的send()
+        {
+            std::lock_guard<std::mutex> lock(m_in->m_mutex);
+            m_in->m_reader_gone = true;
+        }
+        m_in->m_not_full.notify_all();
+    }
+}
+
+#endif // !COMM_INPROC_TPP
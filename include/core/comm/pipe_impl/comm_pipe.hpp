@@ -1,5 +1,9 @@
-#ifndef COMM_HPP
-#define COMM_HPP
+#ifndef COMM_PIPE_HPP
+#define COMM_PIPE_HPP
+
+#include <memory>
+#include <utility>
+#include <vector>
 
 #include "core/comm/comm_adapter.hpp"
 
@@ -7,14 +11,59 @@
 namespace mpmt
 {
     /**
-     * @class   用管道实现的通信适配器
-     * @tparam  DT 传输数据类型，限定为ring32,ring64
+     * @class   用管道实现的通信适配器，用于同一主机上多进程模拟各参与方
+     * @tparam  DT 传输数据类型，限定为 uint8_t, uint16_t uint32_t, uint64_t
+     * @note    1. 由make_pair()成对创建，底层为一对全双工的UNIX域流套接字（socketpair），fork()后两端可分属不同进程。
+     *          2. 报文格式：[元素个数(64bit)][载荷]；send()在内核缓冲区满时阻塞，receive()阻塞直到收齐一条报文。
+     *          3. disconnect()关闭本端发送方向（shutdown），即使其他进程仍持有该描述符的副本，对端读完后receive()也会抛出异常；
+     *             析构只关闭本进程的描述符，不影响继承了副本的其他进程。
+     *          4. 仅支持POSIX平台。
+     * @throw   throw mpmt::comm_exc 对端已断开、读写失败或报文类型不匹配
      */
     template <typename DT>
     class comm_pipe : public comm_adapter<DT>
     {
+    public:
+        /**
+         * @brief   创建一对互联的端点
+         * @return  std::pair<std::unique_ptr<comm_pipe<DT>>, std::unique_ptr<comm_pipe<DT>>>
+         * @throw   comm_exc 无法创建套接字对
+         */
+        static std::pair<std::unique_ptr<comm_pipe<DT>>, std::unique_ptr<comm_pipe<DT>>> make_pair();
+
+        void connect() override;
+        void disconnect() override;
+        void send(const DT send_number) override;
+        void receive(DT& recv_number) override;
+        void send(const std::vector<DT>& send_buf) override;
+        void receive(std::vector<DT>& recv_buf) override;
+
+        /**
+         * @brief   获取本端累计发送的数据量（不含报文头）
+         * @return  uint64_t 发送字节数
+         */
+        uint64_t bytes_sent() const noexcept { return m_bytes_sent; }
+
+        ~comm_pipe() override;
+
+    private:
+        static constexpr uint64_t mc_MAX_ELEMENTS = (1ULL << 40) / sizeof(DT);  // 单条报文的元素个数上限（1 TiB）
+
+        int m_fd;                   // 套接字描述符
+        uint64_t m_bytes_sent;      // 累计发送字节数
+
+        explicit comm_pipe(int fd);
+
+        /** @brief 写出len字节，处理部分写与EINTR */
+        void write_all(const void* data, uint64_t len);
+
+        /** @brief 读入len字节，处理部分读与EINTR；对端关闭时抛出CONNECTION_CLOSED */
+        void read_all(void* data, uint64_t len);
+
+        void write_message(const DT* data, uint64_t n);
+        std::vector<DT> read_message();
     };
 }
 #include "core/comm/pipe_impl/comm_pipe.tpp"
 
-#endif // !COMM_HPP
\ No newline at end of file
+#endif // !COMM_PIPE_HPP
@@ -1,4 +1,165 @@
-#ifndef COMM_TPP
-#define COMM_TPP
+#ifndef COMM_PIPE_TPP
+#define COMM_PIPE_TPP
 
-#endif // !COMM_TPP
\ No newline at end of file
+#include <cerrno>
+#include <cstring>
+#include <string>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "auxkit/profiler.hpp"
+#include "core/exception/comm_exc.hpp"
+
+/** @namespace 项目命名空间。 */
+namespace mpmt
+{
+    template <typename DT>
+    comm_pipe<DT>::comm_pipe(int fd)
+        :
+        m_fd(fd),
+        m_bytes_sent(0)
+    {}
+
+    template <typename DT>
+    std::pair<std::unique_ptr<comm_pipe<DT>>, std::unique_ptr<comm_pipe<DT>>> comm_pipe<DT>::make_pair()
+    {
+        int fds[2];
+        if (::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0)
+        {
+            throw comm_exc(comm_exc::exc_type::CONNECTION_CLOSED, std::string("socketpair failed: ") + std::strerror(errno) + ".");
+        }
+        return
+        {
+            std::unique_ptr<comm_pipe<DT>>(new comm_pipe<DT>(fds[0])),
+            std::unique_ptr<comm_pipe<DT>>(new comm_pipe<DT>(fds[1]))
+        };
+    }
+
+    template <typename DT>
+    void comm_pipe<DT>::connect()
+    {
+        // 套接字对创建即连通
+    }
+
+    template <typename DT>
+    void comm_pipe<DT>::disconnect()
+    {
+        // 关闭发送方向，对端读完已发送的报文后receive()将抛出异常
+        ::shutdown(m_fd, SHUT_WR);
+    }
+
+    template <typename DT>
+    void comm_pipe<DT>::send(const DT send_number)
+    {
+        write_message(&send_number, 1);
+    }
+
+    template <typename DT>
+    void comm_pipe<DT>::receive(DT& recv_number)
+    {
+        const std::vector<DT> message = read_message();
+        if (message.size() != 1)
+        {
+            throw comm_exc
+            (
+                comm_exc::exc_type::MESSAGE_MISMATCH,
+                "expected a single value but received " + std::to_string(message.size()) + " value(s)."
+            );
+        }
+        recv_number = message[0];
+    }
+
+    template <typename DT>
+    void comm_pipe<DT>::send(const std::vector<DT>& send_buf)
+    {
+        write_message(send_buf.data(), send_buf.size());
+    }
+
+    template <typename DT>
+    void comm_pipe<DT>::receive(std::vector<DT>& recv_buf)
+    {
+        recv_buf = read_message();
+    }
+
+    template <typename DT>
+    void comm_pipe<DT>::write_message(const DT* data, uint64_t n)
+    {
+        write_all(&n, sizeof(n));
+        write_all(data, n * sizeof(DT));
+        m_bytes_sent += n * sizeof(DT);
+        MPMT_PROF_COUNT(BYTES_SENT, n * sizeof(DT));
+    }
+
+    template <typename DT>
+    std::vector<DT> comm_pipe<DT>::read_message()
+    {
+        uint64_t n = 0;
+        read_all(&n, sizeof(n));
+        if (n > mc_MAX_ELEMENTS)
+        {
+            throw comm_exc
+            (
+                comm_exc::exc_type::MESSAGE_MISMATCH,
+                "pipe message header announces " + std::to_string(n) + " element(s)."
+            );
+        }
+        std::vector<DT> message(n);
+        read_all(message.data(), n * sizeof(DT));
+        MPMT_PROF_COUNT(BYTES_RECEIVED, n * sizeof(DT));
+        return message;
+    }
+
+    template <typename DT>
+    void comm_pipe<DT>::write_all(const void* data, uint64_t len)
+    {
+        const uint8_t* p = static_cast<const uint8_t*>(data);
+        while (len != 0)
+        {
+            // MSG_NOSIGNAL：对端已关闭时返回EPIPE而非触发SIGPIPE
+            const ssize_t c_written = ::send(m_fd, p, len, MSG_NOSIGNAL);
+            if (c_written < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                throw comm_exc(comm_exc::exc_type::CONNECTION_CLOSED, std::string("pipe send failed: ") + std::strerror(errno) + ".");
+            }
+            p += c_written;
+            len -= static_cast<uint64_t>(c_written);
+        }
+    }
+
+    template <typename DT>
+    void comm_pipe<DT>::read_all(void* data, uint64_t len)
+    {
+        uint8_t* p = static_cast<uint8_t*>(data);
+        while (len != 0)
+        {
+            const ssize_t c_read = ::recv(m_fd, p, len, 0);
+            if (c_read < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                throw comm_exc(comm_exc::exc_type::CONNECTION_CLOSED, std::string("pipe receive failed: ") + std::strerror(errno) + ".");
+            }
+            if (c_read == 0)
+            {
+                throw comm_exc(comm_exc::exc_type::CONNECTION_CLOSED, "peer disconnected the pipe.");
+            }
+            p += c_read;
+            len -= static_cast<uint64_t>(c_read);
+        }
+    }
+
+    template <typename DT>
+    comm_pipe<DT>::~comm_pipe()
+    {
+        ::close(m_fd);
+    }
+}
+
+#endif // !COMM_PIPE_TPP
@@ -0,0 +1,87 @@
+#ifndef CORO_COMM_HPP
+#define CORO_COMM_HPP
+
+#include <coroutine>
+#include <vector>
+
+#include "core/comm/comm_adapter.hpp"
+#include "core/coro/coro_pool.hpp"
+#include "core/coro/coro_task.hpp"
+
+/** @namespace 项目命名空间 */
+namespace mpmt
+{
+    /** @namespace 内部实现 */
+    namespace verborgen
+    {
+        /** @brief 尝试接收一次：无报文时挂起，报文到达或连接关闭后由池内线程恢复 */
+        template <typename DT>
+        struct receive_awaiter
+        {
+            coro_pool& m_pool;
+            comm_adapter<DT>& m_comm;
+            std::vector<DT>& m_buf;
+            bool m_received = false;
+
+            bool await_ready() const noexcept { return false; }
+
+            bool await_suspend(std::coroutine_handle<> handle)
+            {
+                // 登记回调后协程可能已在其他线程上恢复，此后不得再访问本等待体
+                coro_pool* const c_pool = &m_pool;
+                if (m_comm.try_receive(m_buf, [c_pool, handle] { c_pool->post(handle); }))
+                {
+                    m_received = true;
+                    return false;
+                }
+                return true;
+            }
+
+            bool await_resume() const noexcept { return m_received; }
+        };
+    }
+
+    /**
+     * @brief   在协程中接收一条报文：co_await async_receive(pool, comm, buf)
+     * @param   coro_pool& pool 恢复协程的线程池
+     * @param   comm_adapter<DT>& comm 通信适配器
+     * @param   std::vector<DT>& buf 接收缓存
+     * @return  coro_task<void> 报文写入buf后结束
+     * @throw   comm_exc 连接已关闭（在co_await处抛出）
+     * @note    通信适配器未重写try_receive()时退化为在当前工作线程上阻塞接收。
+     */
+    template <typename DT>
+    coro_task<void> async_receive(coro_pool& pool, comm_adapter<DT>& comm, std::vector<DT>& buf)
+    {
+        // 被唤醒后再次尝试：报文已入队则立即取出，连接关闭则由try_receive()抛出
+        for (;;)
+        {
+            verborgen::receive_awaiter<DT> awaiter{ pool, comm, buf };
+            if (co_await awaiter)
+            {
+                break;
+            }
+        }
+    }
+
+    /**
+     * @brief   同async_receive()，pool为nullptr时在当前线程上阻塞接收（不挂起）
+     * @param   coro_pool* pool 恢复协程的线程池，可为nullptr
+     * @param   comm_adapter<DT>& comm 通信适配器
+     * @param   std::vector<DT>& buf 接收缓存
+     * @return  coro_task<void> 报文写入buf后结束
+     * @note    协议角色的同步接口与协程接口共用同一协程实现：同步接口以nullptr调用并经run_inline()运行。
+     */
+    template <typename DT>
+    coro_task<void> async_receive(coro_pool* pool, comm_adapter<DT>& comm, std::vector<DT>& buf)
+    {
+        if (pool == nullptr)
+        {
+            comm.receive(buf);
+            co_return;
+        }
+        co_await async_receive(*pool, comm, buf);
+    }
+}
+
+#endif // !CORO_COMM_HPP
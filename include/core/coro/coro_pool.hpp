@@ -0,0 +1,113 @@
+#ifndef CORO_POOL_HPP
+#define CORO_POOL_HPP
+
+#include <condition_variable>
+#include <coroutine>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "core/coro/coro_task.hpp"
+
+/** @namespace 项目命名空间 */
+namespace mpmt
+{
+    /**
+     * @class   协程调度线程池：少量工作线程轮流恢复就绪的协程，复用大量会话
+     * @note    1. spawn()提交顶层任务，任务在池内线程上开始；任务等待通信时挂起，不占用线程，
+     *             由通信就绪回调经post()放回就绪队列，被任意空闲工作线程恢复。
+     *          2. 每个会话只需一个协程帧（通常数百字节），而非一个线程栈，数千会话只需与CPU数相当的线程。
+     *          3. 顶层任务抛出的异常连同其what()记录日志后丢弃，不影响其他会话；会话应自行处理错误，
+     *             需要由调用方感知失败时在任务内捕获并转交（如保存std::exception_ptr，wait_idle()后重新抛出）。
+     *          4. worker_index()返回当前工作线程在所属池中的编号，可用于按线程索引的无锁状态；
+     *             该编号只在两次co_await之间有效。
+     */
+    class coro_pool
+    {
+    public:
+        struct config
+        {
+            unsigned m_threads;             // 工作线程数，0表示硬件并发数
+            bool m_pin_workers = false;     // 是否将第w个工作线程绑定到第w % N个NUMA计算节点的CPU上
+        };
+
+        /** @brief 把当前协程转移到池内线程上继续执行的等待体 */
+        struct schedule_awaiter
+        {
+            coro_pool& m_pool;
+
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<> handle) const { m_pool.post(handle); }
+            void await_resume() const noexcept {}
+        };
+
+        /**
+         * @brief   创建线程池并启动工作线程
+         * @param   const config& cfg 线程池配置
+         */
+        explicit coro_pool(const config& cfg);
+
+        /**
+         * @brief   提交顶层任务
+         * @param   coro_task<void>&& task 任务
+         * @return  void
+         */
+        void spawn(coro_task<void>&& task);
+
+        /**
+         * @brief   将挂起的协程放入就绪队列
+         * @param   std::coroutine_handle<> handle 协程句柄
+         * @return  void
+         */
+        void post(std::coroutine_handle<> handle);
+
+        /**
+         * @brief   获取转移到池内线程的等待体：co_await pool.schedule()
+         * @return  schedule_awaiter 等待体
+         */
+        schedule_awaiter schedule() noexcept { return schedule_awaiter{ *this }; }
+
+        /**
+         * @brief   等待全部已提交任务结束
+         * @return  void
+         */
+        void wait_idle();
+
+        /**
+         * @brief   获取工作线程数
+         * @return  unsigned 线程数
+         */
+        unsigned threads() const noexcept { return static_cast<unsigned>(m_threads.size()); }
+
+        /**
+         * @brief   获取当前线程在所属池中的编号
+         * @return  unsigned 编号，非池内线程返回0
+         */
+        static unsigned worker_index() noexcept;
+
+        /** @brief 等待已提交任务结束后停止工作线程 */
+        ~coro_pool();
+
+    private:
+        std::mutex m_mutex;                             // 保护就绪队列与计数
+        std::condition_variable m_ready_cv;             // 有就绪协程或停止
+        std::condition_variable m_idle_cv;              // 任务全部结束
+        std::deque<std::coroutine_handle<>> m_ready;    // 就绪队列
+        uint64_t m_pending;                             // 未结束的顶层任务数
+        bool m_stop;                                    // 是否停止
+        std::vector<std::thread> m_threads;             // 工作线程
+
+        /** @brief 工作线程主循环 */
+        void work(unsigned worker);
+
+        /** @brief 顶层任务结束 */
+        void finish();
+
+        coro_pool(const coro_pool&) = delete;
+        coro_pool& operator=(const coro_pool&) = delete;
+    };
+}
+
+#endif // !CORO_POOL_HPP
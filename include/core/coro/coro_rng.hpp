@@ -0,0 +1,49 @@
+#ifndef CORO_RNG_HPP
+#define CORO_RNG_HPP
+
+#include <algorithm>
+#include <cstdint>
+
+#include "core/coro/coro_pool.hpp"
+#include "core/coro/coro_task.hpp"
+#include "core/rng/openssl_impl/prg_openssl.hpp"
+
+/** @namespace 项目命名空间 */
+namespace mpmt
+{
+    /** @brief 协程中每展开一个窗口的伪随机数后让出一次工作线程（字节） */
+    inline constexpr uint64_t c_CORO_FILL_WINDOW = 1ULL << 16;
+
+    /**
+     * @brief   在协程中展开伪随机数：co_await async_fill(pool, prg, byte_offset, out, len)
+     * @param   coro_pool* pool 恢复协程的线程池，为nullptr时一次展开完毕（不挂起）
+     * @param   const prg_openssl& prg 伪随机数生成器，须存活至任务结束
+     * @param   uint64_t byte_offset 输出流中的起始字节偏移
+     * @param   uint8_t* out 输出缓存区，须存活至任务结束
+     * @param   uint64_t len 输出长度（字节）
+     * @return  coro_task<void> 写满out后结束
+     * @note    1. AES-CTR展开是纯计算，不会阻塞；大段展开按c_CORO_FILL_WINDOW分窗，窗口之间经pool.schedule()
+     *             回到就绪队列末尾，同一工作线程上的其他会话不会被一次长展开饿死。
+     *          2. 同一prg不得被两个任务同时使用（加密上下文不可并发）。
+     */
+    inline coro_task<void> async_fill(coro_pool* pool, const prg_openssl& prg, uint64_t byte_offset, uint8_t* out, uint64_t len)
+    {
+        if (pool == nullptr)
+        {
+            prg.fill(byte_offset, out, len);
+            co_return;
+        }
+        for (uint64_t done = 0; done < len;)
+        {
+            const uint64_t c_len = std::min(c_CORO_FILL_WINDOW, len - done);
+            prg.fill(byte_offset + done, out + done, c_len);
+            done += c_len;
+            if (done < len)
+            {
+                co_await pool->schedule();
+            }
+        }
+    }
+}
+
+#endif // !CORO_RNG_HPP
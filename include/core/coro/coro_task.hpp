@@ -0,0 +1,149 @@
+#ifndef CORO_TASK_HPP
+#define CORO_TASK_HPP
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+/** @namespace 项目命名空间 */
+namespace mpmt
+{
+    template <typename T>
+    class coro_task;
+
+    /** @namespace 内部实现 */
+    namespace verborgen
+    {
+        /** @brief 协程结束时对称转移到等待者，没有等待者时返回到恢复方 */
+        struct coro_final_awaiter
+        {
+            bool await_ready() const noexcept { return false; }
+
+            template <typename P>
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<P> self) const noexcept
+            {
+                const std::coroutine_handle<> c_next = self.promise().m_continuation;
+                return c_next ? c_next : std::noop_coroutine();
+            }
+
+            void await_resume() const noexcept {}
+        };
+
+        /** @brief 返回值与返回void的promise的公共部分 */
+        struct coro_promise_base
+        {
+            std::coroutine_handle<> m_continuation;     // 等待本协程的协程
+            std::exception_ptr m_exception;             // 协程体抛出的异常
+
+            std::suspend_always initial_suspend() const noexcept { return {}; }
+            coro_final_awaiter final_suspend() const noexcept { return {}; }
+            void unhandled_exception() noexcept { m_exception = std::current_exception(); }
+
+            /** @brief 在等待者中重新抛出协程体的异常 */
+            void rethrow() const
+            {
+                if (m_exception)
+                {
+                    std::rethrow_exception(m_exception);
+                }
+            }
+        };
+
+        template <typename T>
+        struct coro_promise : coro_promise_base
+        {
+            std::optional<T> m_value;   // 返回值
+
+            void return_value(T value) { m_value.emplace(std::move(value)); }
+            T take() { rethrow(); return std::move(*m_value); }
+        };
+
+        template <>
+        struct coro_promise<void> : coro_promise_base
+        {
+            void return_void() const noexcept {}
+            void take() const { rethrow(); }
+        };
+    }
+
+    /**
+     * @class   惰性协程任务：创建时不执行，被co_await时才开始，结束时对称转移回等待者
+     * @tparam  T 返回值类型，默认为void
+     * @note    1. 协程体抛出的异常在co_await处重新抛出。
+     *          2. 任务只能被等待一次；顶层任务交给coro_pool::spawn()运行。
+     *          3. 协程可能在与开始时不同的线程上恢复，跨co_await不得持有线程局部状态的引用或锁。
+     *          4. 不会挂起的任务（如线程池参数为nullptr的协议协程）可经run_inline()在当前线程上同步运行。
+     */
+    template <typename T = void>
+    class [[nodiscard]] coro_task
+    {
+    public:
+        struct promise_type : verborgen::coro_promise<T>
+        {
+            coro_task get_return_object() noexcept
+            {
+                return coro_task(std::coroutine_handle<promise_type>::from_promise(*this));
+            }
+        };
+
+        coro_task(coro_task&& other) noexcept : m_handle(std::exchange(other.m_handle, nullptr)) {}
+
+        coro_task& operator=(coro_task&& other) noexcept
+        {
+            if (this != &other)
+            {
+                if (m_handle)
+                {
+                    m_handle.destroy();
+                }
+                m_handle = std::exchange(other.m_handle, nullptr);
+            }
+            return *this;
+        }
+
+        ~coro_task()
+        {
+            if (m_handle)
+            {
+                m_handle.destroy();
+            }
+        }
+
+        bool await_ready() const noexcept { return !m_handle || m_handle.done(); }
+
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept
+        {
+            m_handle.promise().m_continuation = awaiting;
+            return m_handle;
+        }
+
+        T await_resume() { return m_handle.promise().take(); }
+
+        /**
+         * @brief   在当前线程上运行任务直至结束
+         * @return  T 返回值
+         * @throw   std::logic_error 任务在中途挂起（须交给coro_pool运行）；协程体抛出的异常原样抛出
+         */
+        T run_inline()
+        {
+            m_handle.resume();
+            if (!m_handle.done())
+            {
+                throw std::logic_error("coro_task::run_inline() on a task that suspended.");
+            }
+            return m_handle.promise().take();
+        }
+
+    private:
+        std::coroutine_handle<promise_type> m_handle;   // 协程句柄
+
+        explicit coro_task(std::coroutine_handle<promise_type> handle) noexcept : m_handle(handle) {}
+
+        coro_task(const coro_task&) = delete;
+        coro_task& operator=(const coro_task&) = delete;
+    };
+}
+
+#endif // !CORO_TASK_HPP
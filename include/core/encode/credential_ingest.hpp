@@ -0,0 +1,92 @@
+#ifndef CREDENTIAL_INGEST_HPP
+#define CREDENTIAL_INGEST_HPP
+
+#include <string>
+
+#include "core/encode/slot_indicator.hpp"
+#include "core/hash/hash_adapter.hpp"
+
+/** @namespace 项目命名空间 */
+namespace mpmt
+{
+    /**
+     * @class   凭据编码流水线：CSV读入 -> 哈希 -> 槽位指示向量
+     * @note    1. 凭据文件以内存映射方式读入，按行边界切分给各工作线程。
+     *          2. 每行第一列（逗号之前，去除行尾\r与首尾空白）视为一条凭据，空行跳过。
+     *          3. 每条凭据经双重哈希得到k个槽位（k = 1时即 hash(凭据) mod num_slots），
+     *             多线程无锁置位到slot_indicator；k > 1时即为k哈希Bloom编码。
+     *          4. 各线程攒满mc_BATCH_SIZE条凭据后调用hash_adapter::indices_batch批量哈希。
+     */
+    class credential_ingest
+    {
+    public:
+        struct config
+        {
+            uint64_t m_num_slots;           // 槽位数（编码向量长度）
+            unsigned m_num_threads;         // 工作线程数，0表示使用硬件并发数
+            uint8_t m_num_hashes;           // 每条凭据的槽位数k，0按1处理
+        };
+
+        /**
+         * @brief   构造编码流水线
+         * @param   const config& cfg 编码配置
+         * @param   const hash_adapter& hasher 带密钥哈希（需线程安全）
+         * @throw   encode_exc 槽位数为0
+         */
+        credential_ingest(const config& cfg, const hash_adapter& hasher);
+
+        /**
+         * @brief   编码凭据文件
+         * @param   const std::string& csv_path 凭据文件路径
+         * @return  slot_indicator 槽位指示向量
+         * @throw   encode_exc 文件打开或映射失败
+         */
+        slot_indicator encode_file(const std::string& csv_path) const;
+
+        /**
+         * @brief   编码内存中的凭据文本
+         * @param   const char* text 文本首地址
+         * @param   uint64_t len 文本长度（字节）
+         * @return  slot_indicator 槽位指示向量
+         */
+        slot_indicator encode_buffer(const char* text, uint64_t len) const;
+
+        /**
+         * @brief   计算单条凭据的k个槽位（查询方使用同一映射）
+         * @param   const char* credential 凭据
+         * @param   uint64_t len 凭据长度（字节）
+         * @param   uint64_t* slots 输出槽位下标（k个）
+         * @return  void
+         */
+        void slots_of(const char* credential, uint64_t len, uint64_t* slots) const;
+
+        /**
+         * @brief   获取每条凭据的槽位数
+         * @return  uint8_t k
+         */
+        uint8_t num_hashes() const noexcept { return mc_num_hashes; }
+
+        /**
+         * @brief   获取实际使用的线程数
+         * @return  unsigned 线程数
+         */
+        unsigned num_threads() const noexcept { return m_num_threads; }
+
+    private:
+        const uint64_t mc_num_slots;            // 槽位数
+        const uint8_t mc_num_hashes;            // 每条凭据的槽位数
+        unsigned m_num_threads;                 // 工作线程数
+        const hash_adapter& m_hasher;           // 带密钥哈希
+
+        static constexpr uint64_t mc_MIN_BYTES_PER_THREAD = 1ULL << 20;  // 每线程最少处理的字节数
+        static constexpr uint64_t mc_BATCH_SIZE = 256ULL;               // 批量哈希的凭据条数
+
+        /**
+         * @brief   编码[begin, end)内的所有完整行
+         * @return  void
+         */
+        void encode_range(const char* begin, const char* end, slot_indicator& out) const;
+    };
+}
+
+#endif // !CREDENTIAL_INGEST_HPP
@@ -0,0 +1,138 @@
+#ifndef SET_LAYOUT_HPP
+#define SET_LAYOUT_HPP
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "core/hash/hash_adapter.hpp"
+#include "core/ring/rvector.hpp"
+
+/** @namespace 项目命名空间 */
+namespace mpmt
+{
+    /**
+     * @class   k哈希Bloom编码的参数工具
+     * @note    编码本身由credential_ingest完成（config::m_num_hashes = k），
+     *          多个持有方的Bloom编码可直接相加合并。
+     */
+    class bloom_layout
+    {
+    public:
+        /**
+         * @brief   估计Bloom编码的误判率 (1 - e^{-kn/m})^k
+         * @param   uint64_t n 元素个数
+         * @param   uint64_t num_slots 槽位数m
+         * @param   uint8_t k 哈希个数
+         * @return  double 误判率
+         */
+        static double expected_fpr(uint64_t n, uint64_t num_slots, uint8_t k) noexcept
+        {
+            if (num_slots == 0 || k == 0)
+            {
+                return 1.0;
+            }
+            const double c_fill = 1.0 - std::exp(-static_cast<double>(k) * n / num_slots);
+            return std::pow(c_fill, k);
+        }
+
+        /**
+         * @brief   计算使误判率最小的哈希个数 round(m/n * ln2)
+         * @param   uint64_t n 元素个数
+         * @param   uint64_t num_slots 槽位数m
+         * @return  uint8_t 哈希个数，至少为1
+         */
+        static uint8_t optimal_hashes(uint64_t n, uint64_t num_slots) noexcept
+        {
+            if (n == 0)
+            {
+                return 1;
+            }
+            const double c_k = std::round(static_cast<double>(num_slots) / n * std::log(2.0));
+            return static_cast<uint8_t>(std::min(64.0, std::max(1.0, c_k)));
+        }
+    };
+
+    /**
+     * @class   Cuckoo哈希表布局：每个元素在k个候选槽位之一存放其指纹
+     * @tparam  RT 环类型，限定为ring8,ring16,ring32,ring64（指纹位宽即环位宽）
+     * @note    1. 查询只需比较k（通常2-3）个候选槽位与指纹是否相等，而Bloom需访问k个槽位并求与。
+     *          2. 空槽位为0，指纹保证非0。
+     *          3. 不同表的槽位分配不同，不能像Bloom编码那样逐元素相加合并，
+     *             适用于单一集合（单个持有方或预先合并的并集）的编码。
+     */
+    template <typename RT>
+    class cuckoo_layout
+    {
+    public:
+        /** @brief 断言限制模板类型 */
+        static_assert(
+            is_word_ring_type<RT>,
+            "RT must be ring8, ring16, ring32, or ring64."
+            );
+
+        struct config
+        {
+            uint64_t m_num_slots;           // 槽位数
+            uint8_t m_num_hashes;           // 候选槽位个数k（2或3）
+            uint64_t m_max_kicks;           // 单次插入允许的最大踢出次数
+        };
+
+        /**
+         * @brief   构造Cuckoo布局
+         * @param   const config& cfg 布局配置
+         * @param   const hash_adapter& hasher 带密钥哈希
+         * @throw   encode_exc 参数不合法
+         */
+        cuckoo_layout(const config& cfg, const hash_adapter& hasher);
+
+        /**
+         * @brief   将n个元素编码为指纹表
+         * @param   const uint8_t* const* keys 元素首地址数组
+         * @param   const uint64_t* lens 元素长度数组
+         * @param   uint64_t n 元素个数
+         * @return  rvector<RT> 指纹表
+         * @throw   encode_exc 装载过高，插入失败
+         */
+        rvector<RT> encode(const uint8_t* const* keys, const uint64_t* lens, uint64_t n) const;
+
+        /**
+         * @brief   计算单个元素的候选槽位与指纹（查询方使用）
+         * @param   const uint8_t* key 元素
+         * @param   uint64_t len 元素长度
+         * @param   uint64_t* slots 输出候选槽位（k个）
+         * @return  RT 指纹
+         */
+        RT locate(const uint8_t* key, uint64_t len, uint64_t* slots) const;
+
+        /**
+         * @brief   估计查询误判率：k个候选槽位中任一被其他元素的相同指纹占据的概率
+         * @param   uint64_t n 已编码的元素个数
+         * @return  double 误判率
+         */
+        double expected_fpr(uint64_t n) const noexcept;
+
+        /**
+         * @brief   获取候选槽位个数
+         * @return  uint8_t k
+         */
+        uint8_t num_hashes() const noexcept { return mc_config.m_num_hashes; }
+
+    private:
+        const config mc_config;             // 布局配置
+        const hash_adapter& m_hasher;       // 带密钥哈希
+
+        static constexpr uint64_t mc_EMPTY = ~uint64_t(0);  // 空槽位标识
+
+        /** @brief 由哈希值派生非0指纹 */
+        static RT fingerprint(uint64_t h) noexcept
+        {
+            const RT fp = static_cast<RT>(hash_adapter::remix(h ^ 0x9e3779b97f4a7c15ULL));
+            return fp == 0 ? RT(1) : fp;
+        }
+    };
+}
+
+#include "core/encode/set_layout.tpp"
+
+#endif // !SET_LAYOUT_HPP
@@ -0,0 +1,112 @@
+#include <string>
+#include <utility>
+
+#include "core/exception/encode_exc.hpp"
+
+/** @namespace 项目命名空间 */
+namespace mpmt
+{
+    template <typename RT>
+    cuckoo_layout<RT>::cuckoo_layout(const config& cfg, const hash_adapter& hasher)
+        :
+        mc_config(cfg),
+        m_hasher(hasher)
+    {
+        if (cfg.m_num_slots == 0 || cfg.m_num_hashes < 2)
+        {
+            throw encode_exc
+            (
+                encode_exc::exc_type::INVALID_PARAMETER,
+                "cuckoo_layout requires a non-zero number of slots and at least 2 hash functions."
+            );
+        }
+    }
+
+    template <typename RT>
+    rvector<RT> cuckoo_layout<RT>::encode(const uint8_t* const* keys, const uint64_t* lens, uint64_t n) const
+    {
+        const uint8_t k = mc_config.m_num_hashes;
+        if (n > mc_config.m_num_slots)
+        {
+            throw encode_exc
+            (
+                encode_exc::exc_type::CAPACITY_EXCEEDED,
+                "cannot place " + std::to_string(n) + " element(s) into "
+                + std::to_string(mc_config.m_num_slots) + " slot(s)."
+            );
+        }
+
+        // 1-批量计算所有元素的候选槽位与指纹
+        std::vector<uint64_t> hashes(n);
+        std::vector<uint64_t> cand(n * k);
+        m_hasher.hash_batch(keys, lens, n, hashes.data());
+        m_hasher.indices_batch(keys, lens, n, k, mc_config.m_num_slots, cand.data());
+
+        // 2-逐个插入，候选位均被占用时踢出占用者并为其另寻位置
+        std::vector<uint64_t> owner(mc_config.m_num_slots, mc_EMPTY);
+        uint64_t walk = 0x2545f4914f6cdd1dULL;      // 随机游走状态（xorshift64），只影响布局不影响正确性
+        for (uint64_t i = 0; i < n; ++i)
+        {
+            uint64_t cur = i;
+            uint64_t kicks = 0;
+            bool placed = false;
+            while (!placed)
+            {
+                for (uint8_t j = 0; j < k; ++j)
+                {
+                    const uint64_t s = cand[cur * k + j];
+                    if (owner[s] == mc_EMPTY)
+                    {
+                        owner[s] = cur;
+                        placed = true;
+                        break;
+                    }
+                }
+                if (placed)
+                {
+                    break;
+                }
+                if (kicks++ >= mc_config.m_max_kicks)
+                {
+                    throw encode_exc
+                    (
+                        encode_exc::exc_type::CAPACITY_EXCEEDED,
+                        "cuckoo insertion failed after " + std::to_string(mc_config.m_max_kicks)
+                        + " kick(s) at element " + std::to_string(i) + " of " + std::to_string(n)
+                        + "; increase the number of slots or hash functions."
+                    );
+                }
+                // 随机选择被踢出的候选位，避免在固定的几个位置间循环往复
+                walk ^= walk << 13;
+                walk ^= walk >> 7;
+                walk ^= walk << 17;
+                const uint64_t s = cand[cur * k + walk % k];
+                std::swap(cur, owner[s]);
+            }
+        }
+
+        // 3-写入指纹
+        rvector<RT> table(mc_config.m_num_slots);
+        RT* out = table.data();
+        for (uint64_t s = 0; s < mc_config.m_num_slots; ++s)
+        {
+            out[s] = (owner[s] == mc_EMPTY) ? RT(0) : fingerprint(hashes[owner[s]]);
+        }
+        return table;
+    }
+
+    template <typename RT>
+    RT cuckoo_layout<RT>::locate(const uint8_t* key, uint64_t len, uint64_t* slots) const
+    {
+        m_hasher.indices_batch(&key, &len, 1, mc_config.m_num_hashes, mc_config.m_num_slots, slots);
+        return fingerprint(m_hasher.hash(key, len));
+    }
+
+    template <typename RT>
+    double cuckoo_layout<RT>::expected_fpr(uint64_t n) const noexcept
+    {
+        const double c_load = static_cast<double>(n) / mc_config.m_num_slots;
+        const double c_collide = c_load / (std::pow(2.0, 8.0 * sizeof(RT)) - 1.0);
+        return 1.0 - std::pow(1.0 - c_collide, mc_config.m_num_hashes);
+    }
+}
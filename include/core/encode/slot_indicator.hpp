@@ -0,0 +1,169 @@
+#ifndef SLOT_INDICATOR_HPP
+#define SLOT_INDICATOR_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "core/mpmtcfg.hpp"
+#include "core/ring/rvector.hpp"
+
+/** @namespace 项目命名空间 */
+namespace mpmt
+{
+    /**
+     * @class   位压缩的槽位指示向量
+     * @note    1. 每个槽位占1位，以64位原子字存储，多线程可无锁并发置位。
+     *          2. to_rvector()将指示向量展开为环上0/1向量，作为秘密分享的输入。
+     */
+    class slot_indicator
+    {
+    public:
+        /**
+         * @brief   构造全零指示向量
+         * @param   uint64_t num_slots 槽位数
+         */
+        explicit slot_indicator(uint64_t num_slots)
+            :
+            m_words(std::make_unique<std::atomic<uint64_t>[]>(word_count(num_slots))),
+            m_num_slots(num_slots)
+        {
+            for (uint64_t i = 0; i < word_count(num_slots); ++i)
+            {
+                m_words[i].store(0, std::memory_order_relaxed);
+            }
+        }
+
+        slot_indicator(slot_indicator&&) noexcept = default;
+        slot_indicator& operator=(slot_indicator&&) noexcept = default;
+
+        /**
+         * @brief   并发安全地置位
+         * @param   uint64_t slot 槽位下标
+         * @return  void
+         */
+        void set(uint64_t slot) noexcept
+        {
+            MPMT_ASSERT(slot < m_num_slots, "Slot index out of range.");
+            m_words[slot >> 6].fetch_or(uint64_t(1) << (slot & 63), std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief   查询槽位
+         * @param   uint64_t slot 槽位下标
+         * @return  bool 是否置位
+         */
+        bool test(uint64_t slot) const noexcept
+        {
+            MPMT_ASSERT(slot < m_num_slots, "Slot index out of range.");
+            return (m_words[slot >> 6].load(std::memory_order_relaxed) >> (slot & 63)) & 1;
+        }
+
+        /**
+         * @brief   统计已置位槽位数
+         * @return  uint64_t 置位数
+         */
+        uint64_t count() const noexcept
+        {
+            uint64_t total = 0;
+            for (uint64_t i = 0; i < word_count(m_num_slots); ++i)
+            {
+                total += static_cast<uint64_t>(__builtin_popcountll(m_words[i].load(std::memory_order_relaxed)));
+            }
+            return total;
+        }
+
+        /**
+         * @brief   获取槽位数
+         * @return  uint64_t 槽位数
+         */
+        uint64_t size() const noexcept { return m_num_slots; }
+
+        /**
+         * @brief   展开[offset, offset + len)区间为环上0/1值，供流水线逐块编码
+         * @tparam  RT 环类型
+         * @param   uint64_t offset 起始槽位
+         * @param   RT* out 输出，至少len个元素
+         * @param   uint64_t len 槽位个数
+         * @return  void
+         */
+        template <typename RT>
+        void expand_into(uint64_t offset, RT* out, uint64_t len) const
+        {
+            MPMT_ASSERT(offset + len <= m_num_slots, "Slot range out of range.");
+            // 每个原子字只读取一次，再逐位展开
+            uint64_t slot = offset;
+            const uint64_t c_end = offset + len;
+            while (slot < c_end)
+            {
+                const uint64_t c_bits = m_words[slot >> 6].load(std::memory_order_relaxed);
+                const uint64_t c_word_end = std::min<uint64_t>((slot | 63) + 1, c_end);
+                for (; slot < c_word_end; ++slot)
+                {
+                    *out++ = RT(static_cast<uint8_t>((c_bits >> (slot & 63)) & 1));
+                }
+            }
+        }
+
+        /**
+         * @brief   并行展开为环上0/1向量
+         * @tparam  RT 环类型
+         * @param   unsigned num_threads 线程数
+         * @return  rvector<RT> 指示向量
+         */
+        template <typename RT>
+        rvector<RT> to_rvector(unsigned num_threads) const
+        {
+            rvector<RT> result(m_num_slots);
+            RT* out = result.data();
+
+            // 按64槽位对齐划分，避免线程间共享同一个原子字
+            const uint64_t c_words = word_count(m_num_slots);
+            const uint64_t c_threads = std::max<uint64_t>(1, std::min<uint64_t>(num_threads, c_words));
+            const uint64_t c_per_thread = (c_words + c_threads - 1) / c_threads;
+
+            auto worker = [&](uint64_t wb, uint64_t we)
+            {
+                for (uint64_t w = wb; w < we; ++w)
+                {
+                    const uint64_t c_bits = m_words[w].load(std::memory_order_relaxed);
+                    const uint64_t c_end = std::min<uint64_t>((w + 1) << 6, m_num_slots);
+                    for (uint64_t s = w << 6; s < c_end; ++s)
+                    {
+                        out[s] = RT(static_cast<uint8_t>((c_bits >> (s & 63)) & 1));
+                    }
+                }
+            };
+
+            std::vector<std::thread> pool;
+            for (uint64_t t = 1; t < c_threads; ++t)
+            {
+                const uint64_t wb = t * c_per_thread;
+                if (wb >= c_words)
+                {
+                    break;
+                }
+                pool.emplace_back(worker, wb, std::min(c_words, wb + c_per_thread));
+            }
+            worker(0, std::min(c_words, c_per_thread));
+            for (std::thread& th : pool)
+            {
+                th.join();
+            }
+            return result;
+        }
+
+    private:
+        std::unique_ptr<std::atomic<uint64_t>[]> m_words;   // 位存储
+        uint64_t m_num_slots;                               // 槽位数
+
+        static constexpr uint64_t word_count(uint64_t num_slots) noexcept
+        {
+            return (num_slots + 63) >> 6;
+        }
+    };
+}
+
+#endif // !SLOT_INDICATOR_HPP
@@ -0,0 +1,54 @@
+#ifndef COMM_EXC_HPP
+#define COMM_EXC_HPP
+
+#include <string>
+#include <stdexcept>
+#include "core/mpmtcfg.hpp"
+
+/** @namespace 项目命名空间 */
+namespace mpmt
+{
+    class comm_exc : public std::runtime_error
+    {
+    public:
+        enum class exc_type
+        {
+            CONNECTION_CLOSED,              // 连接已关闭
+            MESSAGE_MISMATCH,               // 收到的报文与接收接口不匹配
+        };
+
+        explicit comm_exc
+        (
+            const exc_type& type,
+            const std::string& info
+        ) :
+            std::runtime_error(build_message(type, info)),
+            m_type(type)
+        {}
+
+        exc_type get_exc_type() const noexcept
+        {
+            return m_type;
+        }
+
+    private:
+        exc_type m_type;
+
+        static std::string build_message(exc_type type, const std::string& info)
+        {
+            switch (type)
+            {
+            case exc_type::CONNECTION_CLOSED:
+                return "Comm Connection Closed: " + info;
+
+            case exc_type::MESSAGE_MISMATCH:
+                return "Comm Message Mismatch: " + info;
+
+            default:
+                MPMT_WARN(false, "Undefined comm_exc::exc_type.");
+                return "Comm Unknown Exception: " + info;
+            }
+        }
+    };
+}
+#endif // !COMM_EXC_HPP
@@ -0,0 +1,58 @@
+#ifndef ENCODE_EXC_HPP
+#define ENCODE_EXC_HPP
+
+#include <string>
+#include <stdexcept>
+#include "core/mpmtcfg.hpp"
+
+/** @namespace 项目命名空间 */
+namespace mpmt
+{
+    class encode_exc : public std::runtime_error
+    {
+    public:
+        enum class exc_type
+        {
+            IOFLOW_ERROR,                   // 打开或映射凭据文件失败
+            INVALID_PARAMETER,              // 编码参数不合法
+            CAPACITY_EXCEEDED,              // 哈希表装载过高，无法完成插入
+        };
+
+        explicit encode_exc
+        (
+            const exc_type& type,
+            const std::string& info
+        ) :
+            std::runtime_error(build_message(type, info)),
+            m_type(type)
+        {}
+
+        exc_type get_exc_type() const noexcept
+        {
+            return m_type;
+        }
+
+    private:
+        exc_type m_type;
+
+        static std::string build_message(exc_type type, const std::string& info)
+        {
+            switch (type)
+            {
+            case exc_type::IOFLOW_ERROR:
+                return "Encode I/O Error: " + info;
+
+            case exc_type::INVALID_PARAMETER:
+                return "Encode Invalid Parameter: " + info;
+
+            case exc_type::CAPACITY_EXCEEDED:
+                return "Encode Capacity Exceeded: " + info;
+
+            default:
+                MPMT_WARN(false, "Undefined encode_exc::exc_type.");
+                return "Encode Unknown Exception: " + info;
+            }
+        }
+    };
+}
+#endif // !ENCODE_EXC_HPP
@@ -15,6 +15,8 @@ namespace mpmt
             IOFLOW_ERROR,                   // 打开文件失败
             RING_SIZE_MISMATCH,             // 文件RingSize与程序预设参数不匹配，
             FILE_CORRUPTION,                // 文件损坏 
+            VERSION_UNSUPPORTED,            // 文件格式版本不支持该操作
+            CODEC_UNSUPPORTED,              // 块编码方式在当前构建中不可用
         };
 
         explicit mrvf_exc
@@ -41,6 +43,12 @@ namespace mpmt
             case exc_type::RING_SIZE_MISMATCH:
                 return "MRVF Ring Size Mismatch Error: " + info;
 
+            case exc_type::VERSION_UNSUPPORTED:
+                return "MRVF Version Unsupported: " + info;
+
+            case exc_type::CODEC_UNSUPPORTED:
+                return "MRVF Codec Unsupported: " + info;
+
             default:
                 MPMT_WARN(false, "Undefined mrvf_exc::exc_type.");
                 return "MRVF Unknown Exception: " + info;
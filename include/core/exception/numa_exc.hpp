@@ -0,0 +1,50 @@
+#ifndef NUMA_EXC_HPP
+#define NUMA_EXC_HPP
+
+#include <string>
+#include <stdexcept>
+#include "core/mpmtcfg.hpp"
+
+/** @namespace 项目命名空间 */
+namespace mpmt
+{
+    class numa_exc : public std::runtime_error
+    {
+    public:
+        enum class exc_type
+        {
+            INVALID_PARAMETER,              // 无法识别的放置策略名称
+        };
+
+        explicit numa_exc
+        (
+            const exc_type& type,
+            const std::string& info
+        ) :
+            std::runtime_error(build_message(type, info)),
+            m_type(type)
+        {}
+
+        exc_type get_exc_type() const noexcept
+        {
+            return m_type;
+        }
+
+    private:
+        exc_type m_type;
+
+        static std::string build_message(exc_type type, const std::string& info)
+        {
+            switch (type)
+            {
+            case exc_type::INVALID_PARAMETER:
+                return "NUMA Invalid Parameter: " + info;
+
+            default:
+                MPMT_WARN(false, "Undefined numa_exc::exc_type.");
+                return "NUMA Unknown Exception: " + info;
+            }
+        }
+    };
+}
+#endif // !NUMA_EXC_HPP
@@ -0,0 +1,62 @@
+#ifndef PROTOCOL_EXC_HPP
+#define PROTOCOL_EXC_HPP
+
+#include <string>
+#include <stdexcept>
+#include "core/mpmtcfg.hpp"
+
+/** @namespace 项目命名空间 */
+namespace mpmt
+{
+    class protocol_exc : public std::runtime_error
+    {
+    public:
+        enum class exc_type
+        {
+            UNSUPPORTED_OPERATION,          // 当前参与方不具备该理想功能
+            INVALID_STATE,                  // 协议状态不满足调用前置条件
+            MESSAGE_CORRUPTION,             // 收到的协议报文格式或长度错误
+            INVALID_PARAMETER,              // 协议参数不合法
+        };
+
+        explicit protocol_exc
+        (
+            const exc_type& type,
+            const std::string& info
+        ) :
+            std::runtime_error(build_message(type, info)),
+            m_type(type)
+        {}
+
+        exc_type get_exc_type() const noexcept
+        {
+            return m_type;
+        }
+
+    private:
+        exc_type m_type;
+
+        static std::string build_message(exc_type type, const std::string& info)
+        {
+            switch (type)
+            {
+            case exc_type::UNSUPPORTED_OPERATION:
+                return "Protocol Unsupported Operation: " + info;
+
+            case exc_type::INVALID_STATE:
+                return "Protocol Invalid State: " + info;
+
+            case exc_type::MESSAGE_CORRUPTION:
+                return "Protocol Message Corruption: " + info;
+
+            case exc_type::INVALID_PARAMETER:
+                return "Protocol Invalid Parameter: " + info;
+
+            default:
+                MPMT_WARN(false, "Undefined protocol_exc::exc_type.");
+                return "Protocol Unknown Exception: " + info;
+            }
+        }
+    };
+}
+#endif // !PROTOCOL_EXC_HPP
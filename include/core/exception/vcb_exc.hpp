@@ -0,0 +1,54 @@
+#ifndef VCB_EXC_HPP
+#define VCB_EXC_HPP
+
+#include <string>
+#include <stdexcept>
+#include "core/mpmtcfg.hpp"
+
+/** @namespace 项目命名空间 */
+namespace mpmt
+{
+    class vcb_exc : public std::runtime_error
+    {
+    public:
+        enum class exc_type
+        {
+            UNSUPPORTED_ISA,                // 当前CPU或构建不支持所选指令集
+            INVALID_PARAMETER,              // 无法识别的后端名称
+        };
+
+        explicit vcb_exc
+        (
+            const exc_type& type,
+            const std::string& info
+        ) :
+            std::runtime_error(build_message(type, info)),
+            m_type(type)
+        {}
+
+        exc_type get_exc_type() const noexcept
+        {
+            return m_type;
+        }
+
+    private:
+        exc_type m_type;
+
+        static std::string build_message(exc_type type, const std::string& info)
+        {
+            switch (type)
+            {
+            case exc_type::UNSUPPORTED_ISA:
+                return "Vector Backend Unsupported ISA: " + info;
+
+            case exc_type::INVALID_PARAMETER:
+                return "Vector Backend Invalid Parameter: " + info;
+
+            default:
+                MPMT_WARN(false, "Undefined vcb_exc::exc_type.");
+                return "Vector Backend Unknown Exception: " + info;
+            }
+        }
+    };
+}
+#endif // !VCB_EXC_HPP
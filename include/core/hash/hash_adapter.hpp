@@ -1,19 +1,141 @@
 #ifndef HASH_ADAPTER
 #define HASH_ADAPTER
 
+#include <cstdint>
+#include <vector>
 
 /** @namespace 项目命名空间 */
 namespace mpmt
 {
-    class hash_adpter
+    /**
+     * @class   哈希适配器，用于封装不同实现的带密钥哈希接口。
+     * @note    数据持有方与查询方需使用相同的密钥，以保证同一凭据映射到同一槽位。
+     */
+    class hash_adapter
     {
     public:
-        hash_adpter();
-        void hash();
-    private:
+        /**
+         * @brief   计算字节串的64位哈希值。
+         * @param   const uint8_t* data 数据
+         * @param   uint64_t len 数据长度（字节）
+         * @return  uint64_t 哈希值
+         */
+        virtual uint64_t hash(const uint8_t* data, uint64_t len) const noexcept = 0;
 
+        /**
+         * @brief   批量计算n个字节串的64位哈希值。
+         * @param   const uint8_t* const* keys 字节串首地址数组
+         * @param   const uint64_t* lens 字节串长度数组
+         * @param   uint64_t n 字节串个数
+         * @param   uint64_t* out 输出哈希值数组（n个）
+         * @return  void
+         * @note    默认逐个调用hash()，实现类可重写为多路并行版本。
+         */
+        virtual void hash_batch
+        (
+            const uint8_t* const* keys,
+            const uint64_t* lens,
+            uint64_t n,
+            uint64_t* out
+        ) const noexcept
+        {
+            for (uint64_t i = 0; i < n; ++i)
+            {
+                out[i] = hash(keys[i], lens[i]);
+            }
+        }
+
+        /**
+         * @brief   计算字节串的128位哈希值（两个64位字）。
+         * @param   const uint8_t* data 数据
+         * @param   uint64_t len 数据长度（字节）
+         * @param   uint64_t* out 输出哈希值（2个字）
+         * @return  void
+         * @note    两个字应近似独立，且与hash()的输出近似独立。
+         */
+        virtual void hash128(const uint8_t* data, uint64_t len, uint64_t* out) const noexcept = 0;
+
+        /**
+         * @brief   批量计算n个字节串的128位哈希值。
+         * @param   const uint8_t* const* keys 字节串首地址数组
+         * @param   const uint64_t* lens 字节串长度数组
+         * @param   uint64_t n 字节串个数
+         * @param   uint64_t* out 输出哈希值数组（2n个，按字节串连续存放）
+         * @return  void
+         * @note    默认逐个调用hash128()，实现类可重写为多路并行版本。
+         */
+        virtual void hash128_batch
+        (
+            const uint8_t* const* keys,
+            const uint64_t* lens,
+            uint64_t n,
+            uint64_t* out
+        ) const noexcept
+        {
+            for (uint64_t i = 0; i < n; ++i)
+            {
+                hash128(keys[i], lens[i], out + 2 * i);
+            }
+        }
+
+        /**
+         * @brief   批量计算n个字节串各自的k个槽位下标（双重哈希 g_j = h1 + j * h2 mod m）。
+         * @param   const uint8_t* const* keys 字节串首地址数组
+         * @param   const uint64_t* lens 字节串长度数组
+         * @param   uint64_t n 字节串个数
+         * @param   uint8_t k 每个字节串的下标个数
+         * @param   uint64_t num_slots 槽位数m
+         * @param   uint64_t* out 输出下标数组（n * k个，按字节串连续存放）
+         * @return  void
+         * @note    h1、h2取hash128()的两个字，步长h2 mod m落在[1, m)内，m为素数时k个下标两两不同；
+         *          下标在模m下递推，不受j * h2溢出影响。
+         */
+        void indices_batch
+        (
+            const uint8_t* const* keys,
+            const uint64_t* lens,
+            uint64_t n,
+            uint8_t k,
+            uint64_t num_slots,
+            uint64_t* out
+        ) const
+        {
+            std::vector<uint64_t> hashes(2 * n);
+            hash128_batch(keys, lens, n, hashes.data());
+            for (uint64_t i = 0; i < n; ++i)
+            {
+                const uint64_t c_step = num_slots > 1 ? 1 + hashes[2 * i + 1] % (num_slots - 1) : 0;
+                uint64_t slot = hashes[2 * i] % num_slots;
+                for (uint8_t j = 0; j < k; ++j)
+                {
+                    out[i * k + j] = slot;
+                    slot += c_step;
+                    slot -= (slot >= num_slots) ? num_slots : 0;
+                }
+            }
+        }
+
+        /**
+         * @brief   64位混合函数（murmur3 fmix64），用于由哈希值派生指纹等附加位。
+         * @param   uint64_t h 哈希值
+         * @return  uint64_t 混合结果
+         */
+        static constexpr uint64_t remix(uint64_t h) noexcept
+        {
+            h ^= h >> 33;
+            h *= 0xff51afd7ed558ccdULL;
+            h ^= h >> 33;
+            h *= 0xc4ceb9fe1a85ec53ULL;
+            h ^= h >> 33;
+            return h;
+        }
+
+        /**
+         * @brief   析构接口。
+         */
+        virtual ~hash_adapter() = default;
     };
 }
 
 
-#endif // !HASH_ADAPTER
\ No newline at end of file
+#endif // !HASH_ADAPTER
@@ -0,0 +1,90 @@
+#ifndef HASH_SIPHASH_HPP
+#define HASH_SIPHASH_HPP
+
+#include <array>
+#include "core/hash/hash_adapter.hpp"
+
+/** @namespace 项目命名空间 */
+namespace mpmt
+{
+    /**
+     * @class   使用SipHash-2-4实现的哈希适配器
+     * @note    SipHash为带128位密钥的短输入PRF，适合凭据这类短字符串的快速哈希。
+     */
+    class hash_siphash : public hash_adapter
+    {
+    public:
+        static constexpr uint64_t mc_KEY_BYTE_SIZE = 16ULL;    // 密钥长度
+
+        using key_type = std::array<uint8_t, mc_KEY_BYTE_SIZE>;
+
+        /**
+         * @brief   以密钥构造
+         * @param   const key_type& key 128位密钥
+         */
+        explicit hash_siphash(const key_type& key) noexcept;
+
+        /**
+         * @brief   计算字节串的SipHash-2-4值。
+         * @param   const uint8_t* data 数据
+         * @param   uint64_t len 数据长度（字节）
+         * @return  uint64_t 哈希值
+         */
+        uint64_t hash(const uint8_t* data, uint64_t len) const noexcept override;
+
+        /**
+         * @brief   批量计算SipHash-2-4值，每mc_LANES个字节串交错计算。
+         * @param   const uint8_t* const* keys 字节串首地址数组
+         * @param   const uint64_t* lens 字节串长度数组
+         * @param   uint64_t n 字节串个数
+         * @param   uint64_t* out 输出哈希值数组（n个）
+         * @return  void
+         * @note    各路状态以定长数组存放、按路无分支更新，多条相互独立的依赖链交错执行以利用指令级并行。
+         */
+        void hash_batch
+        (
+            const uint8_t* const* keys,
+            const uint64_t* lens,
+            uint64_t n,
+            uint64_t* out
+        ) const noexcept override;
+
+        /**
+         * @brief   计算字节串的SipHash-2-4-128值（128位输出变体，与hash()的输出近似独立）。
+         * @param   const uint8_t* data 数据
+         * @param   uint64_t len 数据长度（字节）
+         * @param   uint64_t* out 输出哈希值（2个字）
+         * @return  void
+         */
+        void hash128(const uint8_t* data, uint64_t len, uint64_t* out) const noexcept override;
+
+        /**
+         * @brief   批量计算SipHash-2-4-128值，交错方式同hash_batch()。
+         * @param   const uint8_t* const* keys 字节串首地址数组
+         * @param   const uint64_t* lens 字节串长度数组
+         * @param   uint64_t n 字节串个数
+         * @param   uint64_t* out 输出哈希值数组（2n个，按字节串连续存放）
+         * @return  void
+         */
+        void hash128_batch
+        (
+            const uint8_t* const* keys,
+            const uint64_t* lens,
+            uint64_t n,
+            uint64_t* out
+        ) const noexcept override;
+
+        /**
+         * @brief   析构接口。
+         */
+        ~hash_siphash() override = default;
+
+    private:
+        static constexpr uint64_t mc_LANES = 4ULL;            // 交错计算的路数
+
+        uint64_t m_k0;      // 密钥低64位
+        uint64_t m_k1;      // 密钥高64位
+    };
+}
+
+#endif // !HASH_SIPHASH_HPP
@@ -0,0 +1,116 @@
+#ifndef IO_DIRECT_HPP
+#define IO_DIRECT_HPP
+
+#include <memory>
+#include <string>
+
+#include "core/io/io_adapter.hpp"
+
+/** @namespace 项目命名空间 */
+namespace mpmt
+{
+    namespace verborgen
+    {
+        class uring;
+    }
+
+    /**
+     * @class   绕过页缓存的随机访问文件（Linux）
+     * @note    1. 以O_DIRECT打开文件，读写均经对齐的暂存区按mc_ALIGN对齐后进行；
+     *             非对齐的首尾扇区先读出再合并写回，文件长度在sync()或析构时截断为逻辑长度。
+     *          2. 大块读写切分为chunk_bytes的片段，经io_uring保持至多queue_depth个请求在途；
+     *             内核不支持io_uring或被禁用（环境变量 MPMT_IO_URING=0）时退化为逐片pread/pwrite。
+     *             io_uring_enter失败时先撤销（IORING_OP_ASYNC_CANCEL）并回收全部在途请求，再放弃io_uring，
+     *             被撤销与未提交的片段改为同步读写；在途请求无法回收时放弃（不释放）暂存区后抛出异常。
+     *          3. 文件系统不支持O_DIRECT时退化为普通读写，并在每次读写后逐出对应的页缓存。
+     *          4. supported()首次调用时试建一个io_uring实例并缓存结果，内核不支持或被禁用时返回false，
+     *             调用方应退回普通文件读写；非Linux平台始终返回false，构造时抛出异常。
+     *          5. 对象非线程安全。
+     */
+    class io_direct : public io_adapter
+    {
+    public:
+        static constexpr uint64_t mc_ALIGN = 4096;                          // 偏移、长度与缓存区的对齐粒度
+        static constexpr uint32_t mc_DEFAULT_QUEUE_DEPTH = 8;               // 默认在途请求数
+        static constexpr uint32_t mc_DEFAULT_CHUNK_BYTES = 1U << 20;        // 默认单个请求长度
+
+        /**
+         * @brief   打开文件
+         * @param   const std::string& path 文件路径
+         * @param   io_mode mode 打开方式
+         * @param   uint32_t queue_depth 在途请求数
+         * @param   uint32_t chunk_bytes 单个请求长度，须为mc_ALIGN的整数倍
+         * @throw   std::runtime_error 参数不合法、平台不支持或打开失败
+         */
+        io_direct
+        (
+            const std::string& path,
+            io_mode mode,
+            uint32_t queue_depth = mc_DEFAULT_QUEUE_DEPTH,
+            uint32_t chunk_bytes = mc_DEFAULT_CHUNK_BYTES
+        );
+
+        uint64_t size() const override { return m_size; }
+        void read_at(uint64_t offset, uint8_t* out, uint64_t len) override;
+        void write_at(uint64_t offset, const uint8_t* data, uint64_t len) override;
+        void sync() override;
+        ~io_direct() override;
+
+        /**
+         * @brief   当前使用的读写方式
+         * @return  const char* "io_uring+O_DIRECT"、"pread+O_DIRECT"或"pread+fadvise"
+         */
+        const char* backend() const noexcept;
+
+        /**
+         * @brief   当前平台是否支持本实现
+         * @return  bool
+         */
+        static bool supported() noexcept;
+
+    private:
+        static constexpr uint32_t mc_DRAIN_RETRIES = 1000;  // 回收在途请求时EAGAIN/EBUSY的重试次数
+
+        /** @brief 对齐内存的释放器 */
+        struct aligned_deleter
+        {
+            void operator()(uint8_t* ptr) const noexcept;
+        };
+
+        const std::string mc_path;                      // 文件路径（用于错误信息）
+        const io_mode mc_mode;                          // 打开方式
+        const uint32_t mc_queue_depth;                  // 在途请求数
+        const uint32_t mc_chunk_bytes;                  // 单个请求长度
+        int m_fd;                                       // 文件描述符
+        bool m_direct;                                  // 是否以O_DIRECT打开
+        bool m_padded;                                  // 物理长度是否因对齐写入超出逻辑长度
+        uint64_t m_size;                                // 逻辑长度
+        std::unique_ptr<uint8_t, aligned_deleter> m_pool;   // queue_depth个请求的暂存区
+        std::unique_ptr<uint8_t, aligned_deleter> m_edge;   // 首尾扇区暂存区（2 * mc_ALIGN）
+        std::unique_ptr<verborgen::uring> m_ring;       // io_uring实例，为空时使用pread/pwrite
+
+        /**
+         * @brief   对齐区间[a0, a1)的分片传输
+         * @param   uint64_t a0, a1 对齐的文件区间
+         * @param   bool write 是否为写入
+         * @param   FN&& fn 写入前填充或读取后取出片段：fn(片段偏移, 暂存区, 片段长度, 实际读到的长度)
+         * @return  void
+         */
+        template <typename FN>
+        void transfer(uint64_t a0, uint64_t a1, bool write, FN&& fn);
+
+        /** @brief 同步读取一个对齐片段，返回实际读到的长度（文件末尾处可能不足） */
+        uint64_t pread_full(uint64_t offset, uint8_t* buf, uint64_t len);
+
+        /** @brief 同步写入一个对齐片段 */
+        void pwrite_full(uint64_t offset, const uint8_t* buf, uint64_t len);
+
+        /** @brief 非O_DIRECT退化模式下逐出区间的页缓存 */
+        void drop_cache(uint64_t a0, uint64_t a1, bool written) noexcept;
+
+        io_direct(const io_direct&) = delete;
+        io_direct& operator=(const io_direct&) = delete;
+    };
+}
+
+#endif // !IO_DIRECT_HPP
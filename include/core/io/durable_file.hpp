@@ -0,0 +1,43 @@
+#ifndef DURABLE_FILE_HPP
+#define DURABLE_FILE_HPP
+
+#include <string>
+
+/** @namespace 项目命名空间 */
+namespace mpmt
+{
+    /**
+     * @namespace   原子替换文件：先完整写入临时文件，落盘后再重命名为目标文件
+     * @note        1. 写入方向temp_path(path)写完整内容后调用commit()；崩溃时目标文件要么是旧内容，要么是完整的新内容，
+     *                 残留的临时文件可直接覆盖。
+     *              2. commit()依次同步临时文件、重命名、同步所在目录，返回即表示新内容已持久化。
+     *              3. 失败时抛出std::runtime_error，由调用方转换为模块异常。
+     */
+    namespace durable_file
+    {
+        /**
+         * @brief   获取目标文件对应的临时文件路径（同一目录，保证重命名不跨文件系统）
+         * @param   const std::string& path 目标文件路径
+         * @return  std::string 临时文件路径
+         */
+        std::string temp_path(const std::string& path);
+
+        /**
+         * @brief   将已写完并关闭的临时文件原子替换为目标文件
+         * @param   const std::string& temp 临时文件路径
+         * @param   const std::string& path 目标文件路径
+         * @return  void
+         * @throw   std::runtime_error 同步或重命名失败
+         */
+        void commit(const std::string& temp, const std::string& path);
+
+        /**
+         * @brief   删除文件，文件不存在时忽略
+         * @param   const std::string& path 文件路径
+         * @return  void
+         */
+        void remove(const std::string& path) noexcept;
+    }
+}
+
+#endif // !DURABLE_FILE_HPP
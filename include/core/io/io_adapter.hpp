@@ -0,0 +1,65 @@
+#ifndef IO_ADAPTER_HPP
+#define IO_ADAPTER_HPP
+
+#include <cstdint>
+
+/** @namespace 项目命名空间 */
+namespace mpmt
+{
+    /** @brief 文件打开方式 */
+    enum class io_mode : uint8_t
+    {
+        READ = 0,           // 只读打开已有文件
+        READ_WRITE = 1,     // 读写打开已有文件
+        CREATE = 2,         // 新建（或截断）文件并读写
+    };
+
+    /**
+     * @class   随机访问文件适配器，用于封装不同实现的文件读写接口
+     * @note    1. 所有读写均以绝对偏移定位，不维护文件指针，便于按块随机访问。
+     *          2. 读写失败（含短读）时抛出std::runtime_error，由调用方转换为模块异常。
+     */
+    class io_adapter
+    {
+    public:
+        /**
+         * @brief   获取文件当前大小
+         * @return  uint64_t 文件大小（字节）
+         */
+        virtual uint64_t size() const = 0;
+
+        /**
+         * @brief   从offset处读取len字节
+         * @param   uint64_t offset 文件偏移
+         * @param   uint8_t* out 输出缓存区
+         * @param   uint64_t len 读取长度
+         * @return  void
+         * @throw   std::runtime_error 读取失败或越过文件末尾
+         */
+        virtual void read_at(uint64_t offset, uint8_t* out, uint64_t len) = 0;
+
+        /**
+         * @brief   向offset处写入len字节，必要时扩展文件
+         * @param   uint64_t offset 文件偏移
+         * @param   const uint8_t* data 数据
+         * @param   uint64_t len 写入长度
+         * @return  void
+         * @throw   std::runtime_error 写入失败或以只读方式打开
+         */
+        virtual void write_at(uint64_t offset, const uint8_t* data, uint64_t len) = 0;
+
+        /**
+         * @brief   将已写入的数据同步到存储设备
+         * @return  void
+         * @throw   std::runtime_error 同步失败
+         */
+        virtual void sync() = 0;
+
+        /** @brief 析构接口 */
+        virtual ~io_adapter() = 0;
+    };
+
+    inline io_adapter::~io_adapter() = default;
+}
+
+#endif // !IO_ADAPTER_HPP
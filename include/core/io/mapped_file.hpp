@@ -0,0 +1,80 @@
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <cstdint>
+#include <string>
+
+/** @namespace 项目命名空间 */
+namespace mpmt
+{
+    /**
+     * @class   内存映射文件
+     * @note    1. 析构时自动解除映射；空文件不建立映射，data()返回nullptr。
+     *          2. 打开失败时抛出std::runtime_error，由调用方转换为模块异常。
+     *          3. 只读构造映射已有文件；读写构造新建（或截断）文件到指定大小后映射。
+     */
+    class mapped_file
+    {
+    public:
+        /**
+         * @brief   以只读方式映射文件
+         * @param   const std::string& path 文件路径
+         * @throw   std::runtime_error 打开或映射失败
+         */
+        explicit mapped_file(const std::string& path);
+
+        /**
+         * @brief   新建（或截断）文件到size字节，并以读写方式映射
+         * @param   const std::string& path 文件路径
+         * @param   uint64_t size 文件大小（字节）
+         * @throw   std::runtime_error 创建、调整大小或映射失败
+         */
+        mapped_file(const std::string& path, uint64_t size);
+
+        /**
+         * @brief   获取映射首地址
+         * @return  const uint8_t* 首地址
+         */
+        const uint8_t* data() const noexcept { return m_data; }
+
+        /**
+         * @brief   获取可写映射首地址（仅读写映射有效）
+         * @return  uint8_t* 首地址
+         */
+        uint8_t* mutable_data() noexcept { return m_writable ? const_cast<uint8_t*>(m_data) : nullptr; }
+
+        /**
+         * @brief   将读写映射的修改同步到磁盘
+         * @return  void
+         * @throw   std::runtime_error 同步失败
+         */
+        void flush();
+
+        /**
+         * @brief   获取文件大小
+         * @return  uint64_t 文件大小（字节）
+         */
+        uint64_t size() const noexcept { return m_size; }
+
+        ~mapped_file();
+
+    private:
+        const uint8_t* m_data;      // 映射首地址
+        uint64_t m_size;            // 文件大小
+        bool m_writable;            // 是否为读写映射
+#if defined(_WIN32) || defined(_WIN64)
+        void* m_file;               // 文件句柄
+        void* m_mapping;            // 映射句柄
+#else
+        int m_fd;                   // 文件描述符
+#endif
+
+        /** @brief 禁用拷贝与移动操作 */
+        mapped_file(const mapped_file&) = delete;
+        mapped_file(mapped_file&&) = delete;
+        mapped_file& operator=(const mapped_file&) = delete;
+        mapped_file& operator=(mapped_file&&) = delete;
+    };
+}
+
+#endif // !MAPPED_FILE_HPP
@@ -0,0 +1,67 @@
+#ifndef IO_MMAP_HPP
+#define IO_MMAP_HPP
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include "core/io/io_adapter.hpp"
+#include "core/io/mapped_file.hpp"
+
+/** @namespace 项目命名空间 */
+namespace mpmt
+{
+    /**
+     * @class   基于只读内存映射的随机访问文件
+     * @note    仅访问到的页会被读入，适合在大文件上读取或校验少量块。
+     */
+    class io_mmap : public io_adapter
+    {
+    public:
+        /**
+         * @brief   以只读方式映射文件
+         * @param   const std::string& path 文件路径
+         * @throw   std::runtime_error 打开或映射失败
+         */
+        explicit io_mmap(const std::string& path) : mc_path(path), m_file(path) {}
+
+        uint64_t size() const override { return m_file.size(); }
+
+        void read_at(uint64_t offset, uint8_t* out, uint64_t len) override
+        {
+            if (offset > m_file.size() || len > m_file.size() - offset)
+            {
+                throw std::runtime_error
+                (
+                    "Read of " + std::to_string(len) + " byte(s) at offset=" + std::to_string(offset)
+                    + " exceeds the size of the file [" + mc_path + "]."
+                );
+            }
+            if (len != 0)
+            {
+                std::memcpy(out, m_file.data() + offset, len);
+            }
+        }
+
+        void write_at(uint64_t, const uint8_t*, uint64_t) override
+        {
+            throw std::runtime_error("The file [" + mc_path + "] is mapped read-only.");
+        }
+
+        void sync() override {}
+
+        /**
+         * @brief   获取映射首地址（供零拷贝读取）
+         * @return  const uint8_t* 首地址，空文件为nullptr
+         */
+        const uint8_t* data() const noexcept { return m_file.data(); }
+
+        ~io_mmap() override = default;
+
+    private:
+        const std::string mc_path;      // 文件路径（用于错误信息）
+        const mapped_file m_file;       // 只读映射
+    };
+}
+
+#endif // !IO_MMAP_HPP
@@ -0,0 +1,43 @@
+#ifndef IO_STREAM_HPP
+#define IO_STREAM_HPP
+
+#include <fstream>
+#include <string>
+
+#include "core/io/io_adapter.hpp"
+
+/** @namespace 项目命名空间 */
+namespace mpmt
+{
+    /**
+     * @class   基于std::fstream的随机访问文件（可移植的默认实现）
+     */
+    class io_stream : public io_adapter
+    {
+    public:
+        /**
+         * @brief   打开文件
+         * @param   const std::string& path 文件路径
+         * @param   io_mode mode 打开方式
+         * @throw   std::runtime_error 打开失败
+         */
+        io_stream(const std::string& path, io_mode mode);
+
+        uint64_t size() const override { return m_size; }
+        void read_at(uint64_t offset, uint8_t* out, uint64_t len) override;
+        void write_at(uint64_t offset, const uint8_t* data, uint64_t len) override;
+        void sync() override;
+        ~io_stream() override = default;
+
+    private:
+        const std::string mc_path;      // 文件路径（用于错误信息）
+        const io_mode mc_mode;          // 打开方式
+        std::fstream m_stream;          // 文件流
+        uint64_t m_size;                // 文件大小
+
+        io_stream(const io_stream&) = delete;
+        io_stream& operator=(const io_stream&) = delete;
+    };
+}
+
+#endif // !IO_STREAM_HPP
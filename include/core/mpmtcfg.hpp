@@ -4,10 +4,10 @@
 #include "auxkit/stack_tracer.hpp"
 
 // Marco
-#if (defined(MPMT_VCB_CUDA) + defined(MPMT_VCB_STL) + defined(MPMT_VCB_XSIMD)) == 0
-    #error "ERROR: No vector computing backend selected. Please define exactly one of MPMT_VCB_CUDA, MPMT_VCB_STL, or MPMT_VCB_XSIMD."
-#elif (defined(MPMT_VCB_CUDA) + defined(MPMT_VCB_STL) + defined(MPMT_VCB_XSIMD)) > 1
-    #error "ERROR: Multiple vector computing backends defined. Only one backend can be enabled at a time."
+//  向量计算后端：CPU内核全部编入，运行时按CPUID分派（见core/ring/vcb/vcb_dispatch.hpp）
+//  MPMT_VCB_CUDA 预留给CUDA Thrust后端
+#if defined(MPMT_VCB_CUDA)
+    #error "The CUDA vector computing backend is not implemented yet."
 #endif
 
 #if defined(_WIN64)
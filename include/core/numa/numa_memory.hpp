@@ -0,0 +1,157 @@
+#ifndef NUMA_MEMORY_HPP
+#define NUMA_MEMORY_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+/** @namespace 项目命名空间 */
+namespace mpmt
+{
+    /** @brief 大块内存的NUMA放置策略 */
+    enum class numa_policy : uint8_t
+    {
+        OFF = 0,            // 不干预：普通堆分配，向量运算单线程执行
+        PARTITION = 1,      // 按计算节点分区：第k个分区绑定到第k个节点，由该节点的工作线程处理
+        INTERLEAVE = 2,     // 按页在全部计算节点间交错，工作线程仍按节点固定
+    };
+
+    /**
+     * @class   NUMA感知的大块内存分配
+     * @note    1. 不少于mc_MIN_BYTES的算术类型数组以匿名映射分配，按策略对地址区间调用mbind()后再由缺页按节点落页，
+     *             因此放置与首次写入的线程无关；匿名映射本身全零，无需串行清零。
+     *          2. 分区边界由partition()给出并按页对齐，numa_pool按同一边界把运算派发到对应节点的工作线程。
+     *          3. 单计算节点时默认OFF，多节点时默认PARTITION；环境变量MPMT_NUMA（off、partition、interleave）
+     *             或select()可覆盖，select()应在分配向量之前调用。
+     *          4. 非Linux平台或mbind()失败时退化为未绑定的映射，结果不变，仅失去放置效果。
+     */
+    class numa_memory
+    {
+    public:
+        static constexpr uint64_t mc_PAGE_SIZE = 4096;              // 分区对齐粒度
+        static constexpr uint64_t mc_MIN_BYTES = 1ULL << 21;        // 采用映射与分区的最小字节数
+
+        /**
+         * @brief   释放器：映射分配以munmap释放，其余以delete[]释放
+         * @tparam  T 元素类型
+         */
+        template <typename T>
+        struct deleter
+        {
+            uint64_t m_mapped_bytes = 0;    // 映射长度，0表示堆分配
+
+            void operator()(T* ptr) const noexcept
+            {
+                if (m_mapped_bytes != 0)
+                {
+                    numa_memory::unmap(ptr, m_mapped_bytes);
+                }
+                else
+                {
+                    delete[] ptr;
+                }
+            }
+        };
+
+        /** @brief 按策略分配的数组 */
+        template <typename T>
+        using array = std::unique_ptr<T[], deleter<T>>;
+
+        /**
+         * @brief   分配n个值初始化（全零）的元素
+         * @tparam  T 元素类型，仅算术类型采用映射分配
+         * @param   uint64_t n 元素个数
+         * @return  array<T> 数组，n为0时为空
+         */
+        template <typename T>
+        static array<T> make(uint64_t n)
+        {
+            if (n == 0)
+            {
+                return array<T>(nullptr, deleter<T>{});
+            }
+            if constexpr (std::is_arithmetic_v<T>)
+            {
+                const uint64_t c_bytes = n * sizeof(T);
+                void* mapped = map_zeroed(c_bytes);
+                if (mapped != nullptr)
+                {
+                    return array<T>(static_cast<T*>(mapped), deleter<T>{ c_bytes });
+                }
+            }
+            return array<T>(new T[n](), deleter<T>{});
+        }
+
+        /**
+         * @brief   是否对该长度的数据分区并行处理
+         * @param   uint64_t bytes 字节数
+         * @return  bool
+         */
+        static bool partitioned(uint64_t bytes) noexcept
+        {
+            return bytes >= mc_MIN_BYTES && active() != numa_policy::OFF;
+        }
+
+        /**
+         * @brief   计算第part个分区的元素区间，边界按页对齐
+         * @param   uint64_t elems 元素个数
+         * @param   uint64_t elem_bytes 元素字节数
+         * @param   uint32_t part 分区下标
+         * @param   uint32_t parts 分区个数
+         * @return  std::pair<uint64_t, uint64_t> [first, last)
+         */
+        static std::pair<uint64_t, uint64_t> partition(uint64_t elems, uint64_t elem_bytes, uint32_t part, uint32_t parts) noexcept;
+
+        /**
+         * @brief   获取当前策略
+         * @return  numa_policy 策略
+         */
+        static numa_policy active() noexcept;
+
+        /**
+         * @brief   指定策略
+         * @param   numa_policy policy 策略
+         * @return  void
+         */
+        static void select(numa_policy policy) noexcept;
+
+        /**
+         * @brief   按名称指定策略，"auto"表示恢复默认选择
+         * @param   const std::string& name 策略名称，不区分大小写
+         * @return  void
+         * @throw   numa_exc 名称无法识别
+         */
+        static void select(const std::string& name);
+
+        /**
+         * @brief   获取策略名称
+         * @param   numa_policy policy 策略
+         * @return  const char* 名称
+         */
+        static const char* name(numa_policy policy) noexcept;
+
+    private:
+        static constexpr uint8_t mc_UNSET = 0xFF;       // 尚未完成首次选择
+        static std::atomic<uint8_t> s_active;           // 当前策略
+
+        /** @brief 首次使用时读取MPMT_NUMA环境变量或按拓扑选择 */
+        static numa_policy initialize() noexcept;
+
+        /** @brief 按拓扑给出的默认策略 */
+        static numa_policy detect() noexcept;
+
+        /** @brief 名称解析，无法识别时返回false */
+        static bool parse(const std::string& name, numa_policy& policy);
+
+        /** @brief 按当前策略映射并绑定bytes字节，策略为OFF、长度不足或失败时返回nullptr */
+        static void* map_zeroed(uint64_t bytes) noexcept;
+
+        /** @brief 解除映射 */
+        static void unmap(void* ptr, uint64_t bytes) noexcept;
+    };
+}
+
+#endif // !NUMA_MEMORY_HPP
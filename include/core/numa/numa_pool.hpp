@@ -0,0 +1,85 @@
+#ifndef NUMA_POOL_HPP
+#define NUMA_POOL_HPP
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "core/numa/numa_topology.hpp"
+
+/** @namespace 项目命名空间 */
+namespace mpmt
+{
+    /**
+     * @class   按NUMA节点固定的工作线程池
+     * @note    1. 每个计算节点启动与其可用CPU数相同的工作线程（环境变量MPMT_NUMA_THREADS可限制每节点线程数），
+     *             线程绑定到所属节点的CPU集合上。
+     *          2. parallel_for()按numa_memory::partition()的边界把区间切为每节点一段，
+     *             再在节点内均分给该节点的线程，使每个线程只访问绑定在本节点的页。
+     *          3. 在池内线程中再次调用parallel_for()时直接在当前线程执行，避免嵌套等待。
+     *          4. 全局实例在首次使用时创建，进程退出时停止。
+     */
+    class numa_pool
+    {
+    public:
+        /** @brief 区间任务：fn(first, count) */
+        using range_fn = std::function<void(uint64_t, uint64_t)>;
+
+        /**
+         * @brief   获取全局线程池
+         * @return  numa_pool& 线程池
+         */
+        static numa_pool& instance();
+
+        /**
+         * @brief   按拓扑创建线程池
+         * @param   const numa_topology& topo 拓扑
+         * @param   unsigned threads_per_node 每节点线程数上限，0表示该节点全部可用CPU
+         */
+        numa_pool(const numa_topology& topo, unsigned threads_per_node);
+
+        /**
+         * @brief   按节点分区并行处理[0, elems)，返回时全部区间已处理完
+         * @param   uint64_t elems 元素个数
+         * @param   uint64_t elem_bytes 元素字节数（决定分区的页对齐）
+         * @param   const range_fn& fn 区间任务，须为noexcept语义
+         * @return  void
+         */
+        void parallel_for(uint64_t elems, uint64_t elem_bytes, const range_fn& fn);
+
+        /**
+         * @brief   获取线程总数
+         * @return  uint64_t 线程数
+         */
+        uint64_t num_threads() const noexcept;
+
+        /** @brief 停止并回收全部线程 */
+        ~numa_pool();
+
+    private:
+        /** @brief 一个节点的任务队列与线程 */
+        struct node_queue
+        {
+            std::mutex m_mutex;
+            std::condition_variable m_cv;
+            std::deque<std::function<void()>> m_tasks;
+            std::vector<std::thread> m_threads;
+            bool m_stop = false;
+        };
+
+        std::vector<std::unique_ptr<node_queue>> m_queues;  // 各计算节点
+
+        /** @brief 节点工作线程主循环 */
+        static void work(node_queue& queue, const std::vector<uint32_t>& cpus);
+
+        numa_pool(const numa_pool&) = delete;
+        numa_pool& operator=(const numa_pool&) = delete;
+    };
+}
+
+#endif // !NUMA_POOL_HPP
@@ -0,0 +1,78 @@
+#ifndef NUMA_TOPOLOGY_HPP
+#define NUMA_TOPOLOGY_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/** @namespace 项目命名空间 */
+namespace mpmt
+{
+    /**
+     * @class   NUMA拓扑（读取自sysfs）
+     * @note    1. 解析<root>/node<N>/cpulist，仅保留当前进程允许运行的CPU（sched_getaffinity），
+     *             因此容器或taskset限制下看到的是实际可用的拓扑。
+     *          2. 没有CPU的节点（如纯内存节点）不计入计算节点，内存分区与工作线程只面向计算节点。
+     *          3. sysfs不可读或非Linux平台时退化为包含全部CPU的单节点。
+     */
+    class numa_topology
+    {
+    public:
+        /** @brief 计算节点 */
+        struct node
+        {
+            uint32_t m_id;                  // 内核中的节点编号
+            std::vector<uint32_t> m_cpus;   // 该节点上可用的CPU
+        };
+
+        /**
+         * @brief   读取拓扑
+         * @param   const std::string& root sysfs节点目录
+         */
+        explicit numa_topology(const std::string& root = "/sys/devices/system/node");
+
+        /**
+         * @brief   获取本机拓扑（首次调用时读取）
+         * @return  const numa_topology& 拓扑
+         */
+        static const numa_topology& system();
+
+        /**
+         * @brief   获取计算节点，按节点编号升序
+         * @return  const std::vector<node>& 计算节点
+         */
+        const std::vector<node>& nodes() const noexcept { return m_nodes; }
+
+        /**
+         * @brief   获取计算节点个数
+         * @return  uint32_t 节点个数（至少为1）
+         */
+        uint32_t num_nodes() const noexcept { return static_cast<uint32_t>(m_nodes.size()); }
+
+        /**
+         * @brief   查询CPU所在计算节点的下标（nodes()中的位置）
+         * @param   uint32_t cpu CPU编号
+         * @return  int 下标，未知CPU返回-1
+         */
+        int node_index_of(uint32_t cpu) const noexcept;
+
+        /**
+         * @brief   解析内核CPU列表格式，如"0-3,8,10-11"
+         * @param   const std::string& text 列表文本
+         * @return  std::vector<uint32_t> CPU编号，升序
+         */
+        static std::vector<uint32_t> parse_cpulist(const std::string& text);
+
+        /**
+         * @brief   将调用线程绑定到一组CPU
+         * @param   const std::vector<uint32_t>& cpus CPU编号
+         * @return  bool 是否成功（非Linux平台返回false）
+         */
+        static bool pin_current_thread(const std::vector<uint32_t>& cpus) noexcept;
+
+    private:
+        std::vector<node> m_nodes;          // 计算节点
+    };
+}
+
+#endif // !NUMA_TOPOLOGY_HPP
@@ -1,5 +1,5 @@
-#ifndef DATA_HOLDER_FUNC_HPP
-#define DATA_HOLDER_FUNC_HPP
+#ifndef AGENT_FUNC_HPP
+#define AGENT_FUNC_HPP
 
 #include "core/protocol/base_ideal_fn.hpp"
 
@@ -19,4 +19,4 @@ namespace mpmt
         virtual void add() = 0;
     };
 }
-#endif // !DATA_HOLDER_FUNC_HPP
\ No newline at end of file
+#endif // !AGENT_FUNC_HPP
\ No newline at end of file
@@ -1,17 +1,241 @@
+#ifndef AGENT_ASS_HPP
+#define AGENT_ASS_HPP
 
-#ifndef DATA_HOLDER_ASS_HPP
-#define DATA_HOLDER_ASS_HPP
+#include <functional>
+#include <optional>
+#include <vector>
 
+#include "core/mpmtcfg.hpp"
+#include "core/comm/comm_adapter.hpp"
+#include "core/coro/coro_pool.hpp"
+#include "core/coro/coro_task.hpp"
 #include "core/protocol/agent_ideal_fn.hpp"
+#include "core/protocol/ass_impl/ass_role.hpp"
+#include "core/protocol/ass_impl/merge_checkpoint.hpp"
+#include "core/protocol/ass_impl/query_cache.hpp"
+#include "core/protocol/ass_impl/reveal_blind.hpp"
+#include "core/ring/rvector.hpp"
 
 /** @namespace 项目命名空间。 */
 namespace mpmt
 {
-    class agent_ass : public agent_ideal_fn 
+    /**
+     * @class   代理方（加法秘密分享实现）
+     * @tparam  RT 环类型，限定为ring8,ring16,ring32,ring64
+     * @note    1. aggregate()接收数据持有方的份额并累加到并集份额，AS0按块惰性展开种子；
+     *             每mc_FUSE_WAY个持有方的同一区间经k路融合内核一次累加（见vcb_kernels::m_add_many），
+     *             并集份额的每个区间每组只读写一遍。
+     *          2. reveal()响应一次查询：接收查询方的槽位令牌，返回本方在这些槽位上的份额。
+     *          3. 并集编码为各持有方0/1指示向量之和，持有方个数需小于2^{|RT|}以免计数回绕。
+     *          4. aggregate()（含merge()、update()）与load_union()改变并集份额后清空查询缓存并调用更新回调，
+     *             回调可用于向agent_server发布新快照（见set_update_hook()）。
+     *          5. 启用查询缓存后（见set_cache_capacity()），reveal()对重复的令牌直接返回缓存的份额。
+     *          6. 持有方连接也可以是聚合树中继（见relay_ass）的上游端：AS0收到的报文为种子束，AS1收到的分块为多个持有方份额之和。
+     *          7. 设置检查点（见set_checkpoint()）后，AS1每累加完一组连接、AS0每展开完一个槽位区间即尝试后台写入检查点，
+     *             聚合结束时同步提交最终检查点；中断后经resume()载入检查点，再次merge()或aggregate()时跳过已累加的部分。
+     *          8. 未设置盲化密钥时查询方恢复出槽位计数本身，即持有该凭据的持有方个数；两个代理方设置同一盲化密钥后
+     *             （见set_blind_key()、reveal_blind），查询方只得到计数是否为0（及其2-adic赋值）。
+     *          9. merge_async()、update_async()、aggregate_async()与reveal_async()在协程中执行同一协议：等待报文时挂起，
+     *             种子展开分窗让出工作线程（见async_fill()）；同步接口以不挂起的方式运行同一协程实现。
+     *             协程接口执行期间不得并发调用本对象的其他接口。
+     */
+    template <typename RT>
+    class agent_ass : public agent_ideal_fn
     {
-        virtual void merge() = 0;  
-        virtual void update() = 0;  
-        virtual void aggregate() = 0;  
+    public:
+        /** @brief 断言限制模板类型 */
+        static_assert(
+            is_word_ring_type<RT>,
+            "RT must be ring8, ring16, ring32, or ring64."
+            );
+
+        /**
+         * @brief   构造代理方
+         * @param   ass_role role 代理方角色
+         * @param   const std::vector<comm_adapter<RT>*>& holders 与各数据持有方的连接
+         * @param   comm_adapter<RT>* querier 与查询方的连接，可为nullptr（仅合并）
+         */
+        agent_ass(ass_role role, const std::vector<comm_adapter<RT>*>& holders, comm_adapter<RT>* querier);
+
+        /**
+         * @brief   合并：清空并集份额后聚合全部数据持有方的份额；resume()后则从检查点继续
+         * @return  void
+         */
+        void merge() override;
+
+        /**
+         * @brief   更新：在现有并集份额上继续聚合新的数据持有方份额
+         * @return  void
+         */
+        void update() override;
+
+        /**
+         * @brief   聚合：接收每个已连接数据持有方的一份份额并累加
+         * @return  void
+         * @throw   protocol_exc 份额长度与并集份额长度不一致
+         */
+        void aggregate() override;
+
+        /**
+         * @brief   代理方不作为秘密的输入方
+         * @throw   protocol_exc 始终抛出
+         */
+        void share() override;
+
+        /**
+         * @brief   响应一次查询，向查询方返回槽位份额
+         * @return  void
+         * @throw   protocol_exc 未连接查询方或槽位越界
+         */
+        void reveal() override;
+
+        /**
+         * @brief   在协程中合并，语义同merge()
+         * @param   coro_pool& pool 恢复协程的线程池
+         * @return  coro_task<void> 合并结束后结束
+         * @throw   protocol_exc 同aggregate()（在co_await处抛出）
+         */
+        coro_task<void> merge_async(coro_pool& pool);
+
+        /**
+         * @brief   在协程中更新，语义同update()
+         * @param   coro_pool& pool 恢复协程的线程池
+         * @return  coro_task<void> 更新结束后结束
+         * @throw   protocol_exc 同update()（在co_await处抛出）
+         */
+        coro_task<void> update_async(coro_pool& pool);
+
+        /**
+         * @brief   在协程中聚合：等待持有方报文时挂起，语义同aggregate()
+         * @param   coro_pool& pool 恢复协程的线程池
+         * @return  coro_task<void> 聚合结束后结束
+         * @throw   protocol_exc 同aggregate()（在co_await处抛出）
+         */
+        coro_task<void> aggregate_async(coro_pool& pool);
+
+        /**
+         * @brief   在协程中响应一次查询：等待令牌时挂起，语义同reveal()
+         * @param   coro_pool& pool 恢复协程的线程池
+         * @return  coro_task<void> 份额发出后结束
+         * @throw   protocol_exc 同reveal()（在co_await处抛出）
+         */
+        coro_task<void> reveal_async(coro_pool& pool);
+
+        /**
+         * @brief   替换数据持有方连接（用于update()接入新的数据持有方）
+         * @param   const std::vector<comm_adapter<RT>*>& holders 与各数据持有方的连接
+         * @return  void
+         */
+        void set_holders(const std::vector<comm_adapter<RT>*>& holders);
+
+        /**
+         * @brief   获取并集份额
+         * @return  const rvector<RT>& 并集份额
+         */
+        const rvector<RT>& union_share() const noexcept { return m_union; }
+
+        /**
+         * @brief   载入持久化的并集份额
+         * @param   rvector<RT>&& share 并集份额
+         * @return  void
+         */
+        void load_union(rvector<RT>&& share);
+
+        /**
+         * @brief   设置聚合过程中写入的检查点
+         * @param   merge_checkpoint<RT>* checkpoint 检查点写入器，需存活至聚合结束；nullptr取消
+         * @return  void
+         */
+        void set_checkpoint(merge_checkpoint<RT>* checkpoint) noexcept { m_checkpoint = checkpoint; }
+
+        /**
+         * @brief   从检查点恢复中断的合并：载入累加器，下一次聚合跳过已累加的连接与槽位区间
+         * @param   typename merge_checkpoint<RT>::resume_point&& point 检查点（见merge_checkpoint::load()）
+         * @return  void
+         * @note    下一次聚合时连接数须与检查点记录的相同，且各连接按原顺序重新发送相同的份额。
+         */
+        void resume(typename merge_checkpoint<RT>::resume_point&& point);
+
+        /**
+         * @brief   设置并集份额改变后的回调
+         * @param   std::function<void(const rvector<RT>&)> hook 回调，参数为新的并集份额；传入空函数取消
+         * @return  void
+         */
+        void set_update_hook(std::function<void(const rvector<RT>&)> hook);
+
+        /**
+         * @brief   设置查询缓存容量并清空缓存
+         * @param   uint64_t capacity 最多缓存的令牌数，0表示不缓存（默认）
+         * @return  void
+         */
+        void set_cache_capacity(uint64_t capacity) { m_cache.resize(capacity); }
+
+        /**
+         * @brief   设置查询响应的盲化密钥并清空缓存，两个代理方须使用同一密钥且不告知查询方
+         * @param   const typename reveal_blind<RT>::key_type& key 128位密钥
+         * @return  void
+         */
+        void set_blind_key(const typename reveal_blind<RT>::key_type& key);
+
+        /**
+         * @brief   获取查询缓存（用于读取命中统计）
+         * @return  const query_cache<RT>& 查询缓存
+         */
+        const query_cache<RT>& cache() const noexcept { return m_cache; }
+
+        /**
+         * @brief   获取代理方角色
+         * @return  ass_role 角色
+         */
+        ass_role role() const noexcept { return mc_role; }
+
+    private:
+        static constexpr uint64_t mc_FUSE_WAY = 8;                  // 一次融合累加的持有方个数（AS1需同时缓存其各一块）
+        static constexpr uint64_t mc_FUSE_WINDOW_BYTES = 1ULL << 16;// AS0每次展开的区间字节数，组间累加时并集区间常驻缓存
+
+        const ass_role mc_role;                         // 代理方角色
+        std::vector<comm_adapter<RT>*> m_holders;       // 与各数据持有方的连接
+        comm_adapter<RT>* m_querier;                    // 与查询方的连接
+        rvector<RT> m_union;                            // 并集份额
+        std::function<void(const rvector<RT>&)> m_update_hook;  // 并集份额改变后的回调
+        query_cache<RT> m_cache;                        // 查询缓存
+        std::optional<reveal_blind<RT>> m_blind;        // 查询响应的盲化，未设置时返回原始份额
+        merge_checkpoint<RT>* m_checkpoint;             // 聚合过程中写入的检查点，可为nullptr
+        std::optional<merge_progress> m_resume;         // 待恢复的进度
+
+        void multiply() override;
+        void subtract() override;
+        void add() override;
+
+        /**
+         * @brief   确保并集份额长度为size，首次聚合时分配全零向量
+         * @return  void
+         */
+        void ensure_union(uint64_t size);
+
+        /** @brief 聚合的协程实现，pool为nullptr时不挂起（供同步接口经run_inline()运行） */
+        coro_task<void> aggregate_on(coro_pool* pool);
+
+        /** @brief AS0：收齐各持有方的种子后按区间展开并融合累加，从start继续 */
+        coro_task<void> aggregate_seeds(coro_pool* pool, merge_progress start);
+
+        /** @brief AS1：按组轮流接收各持有方的分块并融合累加，从start继续 */
+        coro_task<void> aggregate_chunks(coro_pool* pool, merge_progress start);
+
+        /** @brief 校验并集份额存在（update()的前置条件） */
+        void require_union() const;
+
+        /** @brief 按令牌收集本方份额并发送给查询方，命中缓存时直接返回 */
+        void respond(const std::vector<RT>& token);
+
+        /** @brief 并集份额改变后清空查询缓存并通知回调 */
+        void notify_update();
     };
 }
-#endif // !DATA_HOLDER_ASS_HPP
\ No newline at end of file
+
+extern template class mpmt::agent_ass<mpmt::ring8>;
+extern template class mpmt::agent_ass<mpmt::ring16>;
+extern template class mpmt::agent_ass<mpmt::ring32>;
+extern template class mpmt::agent_ass<mpmt::ring64>;
+
+#endif // !AGENT_ASS_HPP
@@ -0,0 +1,154 @@
+#ifndef AGENT_SERVER_HPP
+#define AGENT_SERVER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include "core/mpmtcfg.hpp"
+#include "core/comm/comm_adapter.hpp"
+#include "core/coro/coro_pool.hpp"
+#include "core/coro/coro_task.hpp"
+#include "core/protocol/ass_impl/query_cache.hpp"
+#include "core/protocol/ass_impl/reveal_blind.hpp"
+#include "core/protocol/ass_impl/union_snapshot.hpp"
+
+/** @namespace 项目命名空间。 */
+namespace mpmt
+{
+    /**
+     * @class   代理方并发查询服务（加法秘密分享实现）
+     * @tparam  RT 环类型，限定为ring8,ring16,ring32,ring64
+     * @note    1. serve()为一条查询方会话启动一个协程，逐次响应该会话的查询（协议同agent_ass::reveal()），
+     *             直至查询方断开连接；协程等待令牌时挂起，不占用线程，少量工作线程（coro_pool）即可复用数千条会话。
+     *          2. 并集份额以只读快照（union_snapshot）形式共享，读取时不加锁：
+     *             工作线程在一次查询期间将当前纪元写入自己的槽位，publish()原子替换快照并推进纪元，
+     *             待所有槽位都离开旧纪元（宽限期）后释放旧快照，因此查询只会看到完整的旧快照或新快照；
+     *             一次查询的读取与回复之间没有co_await，期间不会换线程。
+     *          3. 槽位与返回份额的缓存区位于工作线程的线程局部内存中，跨查询与会话复用，稳态下不再分配；
+     *             令牌缓存区属于会话协程。
+     *          4. 就绪队列仅在协程挂起与恢复时加锁，与快照读取无关。
+     *          5. m_cache_entries非0时每个工作线程持有一个查询缓存（见query_cache），条目记录所属纪元，
+     *             工作线程读到新纪元的快照时先清空自己的缓存，因此缓存不会返回旧快照的份额。
+     *          6. m_pin_workers为true时工作线程按numa_topology轮流绑定到各计算节点，避免被调度器跨节点迁移。
+     *          7. 设置m_blind_key后响应经reveal_blind盲化（同agent_ass::set_blind_key()），缓存的是盲化后的份额。
+     */
+    template <typename RT>
+    class agent_server
+    {
+    public:
+        /** @brief 断言限制模板类型 */
+        static_assert(
+            is_word_ring_type<RT>,
+            "RT must be ring8, ring16, ring32, or ring64."
+            );
+
+        struct config
+        {
+            unsigned m_workers;             // 工作线程数（与会话数无关），0表示硬件并发数
+            uint64_t m_cache_entries = 0;   // 每个工作线程的查询缓存条目数，0表示不缓存
+            bool m_pin_workers = false;     // 是否将第w个工作线程绑定到第w % N个NUMA计算节点的CPU上
+            std::optional<typename reveal_blind<RT>::key_type> m_blind_key = std::nullopt;  // 盲化密钥，为空时返回原始份额
+        };
+
+        /**
+         * @brief   构造服务并启动工作线程
+         * @param   const config& cfg 服务配置
+         * @param   std::unique_ptr<union_snapshot<RT>> initial 初始快照
+         * @throw   protocol_exc 初始快照为空
+         */
+        agent_server(const config& cfg, std::unique_ptr<union_snapshot<RT>> initial);
+
+        /**
+         * @brief   为一条查询方会话启动协程
+         * @param   comm_adapter<RT>& session 与查询方的连接，需存活至会话结束（wait_idle()返回或服务析构）；
+         *          未重写try_receive()的连接在等待令牌时占用一个工作线程
+         * @return  void
+         */
+        void serve(comm_adapter<RT>& session);
+
+        /**
+         * @brief   替换快照（并集更新后调用），返回时旧快照已释放
+         * @param   std::unique_ptr<union_snapshot<RT>> next 新快照
+         * @return  void
+         * @throw   protocol_exc 新快照为空
+         */
+        void publish(std::unique_ptr<union_snapshot<RT>> next);
+
+        /**
+         * @brief   等待全部已提交会话结束
+         * @return  void
+         */
+        void wait_idle();
+
+        /**
+         * @brief   获取当前纪元（每次publish()加一）
+         * @return  uint64_t 纪元
+         */
+        uint64_t epoch() const noexcept { return m_epoch.load(std::memory_order_acquire); }
+
+        /**
+         * @brief   获取已响应的查询次数
+         * @return  uint64_t 查询次数
+         */
+        uint64_t answered() const noexcept { return m_answered.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief   获取命中查询缓存的查询次数
+         * @return  uint64_t 查询次数
+         */
+        uint64_t cache_hits() const noexcept { return m_cache_hits.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief   获取工作线程数
+         * @return  unsigned 线程数
+         */
+        unsigned workers() const noexcept { return m_pool.threads(); }
+
+        /** @brief 等待已提交会话结束后停止工作线程 */
+        ~agent_server();
+
+    private:
+        /** @brief 工作线程的纪元槽位，0表示当前不在读取快照 */
+        struct alignas(64) reader_slot
+        {
+            std::atomic<uint64_t> m_epoch{ 0 };
+        };
+
+        /** @brief 已发布的快照及其纪元 */
+        struct version
+        {
+            std::unique_ptr<const union_snapshot<RT>> m_snapshot;   // 快照
+            uint64_t m_epoch;                                       // 发布时的纪元
+        };
+
+        const uint64_t mc_cache_entries;                    // 每个工作线程的查询缓存条目数
+        const std::optional<reveal_blind<RT>> mc_blind;     // 查询响应的盲化
+        std::atomic<const version*> m_current;              // 当前快照
+        std::atomic<uint64_t> m_epoch;                      // 当前纪元
+        std::unique_ptr<reader_slot[]> m_slots;             // 各工作线程的纪元槽位
+        std::mutex m_publish_mutex;                         // 串行化publish()
+        std::atomic<uint64_t> m_answered;                   // 已响应的查询次数
+        std::atomic<uint64_t> m_cache_hits;                 // 命中查询缓存的查询次数
+        coro_pool m_pool;                                   // 复用会话协程的工作线程（最后声明，最先停止）
+
+        /** @brief 会话协程：响应一条会话直至查询方断开 */
+        coro_task<void> run_session(comm_adapter<RT>& session);
+
+        /** @brief 在当前工作线程上响应一个令牌 */
+        void answer(const std::vector<RT>& token, comm_adapter<RT>& session);
+
+        agent_server(const agent_server&) = delete;
+        agent_server& operator=(const agent_server&) = delete;
+    };
+}
+
+extern template class mpmt::agent_server<mpmt::ring8>;
+extern template class mpmt::agent_server<mpmt::ring16>;
+extern template class mpmt::agent_server<mpmt::ring32>;
+extern template class mpmt::agent_server<mpmt::ring64>;
+
+#endif // !AGENT_SERVER_HPP
@@ -0,0 +1,17 @@
+#ifndef ASS_ROLE_HPP
+#define ASS_ROLE_HPP
+
+#include <cstdint>
+
+/** @namespace 项目命名空间。 */
+namespace mpmt
+{
+    /** @brief 加法秘密分享中代理方的角色 */
+    enum class ass_role : uint8_t
+    {
+        AS0 = 0,    // 接收数据持有方的种子份额
+        AS1 = 1,    // 接收数据持有方的掩码份额 x - PRG(seed)
+    };
+}
+
+#endif // !ASS_ROLE_HPP
@@ -0,0 +1,249 @@
+#ifndef ASS_WIRE_HPP
+#define ASS_WIRE_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "core/comm/comm_adapter.hpp"
+#include "core/comm/comm_packer.hpp"
+#include "core/exception/protocol_exc.hpp"
+#include "core/ring/rvector.hpp"
+
+/** @namespace 项目命名空间。 */
+namespace mpmt
+{
+    /** @namespace 加法秘密分享协议的报文编解码工具。 */
+    namespace ass_wire
+    {
+        static constexpr uint64_t mc_CHUNK_SIZE = 1ULL << 20;  // 份额分块发送时每块的元素个数
+
+        /**
+         * @brief   将字节串编码为DT报文（字节长度需为sizeof(DT)的整数倍）。
+         * @param   const uint8_t* bytes 字节串
+         * @param   uint64_t len 字节长度
+         * @return  std::vector<DT> 报文
+         */
+        template <typename DT>
+        inline std::vector<DT> encode_bytes(const uint8_t* bytes, uint64_t len)
+        {
+            std::vector<DT> words((len + sizeof(DT) - 1) / sizeof(DT), 0);
+            std::memcpy(words.data(), bytes, len);
+            return words;
+        }
+
+        /**
+         * @brief   从DT报文中解码字节串。
+         * @param   const std::vector<DT>& words 报文
+         * @param   uint64_t word_offset 起始位置（DT个数）
+         * @param   uint8_t* bytes 输出字节串
+         * @param   uint64_t len 字节长度
+         * @return  void
+         * @throw   protocol_exc 报文长度不足
+         */
+        template <typename DT>
+        inline void decode_bytes(const std::vector<DT>& words, uint64_t word_offset, uint8_t* bytes, uint64_t len)
+        {
+            if ((words.size() - std::min<uint64_t>(word_offset, words.size())) * sizeof(DT) < len)
+            {
+                throw protocol_exc
+                (
+                    protocol_exc::exc_type::MESSAGE_CORRUPTION,
+                    "message of " + std::to_string(words.size()) + " word(s) is too short to decode "
+                    + std::to_string(len) + " byte(s) at word offset " + std::to_string(word_offset) + "."
+                );
+            }
+            std::memcpy(bytes, words.data() + word_offset, len);
+        }
+
+        /**
+         * @brief   发送64位长度字段。
+         * @param   comm_adapter<DT>& comm 通信适配器
+         * @param   uint64_t value 长度
+         * @return  void
+         */
+        template <typename DT>
+        inline void send_u64(comm_adapter<DT>& comm, uint64_t value)
+        {
+            comm.send(encode_bytes<DT>(reinterpret_cast<const uint8_t*>(&value), sizeof(value)));
+        }
+
+        /**
+         * @brief   解码send_u64()发送的报文。
+         * @param   const std::vector<DT>& words 报文
+         * @return  uint64_t 长度
+         */
+        template <typename DT>
+        inline uint64_t decode_u64(const std::vector<DT>& words)
+        {
+            uint64_t value = 0;
+            decode_bytes(words, 0, reinterpret_cast<uint8_t*>(&value), sizeof(value));
+            return value;
+        }
+
+        /**
+         * @brief   接收64位长度字段。
+         * @param   comm_adapter<DT>& comm 通信适配器
+         * @return  uint64_t 长度
+         */
+        template <typename DT>
+        inline uint64_t receive_u64(comm_adapter<DT>& comm)
+        {
+            std::vector<DT> words;
+            comm.receive(words);
+            return decode_u64(words);
+        }
+
+        /**
+         * @brief   发送槽位令牌：槽位下标远小于2^64，经comm_packer按最大下标的位宽打包。
+         * @param   comm_adapter<DT>& comm 通信适配器
+         * @param   const std::vector<DT>& token 令牌（encode_bytes编码的64位槽位下标）
+         * @return  void
+         */
+        template <typename DT>
+        inline void send_token(comm_adapter<DT>& comm, const std::vector<DT>& token)
+        {
+            comm.send_packed(token, true);
+        }
+
+        /**
+         * @brief   解包经comm_packer打包的报文。
+         * @param   const std::vector<DT>& message 报文
+         * @return  std::vector<DT> 原始数据
+         * @throw   protocol_exc 报文头损坏或载荷长度不符
+         */
+        template <typename DT>
+        inline std::vector<DT> unpack_packed(const std::vector<DT>& message)
+        {
+            try
+            {
+                return comm_packer<DT>::unpack(message);
+            }
+            catch (const std::invalid_argument& e)
+            {
+                throw protocol_exc(protocol_exc::exc_type::MESSAGE_CORRUPTION, e.what());
+            }
+        }
+
+        /**
+         * @brief   解包send_token()发送的报文。
+         * @param   const std::vector<DT>& message 报文
+         * @return  std::vector<DT> 令牌
+         * @throw   protocol_exc 报文头损坏或载荷长度不符
+         */
+        template <typename DT>
+        inline std::vector<DT> unpack_token(const std::vector<DT>& message)
+        {
+            return unpack_packed(message);
+        }
+
+        /**
+         * @brief   接收send_token()发送的槽位令牌。
+         * @param   comm_adapter<DT>& comm 通信适配器
+         * @return  std::vector<DT> 令牌
+         * @throw   protocol_exc 报文头损坏或载荷长度不符
+         */
+        template <typename DT>
+        inline std::vector<DT> receive_token(comm_adapter<DT>& comm)
+        {
+            std::vector<DT> message;
+            comm.receive(message);
+            return unpack_token(message);
+        }
+
+        /**
+         * @brief   份额位宽为bits时的掩码（低bits位为1）。
+         * @param   uint8_t bits 份额位宽，不小于环位宽时为全1
+         * @return  RT 掩码
+         */
+        template <typename RT>
+        constexpr RT share_mask(uint8_t bits) noexcept
+        {
+            return bits >= sizeof(RT) * 8 ? static_cast<RT>(~RT(0)) : static_cast<RT>((uint64_t(1) << bits) - 1);
+        }
+
+        /**
+         * @brief   校验份额位宽。
+         * @param   uint8_t bits 份额位宽
+         * @return  void
+         * @throw   protocol_exc 位宽不在[1, 环位宽]内
+         */
+        template <typename RT>
+        inline void check_share_bits(uint8_t bits)
+        {
+            if (bits == 0 || bits > sizeof(RT) * 8)
+            {
+                throw protocol_exc
+                (
+                    protocol_exc::exc_type::INVALID_PARAMETER,
+                    "share width " + std::to_string(bits) + " is outside [1, " + std::to_string(sizeof(RT) * 8) + "]."
+                );
+            }
+        }
+
+        /**
+         * @brief   发送AS1的一块份额：经comm_packer按块内最大值的位宽打包。
+         * @param   comm_adapter<DT>& comm 通信适配器
+         * @param   const std::vector<DT>& chunk 份额分块
+         * @return  void
+         * @note    份额以环位宽均匀分布时自动回退为不压缩；持有方以较窄的份额位宽分享时
+         *          （见data_holder_ass::set_share_bits()）每元素只占该位宽，经中继累加后多出log2(扇入)位。
+         */
+        template <typename DT>
+        inline void send_share_chunk(comm_adapter<DT>& comm, const std::vector<DT>& chunk)
+        {
+            comm.send_packed(chunk, true);
+        }
+
+        /**
+         * @brief   接收send_share_chunk()发送的一块份额。
+         * @param   comm_adapter<DT>& comm 通信适配器
+         * @param   std::vector<DT>& chunk 输出份额分块
+         * @return  void
+         * @throw   protocol_exc 报文头损坏或载荷长度不符
+         */
+        template <typename DT>
+        inline void receive_share_chunk(comm_adapter<DT>& comm, std::vector<DT>& chunk)
+        {
+            std::vector<DT> message;
+            comm.receive(message);
+            chunk = unpack_packed(message);
+        }
+
+        /**
+         * @brief   接收分块发送的份额向量：先接收长度字段，再逐块接收并拼接。
+         * @param   comm_adapter<RT>& comm 通信适配器
+         * @return  rvector<RT> 份额向量
+         * @throw   protocol_exc 分块长度与声明长度不符
+         */
+        template <typename RT>
+        inline rvector<RT> receive_chunked(comm_adapter<RT>& comm)
+        {
+            const uint64_t c_size = receive_u64(comm);
+            rvector<RT> share(c_size);
+
+            uint64_t filled = 0;
+            std::vector<RT> chunk;
+            while (filled < c_size)
+            {
+                receive_share_chunk(comm, chunk);
+                if (chunk.empty() || chunk.size() > c_size - filled)
+                {
+                    throw protocol_exc
+                    (
+                        protocol_exc::exc_type::MESSAGE_CORRUPTION,
+                        "received a chunk of " + std::to_string(chunk.size()) + " element(s) with "
+                        + std::to_string(c_size - filled) + " element(s) remaining."
+                    );
+                }
+                std::copy(chunk.begin(), chunk.end(), share.data() + filled);
+                filled += chunk.size();
+            }
+            return share;
+        }
+    }
+}
+#endif // !ASS_WIRE_HPP
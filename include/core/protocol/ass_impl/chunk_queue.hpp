@@ -0,0 +1,103 @@
+#ifndef CHUNK_QUEUE_HPP
+#define CHUNK_QUEUE_HPP
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <utility>
+
+/** @namespace 项目命名空间。 */
+namespace mpmt
+{
+    /**
+     * @class   有界阻塞队列：连接流水线相邻两级，队满时生产方等待，队空时消费方等待
+     * @tparam  T 元素类型（通常为携带缓存区的分块）
+     * @note    1. close()后push()立即返回false，pop()取完剩余元素后返回false，用于正常结束或出错时解除各级等待。
+     *          2. 容量限制流水线中在途的分块数，峰值内存与输入长度无关。
+     */
+    template <typename T>
+    class chunk_queue
+    {
+    public:
+        /**
+         * @brief   构造队列
+         * @param   uint64_t capacity 容量，0视为1
+         */
+        explicit chunk_queue(uint64_t capacity)
+            :
+            m_mutex(),
+            m_not_full(),
+            m_not_empty(),
+            m_items(),
+            m_capacity(capacity == 0 ? 1 : capacity),
+            m_closed(false)
+        {}
+
+        /**
+         * @brief   入队，队满时等待
+         * @param   T&& item 元素
+         * @return  bool 是否入队，队列已关闭时返回false
+         */
+        bool push(T&& item)
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_not_full.wait(lock, [this] { return m_closed || m_items.size() < m_capacity; });
+            if (m_closed)
+            {
+                return false;
+            }
+            m_items.push_back(std::move(item));
+            lock.unlock();
+            m_not_empty.notify_one();
+            return true;
+        }
+
+        /**
+         * @brief   出队，队空时等待
+         * @param   T& item 接收元素
+         * @return  bool 是否取到元素，队列已关闭且为空时返回false
+         */
+        bool pop(T& item)
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_not_empty.wait(lock, [this] { return m_closed || !m_items.empty(); });
+            if (m_items.empty())
+            {
+                return false;
+            }
+            item = std::move(m_items.front());
+            m_items.pop_front();
+            lock.unlock();
+            m_not_full.notify_one();
+            return true;
+        }
+
+        /**
+         * @brief   关闭队列并唤醒全部等待方
+         * @return  void
+         */
+        void close()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_closed = true;
+            }
+            m_not_full.notify_all();
+            m_not_empty.notify_all();
+        }
+
+    private:
+        std::mutex m_mutex;                     // 保护队列
+        std::condition_variable m_not_full;     // 有空位或关闭
+        std::condition_variable m_not_empty;    // 有元素或关闭
+        std::deque<T> m_items;                  // 元素
+        const uint64_t m_capacity;              // 容量
+        bool m_closed;                          // 是否关闭
+
+        chunk_queue(const chunk_queue&) = delete;
+        chunk_queue& operator=(const chunk_queue&) = delete;
+    };
+}
+
+#endif // !CHUNK_QUEUE_HPP
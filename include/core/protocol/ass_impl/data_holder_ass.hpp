@@ -1,15 +1,152 @@
-
 #ifndef DATA_HOLDER_ASS_HPP
 #define DATA_HOLDER_ASS_HPP
 
+#include <optional>
+#include <vector>
+
 #include "core/mpmtcfg.hpp"
+#include "core/comm/comm_adapter.hpp"
+#include "core/coro/coro_pool.hpp"
+#include "core/coro/coro_task.hpp"
+#include "core/encode/slot_indicator.hpp"
 #include "core/protocol/data_holder_ideal_fn.hpp"
+#include "core/protocol/ass_impl/seed_share.hpp"
+#include "core/protocol/ass_impl/shard_map.hpp"
+#include "core/ring/rvector.hpp"
+#include "core/rng/openssl_impl/prg_openssl.hpp"
 
 /** @namespace 项目命名空间。 */
 namespace mpmt
 {
+    /**
+     * @class   数据持有方（加法秘密分享实现）
+     * @tparam  RT 环类型，限定为ring8,ring16,ring32,ring64
+     * @note    share()采用种子压缩：AS0仅收到PRG种子，AS1收到x - PRG(seed)，
+     *          上传量与AS0的存储量均减半。
+     *          分片部署时（见shard_map）编码向量按槽位区间拆分，每个分片独立取种子，分别发送给持有该分片的代理方对。
+     *          share()以三级流水线逐块处理：编码线程展开下一块的编码值，掩码线程对上一块减去PRG输出，
+     *          调用线程发送再上一块；各级之间以有界队列相连，在途至多mc_PIPE_BUFFERS块，
+     *          以位压缩的slot_indicator为输入时，除指示向量本身（每槽位1位）外，额外内存与槽位数无关。
+     *          种子在设置输入后首次share()时抽取，对同一输入重复share()发送逐字节相同的份额，
+     *          代理方中断后从检查点恢复（见merge_checkpoint）时，持有方可经set_connections()接入新连接后重新发送。
+     *          设置份额位宽K后（见set_share_bits()），AS1的份额为x - PRG(seed) mod 2^K，经comm_packer按K位打包发送，
+     *          上传量按K / |RT|缩减；代理方仍在RT上累加，查询方恢复后取低K位（见open_queue::set_share_bits()）。
+     *          share_async()在协程中逐块编码、掩码并发送，PRG展开分窗让出工作线程（见async_fill()），不另起线程；
+     *          发送仍为阻塞调用，进程内连接的队列满时占用工作线程直至代理方取走报文。
+     */
+    template <typename RT>
     class data_holder_ass : public data_holder_ideal_fn
     {
+    public:
+        /** @brief 断言限制模板类型 */
+        static_assert(
+            is_word_ring_type<RT>,
+            "RT must be ring8, ring16, ring32, or ring64."
+            );
+
+        /**
+         * @brief   构造数据持有方
+         * @param   comm_adapter<RT>& as0 与AS0的连接
+         * @param   comm_adapter<RT>& as1 与AS1的连接
+         */
+        data_holder_ass(comm_adapter<RT>& as0, comm_adapter<RT>& as1);
+
+        /**
+         * @brief   构造分片部署下的数据持有方
+         * @param   const shard_map& map 槽位分片
+         * @param   const std::vector<comm_adapter<RT>*>& as0 与各分片AS0的连接，按分片号排列
+         * @param   const std::vector<comm_adapter<RT>*>& as1 与各分片AS1的连接，按分片号排列
+         * @throw   protocol_exc 连接个数与分片数不符
+         */
+        data_holder_ass
+        (
+            const shard_map& map,
+            const std::vector<comm_adapter<RT>*>& as0,
+            const std::vector<comm_adapter<RT>*>& as1
+        );
+
+        static constexpr uint64_t mc_PIPE_BUFFERS = 4;  // 流水线中循环使用的分块缓存区个数
+
+        /**
+         * @brief   替换与各分片代理方的连接（用于代理方恢复后重新发送）
+         * @param   const std::vector<comm_adapter<RT>*>& as0 与各分片AS0的连接，按分片号排列
+         * @param   const std::vector<comm_adapter<RT>*>& as1 与各分片AS1的连接，按分片号排列
+         * @return  void
+         * @throw   protocol_exc 连接个数与分片数不符
+         */
+        void set_connections(const std::vector<comm_adapter<RT>*>& as0, const std::vector<comm_adapter<RT>*>& as1);
+
+        /**
+         * @brief   设置AS1份额的位宽K，协议随之在Z_{2^K}上进行，持有方个数须小于2^K
+         * @param   uint8_t bits 位宽，默认为环位宽
+         * @return  void
+         * @throw   protocol_exc 位宽不在[1, 环位宽]内
+         */
+        void set_share_bits(uint8_t bits);
+
+        /**
+         * @brief   设置待分享的编码向量x
+         * @param   rvector<RT>&& x 编码向量
+         * @return  void
+         */
+        void set_input(rvector<RT>&& x);
+
+        /**
+         * @brief   设置待分享的槽位指示向量，分享时逐块展开为环上0/1值，不生成完整的编码向量
+         * @param   slot_indicator&& x 槽位指示向量
+         * @return  void
+         */
+        void set_input(slot_indicator&& x);
+
+        /**
+         * @brief   秘密分享：对每个分片向AS0发送种子，向AS1分块发送该区间的x - PRG(seed)
+         * @return  void
+         * @note    多于一块时编码、掩码与发送在三个线程上重叠执行，任一级出错时其余各级随之停止，异常在调用线程重新抛出。
+         * @throw   protocol_exc 未设置编码向量，或分片部署下编码向量长度与槽位总数不符
+         */
+        void share() override;
+
+        /**
+         * @brief   在协程中秘密分享，份额与share()逐字节相同
+         * @param   coro_pool& pool 恢复协程的线程池
+         * @return  coro_task<void> 全部份额发出后结束
+         * @throw   protocol_exc 同share()（在co_await处抛出）
+         */
+        coro_task<void> share_async(coro_pool& pool);
+
+        /**
+         * @brief   数据持有方不参与恢复秘密
+         * @throw   protocol_exc 始终抛出
+         */
+        void reveal() override;
+
+    private:
+        shard_map m_map;                        // 槽位分片，未分片时为默认的单一分片
+        std::vector<comm_adapter<RT>*> m_as0;   // 与各分片AS0的连接
+        std::vector<comm_adapter<RT>*> m_as1;   // 与各分片AS1的连接
+        rvector<RT> m_input;                    // 编码向量x
+        std::optional<slot_indicator> m_bits;   // 位压缩的编码向量x（与m_input二选一）
+        std::vector<prg_openssl::seed_type> m_seeds;    // 各分片的种子，重复分享同一输入时复用
+        uint8_t m_share_bits;                   // AS1份额的位宽
+
+        /** @brief 编码向量长度 */
+        uint64_t input_size() const noexcept { return m_bits ? m_bits->size() : m_input.size(); }
+
+        /**
+         * @brief   校验输入，向各分片AS0发送种子、向AS1声明份额长度
+         * @param   std::vector<seed_share<RT>>& seeds 输出各分片的种子份额
+         * @return  shard_map 本次分享使用的分片（未分片时为覆盖整个输入的单一分片）
+         */
+        shard_map begin_share(std::vector<seed_share<RT>>& seeds);
+
+        /** @brief 写出x在[first, first + len)区间的编码值 */
+        void encode_into(uint64_t first, RT* out, uint64_t len) const;
     };
 }
-#endif // !DATA_HOLDER_ASS_HPP
\ No newline at end of file
+
+extern template class mpmt::data_holder_ass<mpmt::ring8>;
+extern template class mpmt::data_holder_ass<mpmt::ring16>;
+extern template class mpmt::data_holder_ass<mpmt::ring32>;
+extern template class mpmt::data_holder_ass<mpmt::ring64>;
+
+#endif // !DATA_HOLDER_ASS_HPP
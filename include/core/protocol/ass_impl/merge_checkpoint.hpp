@@ -0,0 +1,183 @@
+#ifndef MERGE_CHECKPOINT_HPP
+#define MERGE_CHECKPOINT_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+
+#include "core/mpmtcfg.hpp"
+#include "core/protocol/ass_impl/ass_role.hpp"
+#include "core/ring/ring.hpp"
+#include "core/ring/rvector.hpp"
+
+/** @namespace 项目命名空间。 */
+namespace mpmt
+{
+    /**
+     * @brief   一次聚合的进度：m_links个连接中前m_folded个已完整累加，
+     *          其余连接已在槽位前缀[0, m_slots_done)上累加（AS1按连接推进，AS0按槽位区间推进）
+     */
+    struct merge_progress
+    {
+        uint64_t m_links = 0;           // 本次聚合的连接数
+        uint64_t m_folded = 0;          // 已完整累加的连接数（按连接顺序的前缀）
+        uint64_t m_slots_done = 0;      // 其余连接已累加的槽位前缀长度
+    };
+
+    /**
+     * @class   合并检查点：周期性地持久化代理方的累加器与合并进度，崩溃后从最近的检查点继续合并
+     * @tparam  RT 环类型，限定为ring8,ring16,ring32,ring64
+     * @note    1. 每个检查点由累加器快照<path>.gen<g>.mrvf与清单<path>.manifest组成；
+     *             快照与清单均先写临时文件、落盘后原子重命名（见durable_file），清单替换成功即为提交点，
+     *             随后才删除上一代快照，因此任意时刻崩溃，清单总是指向一份完整的快照；
+     *             提交与删除之间崩溃遗留的快照、临时文件在下次构造时清除。
+     *          2. offer()由聚合线程在每组（或每个区间）累加后调用：间隔未到或上一个检查点仍在写入时立即返回，
+     *             否则把累加器复制为快照交给后台线程写入，聚合线程只承担一次内存复制。
+     *          3. 后台写入失败只记录日志，不中断合并，下一次offer()重新尝试；commit()同步写入并在失败时抛出。
+     *          4. 恢复时load()读取清单与快照；代理方载入后跳过已累加的部分（见agent_ass::resume()），
+     *             持有方对同一输入重新发送的份额逐字节相同（见data_holder_ass），因此两个代理方可以各自从自己的检查点恢复。
+     */
+    template <typename RT>
+    class merge_checkpoint
+    {
+    public:
+        /** @brief 断言限制模板类型 */
+        static_assert(
+            is_word_ring_type<RT>,
+            "RT must be ring8, ring16, ring32, or ring64."
+            );
+
+        struct config
+        {
+            std::string m_path;                 // 检查点路径前缀
+            double m_interval_seconds = 60.0;   // 两个检查点之间的最小间隔（秒），0表示每次offer()都尝试
+        };
+
+        /** @brief 从检查点恢复的累加器与进度 */
+        struct resume_point
+        {
+            rvector<RT> m_union;                // 累加器
+            merge_progress m_progress;          // 合并进度
+        };
+
+        /**
+         * @brief   构造检查点写入器并启动后台线程；已有检查点时从其代数继续编号，并删除清单未引用的快照与临时文件
+         * @param   const config& cfg 检查点配置
+         * @param   ass_role role 代理方角色，写入清单用于恢复时校验
+         * @throw   protocol_exc 已有的清单损坏
+         */
+        merge_checkpoint(const config& cfg, ass_role role);
+
+        /**
+         * @brief   若已到间隔且后台空闲，复制累加器并在后台写入检查点
+         * @param   const rvector<RT>& acc 累加器
+         * @param   const merge_progress& progress 累加器对应的进度
+         * @return  bool 是否接受本次检查点
+         */
+        bool offer(const rvector<RT>& acc, const merge_progress& progress);
+
+        /**
+         * @brief   等待在途的检查点后同步写入一个检查点
+         * @param   const rvector<RT>& acc 累加器
+         * @param   const merge_progress& progress 累加器对应的进度
+         * @return  void
+         * @throw   mrvf_exc 快照或清单写入失败
+         */
+        void commit(const rvector<RT>& acc, const merge_progress& progress);
+
+        /**
+         * @brief   等待在途的检查点写完
+         * @return  void
+         */
+        void wait();
+
+        /**
+         * @brief   获取已提交的检查点个数
+         * @return  uint64_t 个数
+         */
+        uint64_t written() const noexcept { return m_written.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief   读取最近提交的检查点
+         * @param   const std::string& path 检查点路径前缀
+         * @param   ass_role role 代理方角色
+         * @return  std::optional<resume_point> 没有清单时为空
+         * @throw   protocol_exc 清单损坏，或角色、环位宽、长度与清单不符
+         * @throw   mrvf_exc 快照读取或校验失败
+         */
+        static std::optional<resume_point> load(const std::string& path, ass_role role);
+
+        /**
+         * @brief   获取清单路径
+         * @param   const std::string& path 检查点路径前缀
+         * @return  std::string 清单路径
+         */
+        static std::string manifest_path(const std::string& path) { return path + ".manifest"; }
+
+        /** @brief 等待在途的检查点写完后停止后台线程 */
+        ~merge_checkpoint();
+
+    private:
+        /** @brief 清单记录的内容 */
+        struct manifest
+        {
+            merge_progress m_progress;          // 合并进度
+            uint64_t m_slots = 0;               // 累加器长度
+            uint64_t m_generation = 0;          // 代数
+            std::string m_union_file;           // 快照文件名（与清单同目录）
+        };
+
+        using clock = std::chrono::steady_clock;
+
+        const config mc_config;                 // 检查点配置
+        const ass_role mc_role;                 // 代理方角色
+        std::mutex m_mutex;                     // 保护待写快照与状态
+        std::condition_variable m_job_cv;       // 有待写快照或停止
+        std::condition_variable m_done_cv;      // 后台空闲
+        rvector<RT> m_snapshot;                 // 待写快照
+        merge_progress m_snapshot_progress;     // 待写快照的进度
+        bool m_has_job;                         // 是否有待写快照
+        bool m_stop;                            // 是否停止
+        std::atomic<bool> m_busy;               // 是否有在途的检查点（待写或写入中）
+        std::exception_ptr m_failure;           // 最近一次写入的异常
+        clock::time_point m_last;               // 上一次接受检查点的时刻
+        uint64_t m_generation;                  // 最近提交的代数（仅后台线程修改）
+        std::string m_committed_file;           // 最近提交的快照路径（仅后台线程修改）
+        std::atomic<uint64_t> m_written;        // 已提交的检查点个数
+        std::thread m_thread;                   // 后台写入线程
+
+        /** @brief 复制累加器为待写快照并唤醒后台线程，调用方持有锁且后台空闲 */
+        void submit(const rvector<RT>& acc, const merge_progress& progress);
+
+        /** @brief 后台线程主循环 */
+        void work();
+
+        /** @brief 写入一个检查点：快照、清单、删除上一代快照 */
+        void write(rvector<RT>&& snapshot, const merge_progress& progress);
+
+        /** @brief 读取清单，不存在时为空 */
+        static std::optional<manifest> read_manifest(const std::string& path, ass_role role);
+
+        /** @brief 删除路径前缀下除keep（快照文件名，可为空）以外的各代快照及临时文件 */
+        static void remove_orphans(const std::string& path, const std::string& keep);
+
+        /** @brief 快照文件相对清单所在目录的完整路径 */
+        static std::string sibling_of(const std::string& path, const std::string& file);
+
+        merge_checkpoint(const merge_checkpoint&) = delete;
+        merge_checkpoint& operator=(const merge_checkpoint&) = delete;
+    };
+}
+
+extern template class mpmt::merge_checkpoint<mpmt::ring8>;
+extern template class mpmt::merge_checkpoint<mpmt::ring16>;
+extern template class mpmt::merge_checkpoint<mpmt::ring32>;
+extern template class mpmt::merge_checkpoint<mpmt::ring64>;
+
+#endif // !MERGE_CHECKPOINT_HPP
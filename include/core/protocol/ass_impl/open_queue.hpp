@@ -0,0 +1,187 @@
+#ifndef OPEN_QUEUE_HPP
+#define OPEN_QUEUE_HPP
+
+#include <vector>
+
+#include "core/mpmtcfg.hpp"
+#include "core/comm/comm_adapter.hpp"
+#include "core/coro/coro_pool.hpp"
+#include "core/coro/coro_task.hpp"
+#include "core/protocol/ass_impl/shard_map.hpp"
+#include "core/ring/ring.hpp"
+
+/** @namespace 项目命名空间。 */
+namespace mpmt
+{
+    /**
+     * @class   惰性打开队列：把同一层内相互独立的打开请求合并为一轮通信
+     * @tparam  RT 环类型，限定为ring8,ring16,ring32,ring64
+     * @note    1. defer()只登记请求并返回票据；send()把本层全部请求的槽位取并集、升序去重后，
+     *             按分片路由为每个含有本层槽位的代理方恰好一条令牌，不含本层槽位的分片不发送；
+     *             receive()只从收到令牌的代理方收回份额、恢复计数并一次解析本层全部票据。
+     *          2. 代理方按令牌逐槽位返回份额，不区分令牌来自一个还是多个请求，报文格式与单次查询相同；
+     *             令牌不含请求边界，合并后代理方看到的只是槽位的并集。令牌经ass_wire::send_token()按位宽打包发送，
+     *             返回的份额均匀随机，不压缩。
+     *          3. 每层的通信轮数恒为1，与请求个数无关；WAN下查询时延由轮数而非带宽主导时，
+     *             应尽量把可并发的请求登记在同一层再统一发送。
+     *          4. 本层解析后首次defer()开始新的一层，上一层票据随之失效。
+     *          5. 持有方以份额位宽K分享时（见data_holder_ass::set_share_bits()），须以set_share_bits()设置相同的K，
+     *             恢复的计数取低K位。
+     */
+    template <typename RT>
+    class open_queue
+    {
+    public:
+        /** @brief 断言限制模板类型 */
+        static_assert(
+            is_word_ring_type<RT>,
+            "RT must be ring8, ring16, ring32, or ring64."
+            );
+
+        using ticket = uint64_t;    // 打开请求的票据
+
+        /**
+         * @brief   构造打开队列
+         * @param   const shard_map& map 槽位分片，未分片时为默认的单一分片
+         * @param   const std::vector<comm_adapter<RT>*>& as0 与各分片AS0的连接，按分片号排列
+         * @param   const std::vector<comm_adapter<RT>*>& as1 与各分片AS1的连接，按分片号排列
+         * @throw   protocol_exc 连接个数与分片数不符
+         */
+        open_queue
+        (
+            const shard_map& map,
+            const std::vector<comm_adapter<RT>*>& as0,
+            const std::vector<comm_adapter<RT>*>& as1
+        );
+
+        /**
+         * @brief   登记一个打开请求
+         * @param   const std::vector<uint64_t>& slots 待打开的槽位（顺序与重复不影响结果）
+         * @return  ticket 票据
+         * @throw   protocol_exc 本层已发送尚未收回，或槽位超出槽位总数
+         */
+        ticket defer(const std::vector<uint64_t>& slots);
+
+        /**
+         * @brief   发送本层：向每个分片的两个代理方各发送一条合并后的令牌
+         * @return  void
+         * @throw   protocol_exc 本层没有待发送的请求
+         */
+        void send();
+
+        /**
+         * @brief   收回本层：接收各代理方的份额并恢复计数，解析本层全部票据
+         * @return  void
+         * @throw   protocol_exc 本层尚未发送，或代理方返回的份额个数与令牌不符
+         */
+        void receive();
+
+        /**
+         * @brief   在协程中收回本层：份额未到达时挂起，语义同receive()
+         * @param   coro_pool& pool 恢复协程的线程池
+         * @return  coro_task<void> 本层解析后结束
+         * @throw   protocol_exc 本层尚未发送，或代理方返回的份额个数与令牌不符（在co_await处抛出）
+         */
+        coro_task<void> receive_async(coro_pool& pool);
+
+        /**
+         * @brief   发送并收回本层（一轮通信）
+         * @return  void
+         */
+        void flush() { send(); receive(); }
+
+        /**
+         * @brief   丢弃本层尚未发送的请求并开始新的一层
+         * @return  void
+         * @throw   protocol_exc 本层已发送尚未收回
+         */
+        void clear();
+
+        /**
+         * @brief   设置份额位宽K，恢复的计数取低K位
+         * @param   uint8_t bits 位宽，默认为环位宽
+         * @return  void
+         * @throw   protocol_exc 位宽不在[1, 环位宽]内
+         */
+        void set_share_bits(uint8_t bits);
+
+        /**
+         * @brief   获取票据对应槽位的恢复计数
+         * @param   ticket t 本层已解析的票据
+         * @return  std::vector<RT> 计数，与请求槽位升序去重后一一对应
+         * @throw   protocol_exc 票据不属于本层或尚未解析
+         */
+        std::vector<RT> counts(ticket t) const;
+
+        /**
+         * @brief   判定票据对应的全部槽位计数是否均非0
+         * @param   ticket t 本层已解析的票据
+         * @return  bool 是否全部非0
+         * @throw   protocol_exc 票据不属于本层或尚未解析
+         */
+        bool all_nonzero(ticket t) const;
+
+        /**
+         * @brief   获取最近一次send()为某分片编码的令牌，即该代理方查询缓存的键（为空时未发送）
+         * @param   uint32_t shard 分片号，未分片时为0
+         * @return  const std::vector<RT>& 令牌
+         */
+        const std::vector<RT>& token(uint32_t shard = 0) const noexcept { return m_tokens[shard]; }
+
+        /**
+         * @brief   获取本层登记的请求个数
+         * @return  uint64_t 请求个数
+         */
+        uint64_t pending() const noexcept { return m_requests.size(); }
+
+        /**
+         * @brief   获取累计完成的通信轮数
+         * @return  uint64_t 轮数
+         */
+        uint64_t rounds() const noexcept { return m_rounds; }
+
+    private:
+        /** @brief 本层所处阶段 */
+        enum class phase : uint8_t
+        {
+            COLLECTING,     // 登记中
+            SENT,           // 已发送，等待收回
+            RESOLVED,       // 已解析
+        };
+
+        shard_map m_map;                                // 槽位分片
+        std::vector<comm_adapter<RT>*> m_as0;           // 与各分片AS0的连接
+        std::vector<comm_adapter<RT>*> m_as1;           // 与各分片AS1的连接
+        phase m_phase;                                  // 本层所处阶段
+        ticket m_base;                                  // 本层首个票据
+        std::vector<std::vector<uint64_t>> m_requests;  // 本层各请求的槽位（升序去重）
+        std::vector<uint64_t> m_slots;                  // 本层槽位并集（升序去重，全局下标）
+        std::vector<uint64_t> m_shard_slots;            // 各分片的槽位个数
+        std::vector<std::vector<RT>> m_tokens;          // 各分片的令牌（分片内下标）
+        std::vector<RT> m_counts;                       // 与m_slots一一对应的恢复计数
+        RT m_share_mask;                                // 份额位宽的掩码
+        uint64_t m_rounds;                              // 累计通信轮数
+
+        /** @brief 校验本层已发送并清空计数 */
+        void begin_receive();
+
+        /** @brief 校验某分片两方返回的份额个数并追加恢复计数 */
+        void absorb(uint32_t shard, const std::vector<RT>& share0, const std::vector<RT>& share1);
+
+        /** @brief 本层解析完毕 */
+        void end_receive();
+
+        /** @brief 解析后首次登记时开始新的一层 */
+        void next_layer();
+
+        /** @brief 校验票据属于本层且已解析，返回其在本层的下标 */
+        uint64_t index_of(ticket t) const;
+    };
+}
+
+extern template class mpmt::open_queue<mpmt::ring8>;
+extern template class mpmt::open_queue<mpmt::ring16>;
+extern template class mpmt::open_queue<mpmt::ring32>;
+extern template class mpmt::open_queue<mpmt::ring64>;
+
+#endif // !OPEN_QUEUE_HPP
@@ -1,18 +1,146 @@
-
 #ifndef QUERIER_ASS_HPP
 #define QUERIER_ASS_HPP
 
+#include <vector>
+
 #include "core/mpmtcfg.hpp"
+#include "core/comm/comm_adapter.hpp"
+#include "core/coro/coro_pool.hpp"
+#include "core/coro/coro_task.hpp"
 #include "core/protocol/querier_ideal_fn.hpp"
+#include "core/protocol/ass_impl/open_queue.hpp"
+#include "core/protocol/ass_impl/shard_map.hpp"
+#include "core/ring/ring.hpp"
 
 /** @namespace 项目命名空间。 */
 namespace mpmt
 {
-    class querier_ass : public querier_ideal_fn   
+    /**
+     * @class   查询方（加法秘密分享实现）
+     * @tparam  RT 环类型，限定为ring8,ring16,ring32,ring64
+     * @note    1. 查询令牌为凭据经带密钥哈希得到的k个槽位下标，代理方不持有哈希密钥，
+     *             看到的只是伪随机下标，而非凭据明文。
+     *          2. share()向两个代理方发送令牌，reveal()收回两方在这些槽位上的份额并恢复计数，
+     *             k个槽位计数均非0即判定凭据存在于并集中。
+     *          3. set_query()将槽位升序排列并去重后编码为令牌，同一凭据的令牌逐字节相同，
+     *             代理方可以令牌为键缓存份额（见query_cache）；去重不改变判定结果。
+     *          4. 分片部署时（见shard_map）槽位按所属分片路由为分片内下标，每个分片的代理方对收到各自的令牌；
+     *             不含本分片槽位的代理方对不参与该次查询，代理方响应的次数因此不固定，应响应至查询方断开连接。
+     *          5. 令牌的路由、发送与恢复由open_queue完成，单次查询即只含一个请求的一层；
+     *             需要把多次查询合并为一轮时直接使用queue()登记请求后统一flush()。
+     *          6. 泄露：代理方未设置盲化密钥时，counts()即持有该凭据的持有方个数；设置后（见agent_ass::set_blind_key()）
+     *             为计数乘以随机奇数，只泄露计数是否为0及其2-adic赋值（见reveal_blind）。
+     *             令牌由凭据确定，代理方可以关联同一凭据的多次查询，两个代理方合谋还可关联其槽位。
+     */
+    template <typename RT>
+    class querier_ass : public querier_ideal_fn
     {
     public:
+        /** @brief 断言限制模板类型 */
+        static_assert(
+            is_word_ring_type<RT>,
+            "RT must be ring8, ring16, ring32, or ring64."
+            );
+
+        /**
+         * @brief   构造查询方
+         * @param   comm_adapter<RT>& as0 与AS0的连接
+         * @param   comm_adapter<RT>& as1 与AS1的连接
+         */
+        querier_ass(comm_adapter<RT>& as0, comm_adapter<RT>& as1);
+
+        /**
+         * @brief   构造分片部署下的查询方
+         * @param   const shard_map& map 槽位分片
+         * @param   const std::vector<comm_adapter<RT>*>& as0 与各分片AS0的连接，按分片号排列
+         * @param   const std::vector<comm_adapter<RT>*>& as1 与各分片AS1的连接，按分片号排列
+         * @throw   protocol_exc 连接个数与分片数不符
+         */
+        querier_ass
+        (
+            const shard_map& map,
+            const std::vector<comm_adapter<RT>*>& as0,
+            const std::vector<comm_adapter<RT>*>& as1
+        );
+
+        /**
+         * @brief   设置查询令牌
+         * @param   const std::vector<uint64_t>& slots 凭据对应的k个槽位（顺序与重复不影响令牌）
+         * @return  void
+         */
+        void set_query(const std::vector<uint64_t>& slots);
+
+        /**
+         * @brief   执行一次完整查询（share + reveal）
+         * @return  void
+         */
+        void query() override;
+
+        /**
+         * @brief   向各分片的两个代理方发送查询令牌
+         * @return  void
+         * @throw   protocol_exc 未设置查询令牌，或槽位超出槽位总数
+         */
+        void share() override;
+
+        /**
+         * @brief   收回各分片两方的份额并恢复查询结果
+         * @return  void
+         * @throw   protocol_exc 代理方返回的份额个数与令牌不符
+         */
+        void reveal() override;
+
+        /**
+         * @brief   在协程中执行一次完整查询：等待份额时挂起而非阻塞线程，语义同query()
+         * @param   coro_pool& pool 恢复协程的线程池
+         * @return  coro_task<void> 查询结果就绪后结束
+         * @throw   protocol_exc 同share()与reveal()（在co_await处抛出）
+         */
+        coro_task<void> query_async(coro_pool& pool);
+
+        /**
+         * @brief   获取最近一次查询结果
+         * @return  bool 凭据是否存在于并集中
+         */
+        bool result() const noexcept { return m_result; }
+
+        /**
+         * @brief   获取最近一次查询恢复出的各槽位计数（代理方启用盲化时为盲化后的计数，仅是否为0有意义）
+         * @return  const std::vector<RT>& 槽位计数，与slots()一一对应
+         */
+        const std::vector<RT>& counts() const noexcept { return m_counts; }
+
+        /**
+         * @brief   获取规范化（升序、去重）后的查询槽位
+         * @return  const std::vector<uint64_t>& 槽位
+         */
+        const std::vector<uint64_t>& slots() const noexcept { return m_slots; }
+
+        /**
+         * @brief   获取最近一次share()发送给某分片代理方的查询令牌，即该代理方查询缓存的键
+         * @param   uint32_t shard 分片号，未分片时为0
+         * @return  const std::vector<RT>& 令牌
+         */
+        const std::vector<RT>& token(uint32_t shard = 0) const noexcept { return m_queue.token(shard); }
+
+        /**
+         * @brief   获取底层的惰性打开队列（用于把多次查询合并为一轮）
+         * @return  open_queue<RT>& 打开队列
+         */
+        open_queue<RT>& queue() noexcept { return m_queue; }
+
+    private:
+        open_queue<RT> m_queue;                         // 惰性打开队列
+        typename open_queue<RT>::ticket m_ticket;       // 当前查询的票据
+        std::vector<uint64_t> m_slots;                  // 规范化后的查询槽位（全局下标）
+        std::vector<RT> m_counts;                       // 恢复出的槽位计数
+        bool m_result;                                  // 查询结果
     };
 }
-#endif // !QUERIER_ASS_HPP
 
+extern template class mpmt::querier_ass<mpmt::ring8>;
+extern template class mpmt::querier_ass<mpmt::ring16>;
+extern template class mpmt::querier_ass<mpmt::ring32>;
+extern template class mpmt::querier_ass<mpmt::ring64>;
 
+#endif // !QUERIER_ASS_HPP
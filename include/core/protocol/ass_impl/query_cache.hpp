@@ -0,0 +1,109 @@
+#ifndef QUERY_CACHE_HPP
+#define QUERY_CACHE_HPP
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "core/mpmtcfg.hpp"
+#include "core/ring/ring.hpp"
+
+/** @namespace 项目命名空间。 */
+namespace mpmt
+{
+    /**
+     * @class   代理方查询结果缓存（加法秘密分享实现）
+     * @tparam  RT 环类型，限定为ring8,ring16,ring32,ring64
+     * @note    1. 以查询方发来的令牌原文为键（带密钥哈希得到的槽位下标，代理方本就可见），
+     *             缓存本方在这些槽位上的份额；代理方因此不会比逐次收集多知道任何信息。
+     *          2. 容量按条目数限制，满后按CLOCK（二次机会）淘汰：命中置引用位，指针扫过时清除，
+     *             扫到未被引用的条目即淘汰。
+     *          3. 并集份额改变后须调用clear()：条目的缓存区保留，索引节点移入备用列表，之后的insert()复用二者；
+     *             resize()一次性预留索引的桶与备用列表，容量不变时clear()与insert()不再分配索引内存，
+     *             条目缓存区只在令牌或份额长于以往时增长。
+     *          4. 容量上限为mc_MAX_CAPACITY条目；resize()按容量预留的内存为O(capacity)，条目本身按需增长。
+     *          5. 对象非线程安全，并发场景应每个线程持有一个。
+     */
+    template <typename RT>
+    class query_cache
+    {
+    public:
+        /** @brief 断言限制模板类型 */
+        static_assert(
+            is_word_ring_type<RT>,
+            "RT must be ring8, ring16, ring32, or ring64."
+            );
+
+        static constexpr uint64_t mc_MAX_CAPACITY = 1ULL << 20;    // 容量上限（条目数）
+
+        /**
+         * @brief   构造缓存
+         * @param   uint64_t capacity 最多缓存的条目数，0表示不缓存
+         * @throw   protocol_exc 容量超过mc_MAX_CAPACITY
+         */
+        explicit query_cache(uint64_t capacity = 0);
+
+        /**
+         * @brief   查找令牌对应的份额，命中时置引用位
+         * @param   const std::vector<RT>& token 查询令牌
+         * @return  const std::vector<RT>* 缓存的份额，未命中为nullptr（下次insert()或clear()前有效）
+         */
+        const std::vector<RT>* find(const std::vector<RT>& token);
+
+        /**
+         * @brief   缓存令牌对应的份额，必要时淘汰一个条目
+         * @param   const std::vector<RT>& token 查询令牌
+         * @param   const std::vector<RT>& shares 本方在令牌槽位上的份额
+         * @return  void
+         */
+        void insert(const std::vector<RT>& token, const std::vector<RT>& shares);
+
+        /**
+         * @brief   清空缓存（并集份额改变后调用），保留已分配的条目与索引节点
+         * @return  void
+         */
+        void clear() noexcept;
+
+        /**
+         * @brief   重新设置容量并清空缓存，释放原有条目后按新容量预留索引
+         * @param   uint64_t capacity 最多缓存的条目数，0表示不缓存
+         * @return  void
+         * @throw   protocol_exc 容量超过mc_MAX_CAPACITY
+         */
+        void resize(uint64_t capacity);
+
+        uint64_t capacity() const noexcept { return m_capacity; }
+        uint64_t size() const noexcept { return m_index.size(); }
+        uint64_t hits() const noexcept { return m_hits; }
+        uint64_t misses() const noexcept { return m_misses; }
+
+    private:
+        /** @brief 缓存条目 */
+        struct entry
+        {
+            uint64_t m_hash = 0;                // 令牌哈希
+            std::vector<RT> m_token;            // 令牌原文（用于排除哈希碰撞）
+            std::vector<RT> m_shares;           // 缓存的份额
+            bool m_referenced = false;          // CLOCK引用位
+        };
+
+        uint64_t m_capacity;                                // 容量
+        std::vector<entry> m_entries;                       // 条目（按需增长至容量）
+        std::unordered_map<uint64_t, uint64_t> m_index;     // 令牌哈希 -> 条目下标
+        std::vector<typename std::unordered_map<uint64_t, uint64_t>::node_type> m_spare;    // clear()回收的索引节点
+        uint64_t m_used;                                    // 有效条目前缀长度（clear()后重新计数）
+        uint64_t m_hand;                                    // CLOCK指针
+        uint64_t m_hits;                                    // 命中次数
+        uint64_t m_misses;                                  // 未命中次数
+
+        /** @brief 计算令牌哈希 */
+        static uint64_t hash_of(const std::vector<RT>& token) noexcept;
+    };
+}
+
+extern template class mpmt::query_cache<mpmt::ring8>;
+extern template class mpmt::query_cache<mpmt::ring16>;
+extern template class mpmt::query_cache<mpmt::ring32>;
+extern template class mpmt::query_cache<mpmt::ring64>;
+
+#endif // !QUERY_CACHE_HPP
@@ -0,0 +1,82 @@
+#ifndef RELAY_ASS_HPP
+#define RELAY_ASS_HPP
+
+#include <vector>
+
+#include "core/mpmtcfg.hpp"
+#include "core/comm/comm_adapter.hpp"
+#include "core/protocol/ass_impl/agent_ass.hpp"
+#include "core/ring/rvector.hpp"
+
+/** @namespace 项目命名空间。 */
+namespace mpmt
+{
+    /**
+     * @class   聚合树的中继节点（加法秘密分享实现）：为一个代理方角色预先合并若干下游的份额
+     * @tparam  RT 环类型，限定为ring8,ring16,ring32,ring64
+     * @note    1. 下游可以是数据持有方或其他中继，上游可以是代理方或其他中继；
+     *             中继向上游发送的报文格式与单个数据持有方相同，代理方无需区分下游是否经过中继。
+     *          2. AS1中继逐块接收各下游的掩码份额，经k路融合内核求和后按ass_wire::mc_CHUNK_SIZE分块转发，
+     *             峰值内存为每个下游一块；扇入为F、深度为d的树使AS1的入口流量由N份降为F份。
+     *          3. AS0中继不展开种子：种子份额仅数十字节，求和为稠密向量反而放大上游流量，
+     *             因此把下游的种子束拼接为一个种子束转发，AS0的入口报文数同样降为F个。
+     *          4. 中继只可见单一角色的份额，单侧份额与均匀随机不可区分；同一参与方不得同时担任同一持有方
+     *             在AS0与AS1两侧路径上的中继，否则可恢复该持有方的输入。部署上宜由各代理方自己的聚合工作进程担任。
+     */
+    template <typename RT>
+    class relay_ass
+    {
+    public:
+        /** @brief 断言限制模板类型 */
+        static_assert(
+            is_word_ring_type<RT>,
+            "RT must be ring8, ring16, ring32, or ring64."
+            );
+
+        /**
+         * @brief   构造中继节点
+         * @param   ass_role role 所服务的代理方角色
+         * @param   const std::vector<comm_adapter<RT>*>& children 与各下游的连接
+         * @param   comm_adapter<RT>& parent 与上游的连接
+         */
+        relay_ass(ass_role role, const std::vector<comm_adapter<RT>*>& children, comm_adapter<RT>& parent);
+
+        /**
+         * @brief   转发一轮：接收每个下游的一份份额，合并后向上游发送一份
+         * @return  void
+         * @throw   protocol_exc 没有下游、报文损坏或各下游的份额长度不一致
+         * @throw   comm_exc 下游连接已关闭
+         * @note    出错时先断开上游连接再抛出，上游代理方随之中断（可从检查点恢复，见merge_checkpoint）。
+         */
+        void forward();
+
+        /**
+         * @brief   获取所服务的代理方角色
+         * @return  ass_role 角色
+         */
+        ass_role role() const noexcept { return mc_role; }
+
+    private:
+        static constexpr uint64_t mc_FUSE_WAY = 8;      // 一次融合累加的下游个数
+
+        const ass_role mc_role;                         // 所服务的代理方角色
+        std::vector<comm_adapter<RT>*> m_children;      // 与各下游的连接
+        comm_adapter<RT>& m_parent;                     // 与上游的连接
+
+        /** @brief AS0：拼接下游的种子束 */
+        void forward_seeds();
+
+        /** @brief AS1：逐块求和下游的掩码份额 */
+        void forward_chunks();
+
+        relay_ass(const relay_ass&) = delete;
+        relay_ass& operator=(const relay_ass&) = delete;
+    };
+}
+
+extern template class mpmt::relay_ass<mpmt::ring8>;
+extern template class mpmt::relay_ass<mpmt::ring16>;
+extern template class mpmt::relay_ass<mpmt::ring32>;
+extern template class mpmt::relay_ass<mpmt::ring64>;
+
+#endif // !RELAY_ASS_HPP
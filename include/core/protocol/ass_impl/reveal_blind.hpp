@@ -0,0 +1,68 @@
+#ifndef REVEAL_BLIND_HPP
+#define REVEAL_BLIND_HPP
+
+#include <vector>
+
+#include "core/hash/siphash_impl/hash_siphash.hpp"
+#include "core/ring/ring.hpp"
+
+/** @namespace 项目命名空间。 */
+namespace mpmt
+{
+    /**
+     * @class   查询响应的乘法盲化：代理方返回份额前将第i个槽位的份额乘以随机奇数r_i
+     * @tparam  RT 环类型，限定为ring8,ring16,ring32,ring64
+     * @note    1. r_i = PRF(key, 令牌, i) | 1，各代理方持有同一密钥（查询方不持有），对同一令牌得到相同的r_i，
+     *             份额之和即为r_i * c_i；r_i为环上的单位，r_i * c_i为0当且仅当c_i为0，查询判定不变。
+     *          2. 查询方不再看到持有该凭据的持有方个数，只看到各槽位计数是否为0，以及计数的2-adic赋值
+     *             （r_i * c_i的最低置位，Z_{2^l}上的乘法盲化无法消除）。
+     *          3. r_i只依赖令牌，同一令牌的响应逐字节相同，查询缓存（见query_cache）仍然有效；
+     *             同一凭据的多次查询可由查询方互相关联，这与令牌本身可被代理方关联相同。
+     */
+    template <typename RT>
+    class reveal_blind
+    {
+    public:
+        /** @brief 断言限制模板类型 */
+        static_assert(
+            is_word_ring_type<RT>,
+            "RT must be ring8, ring16, ring32, or ring64."
+            );
+
+        using key_type = hash_siphash::key_type;
+
+        /**
+         * @brief   以代理方共享的盲化密钥构造
+         * @param   const key_type& key 128位密钥
+         */
+        explicit reveal_blind(const key_type& key) noexcept
+            :
+            m_prf(key)
+        {}
+
+        /**
+         * @brief   将shares[i]乘以r_i（i < n）
+         * @param   const std::vector<RT>& token 查询令牌
+         * @param   RT* shares 令牌槽位上的份额，原地盲化
+         * @param   uint64_t n 份额个数
+         * @return  void
+         */
+        void apply(const std::vector<RT>& token, RT* shares, uint64_t n) const noexcept
+        {
+            // 先以令牌摘要(d0, d1)绑定本次查询，再逐槽位以(d0, d1, i)派生r_i
+            uint64_t block[3];
+            m_prf.hash128(reinterpret_cast<const uint8_t*>(token.data()), token.size() * sizeof(RT), block);
+            for (uint64_t i = 0; i < n; ++i)
+            {
+                block[2] = i;
+                const uint64_t c_r = m_prf.hash(reinterpret_cast<const uint8_t*>(block), sizeof(block)) | 1ULL;
+                shares[i] = static_cast<RT>(static_cast<uint64_t>(shares[i]) * c_r);
+            }
+        }
+
+    private:
+        const hash_siphash m_prf;       // 带密钥PRF
+    };
+}
+
+#endif // !REVEAL_BLIND_HPP
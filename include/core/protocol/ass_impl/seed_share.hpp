@@ -0,0 +1,167 @@
+#ifndef SEED_SHARE_HPP
+#define SEED_SHARE_HPP
+
+#include <vector>
+
+#include "core/coro/coro_rng.hpp"
+#include "core/protocol/ass_impl/ass_wire.hpp"
+#include "core/ring/rvector.hpp"
+#include "core/rng/openssl_impl/prg_openssl.hpp"
+
+/** @namespace 项目命名空间。 */
+namespace mpmt
+{
+    /**
+     * @class   种子压缩的加法份额：份额为PRG(seed)的前size个环元素
+     * @tparam  RT 环类型，限定为ring8,ring16,ring32,ring64
+     * @note    1. AS0仅需保存种子与长度，在聚合需要时按块惰性展开，存储与上传量均为O(1)。
+     *          2. 记录为24字节，是各环元素字节数的整数倍，因此多条记录可直接拼接为种子束（见relay_ass）。
+     */
+    template <typename RT>
+    class seed_share
+    {
+    public:
+        /** @brief 断言限制模板类型 */
+        static_assert(
+            is_word_ring_type<RT>,
+            "RT must be ring8, ring16, ring32, or ring64."
+            );
+
+        /**
+         * @brief   以种子与份额长度构造
+         * @param   const prg_openssl::seed_type& seed 种子
+         * @param   uint64_t size 份额长度
+         */
+        seed_share(const prg_openssl::seed_type& seed, uint64_t size)
+            :
+            m_seed(seed),
+            m_size(size)
+        {}
+
+        /**
+         * @brief   获取份额长度
+         * @return  uint64_t 份额长度
+         */
+        uint64_t size() const noexcept { return m_size; }
+
+        /**
+         * @brief   获取种子
+         * @return  const prg_openssl::seed_type& 种子
+         */
+        const prg_openssl::seed_type& seed() const noexcept { return m_seed; }
+
+        /**
+         * @brief   将[offset, offset + len)区间的份额展开到out
+         * @param   uint64_t offset 起始元素下标
+         * @param   RT* out 输出缓存区（至少len个元素）
+         * @param   uint64_t len 元素个数
+         * @return  void
+         */
+        void expand_into(uint64_t offset, RT* out, uint64_t len) const
+        {
+            MPMT_ASSERT(offset + len <= m_size, "Seed share expansion out of range.");
+            prg_openssl prg(m_seed);
+            prg.fill(offset * sizeof(RT), reinterpret_cast<uint8_t*>(out), len * sizeof(RT));
+        }
+
+        /**
+         * @brief   在协程中将[offset, offset + len)区间的份额展开到out，大段展开分窗让出工作线程（见async_fill()）
+         * @param   coro_pool* pool 恢复协程的线程池，为nullptr时同expand_into()
+         * @param   uint64_t offset 起始元素下标
+         * @param   RT* out 输出缓存区（至少len个元素），须存活至任务结束
+         * @param   uint64_t len 元素个数
+         * @return  coro_task<void> 展开完毕后结束
+         */
+        coro_task<void> expand_async(coro_pool* pool, uint64_t offset, RT* out, uint64_t len) const
+        {
+            MPMT_ASSERT(offset + len <= m_size, "Seed share expansion out of range.");
+            const prg_openssl c_prg(m_seed);
+            co_await async_fill(pool, c_prg, offset * sizeof(RT), reinterpret_cast<uint8_t*>(out), len * sizeof(RT));
+        }
+
+        /**
+         * @brief   展开[offset, offset + len)区间的份额
+         * @param   uint64_t offset 起始元素下标
+         * @param   uint64_t len 元素个数
+         * @return  rvector<RT> 份额分块
+         */
+        rvector<RT> expand(uint64_t offset, uint64_t len) const
+        {
+            rvector<RT> chunk(len);
+            expand_into(offset, chunk.data(), len);
+            return chunk;
+        }
+
+        /**
+         * @brief   编码为报文：[种子][份额长度]
+         * @return  std::vector<RT> 报文
+         */
+        std::vector<RT> encode() const
+        {
+            uint8_t bytes[mc_WIRE_BYTE_SIZE];
+            std::memcpy(bytes, m_seed.data(), prg_openssl::mc_SEED_BYTE_SIZE);
+            std::memcpy(bytes + prg_openssl::mc_SEED_BYTE_SIZE, &m_size, sizeof(m_size));
+            return ass_wire::encode_bytes<RT>(bytes, mc_WIRE_BYTE_SIZE);
+        }
+
+        /**
+         * @brief   从报文解码
+         * @param   const std::vector<RT>& message 报文
+         * @return  seed_share<RT>
+         * @throw   protocol_exc 报文长度不符
+         */
+        static seed_share<RT> decode(const std::vector<RT>& message)
+        {
+            uint8_t bytes[mc_WIRE_BYTE_SIZE];
+            ass_wire::decode_bytes(message, 0, bytes, mc_WIRE_BYTE_SIZE);
+
+            prg_openssl::seed_type seed{};
+            uint64_t size = 0;
+            std::memcpy(seed.data(), bytes, prg_openssl::mc_SEED_BYTE_SIZE);
+            std::memcpy(&size, bytes + prg_openssl::mc_SEED_BYTE_SIZE, sizeof(size));
+            return seed_share<RT>(seed, size);
+        }
+
+        /**
+         * @brief   从种子束报文解码：报文为若干条[种子][份额长度]记录的拼接（单条即encode()的报文）
+         * @param   const std::vector<RT>& message 报文
+         * @return  std::vector<seed_share<RT>> 各条种子份额
+         * @throw   protocol_exc 报文为空或长度不是整条记录
+         */
+        static std::vector<seed_share<RT>> decode_bundle(const std::vector<RT>& message)
+        {
+            const uint64_t c_bytes = message.size() * sizeof(RT);
+            if (c_bytes == 0 || c_bytes % mc_WIRE_BYTE_SIZE != 0)
+            {
+                throw protocol_exc
+                (
+                    protocol_exc::exc_type::MESSAGE_CORRUPTION,
+                    "seed bundle of " + std::to_string(c_bytes) + " byte(s) is not a whole number of "
+                    + std::to_string(mc_WIRE_BYTE_SIZE) + "-byte record(s)."
+                );
+            }
+
+            std::vector<seed_share<RT>> shares;
+            shares.reserve(c_bytes / mc_WIRE_BYTE_SIZE);
+            for (uint64_t offset = 0; offset < message.size(); offset += mc_WIRE_BYTE_SIZE / sizeof(RT))
+            {
+                uint8_t bytes[mc_WIRE_BYTE_SIZE];
+                ass_wire::decode_bytes(message, offset, bytes, mc_WIRE_BYTE_SIZE);
+
+                prg_openssl::seed_type seed{};
+                uint64_t size = 0;
+                std::memcpy(seed.data(), bytes, prg_openssl::mc_SEED_BYTE_SIZE);
+                std::memcpy(&size, bytes + prg_openssl::mc_SEED_BYTE_SIZE, sizeof(size));
+                shares.emplace_back(seed, size);
+            }
+            return shares;
+        }
+
+    private:
+        static constexpr uint64_t mc_WIRE_BYTE_SIZE = prg_openssl::mc_SEED_BYTE_SIZE + sizeof(uint64_t);
+
+        prg_openssl::seed_type m_seed;  // 种子
+        uint64_t m_size;                // 份额长度
+    };
+}
+#endif // !SEED_SHARE_HPP
@@ -0,0 +1,129 @@
+#ifndef SHARD_MAP_HPP
+#define SHARD_MAP_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+
+#include "core/mpmtcfg.hpp"
+#include "core/exception/protocol_exc.hpp"
+
+/** @namespace 项目命名空间。 */
+namespace mpmt
+{
+    /**
+     * @class   并集编码的水平分片：把槽位区间[0, slots)切为连续的若干段，每段由一对代理方（AS0, AS1）持有
+     * @note    1. 各段长度为floor(slots / shards)，前slots % shards段各多一个槽位，因此各段均非空且长度至多相差1；
+     *             全局槽位s在所属段内的下标为s - first(owner(s))。
+     *          2. 段按槽位升序排列，升序的全局槽位按段拆分后仍各自升序，且按段号拼接即还原全局顺序。
+     *          3. 默认构造为不限长度的单一分片，用于未分片的部署。
+     */
+    class shard_map
+    {
+    public:
+        /** @brief 构造不限长度的单一分片 */
+        shard_map() noexcept
+            :
+            m_slots(UINT64_MAX),
+            m_shards(1),
+            m_quot(UINT64_MAX),
+            m_rem(0)
+        {}
+
+        /**
+         * @brief   按槽位总数与分片数构造
+         * @param   uint64_t slots 槽位总数
+         * @param   uint32_t shards 分片数
+         * @throw   protocol_exc 分片数为0或超过槽位数
+         */
+        shard_map(uint64_t slots, uint32_t shards)
+            :
+            m_slots(slots),
+            m_shards(shards),
+            m_quot(0),
+            m_rem(0)
+        {
+            if (shards == 0 || shards > slots)
+            {
+                throw protocol_exc
+                (
+                    protocol_exc::exc_type::INVALID_PARAMETER,
+                    "cannot split " + std::to_string(slots) + " slot(s) into " + std::to_string(shards) + " shard(s)."
+                );
+            }
+            m_quot = slots / shards;
+            m_rem = slots % shards;
+        }
+
+        /**
+         * @brief   获取槽位总数
+         * @return  uint64_t 槽位总数
+         */
+        uint64_t slots() const noexcept { return m_slots; }
+
+        /**
+         * @brief   获取分片数
+         * @return  uint32_t 分片数
+         */
+        uint32_t shards() const noexcept { return m_shards; }
+
+        /**
+         * @brief   获取分片的首个全局槽位
+         * @param   uint32_t shard 分片号
+         * @return  uint64_t 首个槽位
+         */
+        uint64_t first(uint32_t shard) const noexcept
+        {
+            MPMT_ASSERT(shard < m_shards, "Shard index out of range.");
+            return m_quot * shard + std::min<uint64_t>(shard, m_rem);
+        }
+
+        /**
+         * @brief   获取分片的槽位个数
+         * @param   uint32_t shard 分片号
+         * @return  uint64_t 槽位个数
+         */
+        uint64_t count(uint32_t shard) const noexcept
+        {
+            MPMT_ASSERT(shard < m_shards, "Shard index out of range.");
+            return m_quot + (shard < m_rem ? 1 : 0);
+        }
+
+        /**
+         * @brief   获取全局槽位所属的分片
+         * @param   uint64_t slot 全局槽位
+         * @return  uint32_t 分片号
+         */
+        uint32_t owner(uint64_t slot) const noexcept
+        {
+            MPMT_ASSERT(slot < m_slots, "Slot out of range.");
+            const uint64_t c_long = m_rem * (m_quot + 1);     // 前m_rem个长段覆盖的槽位数
+            return static_cast<uint32_t>(slot < c_long ? slot / (m_quot + 1) : m_rem + (slot - c_long) / m_quot);
+        }
+
+        /**
+         * @brief   由未分片的文件路径得到分片文件路径：在扩展名前插入".shard<分片号>"
+         * @param   const std::string& path 文件路径，如"as0.mrvf"
+         * @param   uint32_t shard 分片号
+         * @return  std::string 分片文件路径，如"as0.shard1.mrvf"
+         */
+        static std::string path_of(const std::string& path, uint32_t shard)
+        {
+            const std::string c_tag = ".shard" + std::to_string(shard);
+            const std::string::size_type c_dot = path.find_last_of('.');
+            const std::string::size_type c_sep = path.find_last_of("/\\");
+            if (c_dot == std::string::npos || (c_sep != std::string::npos && c_dot < c_sep))
+            {
+                return path + c_tag;
+            }
+            return path.substr(0, c_dot) + c_tag + path.substr(c_dot);
+        }
+
+    private:
+        uint64_t m_slots;       // 槽位总数
+        uint32_t m_shards;      // 分片数
+        uint64_t m_quot;        // 短段长度
+        uint64_t m_rem;         // 长段（多一个槽位）的个数
+    };
+}
+#endif // !SHARD_MAP_HPP
@@ -0,0 +1,90 @@
+#ifndef UNION_SNAPSHOT_HPP
+#define UNION_SNAPSHOT_HPP
+
+#include <memory>
+#include <string>
+
+#include "core/mpmtcfg.hpp"
+#include "core/io/mmap_impl/io_mmap.hpp"
+#include "core/ring/mrvf/mrvf_handler.hpp"
+#include "core/ring/rvector.hpp"
+
+/** @namespace 项目命名空间。 */
+namespace mpmt
+{
+    /**
+     * @class   代理方并集份额的只读快照（供agent_server并发查询）
+     * @tparam  RT 环类型，限定为ring8,ring16,ring32,ring64
+     * @note    1. 构造后内容不再改变，任意线程可无锁并发读取；并集更新时由agent_server整体替换快照。
+     *          2. map()打开持久化的mrvf文件：未压缩且块连续存放的v2文件（save()默认产生的布局）
+     *             校验全部块后直接在只读映射上读取，不复制数据；v1或含压缩、迁移块的v2文件退化为完整载入内存。
+     *          3. adopt()接管内存中的并集份额（如agent_ass合并或更新后的副本）。
+     */
+    template <typename RT>
+    class union_snapshot
+    {
+    public:
+        /** @brief 断言限制模板类型 */
+        static_assert(
+            is_word_ring_type<RT>,
+            "RT must be ring8, ring16, ring32, or ring64."
+            );
+
+        /**
+         * @brief   由持久化的并集份额文件建立快照
+         * @param   const std::string& path mrvf文件路径
+         * @param   const typename mrvf_handler<RT>::config& config 退化为完整载入时使用的读取配置
+         * @return  std::unique_ptr<union_snapshot<RT>> 快照
+         * @throw   mrvf_exc 打开失败、环大小不符或文件损坏
+         */
+        static std::unique_ptr<union_snapshot<RT>> map
+        (
+            const std::string& path,
+            const typename mrvf_handler<RT>::config& config
+        );
+
+        /**
+         * @brief   接管内存中的并集份额建立快照
+         * @param   rvector<RT>&& share 并集份额
+         * @return  std::unique_ptr<union_snapshot<RT>> 快照
+         */
+        static std::unique_ptr<union_snapshot<RT>> adopt(rvector<RT>&& share);
+
+        /**
+         * @brief   获取槽位个数
+         * @return  uint64_t 槽位个数
+         */
+        uint64_t size() const noexcept { return m_size; }
+
+        /**
+         * @brief   读取一个槽位的份额（调用方保证下标不越界）
+         * @param   uint64_t slot 槽位下标
+         * @return  RT 份额
+         */
+        RT operator[](uint64_t slot) const noexcept { return m_data[slot]; }
+
+        /**
+         * @brief   是否直接读取文件映射
+         * @return  bool
+         */
+        bool mapped() const noexcept { return m_map != nullptr; }
+
+    private:
+        std::unique_ptr<io_mmap> m_map;     // 文件映射，零拷贝时有效
+        rvector<RT> m_owned;                // 内存中的份额，非零拷贝时有效
+        const RT* m_data;                   // 份额首地址
+        uint64_t m_size;                    // 槽位个数
+
+        union_snapshot() : m_map(), m_owned(), m_data(nullptr), m_size(0) {}
+
+        union_snapshot(const union_snapshot&) = delete;
+        union_snapshot& operator=(const union_snapshot&) = delete;
+    };
+}
+
+extern template class mpmt::union_snapshot<mpmt::ring8>;
+extern template class mpmt::union_snapshot<mpmt::ring16>;
+extern template class mpmt::union_snapshot<mpmt::ring32>;
+extern template class mpmt::union_snapshot<mpmt::ring64>;
+
+#endif // !UNION_SNAPSHOT_HPP
@@ -0,0 +1,181 @@
+#ifndef AGENT_RSS_HPP
+#define AGENT_RSS_HPP
+
+#include <optional>
+#include <vector>
+
+#include "core/mpmtcfg.hpp"
+#include "core/comm/comm_adapter.hpp"
+#include "core/protocol/agent_ideal_fn.hpp"
+#include "core/protocol/ass_impl/reveal_blind.hpp"
+#include "core/protocol/rss_impl/rss_role.hpp"
+#include "core/protocol/rss_impl/rss_share.hpp"
+#include "core/ring/rvector.hpp"
+#include "core/rng/openssl_impl/prg_openssl.hpp"
+
+/** @namespace 项目命名空间。 */
+namespace mpmt
+{
+    /**
+     * @class   代理方（2-out-of-3复制秘密分享实现）
+     * @tparam  RT 环类型，限定为ring8,ring16,ring32,ring64
+     * @note    1. 三个代理方P0、P1、P2两两之间各有一条连接，Pi经next连接Pi+1、经prev连接Pi-1（下标模3）。
+     *          2. aggregate()逐个接收数据持有方的两个分量并分别累加，种子分量按区间惰性展开，并集份额为(u_i, u_{i+1})。
+     *          3. reveal()响应一次查询：接收槽位令牌（与querier_ass相同），返回本方两个分量在这些槽位上的值，
+     *             查询方可据此交叉校验三方的复制分量。
+     *          4. multiply()为复制秘密分享的乘法：本地计算交叉项并加上零分享，向prev发送一条报文、从next接收一条报文，
+     *             无需离线预处理（Beaver三元组）；零分享的PRG密钥在首次乘法时经同一环路交换一次。
+     *          5. 三方环路中P0先接收后发送，其余两方先发送后接收，阻塞式连接上也不会相互等待。
+     *          6. 三方设置同一盲化密钥后（见set_blind_key()），reveal()返回的两个分量逐槽位乘以同一随机奇数，
+     *             复制分量仍可交叉校验，查询方只得到计数是否为0（见reveal_blind）。
+     */
+    template <typename RT>
+    class agent_rss : public agent_ideal_fn
+    {
+    public:
+        /** @brief 断言限制模板类型 */
+        static_assert(
+            is_word_ring_type<RT>,
+            "RT must be ring8, ring16, ring32, or ring64."
+            );
+
+        /**
+         * @brief   构造代理方
+         * @param   rss_role role 代理方角色
+         * @param   const std::vector<comm_adapter<RT>*>& holders 与各数据持有方的连接
+         * @param   comm_adapter<RT>* querier 与查询方的连接，可为nullptr（仅合并）
+         * @param   comm_adapter<RT>* next 与下一个代理方的连接，可为nullptr（不做乘法）
+         * @param   comm_adapter<RT>* prev 与上一个代理方的连接，可为nullptr（不做乘法）
+         */
+        agent_rss
+        (
+            rss_role role,
+            const std::vector<comm_adapter<RT>*>& holders,
+            comm_adapter<RT>* querier,
+            comm_adapter<RT>* next,
+            comm_adapter<RT>* prev
+        );
+
+        /**
+         * @brief   合并：清空并集份额后聚合全部数据持有方的份额
+         * @return  void
+         */
+        void merge() override;
+
+        /**
+         * @brief   更新：在现有并集份额上继续聚合新的数据持有方份额
+         * @return  void
+         */
+        void update() override;
+
+        /**
+         * @brief   聚合：接收每个已连接数据持有方的两个分量并分别累加
+         * @return  void
+         * @throw   protocol_exc 分量长度与并集份额长度不一致
+         */
+        void aggregate() override;
+
+        /**
+         * @brief   代理方不作为秘密的输入方
+         * @throw   protocol_exc 始终抛出
+         */
+        void share() override;
+
+        /**
+         * @brief   响应一次查询，向查询方返回两个分量在令牌槽位上的值
+         * @return  void
+         * @throw   protocol_exc 未连接查询方或槽位越界
+         */
+        void reveal() override;
+
+        /**
+         * @brief   复制秘密分享的逐元素乘法：z = x * y
+         * @param   const rss_share<RT>& x 本方持有的x的份额
+         * @param   const rss_share<RT>& y 本方持有的y的份额
+         * @return  rss_share<RT> 本方持有的z的份额
+         * @note    三个代理方须以相同长度、相同顺序调用。
+         * @throw   protocol_exc 未连接相邻代理方，或份额长度不一致
+         */
+        rss_share<RT> multiply(const rss_share<RT>& x, const rss_share<RT>& y);
+
+        /**
+         * @brief   替换数据持有方连接（用于update()接入新的数据持有方）
+         * @param   const std::vector<comm_adapter<RT>*>& holders 与各数据持有方的连接
+         * @return  void
+         */
+        void set_holders(const std::vector<comm_adapter<RT>*>& holders);
+
+        /**
+         * @brief   设置查询响应的盲化密钥，三个代理方须使用同一密钥且不告知查询方
+         * @param   const typename reveal_blind<RT>::key_type& key 128位密钥
+         * @return  void
+         */
+        void set_blind_key(const typename reveal_blind<RT>::key_type& key) { m_blind.emplace(key); }
+
+        /**
+         * @brief   获取并集份额
+         * @return  const rss_share<RT>& 并集份额
+         */
+        const rss_share<RT>& union_share() const noexcept { return m_union; }
+
+        /**
+         * @brief   载入持久化的并集份额
+         * @param   rss_share<RT>&& share 并集份额
+         * @return  void
+         * @throw   protocol_exc 两个分量长度不一致
+         */
+        void load_union(rss_share<RT>&& share);
+
+        /**
+         * @brief   获取代理方角色
+         * @return  rss_role 角色
+         */
+        rss_role role() const noexcept { return mc_role; }
+
+        /**
+         * @brief   获取零分享已消耗的PRG字节数（三方须保持一致）
+         * @return  uint64_t 字节数
+         */
+        uint64_t zero_offset() const noexcept { return m_zero_offset; }
+
+    private:
+        static constexpr uint64_t mc_EXPAND_WINDOW = 1ULL << 14;   // 种子分量每次展开的元素个数
+
+        const rss_role mc_role;                         // 代理方角色
+        std::vector<comm_adapter<RT>*> m_holders;       // 与各数据持有方的连接
+        comm_adapter<RT>* m_querier;                    // 与查询方的连接
+        comm_adapter<RT>* m_next;                       // 与下一个代理方的连接
+        comm_adapter<RT>* m_prev;                       // 与上一个代理方的连接
+        rss_share<RT> m_union;                          // 并集份额
+        std::optional<prg_openssl> m_zero_own;          // 零分享：本方密钥的PRG（与prev共享）
+        std::optional<prg_openssl> m_zero_next;         // 零分享：next密钥的PRG
+        uint64_t m_zero_offset;                         // 零分享已消耗的PRG字节数
+        std::optional<reveal_blind<RT>> m_blind;        // 查询响应的盲化，未设置时返回原始分量
+
+        void multiply() override;
+        void subtract() override;
+        void add() override;
+
+        /**
+         * @brief   确保并集份额长度为size，首次聚合时分配全零向量
+         * @return  void
+         */
+        void ensure_union(uint64_t size);
+
+        /** @brief 接收一个分量（种子或稠密）并累加到acc */
+        void absorb(comm_adapter<RT>& holder, bool seeded, rvector<RT>& acc);
+
+        /** @brief 沿环路向prev发送out并从next接收一条报文，按角色决定先后以免互相等待 */
+        std::vector<RT> exchange(const std::vector<RT>& out);
+
+        /** @brief 首次乘法前与相邻代理方交换零分享密钥 */
+        void ensure_zero_keys();
+    };
+}
+
+extern template class mpmt::agent_rss<mpmt::ring8>;
+extern template class mpmt::agent_rss<mpmt::ring16>;
+extern template class mpmt::agent_rss<mpmt::ring32>;
+extern template class mpmt::agent_rss<mpmt::ring64>;
+
+#endif // !AGENT_RSS_HPP
@@ -0,0 +1,88 @@
+#ifndef DATA_HOLDER_RSS_HPP
+#define DATA_HOLDER_RSS_HPP
+
+#include <array>
+#include <optional>
+#include <vector>
+
+#include "core/mpmtcfg.hpp"
+#include "core/comm/comm_adapter.hpp"
+#include "core/encode/slot_indicator.hpp"
+#include "core/protocol/data_holder_ideal_fn.hpp"
+#include "core/protocol/rss_impl/rss_role.hpp"
+#include "core/ring/rvector.hpp"
+#include "core/rng/openssl_impl/prg_openssl.hpp"
+
+/** @namespace 项目命名空间。 */
+namespace mpmt
+{
+    /**
+     * @class   数据持有方（复制秘密分享实现）
+     * @tparam  RT 环类型，限定为ring8,ring16,ring32,ring64
+     * @note    1. share()把x拆为x0 = PRG(s0)、x1 = PRG(s1)、x2 = x - x0 - x1，向Pi发送(x_i, x_{i+1})：
+     *             P0收到两个种子，P1收到种子s1与x2，P2收到x2与种子s0，稠密的x2只计算一次、逐块同时发给P1与P2。
+     *          2. 每个分量的报文与加法秘密分享相同：种子分量为seed_share报文，稠密分量为长度字段加分块（见ass_wire）。
+     *          3. 种子在设置输入后首次share()时抽取，对同一输入重复share()发送逐字节相同的份额。
+     */
+    template <typename RT>
+    class data_holder_rss : public data_holder_ideal_fn
+    {
+    public:
+        /** @brief 断言限制模板类型 */
+        static_assert(
+            is_word_ring_type<RT>,
+            "RT must be ring8, ring16, ring32, or ring64."
+            );
+
+        /**
+         * @brief   构造数据持有方
+         * @param   comm_adapter<RT>& p0 与P0的连接
+         * @param   comm_adapter<RT>& p1 与P1的连接
+         * @param   comm_adapter<RT>& p2 与P2的连接
+         */
+        data_holder_rss(comm_adapter<RT>& p0, comm_adapter<RT>& p1, comm_adapter<RT>& p2);
+
+        /**
+         * @brief   设置待分享的编码向量x
+         * @param   rvector<RT>&& x 编码向量
+         * @return  void
+         */
+        void set_input(rvector<RT>&& x);
+
+        /**
+         * @brief   设置待分享的槽位指示向量，分享时逐块展开为环上0/1值
+         * @param   slot_indicator&& x 槽位指示向量
+         * @return  void
+         */
+        void set_input(slot_indicator&& x);
+
+        /**
+         * @brief   秘密分享：向三个代理方各发送两个分量
+         * @return  void
+         * @throw   protocol_exc 未设置编码向量
+         */
+        void share() override;
+
+        /**
+         * @brief   数据持有方不参与恢复秘密
+         * @throw   protocol_exc 始终抛出
+         */
+        void reveal() override;
+
+    private:
+        std::array<comm_adapter<RT>*, c_RSS_PARTIES> m_agents;  // 与P0、P1、P2的连接
+        rvector<RT> m_input;                    // 编码向量x
+        std::optional<slot_indicator> m_bits;   // 位压缩的编码向量x（与m_input二选一）
+        std::vector<prg_openssl::seed_type> m_seeds;    // x0与x1的种子，重复分享同一输入时复用
+
+        /** @brief 编码向量长度 */
+        uint64_t input_size() const noexcept { return m_bits ? m_bits->size() : m_input.size(); }
+    };
+}
+
+extern template class mpmt::data_holder_rss<mpmt::ring8>;
+extern template class mpmt::data_holder_rss<mpmt::ring16>;
+extern template class mpmt::data_holder_rss<mpmt::ring32>;
+extern template class mpmt::data_holder_rss<mpmt::ring64>;
+
+#endif // !DATA_HOLDER_RSS_HPP
@@ -0,0 +1,104 @@
+#ifndef QUERIER_RSS_HPP
+#define QUERIER_RSS_HPP
+
+#include <array>
+#include <vector>
+
+#include "core/mpmtcfg.hpp"
+#include "core/comm/comm_adapter.hpp"
+#include "core/protocol/querier_ideal_fn.hpp"
+#include "core/protocol/rss_impl/rss_role.hpp"
+#include "core/ring/ring.hpp"
+
+/** @namespace 项目命名空间。 */
+namespace mpmt
+{
+    /**
+     * @class   查询方（复制秘密分享实现）
+     * @tparam  RT 环类型，限定为ring8,ring16,ring32,ring64
+     * @note    1. 查询令牌与querier_ass相同：升序去重后的k个槽位下标，代理方看到的只是伪随机下标。
+     *          2. share()向三个代理方发送同一令牌，reveal()收回各方(x_i, x_{i+1})在这些槽位上的值，
+     *             计数为x0 + x1 + x2，k个槽位计数均非0即判定凭据存在于并集中。
+     *          3. 每个分量由两个代理方各持有一份，reveal()校验Pi的第二个分量与Pi+1的第一个分量逐一相等，
+     *             任一代理方返回的值被篡改即可发现。
+     *          4. 泄露：代理方未设置盲化密钥时，恢复值即持有该凭据的持有方个数；设置后为计数乘以随机奇数，
+     *             只泄露计数是否为0及其2-adic赋值（见reveal_blind）。同一凭据的令牌逐字节相同，
+     *             代理方可以关联同一凭据的多次查询。
+     */
+    template <typename RT>
+    class querier_rss : public querier_ideal_fn
+    {
+    public:
+        /** @brief 断言限制模板类型 */
+        static_assert(
+            is_word_ring_type<RT>,
+            "RT must be ring8, ring16, ring32, or ring64."
+            );
+
+        /**
+         * @brief   构造查询方
+         * @param   comm_adapter<RT>& p0 与P0的连接
+         * @param   comm_adapter<RT>& p1 与P1的连接
+         * @param   comm_adapter<RT>& p2 与P2的连接
+         */
+        querier_rss(comm_adapter<RT>& p0, comm_adapter<RT>& p1, comm_adapter<RT>& p2);
+
+        /**
+         * @brief   设置查询令牌
+         * @param   const std::vector<uint64_t>& slots 凭据对应的k个槽位（顺序与重复不影响令牌）
+         * @return  void
+         */
+        void set_query(const std::vector<uint64_t>& slots);
+
+        /**
+         * @brief   执行一次完整查询（share + reveal）
+         * @return  void
+         */
+        void query() override;
+
+        /**
+         * @brief   向三个代理方发送查询令牌
+         * @return  void
+         * @throw   protocol_exc 未设置查询令牌
+         */
+        void share() override;
+
+        /**
+         * @brief   收回三方的份额，校验复制分量并恢复查询结果
+         * @return  void
+         * @throw   protocol_exc 代理方返回的份额个数与令牌不符，或复制分量不一致
+         */
+        void reveal() override;
+
+        /**
+         * @brief   获取最近一次查询结果
+         * @return  bool 凭据是否存在于并集中
+         */
+        bool result() const noexcept { return m_result; }
+
+        /**
+         * @brief   获取最近一次查询恢复出的各槽位计数（代理方启用盲化时为盲化后的计数，仅是否为0有意义）
+         * @return  const std::vector<RT>& 槽位计数，与slots()一一对应
+         */
+        const std::vector<RT>& counts() const noexcept { return m_counts; }
+
+        /**
+         * @brief   获取规范化（升序、去重）后的查询槽位
+         * @return  const std::vector<uint64_t>& 槽位
+         */
+        const std::vector<uint64_t>& slots() const noexcept { return m_slots; }
+
+    private:
+        std::array<comm_adapter<RT>*, c_RSS_PARTIES> m_agents;  // 与P0、P1、P2的连接
+        std::vector<uint64_t> m_slots;                  // 规范化后的查询槽位
+        std::vector<RT> m_counts;                       // 恢复出的槽位计数
+        bool m_result;                                  // 查询结果
+    };
+}
+
+extern template class mpmt::querier_rss<mpmt::ring8>;
+extern template class mpmt::querier_rss<mpmt::ring16>;
+extern template class mpmt::querier_rss<mpmt::ring32>;
+extern template class mpmt::querier_rss<mpmt::ring64>;
+
+#endif // !QUERIER_RSS_HPP
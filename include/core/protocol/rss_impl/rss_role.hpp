@@ -0,0 +1,44 @@
+#ifndef RSS_ROLE_HPP
+#define RSS_ROLE_HPP
+
+#include <cstdint>
+
+/** @namespace 项目命名空间。 */
+namespace mpmt
+{
+    /**
+     * @brief   复制秘密分享中代理方的角色
+     * @note    秘密x = x0 + x1 + x2，角色Pi持有(x_i, x_{i+1})（下标模3），任意两方可恢复x，任意单方只看到两个均匀随机的分量。
+     */
+    enum class rss_role : uint8_t
+    {
+        P0 = 0,     // 持有(x0, x1)，两个分量均由数据持有方的种子展开
+        P1 = 1,     // 持有(x1, x2)，x1由种子展开，x2 = x - x0 - x1
+        P2 = 2,     // 持有(x2, x0)，x2 = x - x0 - x1，x0由种子展开
+    };
+
+    /** @brief 复制秘密分享的代理方个数 */
+    inline constexpr uint8_t c_RSS_PARTIES = 3;
+
+    /**
+     * @brief   获取下一个角色（持有本方第二个分量作为其第一个分量的一方）
+     * @param   rss_role role 角色
+     * @return  rss_role 下一个角色
+     */
+    inline constexpr rss_role rss_next(rss_role role) noexcept
+    {
+        return static_cast<rss_role>((static_cast<uint8_t>(role) + 1) % c_RSS_PARTIES);
+    }
+
+    /**
+     * @brief   获取上一个角色（持有本方第一个分量作为其第二个分量的一方）
+     * @param   rss_role role 角色
+     * @return  rss_role 上一个角色
+     */
+    inline constexpr rss_role rss_prev(rss_role role) noexcept
+    {
+        return static_cast<rss_role>((static_cast<uint8_t>(role) + c_RSS_PARTIES - 1) % c_RSS_PARTIES);
+    }
+}
+
+#endif // !RSS_ROLE_HPP
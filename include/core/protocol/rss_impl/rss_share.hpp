@@ -0,0 +1,35 @@
+#ifndef RSS_SHARE_HPP
+#define RSS_SHARE_HPP
+
+#include "core/ring/ring.hpp"
+#include "core/ring/rvector.hpp"
+
+/** @namespace 项目命名空间。 */
+namespace mpmt
+{
+    /**
+     * @brief   一个代理方持有的复制份额：角色Pi的m_first为x_i，m_second为x_{i+1}
+     * @tparam  RT 环类型，限定为ring8,ring16,ring32,ring64
+     * @note    两个分量等长；加减法与常数乘法逐分量本地完成，乘法见agent_rss::multiply()。
+     */
+    template <typename RT>
+    struct rss_share
+    {
+        /** @brief 断言限制模板类型 */
+        static_assert(
+            is_word_ring_type<RT>,
+            "RT must be ring8, ring16, ring32, or ring64."
+            );
+
+        rvector<RT> m_first;    // 本方分量x_i
+        rvector<RT> m_second;   // 下一方分量x_{i+1}
+
+        /**
+         * @brief   获取份额长度
+         * @return  uint64_t 份额长度
+         */
+        uint64_t size() const noexcept { return m_first.size(); }
+    };
+}
+
+#endif // !RSS_SHARE_HPP
@@ -11,7 +11,7 @@ namespace mpmt
     {
         static_assert(
             is_ring_type<RT>,
-            "RT must be ring1, ring8, ring16, ring32 or ring64."
+            "RT must be ring1, ring8, ring16, ring32, ring64 or ring_k<K>."
             );
             
 
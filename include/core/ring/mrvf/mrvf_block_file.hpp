@@ -0,0 +1,225 @@
+#ifndef MRVF_BLOCK_FILE_HPP
+#define MRVF_BLOCK_FILE_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "core/io/io_adapter.hpp"
+#include "core/ring/mrvf/mrvf_codec.hpp"
+
+/** @namespace 项目命名空间 */
+namespace mpmt
+{
+    /**
+     * @class   mrvf v2分块文件（与元素类型无关的字节级实现，由mrvf_handler<RT>使用）
+     * @note    1. 文件布局：
+     *             [文件头 64B][数据块 0..n-1][块索引 n*24B][文件尾 "MRVF_EOF" 8B]
+     *             文件头：magic "MRVF_HDR"(8) | version u16 | ring_size u8 | flags u8 | block_elems u32 |
+     *                     rvector_size u64 | num_blocks u64 | index_offset u64 | index_crc64 u64 |
+     *                     reserved u64 | header_crc64 u64（覆盖前56字节）
+     *             块索引：offset u64 | stored_bytes u32 | codec u8 | reserved 3B | crc64 u64（覆盖块的存储字节）
+     *          2. 每块含block_elems个元素（末块可不足），各块独立校验，读取或校验任意区间只访问覆盖的块。
+     *          3. 启用压缩时每块由mrvf_codec::choose()独立选择编码（见mrvf_codec），块长度随之可变。
+     *          4. patch()改写覆盖的块并更新其校验和；重新编码后变长、放不下原位置的块（数据区末尾的块除外，可原位伸缩）
+     *             移至数据区末尾，索引项改指新位置，原位置成为空洞；变短的块原位写入后剩余的字节同为空洞。空洞不被任何索引项引用，不参与校验，读取时不会访问；
+     *             因此数据块在文件中不保证连续或按块号排列，read()只合并文件中恰好相邻的块。
+     *             空洞不会被之后的patch()复用，反复改写可变长的块时文件只增不减，空洞总字节数见hole_bytes()；
+     *             经mrvf_handler::save()重写整个文件即可回收。
+     *             append()从末块起续写，随后重写块索引、文件尾与文件头。
+     *          5. 原位改写不具备崩溃一致性，写入中断可能使文件在下次打开时校验失败。
+     *          6. 多字节字段按本机字节序存储，与v1一致。
+     *          7. flags含mc_FLAG_RING_BITS时为位宽模式（ring_k<K>）：ring_size字段为位宽K，rvector_size与block_elems仍以元素计，
+     *             数据为按K位紧密排列的位流，block_elems须为8的倍数以使每块为整字节，末块的填充位为0。
+     *             此时本类以字节为存储单元：size()、block_elems()与读写区间均以字节计，elements()与ring_bits()给出元素个数与位宽；
+     *             位宽模式不支持append()。
+     */
+    class mrvf_block_file
+    {
+    public:
+        static constexpr uint16_t mc_VERSION = 2;                   // 格式版本
+        static constexpr uint64_t mc_HEADER_SIZE = 64;              // 文件头长度
+        static constexpr uint64_t mc_ENTRY_SIZE = 24;               // 每个块索引项长度
+        static constexpr uint64_t mc_EOF_SIZE = 8;                  // 文件尾长度
+        static constexpr uint64_t mc_RING_SIZE_OFFSET = 10;         // 文件头中环大小字段的偏移
+        static constexpr uint64_t mc_FLAGS_OFFSET = 11;             // 文件头中标志字段的偏移
+        static constexpr uint8_t mc_FLAG_RING_BITS = 0x01;          // 标志：ring_size字段为位宽（位宽模式）
+        static constexpr uint32_t mc_DEFAULT_BLOCK_ELEMS = 1U << 16;// 默认每块元素数
+        static constexpr uint8_t mc_MAGIC[8] = { 0x4d,0x52,0x56,0x46,0x5f,0x48,0x44,0x52 };   // "MRVF_HDR"
+        static constexpr uint8_t mc_EOF[8] = { 0x4d,0x52,0x56,0x46,0x5f,0x45,0x4f,0x46 };     // "MRVF_EOF"
+
+        /** @brief 块编码方式（见mrvf_codec） */
+        using codec = mrvf_codec::codec;
+
+        /** @brief 块索引项 */
+        struct block_entry
+        {
+            uint64_t m_offset;          // 块在文件中的偏移
+            uint32_t m_stored_bytes;    // 块的存储字节数
+            codec m_codec;              // 块编码方式
+            uint64_t m_crc64;           // 块存储字节的CRC64
+        };
+
+        /**
+         * @brief   判断文件起始字节是否为v2格式
+         * @param   const uint8_t* head 文件起始字节
+         * @param   uint64_t len head的长度
+         * @return  bool 是否为v2
+         */
+        static bool probe(const uint8_t* head, uint64_t len) noexcept;
+
+        /**
+         * @brief   将完整向量写入新文件（覆盖已有内容）
+         * @param   io_adapter& io 以CREATE方式打开的文件
+         * @param   const std::string& path 文件路径（用于错误信息）
+         * @param   uint8_t ring_size 元素字节数
+         * @param   uint32_t block_elems 每块元素数
+         * @param   const uint8_t* data 向量数据
+         * @param   uint64_t size 元素个数
+         * @param   bool compress 是否逐块选择压缩编码
+         * @return  void
+         * @throw   mrvf_exc 参数不合法或写入失败
+         */
+        static void write
+        (
+            io_adapter& io,
+            const std::string& path,
+            uint8_t ring_size,
+            uint32_t block_elems,
+            const uint8_t* data,
+            uint64_t size,
+            bool compress = false
+        );
+
+        /**
+         * @brief   将完整的位宽模式向量写入新文件（覆盖已有内容）
+         * @param   io_adapter& io 以CREATE方式打开的文件
+         * @param   const std::string& path 文件路径（用于错误信息）
+         * @param   uint8_t ring_bits 元素位宽，1至64
+         * @param   uint32_t block_elems 每块元素数，须为8的倍数
+         * @param   const uint8_t* data 紧密排列的位流，至少ceil(size * ring_bits / 8)字节
+         * @param   uint64_t size 元素个数
+         * @param   bool compress 是否逐块选择压缩编码
+         * @return  void
+         * @throw   mrvf_exc 参数不合法或写入失败
+         */
+        static void write_bits
+        (
+            io_adapter& io,
+            const std::string& path,
+            uint8_t ring_bits,
+            uint32_t block_elems,
+            const uint8_t* data,
+            uint64_t size,
+            bool compress = false
+        );
+
+        /**
+         * @brief   打开已有文件，读取并校验文件头、块索引与文件尾（不读取数据块）
+         * @param   io_adapter& io 已打开的文件，生命周期需长于本对象
+         * @param   const std::string& path 文件路径（用于错误信息）
+         * @param   bool compress patch()与append()写入的块是否选择压缩编码
+         * @throw   mrvf_exc 文件损坏或读取失败
+         */
+        mrvf_block_file(io_adapter& io, const std::string& path, bool compress = false);
+
+        uint8_t ring_size() const noexcept { return m_ring_size; }
+        uint32_t block_elems() const noexcept { return m_block_elems; }
+        uint64_t size() const noexcept { return m_size; }
+        bool packed() const noexcept { return (m_layout.m_flags & mc_FLAG_RING_BITS) != 0; }
+        uint8_t ring_bits() const noexcept { return packed() ? m_layout.m_ring_field : static_cast<uint8_t>(m_ring_size * 8); }
+        uint64_t elements() const noexcept { return m_layout.m_size; }
+        uint64_t num_blocks() const noexcept { return m_index.size(); }
+        uint64_t stored_bytes() const noexcept;
+        uint64_t hole_bytes() const noexcept { return m_data_end - mc_HEADER_SIZE - stored_bytes(); }  // 数据区中的空洞字节数
+        const block_entry& entry(uint64_t block) const { return m_index.at(block); }
+
+        /**
+         * @brief   读取存储单元区间[first, first + count)，并校验覆盖的每个块
+         * @param   uint64_t first 首元素下标
+         * @param   uint64_t count 元素个数
+         * @param   uint8_t* out 输出缓存区，至少count * ring_size字节
+         * @return  void
+         * @throw   mrvf_exc 区间越界、块校验失败或读取失败
+         */
+        void read(uint64_t first, uint64_t count, uint8_t* out);
+
+        /**
+         * @brief   校验存储单元区间[first, first + count)覆盖的每个块
+         * @throw   mrvf_exc 区间越界、块校验失败或读取失败
+         */
+        void verify(uint64_t first, uint64_t count);
+
+        /**
+         * @brief   原位改写存储单元区间[first, first + count)
+         * @param   const uint8_t* data 新数据，count * ring_size字节
+         * @throw   mrvf_exc 区间越界、原块校验失败或写入失败
+         */
+        void patch(uint64_t first, uint64_t count, const uint8_t* data);
+
+        /**
+         * @brief   在末尾追加count个元素
+         * @param   const uint8_t* data 新数据，count * ring_size字节
+         * @throw   mrvf_exc 位宽模式、超出长度上限或写入失败
+         */
+        void append(uint64_t count, const uint8_t* data);
+
+    private:
+        /** @brief 文件头中描述向量的字段 */
+        struct layout
+        {
+            uint8_t m_ring_field;               // ring_size字段：元素字节数，位宽模式下为位宽
+            uint8_t m_flags;                    // 标志
+            uint32_t m_block_elems;             // 每块元素数
+            uint64_t m_size;                    // 元素个数
+        };
+
+        io_adapter& m_io;                       // 文件
+        const std::string mc_path;              // 文件路径（用于错误信息）
+        const bool mc_compress;                 // 写入的块是否选择压缩编码
+        layout m_layout;                        // 文件头字段
+        uint8_t m_ring_size;                    // 存储单元字节数（位宽模式下为1）
+        uint32_t m_block_elems;                 // 每块存储单元数
+        uint64_t m_size;                        // 存储单元个数
+        std::vector<block_entry> m_index;       // 块索引
+        uint64_t m_data_end;                    // 数据区末尾（即块索引起点）
+
+        /** @brief 第block块的元素个数 */
+        uint64_t block_length(uint64_t block) const noexcept;
+
+        /** @brief 以一次读取载入文件中相邻的块[first_block, last_block]，逐块校验并解码 */
+        void load_blocks(uint64_t first_block, uint64_t last_block, uint8_t* out);
+
+        /** @brief 编码并写入第block块的elems个原始元素，放不下原位置时移至数据区末尾 */
+        void store_block(uint64_t block, const uint8_t* raw, uint64_t elems);
+
+        /** @brief 检查区间是否越界 */
+        void check_range(uint64_t first, uint64_t count) const;
+
+        /** @brief 写入块索引、文件尾与文件头，index_offset为块索引起点 */
+        void commit(uint64_t index_offset);
+
+        /** @brief 按存储单元写入完整数据，文件头按hdr填写 */
+        static void write_units
+        (
+            io_adapter& io,
+            const layout& hdr,
+            uint8_t ring_size,
+            uint32_t block_elems,
+            const uint8_t* data,
+            uint64_t size,
+            bool compress
+        );
+
+        /** @brief 无文件对象时写入块索引、文件尾与文件头 */
+        static void commit
+        (
+            io_adapter& io,
+            const layout& hdr,
+            const std::vector<block_entry>& index,
+            uint64_t index_offset
+        );
+    };
+}
+
+#endif // !MRVF_BLOCK_FILE_HPP
@@ -0,0 +1,87 @@
+#ifndef MRVF_CODEC_HPP
+#define MRVF_CODEC_HPP
+
+#include <cstdint>
+#include <vector>
+
+/** @namespace 项目命名空间 */
+namespace mpmt
+{
+    /**
+     * @class   mrvf v2块编码
+     * @note    1. 块按定宽无符号整数（ring_size字节，本机字节序）解释：
+     *             BITPACK  [位宽 u8][每个元素按位宽紧密排列]，适合取值很小的计数向量与ring1向量（每元素1位）；
+     *             FOR      [基准值 u64][位宽 u8][元素减基准值后按位宽排列]，适合取值集中在某一区间的向量；
+     *             DELTA    [首元素 u64][位宽 u8][相邻差值zigzag后按位宽排列]，适合单调或缓变的向量；
+     *             LZ4/ZSTD 通用压缩，仅在构建时找到对应库（MPMT_HAVE_LZ4、MPMT_HAVE_ZSTD）时可用。
+     *          2. choose()逐块估算各编码的大小：先以一次扫描得到三种定宽编码的位宽，
+     *             均节省不足1/8时再用通用压缩试压块首的小段样本，样本同样不可压缩（如均匀随机的份额）时直接保留RAW，
+     *             因此随机数据只多付出一次扫描与一次样本压缩。
+     *          3. 编码结果不小于原始长度时视为失败，调用方应保留RAW。
+     */
+    class mrvf_codec
+    {
+    public:
+        /** @brief 块编码方式（写入块索引，取值不可更改） */
+        enum class codec : uint8_t
+        {
+            RAW = 0,        // 原始定宽存储
+            BITPACK = 1,    // 位打包
+            FOR = 2,        // 基准值 + 位打包
+            DELTA = 3,      // 差分 + zigzag + 位打包
+            LZ4 = 4,        // LZ4
+            ZSTD = 5,       // Zstandard
+        };
+        static constexpr uint8_t mc_CODEC_COUNT = 6;                // 编码方式个数
+
+        /**
+         * @brief   当前构建是否支持该编码
+         * @param   codec c 编码方式
+         * @return  bool
+         */
+        static bool available(codec c) noexcept;
+
+        /**
+         * @brief   编码方式名称
+         * @param   codec c 编码方式
+         * @return  const char*
+         */
+        static const char* name(codec c) noexcept;
+
+        /**
+         * @brief   按指定方式编码一个块
+         * @param   codec c 编码方式（非RAW）
+         * @param   uint8_t ring_size 元素字节数
+         * @param   const uint8_t* in 原始数据
+         * @param   uint64_t elems 元素个数
+         * @param   std::vector<uint8_t>& out 编码结果
+         * @return  bool 是否成功；编码不可用或结果不小于原始长度时返回false
+         */
+        static bool encode(codec c, uint8_t ring_size, const uint8_t* in, uint64_t elems, std::vector<uint8_t>& out);
+
+        /**
+         * @brief   解码一个块
+         * @param   codec c 编码方式（非RAW）
+         * @param   uint8_t ring_size 元素字节数
+         * @param   const uint8_t* in 编码数据
+         * @param   uint64_t in_bytes 编码数据长度
+         * @param   uint8_t* out 输出，elems * ring_size字节
+         * @param   uint64_t elems 元素个数
+         * @return  void
+         * @throw   std::runtime_error 编码不可用或数据不合法
+         */
+        static void decode(codec c, uint8_t ring_size, const uint8_t* in, uint64_t in_bytes, uint8_t* out, uint64_t elems);
+
+        /**
+         * @brief   为一个块选择编码并编码
+         * @param   uint8_t ring_size 元素字节数
+         * @param   const uint8_t* in 原始数据
+         * @param   uint64_t elems 元素个数
+         * @param   std::vector<uint8_t>& out 编码结果（返回RAW时内容无意义）
+         * @return  codec 选中的编码；节省不足1/8时为RAW
+         */
+        static codec choose(uint8_t ring_size, const uint8_t* in, uint64_t elems, std::vector<uint8_t>& out);
+    };
+}
+
+#endif // !MRVF_CODEC_HPP
@@ -1,27 +1,40 @@
 #ifndef MRVF_HANDLER_HPP
 #define MRVF_HANDLER_HPP
 
+#include <memory>
 #include <string>
+#include <utility>
+#include "core/io/io_adapter.hpp"
 #include "core/ring/mrvf/mrvf.hpp"
+#include "core/ring/mrvf/mrvf_block_file.hpp"
 #include "core/ring/ring.hpp"
 
 /** @namespace 项目命名空间 */
 namespace mpmt
 {
+    /**
+     * @class   mrvf文件的载入与保存
+     * @tparam  RT 环类型
+     * @note    ring_k<K>仅以v2位宽模式存储（见mrvf_block_file），不支持v1、patch()与append()。
+     */
     template<typename RT>
     class mrvf_handler
     {
     public:
         struct config
         {
-            bool m_use_memory_map;          // 读写文件时是否启用内存映射
+            bool m_use_memory_map;          // 读写文件时是否启用内存映射（v2仅作用于读取）
             bool m_enable_parallel_read;    // 是否启用多线程读入
+            uint16_t m_format_version = mrvf_block_file::mc_VERSION;                // 保存时使用的格式版本：1或2
+            uint32_t m_block_elems = mrvf_block_file::mc_DEFAULT_BLOCK_ELEMS;       // v2每块元素数
+            bool m_use_direct_io = false;   // v2读写是否绕过页缓存（O_DIRECT + io_uring，见io_direct），优先于内存映射
+            bool m_compress = false;        // v2写入时是否逐块选择压缩编码（见mrvf_codec），随机数据自动保留原始存储
         };
 
         /** @brief 断言限制模板类型 */
         static_assert(
             is_ring_type<RT>,
-            "RT must be ring1, ring8, ring16, ring32 or ring64."
+            "RT must be ring1, ring8, ring16, ring32, ring64 or ring_k<K>."
             );
 
         mrvf_handler(const mrvf_handler::config& config);
@@ -29,22 +42,70 @@ namespace mpmt
         /**
          * @brief 从文件中载入文件规定的环大小（用于单独判断环大小场景）
          * @param const std::string& load_path  加载路径
-         * @return uint8_t 文件的环大小
+         * @return uint8_t 文件的环大小（字节）；v2位宽模式的文件（ring_k）为位宽
          */
         uint8_t read_ring_size(const std::string& load_path);
 
         /**
-         * @brief 从文件中载入mrvf对象
+         * @brief 读取文件的格式版本
+         * @param const std::string& load_path  加载路径
+         * @return uint16_t 1或2
+         */
+        uint16_t read_version(const std::string& load_path);
+
+        /**
+         * @brief 从文件中载入mrvf对象（自动识别v1/v2）
          * @param const std::string& load_path  加载路径
          * @return mrvf<RT>
          */
         mrvf<RT> load(const std::string& load_path);
 
         /**
-         * @brief  保存mrvf对象为文件
+         * @brief 载入元素区间[first, first + count)
+         * @param const std::string& load_path  加载路径
+         * @param uint64_t first 首元素下标
+         * @param uint64_t count 元素个数
+         * @return rvector<RT>
+         * @note  v2只读取并校验覆盖的块；v1需读取并校验整个文件。
+         */
+        rvector<RT> load_range(const std::string& load_path, uint64_t first, uint64_t count);
+
+        /**
+         * @brief 校验元素区间[first, first + count)
+         * @param const std::string& load_path  加载路径
+         * @param uint64_t first 首元素下标
+         * @param uint64_t count 元素个数
+         * @return void
+         * @throw mrvf_exc 校验失败
+         * @note  v2只校验覆盖的块；v1校验整个文件。
+         */
+        void verify(const std::string& load_path, uint64_t first, uint64_t count);
+
+        /**
+         * @brief 原位改写v2文件的元素区间[first, first + values.size())
+         * @param const std::string& path 文件路径
+         * @param uint64_t first 首元素下标
+         * @param const rvector<RT>& values 新数据
+         * @return void
+         * @throw mrvf_exc 文件为v1、区间越界或校验失败
+         */
+        void patch(const std::string& path, uint64_t first, const rvector<RT>& values);
+
+        /**
+         * @brief 在v2文件末尾追加元素
+         * @param const std::string& path 文件路径
+         * @param const rvector<RT>& values 新数据
+         * @return void
+         * @throw mrvf_exc 文件为v1或写入失败
+         */
+        void append(const std::string& path, const rvector<RT>& values);
+
+        /**
+         * @brief  保存mrvf对象为文件（先写临时文件并落盘，再原子替换目标文件，见durable_file）
          * @param  const std::string& save_path,
          * @param  const mrvf<RT>& mrvf_obj
          * @return void
+         * @throw  mrvf_exc 写入、同步或重命名失败（目标文件保持原样）
          */
         void save
         (
@@ -52,9 +113,93 @@ namespace mpmt
             const mrvf<RT>& mrvf_obj
         );
 
-        ~mrvf_handler();
+        ~mrvf_handler() = default;
 
     private:
+        /**
+         * @brief 按配置的格式把mrvf对象写入文件（save()的写入部分）
+         * @param const std::string& save_path 写入路径
+         * @param const mrvf<RT>& mrvf_obj
+         * @return void
+         */
+        void write_file(const std::string& save_path, const mrvf<RT>& mrvf_obj);
+
+        /**
+         * @brief 打开v2文件对应的随机访问文件，按配置选择直接读写、内存映射或文件流
+         * @param const std::string& path 文件路径
+         * @param io_mode mode 打开方式
+         * @return std::unique_ptr<io_adapter>
+         */
+        std::unique_ptr<io_adapter> open_io(const std::string& path, io_mode mode) const;
+
+        /**
+         * @brief 检查v2文件的环大小并返回分块文件（写入的块按配置选择编码）
+         * @param io_adapter& io 已打开的文件
+         * @param const std::string& path 文件路径
+         * @return mrvf_block_file
+         */
+        mrvf_block_file open_blocks(io_adapter& io, const std::string& path) const;
+
+        /**
+         * @brief 检查ring_k的文件为v2（位宽模式仅存在于v2）
+         * @param const std::string& path 文件路径
+         * @return void
+         * @throw mrvf_exc 文件为v1
+         */
+        void require_bit_width(const std::string& path);
+
+        /**
+         * @brief 检查位宽模式文件的元素区间并换算为覆盖它的字节区间
+         * @return std::pair<uint64_t, uint64_t> 字节区间[first, last)
+         * @throw mrvf_exc 区间越界
+         */
+        static std::pair<uint64_t, uint64_t> packed_range
+        (
+            const mrvf_block_file& blocks,
+            const std::string& path,
+            uint64_t first,
+            uint64_t count
+        );
+
+        /** @brief 文件中记录的环位宽：ring_k<K>为K，其余为sizeof(RT) * 8 */
+        static constexpr unsigned ring_bits() noexcept
+        {
+            if constexpr (is_ring_k<RT>)
+            {
+                return RT::mc_BITS;
+            }
+            else
+            {
+                return sizeof(RT) * 8;
+            }
+        }
+
+        /**
+         * @brief 从完整的文件内容中解析并校验mrvf对象
+         * @param const uint8_t* file_buffer 文件内容
+         * @param uint64_t c_file_byte_size 文件大小
+         * @param const std::string& load_path 加载路径（用于错误信息）
+         * @return mrvf<RT>
+         */
+        static mrvf<RT> parse
+        (
+            const uint8_t* const file_buffer,
+            const uint64_t c_file_byte_size,
+            const std::string& load_path
+        );
+
+        /**
+         * @brief 将mrvf对象序列化到大小为mc_MIN_FILE_SIZE + 向量字节数的缓存区
+         * @param uint8_t* file_buffer 输出缓存区
+         * @param const mrvf<RT>& mrvf_obj
+         * @return void
+         */
+        static void serialize
+        (
+            uint8_t* const file_buffer,
+            const mrvf<RT>& mrvf_obj
+        );
+
         const mrvf_handler::config mc_config;                               // 加载、保存配置设置
 
         /** @brief mrcf file format bit size (Unit: Bytes) */
@@ -1,9 +1,18 @@
+#include <algorithm>
 #include <cstring>
 #include <fstream>
+#include <stdexcept>
+#include <vector>
 
+#include "auxkit/profiler.hpp"
 #include "core/mpmtcfg.hpp"
 #include "core/crc/crc64.hpp"
 #include "core/exception/mrvf_exc.hpp"
+#include "core/io/direct_impl/io_direct.hpp"
+#include "core/io/durable_file.hpp"
+#include "core/io/mapped_file.hpp"
+#include "core/io/mmap_impl/io_mmap.hpp"
+#include "core/io/stream_impl/io_stream.hpp"
 
 namespace mpmt
 {
@@ -27,9 +36,11 @@ namespace mpmt
         }
 
 
-        // 2-偏移至 ring_size字段
+        // 2-偏移至 ring_size字段（v1紧随文件头，v2位于文件头内）
         //  2.1-偏移输入流指针至offset
-        const uint64_t offset = mc_BOF_BYTE_SIZE;
+        const uint64_t offset = (read_version(load_path) == mrvf_block_file::mc_VERSION)
+            ? mrvf_block_file::mc_RING_SIZE_OFFSET
+            : mc_BOF_BYTE_SIZE;
         in_file.seekg(offset);
 
         //  2.2-检查是否seek成功
@@ -74,21 +85,66 @@ namespace mpmt
         return ring_size;
     }
 
+    template<typename RT>
+    uint16_t mrvf_handler<RT>::read_version(const std::string& load_path)
+    {
+        std::ifstream in_file(load_path, std::ios::binary);
+        if (!in_file)
+        {
+            throw mpmt::mrvf_exc
+            (
+                mrvf_exc::exc_type::IOFLOW_ERROR,
+                "Can not open the file [" + load_path + "]."
+            );
+        }
+
+        // 文件不足8字节时按v1处理，由后续解析报告截断
+        uint8_t head[sizeof(mrvf_block_file::mc_MAGIC)] = {};
+        in_file.read(reinterpret_cast<char*>(head), sizeof(head));
+        const uint64_t c_got = static_cast<uint64_t>(in_file.gcount());
+        return mrvf_block_file::probe(head, c_got) ? mrvf_block_file::mc_VERSION : 1;
+    }
+
     template<typename RT>
     mrvf<RT> mrvf_handler<RT>::load(const std::string& load_path)
     {
+        MPMT_PROF_SCOPE("mrvf_handler::load");
+        if constexpr (is_ring_k<RT>)
+        {
+            // ring_k：v2位宽模式，存储字节直接读入紧密存储
+            require_bit_width(load_path);
+            std::unique_ptr<io_adapter> io = open_io(load_path, io_mode::READ);
+            mrvf_block_file blocks = open_blocks(*io, load_path);
+            mpmt::rvector<RT> l_rvector(blocks.elements());
+            blocks.read(0, blocks.size(), reinterpret_cast<uint8_t*>(l_rvector.m_data.get()));
+            return mrvf<RT>(std::move(l_rvector));
+        }
+        if (read_version(load_path) == mrvf_block_file::mc_VERSION)
+        {
+            // v2：读取并校验全部块
+            std::unique_ptr<io_adapter> io = open_io(load_path, io_mode::READ);
+            mrvf_block_file blocks = open_blocks(*io, load_path);
+            mpmt::rvector<RT> l_rvector(blocks.size());
+            blocks.read(0, blocks.size(), reinterpret_cast<uint8_t*>(l_rvector.m_data.get()));
+            return mrvf<RT>(std::move(l_rvector));
+        }
+
         if (mc_config.m_use_memory_map)
         {
-#ifdef MPMT_OS_WIN
-#elif MPMT_OS_IOS
-#error "No immediate plan."
-#elif MPMT_OS_MACOS
-#error "Coming soon."
-#elif MPMT_OS_ANDROID
-#error "No immediate plan."
-#elif MPMT_OS_LINUX
-#error "Coming soon."
-#endif 
+            // 直接在只读映射上解析，省去整文件缓存区
+            try
+            {
+                const mapped_file file(load_path);
+                return parse(file.data(), file.size(), load_path);
+            }
+            catch (const std::runtime_error& e)
+            {
+                if (dynamic_cast<const mrvf_exc*>(&e) != nullptr)
+                {
+                    throw;
+                }
+                throw mpmt::mrvf_exc(mrvf_exc::exc_type::IOFLOW_ERROR, e.what());
+            }
         }
         else
         {
@@ -141,39 +197,10 @@ namespace mpmt
                 );
             }
 
-            //  2.2-判断文件大小是否超出限制
-            if (c_file_byte_size > mc_MIN_FILE_SIZE + mc_MAX_RVECTOR_SIZE * sizeof(RT))
-            {
-                throw mpmt::mrvf_exc
-                (
-                    mrvf_exc::exc_type::FILE_CORRUPTION,
-                    "The size of the file["
-                    + load_path
-                    + "] exceeds the allowed limit. Loaded file size: "
-                    + std::to_string(c_file_byte_size)
-                    + " byte(s); maximum allowed: "
-                    + std::to_string(mc_MIN_FILE_SIZE + mc_MAX_RVECTOR_SIZE * sizeof(RT))
-                    + " byte(s)."
-                );
-            }
-
-            //  2.3-判断文件是否不满足最小大小
-            if (c_file_byte_size < mc_MIN_FILE_SIZE)
-            {
-                throw mpmt::mrvf_exc(
-                    mrvf_exc::exc_type::FILE_CORRUPTION,
-                    "File["
-                    + load_path
-                    + "] is unexpectedly truncated. Its size is below the minimum expected threshold="
-                    + std::to_string(mc_MIN_FILE_SIZE)
-                    + "byte(s)."
-                );
-            }
-
-            //  2.4-分配缓存区
+            //  2.2-分配缓存区
             std::unique_ptr<uint8_t[]> file_buffer = std::make_unique<uint8_t[]>(c_file_byte_size);
 
-            //  2.5-读入数据到缓存区并校验操作
+            //  2.3-读入数据到缓存区并校验操作
             in_file.read(reinterpret_cast<char*>(file_buffer.get()), c_file_byte_size);
             if (!in_file)
             {
@@ -187,160 +214,457 @@ namespace mpmt
             }
 
 
-            // 3-从缓冲区读出数据
-            //  3.1-初始化读指针
-            uint64_t ipointer = 0ULL;
+            return parse(file_buffer.get(), c_file_byte_size, load_path);
+        }
+    }
+
 
-            //  3.2-读取文件头并校验
-            for (uint64_t i = 0;i < mc_BOF_BYTE_SIZE;++i)
+    template<typename RT>
+    rvector<RT> mrvf_handler<RT>::load_range(const std::string& load_path, uint64_t first, uint64_t count)
+    {
+        MPMT_PROF_SCOPE("mrvf_handler::load_range");
+        if constexpr (is_ring_k<RT>)
+        {
+            // ring_k：读入覆盖区间的字节后按位截取
+            require_bit_width(load_path);
+            std::unique_ptr<io_adapter> io = open_io(load_path, io_mode::READ);
+            mrvf_block_file blocks = open_blocks(*io, load_path);
+            const std::pair<uint64_t, uint64_t> c_bytes = packed_range(blocks, load_path, first, count);
+            mpmt::rvector<RT> l_rvector(count);
+            if (count != 0)
             {
-                if (file_buffer[i + ipointer] != mc_BOF[i])
+                std::vector<uint64_t> window((c_bytes.second - c_bytes.first + 7) / 8 + 1, 0);
+                blocks.read(c_bytes.first, c_bytes.second - c_bytes.first, reinterpret_cast<uint8_t*>(window.data()));
+                const uint64_t c_bit = first * RT::mc_BITS % 8;
+                for (uint64_t i = 0; i < count; ++i)
                 {
-                    throw mpmt::mrvf_exc
-                    (
-                        mrvf_exc::exc_type::FILE_CORRUPTION,
-                        "Invalid beginning of the file ["
-                        + load_path
-                        + "] or it is corrupted. BOF mismatch detected in file buffer at index="
-                        + std::to_string(i)
-                        + "."
-                    );
+                    l_rvector.set(i, RT(rvector<RT>::extract(window.data(), c_bit + i * RT::mc_BITS)));
                 }
             }
-            ipointer += mc_BOF_BYTE_SIZE;
+            return l_rvector;
+        }
+        if (read_version(load_path) == mrvf_block_file::mc_VERSION)
+        {
+            std::unique_ptr<io_adapter> io = open_io(load_path, io_mode::READ);
+            mrvf_block_file blocks = open_blocks(*io, load_path);
+            mpmt::rvector<RT> l_rvector(count);
+            blocks.read(first, count, reinterpret_cast<uint8_t*>(l_rvector.m_data.get()));
+            return l_rvector;
+        }
 
-            //  3.3 读入环大小字段
-            uint8_t ring_size = file_buffer[ipointer];
-            if (ring_size != sizeof(RT))
+        // v1：只能整体读入校验后截取
+        const mrvf<RT> whole = load(load_path);
+        if (first > whole.m_rvector.size() || count > whole.m_rvector.size() - first)
+        {
+            throw mpmt::mrvf_exc
+            (
+                mrvf_exc::exc_type::IOFLOW_ERROR,
+                "Range of " + std::to_string(count) + " element(s) starting at " + std::to_string(first)
+                + " exceeds the " + std::to_string(whole.m_rvector.size()) + " element(s) of the file [" + load_path + "]."
+            );
+        }
+        mpmt::rvector<RT> l_rvector(count);
+        std::copy
+        (
+            whole.m_rvector.m_data.get() + first,
+            whole.m_rvector.m_data.get() + first + count,
+            l_rvector.m_data.get()
+        );
+        return l_rvector;
+    }
+
+    template<typename RT>
+    void mrvf_handler<RT>::verify(const std::string& load_path, uint64_t first, uint64_t count)
+    {
+        MPMT_PROF_SCOPE("mrvf_handler::verify");
+        if constexpr (is_ring_k<RT>)
+        {
+            require_bit_width(load_path);
+            std::unique_ptr<io_adapter> io = open_io(load_path, io_mode::READ);
+            mrvf_block_file blocks = open_blocks(*io, load_path);
+            const std::pair<uint64_t, uint64_t> c_bytes = packed_range(blocks, load_path, first, count);
+            blocks.verify(c_bytes.first, c_bytes.second - c_bytes.first);
+            return;
+        }
+        if (read_version(load_path) == mrvf_block_file::mc_VERSION)
+        {
+            std::unique_ptr<io_adapter> io = open_io(load_path, io_mode::READ);
+            open_blocks(*io, load_path).verify(first, count);
+            return;
+        }
+        (void)load_range(load_path, first, count);
+    }
+
+    template<typename RT>
+    void mrvf_handler<RT>::patch(const std::string& path, uint64_t first, const rvector<RT>& values)
+    {
+        MPMT_PROF_SCOPE("mrvf_handler::patch");
+        if constexpr (is_ring_k<RT>)
+        {
+            throw mpmt::mrvf_exc
+            (
+                mrvf_exc::exc_type::VERSION_UNSUPPORTED,
+                "In-place patching of the bit-width file [" + path + "] is not supported."
+            );
+        }
+        if (read_version(path) != mrvf_block_file::mc_VERSION)
+        {
+            throw mpmt::mrvf_exc
+            (
+                mrvf_exc::exc_type::VERSION_UNSUPPORTED,
+                "In-place patching requires a v2 file, but the file [" + path + "] is v1."
+            );
+        }
+        std::unique_ptr<io_adapter> io = open_io(path, io_mode::READ_WRITE);
+        open_blocks(*io, path).patch(first, values.size(), reinterpret_cast<const uint8_t*>(values.m_data.get()));
+    }
+
+    template<typename RT>
+    void mrvf_handler<RT>::append(const std::string& path, const rvector<RT>& values)
+    {
+        MPMT_PROF_SCOPE("mrvf_handler::append");
+        if constexpr (is_ring_k<RT>)
+        {
+            throw mpmt::mrvf_exc
+            (
+                mrvf_exc::exc_type::VERSION_UNSUPPORTED,
+                "Appending to the bit-width file [" + path + "] is not supported."
+            );
+        }
+        if (read_version(path) != mrvf_block_file::mc_VERSION)
+        {
+            throw mpmt::mrvf_exc
+            (
+                mrvf_exc::exc_type::VERSION_UNSUPPORTED,
+                "Appending requires a v2 file, but the file [" + path + "] is v1."
+            );
+        }
+        std::unique_ptr<io_adapter> io = open_io(path, io_mode::READ_WRITE);
+        open_blocks(*io, path).append(values.size(), reinterpret_cast<const uint8_t*>(values.m_data.get()));
+    }
+
+    template<typename RT>
+    std::unique_ptr<io_adapter> mrvf_handler<RT>::open_io(const std::string& path, io_mode mode) const
+    {
+        try
+        {
+            if (mc_config.m_use_direct_io && io_direct::supported())
             {
-                throw mpmt::mrvf_exc
-                (
-                    mrvf_exc::exc_type::RING_SIZE_MISMATCH,
-                    "Ring size mismatches in the file["
-                    + load_path
-                    + "] or it is corrupted. The file declares ring as Z_{2^"
-                    + std::to_string(ring_size * 8)
-                    + "}, but the selected parameter is Z_{2^"
-                    + std::to_string(sizeof(RT) * 8)
-                    + "}."
-                );
+                return std::make_unique<io_direct>(path, mode);
             }
-            ipointer += mc_RING_SIZE_BYTE_SIZE;
+            if (mode == io_mode::READ && mc_config.m_use_memory_map)
+            {
+                return std::make_unique<io_mmap>(path);
+            }
+            return std::make_unique<io_stream>(path, mode);
+        }
+        catch (const std::runtime_error& e)
+        {
+            throw mpmt::mrvf_exc(mrvf_exc::exc_type::IOFLOW_ERROR, e.what());
+        }
+    }
 
-            //  3.4-读入向量大小字段 
-            //  (1) 读入字段
-            uint64_t rvector_size;
-            std::memcpy
+    template<typename RT>
+    mrvf_block_file mrvf_handler<RT>::open_blocks(io_adapter& io, const std::string& path) const
+    {
+        mrvf_block_file blocks(io, path, mc_config.m_compress);
+        if (blocks.packed() != is_ring_k<RT> || blocks.ring_bits() != ring_bits())
+        {
+            throw mpmt::mrvf_exc
             (
-                reinterpret_cast<char*>(&rvector_size),
-                reinterpret_cast<char*>(file_buffer.get()) + ipointer,
-                mc_RVECTOR_SIZE_BYTE_SIZE
+                mrvf_exc::exc_type::RING_SIZE_MISMATCH,
+                "Ring size mismatches in the file["
+                + path
+                + "]. The file declares ring as Z_{2^"
+                + std::to_string(blocks.ring_bits())
+                + (blocks.packed() ? "} (bit-width)" : "}")
+                + ", but the selected parameter is Z_{2^"
+                + std::to_string(ring_bits())
+                + (is_ring_k<RT> ? "} (bit-width)." : "}.")
             );
-            ipointer += mc_RVECTOR_SIZE_BYTE_SIZE;
-            const uint64_t c_rvector_byte_size = rvector_size * sizeof(RT);
-            //  (2) 检查文件是否意外损害
-            if (c_rvector_byte_size + mc_MIN_FILE_SIZE != c_file_byte_size)
+        }
+        return blocks;
+    }
+
+    template<typename RT>
+    void mrvf_handler<RT>::require_bit_width(const std::string& path)
+    {
+        if (read_version(path) != mrvf_block_file::mc_VERSION)
+        {
+            throw mpmt::mrvf_exc
+            (
+                mrvf_exc::exc_type::VERSION_UNSUPPORTED,
+                "ring_k vectors are stored only in v2 bit-width files, but the file [" + path + "] is v1."
+            );
+        }
+    }
+
+    template<typename RT>
+    std::pair<uint64_t, uint64_t> mrvf_handler<RT>::packed_range
+    (
+        const mrvf_block_file& blocks,
+        const std::string& path,
+        uint64_t first,
+        uint64_t count
+    )
+    {
+        if (first > blocks.elements() || count > blocks.elements() - first)
+        {
+            throw mpmt::mrvf_exc
+            (
+                mrvf_exc::exc_type::IOFLOW_ERROR,
+                "Range of " + std::to_string(count) + " element(s) starting at " + std::to_string(first)
+                + " exceeds the " + std::to_string(blocks.elements()) + " element(s) of the file [" + path + "]."
+            );
+        }
+        return { first * blocks.ring_bits() / 8, ((first + count) * blocks.ring_bits() + 7) / 8 };
+    }
+
+    template<typename RT>
+    mrvf<RT> mrvf_handler<RT>::parse
+    (
+        const uint8_t* const file_buffer,
+        const uint64_t c_file_byte_size,
+        const std::string& load_path
+    )
+    {
+        // 1-判断文件大小是否超出限制
+        if (c_file_byte_size > mc_MIN_FILE_SIZE + mc_MAX_RVECTOR_SIZE * sizeof(RT))
+        {
+            throw mpmt::mrvf_exc
+            (
+                mrvf_exc::exc_type::FILE_CORRUPTION,
+                "The size of the file["
+                + load_path
+                + "] exceeds the allowed limit. Loaded file size: "
+                + std::to_string(c_file_byte_size)
+                + " byte(s); maximum allowed: "
+                + std::to_string(mc_MIN_FILE_SIZE + mc_MAX_RVECTOR_SIZE * sizeof(RT))
+                + " byte(s)."
+            );
+        }
+
+        // 2-判断文件是否不满足最小大小
+        if (c_file_byte_size < mc_MIN_FILE_SIZE)
+        {
+            throw mpmt::mrvf_exc(
+                mrvf_exc::exc_type::FILE_CORRUPTION,
+                "File["
+                + load_path
+                + "] is unexpectedly truncated. Its size is below the minimum expected threshold="
+                + std::to_string(mc_MIN_FILE_SIZE)
+                + "byte(s)."
+            );
+        }
+
+        // 3-从缓冲区读出数据
+        //  3.1-初始化读指针
+        uint64_t ipointer = 0ULL;
+
+        //  3.2-读取文件头并校验
+        for (uint64_t i = 0;i < mc_BOF_BYTE_SIZE;++i)
+        {
+            if (file_buffer[i + ipointer] != mc_BOF[i])
             {
-                throw mpmt::mrvf_exc(
+                throw mpmt::mrvf_exc
+                (
                     mrvf_exc::exc_type::FILE_CORRUPTION,
-                    "The value read from 'rvector_size' does not match the expected value in the file ["
+                    "Invalid beginning of the file ["
                     + load_path
-                    + "]. The value of rvector_size="
-                    + std::to_string(c_rvector_byte_size)
-                    + " plus the fixed header length="
-                    + std::to_string(mc_MIN_FILE_SIZE)
-                    + " does not match the total file size="
-                    + std::to_string(c_file_byte_size)
+                    + "] or it is corrupted. BOF mismatch detected in file buffer at index="
+                    + std::to_string(i)
                     + "."
                 );
             }
+        }
+        ipointer += mc_BOF_BYTE_SIZE;
 
-
-            //  3.5 写入向量
-            //  (1) 初始化 rvector
-            mpmt::rvector<RT> l_rvector(rvector_size);
-            //  (2) 将数据拷入rvector
-            std::memcpy
+        //  3.3 读入环大小字段
+        uint8_t ring_size = file_buffer[ipointer];
+        if (ring_size != sizeof(RT))
+        {
+            throw mpmt::mrvf_exc
             (
-                reinterpret_cast<char*>(l_rvector.m_data.get()),
-                reinterpret_cast<char*>(file_buffer.get()) + ipointer,
-                c_rvector_byte_size
+                mrvf_exc::exc_type::RING_SIZE_MISMATCH,
+                "Ring size mismatches in the file["
+                + load_path
+                + "] or it is corrupted. The file declares ring as Z_{2^"
+                + std::to_string(ring_size * 8)
+                + "}, but the selected parameter is Z_{2^"
+                + std::to_string(sizeof(RT) * 8)
+                + "}."
             );
-            ipointer += (c_rvector_byte_size);
-
-            // 3.6 进行crc64校验
-            // (1) 从文件中读出校验和
-            uint64_t file_crc64;
-            std::memcpy
-            (
-                reinterpret_cast<char*>(&file_crc64),
-                reinterpret_cast<char*>(file_buffer.get()) + ipointer,
-                mc_CRC64_BYTE_SIZE
+        }
+        ipointer += mc_RING_SIZE_BYTE_SIZE;
+
+        //  3.4-读入向量大小字段 
+        //  (1) 读入字段
+        uint64_t rvector_size;
+        std::memcpy
+        (
+            reinterpret_cast<char*>(&rvector_size),
+            reinterpret_cast<const char*>(file_buffer) + ipointer,
+            mc_RVECTOR_SIZE_BYTE_SIZE
+        );
+        ipointer += mc_RVECTOR_SIZE_BYTE_SIZE;
+        const uint64_t c_rvector_byte_size = rvector_size * sizeof(RT);
+        //  (2) 检查文件是否意外损害
+        if (c_rvector_byte_size + mc_MIN_FILE_SIZE != c_file_byte_size)
+        {
+            throw mpmt::mrvf_exc(
+                mrvf_exc::exc_type::FILE_CORRUPTION,
+                "The value read from 'rvector_size' does not match the expected value in the file ["
+                + load_path
+                + "]. The value of rvector_size="
+                + std::to_string(c_rvector_byte_size)
+                + " plus the fixed header length="
+                + std::to_string(mc_MIN_FILE_SIZE)
+                + " does not match the total file size="
+                + std::to_string(c_file_byte_size)
+                + "."
             );
-            // (2) 计算CRC校验长度
-            const uint64_t c_crc64_compute_len
-                = mc_RING_SIZE_BYTE_SIZE
-                + mc_RVECTOR_SIZE_BYTE_SIZE
-                + c_rvector_byte_size;
-            // (3) 比较CRC校验和
-            uint64_t computing_crc64 = mpmt::crc64::compute
+        }
+
+
+        //  3.5 写入向量
+        //  (1) 初始化 rvector
+        mpmt::rvector<RT> l_rvector(rvector_size);
+        //  (2) 将数据拷入rvector
+        std::memcpy
+        (
+            reinterpret_cast<char*>(l_rvector.m_data.get()),
+            reinterpret_cast<const char*>(file_buffer) + ipointer,
+            c_rvector_byte_size
+        );
+        ipointer += (c_rvector_byte_size);
+
+        // 3.6 进行crc64校验
+        // (1) 从文件中读出校验和
+        uint64_t file_crc64;
+        std::memcpy
+        (
+            reinterpret_cast<char*>(&file_crc64),
+            reinterpret_cast<const char*>(file_buffer) + ipointer,
+            mc_CRC64_BYTE_SIZE
+        );
+        // (2) 计算CRC校验长度
+        const uint64_t c_crc64_compute_len
+            = mc_RING_SIZE_BYTE_SIZE
+            + mc_RVECTOR_SIZE_BYTE_SIZE
+            + c_rvector_byte_size;
+        // (3) 比较CRC校验和
+        uint64_t computing_crc64 = mpmt::crc64::compute
+        (
+            file_buffer + mc_BOF_BYTE_SIZE,
+            c_crc64_compute_len
+        );
+        if (file_crc64 != computing_crc64)
+        {
+            throw mpmt::mrvf_exc
             (
-                file_buffer.get() + mc_BOF_BYTE_SIZE,
-                c_crc64_compute_len
+
+                mrvf_exc::exc_type::FILE_CORRUPTION,
+                "CRC64 check failed in the file["
+                + load_path
+                + "]. Expected checksum="
+                + std::to_string(file_crc64)
+                + " from file, but computed checksum="
+                + std::to_string(computing_crc64)
+                + "."
             );
-            if (file_crc64 != computing_crc64)
+        }
+        ipointer += mc_CRC64_BYTE_SIZE;
+
+        // 3.7 比较件尾
+        for (uint64_t i = 0;i < mc_EOF_BYTE_SIZE;++i)
+        {
+            if (file_buffer[i + ipointer] != mc_EOF[i])
             {
                 throw mpmt::mrvf_exc
                 (
-
                     mrvf_exc::exc_type::FILE_CORRUPTION,
-                    "CRC64 check failed in the file["
+                    "Invalid end of the file["
                     + load_path
-                    + "]. Expected checksum="
-                    + std::to_string(file_crc64)
-                    + " from file, but computed checksum="
-                    + std::to_string(computing_crc64)
+                    + "]. EOF mismatch found in file_buffer at index "
+                    + std::to_string(i)
                     + "."
                 );
             }
-            ipointer += mc_CRC64_BYTE_SIZE;
 
-            // 3.7 比较件尾
-            for (uint64_t i = 0;i < mc_EOF_BYTE_SIZE;++i)
-            {
-                if (file_buffer[i + ipointer] != mc_EOF[i])
-                {
-                    throw mpmt::mrvf_exc
-                    (
-                        mrvf_exc::exc_type::FILE_CORRUPTION,
-                        "Invalid end of the file["
-                        + load_path
-                        + "]. EOF mismatch found in file_buffer at index "
-                        + std::to_string(i)
-                        + "."
-                    );
-                }
+        }
+        ipointer += mc_EOF_BYTE_SIZE;
 
-            }
-            ipointer += mc_EOF_BYTE_SIZE;
+        // 3.8-防御性断言，确保没有未定义错误
+        MPMT_ASSERT(ipointer == c_file_byte_size, "File read operation was unexpectedly interrupted.");
 
-            // 3.8-防御性断言，确保没有未定义错误
-            MPMT_ASSERT(ipointer == c_file_byte_size, "File read operation was unexpectedly interrupted.");
 
+        // 4-返回读入的mrvf对象
+        return mrvf<RT>(std::move(l_rvector));
+    }
 
-            // 4-返回读入的mrvf对象
-            return mrvf<RT>(std::move(l_rvector));
+    template<typename RT>
+    void mrvf_handler<RT>::save
+    (
+        const std::string& save_path,
+        const mrvf<RT>& mrvf_obj
+    )
+    {
+        MPMT_PROF_SCOPE("mrvf_handler::save");
+
+        // 写入同目录的临时文件，落盘后原子替换目标文件：中途崩溃不会留下半个文件
+        const std::string c_temp = durable_file::temp_path(save_path);
+        try
+        {
+            write_file(c_temp, mrvf_obj);
+        }
+        catch (...)
+        {
+            durable_file::remove(c_temp);
+            throw;
+        }
+        try
+        {
+            durable_file::commit(c_temp, save_path);
+        }
+        catch (const std::runtime_error& e)
+        {
+            durable_file::remove(c_temp);
+            throw mpmt::mrvf_exc(mrvf_exc::exc_type::IOFLOW_ERROR, e.what());
         }
     }
 
-
     template<typename RT>
-    void mrvf_handler<RT>::save
+    void mrvf_handler<RT>::write_file
     (
         const std::string& save_path,
         const mrvf<RT>& mrvf_obj
     )
     {
+        if constexpr (is_ring_k<RT>)
+        {
+            // ring_k：仅以v2位宽模式保存，数据为紧密存储的有效字节
+            if (mc_config.m_format_version != mrvf_block_file::mc_VERSION)
+            {
+                throw mpmt::mrvf_exc
+                (
+                    mrvf_exc::exc_type::VERSION_UNSUPPORTED,
+                    "ring_k vectors are stored only in v2 bit-width files, cannot save the file [" + save_path
+                    + "] as version " + std::to_string(mc_config.m_format_version) + "."
+                );
+            }
+            std::unique_ptr<io_adapter> io = open_io(save_path, io_mode::CREATE);
+            mrvf_block_file::write_bits
+            (
+                *io,
+                save_path,
+                static_cast<uint8_t>(RT::mc_BITS),
+                mc_config.m_block_elems,
+                reinterpret_cast<const uint8_t*>(mrvf_obj.m_rvector.m_data.get()),
+                mrvf_obj.m_rvector.size(),
+                mc_config.m_compress
+            );
+            return;
+        }
         // 其实逻辑上根本不可能出现这种问题，mrvf<RT>构造时的ring_size参数都是sizeof(RT)，
         // 且ring_size是const，只是写一个防御性判断...
         if (mrvf_obj.mc_ring_size != sizeof(RT))
@@ -358,18 +682,45 @@ namespace mpmt
             );
         }
 
+        if (mc_config.m_format_version == mrvf_block_file::mc_VERSION)
+        {
+            // v2：分块写入，内存映射配置仅作用于读取
+            std::unique_ptr<io_adapter> io = open_io(save_path, io_mode::CREATE);
+            mrvf_block_file::write
+            (
+                *io,
+                save_path,
+                mrvf_obj.mc_ring_size,
+                mc_config.m_block_elems,
+                reinterpret_cast<const uint8_t*>(mrvf_obj.m_rvector.m_data.get()),
+                mrvf_obj.m_rvector.size(),
+                mc_config.m_compress
+            );
+            return;
+        }
+        if (mc_config.m_format_version != 1)
+        {
+            throw mpmt::mrvf_exc
+            (
+                mrvf_exc::exc_type::VERSION_UNSUPPORTED,
+                "Cannot save the file [" + save_path + "] as version " + std::to_string(mc_config.m_format_version) + "."
+            );
+        }
+
+        const uint64_t c_file_byte_size = mc_MIN_FILE_SIZE + mrvf_obj.m_rvector.size() * sizeof(RT);
         if (mc_config.m_use_memory_map)
         {
-#ifdef MPMT_OS_WIN
-#elif MPMT_OS_IOS
-#error "No immediate plan."
-#elif MPMT_OS_MACOS
-#error "Coming soon."
-#elif MPMT_OS_ANDROID
-#error "No immediate plan."
-#elif MPMT_OS_LINUX
-#error "Coming soon."
-#endif 
+            // 直接序列化到读写映射，省去整文件缓存区
+            try
+            {
+                mapped_file file(save_path, c_file_byte_size);
+                serialize(file.mutable_data(), mrvf_obj);
+                file.flush();
+            }
+            catch (const std::runtime_error& e)
+            {
+                throw mpmt::mrvf_exc(mrvf_exc::exc_type::IOFLOW_ERROR, e.what());
+            }
         }
         else
         {
@@ -385,92 +736,109 @@ namespace mpmt
             }
 
 
-            // 2-建立文件缓存区 
-            //  2.1-计算常用长度
-            //  (1) 向量长度
-            const uint64_t c_rvector_size = mrvf_obj.m_rvector.size();
-            //  (2) 向量在文件中的实际存储大小（字节）
-            const uint64_t c_rvector_byte_size = c_rvector_size * sizeof(RT);
-            //  (3) 文件大小（字节）
-            const uint64_t c_file_byte_size         // 单位：字节
-                = mc_MIN_FILE_SIZE                  // 文件头+环大小字段+向量大小字段+crc校验码字段+文件尾
-                + c_rvector_byte_size;              // 数据段大小
-
-            //  2.2-为缓存区分配内存
+            // 2-建立文件缓存区并序列化
             std::unique_ptr<uint8_t[]> file_buffer = std::make_unique<uint8_t[]>(c_file_byte_size);
+            serialize(file_buffer.get(), mrvf_obj);
 
 
-            // 3-向缓冲区写入文件
-            //  3.1-初始化写指针
-            uint64_t opointer = 0ULL;
-
-            //  3.2-写入文件头
-            for (uint64_t i = 0;i < mc_BOF_BYTE_SIZE;++i)
-            {
-                file_buffer[i + opointer] = mc_BOF[i];
-            }
-            opointer += mc_BOF_BYTE_SIZE;
-
-            //  3.3 写入环大小字段
-            file_buffer[opointer] = mrvf_obj.mc_ring_size;
-            opointer += mc_RING_SIZE_BYTE_SIZE;
-
-            //  3.4 写入向量大小
-            std::memcpy
-            (
-                reinterpret_cast<char*>(file_buffer.get()) + opointer,
-                reinterpret_cast<const char*>(&c_rvector_size),
-                mc_RVECTOR_SIZE_BYTE_SIZE
-            );
-            opointer += mc_RVECTOR_SIZE_BYTE_SIZE;
-
-            //  3.5 写入向量
-            std::memcpy
-            (
-                reinterpret_cast<char*>(file_buffer.get()) + opointer,
-                reinterpret_cast<char*>(mrvf_obj.m_rvector.m_data),
-                c_rvector_byte_size
-            );
-            opointer += (c_rvector_byte_size);
-
-            // 3.6 进行crc64校验码计算，并写入文件
-            // (1) 计算CRC校验长度
-            const uint64_t c_crc64_compute_len
-                = mc_RING_SIZE_BYTE_SIZE
-                + mc_RVECTOR_SIZE_BYTE_SIZE
-                + c_rvector_byte_size;
-            // (2) 计算CRC校验和
-            uint64_t computing_crc64 = mpmt::crc64::compute
-            (
-                file_buffer.get() + mc_BOF_BYTE_SIZE,
-                c_crc64_compute_len
-            );
-            // (3) 写入校验和
-            std::memcpy
-            (
-                reinterpret_cast<char*>(file_buffer.get()) + opointer,
-                reinterpret_cast<char*>(&computing_crc64),
-                mc_CRC64_BYTE_SIZE
-            );
-            opointer += mc_CRC64_BYTE_SIZE;
-
-            // 3.7 写入文件尾
-            for (uint64_t i = 0;i < mc_EOF_BYTE_SIZE;++i)
-            {
-                file_buffer[i + opointer] = mc_EOF[i];
-            }
-            opointer += mc_EOF_BYTE_SIZE;
-
-            // 3.8-防御性断言，确保没有未定义错误
-            MPMT_ASSERT(opointer == c_file_byte_size, "File write operation was unexpectedly interrupted.");
-
-
-            // 4-将缓存区内容写入文件
+            // 3-将缓存区内容写入文件
             out_file.write
             (
                 reinterpret_cast<const char*>(file_buffer.get()),
                 c_file_byte_size
             );
+            out_file.close();
+            if (!out_file)
+            {
+                throw mpmt::mrvf_exc
+                (
+                    mrvf_exc::exc_type::IOFLOW_ERROR,
+                    "Cannot write the file [" + save_path + "] correctly."
+                );
+            }
+        }
+    }
+
+    template<typename RT>
+    void mrvf_handler<RT>::serialize
+    (
+        uint8_t* const file_buffer,
+        const mrvf<RT>& mrvf_obj
+    )
+    {
+        // 1-计算常用长度
+        //  (1) 向量长度
+        const uint64_t c_rvector_size = mrvf_obj.m_rvector.size();
+        //  (2) 向量在文件中的实际存储大小（字节）
+        const uint64_t c_rvector_byte_size = c_rvector_size * sizeof(RT);
+        //  (3) 文件大小（字节）
+        const uint64_t c_file_byte_size         // 单位：字节
+            = mc_MIN_FILE_SIZE                  // 文件头+环大小字段+向量大小字段+crc校验码字段+文件尾
+            + c_rvector_byte_size;              // 数据段大小
+
+
+        // 2-向缓冲区写入文件
+        //  2.1-初始化写指针
+        uint64_t opointer = 0ULL;
+
+        //  2.2-写入文件头
+        for (uint64_t i = 0;i < mc_BOF_BYTE_SIZE;++i)
+        {
+            file_buffer[i + opointer] = mc_BOF[i];
+        }
+        opointer += mc_BOF_BYTE_SIZE;
+
+        //  2.3 写入环大小字段
+        file_buffer[opointer] = mrvf_obj.mc_ring_size;
+        opointer += mc_RING_SIZE_BYTE_SIZE;
+
+        //  2.4 写入向量大小
+        std::memcpy
+        (
+            reinterpret_cast<char*>(file_buffer) + opointer,
+            reinterpret_cast<const char*>(&c_rvector_size),
+            mc_RVECTOR_SIZE_BYTE_SIZE
+        );
+        opointer += mc_RVECTOR_SIZE_BYTE_SIZE;
+
+        //  2.5 写入向量
+        std::memcpy
+        (
+            reinterpret_cast<char*>(file_buffer) + opointer,
+            reinterpret_cast<const char*>(mrvf_obj.m_rvector.m_data.get()),
+            c_rvector_byte_size
+        );
+        opointer += (c_rvector_byte_size);
+
+        // 2.6 进行crc64校验码计算，并写入文件
+        // (1) 计算CRC校验长度
+        const uint64_t c_crc64_compute_len
+            = mc_RING_SIZE_BYTE_SIZE
+            + mc_RVECTOR_SIZE_BYTE_SIZE
+            + c_rvector_byte_size;
+        // (2) 计算CRC校验和
+        uint64_t computing_crc64 = mpmt::crc64::compute
+        (
+            file_buffer + mc_BOF_BYTE_SIZE,
+            c_crc64_compute_len
+        );
+        // (3) 写入校验和
+        std::memcpy
+        (
+            reinterpret_cast<char*>(file_buffer) + opointer,
+            reinterpret_cast<char*>(&computing_crc64),
+            mc_CRC64_BYTE_SIZE
+        );
+        opointer += mc_CRC64_BYTE_SIZE;
+
+        // 2.7 写入文件尾
+        for (uint64_t i = 0;i < mc_EOF_BYTE_SIZE;++i)
+        {
+            file_buffer[i + opointer] = mc_EOF[i];
         }
+        opointer += mc_EOF_BYTE_SIZE;
+
+        // 2.8-防御性断言，确保没有未定义错误
+        MPMT_ASSERT(opointer == c_file_byte_size, "File write operation was unexpectedly interrupted.");
     }
-}
\ No newline at end of file
+}
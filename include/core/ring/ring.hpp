@@ -2,6 +2,7 @@
 #define RING_HPP
 #include <cstdint>
 #include <iostream>
+#include <type_traits>
 /** @namespace 项目命名空间。*/
 namespace mpmt
 {
@@ -60,19 +61,80 @@ namespace mpmt
     /** @typedef 64位环。 */
     using ring64 = uint64_t;
 
+    /**
+     * @class   任意位宽环\mathbb{Z}_{2^K}
+     * @tparam  K 位宽，1 <= K <= 64
+     * @note    1. 单个值以能容纳K位的最小无符号整数（word_type）保存，每次运算后截取低K位。
+     *          2. rvector<ring_k<K>>按K位紧密排列存储（见rvector_packed.hpp），
+     *             逐元素运算展开为word_type后经向量计算后端完成，写回时截取低K位。
+     *          3. K为编译期常量，ring_k仅用于存储与文件（mrvf v2位宽模式）；协议层的份额仍以ring8..ring64计算，
+     *             位宽由运行期的份额位宽决定，经comm_packer紧密打包后传输（见data_holder_ass::set_share_bits()）。
+     */
+    template <unsigned K>
+    class ring_k
+    {
+        static_assert(K >= 1 && K <= 64, "K must be in [1, 64].");
+
+    public:
+        /** @brief 能容纳K位的最小无符号整数 */
+        using word_type =
+            std::conditional_t<(K <= 8), uint8_t,
+            std::conditional_t<(K <= 16), uint16_t,
+            std::conditional_t<(K <= 32), uint32_t, uint64_t>>>;
+
+        static constexpr unsigned mc_BITS = K;                          // 位宽
+        static constexpr uint64_t mc_MASK = ~0ULL >> (64 - K);          // 低K位掩码
+
+        ring_k() noexcept : m_v(0) {}
+        ring_k(uint64_t v) noexcept : m_v(static_cast<word_type>(v & mc_MASK)) {}
+        word_type value() const noexcept { return m_v; }
+        ring_k operator+(const ring_k& other) const noexcept { return ring_k(static_cast<uint64_t>(m_v) + other.m_v); }
+        ring_k operator-(const ring_k& other) const noexcept { return ring_k(static_cast<uint64_t>(m_v) - other.m_v); }
+        ring_k operator*(const ring_k& other) const noexcept { return ring_k(static_cast<uint64_t>(m_v) * other.m_v); }
+        ring_k& operator+=(const ring_k& other) noexcept { return *this = *this + other; }
+        ring_k& operator-=(const ring_k& other) noexcept { return *this = *this - other; }
+        ring_k& operator*=(const ring_k& other) noexcept { return *this = *this * other; }
+        bool operator==(const ring_k& other) const noexcept { return m_v == other.m_v; }
+        bool operator!=(const ring_k& other) const noexcept { return m_v != other.m_v; }
+        friend std::ostream& operator<<(std::ostream& os, const ring_k& r) { return os << static_cast<uint64_t>(r.m_v); }
+
+    private:
+        word_type m_v;
+    };
+
+    /** @namespace 内部实现 */
+    namespace verborgen
+    {
+        template <typename RT>
+        struct is_ring_k_impl : std::false_type {};
+
+        template <unsigned K>
+        struct is_ring_k_impl<ring_k<K>> : std::true_type {};
+    }
+
+    /** @brief 是否为任意位宽环ring_k<K> */
     template<typename RT>
-    constexpr bool is_ring_type =
-        std::is_same_v<RT, ring1> ||
+    constexpr bool is_ring_k = verborgen::is_ring_k_impl<RT>::value;
+
+    /** @brief 是否为以原生无符号整数表示的环（ring8,ring16,ring32,ring64） */
+    template<typename RT>
+    constexpr bool is_word_ring_type =
         std::is_same_v<RT, ring8> ||
         std::is_same_v<RT, ring16> ||
         std::is_same_v<RT, ring32> ||
         std::is_same_v<RT, ring64>;
 
+    template<typename RT>
+    constexpr bool is_ring_type =
+        std::is_same_v<RT, ring1> ||
+        is_word_ring_type<RT> ||
+        is_ring_k<RT>;
+
     template <typename RT>
     inline RT boolean_to_arithmetic(const ring1 x)
     {
         static_assert(
-            is_ring_type<RT> && !std::is_same_v<RT, ring1>,
+            is_word_ring_type<RT>,
             "RT must be ring8, ring16, ring32, or ring64."
             );
 
@@ -83,7 +145,7 @@ namespace mpmt
     inline ring1 arithmetic_to_boolean(const RT x)
     {
         static_assert(
-            is_ring_type<RT> && !std::is_same_v<RT, ring1>,
+            is_word_ring_type<RT>,
             "RT must be ring8, ring16, ring32, or ring64."
             );
 
@@ -94,7 +156,7 @@ namespace mpmt
     RT ring1::fill_bits()
     {
         static_assert(
-            is_ring_type<RT> && !std::is_same_v<RT, ring1>,
+            is_word_ring_type<RT>,
             "RT must be ring8, ring16, ring32, or ring64."
             );
 
@@ -5,6 +5,7 @@
 #include <vector>
 
 #include "core/mpmtcfg.hpp"
+#include "core/numa/numa_memory.hpp"
 #include "core/ring/ring.hpp"
 
 /** @namespace 项目命名空间 */
@@ -17,6 +18,8 @@ namespace mpmt
     /**
      * @class   环上数组统一接口
      * @tparam  RT 环类型，限定为ring1,ring32，ring64
+     * @note    1. 大向量按numa_memory的策略放置，其逐元素运算与求和经numa_pool按节点分区并行执行（见numa_memory）。
+     *          2. ring_k<K>的紧密存储特化见rvector_packed.hpp。
      */
     template <typename RT>
     class rvector
@@ -108,6 +111,21 @@ namespace mpmt
          */
         rvector<RT>& operator*=(const RT scalar);
 
+        /**
+         * @brief   k路融合累加：当前向量 += \sum_j terms[j]
+         * @param   const std::vector<const rvector<RT>*>& terms 加数向量，长度须与当前向量一致
+         * @return  rvector<RT>& 当前向量的引用
+         * @note    按块合并全部加数后写回一次，当前向量只被读写一遍，而非逐个operator+=的k遍。
+         */
+        rvector<RT>& accumulate(const std::vector<const rvector<RT>*>& terms);
+
+        /**
+         * @brief   k路融合哈达玛积：当前向量 *= \prod_j factors[j]
+         * @param   const std::vector<const rvector<RT>*>& factors 乘数向量，长度须与当前向量一致
+         * @return  rvector<RT>& 当前向量的引用
+         */
+        rvector<RT>& multiply(const std::vector<const rvector<RT>*>& factors);
+
         /**
          * @brief   向量重载等于比较操作符
          * @param   const rvector<RT>& other
@@ -134,6 +152,18 @@ namespace mpmt
          */
         uint64_t size() const noexcept;
 
+        /**
+         * @brief   获取底层连续存储的首地址（用于批量拷贝、通信与随机数填充）
+         * @return  RT* 首元素指针，空向量返回nullptr
+         */
+        RT* data() noexcept;
+
+        /**
+         * @brief   获取底层连续存储的常量首地址
+         * @return  const RT* 首元素指针，空向量返回nullptr
+         */
+        const RT* data() const noexcept;
+
         /**
          * @brief   析构接口
          * @param   void
@@ -142,7 +172,7 @@ namespace mpmt
         ~rvector();
 
     private:
-        std::unique_ptr<RT[]> m_data;
+        numa_memory::array<RT> m_data;
         uint64_t m_size;
 
         /** @brief 禁用大于运算符 */
@@ -165,4 +195,6 @@ extern template class mpmt::rvector<mpmt::ring16>;
 extern template class mpmt::rvector<mpmt::ring32>;
 extern template class mpmt::rvector<mpmt::ring64>;
 
+#include "core/ring/rvector_packed.hpp"
+
 #endif // !RVECTOR_HPP
@@ -0,0 +1,219 @@
+#ifndef RVECTOR_PACKED_HPP
+#define RVECTOR_PACKED_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "core/numa/numa_memory.hpp"
+#include "core/ring/ring.hpp"
+#include "core/ring/rvector.hpp"
+
+/** @namespace 项目命名空间 */
+namespace mpmt
+{
+    /**
+     * @class   任意位宽环上数组：rvector<ring_k<K>>的紧密存储特化
+     * @tparam  K 位宽，1 <= K <= 64
+     * @note    1. 第i个元素占据位流的[i*K, (i+1)*K)位，位流按64位字小端存放，末字的填充位恒为0，
+     *             因此存储为ceil(n*K/64)个字，相等比较直接比较存储字。
+     *          2. 逐元素运算每次展开mc_CHUNK个元素为word_type，经vcb_dispatch的内核计算后截取低K位写回；
+     *             K为8、16、32、64时存储与原生数组一致，直接在存储上调用内核，无需展开与截取。
+     *          3. 下标访问返回值或代理对象，不提供元素引用；经data()直接写入存储时须保持填充位为0。
+     *          4. 存储经numa_memory分配，运算在当前线程执行。
+     */
+    template <unsigned K>
+    class rvector<ring_k<K>>
+    {
+    public:
+        friend class mrvf_handler<ring_k<K>>;
+
+        using value_type = ring_k<K>;                               // 元素类型
+        using word_type = typename ring_k<K>::word_type;            // 展开计算时的元素类型
+
+        /** @brief 可写下标访问的代理 */
+        class reference
+        {
+        public:
+            operator value_type() const noexcept { return m_owner.get(m_index); }
+            reference& operator=(const value_type value) noexcept { m_owner.set(m_index, value); return *this; }
+            reference& operator=(const reference& other) noexcept { return *this = static_cast<value_type>(other); }
+
+        private:
+            friend class rvector;
+            reference(rvector& owner, uint64_t index) noexcept : m_owner(owner), m_index(index) {}
+
+            rvector& m_owner;       // 所属向量
+            uint64_t m_index;       // 元素下标
+        };
+
+        rvector();                                          // 默认构造
+        explicit rvector(uint64_t n);                       // 指定大小构造
+        rvector(uint64_t n, const value_type value);        // 指定大小 + 默认值构造
+        rvector(const std::vector<value_type>& list);       // 列表构造
+        rvector(const rvector& other);                      // 拷贝构造
+        rvector(rvector&& other) noexcept;                  // 移动构造
+
+        /**
+         * @brief   拷贝赋值
+         * @param   const rvector& other 拷贝对象
+         * @return  rvector& 当前向量的引用
+         */
+        rvector& operator=(const rvector& other);
+
+        /**
+         * @brief   移动赋值
+         * @param   rvector&& other 移动对象
+         * @return  rvector& 当前向量的引用
+         */
+        rvector& operator=(rvector&& other) noexcept;
+
+        /**
+         * @brief   下标访问运算符
+         * @param   uint64_t index 索引位置
+         * @return  reference 对应位置的代理对象
+         */
+        reference operator[](uint64_t index);
+
+        /**
+         * @brief   常量下标访问运算符
+         * @param   uint64_t index 索引位置
+         * @return  value_type 对应位置的元素值
+         */
+        value_type operator[](uint64_t index) const;
+
+        /**
+         * @brief   读取元素（不检查下标）
+         * @param   uint64_t index 索引位置
+         * @return  value_type 元素值
+         */
+        value_type get(uint64_t index) const noexcept;
+
+        /**
+         * @brief   写入元素（不检查下标）
+         * @param   uint64_t index 索引位置
+         * @param   const value_type value 元素值
+         * @return  void
+         */
+        void set(uint64_t index, const value_type value) noexcept;
+
+        /**
+         * @brief   向量-向量加法
+         * @param   const rvector& other 要相加的向量
+         * @return  rvector& 当前向量的引用
+         */
+        rvector& operator+=(const rvector& other);
+
+        /**
+         * @brief   向量-标量加法
+         * @param   const value_type scalar 要相加的标量
+         * @return  rvector& 当前向量的引用
+         */
+        rvector& operator+=(const value_type scalar);
+
+        /**
+         * @brief   向量-向量减法
+         * @param   const rvector& other 要相减的向量
+         * @return  rvector& 当前向量的引用
+         */
+        rvector& operator-=(const rvector& other);
+
+        /**
+         * @brief   向量-标量减法
+         * @param   const value_type scalar 要相减的标量
+         * @return  rvector& 当前向量的引用
+         */
+        rvector& operator-=(const value_type scalar);
+
+        /**
+         * @brief   向量哈达玛积
+         * @param   const rvector& other 要相乘的向量
+         * @return  rvector& 当前向量的引用
+         */
+        rvector& operator*=(const rvector& other);
+
+        /**
+         * @brief   向量-标量乘法
+         * @param   const value_type scalar 要相乘的标量
+         * @return  rvector& 当前向量的引用
+         */
+        rvector& operator*=(const value_type scalar);
+
+        /**
+         * @brief   向量重载等于比较操作符
+         * @param   const rvector& other
+         * @return  bool 比较结果
+         */
+        bool operator==(const rvector& other) const;
+
+        /**
+         * @brief   向量重载不等比较操作符
+         * @param   const rvector& other
+         * @return  bool 比较结果
+         */
+        bool operator!=(const rvector& other) const;
+
+        /**
+         * @brief   获取向量和
+         * @return  value_type 环上向量和
+         */
+        value_type reduce() const noexcept;
+
+        /**
+         * @brief   获取向量大小
+         * @return  uint64_t 元素个数
+         */
+        uint64_t size() const noexcept { return m_size; }
+
+        /**
+         * @brief   获取紧密存储的首地址（用于批量拷贝与通信）
+         * @return  uint64_t* 首个存储字，空向量返回nullptr
+         */
+        uint64_t* data() noexcept { return m_data.get(); }
+
+        /**
+         * @brief   获取紧密存储的常量首地址
+         * @return  const uint64_t* 首个存储字，空向量返回nullptr
+         */
+        const uint64_t* data() const noexcept { return m_data.get(); }
+
+        /**
+         * @brief   获取紧密存储中有效数据的字节数
+         * @return  uint64_t ceil(size() * K / 8)
+         */
+        uint64_t packed_bytes() const noexcept { return (m_size * K + 7) / 8; }
+
+        ~rvector() = default;
+
+    private:
+        static constexpr uint64_t mc_CHUNK = 512;   // 每次展开的元素数，mc_CHUNK * K为64的倍数，各段起点对齐到存储字
+
+        numa_memory::array<uint64_t> m_data;        // 紧密存储
+        uint64_t m_size;                            // 元素个数
+
+        /** @brief n个元素所需的存储字数 */
+        static uint64_t words(uint64_t n) noexcept { return (n * K + 63) / 64; }
+
+        /** @brief 读取位流中自第bit位起的K位 */
+        static uint64_t extract(const uint64_t* words, uint64_t bit) noexcept;
+
+        /** @brief 将自对齐起点的n个元素展开到out */
+        static void unpack(const uint64_t* words, word_type* out, uint64_t n) noexcept;
+
+        /** @brief 将n个元素截取低K位后写入自对齐起点的存储（覆盖对应的全部存储字） */
+        static void pack(const word_type* in, uint64_t* words, uint64_t n) noexcept;
+
+        /** @brief 逐段展开后执行fn(dst, src, count)并写回，other为空时src无意义 */
+        template <typename FN>
+        void transform(const rvector* other, FN&& fn);
+
+        /** @brief 禁用大小比较运算符 */
+        bool operator>(const rvector& other) const = delete;
+        bool operator<(const rvector& other) const = delete;
+        bool operator>=(const rvector& other) const = delete;
+        bool operator<=(const rvector& other) const = delete;
+    };
+}
+
+#include "core/ring/rvector_packed.tpp"
+
+#endif // !RVECTOR_PACKED_HPP
@@ -0,0 +1,306 @@
+#include <algorithm>
+
+#include "auxkit/profiler.hpp"
+#include "core/mpmtcfg.hpp"
+#include "core/ring/vcb/vcb_dispatch.hpp"
+
+namespace mpmt
+{
+    template <unsigned K>
+    rvector<ring_k<K>>::rvector() :
+        m_data(nullptr),
+        m_size(0)
+    {}
+
+    template <unsigned K>
+    rvector<ring_k<K>>::rvector(uint64_t n) :
+        m_data(numa_memory::make<uint64_t>(words(n))),
+        m_size(n)
+    {}
+
+    template <unsigned K>
+    rvector<ring_k<K>>::rvector(uint64_t n, const value_type value) :
+        rvector(n)
+    {
+        // 新分配的存储已全零，仅非零初值需要填充
+        if (value != value_type(0))
+        {
+            transform(nullptr, [value](word_type* dst, const word_type*, uint64_t count)
+            {
+                std::fill(dst, dst + count, value.value());
+            });
+        }
+    }
+
+    template <unsigned K>
+    rvector<ring_k<K>>::rvector(const std::vector<value_type>& list) :
+        rvector(list.size())
+    {
+        for (uint64_t i = 0; i < m_size; ++i)
+        {
+            set(i, list[i]);
+        }
+    }
+
+    template <unsigned K>
+    rvector<ring_k<K>>::rvector(const rvector& other) :
+        rvector(other.m_size)
+    {
+        std::copy(other.m_data.get(), other.m_data.get() + words(m_size), m_data.get());
+    }
+
+    template <unsigned K>
+    rvector<ring_k<K>>::rvector(rvector&& other) noexcept :
+        m_data(std::move(other.m_data)),
+        m_size(other.m_size)
+    {
+        other.m_size = 0;
+    }
+
+    template <unsigned K>
+    rvector<ring_k<K>>& rvector<ring_k<K>>::operator=(const rvector& other)
+    {
+        if (this != &other)
+        {
+            if (m_size != other.m_size)
+            {
+                rvector temp(other);
+                std::swap(m_data, temp.m_data);
+                std::swap(m_size, temp.m_size);
+            }
+            else
+            {
+                std::copy(other.m_data.get(), other.m_data.get() + words(m_size), m_data.get());
+            }
+        }
+        return *this;
+    }
+
+    template <unsigned K>
+    rvector<ring_k<K>>& rvector<ring_k<K>>::operator=(rvector&& other) noexcept
+    {
+        if (this != &other)
+        {
+            m_data = std::move(other.m_data);
+            m_size = other.m_size;
+            other.m_size = 0;
+        }
+        return *this;
+    }
+
+    template <unsigned K>
+    typename rvector<ring_k<K>>::reference rvector<ring_k<K>>::operator[](uint64_t index)
+    {
+        MPMT_ASSERT(index < m_size, "Index out of range.");
+        return reference(*this, index);
+    }
+
+    template <unsigned K>
+    ring_k<K> rvector<ring_k<K>>::operator[](uint64_t index) const
+    {
+        MPMT_ASSERT(index < m_size, "Index out of range.");
+        return get(index);
+    }
+
+    template <unsigned K>
+    ring_k<K> rvector<ring_k<K>>::get(uint64_t index) const noexcept
+    {
+        return value_type(extract(m_data.get(), index * K));
+    }
+
+    template <unsigned K>
+    void rvector<ring_k<K>>::set(uint64_t index, const value_type value) noexcept
+    {
+        const uint64_t c_bit = index * K;
+        const uint64_t c_value = value.value();
+        const unsigned c_shift = static_cast<unsigned>(c_bit % 64);
+        uint64_t* const word = m_data.get() + c_bit / 64;
+        word[0] = (word[0] & ~(ring_k<K>::mc_MASK << c_shift)) | (c_value << c_shift);
+        if (c_shift + K > 64)
+        {
+            const unsigned c_low = 64 - c_shift;
+            word[1] = (word[1] & ~(ring_k<K>::mc_MASK >> c_low)) | (c_value >> c_low);
+        }
+    }
+
+    template <unsigned K>
+    rvector<ring_k<K>>& rvector<ring_k<K>>::operator+=(const rvector& other)
+    {
+        MPMT_PROF_COUNT(RVECTOR_ELEMENTS, m_size);
+        MPMT_ASSERT(m_size == other.m_size, "Vector dimension mismatch for addition.");
+        transform(&other, [](word_type* dst, const word_type* src, uint64_t count)
+        {
+            vcb_dispatch::kernels<word_type>().m_add(dst, src, count);
+        });
+        return *this;
+    }
+
+    template <unsigned K>
+    rvector<ring_k<K>>& rvector<ring_k<K>>::operator+=(const value_type scalar)
+    {
+        MPMT_PROF_COUNT(RVECTOR_ELEMENTS, m_size);
+        transform(nullptr, [scalar](word_type* dst, const word_type*, uint64_t count)
+        {
+            vcb_dispatch::kernels<word_type>().m_add_scalar(dst, scalar.value(), count);
+        });
+        return *this;
+    }
+
+    template <unsigned K>
+    rvector<ring_k<K>>& rvector<ring_k<K>>::operator-=(const rvector& other)
+    {
+        MPMT_PROF_COUNT(RVECTOR_ELEMENTS, m_size);
+        MPMT_ASSERT(m_size == other.m_size, "Vector dimension mismatch for subtraction.");
+        transform(&other, [](word_type* dst, const word_type* src, uint64_t count)
+        {
+            vcb_dispatch::kernels<word_type>().m_sub(dst, src, count);
+        });
+        return *this;
+    }
+
+    template <unsigned K>
+    rvector<ring_k<K>>& rvector<ring_k<K>>::operator-=(const value_type scalar)
+    {
+        MPMT_PROF_COUNT(RVECTOR_ELEMENTS, m_size);
+        transform(nullptr, [scalar](word_type* dst, const word_type*, uint64_t count)
+        {
+            vcb_dispatch::kernels<word_type>().m_sub_scalar(dst, scalar.value(), count);
+        });
+        return *this;
+    }
+
+    template <unsigned K>
+    rvector<ring_k<K>>& rvector<ring_k<K>>::operator*=(const rvector& other)
+    {
+        MPMT_PROF_COUNT(RVECTOR_ELEMENTS, m_size);
+        MPMT_ASSERT(m_size == other.m_size, "Vector dimension mismatch for multiplication.");
+        transform(&other, [](word_type* dst, const word_type* src, uint64_t count)
+        {
+            vcb_dispatch::kernels<word_type>().m_mul(dst, src, count);
+        });
+        return *this;
+    }
+
+    template <unsigned K>
+    rvector<ring_k<K>>& rvector<ring_k<K>>::operator*=(const value_type scalar)
+    {
+        MPMT_PROF_COUNT(RVECTOR_ELEMENTS, m_size);
+        transform(nullptr, [scalar](word_type* dst, const word_type*, uint64_t count)
+        {
+            vcb_dispatch::kernels<word_type>().m_mul_scalar(dst, scalar.value(), count);
+        });
+        return *this;
+    }
+
+    template <unsigned K>
+    bool rvector<ring_k<K>>::operator==(const rvector& other) const
+    {
+        // 填充位恒为0，逐字比较即逐元素比较
+        return m_size == other.m_size
+            && std::equal(m_data.get(), m_data.get() + words(m_size), other.m_data.get());
+    }
+
+    template <unsigned K>
+    bool rvector<ring_k<K>>::operator!=(const rvector& other) const
+    {
+        return !(*this == other);
+    }
+
+    template <unsigned K>
+    ring_k<K> rvector<ring_k<K>>::reduce() const noexcept
+    {
+        MPMT_PROF_COUNT(RVECTOR_ELEMENTS, m_size);
+        const vcb_kernels<word_type>& c_kernels = vcb_dispatch::kernels<word_type>();
+        if constexpr (K == 8 * sizeof(word_type))
+        {
+            return value_type(c_kernels.m_reduce(reinterpret_cast<const word_type*>(m_data.get()), m_size));
+        }
+        else
+        {
+            // 按word_type回绕求和，模2^K的结果为其低K位，仅在最后截取一次
+            word_type buffer[mc_CHUNK];
+            word_type reduction = 0;
+            for (uint64_t first = 0; first < m_size; first += mc_CHUNK)
+            {
+                const uint64_t c_count = std::min(mc_CHUNK, m_size - first);
+                unpack(m_data.get() + first * K / 64, buffer, c_count);
+                reduction = static_cast<word_type>(reduction + c_kernels.m_reduce(buffer, c_count));
+            }
+            return value_type(reduction);
+        }
+    }
+
+    template <unsigned K>
+    uint64_t rvector<ring_k<K>>::extract(const uint64_t* words, uint64_t bit) noexcept
+    {
+        const unsigned c_shift = static_cast<unsigned>(bit % 64);
+        const uint64_t* const word = words + bit / 64;
+        uint64_t value = word[0] >> c_shift;
+        if (c_shift + K > 64)
+        {
+            value |= word[1] << (64 - c_shift);
+        }
+        return value & ring_k<K>::mc_MASK;
+    }
+
+    template <unsigned K>
+    void rvector<ring_k<K>>::unpack(const uint64_t* words, word_type* out, uint64_t n) noexcept
+    {
+        for (uint64_t i = 0; i < n; ++i)
+        {
+            out[i] = static_cast<word_type>(extract(words, i * K));
+        }
+    }
+
+    template <unsigned K>
+    void rvector<ring_k<K>>::pack(const word_type* in, uint64_t* words, uint64_t n) noexcept
+    {
+        // 段起点对齐到存储字且段长为整字（末段除外，其后只有填充位），可先清零再逐元素或入
+        std::fill(words, words + rvector::words(n), 0);
+        for (uint64_t i = 0; i < n; ++i)
+        {
+            const uint64_t c_bit = i * K;
+            const uint64_t c_value = static_cast<uint64_t>(in[i]) & ring_k<K>::mc_MASK;
+            const unsigned c_shift = static_cast<unsigned>(c_bit % 64);
+            words[c_bit / 64] |= c_value << c_shift;
+            if (c_shift + K > 64)
+            {
+                words[c_bit / 64 + 1] |= c_value >> (64 - c_shift);
+            }
+        }
+    }
+
+    template <unsigned K>
+    template <typename FN>
+    void rvector<ring_k<K>>::transform(const rvector* other, FN&& fn)
+    {
+        if constexpr (K == 8 * sizeof(word_type))
+        {
+            // 1-原生位宽：存储即word_type数组，回绕即取模
+            fn
+            (
+                reinterpret_cast<word_type*>(m_data.get()),
+                other != nullptr ? reinterpret_cast<const word_type*>(other->m_data.get()) : nullptr,
+                m_size
+            );
+        }
+        else
+        {
+            // 2-其余位宽：逐段展开、计算并截取写回
+            word_type lhs[mc_CHUNK];
+            word_type rhs[mc_CHUNK];
+            for (uint64_t first = 0; first < m_size; first += mc_CHUNK)
+            {
+                const uint64_t c_count = std::min(mc_CHUNK, m_size - first);
+                uint64_t* const words = m_data.get() + first * K / 64;
+                unpack(words, lhs, c_count);
+                if (other != nullptr)
+                {
+                    unpack(other->m_data.get() + first * K / 64, rhs, c_count);
+                }
+                fn(lhs, rhs, c_count);
+                pack(lhs, words, c_count);
+            }
+        }
+    }
+}
@@ -0,0 +1,115 @@
+#ifndef VCB_DISPATCH_HPP
+#define VCB_DISPATCH_HPP
+
+#include <atomic>
+#include <string>
+
+#include "core/ring/vcb/vcb_kernels.hpp"
+
+/** @namespace 项目命名空间 */
+namespace mpmt
+{
+    /** @brief CPU向量计算后端所用的指令集，按性能由低到高排列 */
+    enum class vcb_isa : uint8_t
+    {
+        GENERIC = 0,    // 构建基线指令集（非x86-64平台仅此一项）
+        SSE42 = 1,      // SSE4.2
+        AVX2 = 2,       // AVX2
+        AVX512 = 3,     // AVX-512F + AVX-512BW
+    };
+
+    /**
+     * @class   向量计算后端的运行时分派
+     * @note    1. 全部CPU内核编入同一二进制，首次使用时按CPUID选择当前CPU支持的最高指令集。
+     *          2. 环境变量MPMT_VCB（generic、sse4.2、avx2、avx512）或select()可覆盖自动选择。
+     *          3. select()应在启动阶段、向量运算开始之前调用；切换本身是原子的，但不与进行中的运算同步。
+     */
+    class vcb_dispatch
+    {
+    public:
+        /**
+         * @brief   获取当前选用的指令集
+         * @return  vcb_isa 指令集
+         */
+        static vcb_isa active() noexcept;
+
+        /**
+         * @brief   检测当前CPU与构建所支持的最高指令集
+         * @return  vcb_isa 指令集
+         */
+        static vcb_isa detect() noexcept;
+
+        /**
+         * @brief   判断当前CPU与构建是否支持指定指令集
+         * @param   vcb_isa isa 指令集
+         * @return  bool 是否支持
+         */
+        static bool supported(vcb_isa isa) noexcept;
+
+        /**
+         * @brief   指定使用的指令集
+         * @param   vcb_isa isa 指令集
+         * @return  void
+         * @throw   vcb_exc 当前CPU或构建不支持该指令集
+         */
+        static void select(vcb_isa isa);
+
+        /**
+         * @brief   按名称指定使用的指令集，"auto"表示恢复自动选择
+         * @param   const std::string& name 指令集名称，不区分大小写
+         * @return  void
+         * @throw   vcb_exc 名称无法识别或不受支持
+         */
+        static void select(const std::string& name);
+
+        /**
+         * @brief   获取指令集名称
+         * @param   vcb_isa isa 指令集
+         * @return  const char* 名称
+         */
+        static const char* name(vcb_isa isa) noexcept;
+
+        /**
+         * @brief   获取当前选用指令集下的内核表
+         * @tparam  RT 环类型，限定为ring8,ring16,ring32,ring64
+         * @return  const vcb_kernels<RT>& 内核表
+         */
+        template <typename RT>
+        static const vcb_kernels<RT>& kernels() noexcept;
+
+    private:
+        static constexpr uint8_t mc_UNSET = 0xFF;                       // 尚未完成首次选择
+        static std::atomic<uint8_t> s_active;                           // 当前选用的指令集
+
+        /** @brief 首次使用时读取MPMT_VCB环境变量或自动检测 */
+        static vcb_isa initialize() noexcept;
+
+        /** @brief 名称解析，无法识别时返回false */
+        static bool parse(const std::string& name, vcb_isa& isa);
+    };
+
+    template <typename RT>
+    const vcb_kernels<RT>& vcb_dispatch::kernels() noexcept
+    {
+        static_assert(
+            is_word_ring_type<RT>,
+            "RT must be ring8, ring16, ring32, or ring64."
+            );
+
+        switch (active())
+        {
+#if defined(__x86_64__)
+        case vcb_isa::AVX512:
+            return verborgen::vcb_avx512::table<RT>();
+        case vcb_isa::AVX2:
+            return verborgen::vcb_avx2::table<RT>();
+        case vcb_isa::SSE42:
+            return verborgen::vcb_sse42::table<RT>();
+#endif
+        default:
+            return verborgen::vcb_generic::table<RT>();
+        }
+    }
+}
+
+#endif // !VCB_DISPATCH_HPP
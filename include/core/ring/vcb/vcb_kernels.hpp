@@ -0,0 +1,43 @@
+#ifndef VCB_KERNELS_HPP
+#define VCB_KERNELS_HPP
+
+#include <cstdint>
+
+#include "core/ring/ring.hpp"
+
+/** @namespace 项目命名空间 */
+namespace mpmt
+{
+    /**
+     * @struct  向量计算内核表：一组指令集下rvector<RT>逐元素运算的实现
+     * @tparam  RT 环类型，限定为ring8,ring16,ring32,ring64
+     * @note    1. 所有内核允许dst与src相同；长度为0时不访问指针。
+     *          2. k路融合内核按mc_FUSE_TILE_BYTES分块，每块先在局部缓存区合并全部k个输入再写回一次，
+     *             dst只被读写一遍，各输入各读一遍。
+     */
+    template <typename RT>
+    struct vcb_kernels
+    {
+        void (*m_add)(RT* dst, const RT* src, uint64_t n) noexcept;         // dst[i] += src[i]
+        void (*m_add_scalar)(RT* dst, RT scalar, uint64_t n) noexcept;      // dst[i] += scalar
+        void (*m_sub)(RT* dst, const RT* src, uint64_t n) noexcept;         // dst[i] -= src[i]
+        void (*m_sub_scalar)(RT* dst, RT scalar, uint64_t n) noexcept;      // dst[i] -= scalar
+        void (*m_mul)(RT* dst, const RT* src, uint64_t n) noexcept;         // dst[i] *= src[i]
+        void (*m_mul_scalar)(RT* dst, RT scalar, uint64_t n) noexcept;      // dst[i] *= scalar
+        bool (*m_equal)(const RT* a, const RT* b, uint64_t n) noexcept;     // a == b
+        RT (*m_reduce)(const RT* src, uint64_t n) noexcept;                 // \sum src[i]
+        void (*m_add_many)(RT* dst, const RT* const* srcs, uint64_t k, uint64_t n) noexcept;   // dst[i] += \sum_j srcs[j][i]
+        void (*m_mul_many)(RT* dst, const RT* const* srcs, uint64_t k, uint64_t n) noexcept;   // dst[i] *= \prod_j srcs[j][i]
+    };
+
+    /** @namespace 内部实现，各指令集的内核表分别编译于独立的翻译单元 */
+    namespace verborgen
+    {
+        namespace vcb_generic { template <typename RT> const vcb_kernels<RT>& table() noexcept; }
+        namespace vcb_sse42   { template <typename RT> const vcb_kernels<RT>& table() noexcept; }
+        namespace vcb_avx2    { template <typename RT> const vcb_kernels<RT>& table() noexcept; }
+        namespace vcb_avx512  { template <typename RT> const vcb_kernels<RT>& table() noexcept; }
+    }
+}
+
+#endif // !VCB_KERNELS_HPP
@@ -0,0 +1,216 @@
+/**
+ * @file    向量计算内核的公共实现
+ * @note    1. 仅供src/core/ring/vcb/下的各指令集翻译单元包含，包含前需定义MPMT_VCB_KERNEL_NS。
+ *          2. 同一份循环以不同的目标指令集编译（见CMakeLists.txt），由编译器完成向量化；
+ *             各翻译单元位于不同命名空间，避免同名模板实例在链接时被合并。
+ */
+#ifndef MPMT_VCB_KERNEL_NS
+#error "MPMT_VCB_KERNEL_NS must be defined before including vcb_kernels.tpp."
+#endif
+
+#include <type_traits>
+
+#include "core/ring/vcb/vcb_kernels.hpp"
+
+namespace mpmt::verborgen::MPMT_VCB_KERNEL_NS
+{
+    namespace
+    {
+        constexpr uint64_t mc_EQUAL_BLOCK = 1024;      // 比较内核每块的元素个数，块内无分支以便向量化
+        constexpr uint64_t mc_FUSE_TILE_BYTES = 4096;  // 融合内核每块的字节数，块内累加结果常驻L1
+
+        // 乘法的运算类型：窄类型先提升为unsigned再相乘，避免整型提升为int后的有符号溢出（如ring16的65535 * 65535）
+        template <typename RT>
+        using wide_t = std::conditional_t<(sizeof(RT) < sizeof(unsigned)), unsigned, RT>;
+
+        template <typename RT>
+        void add(RT* dst, const RT* src, uint64_t n) noexcept
+        {
+            for (uint64_t i = 0; i < n; ++i)
+            {
+                dst[i] += src[i];
+            }
+        }
+
+        template <typename RT>
+        void add_scalar(RT* dst, RT scalar, uint64_t n) noexcept
+        {
+            for (uint64_t i = 0; i < n; ++i)
+            {
+                dst[i] += scalar;
+            }
+        }
+
+        template <typename RT>
+        void sub(RT* dst, const RT* src, uint64_t n) noexcept
+        {
+            for (uint64_t i = 0; i < n; ++i)
+            {
+                dst[i] -= src[i];
+            }
+        }
+
+        template <typename RT>
+        void sub_scalar(RT* dst, RT scalar, uint64_t n) noexcept
+        {
+            for (uint64_t i = 0; i < n; ++i)
+            {
+                dst[i] -= scalar;
+            }
+        }
+
+        template <typename RT>
+        void mul(RT* dst, const RT* src, uint64_t n) noexcept
+        {
+            for (uint64_t i = 0; i < n; ++i)
+            {
+                dst[i] = static_cast<RT>(static_cast<wide_t<RT>>(dst[i]) * static_cast<wide_t<RT>>(src[i]));
+            }
+        }
+
+        template <typename RT>
+        void mul_scalar(RT* dst, RT scalar, uint64_t n) noexcept
+        {
+            for (uint64_t i = 0; i < n; ++i)
+            {
+                dst[i] = static_cast<RT>(static_cast<wide_t<RT>>(dst[i]) * static_cast<wide_t<RT>>(scalar));
+            }
+        }
+
+        template <typename RT>
+        bool equal(const RT* a, const RT* b, uint64_t n) noexcept
+        {
+            for (uint64_t base = 0; base < n; base += mc_EQUAL_BLOCK)
+            {
+                const uint64_t c_end = (n - base < mc_EQUAL_BLOCK) ? n : base + mc_EQUAL_BLOCK;
+                RT diff = 0;
+                for (uint64_t i = base; i < c_end; ++i)
+                {
+                    diff |= static_cast<RT>(a[i] ^ b[i]);
+                }
+                if (diff != 0)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        template <typename RT>
+        RT reduce(const RT* src, uint64_t n) noexcept
+        {
+            RT reduction = 0;
+            for (uint64_t i = 0; i < n; ++i)
+            {
+                reduction += src[i];
+            }
+            return reduction;
+        }
+
+        template <typename RT>
+        void add_many(RT* dst, const RT* const* srcs, uint64_t k, uint64_t n) noexcept
+        {
+            constexpr uint64_t c_tile = mc_FUSE_TILE_BYTES / sizeof(RT);
+            RT acc[c_tile];
+            for (uint64_t base = 0; base < n; base += c_tile)
+            {
+                const uint64_t c_len = (n - base < c_tile) ? n - base : c_tile;
+                for (uint64_t i = 0; i < c_len; ++i)
+                {
+                    acc[i] = dst[base + i];
+                }
+
+                // 每次合并4个输入，减少对累加块的读写
+                uint64_t j = 0;
+                for (; j + 4 <= k; j += 4)
+                {
+                    const RT* const s0 = srcs[j] + base;
+                    const RT* const s1 = srcs[j + 1] + base;
+                    const RT* const s2 = srcs[j + 2] + base;
+                    const RT* const s3 = srcs[j + 3] + base;
+                    for (uint64_t i = 0; i < c_len; ++i)
+                    {
+                        acc[i] += static_cast<RT>(static_cast<RT>(s0[i] + s1[i]) + static_cast<RT>(s2[i] + s3[i]));
+                    }
+                }
+                for (; j < k; ++j)
+                {
+                    const RT* const s = srcs[j] + base;
+                    for (uint64_t i = 0; i < c_len; ++i)
+                    {
+                        acc[i] += s[i];
+                    }
+                }
+
+                for (uint64_t i = 0; i < c_len; ++i)
+                {
+                    dst[base + i] = acc[i];
+                }
+            }
+        }
+
+        template <typename RT>
+        void mul_many(RT* dst, const RT* const* srcs, uint64_t k, uint64_t n) noexcept
+        {
+            using wide = wide_t<RT>;
+            constexpr uint64_t c_tile = mc_FUSE_TILE_BYTES / sizeof(RT);
+            RT acc[c_tile];
+            for (uint64_t base = 0; base < n; base += c_tile)
+            {
+                const uint64_t c_len = (n - base < c_tile) ? n - base : c_tile;
+                for (uint64_t i = 0; i < c_len; ++i)
+                {
+                    acc[i] = dst[base + i];
+                }
+
+                uint64_t j = 0;
+                for (; j + 2 <= k; j += 2)
+                {
+                    const RT* const s0 = srcs[j] + base;
+                    const RT* const s1 = srcs[j + 1] + base;
+                    for (uint64_t i = 0; i < c_len; ++i)
+                    {
+                        acc[i] = static_cast<RT>(static_cast<wide>(acc[i]) * static_cast<wide>(s0[i]) * static_cast<wide>(s1[i]));
+                    }
+                }
+                for (; j < k; ++j)
+                {
+                    const RT* const s = srcs[j] + base;
+                    for (uint64_t i = 0; i < c_len; ++i)
+                    {
+                        acc[i] = static_cast<RT>(static_cast<wide>(acc[i]) * static_cast<wide>(s[i]));
+                    }
+                }
+
+                for (uint64_t i = 0; i < c_len; ++i)
+                {
+                    dst[base + i] = acc[i];
+                }
+            }
+        }
+    }
+
+    template <typename RT>
+    const vcb_kernels<RT>& table() noexcept
+    {
+        static const vcb_kernels<RT> sc_table =
+        {
+            &add<RT>,
+            &add_scalar<RT>,
+            &sub<RT>,
+            &sub_scalar<RT>,
+            &mul<RT>,
+            &mul_scalar<RT>,
+            &equal<RT>,
+            &reduce<RT>,
+            &add_many<RT>,
+            &mul_many<RT>,
+        };
+        return sc_table;
+    }
+
+    template const vcb_kernels<ring8>& table<ring8>() noexcept;
+    template const vcb_kernels<ring16>& table<ring16>() noexcept;
+    template const vcb_kernels<ring32>& table<ring32>() noexcept;
+    template const vcb_kernels<ring64>& table<ring64>() noexcept;
+}
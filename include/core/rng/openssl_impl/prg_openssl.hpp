@@ -0,0 +1,65 @@
+#ifndef PRG_OPENSSL_HPP
+#define PRG_OPENSSL_HPP
+
+#include <array>
+#include <cstdint>
+#include <openssl/evp.h>
+
+
+/** @namespace 项目命名空间。 */
+namespace mpmt
+{
+    /**
+     * @class   使用openssl AES-128-CTR实现的种子伪随机数生成器
+     * @note    1. 相同种子的输出流是确定的，用于种子压缩的秘密分享。
+     *          2. CTR模式支持随机访问，可从任意字节偏移开始按块展开，无需生成前缀。
+     *          3. 每个种子只能用于一条输出流（计数器从0开始，IV不额外携带nonce）。
+     * @throw   throw mpmt::rng_exc(rng_exc::impl_type::OPENSSL, "") 伪随机数生成错误
+     */
+    class prg_openssl
+    {
+    public:
+        static constexpr uint64_t mc_SEED_BYTE_SIZE = 16ULL;     // 种子长度（AES-128密钥）
+        static constexpr uint64_t mc_BLOCK_BYTE_SIZE = 16ULL;    // AES分组长度
+
+        using seed_type = std::array<uint8_t, mc_SEED_BYTE_SIZE>;
+
+        /**
+         * @brief   以种子构造伪随机数生成器。
+         * @param   const seed_type& seed 种子
+         */
+        explicit prg_openssl(const seed_type& seed);
+
+        /**
+         * @brief   使用openssl真随机数生成新的种子。
+         * @return  seed_type 种子
+         */
+        static seed_type fresh_seed();
+
+        /**
+         * @brief   从输出流的byte_offset处开始写出len字节伪随机数。
+         * @param   uint64_t byte_offset 输出流中的起始字节偏移
+         * @param   uint8_t* out 输出缓存区
+         * @param   uint64_t len 输出长度（字节）
+         * @return  void
+         */
+        void fill(uint64_t byte_offset, uint8_t* out, uint64_t len) const;
+
+        /**
+         * @brief   析构接口。
+         */
+        ~prg_openssl();
+
+    private:
+        seed_type m_seed;               // 种子
+        EVP_CIPHER_CTX* m_ctx;          // 加密上下文（复用以避免重复分配）
+
+        /** @brief 禁用拷贝与移动操作 */
+        prg_openssl(const prg_openssl&) = delete;
+        prg_openssl& operator=(const prg_openssl&) = delete;
+    };
+}
+
+#include "core/rng/openssl_impl/prg_openssl.tpp"
+
+#endif // !PRG_OPENSSL_HPP
@@ -0,0 +1,105 @@
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <openssl/rand.h>
+#include "auxkit/profiler.hpp"
+#include "core/mpmtcfg.hpp"
+#include "core/exception/rng_exc.hpp"
+
+/** @namespace 项目命名空间。 */
+namespace mpmt
+{
+	inline prg_openssl::prg_openssl(const seed_type& seed)
+		:
+		m_seed(seed),
+		m_ctx(EVP_CIPHER_CTX_new())
+	{
+		if (m_ctx == nullptr)
+		{
+			throw mpmt::rng_exc
+			(
+				rng_exc::impl_type::OPENSSL,
+				"failed to allocate the PRG cipher context."
+			);
+		}
+	}
+
+	inline prg_openssl::seed_type prg_openssl::fresh_seed()
+	{
+		seed_type seed{};
+		if (RAND_bytes(seed.data(), static_cast<int>(seed.size())) != 1)
+		{
+			throw mpmt::rng_exc
+			(
+				rng_exc::impl_type::OPENSSL,
+				"random number generation failed, low entropy or internal error."
+			);
+		}
+		return seed;
+	}
+
+	inline void prg_openssl::fill(uint64_t byte_offset, uint8_t* out, uint64_t len) const
+	{
+		if (len == 0)
+		{
+			return;
+		}
+		MPMT_PROF_SCOPE("prg_openssl::fill");
+		MPMT_PROF_COUNT(RNG_BYTES, len);
+
+		// 1-由字节偏移计算起始计数器（大端128位）与块内偏移
+		const uint64_t c_block_index = byte_offset / mc_BLOCK_BYTE_SIZE;
+		const uint64_t c_skip = byte_offset % mc_BLOCK_BYTE_SIZE;
+		uint8_t iv[mc_BLOCK_BYTE_SIZE] = { 0 };
+		for (uint64_t i = 0; i < 8; ++i)
+		{
+			iv[mc_BLOCK_BYTE_SIZE - 1 - i] = static_cast<uint8_t>(c_block_index >> (i * 8));
+		}
+
+		if (EVP_EncryptInit_ex(m_ctx, EVP_aes_128_ctr(), nullptr, m_seed.data(), iv) != 1)
+		{
+			throw mpmt::rng_exc
+			(
+				rng_exc::impl_type::OPENSSL,
+				"failed to initialize the PRG cipher context."
+			);
+		}
+
+		// 2-丢弃块内偏移之前的字节
+		int outl = 0;
+		if (c_skip != 0)
+		{
+			uint8_t discard[mc_BLOCK_BYTE_SIZE] = { 0 };
+			if (EVP_EncryptUpdate(m_ctx, discard, &outl, discard, static_cast<int>(c_skip)) != 1)
+			{
+				throw mpmt::rng_exc
+				(
+					rng_exc::impl_type::OPENSSL,
+					"pseudo-random number generation failed."
+				);
+			}
+		}
+
+		// 3-分块加密全零明文得到密钥流（EVP接口长度为int，需分块处理）
+		static constexpr uint64_t c_STEP = 1ULL << 30;
+		std::memset(out, 0, len);
+		for (uint64_t done = 0; done < len; done += c_STEP)
+		{
+			const int step = static_cast<int>(std::min(c_STEP, len - done));
+			if (EVP_EncryptUpdate(m_ctx, out + done, &outl, out + done, step) != 1)
+			{
+				throw mpmt::rng_exc
+				(
+					rng_exc::impl_type::OPENSSL,
+					"pseudo-random number generation failed."
+				);
+			}
+		}
+	}
+
+	inline prg_openssl::~prg_openssl()
+	{
+		EVP_CIPHER_CTX_free(m_ctx);
+		OPENSSL_cleanse(m_seed.data(), m_seed.size());
+	}
+}
@@ -1,5 +1,6 @@
 #include <string>    
 #include <limits>
+#include "auxkit/profiler.hpp"
 #include "core/mpmtcfg.hpp"
 #include "core/exception/rng_exc.hpp"
 #include "core/rng/rng_adapter.hpp"
@@ -26,6 +27,8 @@ namespace mpmt
 	rng_array<DT> rng_openssl<DT>::rand(const uint64_t size) const
 	{
       	rng_array<DT> result(size);
+		MPMT_PROF_SCOPE("rng_openssl::rand");
+		MPMT_PROF_COUNT(RNG_BYTES, sizeof(DT) * size);
 
 		if (result.m_size != 0)
 		{		
@@ -99,6 +102,8 @@ namespace mpmt
 		}
 
 		rng_array<DT> result(size);
+		MPMT_PROF_SCOPE("rng_openssl::rand_bounded");
+		MPMT_PROF_COUNT(RNG_BYTES, sizeof(DT) * size);
 		if (result.m_size != 0)
 		{		
 			DT* arr = result.m_data.get(); 
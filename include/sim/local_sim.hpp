@@ -0,0 +1,138 @@
+#ifndef LOCAL_SIM_HPP
+#define LOCAL_SIM_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/** @namespace 项目命名空间 */
+namespace mpmt
+{
+    class credential_ingest;
+    class slot_indicator;
+    template <typename RT> class querier_ass;
+
+    /**
+     * @class   单进程本地模拟：数据持有方、AS0、AS1与查询方均以线程运行，经进程内通道互联
+     * @note    1. 凭据集合为确定性合成数据，持有方i的第j条凭据为"h<i>_<j>"。
+     *          2. 查询一半取自某持有方集合（应命中），一半为不存在的凭据（用于统计误判率）。
+     *          3. 不经过网络，可用于端到端合并与查询吞吐的基准测试与性能回归检查。
+     *          4. m_serve_workers非0时代理方以agent_server响应查询，m_query_clients个查询方线程各自建立会话并发查询。
+     *          5. m_relay_fanin非0时两侧各建一棵扇入不超过该值的聚合树（见relay_ass），中继以线程运行，
+     *             代理方只与树根一层的至多m_relay_fanin个节点相连。
+     *          6. m_num_shards大于1时槽位按shard_map切分给多对代理方，每对只合并、保存并响应本分片；
+     *             m_union_path非空时每个分片的每个代理方各保存一个mrvf文件，查询服务由这些文件建立快照。
+     *          7. m_open_batch大于1时每个查询方把连续的m_open_batch次查询登记到open_queue的同一层，一轮通信完成。
+     *          8. m_checkpoint_path非空时每个代理方周期性地写合并检查点（见merge_checkpoint）；m_crash_after在(0, 持有方个数)内时，
+     *             前m_crash_after个持有方发送后其余持有方断开，代理方中断后重启并从检查点恢复，全部持有方重新发送。
+     *          9. m_backend为RSS时改用三个代理方的复制秘密分享（见agent_rss），只支持直连合并与逐次查询。
+     *          10. m_shard_processes为true时每个分片的代理方对运行在各自fork()出的子进程中，经comm_pipe与持有方、查询方相连，
+     *              用于在一台主机上验证多进程分片部署；聚合树的中继在父进程中以线程运行，同样经comm_pipe相连，
+     *              树根一层的连接交给分片进程；只支持查询方逐批查询（仅POSIX）。
+     *          11. m_share_bits非0时加法秘密分享在Z_{2^{m_share_bits}}上进行（见data_holder_ass::set_share_bits()），
+     *              持有方上传的份额按该位宽打包；须满足2^{m_share_bits}大于持有方个数。
+     */
+    class local_sim
+    {
+    public:
+        /** @brief 秘密分享后端 */
+        enum class backend : uint8_t
+        {
+            ASS = 0,    // 两个代理方的加法秘密分享（ass_impl）
+            RSS = 1,    // 三个代理方的2-out-of-3复制秘密分享（rss_impl）
+        };
+
+        struct config
+        {
+            uint32_t m_num_holders;         // 数据持有方个数
+            uint64_t m_set_size;            // 每个持有方的凭据条数
+            uint64_t m_num_slots;           // 编码向量长度
+            uint8_t m_num_hashes;           // 每条凭据的槽位数k
+            uint8_t m_ring_bits;            // 环位宽：8、16、32或64
+            uint64_t m_num_queries;         // 查询次数
+            unsigned m_ingest_threads;      // 每个持有方编码时的线程数，0表示硬件并发数
+            unsigned m_serve_workers;       // 代理方查询服务的工作线程数，0表示由代理方线程逐次响应
+            unsigned m_query_clients;       // 并发查询方个数（m_serve_workers非0时有效），0视为1
+            uint64_t m_cache_entries;       // 代理方查询缓存条目数（agent_server为每个工作线程），0表示不缓存
+            uint32_t m_relay_fanin;         // 聚合树每个节点的扇入，0表示持有方直连代理方
+            uint32_t m_num_shards;          // 代理方对（分片）个数，0视为1
+            uint64_t m_open_batch;          // 每轮通信合并的查询次数，0视为1
+            std::string m_union_path;       // 并集份额文件的路径前缀（<前缀>.as0[.shard<i>].mrvf），空表示不保存
+            std::string m_checkpoint_path;  // 合并检查点的路径前缀（<前缀>.as0[.shard<i>].manifest），空表示不写检查点
+            double m_checkpoint_interval;   // 两个检查点之间的最小间隔（秒），0表示每组累加后都尝试
+            uint32_t m_crash_after;         // 模拟代理方崩溃前完成发送的持有方个数，0表示不模拟
+            backend m_backend;              // 秘密分享后端
+            bool m_shard_processes;         // 每个分片的代理方对以独立子进程运行
+            uint8_t m_share_bits;           // 份额位宽，0表示环位宽
+        };
+
+        struct report
+        {
+            double m_encode_seconds;        // 全部持有方编码耗时
+            double m_merge_seconds;         // 分享 + 合并耗时（墙钟）
+            double m_query_seconds;         // 全部查询耗时
+            uint64_t m_holder_upload_bytes; // 持有方上传总字节数
+            uint64_t m_agent_ingress_bytes; // 两个代理方合并时接收的总字节数
+            uint64_t m_num_relays;          // 两侧聚合树的中继节点总数
+            uint64_t m_true_positives;      // 成员查询命中数
+            uint64_t m_false_negatives;     // 成员查询未命中数（应为0）
+            uint64_t m_false_positives;     // 非成员查询误判数
+            uint64_t m_true_negatives;      // 非成员查询正确否定数
+            uint64_t m_cache_hits;          // AS0命中查询缓存的次数
+            uint64_t m_rounds;              // 全部查询方与代理方之间的通信轮数
+            uint64_t m_checkpoints_written; // 全部代理方提交的检查点个数
+            uint64_t m_resumed_agents;      // 崩溃后从检查点恢复的代理方个数
+        };
+
+        /**
+         * @brief   构造本地模拟
+         * @param   const config& cfg 模拟配置
+         * @throw   encode_exc 参数不合法
+         */
+        explicit local_sim(const config& cfg);
+
+        /**
+         * @brief   运行一次完整的编码、分享、合并与查询
+         * @return  report 运行报告
+         */
+        report run() const;
+
+        /**
+         * @brief   将运行报告格式化为可读文本
+         * @param   const report& rep 运行报告
+         * @return  std::string 文本
+         */
+        std::string format(const report& rep) const;
+
+    private:
+        const config mc_config;             // 模拟配置
+
+        template <typename RT>
+        report run_ring() const;
+
+        template <typename RT>
+        report run_rss() const;
+
+        template <typename RT>
+        report run_processes() const;
+
+        /** @brief 编码全部持有方的合成凭据集合 */
+        std::vector<slot_indicator> encode_inputs(const credential_ingest& ingest) const;
+
+        /** @brief 写出第q次查询凭据的槽位，返回该凭据是否属于某持有方 */
+        bool query_slots(const credential_ingest& ingest, uint64_t q, std::vector<uint64_t>& slots) const;
+
+        /** @brief 以一轮通信执行一批查询（单次查询或经open_queue合并的一层）并计入统计 */
+        template <typename RT>
+        void query_batch
+        (
+            const credential_ingest& ingest,
+            querier_ass<RT>& querier,
+            std::vector<uint64_t>& slots,
+            const std::vector<uint64_t>& batch,
+            report& out
+        ) const;
+    };
+}
+
+#endif // !LOCAL_SIM_HPP
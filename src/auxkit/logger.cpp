@@ -1 +1,445 @@
-#include "auxkit/logger.hpp"
\ No newline at end of file
+#include "auxkit/logger.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <pthread.h>
+#endif
+
+#include <nlohmann/json.hpp>
+
+#include "auxkit/stack_tracer.hpp"
+
+namespace utils
+{
+    namespace verborgen
+    {
+        struct log_record
+        {
+            uint64_t m_ts_ns;
+            const char* m_file;
+            const char* m_msg;
+            int m_line;
+            logger::level m_level;
+            uint8_t m_num_fields;
+            logger::field m_fields[logger::mc_MAX_FIELDS];
+        };
+
+        /**
+         * @brief 单生产者单消费者环形队列：生产者为所属线程，消费者为后台写出线程
+         * @note  1. 槽位按段分配，生产者写到某段时才分配该段，只记录少量日志的线程只占用一段；
+         *           段在m_head发布之前就位，所属线程存续期间不释放。
+         *        2. m_in_flight与m_head同属生产者的缓存行，shutdown()逐个队列检查，生产者不触碰共享计数。
+         */
+        struct spsc_queue
+        {
+            static constexpr uint64_t mc_SEGMENT = 256;                                     // 每段记录数
+            static constexpr uint64_t mc_SEGMENTS = logger::mc_QUEUE_CAPACITY / mc_SEGMENT;
+
+            explicit spsc_queue(uint32_t tid)
+                :
+                m_tid(tid),
+                m_segments(),
+                m_retired(false),
+                m_head(0),
+                m_in_flight(false),
+                m_reserved(0),
+                m_tail(0)
+            {}
+
+            log_record& slot(uint64_t pos) const noexcept
+            {
+                const uint64_t c_idx = pos & (logger::mc_QUEUE_CAPACITY - 1);
+                return m_segments[c_idx / mc_SEGMENT][c_idx % mc_SEGMENT];
+            }
+
+            const uint32_t m_tid;
+            std::unique_ptr<log_record[]> m_segments[mc_SEGMENTS];  // 写到时分配
+            bool m_retired;                                         // 所属线程已退出，受log_state::m_mutex保护
+            alignas(64) std::atomic<uint64_t> m_head;               // 下一个写入位置（生产者）
+            std::atomic<bool> m_in_flight;                          // 生产者正在write()中
+            std::atomic<uint64_t> m_reserved;                       // 已分配的槽位字节数
+            alignas(64) std::atomic<uint64_t> m_tail;               // 下一个读取位置（消费者）
+        };
+
+        static_assert(logger::mc_QUEUE_CAPACITY % spsc_queue::mc_SEGMENT == 0);
+
+        struct log_state
+        {
+            ~log_state();
+
+            std::mutex m_mutex;                                 // 仅在线程注册与退出、读空时的队列回收、启动与停止时使用
+            std::vector<std::unique_ptr<spsc_queue>> m_queues;  // 线程退出后队列仍保留，直到被读空后回收
+            uint32_t m_next_tid = 0;                            // 下一个队列的编号
+            bool m_writer_active = false;                       // 写出线程存在，受m_mutex保护
+            std::atomic<bool> m_running{ false };               // 是否接受新记录
+            std::atomic<bool> m_writer_stop{ false };           // 通知写出线程做最后一次读空并退出
+            std::atomic<uint8_t> m_min_level{ static_cast<uint8_t>(logger::level::INFO) };
+            std::atomic<uint64_t> m_dropped{ 0 };
+            std::thread m_writer;
+            FILE* m_out = nullptr;
+            bool m_owns_out = false;
+            const std::chrono::steady_clock::time_point m_origin = std::chrono::steady_clock::now();
+        };
+
+        log_state& global_state()
+        {
+            static log_state s_state;
+            return s_state;
+        }
+
+        thread_local spsc_queue* t_queue = nullptr;
+        thread_local bool t_queue_exited = false;
+
+        /** @brief 移除已退役且读空的队列（调用方持有m_mutex） */
+        void reclaim_retired(log_state& st)
+        {
+            st.m_queues.erase
+            (
+                std::remove_if(st.m_queues.begin(), st.m_queues.end(), [](const std::unique_ptr<spsc_queue>& q)
+                {
+                    return q->m_retired
+                        && q->m_tail.load(std::memory_order_relaxed) == q->m_head.load(std::memory_order_relaxed);
+                }),
+                st.m_queues.end()
+            );
+        }
+
+        /**
+         * @brief 线程退出时退役其队列
+         * @note  写出线程运行时由它在读空后回收（它可能正在读取该队列）；没有写出线程时队列必已读空，立即回收。
+         */
+        struct queue_retirer
+        {
+            ~queue_retirer()
+            {
+                log_state& st = global_state();
+                std::lock_guard<std::mutex> lock(st.m_mutex);
+                t_queue->m_retired = true;
+                if (!st.m_writer_active)
+                {
+                    reclaim_retired(st);
+                }
+                t_queue = nullptr;
+                t_queue_exited = true;
+            }
+        };
+
+        /** @brief 本线程的队列，首次使用时注册；注册失败或线程退出阶段返回nullptr */
+        spsc_queue* local_queue() noexcept
+        {
+            if (t_queue != nullptr || t_queue_exited)
+            {
+                return t_queue;
+            }
+            log_state& st = global_state();
+            {
+                std::lock_guard<std::mutex> lock(st.m_mutex);
+                std::unique_ptr<spsc_queue> q(new (std::nothrow) spsc_queue(st.m_next_tid));
+                if (!q)
+                {
+                    return nullptr;
+                }
+                try
+                {
+                    st.m_queues.push_back(std::move(q));
+                }
+                catch (...)
+                {
+                    return nullptr;
+                }
+                ++st.m_next_tid;
+                t_queue = st.m_queues.back().get();
+            }
+            thread_local queue_retirer t_retirer;
+            (void)t_retirer;
+            return t_queue;
+        }
+
+        const char* level_name(logger::level lv) noexcept
+        {
+            switch (lv)
+            {
+            case logger::level::TRACE:  return "TRACE";
+            case logger::level::DEBUG:  return "DEBUG";
+            case logger::level::INFO:   return "INFO";
+            case logger::level::WARN:   return "WARN";
+            case logger::level::ERR:    return "ERROR";
+            default:                    return "UNKNOWN";
+            }
+        }
+
+        void emit(FILE* out, uint32_t tid, const log_record& rec)
+        {
+            nlohmann::json line =
+            {
+                { "ts_ns", rec.m_ts_ns },
+                { "level", level_name(rec.m_level) },
+                { "tid", tid },
+                { "file", rec.m_file },
+                { "line", rec.m_line },
+                { "msg", rec.m_msg }
+            };
+            for (uint8_t i = 0; i < rec.m_num_fields; ++i)
+            {
+                const logger::field& f = rec.m_fields[i];
+                switch (f.m_kind)
+                {
+                case logger::field::kind::INT:  line[f.m_key] = f.m_int; break;
+                case logger::field::kind::UINT: line[f.m_key] = f.m_uint; break;
+                case logger::field::kind::REAL: line[f.m_key] = f.m_real; break;
+                case logger::field::kind::TEXT: line[f.m_key] = (f.m_text == nullptr) ? "" : f.m_text; break;
+                default: break;
+                }
+            }
+            const std::string text = line.dump() + "\n";
+            std::fwrite(text.data(), 1, text.size(), out);
+        }
+
+        /**
+         * @brief 读空全部队列，返回写出的记录数
+         */
+        uint64_t drain(log_state& st)
+        {
+            std::vector<spsc_queue*> queues;
+            {
+                std::lock_guard<std::mutex> lock(st.m_mutex);
+                for (const auto& q : st.m_queues)
+                {
+                    queues.push_back(q.get());
+                }
+            }
+
+            uint64_t written = 0;
+            for (spsc_queue* q : queues)
+            {
+                uint64_t tail = q->m_tail.load(std::memory_order_relaxed);
+                const uint64_t c_head = q->m_head.load(std::memory_order_acquire);
+                for (; tail != c_head; ++tail, ++written)
+                {
+                    emit(st.m_out, q->m_tid, q->slot(tail));
+                }
+                q->m_tail.store(tail, std::memory_order_release);
+            }
+            if (written != 0)
+            {
+                std::fflush(st.m_out);
+            }
+
+            // 回收所属线程已退出且已读空的队列；只有写出线程读取队列，此后不再访问被回收的队列
+            {
+                std::lock_guard<std::mutex> lock(st.m_mutex);
+                reclaim_retired(st);
+            }
+            return written;
+        }
+
+        /**
+         * @brief 停止接受新记录，等待进行中的写入完成后令写出线程读空队列并退出
+         * @note  write()先置本队列的m_in_flight再检查m_running，此处先清除m_running再逐个队列等待m_in_flight清零
+         *        （均为顺序一致），二者必有一方看到对方：要么写入方放弃，要么本函数等到该记录入队，最后一次读空不会遗漏记录。
+         *        此后才注册的队列，其写入方在注册锁之后读取m_running，必然看到已清除。
+         */
+        void shutdown(log_state& st)
+        {
+            if (!st.m_writer.joinable())
+            {
+                return;
+            }
+            st.m_running.store(false);
+            {
+                std::lock_guard<std::mutex> lock(st.m_mutex);
+                for (const auto& q : st.m_queues)
+                {
+                    while (q->m_in_flight.load())
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+            }
+            st.m_writer_stop.store(true, std::memory_order_release);
+            st.m_writer.join();
+            {
+                std::lock_guard<std::mutex> lock(st.m_mutex);
+                st.m_writer_active = false;
+                reclaim_retired(st);
+            }
+            if (st.m_owns_out)
+            {
+                std::fclose(st.m_out);
+            }
+            st.m_out = nullptr;
+            st.m_owns_out = false;
+        }
+
+#if !defined(_WIN32)
+        /**
+         * @brief 登记fork()处理：fork期间持有注册锁，使子进程中的锁处于未持有状态；
+         *        子进程没有写出线程，停止接受记录（记录被丢弃而非堆积在无人读取的队列中）
+         */
+        void install_fork_handlers()
+        {
+            static std::once_flag s_once;
+            std::call_once(s_once, []
+            {
+                ::pthread_atfork
+                (
+                    [] { global_state().m_mutex.lock(); },
+                    [] { global_state().m_mutex.unlock(); },
+                    []
+                    {
+                        log_state& st = global_state();
+                        st.m_mutex.unlock();
+                        st.m_running.store(false);
+                    }
+                );
+            });
+        }
+#endif
+
+        log_state::~log_state()
+        {
+            // 未调用stop()即退出（如异常路径）时回收写出线程，避免析构可join的std::thread而终止进程
+            shutdown(*this);
+        }
+    }
+
+    bool logger::start(const config& cfg)
+    {
+        verborgen::log_state& st = verborgen::global_state();
+        stop();
+
+        FILE* out = stderr;
+        if (!cfg.m_path.empty())
+        {
+            out = std::fopen(cfg.m_path.c_str(), "ab");
+            if (out == nullptr)
+            {
+                return false;
+            }
+        }
+
+        st.m_out = out;
+        st.m_owns_out = !cfg.m_path.empty();
+        st.m_min_level.store(static_cast<uint8_t>(cfg.m_min_level), std::memory_order_relaxed);
+#if !defined(_WIN32)
+        verborgen::install_fork_handlers();
+#endif
+        st.m_writer_stop.store(false, std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(st.m_mutex);
+            st.m_writer_active = true;
+        }
+        st.m_running.store(true);
+        st.m_writer = std::thread([&st]
+        {
+            utils::stack_tracer::install_thread_alt_stack();
+
+            // 空闲时指数退避休眠，生产者无需唤醒写出线程
+            auto idle = std::chrono::microseconds(50);
+            while (!st.m_writer_stop.load(std::memory_order_acquire))
+            {
+                if (verborgen::drain(st) == 0)
+                {
+                    std::this_thread::sleep_for(idle);
+                    idle = std::min(idle * 2, std::chrono::microseconds(10000));
+                }
+                else
+                {
+                    idle = std::chrono::microseconds(50);
+                }
+            }
+            verborgen::drain(st);
+        });
+        return true;
+    }
+
+    void logger::stop()
+    {
+        verborgen::shutdown(verborgen::global_state());
+    }
+
+    void logger::write(level lv, const char* file, int line, const char* msg, const field* fields, uint32_t num_fields) noexcept
+    {
+        verborgen::log_state& st = verborgen::global_state();
+        if (static_cast<uint8_t>(lv) < st.m_min_level.load(std::memory_order_relaxed))
+        {
+            return;
+        }
+
+        if (!st.m_running.load(std::memory_order_relaxed))
+        {
+            return;
+        }
+        verborgen::spsc_queue* const c_queue = verborgen::local_queue();
+        if (c_queue == nullptr)
+        {
+            st.m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        verborgen::spsc_queue& q = *c_queue;
+
+        // 先置本队列的进行中标志再检查运行标志，与shutdown()的先清除再等待配对
+        q.m_in_flight.store(true);
+        if (st.m_running.load())
+        {
+            const uint64_t c_head = q.m_head.load(std::memory_order_relaxed);
+            const uint64_t c_seg = (c_head & (mc_QUEUE_CAPACITY - 1)) / verborgen::spsc_queue::mc_SEGMENT;
+            if (!q.m_segments[c_seg])
+            {
+                q.m_segments[c_seg].reset(new (std::nothrow) verborgen::log_record[verborgen::spsc_queue::mc_SEGMENT]);
+                if (q.m_segments[c_seg])
+                {
+                    q.m_reserved.fetch_add(verborgen::spsc_queue::mc_SEGMENT * sizeof(verborgen::log_record), std::memory_order_relaxed);
+                }
+            }
+            if (!q.m_segments[c_seg] || c_head - q.m_tail.load(std::memory_order_acquire) >= mc_QUEUE_CAPACITY)
+            {
+                st.m_dropped.fetch_add(1, std::memory_order_relaxed);
+            }
+            else
+            {
+                verborgen::log_record& rec = q.slot(c_head);
+                rec.m_ts_ns = static_cast<uint64_t>
+                (
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - st.m_origin).count()
+                );
+                rec.m_file = file;
+                rec.m_msg = msg;
+                rec.m_line = line;
+                rec.m_level = lv;
+                rec.m_num_fields = static_cast<uint8_t>(std::min(num_fields, mc_MAX_FIELDS));
+                for (uint8_t i = 0; i < rec.m_num_fields; ++i)
+                {
+                    rec.m_fields[i] = fields[i];
+                }
+                q.m_head.store(c_head + 1, std::memory_order_release);
+            }
+        }
+        q.m_in_flight.store(false, std::memory_order_release);
+    }
+
+    uint64_t logger::dropped() noexcept
+    {
+        return verborgen::global_state().m_dropped.load(std::memory_order_relaxed);
+    }
+
+    uint64_t logger::queue_bytes() noexcept
+    {
+        verborgen::log_state& st = verborgen::global_state();
+        std::lock_guard<std::mutex> lock(st.m_mutex);
+        uint64_t total = 0;
+        for (const auto& q : st.m_queues)
+        {
+            total += q->m_reserved.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+}
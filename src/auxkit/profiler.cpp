@@ -1,3 +1,462 @@
 #include "auxkit/profiler.hpp"
 
+#include <bit>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
 
+#include <nlohmann/json.hpp>
+
+#include "auxkit/stack_tracer.hpp"
+
+namespace utils
+{
+    namespace verborgen
+    {
+        struct prof_event
+        {
+            const char* m_name;
+            uint64_t m_begin_ns;
+            uint64_t m_end_ns;
+        };
+
+        /** @brief 慢路径调用栈样本，符号化推迟到导出时 */
+        struct prof_stack
+        {
+            const char* m_name;
+            uint64_t m_end_ns;
+            uint64_t m_duration_ns;
+            stack_tracer::trace m_trace;
+        };
+
+        /**
+         * @brief 线程事件缓存区：仅所属线程写入，m_count以release发布，导出方以acquire读取
+         * @note  1. 事件按段存放，段在写到时才分配：段0容纳[0, 256)，段k（k>=1）容纳[256<<(k-1), 256<<k)，
+         *           只记录少量事件的线程只占用首段，已分配的段不移动，导出方可与写入并发读取。
+         *        2. 所属线程退出后缓存区标记为退役，事件保留至导出；没有事件的退役缓存区可由新线程接管，
+         *           reset()释放退役缓存区的段并使其可被接管。计数器随缓存区保留，汇总值不受影响。
+         */
+        struct thread_buffer
+        {
+            static constexpr uint64_t mc_FIRST_SEGMENT = 1ULL << 8;
+            static constexpr uint32_t mc_SEGMENTS = 9;
+            static constexpr uint64_t mc_CAPACITY = mc_FIRST_SEGMENT << (mc_SEGMENTS - 1);
+            static constexpr uint64_t mc_STACK_CAPACITY = 128;
+
+            explicit thread_buffer(uint32_t tid)
+                :
+                m_tid(tid),
+                m_segments(),
+                m_count(0),
+                m_dropped(0),
+                m_stacks(),
+                m_stack_count(0),
+                m_reserved(0),
+                m_slow_seen(0),
+                m_retired(false)
+            {
+                for (auto& c : m_counters)
+                {
+                    c.store(0, std::memory_order_relaxed);
+                }
+            }
+
+            /** @brief 第idx个事件所在的段 */
+            static constexpr uint32_t segment_of(uint64_t idx) noexcept
+            {
+                constexpr int c_first_bits = std::countr_zero(mc_FIRST_SEGMENT);
+                return idx < mc_FIRST_SEGMENT ? 0 : static_cast<uint32_t>(std::bit_width(idx) - c_first_bits);
+            }
+
+            /** @brief 段的起始下标 */
+            static constexpr uint64_t segment_begin(uint32_t seg) noexcept
+            {
+                return seg == 0 ? 0 : mc_FIRST_SEGMENT << (seg - 1);
+            }
+
+            /** @brief 段容纳的事件数 */
+            static constexpr uint64_t segment_size(uint32_t seg) noexcept
+            {
+                return seg == 0 ? mc_FIRST_SEGMENT : mc_FIRST_SEGMENT << (seg - 1);
+            }
+
+            prof_event& event(uint64_t idx) const noexcept
+            {
+                const uint32_t c_seg = segment_of(idx);
+                return m_segments[c_seg][idx - segment_begin(c_seg)];
+            }
+
+            /** @brief 释放全部段与调用栈并清空事件（仅用于退役缓存区） */
+            void release() noexcept
+            {
+                for (auto& seg : m_segments)
+                {
+                    seg.reset();
+                }
+                m_stacks.reset();
+                m_count.store(0, std::memory_order_release);
+                m_stack_count.store(0, std::memory_order_release);
+                m_reserved.store(0, std::memory_order_relaxed);
+                m_slow_seen = 0;
+            }
+
+            const uint32_t m_tid;
+            std::unique_ptr<prof_event[]> m_segments[mc_SEGMENTS];   // 写到时分配
+            std::atomic<uint64_t> m_count;
+            std::atomic<uint64_t> m_dropped;
+            std::atomic<uint64_t> m_counters[static_cast<size_t>(profiler::counter::COUNT_)];
+            std::unique_ptr<prof_stack[]> m_stacks;                 // 首次采样时分配
+            std::atomic<uint64_t> m_stack_count;
+            std::atomic<uint64_t> m_reserved;                       // 已分配的段与调用栈字节数
+            uint64_t m_slow_seen;                                   // 仅所属线程访问
+            bool m_retired;                                         // 所属线程已退出，受registry::m_mutex保护
+        };
+
+        static_assert(thread_buffer::segment_begin(thread_buffer::mc_SEGMENTS - 1)
+            + thread_buffer::segment_size(thread_buffer::mc_SEGMENTS - 1) == thread_buffer::mc_CAPACITY);
+
+        std::atomic<uint64_t> g_unbuffered_dropped{ 0 };        // 没有可用缓存区而丢弃的事件数
+        std::atomic<uint64_t> g_stack_threshold_ns{ 0 };
+        std::atomic<uint32_t> g_stack_period{ 1 };
+
+        /** @brief 慢事件按周期采集调用栈，跳过record()与scope析构两层 */
+        void sample_stack(thread_buffer& buf, const char* name, uint64_t end_ns, uint64_t duration_ns) noexcept
+        {
+            const uint64_t c_seen = buf.m_slow_seen++;
+            if (c_seen % g_stack_period.load(std::memory_order_relaxed) != 0)
+            {
+                return;
+            }
+            const uint64_t c_idx = buf.m_stack_count.load(std::memory_order_relaxed);
+            if (c_idx >= thread_buffer::mc_STACK_CAPACITY)
+            {
+                return;
+            }
+            if (!buf.m_stacks)
+            {
+                buf.m_stacks.reset(new (std::nothrow) prof_stack[thread_buffer::mc_STACK_CAPACITY]);
+                if (!buf.m_stacks)
+                {
+                    return;
+                }
+                buf.m_reserved.fetch_add(thread_buffer::mc_STACK_CAPACITY * sizeof(prof_stack), std::memory_order_relaxed);
+            }
+            prof_stack& st = buf.m_stacks[c_idx];
+            st.m_name = name;
+            st.m_end_ns = end_ns;
+            st.m_duration_ns = duration_ns;
+            stack_tracer::capture(st.m_trace, 2);
+            buf.m_stack_count.store(c_idx + 1, std::memory_order_release);
+        }
+
+        struct registry
+        {
+            std::mutex m_mutex;                                     // 仅在线程注册、退出与导出时使用
+            std::vector<std::unique_ptr<thread_buffer>> m_buffers;  // 线程退出后缓存区仍保留以便导出
+            std::vector<thread_buffer*> m_idle;                     // 没有事件的退役缓存区，可被新线程接管
+            const std::chrono::steady_clock::time_point m_origin = std::chrono::steady_clock::now();
+        };
+
+        registry& global_registry()
+        {
+            static registry s_registry;
+            return s_registry;
+        }
+
+        thread_local thread_buffer* t_buffer = nullptr;
+        thread_local bool t_exited = false;
+
+        /** @brief 线程退出时退役其缓存区：没有事件的立即释放存储并可被接管，否则保留至导出后的reset() */
+        struct buffer_retirer
+        {
+            ~buffer_retirer()
+            {
+                registry& reg = global_registry();
+                std::lock_guard<std::mutex> lock(reg.m_mutex);
+                t_buffer->m_retired = true;
+                if (t_buffer->m_count.load(std::memory_order_relaxed) == 0
+                    && t_buffer->m_stack_count.load(std::memory_order_relaxed) == 0)
+                {
+                    t_buffer->release();
+                    reg.m_idle.push_back(t_buffer);
+                }
+                t_buffer = nullptr;
+                t_exited = true;
+            }
+        };
+
+        /**
+         * @brief 本线程的缓存区，首次使用时接管空闲缓存区或注册新缓存区
+         * @note  由noexcept的record()/add()调用，分配失败时不抛出，返回nullptr（线程退出阶段同样返回nullptr），
+         *        调用方丢弃该次记录并计入g_unbuffered_dropped。
+         */
+        thread_buffer* local_buffer() noexcept
+        {
+            if (t_buffer != nullptr || t_exited)
+            {
+                return t_buffer;
+            }
+            {
+                registry& reg = global_registry();
+                std::lock_guard<std::mutex> lock(reg.m_mutex);
+                if (!reg.m_idle.empty())
+                {
+                    t_buffer = reg.m_idle.back();
+                    reg.m_idle.pop_back();
+                    t_buffer->m_retired = false;
+                }
+                else
+                {
+                    std::unique_ptr<thread_buffer> buf(new (std::nothrow) thread_buffer(static_cast<uint32_t>(reg.m_buffers.size())));
+                    if (!buf)
+                    {
+                        return nullptr;
+                    }
+                    try
+                    {
+                        // 先为m_idle预留，退役与reset()向m_idle追加时不再分配
+                        reg.m_idle.reserve(reg.m_buffers.size() + 1);
+                        reg.m_buffers.push_back(std::move(buf));
+                    }
+                    catch (...)
+                    {
+                        return nullptr;
+                    }
+                    t_buffer = reg.m_buffers.back().get();
+                }
+            }
+            thread_local buffer_retirer t_retirer;
+            (void)t_retirer;
+            return t_buffer;
+        }
+    }
+
+    uint64_t profiler::now() noexcept
+    {
+        return static_cast<uint64_t>
+        (
+            std::chrono::duration_cast<std::chrono::nanoseconds>
+            (
+                std::chrono::steady_clock::now() - verborgen::global_registry().m_origin
+            ).count()
+        );
+    }
+
+    void profiler::record(const char* name, uint64_t begin_ns, uint64_t end_ns) noexcept
+    {
+        verborgen::thread_buffer* const c_buf = verborgen::local_buffer();
+        if (c_buf == nullptr)
+        {
+            verborgen::g_unbuffered_dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        verborgen::thread_buffer& buf = *c_buf;
+        const uint64_t c_idx = buf.m_count.load(std::memory_order_relaxed);
+        if (c_idx >= verborgen::thread_buffer::mc_CAPACITY)
+        {
+            buf.m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        // 写到新段的第一个事件时分配该段；段在m_count发布之前就位
+        const uint32_t c_seg = verborgen::thread_buffer::segment_of(c_idx);
+        if (!buf.m_segments[c_seg])
+        {
+            const uint64_t c_size = verborgen::thread_buffer::segment_size(c_seg);
+            buf.m_segments[c_seg].reset(new (std::nothrow) verborgen::prof_event[c_size]);
+            if (!buf.m_segments[c_seg])
+            {
+                buf.m_dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            buf.m_reserved.fetch_add(c_size * sizeof(verborgen::prof_event), std::memory_order_relaxed);
+        }
+        buf.event(c_idx) = verborgen::prof_event{ name, begin_ns, end_ns };
+        buf.m_count.store(c_idx + 1, std::memory_order_release);
+
+        const uint64_t c_threshold = verborgen::g_stack_threshold_ns.load(std::memory_order_relaxed);
+        if (c_threshold != 0 && end_ns - begin_ns >= c_threshold)
+        {
+            verborgen::sample_stack(buf, name, end_ns, end_ns - begin_ns);
+        }
+    }
+
+    void profiler::set_stack_sampling(uint64_t threshold_ns, uint32_t period) noexcept
+    {
+        verborgen::g_stack_period.store(period == 0 ? 1 : period, std::memory_order_relaxed);
+        verborgen::g_stack_threshold_ns.store(threshold_ns, std::memory_order_relaxed);
+    }
+
+    void profiler::add(counter c, uint64_t value) noexcept
+    {
+        verborgen::thread_buffer* const c_buf = verborgen::local_buffer();
+        if (c_buf != nullptr)
+        {
+            c_buf->m_counters[static_cast<size_t>(c)].fetch_add(value, std::memory_order_relaxed);
+        }
+    }
+
+    uint64_t profiler::counter_value(counter c) noexcept
+    {
+        verborgen::registry& reg = verborgen::global_registry();
+        std::lock_guard<std::mutex> lock(reg.m_mutex);
+        uint64_t total = 0;
+        for (const auto& buf : reg.m_buffers)
+        {
+            total += buf->m_counters[static_cast<size_t>(c)].load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    uint64_t profiler::dropped_events() noexcept
+    {
+        verborgen::registry& reg = verborgen::global_registry();
+        std::lock_guard<std::mutex> lock(reg.m_mutex);
+        uint64_t total = verborgen::g_unbuffered_dropped.load(std::memory_order_relaxed);
+        for (const auto& buf : reg.m_buffers)
+        {
+            total += buf->m_dropped.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    uint64_t profiler::buffer_bytes() noexcept
+    {
+        verborgen::registry& reg = verborgen::global_registry();
+        std::lock_guard<std::mutex> lock(reg.m_mutex);
+        uint64_t total = 0;
+        for (const auto& buf : reg.m_buffers)
+        {
+            total += buf->m_reserved.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    const char* profiler::counter_name(counter c) noexcept
+    {
+        switch (c)
+        {
+        case counter::BYTES_SENT:       return "bytes_sent";
+        case counter::BYTES_RECEIVED:   return "bytes_received";
+        case counter::RNG_BYTES:        return "rng_bytes";
+        case counter::CRC_BYTES:        return "crc_bytes";
+        case counter::RVECTOR_ELEMENTS: return "rvector_elements";
+        case counter::MRVF_RAW_BYTES:   return "mrvf_raw_bytes";
+        case counter::MRVF_STORED_BYTES:return "mrvf_stored_bytes";
+        default:                        return "unknown";
+        }
+    }
+
+    std::string profiler::export_chrome_trace()
+    {
+        nlohmann::json events = nlohmann::json::array();
+        const uint64_t c_export_ns = now();
+
+        verborgen::registry& reg = verborgen::global_registry();
+        std::lock_guard<std::mutex> lock(reg.m_mutex);
+
+        // 1-作用域事件（"X"完整事件，时间单位为微秒）
+        for (const auto& buf : reg.m_buffers)
+        {
+            const uint64_t c_count = buf->m_count.load(std::memory_order_acquire);
+            for (uint64_t i = 0; i < c_count; ++i)
+            {
+                const verborgen::prof_event& ev = buf->event(i);
+                events.push_back
+                ({
+                    { "name", ev.m_name },
+                    { "ph", "X" },
+                    { "ts", ev.m_begin_ns / 1000.0 },
+                    { "dur", (ev.m_end_ns - ev.m_begin_ns) / 1000.0 },
+                    { "pid", 0 },
+                    { "tid", buf->m_tid }
+                });
+            }
+        }
+
+        // 2-慢路径调用栈（"i"即时事件，在此处完成符号化）
+        for (const auto& buf : reg.m_buffers)
+        {
+            const uint64_t c_count = buf->m_stack_count.load(std::memory_order_acquire);
+            for (uint64_t i = 0; i < c_count; ++i)
+            {
+                const verborgen::prof_stack& st = buf->m_stacks[i];
+                events.push_back
+                ({
+                    { "name", std::string("slow:") + st.m_name },
+                    { "ph", "i" },
+                    { "s", "t" },
+                    { "ts", st.m_end_ns / 1000.0 },
+                    { "pid", 0 },
+                    { "tid", buf->m_tid },
+                    { "args", { { "duration_us", st.m_duration_ns / 1000.0 }, { "stack", stack_tracer::symbolize(st.m_trace) } } }
+                });
+            }
+        }
+
+        // 3-计数器（"C"计数事件，取导出时刻的汇总值）
+        nlohmann::json args = nlohmann::json::object();
+        for (size_t c = 0; c < static_cast<size_t>(counter::COUNT_); ++c)
+        {
+            uint64_t total = 0;
+            for (const auto& buf : reg.m_buffers)
+            {
+                total += buf->m_counters[c].load(std::memory_order_relaxed);
+            }
+            args[counter_name(static_cast<counter>(c))] = total;
+        }
+        events.push_back
+        ({
+            { "name", "mpmt_counters" },
+            { "ph", "C" },
+            { "ts", c_export_ns / 1000.0 },
+            { "pid", 0 },
+            { "args", args }
+        });
+
+        nlohmann::json trace =
+        {
+            { "traceEvents", events },
+            { "displayTimeUnit", "ns" }
+        };
+        return trace.dump();
+    }
+
+    bool profiler::save_chrome_trace(const std::string& path)
+    {
+        std::ofstream out(path, std::ios::binary);
+        if (!out)
+        {
+            return false;
+        }
+        out << export_chrome_trace();
+        return static_cast<bool>(out);
+    }
+
+    void profiler::reset() noexcept
+    {
+        verborgen::registry& reg = verborgen::global_registry();
+        std::lock_guard<std::mutex> lock(reg.m_mutex);
+        verborgen::g_unbuffered_dropped.store(0, std::memory_order_relaxed);
+        reg.m_idle.clear();
+        for (const auto& buf : reg.m_buffers)
+        {
+            buf->m_count.store(0, std::memory_order_release);
+            buf->m_dropped.store(0, std::memory_order_relaxed);
+            buf->m_stack_count.store(0, std::memory_order_release);
+            for (auto& c : buf->m_counters)
+            {
+                c.store(0, std::memory_order_relaxed);
+            }
+            // 退役缓存区的事件已无用，释放存储供新线程接管；存活线程保留已分配的段
+            if (buf->m_retired)
+            {
+                buf->release();
+                reg.m_idle.push_back(buf.get());
+            }
+        }
+    }
+}
@@ -1,11 +1,44 @@
 #include "auxkit/stack_tracer.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+
+namespace utils
+{
+    namespace verborgen
+    {
+        std::atomic<bool> g_crash_handlers_installed{ false };
+
+        /** @brief 异步信号安全地写出到stderr，各平台实现见下 */
+        void write_stderr(const char* text, std::size_t len) noexcept;
+
+        void write_text(const char* text) noexcept
+        {
+            write_stderr(text, std::strlen(text));
+        }
+
+        /** @brief 异步信号安全的十六进制格式化 */
+        void write_hex(uintptr_t value) noexcept
+        {
+            char text[2 + 16 + 1] = { '0', 'x' };
+            for (int i = 0; i < 16; ++i)
+            {
+                const unsigned c_nibble = static_cast<unsigned>((value >> ((15 - i) * 4)) & 0xF);
+                text[2 + i] = static_cast<char>(c_nibble < 10 ? '0' + c_nibble : 'a' + c_nibble - 10);
+            }
+            text[18] = '\0';
+            write_text(text);
+        }
+    }
+}
+
 #if defined(_WIN32) || defined(_WIN64)
 
 #include <windows.h>
 #include <dbghelp.h>
-#include <cstdio>
-#include <vector>
+#include <csignal>
 
 namespace utils
 {
@@ -25,33 +58,72 @@ namespace utils
                 SymCleanup(GetCurrentProcess());
             }
         };
+
+        void write_stderr(const char* text, std::size_t len) noexcept
+        {
+            DWORD written = 0;
+            WriteFile(GetStdHandle(STD_ERROR_HANDLE), text, static_cast<DWORD>(len), &written, nullptr);
+        }
+
+        const char* signal_name(int sig) noexcept
+        {
+            switch (sig)
+            {
+            case SIGSEGV:   return "SIGSEGV";
+            case SIGABRT:   return "SIGABRT";
+            case SIGFPE:    return "SIGFPE";
+            case SIGILL:    return "SIGILL";
+            default:        return "signal";
+            }
+        }
+
+        void crash_handler(int sig)
+        {
+            // 1-处理函数内不使用stdio、不调用dbghelp（均会加锁或分配内存），只输出模块基址与原始返回地址
+            write_text("Fatal ");
+            write_text(signal_name(sig));
+            write_text(".\nRaw stack trace (symbolize offline against the module base ");
+            write_hex(reinterpret_cast<uintptr_t>(GetModuleHandleW(nullptr)));
+            write_text("):\n");
+
+            stack_tracer::trace tr;
+            stack_tracer::capture(tr, 1);
+            for (uint32_t i = 0; i < tr.m_size; ++i)
+            {
+                write_text("  ");
+                write_hex(reinterpret_cast<uintptr_t>(tr.m_frames[i]));
+                write_text("\n");
+            }
+
+            // 2-恢复默认处理并重新触发
+            std::signal(sig, SIG_DFL);
+            std::raise(sig);
+        }
     }
     static verborgen::dbghelp_initializer g_dbghelp_init;
 
-    void stack_tracer::print(size_t max_frames) noexcept
+    uint32_t stack_tracer::capture(trace& out, std::size_t skip) noexcept
     {
-        HANDLE process = GetCurrentProcess();
-        HANDLE thread = GetCurrentThread();
-
-        std::vector<void*> stack(max_frames);
-        USHORT captured = CaptureStackBackTrace(
-            /* Frames to skip */ 0,
-            /* Frames to capture */ static_cast<DWORD>(max_frames),
-            stack.data(),
+        out.m_size = CaptureStackBackTrace
+        (
+            /* Frames to skip */ static_cast<DWORD>(skip + 1),
+            /* Frames to capture */ static_cast<DWORD>(mc_MAX_FRAMES),
+            out.m_frames,
             nullptr
         );
+        return out.m_size;
+    }
 
-        fprintf(stderr, "Stack trace (%u frames):\n", captured);
+    std::vector<std::string> stack_tracer::symbolize(const trace& tr)
+    {
+        HANDLE process = GetCurrentProcess();
+        std::vector<std::string> lines;
+        lines.reserve(tr.m_size);
 
         // Allocate symbol buffer
         constexpr size_t kSymbolBufferSize = sizeof(SYMBOL_INFO) + MAX_SYM_NAME * sizeof(char);
-        SYMBOL_INFO* symbol = reinterpret_cast<SYMBOL_INFO*>(malloc(kSymbolBufferSize));
-        if (!symbol)
-        {
-            fprintf(stderr, "  [Error] Failed to allocate symbol info buffer.\n");
-            return;
-        }
-
+        std::vector<char> symbol_buffer(kSymbolBufferSize);
+        SYMBOL_INFO* symbol = reinterpret_cast<SYMBOL_INFO*>(symbol_buffer.data());
         symbol->MaxNameLen = MAX_SYM_NAME;
         symbol->SizeOfStruct = sizeof(SYMBOL_INFO);
 
@@ -60,44 +132,302 @@ namespace utils
         line.SizeOfStruct = sizeof(line);
 
         DWORD displacement = 0;
+        char text[MAX_SYM_NAME + MAX_PATH + 64];
 
-        for (USHORT i = 0; i < captured; ++i)
+        for (uint32_t i = 0; i < tr.m_size; ++i)
         {
-            DWORD64 address = reinterpret_cast<DWORD64>(stack[i]);
+            DWORD64 address = reinterpret_cast<DWORD64>(tr.m_frames[i]);
 
             bool gotSymbol = SymFromAddr(process, address, nullptr, symbol);
             bool gotLine = SymGetLineFromAddr64(process, address, &displacement, &line);
 
-            fprintf(stderr, "  #%02u: ", i);
-
-            if (gotSymbol)
+            if (gotSymbol && gotLine)
             {
-                fprintf(stderr, "%s - ", symbol->Name);
+                snprintf(text, sizeof(text), "%s - %s:%lu", symbol->Name, line.FileName, line.LineNumber);
+            }
+            else if (gotSymbol)
+            {
+                snprintf(text, sizeof(text), "%s - 0x%llX", symbol->Name, address);
             }
             else
             {
-                fprintf(stderr, "0x%llX - ", address);
+                snprintf(text, sizeof(text), "0x%llX", address);
+            }
+            lines.emplace_back(text);
+        }
+        return lines;
+    }
+
+    bool stack_tracer::install_crash_handlers() noexcept
+    {
+        bool ok = true;
+        for (int sig : { SIGSEGV, SIGABRT, SIGFPE, SIGILL })
+        {
+            ok = (std::signal(sig, verborgen::crash_handler) != SIG_ERR) && ok;
+        }
+        verborgen::g_crash_handlers_installed.store(true, std::memory_order_release);
+        return ok;
+    }
+
+    bool stack_tracer::install_thread_alt_stack() noexcept
+    {
+        return false;
+    }
+}
+
+
+#elif defined(__linux__)
+
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <signal.h>
+#include <unistd.h>
+
+namespace utils
+{
+    namespace verborgen
+    {
+        constexpr int mc_CRASH_SIGNALS[] = { SIGSEGV, SIGABRT, SIGBUS, SIGFPE, SIGILL };
+        constexpr std::size_t mc_ALT_STACK_SIZE = 64 * 1024;
+
+        volatile sig_atomic_t g_in_crash_handler = 0;
+
+        /** @brief backtrace()首次调用会加载libgcc_s并分配内存，预热后方可在信号处理中使用 */
+        class backtrace_initializer
+        {
+        public:
+            backtrace_initializer()
+            {
+                void* frame;
+                backtrace(&frame, 1);
             }
+        };
 
-            if (gotLine)
+        /** @brief 仅使用write(2) */
+        void write_stderr(const char* text, std::size_t len) noexcept
+        {
+            std::size_t done = 0;
+            while (done < len)
             {
-                fprintf(stderr, "%s:%lu\n", line.FileName, line.LineNumber);
+                const ssize_t c_written = write(STDERR_FILENO, text + done, len - done);
+                if (c_written <= 0)
+                {
+                    return;
+                }
+                done += static_cast<std::size_t>(c_written);
             }
-            else
+        }
+
+        const char* signal_name(int sig) noexcept
+        {
+            switch (sig)
+            {
+            case SIGSEGV:   return "SIGSEGV";
+            case SIGABRT:   return "SIGABRT";
+            case SIGBUS:    return "SIGBUS";
+            case SIGFPE:    return "SIGFPE";
+            case SIGILL:    return "SIGILL";
+            default:        return "signal";
+            }
+        }
+
+        void crash_handler(int sig, siginfo_t* info, void*)
+        {
+            // 1-处理过程中再次崩溃时直接按默认行为终止
+            if (g_in_crash_handler != 0)
+            {
+                signal(sig, SIG_DFL);
+                raise(sig);
+                return;
+            }
+            g_in_crash_handler = 1;
+
+            // 2-输出信号信息与原始调用栈，backtrace_symbols_fd不分配内存
+            write_text("Fatal ");
+            write_text(signal_name(sig));
+            if (sig != SIGABRT && info != nullptr)
             {
-                fprintf(stderr, "0x%llX\n", address);
+                write_text(" at address ");
+                write_hex(reinterpret_cast<uintptr_t>(info->si_addr));
             }
+            write_text(".\nRaw stack trace (symbolize offline with addr2line -Cfpe <module> <offset>):\n");
+
+            stack_tracer::trace tr;
+            stack_tracer::capture(tr, 1);
+            backtrace_symbols_fd(tr.m_frames, static_cast<int>(tr.m_size), STDERR_FILENO);
+
+            // 3-恢复默认处理并重新触发，保留核心转储与退出码
+            signal(sig, SIG_DFL);
+            raise(sig);
         }
 
-        free(symbol);
+        /** @brief 线程的备用信号栈，使栈溢出时仍能执行处理函数；线程退出时先撤销再释放 */
+        class alt_stack
+        {
+        public:
+            alt_stack() noexcept = default;
+
+            ~alt_stack()
+            {
+                if (m_memory == nullptr)
+                {
+                    return;
+                }
+                stack_t ss{};
+                ss.ss_flags = SS_DISABLE;
+                if (sigaltstack(&ss, nullptr) == 0)
+                {
+                    std::free(m_memory);
+                }
+            }
+
+            alt_stack(const alt_stack&) = delete;
+            alt_stack& operator=(const alt_stack&) = delete;
+
+            bool install() noexcept
+            {
+                if (m_memory != nullptr)
+                {
+                    return true;
+                }
+                stack_t ss{};
+                ss.ss_sp = std::malloc(mc_ALT_STACK_SIZE);
+                if (ss.ss_sp == nullptr)
+                {
+                    return false;
+                }
+                ss.ss_size = mc_ALT_STACK_SIZE;
+                ss.ss_flags = 0;
+                if (sigaltstack(&ss, nullptr) != 0)
+                {
+                    std::free(ss.ss_sp);
+                    return false;
+                }
+                m_memory = ss.ss_sp;
+                return true;
+            }
+
+        private:
+            void* m_memory = nullptr;
+        };
+
+        thread_local alt_stack t_alt_stack;
+    }
+    static verborgen::backtrace_initializer g_backtrace_init;
+
+    uint32_t stack_tracer::capture(trace& out, std::size_t skip) noexcept
+    {
+        // 多采集skip+1帧后整体前移，跳过capture自身及调用方指定的帧
+        void* frames[mc_MAX_FRAMES + 16];
+        const std::size_t c_skip = std::min<std::size_t>(skip + 1, 16);
+        const int c_got = backtrace(frames, static_cast<int>(mc_MAX_FRAMES + c_skip));
+        const std::size_t c_keep = (static_cast<std::size_t>(c_got) > c_skip) ? static_cast<std::size_t>(c_got) - c_skip : 0;
+        std::memcpy(out.m_frames, frames + c_skip, c_keep * sizeof(void*));
+        out.m_size = static_cast<uint32_t>(c_keep);
+        return out.m_size;
     }
-}
 
+    std::vector<std::string> stack_tracer::symbolize(const trace& tr)
+    {
+        std::vector<std::string> lines;
+        lines.reserve(tr.m_size);
+        char text[64];
 
-#elif defined(__linux__)
+        for (uint32_t i = 0; i < tr.m_size; ++i)
+        {
+            // 返回地址指向调用指令之后，减1落回调用指令以免解析到下一个函数
+            const uintptr_t c_addr = reinterpret_cast<uintptr_t>(tr.m_frames[i]);
+            const uintptr_t c_lookup = (c_addr == 0) ? 0 : c_addr - 1;
+
+            Dl_info info{};
+            if (dladdr(reinterpret_cast<void*>(c_lookup), &info) == 0)
+            {
+                snprintf(text, sizeof(text), "0x%zx", static_cast<std::size_t>(c_addr));
+                lines.emplace_back(text);
+                continue;
+            }
+
+            std::string line;
+            if (info.dli_sname != nullptr)
+            {
+                int status = -1;
+                char* demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+                line = (status == 0 && demangled != nullptr) ? demangled : info.dli_sname;
+                std::free(demangled);
+                snprintf(text, sizeof(text), "+0x%zx", static_cast<std::size_t>(c_addr - reinterpret_cast<uintptr_t>(info.dli_saddr)));
+                line += text;
+            }
+            else
+            {
+                snprintf(text, sizeof(text), "0x%zx", static_cast<std::size_t>(c_addr));
+                line = text;
+            }
+
+            if (info.dli_fname != nullptr)
+            {
+                snprintf(text, sizeof(text), "+0x%zx)", static_cast<std::size_t>(c_lookup - reinterpret_cast<uintptr_t>(info.dli_fbase)));
+                line += std::string(" (") + info.dli_fname + text;
+            }
+            lines.push_back(std::move(line));
+        }
+        return lines;
+    }
+
+    bool stack_tracer::install_crash_handlers() noexcept
+    {
+        bool ok = verborgen::t_alt_stack.install();
 
-#error "Coming soon."
+        struct sigaction sa{};
+        sa.sa_sigaction = verborgen::crash_handler;
+        sa.sa_flags = SA_SIGINFO | SA_ONSTACK;
+        sigemptyset(&sa.sa_mask);
+        for (int sig : verborgen::mc_CRASH_SIGNALS)
+        {
+            ok = (sigaction(sig, &sa, nullptr) == 0) && ok;
+        }
+        verborgen::g_crash_handlers_installed.store(true, std::memory_order_release);
+        return ok;
+    }
+
+    bool stack_tracer::install_thread_alt_stack() noexcept
+    {
+        if (!verborgen::g_crash_handlers_installed.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+        return verborgen::t_alt_stack.install();
+    }
+}
 
 #else
 #error "Unsupported Operating System."
 #endif
+
+namespace utils
+{
+    void stack_tracer::print(std::size_t max_frames) noexcept
+    {
+        trace tr;
+        capture(tr, 1);
+        tr.m_size = static_cast<uint32_t>(std::min<std::size_t>(tr.m_size, max_frames));
+        print(tr, stderr);
+    }
+
+    void stack_tracer::print(const trace& tr, FILE* out) noexcept
+    {
+        try
+        {
+            const std::vector<std::string> lines = symbolize(tr);
+            fprintf(out, "Stack trace (%u frames):\n", tr.m_size);
+            for (std::size_t i = 0; i < lines.size(); ++i)
+            {
+                fprintf(out, "  #%02zu: %s\n", i, lines[i].c_str());
+            }
+        }
+        catch (...)
+        {
+            fprintf(out, "  [Error] Failed to symbolize the stack trace.\n");
+        }
+    }
+}
@@ -0,0 +1,159 @@
+#include "core/coro/coro_pool.hpp"
+
+#include <exception>
+
+#include "auxkit/logger.hpp"
+#include "auxkit/stack_tracer.hpp"
+#include "core/numa/numa_topology.hpp"
+
+namespace
+{
+    thread_local unsigned t_worker = 0;     // 当前线程在所属池中的编号
+
+    /** @brief 顶层任务的外壳：创建即执行，结束时自行销毁协程帧 */
+    struct detached
+    {
+        struct promise_type
+        {
+            detached get_return_object() const noexcept { return {}; }
+            std::suspend_never initial_suspend() const noexcept { return {}; }
+            std::suspend_never final_suspend() const noexcept { return {}; }
+            void return_void() const noexcept {}
+            void unhandled_exception() const noexcept { std::terminate(); }
+        };
+    };
+}
+
+mpmt::coro_pool::coro_pool(const config& cfg) :
+    m_mutex(),
+    m_ready_cv(),
+    m_idle_cv(),
+    m_ready(),
+    m_pending(0),
+    m_stop(false),
+    m_threads()
+{
+    unsigned threads = cfg.m_threads;
+    if (threads == 0)
+    {
+        threads = std::thread::hardware_concurrency();
+    }
+    threads = threads == 0 ? 1 : threads;
+
+    m_threads.reserve(threads);
+    for (unsigned w = 0; w < threads; ++w)
+    {
+        std::vector<uint32_t> cpus;
+        if (cfg.m_pin_workers)
+        {
+            const numa_topology& topo = numa_topology::system();
+            cpus = topo.nodes()[w % topo.num_nodes()].m_cpus;
+        }
+        m_threads.emplace_back([this, w, cpus]
+        {
+            if (!cpus.empty() && !numa_topology::pin_current_thread(cpus))
+            {
+                MPMT_LOG_DEBUG("coroutine worker could not be pinned", "worker", w);
+            }
+            work(w);
+        });
+    }
+}
+
+void mpmt::coro_pool::spawn(coro_task<void>&& task)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_pending;
+    }
+
+    // 外壳协程先转移到池内线程，再等待任务本体；任务帧在计数减一之前销毁，wait_idle()返回后不再访问任务状态
+    [](coro_pool& pool, coro_task<void> body) -> detached
+    {
+        co_await pool.schedule();
+        {
+            coro_task<void> running = std::move(body);
+            try
+            {
+                co_await running;
+            }
+            catch (const std::exception& e)
+            {
+                MPMT_LOG_WARN("coroutine task failed", "worker", worker_index(), "what", e.what());
+            }
+            catch (...)
+            {
+                MPMT_LOG_WARN("coroutine task failed", "worker", worker_index(), "what", "non-standard exception");
+            }
+        }
+        pool.finish();
+    }(*this, std::move(task));
+}
+
+void mpmt::coro_pool::post(std::coroutine_handle<> handle)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_ready.push_back(handle);
+    }
+    m_ready_cv.notify_one();
+}
+
+void mpmt::coro_pool::wait_idle()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idle_cv.wait(lock, [this] { return m_pending == 0; });
+}
+
+unsigned mpmt::coro_pool::worker_index() noexcept
+{
+    return t_worker;
+}
+
+mpmt::coro_pool::~coro_pool()
+{
+    wait_idle();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_ready_cv.notify_all();
+    for (std::thread& th : m_threads)
+    {
+        th.join();
+    }
+}
+
+void mpmt::coro_pool::work(unsigned worker)
+{
+    t_worker = worker;
+    utils::stack_tracer::install_thread_alt_stack();
+    for (;;)
+    {
+        std::coroutine_handle<> handle;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_ready_cv.wait(lock, [this] { return m_stop || !m_ready.empty(); });
+            if (m_ready.empty())
+            {
+                return;
+            }
+            handle = m_ready.front();
+            m_ready.pop_front();
+        }
+        handle.resume();
+    }
+}
+
+void mpmt::coro_pool::finish()
+{
+    bool idle = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        idle = --m_pending == 0;
+    }
+    if (idle)
+    {
+        m_idle_cv.notify_all();
+    }
+}
@@ -1,7 +1,10 @@
 #include "core/crc/crc64.hpp"
+#include "auxkit/profiler.hpp"
 
 uint64_t mpmt::crc64::compute(const uint8_t* const data, const uint64_t len)
 {
+    MPMT_PROF_SCOPE("crc64::compute");
+    MPMT_PROF_COUNT(CRC_BYTES, len);
     uint64_t crc_reg = m_mask;
     for (uint64_t i = 0; i < len; ++i)
     {
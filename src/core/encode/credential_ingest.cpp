@@ -0,0 +1,148 @@
+#include "core/encode/credential_ingest.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "auxkit/profiler.hpp"
+#include "core/exception/encode_exc.hpp"
+#include "core/io/mapped_file.hpp"
+
+mpmt::credential_ingest::credential_ingest(const config& cfg, const hash_adapter& hasher)
+    :
+    mc_num_slots(cfg.m_num_slots),
+    mc_num_hashes(std::max<uint8_t>(1, cfg.m_num_hashes)),
+    m_num_threads(cfg.m_num_threads),
+    m_hasher(hasher)
+{
+    if (mc_num_slots == 0)
+    {
+        throw encode_exc
+        (
+            encode_exc::exc_type::INVALID_PARAMETER,
+            "credential_ingest requires a non-zero number of slots."
+        );
+    }
+    if (m_num_threads == 0)
+    {
+        m_num_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+}
+
+mpmt::slot_indicator mpmt::credential_ingest::encode_file(const std::string& csv_path) const
+{
+    try
+    {
+        const mapped_file file(csv_path);
+        return encode_buffer(reinterpret_cast<const char*>(file.data()), file.size());
+    }
+    catch (const std::runtime_error& e)
+    {
+        throw encode_exc(encode_exc::exc_type::IOFLOW_ERROR, e.what());
+    }
+}
+
+mpmt::slot_indicator mpmt::credential_ingest::encode_buffer(const char* text, uint64_t len) const
+{
+    MPMT_PROF_SCOPE("credential_ingest::encode_buffer");
+    slot_indicator result(mc_num_slots);
+    if (len == 0)
+    {
+        return result;
+    }
+
+    // 1-确定线程数，小文件不值得多线程
+    const uint64_t c_threads = std::max<uint64_t>
+    (
+        1,
+        std::min<uint64_t>(m_num_threads, len / mc_MIN_BYTES_PER_THREAD)
+    );
+
+    // 2-按字节等分后将切分点推进到下一行首，保证每行恰好属于一个线程
+    std::vector<const char*> cuts(c_threads + 1);
+    const char* const c_end = text + len;
+    cuts[0] = text;
+    cuts[c_threads] = c_end;
+    for (uint64_t t = 1; t < c_threads; ++t)
+    {
+        const char* p = std::max(text + len / c_threads * t, cuts[t - 1]);
+        const void* nl = std::memchr(p, '\n', static_cast<size_t>(c_end - p));
+        cuts[t] = (nl == nullptr) ? c_end : static_cast<const char*>(nl) + 1;
+    }
+
+    // 3-并行编码
+    std::vector<std::thread> pool;
+    pool.reserve(c_threads - 1);
+    for (uint64_t t = 1; t < c_threads; ++t)
+    {
+        pool.emplace_back([this, &cuts, &result, t] { encode_range(cuts[t], cuts[t + 1], result); });
+    }
+    encode_range(cuts[0], cuts[1], result);
+    for (std::thread& th : pool)
+    {
+        th.join();
+    }
+
+    return result;
+}
+
+void mpmt::credential_ingest::slots_of(const char* credential, uint64_t len, uint64_t* slots) const
+{
+    const uint8_t* key = reinterpret_cast<const uint8_t*>(credential);
+    m_hasher.indices_batch(&key, &len, 1, mc_num_hashes, mc_num_slots, slots);
+}
+
+void mpmt::credential_ingest::encode_range(const char* begin, const char* end, slot_indicator& out) const
+{
+    std::vector<const uint8_t*> keys;
+    std::vector<uint64_t> lens;
+    std::vector<uint64_t> slots(mc_BATCH_SIZE * mc_num_hashes);
+    keys.reserve(mc_BATCH_SIZE);
+    lens.reserve(mc_BATCH_SIZE);
+
+    auto flush = [&]()
+    {
+        m_hasher.indices_batch(keys.data(), lens.data(), keys.size(), mc_num_hashes, mc_num_slots, slots.data());
+        for (uint64_t i = 0; i < keys.size() * mc_num_hashes; ++i)
+        {
+            out.set(slots[i]);
+        }
+        keys.clear();
+        lens.clear();
+    };
+
+    const char* line = begin;
+    while (line < end)
+    {
+        const void* nl = std::memchr(line, '\n', static_cast<size_t>(end - line));
+        const char* line_end = (nl == nullptr) ? end : static_cast<const char*>(nl);
+
+        // 取第一列并去除首尾空白（含\r）
+        const void* comma = std::memchr(line, ',', static_cast<size_t>(line_end - line));
+        const char* field_end = (comma == nullptr) ? line_end : static_cast<const char*>(comma);
+        const char* field_begin = line;
+        while (field_begin < field_end && (*field_begin == ' ' || *field_begin == '\t'))
+        {
+            ++field_begin;
+        }
+        while (field_end > field_begin && (field_end[-1] == '\r' || field_end[-1] == ' ' || field_end[-1] == '\t'))
+        {
+            --field_end;
+        }
+
+        if (field_end > field_begin)
+        {
+            keys.push_back(reinterpret_cast<const uint8_t*>(field_begin));
+            lens.push_back(static_cast<uint64_t>(field_end - field_begin));
+            if (keys.size() == mc_BATCH_SIZE)
+            {
+                flush();
+            }
+        }
+        // 末行无换行符时line_end == end，不得越过区间末尾
+        line = (line_end == end) ? end : line_end + 1;
+    }
+    flush();
+}
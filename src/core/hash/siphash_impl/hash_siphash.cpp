@@ -0,0 +1,225 @@
+#include "core/hash/siphash_impl/hash_siphash.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+    inline uint64_t rotl(uint64_t x, int b) noexcept
+    {
+        return (x << b) | (x >> (64 - b));
+    }
+
+    inline uint64_t load_le64(const uint8_t* p) noexcept
+    {
+        uint64_t v = 0;
+        for (int i = 0; i < 8; ++i)
+        {
+            v |= static_cast<uint64_t>(p[i]) << (8 * i);
+        }
+        return v;
+    }
+
+    inline void sip_round(uint64_t& v0, uint64_t& v1, uint64_t& v2, uint64_t& v3) noexcept
+    {
+        v0 += v1; v1 = rotl(v1, 13); v1 ^= v0; v0 = rotl(v0, 32);
+        v2 += v3; v3 = rotl(v3, 16); v3 ^= v2;
+        v0 += v3; v3 = rotl(v3, 21); v3 ^= v0;
+        v2 += v1; v1 = rotl(v1, 17); v1 ^= v2; v2 = rotl(v2, 32);
+    }
+
+    /**
+     * @brief   SipHash-2-4，WIDE为true时为128位输出变体（初始v1 ^= 0xee，终结时再挤出一个64位字）
+     * @param   uint64_t k0, k1 密钥
+     * @param   const uint8_t* data 数据
+     * @param   uint64_t len 数据长度（字节）
+     * @param   uint64_t* out 输出（WIDE时2个字，否则1个字）
+     */
+    template <bool WIDE>
+    void sip24(uint64_t k0, uint64_t k1, const uint8_t* data, uint64_t len, uint64_t* out) noexcept
+    {
+        uint64_t v0 = 0x736f6d6570736575ULL ^ k0;
+        uint64_t v1 = 0x646f72616e646f6dULL ^ k1 ^ (WIDE ? 0xeeULL : 0ULL);
+        uint64_t v2 = 0x6c7967656e657261ULL ^ k0;
+        uint64_t v3 = 0x7465646279746573ULL ^ k1;
+
+        // 1-压缩完整的8字节分组
+        const uint64_t c_full = len & ~uint64_t(7);
+        for (uint64_t i = 0; i < c_full; i += 8)
+        {
+            const uint64_t m = load_le64(data + i);
+            v3 ^= m;
+            sip_round(v0, v1, v2, v3);
+            sip_round(v0, v1, v2, v3);
+            v0 ^= m;
+        }
+
+        // 2-压缩尾部分组（最高字节为长度低8位）
+        uint64_t b = static_cast<uint64_t>(len) << 56;
+        for (uint64_t i = 0; i < (len & 7); ++i)
+        {
+            b |= static_cast<uint64_t>(data[c_full + i]) << (8 * i);
+        }
+        v3 ^= b;
+        sip_round(v0, v1, v2, v3);
+        sip_round(v0, v1, v2, v3);
+        v0 ^= b;
+
+        // 3-终结
+        v2 ^= WIDE ? 0xeeULL : 0xffULL;
+        for (int i = 0; i < 4; ++i)
+        {
+            sip_round(v0, v1, v2, v3);
+        }
+        out[0] = v0 ^ v1 ^ v2 ^ v3;
+        if (WIDE)
+        {
+            v1 ^= 0xdd;
+            for (int i = 0; i < 4; ++i)
+            {
+                sip_round(v0, v1, v2, v3);
+            }
+            out[1] = v0 ^ v1 ^ v2 ^ v3;
+        }
+    }
+
+    /**
+     * @brief   每L个字节串交错计算SipHash-2-4，不足一组的剩余部分逐个计算
+     * @param   uint64_t* out 输出（WIDE时每个字节串2个字，否则1个字）
+     */
+    template <uint64_t L, bool WIDE>
+    void sip24_lanes
+    (
+        uint64_t k0,
+        uint64_t k1,
+        const uint8_t* const* keys,
+        const uint64_t* lens,
+        uint64_t n,
+        uint64_t* out
+    ) noexcept
+    {
+        constexpr uint64_t c_words = WIDE ? 2 : 1;
+        const uint64_t c_grouped = n - n % L;
+
+        for (uint64_t base = 0; base < c_grouped; base += L)
+        {
+            uint64_t v0[L], v1[L], v2[L], v3[L], nblk[L];
+            uint64_t max_blk = 0;
+            for (uint64_t l = 0; l < L; ++l)
+            {
+                v0[l] = 0x736f6d6570736575ULL ^ k0;
+                v1[l] = 0x646f72616e646f6dULL ^ k1 ^ (WIDE ? 0xeeULL : 0ULL);
+                v2[l] = 0x6c7967656e657261ULL ^ k0;
+                v3[l] = 0x7465646279746573ULL ^ k1;
+                nblk[l] = lens[base + l] >> 3;
+                max_blk = std::max(max_blk, nblk[l]);
+            }
+
+            // 1-各路同步压缩完整分组，已结束的路通过掩码保持状态不变
+            for (uint64_t j = 0; j < max_blk; ++j)
+            {
+                uint64_t m[L], keep[L];
+                for (uint64_t l = 0; l < L; ++l)
+                {
+                    const bool active = j < nblk[l];
+                    m[l] = active ? load_le64(keys[base + l] + (j << 3)) : 0;
+                    keep[l] = active ? 0 : ~uint64_t(0);
+                }
+
+                uint64_t a0[L], a1[L], a2[L], a3[L];
+                for (uint64_t l = 0; l < L; ++l)
+                {
+                    a0[l] = v0[l]; a1[l] = v1[l]; a2[l] = v2[l]; a3[l] = v3[l] ^ m[l];
+                    sip_round(a0[l], a1[l], a2[l], a3[l]);
+                    sip_round(a0[l], a1[l], a2[l], a3[l]);
+                    a0[l] ^= m[l];
+                    v0[l] = (v0[l] & keep[l]) | (a0[l] & ~keep[l]);
+                    v1[l] = (v1[l] & keep[l]) | (a1[l] & ~keep[l]);
+                    v2[l] = (v2[l] & keep[l]) | (a2[l] & ~keep[l]);
+                    v3[l] = (v3[l] & keep[l]) | (a3[l] & ~keep[l]);
+                }
+            }
+
+            // 2-尾部分组与终结，各路同步进行
+            uint64_t b[L];
+            for (uint64_t l = 0; l < L; ++l)
+            {
+                const uint64_t c_len = lens[base + l];
+                const uint8_t* tail = keys[base + l] + (c_len & ~uint64_t(7));
+                b[l] = c_len << 56;
+                for (uint64_t i = 0; i < (c_len & 7); ++i)
+                {
+                    b[l] |= static_cast<uint64_t>(tail[i]) << (8 * i);
+                }
+            }
+            for (uint64_t l = 0; l < L; ++l)
+            {
+                v3[l] ^= b[l];
+                sip_round(v0[l], v1[l], v2[l], v3[l]);
+                sip_round(v0[l], v1[l], v2[l], v3[l]);
+                v0[l] ^= b[l];
+                v2[l] ^= WIDE ? 0xeeULL : 0xffULL;
+                sip_round(v0[l], v1[l], v2[l], v3[l]);
+                sip_round(v0[l], v1[l], v2[l], v3[l]);
+                sip_round(v0[l], v1[l], v2[l], v3[l]);
+                sip_round(v0[l], v1[l], v2[l], v3[l]);
+                out[(base + l) * c_words] = v0[l] ^ v1[l] ^ v2[l] ^ v3[l];
+                if (WIDE)
+                {
+                    v1[l] ^= 0xdd;
+                    sip_round(v0[l], v1[l], v2[l], v3[l]);
+                    sip_round(v0[l], v1[l], v2[l], v3[l]);
+                    sip_round(v0[l], v1[l], v2[l], v3[l]);
+                    sip_round(v0[l], v1[l], v2[l], v3[l]);
+                    out[(base + l) * c_words + 1] = v0[l] ^ v1[l] ^ v2[l] ^ v3[l];
+                }
+            }
+        }
+
+        // 3-不足一组的剩余部分逐个计算
+        for (uint64_t i = c_grouped; i < n; ++i)
+        {
+            sip24<WIDE>(k0, k1, keys[i], lens[i], out + i * c_words);
+        }
+    }
+}
+
+mpmt::hash_siphash::hash_siphash(const key_type& key) noexcept
+    :
+    m_k0(load_le64(key.data())),
+    m_k1(load_le64(key.data() + 8))
+{}
+
+uint64_t mpmt::hash_siphash::hash(const uint8_t* data, uint64_t len) const noexcept
+{
+    uint64_t out = 0;
+    sip24<false>(m_k0, m_k1, data, len, &out);
+    return out;
+}
+
+void mpmt::hash_siphash::hash128(const uint8_t* data, uint64_t len, uint64_t* out) const noexcept
+{
+    sip24<true>(m_k0, m_k1, data, len, out);
+}
+
+void mpmt::hash_siphash::hash_batch
+(
+    const uint8_t* const* keys,
+    const uint64_t* lens,
+    uint64_t n,
+    uint64_t* out
+) const noexcept
+{
+    sip24_lanes<mc_LANES, false>(m_k0, m_k1, keys, lens, n, out);
+}
+
+void mpmt::hash_siphash::hash128_batch
+(
+    const uint8_t* const* keys,
+    const uint64_t* lens,
+    uint64_t n,
+    uint64_t* out
+) const noexcept
+{
+    sip24_lanes<mc_LANES, true>(m_k0, m_k1, keys, lens, n, out);
+}
@@ -0,0 +1,811 @@
+#include "core/io/direct_impl/io_direct.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "auxkit/logger.hpp"
+#include "auxkit/profiler.hpp"
+
+#if defined(__linux__)
+
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#if defined(__NR_io_uring_setup) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#define MPMT_IO_URING
+#endif
+#endif
+
+namespace mpmt
+{
+    namespace verborgen
+    {
+#if defined(MPMT_IO_URING)
+        /**
+         * @class   最小的io_uring封装：直接使用系统调用与共享环，不依赖liburing
+         * @note    调用方保证在途请求数不超过创建时的entries，因而提交队列与完成队列不会溢出。
+         */
+        class uring
+        {
+        public:
+            static constexpr uint64_t mc_CANCEL_TAG = 1ULL << 63;  // 撤销请求的user_data标记，其完成项不交给调用方
+
+            /**
+             * @brief   创建实例
+             * @param   uint32_t entries 队列深度
+             * @return  std::unique_ptr<uring> 内核不支持或被禁止时为空
+             */
+            static std::unique_ptr<uring> create(uint32_t entries) noexcept
+            {
+                io_uring_params params{};
+                const int c_fd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+                if (c_fd < 0)
+                {
+                    return nullptr;
+                }
+                std::unique_ptr<uring> ring(new uring(c_fd));
+
+                // IORING_OP_READ/WRITE与IORING_FEAT_RW_CUR_POS同在5.6引入，以后者判断内核是否支持前者
+                if ((params.features & IORING_FEAT_RW_CUR_POS) == 0 || !ring->map(params))
+                {
+                    return nullptr;
+                }
+                return ring;
+            }
+
+            ~uring()
+            {
+                if (m_sqes != MAP_FAILED)
+                {
+                    munmap(m_sqes, m_sqes_len);
+                }
+                if (m_cq_ptr != MAP_FAILED && m_cq_ptr != m_sq_ptr)
+                {
+                    munmap(m_cq_ptr, m_cq_len);
+                }
+                if (m_sq_ptr != MAP_FAILED)
+                {
+                    munmap(m_sq_ptr, m_sq_len);
+                }
+                close(m_fd);
+            }
+
+            /** @brief 放入一个读写请求，待submit_and_wait()提交 */
+            void push(bool write, int fd, uint8_t* buf, uint32_t len, uint64_t offset, uint64_t user_data) noexcept
+            {
+                const unsigned c_tail = *m_sq_tail;
+                const unsigned c_idx = c_tail & *m_sq_mask;
+                io_uring_sqe& sqe = m_sqes[c_idx];
+                std::memset(&sqe, 0, sizeof(sqe));
+                sqe.opcode = write ? IORING_OP_WRITE : IORING_OP_READ;
+                sqe.fd = fd;
+                sqe.addr = reinterpret_cast<uint64_t>(buf);
+                sqe.len = len;
+                sqe.off = offset;
+                sqe.user_data = user_data;
+                m_sq_array[c_idx] = c_idx;
+                __atomic_store_n(m_sq_tail, c_tail + 1, __ATOMIC_RELEASE);
+                ++m_to_submit;
+            }
+
+            /**
+             * @brief   放入一个撤销请求（IORING_OP_ASYNC_CANCEL），撤销user_data对应的在途请求
+             * @return  bool 提交队列已满时为false
+             */
+            bool cancel(uint64_t user_data) noexcept
+            {
+                const unsigned c_tail = *m_sq_tail;
+                if (c_tail - __atomic_load_n(m_sq_head, __ATOMIC_ACQUIRE) >= m_sq_entries)
+                {
+                    return false;
+                }
+                const unsigned c_idx = c_tail & *m_sq_mask;
+                io_uring_sqe& sqe = m_sqes[c_idx];
+                std::memset(&sqe, 0, sizeof(sqe));
+                sqe.opcode = IORING_OP_ASYNC_CANCEL;
+                sqe.fd = -1;
+                sqe.addr = user_data;
+                sqe.user_data = mc_CANCEL_TAG | user_data;
+                m_sq_array[c_idx] = c_idx;
+                __atomic_store_n(m_sq_tail, c_tail + 1, __ATOMIC_RELEASE);
+                ++m_to_submit;
+                return true;
+            }
+
+            /**
+             * @brief   提交已放入的请求并等待至少wait_nr个完成
+             * @return  int 成功为0，失败为-errno
+             */
+            int submit_and_wait(uint32_t wait_nr) noexcept
+            {
+                for (;;)
+                {
+                    const int c_ret = static_cast<int>(syscall
+                    (
+                        __NR_io_uring_enter, m_fd, m_to_submit, wait_nr, IORING_ENTER_GETEVENTS, nullptr, 0
+                    ));
+                    if (c_ret >= 0)
+                    {
+                        m_to_submit -= std::min<uint32_t>(m_to_submit, static_cast<uint32_t>(c_ret));
+                        if (m_to_submit == 0)
+                        {
+                            return 0;
+                        }
+                        continue;
+                    }
+                    if (errno != EINTR)
+                    {
+                        return -errno;
+                    }
+                }
+            }
+
+            /**
+             * @brief   取出全部已完成的请求（撤销请求自身的完成项直接丢弃）
+             * @param   FN&& fn fn(user_data, res)
+             * @return  uint32_t 取出的读写请求个数
+             */
+            template <typename FN>
+            uint32_t reap(FN&& fn)
+            {
+                unsigned head = *m_cq_head;
+                const unsigned c_tail = __atomic_load_n(m_cq_tail, __ATOMIC_ACQUIRE);
+                uint32_t n = 0;
+                for (; head != c_tail; ++head)
+                {
+                    const io_uring_cqe& cqe = m_cqes[head & *m_cq_mask];
+                    if ((cqe.user_data & mc_CANCEL_TAG) == 0)
+                    {
+                        fn(cqe.user_data, cqe.res);
+                        ++n;
+                    }
+                }
+                __atomic_store_n(m_cq_head, head, __ATOMIC_RELEASE);
+                return n;
+            }
+
+        private:
+            explicit uring(int fd) noexcept : m_fd(fd) {}
+
+            /** @brief 映射提交队列、完成队列与请求数组 */
+            bool map(const io_uring_params& params) noexcept
+            {
+                m_sq_len = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+                m_cq_len = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+                const bool c_single = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+                if (c_single)
+                {
+                    m_sq_len = m_cq_len = std::max(m_sq_len, m_cq_len);
+                }
+
+                m_sq_ptr = mmap(nullptr, m_sq_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_SQ_RING);
+                if (m_sq_ptr == MAP_FAILED)
+                {
+                    return false;
+                }
+                m_cq_ptr = c_single
+                    ? m_sq_ptr
+                    : mmap(nullptr, m_cq_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_CQ_RING);
+                if (m_cq_ptr == MAP_FAILED)
+                {
+                    return false;
+                }
+                m_sqes_len = params.sq_entries * sizeof(io_uring_sqe);
+                void* sqes = mmap(nullptr, m_sqes_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_SQES);
+                if (sqes == MAP_FAILED)
+                {
+                    return false;
+                }
+                m_sqes = static_cast<io_uring_sqe*>(sqes);
+
+                uint8_t* sq = static_cast<uint8_t*>(m_sq_ptr);
+                uint8_t* cq = static_cast<uint8_t*>(m_cq_ptr);
+                m_sq_entries = params.sq_entries;
+                m_sq_head = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+                m_sq_tail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+                m_sq_mask = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+                m_sq_array = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+                m_cq_head = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+                m_cq_tail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+                m_cq_mask = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+                m_cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+                return true;
+            }
+
+            int m_fd;
+            void* m_sq_ptr = MAP_FAILED;
+            void* m_cq_ptr = MAP_FAILED;
+            io_uring_sqe* m_sqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+            std::size_t m_sq_len = 0;
+            std::size_t m_cq_len = 0;
+            std::size_t m_sqes_len = 0;
+            unsigned m_sq_entries = 0;
+            unsigned* m_sq_head = nullptr;
+            unsigned* m_sq_tail = nullptr;
+            unsigned* m_sq_mask = nullptr;
+            unsigned* m_sq_array = nullptr;
+            unsigned* m_cq_head = nullptr;
+            unsigned* m_cq_tail = nullptr;
+            unsigned* m_cq_mask = nullptr;
+            io_uring_cqe* m_cqes = nullptr;
+            uint32_t m_to_submit = 0;
+        };
+#else
+        /** @brief 内核头文件不提供io_uring时的占位实现 */
+        class uring
+        {
+        public:
+            static std::unique_ptr<uring> create(uint32_t) noexcept { return nullptr; }
+            void push(bool, int, uint8_t*, uint32_t, uint64_t, uint64_t) noexcept {}
+            bool cancel(uint64_t) noexcept { return false; }
+            int submit_and_wait(uint32_t) noexcept { return -ENOSYS; }
+            template <typename FN> uint32_t reap(FN&&) { return 0; }
+        };
+#endif
+
+        uint64_t align_down(uint64_t value) noexcept
+        {
+            return value & ~(io_direct::mc_ALIGN - 1);
+        }
+
+        uint64_t align_up(uint64_t value) noexcept
+        {
+            return align_down(value + io_direct::mc_ALIGN - 1);
+        }
+
+        uint8_t* aligned_new(uint64_t bytes)
+        {
+            void* ptr = std::aligned_alloc(io_direct::mc_ALIGN, bytes);
+            if (ptr == nullptr)
+            {
+                throw std::bad_alloc();
+            }
+            return static_cast<uint8_t*>(ptr);
+        }
+    }
+}
+
+void mpmt::io_direct::aligned_deleter::operator()(uint8_t* ptr) const noexcept
+{
+    std::free(ptr);
+}
+
+bool mpmt::io_direct::supported() noexcept
+{
+    // 以一次io_uring_setup探测：内核过旧、被seccomp或sysctl(kernel.io_uring_disabled)禁止时为false，结果缓存
+    static const bool s_supported = verborgen::uring::create(1) != nullptr;
+    return s_supported;
+}
+
+mpmt::io_direct::io_direct(const std::string& path, io_mode mode, uint32_t queue_depth, uint32_t chunk_bytes)
+    :
+    mc_path(path),
+    mc_mode(mode),
+    mc_queue_depth(queue_depth),
+    mc_chunk_bytes(chunk_bytes),
+    m_fd(-1),
+    m_direct(true),
+    m_padded(false),
+    m_size(0),
+    m_pool(),
+    m_edge(),
+    m_ring()
+{
+    if (queue_depth == 0 || chunk_bytes == 0 || chunk_bytes % mc_ALIGN != 0)
+    {
+        throw std::runtime_error
+        (
+            "Invalid direct I/O parameters for the file [" + path + "]: queue_depth=" + std::to_string(queue_depth)
+            + ", chunk_bytes=" + std::to_string(chunk_bytes) + "."
+        );
+    }
+
+    // 1-以O_DIRECT打开，文件系统不支持时退化为普通读写
+    int flags = O_CLOEXEC;
+    if (mode == io_mode::READ)
+    {
+        flags |= O_RDONLY;
+    }
+    else if (mode == io_mode::READ_WRITE)
+    {
+        flags |= O_RDWR;
+    }
+    else
+    {
+        flags |= O_RDWR | O_CREAT | O_TRUNC;
+    }
+    m_fd = open(path.c_str(), flags | O_DIRECT, 0644);
+    if (m_fd < 0 && errno == EINVAL)
+    {
+        m_direct = false;
+        m_fd = open(path.c_str(), flags, 0644);
+    }
+    if (m_fd < 0)
+    {
+        throw std::runtime_error("Can not open the file [" + path + "]: " + std::strerror(errno) + ".");
+    }
+
+    struct stat st{};
+    if (fstat(m_fd, &st) != 0)
+    {
+        const int c_err = errno;
+        close(m_fd);
+        throw std::runtime_error("Cannot get the size of the file [" + path + "] correctly: " + std::strerror(c_err) + ".");
+    }
+    m_size = static_cast<uint64_t>(st.st_size);
+
+    // 2-分配暂存区，按环境变量与内核能力决定是否启用io_uring
+    try
+    {
+        m_pool.reset(verborgen::aligned_new(static_cast<uint64_t>(queue_depth) * chunk_bytes));
+        m_edge.reset(verborgen::aligned_new(2 * mc_ALIGN));
+    }
+    catch (...)
+    {
+        close(m_fd);
+        throw;
+    }
+    const char* env = std::getenv("MPMT_IO_URING");
+    if (env == nullptr || std::strcmp(env, "0") != 0)
+    {
+        m_ring = verborgen::uring::create(queue_depth);
+    }
+}
+
+mpmt::io_direct::~io_direct()
+{
+    m_ring.reset();
+    if (m_padded)
+    {
+        (void)ftruncate(m_fd, static_cast<off_t>(m_size));
+    }
+    close(m_fd);
+}
+
+const char* mpmt::io_direct::backend() const noexcept
+{
+    if (!m_direct)
+    {
+        return "pread+fadvise";
+    }
+    return m_ring ? "io_uring+O_DIRECT" : "pread+O_DIRECT";
+}
+
+void mpmt::io_direct::read_at(uint64_t offset, uint8_t* out, uint64_t len)
+{
+    MPMT_PROF_SCOPE("io_direct::read_at");
+    if (offset > m_size || len > m_size - offset)
+    {
+        throw std::runtime_error
+        (
+            "Read of " + std::to_string(len) + " byte(s) at offset=" + std::to_string(offset)
+            + " exceeds the size of the file [" + mc_path + "]."
+        );
+    }
+    if (len == 0)
+    {
+        return;
+    }
+
+    const uint64_t c_end = offset + len;
+    const uint64_t c_a0 = verborgen::align_down(offset);
+    const uint64_t c_a1 = verborgen::align_up(c_end);
+    transfer(c_a0, c_a1, false, [&](uint64_t off, uint8_t* buf, uint64_t clen, uint64_t got)
+        {
+            const uint64_t c_lo = std::max(off, offset);
+            const uint64_t c_hi = std::min(off + clen, c_end);
+            if (c_hi > off + got)
+            {
+                throw std::runtime_error
+                (
+                    "Can not read data of length=" + std::to_string(len) + " from file[" + mc_path
+                    + "] at offset=" + std::to_string(offset) + " correctly: unexpected end of file."
+                );
+            }
+            std::memcpy(out + (c_lo - offset), buf + (c_lo - off), c_hi - c_lo);
+        });
+    drop_cache(c_a0, c_a1, false);
+}
+
+void mpmt::io_direct::write_at(uint64_t offset, const uint8_t* data, uint64_t len)
+{
+    MPMT_PROF_SCOPE("io_direct::write_at");
+    if (mc_mode == io_mode::READ)
+    {
+        throw std::runtime_error("The file [" + mc_path + "] is opened read-only.");
+    }
+    if (len == 0)
+    {
+        return;
+    }
+
+    // 1-读出非对齐的首尾扇区中不被覆盖的原有内容，逻辑长度之外补零
+    const uint64_t c_end = offset + len;
+    const uint64_t c_a0 = verborgen::align_down(offset);
+    const uint64_t c_a1 = verborgen::align_up(c_end);
+    const uint64_t c_tail_sector = c_a1 - mc_ALIGN;
+    uint8_t* const head = m_edge.get();
+    uint8_t* const tail = m_edge.get() + mc_ALIGN;
+    auto load_sector = [&](uint64_t sector, uint8_t* buf)
+        {
+            const uint64_t c_got = (sector < m_size) ? pread_full(sector, buf, mc_ALIGN) : 0;
+            const uint64_t c_valid = std::min<uint64_t>(c_got, m_size > sector ? m_size - sector : 0);
+            std::memset(buf + c_valid, 0, mc_ALIGN - c_valid);
+        };
+    if (offset != c_a0)
+    {
+        load_sector(c_a0, head);
+    }
+    if (c_end != c_a1)
+    {
+        if (c_tail_sector == c_a0 && offset != c_a0)
+        {
+            std::memcpy(tail, head, mc_ALIGN);
+        }
+        else
+        {
+            load_sector(c_tail_sector, tail);
+        }
+    }
+
+    // 2-逐片合并首扇区、数据与尾扇区后写入
+    transfer(c_a0, c_a1, true, [&](uint64_t off, uint8_t* buf, uint64_t clen, uint64_t)
+        {
+            const uint64_t c_lo = std::max(off, offset);
+            const uint64_t c_hi = std::min(off + clen, c_end);
+            if (c_lo < c_hi)
+            {
+                std::memcpy(buf + (c_lo - off), data + (c_lo - offset), c_hi - c_lo);
+            }
+            if (off < offset)
+            {
+                std::memcpy(buf, head + (off - c_a0), std::min(offset, off + clen) - off);
+            }
+            if (off + clen > c_end)
+            {
+                const uint64_t c_from = std::max(off, c_end);
+                std::memcpy(buf + (c_from - off), tail + (c_from - c_tail_sector), off + clen - c_from);
+            }
+        });
+
+    m_size = std::max(m_size, c_end);
+    m_padded = m_padded || c_a1 > m_size;
+    drop_cache(c_a0, c_a1, true);
+}
+
+void mpmt::io_direct::sync()
+{
+    MPMT_PROF_SCOPE("io_direct::sync");
+    if (m_padded)
+    {
+        if (ftruncate(m_fd, static_cast<off_t>(m_size)) != 0)
+        {
+            throw std::runtime_error("Can not truncate the file [" + mc_path + "]: " + std::strerror(errno) + ".");
+        }
+        m_padded = false;
+    }
+    // O_DIRECT不经页缓存，但元数据与设备缓存仍需同步
+    if (mc_mode != io_mode::READ && fdatasync(m_fd) != 0)
+    {
+        throw std::runtime_error("Can not sync the file [" + mc_path + "]: " + std::strerror(errno) + ".");
+    }
+}
+
+template <typename FN>
+void mpmt::io_direct::transfer(uint64_t a0, uint64_t a1, bool write, FN&& fn)
+{
+    const uint64_t c_chunks = (a1 - a0 + mc_chunk_bytes - 1) / mc_chunk_bytes;
+    auto chunk_len = [&](uint64_t idx) { return std::min<uint64_t>(mc_chunk_bytes, a1 - a0 - idx * mc_chunk_bytes); };
+    auto slot_buf = [&](uint64_t slot) { return m_pool.get() + slot * mc_chunk_bytes; };
+
+    // 同步读写一个片段；fill为false时buf中已是待写数据（io_uring撤销后重做）
+    auto sync_chunk = [&](uint64_t idx, uint8_t* buf, bool fill)
+    {
+        const uint64_t c_off = a0 + idx * mc_chunk_bytes;
+        const uint64_t c_len = chunk_len(idx);
+        if (write)
+        {
+            if (fill)
+            {
+                fn(c_off, buf, c_len, c_len);
+            }
+            pwrite_full(c_off, buf, c_len);
+        }
+        else
+        {
+            fn(c_off, buf, c_len, pread_full(c_off, buf, c_len));
+        }
+    };
+
+    // 1-无io_uring时逐片同步读写
+    if (!m_ring)
+    {
+        for (uint64_t idx = 0; idx < c_chunks; ++idx)
+        {
+            sync_chunk(idx, m_pool.get(), true);
+        }
+        return;
+    }
+
+    // 2-io_uring：保持至多queue_depth个片段在途，每完成一个即补充下一个；
+    //   出错时先等待在途请求全部完成再抛出，避免内核继续访问暂存区
+    const uint64_t c_slots = std::min<uint64_t>(mc_queue_depth, c_chunks);
+    std::vector<uint64_t> slot_chunk(c_slots);
+    std::vector<uint8_t> slot_busy(c_slots, 0);
+    std::vector<uint64_t> free_slots;
+    std::vector<uint64_t> cancelled;
+    free_slots.reserve(c_slots);
+    for (uint64_t s = c_slots; s > 0; --s)
+    {
+        free_slots.push_back(s - 1);
+    }
+    uint64_t next = 0;
+    uint64_t inflight = 0;
+    std::string error;
+    auto on_complete = [&](uint64_t slot, int32_t res)
+    {
+        slot_busy[slot] = 0;
+        if (res == -ECANCELED)
+        {
+            // 仅在放弃io_uring时撤销，该片段随后同步重做
+            cancelled.push_back(slot);
+            return;
+        }
+        free_slots.push_back(slot);
+        if (!error.empty())
+        {
+            return;
+        }
+        const uint64_t c_off = a0 + slot_chunk[slot] * mc_chunk_bytes;
+        const uint64_t c_len = chunk_len(slot_chunk[slot]);
+        try
+        {
+            if (res < 0)
+            {
+                throw std::runtime_error
+                (
+                    std::string(write ? "Can not write" : "Can not read") + " data of length=" + std::to_string(c_len)
+                    + (write ? " to file[" : " from file[") + mc_path + "] at offset=" + std::to_string(c_off)
+                    + " correctly: " + std::strerror(-res) + "."
+                );
+            }
+            // 短读写时同步补齐剩余部分；O_DIRECT下非对齐的短读只可能发生在文件末尾
+            uint64_t done = static_cast<uint64_t>(res);
+            if (write)
+            {
+                if (done < c_len)
+                {
+                    pwrite_full(c_off + done, slot_buf(slot) + done, c_len - done);
+                }
+            }
+            else
+            {
+                if (done < c_len && (!m_direct || done % mc_ALIGN == 0))
+                {
+                    done += pread_full(c_off + done, slot_buf(slot) + done, c_len - done);
+                }
+                fn(c_off, slot_buf(slot), c_len, done);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error = e.what();
+        }
+    };
+    while (inflight != 0 || (next < c_chunks && error.empty()))
+    {
+        while (error.empty() && next < c_chunks && !free_slots.empty())
+        {
+            const uint64_t c_slot = free_slots.back();
+            const uint64_t c_off = a0 + next * mc_chunk_bytes;
+            const uint64_t c_len = chunk_len(next);
+            if (write)
+            {
+                fn(c_off, slot_buf(c_slot), c_len, c_len);
+            }
+            free_slots.pop_back();
+            slot_chunk[c_slot] = next++;
+            slot_busy[c_slot] = 1;
+            m_ring->push(write, m_fd, slot_buf(c_slot), static_cast<uint32_t>(c_len), c_off, c_slot);
+            ++inflight;
+        }
+
+        const int c_ret = m_ring->submit_and_wait(1);
+        if (c_ret >= 0)
+        {
+            inflight -= m_ring->reap(on_complete);
+            continue;
+        }
+
+        // 3-io_uring_enter失败：撤销在途请求并回收全部完成项，确认内核不再访问暂存区后放弃io_uring，
+        //   被撤销的片段与尚未提交的片段改为同步读写；无法回收时放弃暂存区（不释放）再抛出
+        for (uint64_t slot = 0; slot < c_slots; ++slot)
+        {
+            if (slot_busy[slot] != 0)
+            {
+                (void)m_ring->cancel(slot);
+            }
+        }
+        uint32_t retries = 0;
+        while (inflight != 0)
+        {
+            const int c_drain = m_ring->submit_and_wait(1);
+            if (c_drain < 0)
+            {
+                if ((c_drain == -EAGAIN || c_drain == -EBUSY) && ++retries < mc_DRAIN_RETRIES)
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                    continue;
+                }
+                (void)m_pool.release();
+                m_ring.reset();
+                m_pool.reset(verborgen::aligned_new(static_cast<uint64_t>(mc_queue_depth) * mc_chunk_bytes));
+                throw std::runtime_error
+                (
+                    "io_uring_enter failed on the file [" + mc_path + "]: " + std::strerror(-c_ret)
+                    + ", and in-flight requests could not be reclaimed: " + std::strerror(-c_drain) + "."
+                );
+            }
+            inflight -= m_ring->reap(on_complete);
+        }
+        m_ring.reset();
+        MPMT_LOG_WARN("io_uring submission failed, falling back to pread/pwrite", "errno", -c_ret);
+        break;
+    }
+
+    // 4-放弃io_uring后同步完成被撤销与尚未提交的片段
+    if (!m_ring && error.empty())
+    {
+        for (const uint64_t c_slot : cancelled)
+        {
+            sync_chunk(slot_chunk[c_slot], slot_buf(c_slot), false);
+        }
+        for (; next < c_chunks; ++next)
+        {
+            sync_chunk(next, m_pool.get(), true);
+        }
+    }
+    if (!error.empty())
+    {
+        throw std::runtime_error(error);
+    }
+}
+
+uint64_t mpmt::io_direct::pread_full(uint64_t offset, uint8_t* buf, uint64_t len)
+{
+    uint64_t done = 0;
+    while (done < len)
+    {
+        const ssize_t c_got = pread(m_fd, buf + done, len - done, static_cast<off_t>(offset + done));
+        if (c_got < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            throw std::runtime_error
+            (
+                "Can not read data of length=" + std::to_string(len) + " from file[" + mc_path
+                + "] at offset=" + std::to_string(offset) + " correctly: " + std::strerror(errno) + "."
+            );
+        }
+        done += static_cast<uint64_t>(c_got);
+        if (c_got == 0 || (m_direct && c_got % mc_ALIGN != 0))
+        {
+            break;
+        }
+    }
+    return done;
+}
+
+void mpmt::io_direct::pwrite_full(uint64_t offset, const uint8_t* buf, uint64_t len)
+{
+    uint64_t done = 0;
+    while (done < len)
+    {
+        const ssize_t c_put = pwrite(m_fd, buf + done, len - done, static_cast<off_t>(offset + done));
+        if (c_put < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            throw std::runtime_error
+            (
+                "Can not write data of length=" + std::to_string(len) + " to file[" + mc_path
+                + "] at offset=" + std::to_string(offset) + " correctly: " + std::strerror(errno) + "."
+            );
+        }
+        done += static_cast<uint64_t>(c_put);
+    }
+}
+
+void mpmt::io_direct::drop_cache(uint64_t a0, uint64_t a1, bool written) noexcept
+{
+    if (m_direct)
+    {
+        return;
+    }
+    // 脏页须先写回才能被逐出
+    if (written)
+    {
+        (void)sync_file_range
+        (
+            m_fd, static_cast<off_t>(a0), static_cast<off_t>(a1 - a0),
+            SYNC_FILE_RANGE_WAIT_BEFORE | SYNC_FILE_RANGE_WRITE | SYNC_FILE_RANGE_WAIT_AFTER
+        );
+    }
+    (void)posix_fadvise(m_fd, static_cast<off_t>(a0), static_cast<off_t>(a1 - a0), POSIX_FADV_DONTNEED);
+}
+
+#else
+
+namespace mpmt
+{
+    namespace verborgen
+    {
+        class uring
+        {
+        };
+    }
+}
+
+void mpmt::io_direct::aligned_deleter::operator()(uint8_t* ptr) const noexcept
+{
+    std::free(ptr);
+}
+
+bool mpmt::io_direct::supported() noexcept
+{
+    return false;
+}
+
+mpmt::io_direct::io_direct(const std::string& path, io_mode mode, uint32_t queue_depth, uint32_t chunk_bytes)
+    :
+    mc_path(path),
+    mc_mode(mode),
+    mc_queue_depth(queue_depth),
+    mc_chunk_bytes(chunk_bytes),
+    m_fd(-1),
+    m_direct(false),
+    m_padded(false),
+    m_size(0)
+{
+    throw std::runtime_error("Direct I/O is only supported on Linux, cannot open the file [" + path + "].");
+}
+
+mpmt::io_direct::~io_direct() = default;
+
+const char* mpmt::io_direct::backend() const noexcept
+{
+    return "unsupported";
+}
+
+void mpmt::io_direct::read_at(uint64_t, uint8_t*, uint64_t)
+{
+    throw std::runtime_error("Direct I/O is only supported on Linux.");
+}
+
+void mpmt::io_direct::write_at(uint64_t, const uint8_t*, uint64_t)
+{
+    throw std::runtime_error("Direct I/O is only supported on Linux.");
+}
+
+void mpmt::io_direct::sync()
+{
+    throw std::runtime_error("Direct I/O is only supported on Linux.");
+}
+
+#endif
@@ -0,0 +1,86 @@
+#include "core/io/durable_file.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+
+std::string mpmt::durable_file::temp_path(const std::string& path)
+{
+    return path + ".tmp";
+}
+
+void mpmt::durable_file::remove(const std::string& path) noexcept
+{
+    std::remove(path.c_str());
+}
+
+#if defined(_WIN32) || defined(_WIN64)
+
+#include <windows.h>
+
+void mpmt::durable_file::commit(const std::string& temp, const std::string& path)
+{
+    // 1-同步临时文件
+    HANDLE file = CreateFileA(temp.c_str(), GENERIC_WRITE, 0, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        throw std::runtime_error("Can not open the file [" + temp + "] for syncing.");
+    }
+    const bool c_synced = FlushFileBuffers(file) != 0;
+    CloseHandle(file);
+    if (!c_synced)
+    {
+        throw std::runtime_error("Cannot sync the file [" + temp + "] correctly.");
+    }
+
+    // 2-写穿式重命名，返回时目录项已落盘
+    if (!MoveFileExA(temp.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH))
+    {
+        throw std::runtime_error("Cannot rename the file [" + temp + "] to [" + path + "].");
+    }
+}
+
+#else
+
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace
+{
+    /** @brief 打开并同步文件或目录 */
+    void sync_path(const std::string& path, int flags)
+    {
+        const int fd = ::open(path.c_str(), flags);
+        if (fd < 0)
+        {
+            throw std::runtime_error("Can not open [" + path + "] for syncing: " + std::strerror(errno) + ".");
+        }
+        const int c_result = ::fsync(fd);
+        const int c_error = errno;
+        ::close(fd);
+        if (c_result != 0)
+        {
+            throw std::runtime_error("Cannot sync [" + path + "] correctly: " + std::strerror(c_error) + ".");
+        }
+    }
+}
+
+void mpmt::durable_file::commit(const std::string& temp, const std::string& path)
+{
+    // 1-同步临时文件内容
+    sync_path(temp, O_RDONLY);
+
+    // 2-原子重命名：同一文件系统内rename()替换目标文件不会出现半个文件
+    if (::rename(temp.c_str(), path.c_str()) != 0)
+    {
+        throw std::runtime_error("Cannot rename the file [" + temp + "] to [" + path + "]: " + std::strerror(errno) + ".");
+    }
+
+    // 3-同步所在目录，使重命名本身持久化
+    const std::string::size_type c_slash = path.find_last_of('/');
+    const std::string c_dir = c_slash == std::string::npos ? "." : (c_slash == 0 ? "/" : path.substr(0, c_slash));
+    sync_path(c_dir, O_RDONLY | O_DIRECTORY);
+}
+
+#endif
@@ -0,0 +1,216 @@
+#include "core/io/mapped_file.hpp"
+
+#include <stdexcept>
+#include <string>
+
+#if defined(_WIN32) || defined(_WIN64)
+
+#include <windows.h>
+
+mpmt::mapped_file::mapped_file(const std::string& path)
+    :
+    m_data(nullptr),
+    m_size(0),
+    m_writable(false),
+    m_file(INVALID_HANDLE_VALUE),
+    m_mapping(nullptr)
+{
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        throw std::runtime_error("Can not open the file [" + path + "].");
+    }
+    m_file = file;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size))
+    {
+        CloseHandle(file);
+        throw std::runtime_error("Cannot get the size of the file [" + path + "] correctly.");
+    }
+    m_size = static_cast<uint64_t>(size.QuadPart);
+    if (m_size == 0)
+    {
+        return;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr)
+    {
+        CloseHandle(file);
+        throw std::runtime_error("Cannot map the file [" + path + "].");
+    }
+    m_mapping = mapping;
+
+    m_data = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    if (m_data == nullptr)
+    {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        throw std::runtime_error("Cannot map the file [" + path + "].");
+    }
+}
+
+mpmt::mapped_file::mapped_file(const std::string& path, uint64_t size)
+    :
+    m_data(nullptr),
+    m_size(size),
+    m_writable(true),
+    m_file(INVALID_HANDLE_VALUE),
+    m_mapping(nullptr)
+{
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr,
+        CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        throw std::runtime_error("Can not create the file [" + path + "].");
+    }
+    m_file = file;
+    if (size == 0)
+    {
+        return;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READWRITE,
+        static_cast<DWORD>(size >> 32), static_cast<DWORD>(size & 0xFFFFFFFFULL), nullptr);
+    if (mapping == nullptr)
+    {
+        CloseHandle(file);
+        throw std::runtime_error("Cannot map the file [" + path + "] for writing.");
+    }
+    m_mapping = mapping;
+
+    m_data = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, 0));
+    if (m_data == nullptr)
+    {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        throw std::runtime_error("Cannot map the file [" + path + "] for writing.");
+    }
+}
+
+void mpmt::mapped_file::flush()
+{
+    if (m_writable && m_data != nullptr)
+    {
+        if (!FlushViewOfFile(m_data, 0) || !FlushFileBuffers(static_cast<HANDLE>(m_file)))
+        {
+            throw std::runtime_error("Cannot flush the mapped file.");
+        }
+    }
+}
+
+mpmt::mapped_file::~mapped_file()
+{
+    if (m_data != nullptr)
+    {
+        UnmapViewOfFile(m_data);
+    }
+    if (m_mapping != nullptr)
+    {
+        CloseHandle(static_cast<HANDLE>(m_mapping));
+    }
+    if (m_file != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(static_cast<HANDLE>(m_file));
+    }
+}
+
+#else
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+mpmt::mapped_file::mapped_file(const std::string& path)
+    :
+    m_data(nullptr),
+    m_size(0),
+    m_writable(false),
+    m_fd(-1)
+{
+    m_fd = ::open(path.c_str(), O_RDONLY);
+    if (m_fd < 0)
+    {
+        throw std::runtime_error("Can not open the file [" + path + "].");
+    }
+
+    struct stat st;
+    if (::fstat(m_fd, &st) != 0)
+    {
+        ::close(m_fd);
+        throw std::runtime_error("Cannot get the size of the file [" + path + "] correctly.");
+    }
+    m_size = static_cast<uint64_t>(st.st_size);
+    if (m_size == 0)
+    {
+        return;
+    }
+
+    void* addr = ::mmap(nullptr, m_size, PROT_READ, MAP_SHARED, m_fd, 0);
+    if (addr == MAP_FAILED)
+    {
+        ::close(m_fd);
+        throw std::runtime_error("Cannot map the file [" + path + "].");
+    }
+    ::madvise(addr, m_size, MADV_SEQUENTIAL);
+    m_data = static_cast<const uint8_t*>(addr);
+}
+
+mpmt::mapped_file::mapped_file(const std::string& path, uint64_t size)
+    :
+    m_data(nullptr),
+    m_size(size),
+    m_writable(true),
+    m_fd(-1)
+{
+    m_fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (m_fd < 0)
+    {
+        throw std::runtime_error("Can not create the file [" + path + "].");
+    }
+    if (::ftruncate(m_fd, static_cast<off_t>(size)) != 0)
+    {
+        ::close(m_fd);
+        throw std::runtime_error("Cannot resize the file [" + path + "] to " + std::to_string(size) + " byte(s).");
+    }
+    if (size == 0)
+    {
+        return;
+    }
+
+    void* addr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+    if (addr == MAP_FAILED)
+    {
+        ::close(m_fd);
+        throw std::runtime_error("Cannot map the file [" + path + "] for writing.");
+    }
+    m_data = static_cast<const uint8_t*>(addr);
+}
+
+void mpmt::mapped_file::flush()
+{
+    if (m_writable && m_data != nullptr)
+    {
+        if (::msync(const_cast<uint8_t*>(m_data), m_size, MS_SYNC) != 0)
+        {
+            throw std::runtime_error("Cannot flush the mapped file.");
+        }
+    }
+}
+
+mpmt::mapped_file::~mapped_file()
+{
+    if (m_data != nullptr)
+    {
+        ::munmap(const_cast<uint8_t*>(m_data), m_size);
+    }
+    if (m_fd >= 0)
+    {
+        ::close(m_fd);
+    }
+}
+
+#endif
@@ -0,0 +1,88 @@
+#include "core/io/stream_impl/io_stream.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+mpmt::io_stream::io_stream(const std::string& path, io_mode mode)
+    :
+    mc_path(path),
+    mc_mode(mode),
+    m_stream(),
+    m_size(0)
+{
+    std::ios::openmode flags = std::ios::binary | std::ios::in;
+    if (mode == io_mode::READ_WRITE)
+    {
+        flags |= std::ios::out;
+    }
+    else if (mode == io_mode::CREATE)
+    {
+        flags |= std::ios::out | std::ios::trunc;
+    }
+
+    m_stream.open(path, flags);
+    if (!m_stream)
+    {
+        throw std::runtime_error("Can not open the file [" + path + "].");
+    }
+    m_stream.seekg(0, std::ios::end);
+    const std::fstream::pos_type c_end = m_stream.tellg();
+    if (c_end == std::fstream::pos_type(-1))
+    {
+        throw std::runtime_error("Cannot get the size of the file [" + path + "] correctly.");
+    }
+    m_size = static_cast<uint64_t>(c_end);
+}
+
+void mpmt::io_stream::read_at(uint64_t offset, uint8_t* out, uint64_t len)
+{
+    if (offset > m_size || len > m_size - offset)
+    {
+        throw std::runtime_error
+        (
+            "Read of " + std::to_string(len) + " byte(s) at offset=" + std::to_string(offset)
+            + " exceeds the size of the file [" + mc_path + "]."
+        );
+    }
+    m_stream.seekg(static_cast<std::streamoff>(offset));
+    m_stream.read(reinterpret_cast<char*>(out), static_cast<std::streamsize>(len));
+    if (!m_stream)
+    {
+        m_stream.clear();
+        throw std::runtime_error
+        (
+            "Can not read data of length=" + std::to_string(len) + " from file[" + mc_path
+            + "] at offset=" + std::to_string(offset) + " correctly."
+        );
+    }
+}
+
+void mpmt::io_stream::write_at(uint64_t offset, const uint8_t* data, uint64_t len)
+{
+    if (mc_mode == io_mode::READ)
+    {
+        throw std::runtime_error("The file [" + mc_path + "] is opened read-only.");
+    }
+    m_stream.seekp(static_cast<std::streamoff>(offset));
+    m_stream.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(len));
+    if (!m_stream)
+    {
+        m_stream.clear();
+        throw std::runtime_error
+        (
+            "Can not write data of length=" + std::to_string(len) + " to file[" + mc_path
+            + "] at offset=" + std::to_string(offset) + " correctly."
+        );
+    }
+    m_size = std::max(m_size, offset + len);
+}
+
+void mpmt::io_stream::sync()
+{
+    m_stream.flush();
+    if (!m_stream)
+    {
+        m_stream.clear();
+        throw std::runtime_error("Can not flush the file [" + mc_path + "].");
+    }
+}
@@ -0,0 +1,230 @@
+#include "core/numa/numa_memory.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "auxkit/logger.hpp"
+#include "core/exception/numa_exc.hpp"
+#include "core/numa/numa_topology.hpp"
+
+std::atomic<uint8_t> mpmt::numa_memory::s_active{ mpmt::numa_memory::mc_UNSET };
+
+namespace
+{
+#if defined(__linux__) && defined(SYS_mbind)
+    constexpr int mc_MPOL_PREFERRED = 1;        // 优先在指定节点落页，节点内存不足时可落到其他节点
+    constexpr int mc_MPOL_INTERLEAVE = 3;       // 按页在节点间交错
+
+    /** @brief 对地址区间设置内存策略（不依赖libnuma） */
+    bool bind_range(void* addr, uint64_t len, int mode, const std::vector<uint32_t>& node_ids) noexcept
+    {
+        uint32_t max_id = 0;
+        for (const uint32_t c_id : node_ids)
+        {
+            max_id = std::max(max_id, c_id);
+        }
+        std::vector<unsigned long> mask(max_id / (8 * sizeof(unsigned long)) + 1, 0);
+        for (const uint32_t c_id : node_ids)
+        {
+            mask[c_id / (8 * sizeof(unsigned long))] |= 1UL << (c_id % (8 * sizeof(unsigned long)));
+        }
+        const unsigned long c_maxnode = mask.size() * 8 * sizeof(unsigned long) + 1;
+        return syscall(SYS_mbind, addr, len, mode, mask.data(), c_maxnode, 0) == 0;
+    }
+#endif
+}
+
+std::pair<uint64_t, uint64_t> mpmt::numa_memory::partition
+(
+    uint64_t elems,
+    uint64_t elem_bytes,
+    uint32_t part,
+    uint32_t parts
+) noexcept
+{
+    // 按页均分，分区边界落在页边界上（最后一个分区吸收不足一页的尾部）
+    const uint64_t c_per_page = std::max<uint64_t>(1, mc_PAGE_SIZE / elem_bytes);
+    const uint64_t c_pages = (elems + c_per_page - 1) / c_per_page;
+    const uint64_t c_first = std::min(elems, c_pages * part / parts * c_per_page);
+    const uint64_t c_last = part + 1 == parts ? elems : std::min(elems, c_pages * (part + 1) / parts * c_per_page);
+    return { c_first, c_last };
+}
+
+mpmt::numa_policy mpmt::numa_memory::active() noexcept
+{
+    const uint8_t c_active = s_active.load(std::memory_order_acquire);
+    return c_active == mc_UNSET ? initialize() : static_cast<numa_policy>(c_active);
+}
+
+void mpmt::numa_memory::select(numa_policy policy) noexcept
+{
+    s_active.store(static_cast<uint8_t>(policy), std::memory_order_release);
+}
+
+void mpmt::numa_memory::select(const std::string& name)
+{
+    numa_policy policy;
+    if (!parse(name, policy))
+    {
+        throw numa_exc
+        (
+            numa_exc::exc_type::INVALID_PARAMETER,
+            "unknown placement policy [" + name + "], expected auto, off, partition or interleave."
+        );
+    }
+    select(policy);
+}
+
+const char* mpmt::numa_memory::name(numa_policy policy) noexcept
+{
+    switch (policy)
+    {
+    case numa_policy::OFF:
+        return "off";
+    case numa_policy::PARTITION:
+        return "partition";
+    case numa_policy::INTERLEAVE:
+        return "interleave";
+    default:
+        return "unknown";
+    }
+}
+
+mpmt::numa_policy mpmt::numa_memory::initialize() noexcept
+{
+    // 1-按拓扑选择默认策略
+    numa_policy policy = detect();
+
+    // 2-环境变量覆盖：无法识别时给出警告并保持默认
+    const char* env = std::getenv("MPMT_NUMA");
+    if (env != nullptr)
+    {
+        numa_policy requested;
+        const bool c_valid = parse(env, requested);
+        MPMT_WARN(c_valid, "MPMT_NUMA names an unknown placement policy, falling back to the default.");
+        if (c_valid)
+        {
+            policy = requested;
+        }
+    }
+
+    // 3-并发的首次调用可能重复初始化，但结果一致；不覆盖已由select()写入的值
+    uint8_t expected = mc_UNSET;
+    if (!s_active.compare_exchange_strong(expected, static_cast<uint8_t>(policy), std::memory_order_acq_rel))
+    {
+        return static_cast<numa_policy>(expected);
+    }
+    return policy;
+}
+
+mpmt::numa_policy mpmt::numa_memory::detect() noexcept
+{
+    try
+    {
+        return numa_topology::system().num_nodes() > 1 ? numa_policy::PARTITION : numa_policy::OFF;
+    }
+    catch (...)
+    {
+        return numa_policy::OFF;
+    }
+}
+
+bool mpmt::numa_memory::parse(const std::string& name, numa_policy& policy)
+{
+    std::string lower(name);
+    std::transform(lower.begin(), lower.end(), lower.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+    if (lower == "auto")                { policy = detect(); }
+    else if (lower == "off")            { policy = numa_policy::OFF; }
+    else if (lower == "partition")      { policy = numa_policy::PARTITION; }
+    else if (lower == "interleave")     { policy = numa_policy::INTERLEAVE; }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+void* mpmt::numa_memory::map_zeroed(uint64_t bytes) noexcept
+{
+#if defined(__linux__)
+    const numa_policy c_policy = active();
+    if (bytes < mc_MIN_BYTES || c_policy == numa_policy::OFF)
+    {
+        return nullptr;
+    }
+
+    // 1-匿名映射：页在首次访问时才分配，内容全零
+    void* addr = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (addr == MAP_FAILED)
+    {
+        return nullptr;
+    }
+
+#if defined(SYS_mbind)
+    // 2-设置策略：mbind只影响之后的缺页，因此须在任何写入之前完成
+    try
+    {
+        const std::vector<numa_topology::node>& c_nodes = numa_topology::system().nodes();
+        bool bound = true;
+        if (c_policy == numa_policy::INTERLEAVE)
+        {
+            std::vector<uint32_t> ids;
+            for (const numa_topology::node& n : c_nodes)
+            {
+                ids.push_back(n.m_id);
+            }
+            bound = bind_range(addr, bytes, mc_MPOL_INTERLEAVE, ids);
+        }
+        else
+        {
+            const uint32_t c_parts = static_cast<uint32_t>(c_nodes.size());
+            for (uint32_t k = 0; k < c_parts; ++k)
+            {
+                const std::pair<uint64_t, uint64_t> c_range = partition(bytes, 1, k, c_parts);
+                if (c_range.second > c_range.first)
+                {
+                    bound = bind_range
+                    (
+                        static_cast<uint8_t*>(addr) + c_range.first,
+                        c_range.second - c_range.first,
+                        mc_MPOL_PREFERRED,
+                        { c_nodes[k].m_id }
+                    ) && bound;
+                }
+            }
+        }
+        if (!bound)
+        {
+            MPMT_LOG_DEBUG("mbind failed, placement left to the kernel", "bytes", bytes);
+        }
+    }
+    catch (...)
+    {
+        // 分配拓扑信息失败时保留未绑定的映射
+    }
+#endif
+    return addr;
+#else
+    (void)bytes;
+    return nullptr;
+#endif
+}
+
+void mpmt::numa_memory::unmap(void* ptr, uint64_t bytes) noexcept
+{
+#if defined(__linux__)
+    munmap(ptr, bytes);
+#else
+    (void)ptr;
+    (void)bytes;
+#endif
+}
@@ -0,0 +1,164 @@
+#include "core/numa/numa_pool.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "auxkit/logger.hpp"
+#include "auxkit/stack_tracer.hpp"
+#include "core/numa/numa_memory.hpp"
+
+namespace
+{
+    thread_local bool t_in_pool = false;    // 当前线程是否为池内线程
+
+    /** @brief 一次parallel_for的完成计数 */
+    struct completion
+    {
+        std::mutex m_mutex;
+        std::condition_variable m_cv;
+        uint64_t m_remaining = 0;
+    };
+}
+
+mpmt::numa_pool& mpmt::numa_pool::instance()
+{
+    static numa_pool s_pool
+    (
+        numa_topology::system(),
+        static_cast<unsigned>(std::getenv("MPMT_NUMA_THREADS") != nullptr ? std::strtoul(std::getenv("MPMT_NUMA_THREADS"), nullptr, 10) : 0)
+    );
+    return s_pool;
+}
+
+mpmt::numa_pool::numa_pool(const numa_topology& topo, unsigned threads_per_node) :
+    m_queues()
+{
+    for (const numa_topology::node& n : topo.nodes())
+    {
+        m_queues.push_back(std::make_unique<node_queue>());
+        node_queue& queue = *m_queues.back();
+
+        uint64_t threads = n.m_cpus.size();
+        if (threads_per_node != 0)
+        {
+            threads = std::min<uint64_t>(threads, threads_per_node);
+        }
+        for (uint64_t t = 0; t < std::max<uint64_t>(1, threads); ++t)
+        {
+            queue.m_threads.emplace_back([&queue, cpus = n.m_cpus] { work(queue, cpus); });
+        }
+    }
+    MPMT_LOG_INFO("numa pool started", "nodes", m_queues.size(), "threads", num_threads());
+}
+
+void mpmt::numa_pool::parallel_for(uint64_t elems, uint64_t elem_bytes, const range_fn& fn)
+{
+    if (elems == 0)
+    {
+        return;
+    }
+    if (t_in_pool || m_queues.empty())
+    {
+        fn(0, elems);
+        return;
+    }
+
+    // 1-按节点分区，节点内再按页均分给该节点的线程
+    completion done;
+    const uint32_t c_parts = static_cast<uint32_t>(m_queues.size());
+    for (uint32_t k = 0; k < c_parts; ++k)
+    {
+        const std::pair<uint64_t, uint64_t> c_node_range = numa_memory::partition(elems, elem_bytes, k, c_parts);
+        const uint64_t c_node_elems = c_node_range.second - c_node_range.first;
+        if (c_node_elems == 0)
+        {
+            continue;
+        }
+
+        node_queue& queue = *m_queues[k];
+        const uint32_t c_threads = static_cast<uint32_t>(queue.m_threads.size());
+        {
+            std::lock_guard<std::mutex> lock(queue.m_mutex);
+            for (uint32_t t = 0; t < c_threads; ++t)
+            {
+                const std::pair<uint64_t, uint64_t> c_sub = numa_memory::partition(c_node_elems, elem_bytes, t, c_threads);
+                if (c_sub.second == c_sub.first)
+                {
+                    continue;
+                }
+                {
+                    std::lock_guard<std::mutex> done_lock(done.m_mutex);
+                    ++done.m_remaining;
+                }
+                const uint64_t c_first = c_node_range.first + c_sub.first;
+                const uint64_t c_count = c_sub.second - c_sub.first;
+                queue.m_tasks.emplace_back([&fn, &done, c_first, c_count]
+                {
+                    fn(c_first, c_count);
+                    std::lock_guard<std::mutex> done_lock(done.m_mutex);
+                    if (--done.m_remaining == 0)
+                    {
+                        done.m_cv.notify_one();
+                    }
+                });
+            }
+        }
+        queue.m_cv.notify_all();
+    }
+
+    // 2-等待全部区间完成
+    std::unique_lock<std::mutex> lock(done.m_mutex);
+    done.m_cv.wait(lock, [&done] { return done.m_remaining == 0; });
+}
+
+uint64_t mpmt::numa_pool::num_threads() const noexcept
+{
+    uint64_t total = 0;
+    for (const std::unique_ptr<node_queue>& queue : m_queues)
+    {
+        total += queue->m_threads.size();
+    }
+    return total;
+}
+
+mpmt::numa_pool::~numa_pool()
+{
+    for (std::unique_ptr<node_queue>& queue : m_queues)
+    {
+        {
+            std::lock_guard<std::mutex> lock(queue->m_mutex);
+            queue->m_stop = true;
+        }
+        queue->m_cv.notify_all();
+        for (std::thread& th : queue->m_threads)
+        {
+            th.join();
+        }
+    }
+}
+
+void mpmt::numa_pool::work(node_queue& queue, const std::vector<uint32_t>& cpus)
+{
+    t_in_pool = true;
+    utils::stack_tracer::install_thread_alt_stack();
+    if (!numa_topology::pin_current_thread(cpus))
+    {
+        MPMT_LOG_DEBUG("numa worker could not be pinned", "cpus", cpus.size());
+    }
+
+    for (;;)
+    {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(queue.m_mutex);
+            queue.m_cv.wait(lock, [&queue] { return queue.m_stop || !queue.m_tasks.empty(); });
+            if (queue.m_tasks.empty())
+            {
+                return;
+            }
+            task = std::move(queue.m_tasks.front());
+            queue.m_tasks.pop_front();
+        }
+        task();
+    }
+}
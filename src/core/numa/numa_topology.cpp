@@ -0,0 +1,165 @@
+#include "core/numa/numa_topology.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#if defined(__linux__)
+#include <dirent.h>
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "auxkit/logger.hpp"
+
+namespace
+{
+    /** @brief 当前进程允许运行的CPU，无法获取时返回0..hardware_concurrency-1 */
+    std::vector<uint32_t> allowed_cpus()
+    {
+        std::vector<uint32_t> cpus;
+#if defined(__linux__)
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        if (sched_getaffinity(0, sizeof(set), &set) == 0)
+        {
+            for (uint32_t c = 0; c < CPU_SETSIZE; ++c)
+            {
+                if (CPU_ISSET(c, &set))
+                {
+                    cpus.push_back(c);
+                }
+            }
+        }
+#endif
+        if (cpus.empty())
+        {
+            const unsigned c_count = std::max(1U, std::thread::hardware_concurrency());
+            for (uint32_t c = 0; c < c_count; ++c)
+            {
+                cpus.push_back(c);
+            }
+        }
+        return cpus;
+    }
+}
+
+mpmt::numa_topology::numa_topology(const std::string& root) :
+    m_nodes()
+{
+    const std::vector<uint32_t> c_allowed = allowed_cpus();
+
+#if defined(__linux__)
+    // 1-枚举node<N>目录并读取各自的cpulist
+    DIR* dir = opendir(root.c_str());
+    if (dir != nullptr)
+    {
+        for (dirent* entry = readdir(dir); entry != nullptr; entry = readdir(dir))
+        {
+            const std::string c_name = entry->d_name;
+            if (c_name.size() <= 4 || c_name.compare(0, 4, "node") != 0
+                || c_name.find_first_not_of("0123456789", 4) != std::string::npos)
+            {
+                continue;
+            }
+
+            std::ifstream in(root + "/" + c_name + "/cpulist");
+            std::string text;
+            if (!in || !std::getline(in, text))
+            {
+                continue;
+            }
+
+            // 2-仅保留允许运行的CPU，无CPU的节点不作为计算节点
+            node n{ static_cast<uint32_t>(std::strtoul(c_name.c_str() + 4, nullptr, 10)), {} };
+            for (const uint32_t c_cpu : parse_cpulist(text))
+            {
+                if (std::binary_search(c_allowed.begin(), c_allowed.end(), c_cpu))
+                {
+                    n.m_cpus.push_back(c_cpu);
+                }
+            }
+            if (!n.m_cpus.empty())
+            {
+                m_nodes.push_back(std::move(n));
+            }
+        }
+        closedir(dir);
+    }
+#endif
+
+    // 3-无法读取拓扑时视为单节点
+    if (m_nodes.empty())
+    {
+        m_nodes.push_back(node{ 0, c_allowed });
+    }
+    std::sort(m_nodes.begin(), m_nodes.end(), [](const node& a, const node& b) { return a.m_id < b.m_id; });
+    MPMT_LOG_DEBUG("numa topology loaded", "nodes", m_nodes.size(), "cpus", c_allowed.size());
+}
+
+const mpmt::numa_topology& mpmt::numa_topology::system()
+{
+    static const numa_topology s_system;
+    return s_system;
+}
+
+int mpmt::numa_topology::node_index_of(uint32_t cpu) const noexcept
+{
+    for (uint64_t i = 0; i < m_nodes.size(); ++i)
+    {
+        if (std::binary_search(m_nodes[i].m_cpus.begin(), m_nodes[i].m_cpus.end(), cpu))
+        {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+std::vector<uint32_t> mpmt::numa_topology::parse_cpulist(const std::string& text)
+{
+    std::vector<uint32_t> cpus;
+    std::stringstream ss(text);
+    std::string range;
+    while (std::getline(ss, range, ','))
+    {
+        if (range.empty() || range.find_first_not_of(" \t\r\n") == std::string::npos)
+        {
+            continue;
+        }
+        char* end = nullptr;
+        const unsigned long c_first = std::strtoul(range.c_str(), &end, 10);
+        unsigned long last = c_first;
+        if (end != nullptr && *end == '-')
+        {
+            last = std::strtoul(end + 1, nullptr, 10);
+        }
+        for (unsigned long c = c_first; c <= last; ++c)
+        {
+            cpus.push_back(static_cast<uint32_t>(c));
+        }
+    }
+    std::sort(cpus.begin(), cpus.end());
+    cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+    return cpus;
+}
+
+bool mpmt::numa_topology::pin_current_thread(const std::vector<uint32_t>& cpus) noexcept
+{
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (const uint32_t c_cpu : cpus)
+    {
+        if (c_cpu < CPU_SETSIZE)
+        {
+            CPU_SET(c_cpu, &set);
+        }
+    }
+    return !cpus.empty() && pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)cpus;
+    return false;
+#endif
+}
@@ -1 +1,418 @@
-#include "core/protocol/ass_impl/agent_ass.hpp"
\ No newline at end of file
+#include "core/protocol/ass_impl/agent_ass.hpp"
+
+#include <algorithm>
+#include <string>
+
+#include "auxkit/logger.hpp"
+#include "auxkit/profiler.hpp"
+#include "core/coro/coro_comm.hpp"
+#include "core/exception/protocol_exc.hpp"
+#include "core/protocol/ass_impl/ass_wire.hpp"
+#include "core/protocol/ass_impl/seed_share.hpp"
+#include "core/ring/vcb/vcb_dispatch.hpp"
+
+template<typename RT>
+mpmt::agent_ass<RT>::agent_ass
+(
+    ass_role role,
+    const std::vector<comm_adapter<RT>*>& holders,
+    comm_adapter<RT>* querier
+) :
+    mc_role(role),
+    m_holders(holders),
+    m_querier(querier),
+    m_union(),
+    m_update_hook(),
+    m_cache(),
+    m_blind(),
+    m_checkpoint(nullptr),
+    m_resume()
+{}
+
+template<typename RT>
+void mpmt::agent_ass<RT>::merge()
+{
+    if (!m_resume)
+    {
+        m_union = rvector<RT>();
+    }
+    aggregate();
+}
+
+template<typename RT>
+void mpmt::agent_ass<RT>::update()
+{
+    require_union();
+    aggregate();
+}
+
+template<typename RT>
+void mpmt::agent_ass<RT>::aggregate()
+{
+    MPMT_PROF_SCOPE("agent_ass::aggregate");
+    aggregate_on(nullptr).run_inline();
+}
+
+template<typename RT>
+mpmt::coro_task<void> mpmt::agent_ass<RT>::merge_async(coro_pool& pool)
+{
+    if (!m_resume)
+    {
+        m_union = rvector<RT>();
+    }
+    co_await aggregate_on(&pool);
+}
+
+template<typename RT>
+mpmt::coro_task<void> mpmt::agent_ass<RT>::update_async(coro_pool& pool)
+{
+    require_union();
+    co_await aggregate_on(&pool);
+}
+
+template<typename RT>
+mpmt::coro_task<void> mpmt::agent_ass<RT>::aggregate_async(coro_pool& pool)
+{
+    co_await aggregate_on(&pool);
+}
+
+template<typename RT>
+void mpmt::agent_ass<RT>::require_union() const
+{
+    if (m_union.size() == 0)
+    {
+        throw protocol_exc
+        (
+            protocol_exc::exc_type::INVALID_STATE,
+            "agent_ass::update() requires a merged or loaded union share."
+        );
+    }
+}
+
+template<typename RT>
+mpmt::coro_task<void> mpmt::agent_ass<RT>::aggregate_on(coro_pool* pool)
+{
+    const merge_progress c_start = m_resume.value_or(merge_progress{ m_holders.size(), 0, 0 });
+    if (c_start.m_links != m_holders.size())
+    {
+        throw protocol_exc
+        (
+            protocol_exc::exc_type::INVALID_STATE,
+            "checkpoint covers " + std::to_string(c_start.m_links) + " holder connection(s), but the agent has "
+            + std::to_string(m_holders.size()) + "."
+        );
+    }
+    m_resume.reset();
+
+    m_cache.clear();
+    if (mc_role == ass_role::AS0)
+    {
+        co_await aggregate_seeds(pool, c_start);
+    }
+    else
+    {
+        co_await aggregate_chunks(pool, c_start);
+    }
+    if (m_checkpoint != nullptr)
+    {
+        m_checkpoint->commit(m_union, merge_progress{ m_holders.size(), m_holders.size(), 0 });
+    }
+    notify_update();
+}
+
+template<typename RT>
+mpmt::coro_task<void> mpmt::agent_ass<RT>::aggregate_seeds(coro_pool* pool, merge_progress start)
+{
+    // 1-收齐尚未累加的连接的种子（每个仅数十字节），无需物化完整份额；经中继的连接一次送来多个持有方的种子束
+    std::vector<seed_share<RT>> shares;
+    shares.reserve(m_holders.size() - start.m_folded);
+    std::vector<RT> message;
+    for (uint64_t h = start.m_folded; h < m_holders.size(); ++h)
+    {
+        co_await async_receive(pool, *m_holders[h], message);
+        for (seed_share<RT>& share : seed_share<RT>::decode_bundle(message))
+        {
+            ensure_union(share.size());
+            shares.push_back(std::move(share));
+        }
+    }
+
+    // 2-逐区间展开：同一区间内各组依次展开后融合累加，区间在组间常驻缓存
+    const uint64_t c_window = mc_FUSE_WINDOW_BYTES / sizeof(RT);
+    const uint64_t c_size = m_union.size();
+    std::vector<std::vector<RT>> expanded(std::min<uint64_t>(mc_FUSE_WAY, shares.size()), std::vector<RT>(c_window));
+    std::vector<const RT*> srcs;
+    for (uint64_t offset = start.m_slots_done; offset < c_size; offset += c_window)
+    {
+        const uint64_t c_len = std::min(c_window, c_size - offset);
+        for (uint64_t first = 0; first < shares.size(); first += mc_FUSE_WAY)
+        {
+            const uint64_t c_way = std::min<uint64_t>(mc_FUSE_WAY, shares.size() - first);
+            srcs.clear();
+            for (uint64_t j = 0; j < c_way; ++j)
+            {
+                co_await shares[first + j].expand_async(pool, offset, expanded[j].data(), c_len);
+                srcs.push_back(expanded[j].data());
+            }
+            vcb_dispatch::kernels<RT>().m_add_many(m_union.data() + offset, srcs.data(), c_way, c_len);
+        }
+
+        // 本区间已累加全部连接，尝试在后台写入检查点
+        if (m_checkpoint != nullptr)
+        {
+            m_checkpoint->offer(m_union, merge_progress{ m_holders.size(), start.m_folded, offset + c_len });
+        }
+    }
+    MPMT_LOG_DEBUG("holder shares aggregated", "role", static_cast<uint8_t>(mc_role), "holders", shares.size(), "slots", c_size);
+}
+
+template<typename RT>
+mpmt::coro_task<void> mpmt::agent_ass<RT>::aggregate_chunks(coro_pool* pool, merge_progress start)
+{
+    if (start.m_slots_done != 0)
+    {
+        throw protocol_exc
+        (
+            protocol_exc::exc_type::INVALID_STATE,
+            "an AS1 checkpoint cannot resume from a partial slot range."
+        );
+    }
+
+    // 每组先收本组持有方声明的份额长度，再轮流接收各持有方的下一块，取各块剩余长度的最小值融合累加；
+    // 长度随组接收，后续组的持有方未就绪时前面的组仍可完整累加并写入检查点
+    std::vector<std::vector<RT>> chunks(std::min<uint64_t>(mc_FUSE_WAY, m_holders.size()));
+    std::vector<uint64_t> used(chunks.size());
+    std::vector<const RT*> srcs(chunks.size());
+    std::vector<RT> message;
+    for (uint64_t first = start.m_folded; first < m_holders.size(); first += mc_FUSE_WAY)
+    {
+        const uint64_t c_way = std::min<uint64_t>(mc_FUSE_WAY, m_holders.size() - first);
+        for (uint64_t j = 0; j < c_way; ++j)
+        {
+            co_await async_receive(pool, *m_holders[first + j], message);
+            ensure_union(ass_wire::decode_u64(message));
+            chunks[j].clear();
+            used[j] = 0;
+        }
+
+        const uint64_t c_size = m_union.size();
+        uint64_t filled = 0;
+        while (filled < c_size)
+        {
+            uint64_t len = c_size - filled;
+            for (uint64_t j = 0; j < c_way; ++j)
+            {
+                if (used[j] == chunks[j].size())
+                {
+                    co_await async_receive(pool, *m_holders[first + j], message);
+                    chunks[j] = ass_wire::unpack_packed(message);
+                    used[j] = 0;
+                    if (chunks[j].empty() || chunks[j].size() > c_size - filled)
+                    {
+                        throw protocol_exc
+                        (
+                            protocol_exc::exc_type::MESSAGE_CORRUPTION,
+                            "received a chunk of " + std::to_string(chunks[j].size()) + " element(s) with "
+                            + std::to_string(c_size - filled) + " element(s) remaining."
+                        );
+                    }
+                }
+                len = std::min<uint64_t>(len, chunks[j].size() - used[j]);
+                srcs[j] = chunks[j].data() + used[j];
+            }
+
+            vcb_dispatch::kernels<RT>().m_add_many(m_union.data() + filled, srcs.data(), c_way, len);
+            for (uint64_t j = 0; j < c_way; ++j)
+            {
+                used[j] += len;
+            }
+            filled += len;
+        }
+        MPMT_LOG_DEBUG("holder shares aggregated", "role", static_cast<uint8_t>(mc_role), "holders", first + c_way, "slots", c_size);
+
+        // 本组已完整累加，尝试在后台写入检查点
+        if (m_checkpoint != nullptr)
+        {
+            m_checkpoint->offer(m_union, merge_progress{ m_holders.size(), first + c_way, 0 });
+        }
+    }
+}
+
+template<typename RT>
+void mpmt::agent_ass<RT>::share()
+{
+    throw protocol_exc
+    (
+        protocol_exc::exc_type::UNSUPPORTED_OPERATION,
+        "agents do not provide secret inputs."
+    );
+}
+
+template<typename RT>
+void mpmt::agent_ass<RT>::reveal()
+{
+    if (m_querier == nullptr)
+    {
+        throw protocol_exc
+        (
+            protocol_exc::exc_type::INVALID_STATE,
+            "agent_ass::reveal() requires a querier connection."
+        );
+    }
+    respond(ass_wire::receive_token(*m_querier));
+}
+
+template<typename RT>
+mpmt::coro_task<void> mpmt::agent_ass<RT>::reveal_async(coro_pool& pool)
+{
+    if (m_querier == nullptr)
+    {
+        throw protocol_exc
+        (
+            protocol_exc::exc_type::INVALID_STATE,
+            "agent_ass::reveal() requires a querier connection."
+        );
+    }
+    std::vector<RT> message;
+    co_await async_receive(pool, *m_querier, message);
+    respond(ass_wire::unpack_token(message));
+}
+
+template<typename RT>
+void mpmt::agent_ass<RT>::respond(const std::vector<RT>& token)
+{
+    MPMT_PROF_SCOPE("agent_ass::reveal");
+
+    // 1-令牌为若干64位槽位下标，命中缓存时直接返回
+    const std::vector<RT>* cached = m_cache.find(token);
+    if (cached != nullptr)
+    {
+        m_querier->send(*cached);
+        return;
+    }
+    const uint64_t c_count = token.size() * sizeof(RT) / sizeof(uint64_t);
+    std::vector<uint64_t> slots(c_count);
+    ass_wire::decode_bytes(token, 0, reinterpret_cast<uint8_t*>(slots.data()), c_count * sizeof(uint64_t));
+
+    // 2-收集并返回本方份额
+    std::vector<RT> gathered(c_count);
+    for (uint64_t i = 0; i < c_count; ++i)
+    {
+        if (slots[i] >= m_union.size())
+        {
+            throw protocol_exc
+            (
+                protocol_exc::exc_type::MESSAGE_CORRUPTION,
+                "query slot " + std::to_string(slots[i]) + " is out of range [0, "
+                + std::to_string(m_union.size()) + ")."
+            );
+        }
+        gathered[i] = m_union[slots[i]];
+    }
+    if (m_blind)
+    {
+        m_blind->apply(token, gathered.data(), c_count);
+    }
+    m_cache.insert(token, gathered);
+    m_querier->send(gathered);
+}
+
+template<typename RT>
+void mpmt::agent_ass<RT>::set_holders(const std::vector<comm_adapter<RT>*>& holders)
+{
+    m_holders = holders;
+}
+
+template<typename RT>
+void mpmt::agent_ass<RT>::set_blind_key(const typename reveal_blind<RT>::key_type& key)
+{
+    m_blind.emplace(key);
+    m_cache.clear();
+}
+
+template<typename RT>
+void mpmt::agent_ass<RT>::load_union(rvector<RT>&& share)
+{
+    m_union = std::move(share);
+    notify_update();
+}
+
+template<typename RT>
+void mpmt::agent_ass<RT>::resume(typename merge_checkpoint<RT>::resume_point&& point)
+{
+    m_union = std::move(point.m_union);
+    m_resume = point.m_progress;
+    MPMT_LOG_INFO("agent resumed from checkpoint", "role", static_cast<uint8_t>(mc_role),
+        "folded", m_resume->m_folded, "slots_done", m_resume->m_slots_done);
+}
+
+template<typename RT>
+void mpmt::agent_ass<RT>::set_update_hook(std::function<void(const rvector<RT>&)> hook)
+{
+    m_update_hook = std::move(hook);
+}
+
+template<typename RT>
+void mpmt::agent_ass<RT>::multiply()
+{
+    throw protocol_exc
+    (
+        protocol_exc::exc_type::UNSUPPORTED_OPERATION,
+        "secure multiplication is not required by the additive merge."
+    );
+}
+
+template<typename RT>
+void mpmt::agent_ass<RT>::subtract()
+{
+    throw protocol_exc
+    (
+        protocol_exc::exc_type::UNSUPPORTED_OPERATION,
+        "secure subtraction is not required by the additive merge."
+    );
+}
+
+template<typename RT>
+void mpmt::agent_ass<RT>::add()
+{
+    throw protocol_exc
+    (
+        protocol_exc::exc_type::UNSUPPORTED_OPERATION,
+        "secure addition is performed locally by aggregate()."
+    );
+}
+
+template<typename RT>
+void mpmt::agent_ass<RT>::ensure_union(uint64_t size)
+{
+    if (m_union.size() == 0)
+    {
+        m_union = rvector<RT>(size, RT(0));
+    }
+    else if (m_union.size() != size)
+    {
+        throw protocol_exc
+        (
+            protocol_exc::exc_type::MESSAGE_CORRUPTION,
+            "holder share of " + std::to_string(size) + " element(s) does not match the union share of "
+            + std::to_string(m_union.size()) + " element(s)."
+        );
+    }
+}
+
+template<typename RT>
+void mpmt::agent_ass<RT>::notify_update()
+{
+    m_cache.clear();
+    if (m_update_hook)
+    {
+        m_update_hook(m_union);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// 显式实例化
+template class mpmt::agent_ass<mpmt::ring8>;
+template class mpmt::agent_ass<mpmt::ring16>;
+template class mpmt::agent_ass<mpmt::ring32>;
+template class mpmt::agent_ass<mpmt::ring64>;
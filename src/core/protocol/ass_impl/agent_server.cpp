@@ -0,0 +1,233 @@
+#include "core/protocol/ass_impl/agent_server.hpp"
+
+#include <string>
+#include <thread>
+
+#include "auxkit/logger.hpp"
+#include "auxkit/profiler.hpp"
+#include "core/coro/coro_comm.hpp"
+#include "core/exception/comm_exc.hpp"
+#include "core/exception/protocol_exc.hpp"
+#include "core/protocol/ass_impl/ass_wire.hpp"
+
+namespace
+{
+    /** @brief 工作线程复用的查询缓存区 */
+    template <typename RT>
+    struct session_arena
+    {
+        std::vector<uint64_t> m_slots;      // 解码出的槽位
+        std::vector<RT> m_gathered;         // 返回的份额
+        mpmt::query_cache<RT> m_cache;      // 查询缓存
+        uint64_t m_cache_epoch = 0;         // 缓存条目所属的纪元
+    };
+}
+
+template<typename RT>
+mpmt::agent_server<RT>::agent_server(const config& cfg, std::unique_ptr<union_snapshot<RT>> initial) :
+    mc_cache_entries(cfg.m_cache_entries),
+    mc_blind(cfg.m_blind_key ? std::optional<reveal_blind<RT>>(std::in_place, *cfg.m_blind_key) : std::nullopt),
+    m_current(nullptr),
+    m_epoch(1),
+    m_slots(),
+    m_publish_mutex(),
+    m_answered(0),
+    m_cache_hits(0),
+    m_pool(coro_pool::config{ cfg.m_workers, cfg.m_pin_workers })
+{
+    if (initial == nullptr)
+    {
+        throw protocol_exc
+        (
+            protocol_exc::exc_type::INVALID_STATE,
+            "agent_server requires an initial union snapshot."
+        );
+    }
+    if (mc_cache_entries > query_cache<RT>::mc_MAX_CAPACITY)
+    {
+        throw protocol_exc
+        (
+            protocol_exc::exc_type::INVALID_PARAMETER,
+            "agent_server cache of " + std::to_string(mc_cache_entries) + " entries exceeds the limit of "
+            + std::to_string(query_cache<RT>::mc_MAX_CAPACITY) + "."
+        );
+    }
+    m_current.store(new version{ std::move(initial), 1 }, std::memory_order_release);
+    m_slots = std::make_unique<reader_slot[]>(m_pool.threads());
+    MPMT_LOG_INFO("agent server started", "workers", m_pool.threads(), "slots", m_current.load()->m_snapshot->size());
+}
+
+template<typename RT>
+void mpmt::agent_server<RT>::serve(comm_adapter<RT>& session)
+{
+    m_pool.spawn(run_session(session));
+}
+
+template<typename RT>
+void mpmt::agent_server<RT>::publish(std::unique_ptr<union_snapshot<RT>> next)
+{
+    MPMT_PROF_SCOPE("agent_server::publish");
+    if (next == nullptr)
+    {
+        throw protocol_exc
+        (
+            protocol_exc::exc_type::INVALID_STATE,
+            "agent_server::publish() requires a non-empty union snapshot."
+        );
+    }
+
+    std::lock_guard<std::mutex> lock(m_publish_mutex);
+
+    // 1-替换快照后推进纪元：此后进入读取的线程只会看到新快照
+    const uint64_t c_epoch = m_epoch.load(std::memory_order_relaxed) + 1;
+    const version* old = m_current.exchange(new version{ std::move(next), c_epoch }, std::memory_order_seq_cst);
+    m_epoch.store(c_epoch, std::memory_order_seq_cst);
+
+    // 2-宽限期：等待仍停留在旧纪元的读取结束（每次读取只覆盖一次查询的槽位收集）
+    for (unsigned w = 0; w < m_pool.threads(); ++w)
+    {
+        for (;;)
+        {
+            const uint64_t c_seen = m_slots[w].m_epoch.load(std::memory_order_seq_cst);
+            if (c_seen == 0 || c_seen >= c_epoch)
+            {
+                break;
+            }
+            std::this_thread::yield();
+        }
+    }
+    delete old;
+    MPMT_LOG_INFO("union snapshot published", "epoch", c_epoch, "slots", m_current.load()->m_snapshot->size());
+}
+
+template<typename RT>
+void mpmt::agent_server<RT>::wait_idle()
+{
+    m_pool.wait_idle();
+}
+
+template<typename RT>
+mpmt::agent_server<RT>::~agent_server()
+{
+    // 会话协程全部结束后才释放快照；工作线程随m_pool析构停止
+    m_pool.wait_idle();
+    delete m_current.load();
+}
+
+template<typename RT>
+mpmt::coro_task<void> mpmt::agent_server<RT>::run_session(comm_adapter<RT>& session)
+{
+    std::vector<RT> message;
+    try
+    {
+        for (;;)
+        {
+            // 1-等待槽位令牌（若干64位槽位下标，经comm_packer打包），未到达时挂起，让出工作线程
+            message.clear();
+            co_await async_receive(m_pool, session, message);
+
+            // 2-在恢复本协程的工作线程上响应，期间不再挂起
+            answer(ass_wire::unpack_token(message), session);
+        }
+    }
+    catch (const comm_exc& e)
+    {
+        if (e.get_exc_type() != comm_exc::exc_type::CONNECTION_CLOSED)
+        {
+            MPMT_LOG_WARN("agent server session failed", "worker", coro_pool::worker_index(), "type", static_cast<int>(e.get_exc_type()));
+        }
+    }
+    catch (const protocol_exc& e)
+    {
+        // 报文不合法：结束该会话，不影响其他会话
+        MPMT_LOG_WARN("agent server session rejected", "worker", coro_pool::worker_index(), "type", static_cast<int>(e.get_exc_type()));
+        session.disconnect();
+    }
+}
+
+template<typename RT>
+void mpmt::agent_server<RT>::answer(const std::vector<RT>& token, comm_adapter<RT>& session)
+{
+    thread_local session_arena<RT> t_arena;
+    std::atomic<uint64_t>& slot_epoch = m_slots[coro_pool::worker_index()].m_epoch;
+    if (t_arena.m_cache.capacity() != mc_cache_entries)
+    {
+        t_arena.m_cache.resize(mc_cache_entries);
+    }
+    const uint64_t c_count = token.size() * sizeof(RT) / sizeof(uint64_t);
+
+    // 1-登记纪元后读取当前快照：先查缓存，未命中再收集，完毕即离开
+    const std::vector<RT>* cached = nullptr;
+    uint64_t bad_slot = 0;
+    uint64_t snap_size = 0;
+    bool in_range = true;
+    slot_epoch.store(m_epoch.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+    {
+        const version& current = *m_current.load(std::memory_order_seq_cst);
+        if (t_arena.m_cache_epoch != current.m_epoch)
+        {
+            t_arena.m_cache.clear();
+            t_arena.m_cache_epoch = current.m_epoch;
+        }
+        cached = t_arena.m_cache.find(token);
+
+        if (cached == nullptr)
+        {
+            t_arena.m_slots.resize(c_count);
+            t_arena.m_gathered.resize(c_count);
+            ass_wire::decode_bytes
+            (
+                token, 0, reinterpret_cast<uint8_t*>(t_arena.m_slots.data()), c_count * sizeof(uint64_t)
+            );
+
+            const union_snapshot<RT>& snap = *current.m_snapshot;
+            snap_size = snap.size();
+            for (uint64_t i = 0; i < c_count; ++i)
+            {
+                const uint64_t c_slot = t_arena.m_slots[i];
+                if (c_slot >= snap_size)
+                {
+                    bad_slot = c_slot;
+                    in_range = false;
+                    break;
+                }
+                t_arena.m_gathered[i] = snap[c_slot];
+            }
+        }
+    }
+    slot_epoch.store(0, std::memory_order_release);
+
+    if (!in_range)
+    {
+        throw protocol_exc
+        (
+            protocol_exc::exc_type::MESSAGE_CORRUPTION,
+            "query slot " + std::to_string(bad_slot) + " is out of range [0, "
+            + std::to_string(snap_size) + ")."
+        );
+    }
+
+    // 2-返回本方份额（缓存条目属于本线程，离开纪元后仍可读取）
+    if (cached != nullptr)
+    {
+        session.send(*cached);
+        m_cache_hits.fetch_add(1, std::memory_order_relaxed);
+    }
+    else
+    {
+        if (mc_blind)
+        {
+            mc_blind->apply(token, t_arena.m_gathered.data(), c_count);
+        }
+        t_arena.m_cache.insert(token, t_arena.m_gathered);
+        session.send(t_arena.m_gathered);
+    }
+    m_answered.fetch_add(1, std::memory_order_relaxed);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// 显式实例化
+template class mpmt::agent_server<mpmt::ring8>;
+template class mpmt::agent_server<mpmt::ring16>;
+template class mpmt::agent_server<mpmt::ring32>;
+template class mpmt::agent_server<mpmt::ring64>;
@@ -1 +1,353 @@
 #include "core/protocol/ass_impl/data_holder_ass.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "auxkit/profiler.hpp"
+#include "auxkit/stack_tracer.hpp"
+#include "core/exception/protocol_exc.hpp"
+#include "core/protocol/ass_impl/ass_wire.hpp"
+#include "core/protocol/ass_impl/chunk_queue.hpp"
+#include "core/rng/openssl_impl/prg_openssl.hpp"
+
+template<typename RT>
+mpmt::data_holder_ass<RT>::data_holder_ass(comm_adapter<RT>& as0, comm_adapter<RT>& as1)
+    :
+    m_map(),
+    m_as0{ &as0 },
+    m_as1{ &as1 },
+    m_input(),
+    m_bits(),
+    m_seeds(),
+    m_share_bits(sizeof(RT) * 8)
+{}
+
+template<typename RT>
+mpmt::data_holder_ass<RT>::data_holder_ass
+(
+    const shard_map& map,
+    const std::vector<comm_adapter<RT>*>& as0,
+    const std::vector<comm_adapter<RT>*>& as1
+) :
+    m_map(map),
+    m_as0(),
+    m_as1(),
+    m_input(),
+    m_bits(),
+    m_seeds(),
+    m_share_bits(sizeof(RT) * 8)
+{
+    set_connections(as0, as1);
+}
+
+template<typename RT>
+void mpmt::data_holder_ass<RT>::set_connections
+(
+    const std::vector<comm_adapter<RT>*>& as0,
+    const std::vector<comm_adapter<RT>*>& as1
+)
+{
+    if (as0.size() != m_map.shards() || as1.size() != m_map.shards())
+    {
+        throw protocol_exc
+        (
+            protocol_exc::exc_type::INVALID_PARAMETER,
+            "data holder needs one AS0 and one AS1 connection per shard, got " + std::to_string(as0.size())
+            + " and " + std::to_string(as1.size()) + " for " + std::to_string(m_map.shards()) + " shard(s)."
+        );
+    }
+    m_as0 = as0;
+    m_as1 = as1;
+}
+
+template<typename RT>
+void mpmt::data_holder_ass<RT>::set_share_bits(uint8_t bits)
+{
+    ass_wire::check_share_bits<RT>(bits);
+    m_share_bits = bits;
+}
+
+template<typename RT>
+void mpmt::data_holder_ass<RT>::set_input(rvector<RT>&& x)
+{
+    m_input = std::move(x);
+    m_bits.reset();
+    m_seeds.clear();
+}
+
+template<typename RT>
+void mpmt::data_holder_ass<RT>::set_input(slot_indicator&& x)
+{
+    m_bits.emplace(std::move(x));
+    m_input = rvector<RT>();
+    m_seeds.clear();
+}
+
+template<typename RT>
+mpmt::shard_map mpmt::data_holder_ass<RT>::begin_share(std::vector<seed_share<RT>>& seeds)
+{
+    const uint64_t c_size = input_size();
+    if (c_size == 0)
+    {
+        throw protocol_exc
+        (
+            protocol_exc::exc_type::INVALID_STATE,
+            "data_holder_ass::share() called before set_input()."
+        );
+    }
+
+    if (m_map.shards() > 1 && c_size != m_map.slots())
+    {
+        throw protocol_exc
+        (
+            protocol_exc::exc_type::INVALID_PARAMETER,
+            "encoded vector of " + std::to_string(c_size) + " slot(s) does not match the shard map of "
+            + std::to_string(m_map.slots()) + " slot(s)."
+        );
+    }
+    const shard_map c_map = m_map.shards() > 1 ? m_map : shard_map(c_size, 1);
+
+    // 每个分片取独立的种子（同一输入只抽取一次）发送给该分片的AS0，并向该分片的AS1声明份额长度
+    if (m_seeds.size() != c_map.shards())
+    {
+        m_seeds.clear();
+        for (uint32_t s = 0; s < c_map.shards(); ++s)
+        {
+            m_seeds.push_back(prg_openssl::fresh_seed());
+        }
+    }
+    seeds.clear();
+    seeds.reserve(c_map.shards());
+    for (uint32_t s = 0; s < c_map.shards(); ++s)
+    {
+        seeds.emplace_back(m_seeds[s], c_map.count(s));
+        m_as0[s]->send(seeds.back().encode());
+        ass_wire::send_u64(*m_as1[s], c_map.count(s));
+    }
+    return c_map;
+}
+
+template<typename RT>
+void mpmt::data_holder_ass<RT>::share()
+{
+    MPMT_PROF_SCOPE("data_holder_ass::share");
+
+    // 1-发送种子与份额长度
+    std::vector<seed_share<RT>> seeds;
+    const shard_map c_map = begin_share(seeds);
+    uint64_t num_chunks = 0;
+    for (uint32_t s = 0; s < c_map.shards(); ++s)
+    {
+        num_chunks += (c_map.count(s) + ass_wire::mc_CHUNK_SIZE - 1) / ass_wire::mc_CHUNK_SIZE;
+    }
+
+    // 2-逐块计算 x - PRG(seed) mod 2^{share_bits} 并发送给所属分片的AS1：编码、掩码、发送三级
+    const RT c_mask = ass_wire::share_mask<RT>(m_share_bits);
+    struct chunk
+    {
+        uint32_t m_shard = 0;       // 所属分片
+        uint64_t m_offset = 0;      // 分片内起始下标
+        std::vector<RT> m_data;     // 编码值，掩码后为AS1的份额
+    };
+    auto encode = [&](chunk& c)
+    {
+        encode_into(c_map.first(c.m_shard) + c.m_offset, c.m_data.data(), c.m_data.size());
+    };
+    auto mask = [&](chunk& c, std::vector<RT>& pad)
+    {
+        pad.resize(c.m_data.size());
+        seeds[c.m_shard].expand_into(c.m_offset, pad.data(), pad.size());
+        for (uint64_t i = 0; i < pad.size(); ++i)
+        {
+            c.m_data[i] = static_cast<RT>((c.m_data[i] - pad[i]) & c_mask);
+        }
+    };
+    // 按分片号、分片内偏移依次枚举分块，返回false表示已枚举完
+    auto next = [&](chunk& c, uint32_t& shard, uint64_t& offset)
+    {
+        while (shard < c_map.shards() && offset >= c_map.count(shard))
+        {
+            ++shard;
+            offset = 0;
+        }
+        if (shard == c_map.shards())
+        {
+            return false;
+        }
+        c.m_shard = shard;
+        c.m_offset = offset;
+        c.m_data.resize(std::min(ass_wire::mc_CHUNK_SIZE, c_map.count(shard) - offset));
+        offset += c.m_data.size();
+        return true;
+    };
+
+    uint32_t shard = 0;
+    uint64_t offset = 0;
+    if (num_chunks <= 1)
+    {
+        // 只有一块时无可重叠，直接在当前线程完成
+        chunk c;
+        std::vector<RT> pad;
+        while (next(c, shard, offset))
+        {
+            encode(c);
+            mask(c, pad);
+            ass_wire::send_share_chunk(*m_as1[c.m_shard], c.m_data);
+        }
+        return;
+    }
+
+    // 缓存区在空闲、已编码、已掩码三个队列间循环，在途分块数不超过mc_PIPE_BUFFERS
+    const uint64_t c_buffers = std::min(mc_PIPE_BUFFERS, num_chunks);
+    chunk_queue<chunk> idle(c_buffers);
+    chunk_queue<chunk> encoded(c_buffers);
+    chunk_queue<chunk> masked(c_buffers);
+    for (uint64_t b = 0; b < c_buffers; ++b)
+    {
+        idle.push(chunk{});
+    }
+    auto abort_all = [&]
+    {
+        idle.close();
+        encoded.close();
+        masked.close();
+    };
+
+    std::exception_ptr encode_failure;
+    std::exception_ptr mask_failure;
+    std::thread encoder([&]
+    {
+        utils::stack_tracer::install_thread_alt_stack();
+        MPMT_PROF_SCOPE("data_holder_ass::encode");
+        try
+        {
+            chunk c;
+            while (idle.pop(c) && next(c, shard, offset))
+            {
+                encode(c);
+                if (!encoded.push(std::move(c)))
+                {
+                    break;
+                }
+            }
+            encoded.close();
+        }
+        catch (...)
+        {
+            encode_failure = std::current_exception();
+            abort_all();
+        }
+    });
+    std::thread masker([&]
+    {
+        utils::stack_tracer::install_thread_alt_stack();
+        MPMT_PROF_SCOPE("data_holder_ass::mask");
+        try
+        {
+            chunk c;
+            std::vector<RT> pad;
+            while (encoded.pop(c))
+            {
+                mask(c, pad);
+                if (!masked.push(std::move(c)))
+                {
+                    break;
+                }
+            }
+            masked.close();
+        }
+        catch (...)
+        {
+            mask_failure = std::current_exception();
+            abort_all();
+        }
+    });
+
+    std::exception_ptr send_failure;
+    try
+    {
+        chunk c;
+        while (masked.pop(c))
+        {
+            ass_wire::send_share_chunk(*m_as1[c.m_shard], c.m_data);
+            idle.push(std::move(c));
+        }
+    }
+    catch (...)
+    {
+        send_failure = std::current_exception();
+        abort_all();
+    }
+    encoder.join();
+    masker.join();
+
+    for (const std::exception_ptr& failure : { send_failure, mask_failure, encode_failure })
+    {
+        if (failure)
+        {
+            std::rethrow_exception(failure);
+        }
+    }
+}
+
+template<typename RT>
+mpmt::coro_task<void> mpmt::data_holder_ass<RT>::share_async(coro_pool& pool)
+{
+    // 1-发送种子与份额长度
+    std::vector<seed_share<RT>> seeds;
+    const shard_map c_map = begin_share(seeds);
+
+    // 2-逐块编码，等待PRG展开，掩码后发送给所属分片的AS1
+    const RT c_mask = ass_wire::share_mask<RT>(m_share_bits);
+    std::vector<RT> data;
+    std::vector<RT> pad;
+    for (uint32_t s = 0; s < c_map.shards(); ++s)
+    {
+        for (uint64_t offset = 0; offset < c_map.count(s); offset += data.size())
+        {
+            const uint64_t c_len = std::min(ass_wire::mc_CHUNK_SIZE, c_map.count(s) - offset);
+            data.resize(c_len);
+            pad.resize(c_len);
+            encode_into(c_map.first(s) + offset, data.data(), c_len);
+            co_await seeds[s].expand_async(&pool, offset, pad.data(), c_len);
+            for (uint64_t i = 0; i < c_len; ++i)
+            {
+                data[i] = static_cast<RT>((data[i] - pad[i]) & c_mask);
+            }
+            ass_wire::send_share_chunk(*m_as1[s], data);
+        }
+    }
+}
+
+template<typename RT>
+void mpmt::data_holder_ass<RT>::encode_into(uint64_t first, RT* out, uint64_t len) const
+{
+    if (m_bits)
+    {
+        m_bits->template expand_into<RT>(first, out, len);
+    }
+    else
+    {
+        std::copy_n(m_input.data() + first, len, out);
+    }
+}
+
+template<typename RT>
+void mpmt::data_holder_ass<RT>::reveal()
+{
+    throw protocol_exc
+    (
+        protocol_exc::exc_type::UNSUPPORTED_OPERATION,
+        "data holders do not take part in reveal()."
+    );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// 显式实例化
+template class mpmt::data_holder_ass<mpmt::ring8>;
+template class mpmt::data_holder_ass<mpmt::ring16>;
+template class mpmt::data_holder_ass<mpmt::ring32>;
+template class mpmt::data_holder_ass<mpmt::ring64>;
@@ -0,0 +1,383 @@
+#include "core/protocol/ass_impl/merge_checkpoint.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <stdexcept>
+#include <utility>
+
+#include "auxkit/logger.hpp"
+#include "auxkit/profiler.hpp"
+#include "auxkit/stack_tracer.hpp"
+#include "core/exception/mrvf_exc.hpp"
+#include "core/exception/protocol_exc.hpp"
+#include "core/io/durable_file.hpp"
+#include "core/ring/mrvf/mrvf.hpp"
+#include "core/ring/mrvf/mrvf_handler.hpp"
+
+namespace
+{
+    constexpr const char* c_MANIFEST_MAGIC = "mpmt-merge-checkpoint";   // 清单首行标识
+    constexpr uint64_t c_MANIFEST_VERSION = 1;                          // 清单格式版本
+}
+
+template<typename RT>
+mpmt::merge_checkpoint<RT>::merge_checkpoint(const config& cfg, ass_role role) :
+    mc_config(cfg),
+    mc_role(role),
+    m_mutex(),
+    m_job_cv(),
+    m_done_cv(),
+    m_snapshot(),
+    m_snapshot_progress(),
+    m_has_job(false),
+    m_stop(false),
+    m_busy(false),
+    m_failure(),
+    m_last(clock::now()),
+    m_generation(0),
+    m_committed_file(),
+    m_written(0),
+    m_thread()
+{
+    // 1-从已有检查点的代数继续编号，新快照不会覆盖清单仍指向的文件
+    const std::optional<manifest> c_existing = read_manifest(cfg.m_path, role);
+    if (c_existing)
+    {
+        m_generation = c_existing->m_generation;
+        m_committed_file = sibling_of(cfg.m_path, c_existing->m_union_file);
+    }
+
+    // 2-清除清单未引用的快照与临时文件（清单提交后、删除上一代快照前崩溃时遗留）
+    remove_orphans(cfg.m_path, c_existing ? c_existing->m_union_file : std::string());
+    m_thread = std::thread([this] { work(); });
+}
+
+template<typename RT>
+bool mpmt::merge_checkpoint<RT>::offer(const rvector<RT>& acc, const merge_progress& progress)
+{
+    // 快速路径：在途或间隔未到时不加锁直接返回
+    if (m_busy.load(std::memory_order_acquire))
+    {
+        return false;
+    }
+    const clock::time_point c_now = clock::now();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (std::chrono::duration<double>(c_now - m_last).count() < mc_config.m_interval_seconds)
+    {
+        return false;
+    }
+    m_failure = nullptr;
+    submit(acc, progress);
+    return true;
+}
+
+template<typename RT>
+void mpmt::merge_checkpoint<RT>::commit(const rvector<RT>& acc, const merge_progress& progress)
+{
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_done_cv.wait(lock, [this] { return !m_busy.load(std::memory_order_acquire); });
+        m_failure = nullptr;
+        submit(acc, progress);
+    }
+    wait();
+}
+
+template<typename RT>
+void mpmt::merge_checkpoint<RT>::wait()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_done_cv.wait(lock, [this] { return !m_busy.load(std::memory_order_acquire); });
+    if (m_failure)
+    {
+        std::rethrow_exception(std::exchange(m_failure, nullptr));
+    }
+}
+
+template<typename RT>
+std::optional<typename mpmt::merge_checkpoint<RT>::resume_point>
+mpmt::merge_checkpoint<RT>::load(const std::string& path, ass_role role)
+{
+    MPMT_PROF_SCOPE("merge_checkpoint::load");
+    const std::optional<manifest> c_manifest = read_manifest(path, role);
+    if (!c_manifest)
+    {
+        return std::nullopt;
+    }
+
+    // 快照的CRC由mrvf校验，长度与清单交叉校验
+    mrvf_handler<RT> handler(typename mrvf_handler<RT>::config{ false, false });
+    mrvf<RT> snapshot = handler.load(sibling_of(path, c_manifest->m_union_file));
+    if (snapshot.m_rvector.size() != c_manifest->m_slots)
+    {
+        throw protocol_exc
+        (
+            protocol_exc::exc_type::INVALID_STATE,
+            "checkpoint snapshot [" + c_manifest->m_union_file + "] holds " + std::to_string(snapshot.m_rvector.size())
+            + " slot(s), but its manifest records " + std::to_string(c_manifest->m_slots) + "."
+        );
+    }
+    MPMT_LOG_INFO("merge checkpoint loaded", "generation", c_manifest->m_generation,
+        "folded", c_manifest->m_progress.m_folded, "slots_done", c_manifest->m_progress.m_slots_done);
+    return resume_point{ std::move(snapshot.m_rvector), c_manifest->m_progress };
+}
+
+template<typename RT>
+mpmt::merge_checkpoint<RT>::~merge_checkpoint()
+{
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_done_cv.wait(lock, [this] { return !m_busy.load(std::memory_order_acquire); });
+        m_stop = true;
+    }
+    m_job_cv.notify_all();
+    m_thread.join();
+}
+
+template<typename RT>
+void mpmt::merge_checkpoint<RT>::submit(const rvector<RT>& acc, const merge_progress& progress)
+{
+    MPMT_PROF_SCOPE("merge_checkpoint::submit");
+    m_snapshot = rvector<RT>(acc);
+    m_snapshot_progress = progress;
+    m_has_job = true;
+    m_busy.store(true, std::memory_order_release);
+    m_last = clock::now();
+    m_job_cv.notify_one();
+}
+
+template<typename RT>
+void mpmt::merge_checkpoint<RT>::work()
+{
+    utils::stack_tracer::install_thread_alt_stack();
+    for (;;)
+    {
+        rvector<RT> snapshot;
+        merge_progress progress;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_job_cv.wait(lock, [this] { return m_stop || m_has_job; });
+            if (!m_has_job)
+            {
+                return;
+            }
+            snapshot = std::move(m_snapshot);
+            progress = m_snapshot_progress;
+            m_has_job = false;
+        }
+
+        std::exception_ptr failure;
+        try
+        {
+            write(std::move(snapshot), progress);
+        }
+        catch (...)
+        {
+            MPMT_LOG_WARN("merge checkpoint failed", "generation", m_generation + 1, "folded", progress.m_folded);
+            failure = std::current_exception();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_failure = failure;
+            m_busy.store(false, std::memory_order_release);
+        }
+        m_done_cv.notify_all();
+    }
+}
+
+template<typename RT>
+void mpmt::merge_checkpoint<RT>::write(rvector<RT>&& snapshot, const merge_progress& progress)
+{
+    MPMT_PROF_SCOPE("merge_checkpoint::write");
+    const uint64_t c_generation = m_generation + 1;
+    const uint64_t c_slots = snapshot.size();
+    const std::string c_union_path = mc_config.m_path + ".gen" + std::to_string(c_generation) + ".mrvf";
+
+    // 1-快照：写临时文件、落盘、原子重命名（mrvf_handler::save）
+    mrvf_handler<RT> handler(typename mrvf_handler<RT>::config{ false, false });
+    handler.save(c_union_path, mrvf<RT>(std::move(snapshot)));
+
+    // 2-清单：同样先写临时文件，替换成功即提交本检查点
+    const std::string c_manifest_path = manifest_path(mc_config.m_path);
+    const std::string c_temp = durable_file::temp_path(c_manifest_path);
+    {
+        std::ofstream out(c_temp, std::ios::trunc);
+        const std::string::size_type c_slash = c_union_path.find_last_of('/');
+        out << c_MANIFEST_MAGIC << ' ' << c_MANIFEST_VERSION << '\n'
+            << "role " << static_cast<unsigned>(mc_role) << '\n'
+            << "ring_bits " << sizeof(RT) * 8 << '\n'
+            << "slots " << c_slots << '\n'
+            << "links " << progress.m_links << '\n'
+            << "folded " << progress.m_folded << '\n'
+            << "slots_done " << progress.m_slots_done << '\n'
+            << "generation " << c_generation << '\n'
+            << "union " << (c_slash == std::string::npos ? c_union_path : c_union_path.substr(c_slash + 1)) << '\n';
+        out.close();
+        if (!out)
+        {
+            durable_file::remove(c_temp);
+            throw mrvf_exc(mrvf_exc::exc_type::IOFLOW_ERROR, "Cannot write the checkpoint manifest [" + c_temp + "].");
+        }
+    }
+    try
+    {
+        durable_file::commit(c_temp, c_manifest_path);
+    }
+    catch (const std::runtime_error& e)
+    {
+        durable_file::remove(c_temp);
+        throw mrvf_exc(mrvf_exc::exc_type::IOFLOW_ERROR, e.what());
+    }
+
+    // 3-提交后上一代快照不再被引用
+    if (!m_committed_file.empty() && m_committed_file != c_union_path)
+    {
+        durable_file::remove(m_committed_file);
+    }
+    m_generation = c_generation;
+    m_committed_file = c_union_path;
+    m_written.fetch_add(1, std::memory_order_relaxed);
+    MPMT_LOG_INFO("merge checkpoint written", "generation", c_generation, "folded", progress.m_folded, "slots_done", progress.m_slots_done);
+}
+
+template<typename RT>
+std::optional<typename mpmt::merge_checkpoint<RT>::manifest>
+mpmt::merge_checkpoint<RT>::read_manifest(const std::string& path, ass_role role)
+{
+    const std::string c_path = manifest_path(path);
+    std::ifstream in(c_path);
+    if (!in)
+    {
+        return std::nullopt;
+    }
+
+    auto corrupt = [&c_path](const std::string& reason)
+    {
+        return protocol_exc
+        (
+            protocol_exc::exc_type::INVALID_STATE,
+            "checkpoint manifest [" + c_path + "] " + reason
+        );
+    };
+
+    // 1-首行为标识与版本，其余每行一个键值对
+    std::string magic;
+    uint64_t version = 0;
+    if (!(in >> magic >> version) || magic != c_MANIFEST_MAGIC || version != c_MANIFEST_VERSION)
+    {
+        throw corrupt("is not a version " + std::to_string(c_MANIFEST_VERSION) + " merge checkpoint manifest.");
+    }
+    std::map<std::string, std::string> fields;
+    std::string key;
+    std::string value;
+    while (in >> key >> value)
+    {
+        fields[key] = value;
+    }
+    auto number = [&](const char* name)
+    {
+        const auto c_it = fields.find(name);
+        if (c_it == fields.end())
+        {
+            throw corrupt("has no field [" + std::string(name) + "].");
+        }
+        try
+        {
+            return static_cast<uint64_t>(std::stoull(c_it->second));
+        }
+        catch (const std::exception&)
+        {
+            throw corrupt("has a malformed field [" + std::string(name) + "].");
+        }
+    };
+
+    // 2-校验角色、环位宽与进度
+    manifest result;
+    if (number("role") != static_cast<uint64_t>(role))
+    {
+        throw corrupt("belongs to agent AS" + std::to_string(number("role")) + ", not AS" + std::to_string(static_cast<unsigned>(role)) + ".");
+    }
+    if (number("ring_bits") != sizeof(RT) * 8)
+    {
+        throw corrupt("was written for Z_{2^" + std::to_string(number("ring_bits")) + "}, not Z_{2^" + std::to_string(sizeof(RT) * 8) + "}.");
+    }
+    result.m_slots = number("slots");
+    result.m_progress.m_links = number("links");
+    result.m_progress.m_folded = number("folded");
+    result.m_progress.m_slots_done = number("slots_done");
+    result.m_generation = number("generation");
+    if (result.m_progress.m_folded > result.m_progress.m_links || result.m_progress.m_slots_done > result.m_slots)
+    {
+        throw corrupt("records progress beyond its own bounds.");
+    }
+    const auto c_union = fields.find("union");
+    if (c_union == fields.end())
+    {
+        throw corrupt("has no field [union].");
+    }
+    result.m_union_file = c_union->second;
+    return result;
+}
+
+template<typename RT>
+void mpmt::merge_checkpoint<RT>::remove_orphans(const std::string& path, const std::string& keep)
+{
+    const std::string::size_type c_slash = path.find_last_of('/');
+    const std::string c_base = c_slash == std::string::npos ? path : path.substr(c_slash + 1);
+    const std::string c_gen_prefix = c_base + ".gen";
+    const std::string c_manifest_temp = c_base + ".manifest.tmp";
+
+    // <prefix>.gen<g>.mrvf与<prefix>.gen<g>.mrvf.tmp中除清单引用的快照以外均为孤儿，残留的清单临时文件同理
+    auto orphan = [&](const std::string& name)
+    {
+        if (name == c_manifest_temp)
+        {
+            return true;
+        }
+        if (name == keep || name.compare(0, c_gen_prefix.size(), c_gen_prefix) != 0)
+        {
+            return false;
+        }
+        const std::string::size_type c_digits_end = name.find_first_not_of("0123456789", c_gen_prefix.size());
+        if (c_digits_end == c_gen_prefix.size() || c_digits_end == std::string::npos)
+        {
+            return false;
+        }
+        const std::string c_suffix = name.substr(c_digits_end);
+        return c_suffix == ".mrvf" || c_suffix == ".mrvf.tmp";
+    };
+
+    std::error_code ec;
+    const std::filesystem::path c_dir = c_slash == std::string::npos ? std::filesystem::path(".")
+        : std::filesystem::path(c_slash == 0 ? "/" : path.substr(0, c_slash));
+    uint64_t removed = 0;
+    for (std::filesystem::directory_iterator it(c_dir, ec), end; !ec && it != end; it.increment(ec))
+    {
+        const std::string c_name = it->path().filename().string();
+        if (orphan(c_name))
+        {
+            durable_file::remove(sibling_of(path, c_name));
+            ++removed;
+        }
+    }
+    if (removed != 0)
+    {
+        MPMT_LOG_INFO("merge checkpoint orphans removed", "files", removed);
+    }
+}
+
+template<typename RT>
+std::string mpmt::merge_checkpoint<RT>::sibling_of(const std::string& path, const std::string& file)
+{
+    const std::string::size_type c_slash = path.find_last_of('/');
+    return c_slash == std::string::npos ? file : path.substr(0, c_slash + 1) + file;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// 显式实例化
+template class mpmt::merge_checkpoint<mpmt::ring8>;
+template class mpmt::merge_checkpoint<mpmt::ring16>;
+template class mpmt::merge_checkpoint<mpmt::ring32>;
+template class mpmt::merge_checkpoint<mpmt::ring64>;
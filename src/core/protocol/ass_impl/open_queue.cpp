@@ -0,0 +1,280 @@
+#include "core/protocol/ass_impl/open_queue.hpp"
+
+#include <algorithm>
+#include <string>
+
+#include "auxkit/profiler.hpp"
+#include "core/coro/coro_comm.hpp"
+#include "core/exception/protocol_exc.hpp"
+#include "core/protocol/ass_impl/ass_wire.hpp"
+
+template<typename RT>
+mpmt::open_queue<RT>::open_queue
+(
+    const shard_map& map,
+    const std::vector<comm_adapter<RT>*>& as0,
+    const std::vector<comm_adapter<RT>*>& as1
+) :
+    m_map(map),
+    m_as0(as0),
+    m_as1(as1),
+    m_phase(phase::COLLECTING),
+    m_base(0),
+    m_requests(),
+    m_slots(),
+    m_shard_slots(map.shards(), 0),
+    m_tokens(map.shards()),
+    m_counts(),
+    m_share_mask(ass_wire::share_mask<RT>(sizeof(RT) * 8)),
+    m_rounds(0)
+{
+    if (as0.size() != map.shards() || as1.size() != map.shards())
+    {
+        throw protocol_exc
+        (
+            protocol_exc::exc_type::INVALID_PARAMETER,
+            "open queue needs one AS0 and one AS1 connection per shard, got " + std::to_string(as0.size())
+            + " and " + std::to_string(as1.size()) + " for " + std::to_string(map.shards()) + " shard(s)."
+        );
+    }
+}
+
+template<typename RT>
+typename mpmt::open_queue<RT>::ticket mpmt::open_queue<RT>::defer(const std::vector<uint64_t>& slots)
+{
+    if (m_phase == phase::SENT)
+    {
+        throw protocol_exc
+        (
+            protocol_exc::exc_type::INVALID_STATE,
+            "open_queue::defer() called while a round is in flight."
+        );
+    }
+    if (m_phase == phase::RESOLVED)
+    {
+        next_layer();
+    }
+
+    std::vector<uint64_t> request(slots);
+    std::sort(request.begin(), request.end());
+    request.erase(std::unique(request.begin(), request.end()), request.end());
+    if (!request.empty() && request.back() >= m_map.slots())
+    {
+        throw protocol_exc
+        (
+            protocol_exc::exc_type::INVALID_PARAMETER,
+            "query slot " + std::to_string(request.back()) + " is out of range [0, "
+            + std::to_string(m_map.slots()) + ")."
+        );
+    }
+    m_requests.push_back(std::move(request));
+    return m_base + m_requests.size() - 1;
+}
+
+template<typename RT>
+void mpmt::open_queue<RT>::send()
+{
+    MPMT_PROF_SCOPE("open_queue::send");
+    if (m_phase != phase::COLLECTING || m_requests.empty())
+    {
+        throw protocol_exc
+        (
+            protocol_exc::exc_type::INVALID_STATE,
+            "open_queue::send() called without pending requests."
+        );
+    }
+
+    // 1-本层槽位取并集：各请求已升序，归并后去重
+    m_slots.clear();
+    for (const std::vector<uint64_t>& request : m_requests)
+    {
+        const uint64_t c_mid = m_slots.size();
+        m_slots.insert(m_slots.end(), request.begin(), request.end());
+        std::inplace_merge(m_slots.begin(), m_slots.begin() + c_mid, m_slots.end());
+    }
+    m_slots.erase(std::unique(m_slots.begin(), m_slots.end()), m_slots.end());
+
+    // 2-按分片路由：升序槽位按分片拆分后各段仍升序，换算为分片内下标后分别编码并发送
+    std::vector<uint64_t> local;
+    uint64_t next = 0;
+    for (uint32_t s = 0; s < m_map.shards(); ++s)
+    {
+        local.clear();
+        for (; next < m_slots.size() && m_map.owner(m_slots[next]) == s; ++next)
+        {
+            local.push_back(m_slots[next] - m_map.first(s));
+        }
+        m_shard_slots[s] = local.size();
+        m_tokens[s] = ass_wire::encode_bytes<RT>
+        (
+            reinterpret_cast<const uint8_t*>(local.data()),
+            local.size() * sizeof(uint64_t)
+        );
+        // 不含本层槽位的分片不参与本轮，其代理方对既不收到令牌也不返回份额
+        if (!local.empty())
+        {
+            ass_wire::send_token(*m_as0[s], m_tokens[s]);
+            ass_wire::send_token(*m_as1[s], m_tokens[s]);
+        }
+    }
+    m_phase = phase::SENT;
+}
+
+template<typename RT>
+void mpmt::open_queue<RT>::receive()
+{
+    MPMT_PROF_SCOPE("open_queue::receive");
+    begin_receive();
+
+    // 按分片号依次收回两方份额，拼接即还原全局槽位顺序
+    std::vector<RT> share0;
+    std::vector<RT> share1;
+    for (uint32_t s = 0; s < m_map.shards(); ++s)
+    {
+        if (m_shard_slots[s] == 0)
+        {
+            continue;
+        }
+        m_as0[s]->receive(share0);
+        m_as1[s]->receive(share1);
+        absorb(s, share0, share1);
+    }
+    end_receive();
+}
+
+template<typename RT>
+mpmt::coro_task<void> mpmt::open_queue<RT>::receive_async(coro_pool& pool)
+{
+    begin_receive();
+
+    // 与receive()相同，份额未到达时挂起而非阻塞线程；各方在send()时已收到令牌，逐个等待不增加轮数
+    std::vector<RT> share0;
+    std::vector<RT> share1;
+    for (uint32_t s = 0; s < m_map.shards(); ++s)
+    {
+        if (m_shard_slots[s] == 0)
+        {
+            continue;
+        }
+        co_await async_receive(pool, *m_as0[s], share0);
+        co_await async_receive(pool, *m_as1[s], share1);
+        absorb(s, share0, share1);
+    }
+    end_receive();
+}
+
+template<typename RT>
+void mpmt::open_queue<RT>::clear()
+{
+    if (m_phase == phase::SENT)
+    {
+        throw protocol_exc
+        (
+            protocol_exc::exc_type::INVALID_STATE,
+            "open_queue::clear() called while a round is in flight."
+        );
+    }
+    next_layer();
+}
+
+template<typename RT>
+void mpmt::open_queue<RT>::set_share_bits(uint8_t bits)
+{
+    ass_wire::check_share_bits<RT>(bits);
+    m_share_mask = ass_wire::share_mask<RT>(bits);
+}
+
+template<typename RT>
+std::vector<RT> mpmt::open_queue<RT>::counts(ticket t) const
+{
+    const std::vector<uint64_t>& c_request = m_requests[index_of(t)];
+    std::vector<RT> result;
+    result.reserve(c_request.size());
+    for (const uint64_t c_slot : c_request)
+    {
+        const uint64_t c_pos = std::lower_bound(m_slots.begin(), m_slots.end(), c_slot) - m_slots.begin();
+        result.push_back(m_counts[c_pos]);
+    }
+    return result;
+}
+
+template<typename RT>
+bool mpmt::open_queue<RT>::all_nonzero(ticket t) const
+{
+    const std::vector<uint64_t>& c_request = m_requests[index_of(t)];
+    return std::all_of(c_request.begin(), c_request.end(), [this](const uint64_t c_slot)
+    {
+        const uint64_t c_pos = std::lower_bound(m_slots.begin(), m_slots.end(), c_slot) - m_slots.begin();
+        return m_counts[c_pos] != 0;
+    });
+}
+
+template<typename RT>
+void mpmt::open_queue<RT>::begin_receive()
+{
+    if (m_phase != phase::SENT)
+    {
+        throw protocol_exc
+        (
+            protocol_exc::exc_type::INVALID_STATE,
+            "open_queue::receive() called before send()."
+        );
+    }
+    m_counts.clear();
+    m_counts.reserve(m_slots.size());
+}
+
+template<typename RT>
+void mpmt::open_queue<RT>::absorb(uint32_t shard, const std::vector<RT>& share0, const std::vector<RT>& share1)
+{
+    if (share0.size() != m_shard_slots[shard] || share1.size() != m_shard_slots[shard])
+    {
+        throw protocol_exc
+        (
+            protocol_exc::exc_type::MESSAGE_CORRUPTION,
+            "agents returned " + std::to_string(share0.size()) + " and " + std::to_string(share1.size())
+            + " share(s) for a query of " + std::to_string(m_shard_slots[shard]) + " slot(s) on shard "
+            + std::to_string(shard) + "."
+        );
+    }
+    for (uint64_t i = 0; i < share0.size(); ++i)
+    {
+        m_counts.push_back(static_cast<RT>((share0[i] + share1[i]) & m_share_mask));
+    }
+}
+
+template<typename RT>
+void mpmt::open_queue<RT>::end_receive()
+{
+    m_phase = phase::RESOLVED;
+    ++m_rounds;
+}
+
+template<typename RT>
+void mpmt::open_queue<RT>::next_layer()
+{
+    m_base += m_requests.size();
+    m_requests.clear();
+    m_phase = phase::COLLECTING;
+}
+
+template<typename RT>
+uint64_t mpmt::open_queue<RT>::index_of(ticket t) const
+{
+    if (m_phase != phase::RESOLVED || t < m_base || t - m_base >= m_requests.size())
+    {
+        throw protocol_exc
+        (
+            protocol_exc::exc_type::INVALID_STATE,
+            "ticket " + std::to_string(t) + " is not a resolved request of the current layer."
+        );
+    }
+    return t - m_base;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// 显式实例化
+template class mpmt::open_queue<mpmt::ring8>;
+template class mpmt::open_queue<mpmt::ring16>;
+template class mpmt::open_queue<mpmt::ring32>;
+template class mpmt::open_queue<mpmt::ring64>;
@@ -1 +1,91 @@
 #include "core/protocol/ass_impl/querier_ass.hpp"
+
+#include <algorithm>
+#include <string>
+
+#include "auxkit/profiler.hpp"
+#include "core/exception/protocol_exc.hpp"
+
+template<typename RT>
+mpmt::querier_ass<RT>::querier_ass(comm_adapter<RT>& as0, comm_adapter<RT>& as1)
+    :
+    m_queue(shard_map(), { &as0 }, { &as1 }),
+    m_ticket(0),
+    m_slots(),
+    m_counts(),
+    m_result(false)
+{}
+
+template<typename RT>
+mpmt::querier_ass<RT>::querier_ass
+(
+    const shard_map& map,
+    const std::vector<comm_adapter<RT>*>& as0,
+    const std::vector<comm_adapter<RT>*>& as1
+) :
+    m_queue(map, as0, as1),
+    m_ticket(0),
+    m_slots(),
+    m_counts(),
+    m_result(false)
+{}
+
+template<typename RT>
+void mpmt::querier_ass<RT>::set_query(const std::vector<uint64_t>& slots)
+{
+    // 规范化槽位，使同一凭据的令牌逐字节相同
+    m_slots = slots;
+    std::sort(m_slots.begin(), m_slots.end());
+    m_slots.erase(std::unique(m_slots.begin(), m_slots.end()), m_slots.end());
+}
+
+template<typename RT>
+void mpmt::querier_ass<RT>::query()
+{
+    MPMT_PROF_SCOPE("querier_ass::query");
+    share();
+    reveal();
+}
+
+template<typename RT>
+void mpmt::querier_ass<RT>::share()
+{
+    if (m_slots.empty())
+    {
+        throw protocol_exc
+        (
+            protocol_exc::exc_type::INVALID_STATE,
+            "querier_ass::share() called before set_query()."
+        );
+    }
+    // 以只含本次查询的一层发送，丢弃经queue()登记但尚未发送的请求
+    m_queue.clear();
+    m_ticket = m_queue.defer(m_slots);
+    m_queue.send();
+}
+
+template<typename RT>
+void mpmt::querier_ass<RT>::reveal()
+{
+    // 收回各分片两方份额并恢复计数，全部非0即命中
+    m_queue.receive();
+    m_counts = m_queue.counts(m_ticket);
+    m_result = m_queue.all_nonzero(m_ticket);
+}
+
+template<typename RT>
+mpmt::coro_task<void> mpmt::querier_ass<RT>::query_async(coro_pool& pool)
+{
+    // 发送不会阻塞，等待份额时挂起
+    share();
+    co_await m_queue.receive_async(pool);
+    m_counts = m_queue.counts(m_ticket);
+    m_result = m_queue.all_nonzero(m_ticket);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// 显式实例化
+template class mpmt::querier_ass<mpmt::ring8>;
+template class mpmt::querier_ass<mpmt::ring16>;
+template class mpmt::querier_ass<mpmt::ring32>;
+template class mpmt::querier_ass<mpmt::ring64>;
@@ -0,0 +1,153 @@
+#include "core/protocol/ass_impl/query_cache.hpp"
+
+#include <functional>
+#include <string>
+#include <string_view>
+
+#include "core/exception/protocol_exc.hpp"
+
+template<typename RT>
+mpmt::query_cache<RT>::query_cache(uint64_t capacity) :
+    m_capacity(0),
+    m_entries(),
+    m_index(),
+    m_spare(),
+    m_used(0),
+    m_hand(0),
+    m_hits(0),
+    m_misses(0)
+{
+    resize(capacity);
+}
+
+template<typename RT>
+const std::vector<RT>* mpmt::query_cache<RT>::find(const std::vector<RT>& token)
+{
+    if (m_capacity == 0)
+    {
+        return nullptr;
+    }
+
+    const auto c_it = m_index.find(hash_of(token));
+    if (c_it == m_index.end() || m_entries[c_it->second].m_token != token)
+    {
+        ++m_misses;
+        return nullptr;
+    }
+    entry& hit = m_entries[c_it->second];
+    hit.m_referenced = true;
+    ++m_hits;
+    return &hit.m_shares;
+}
+
+template<typename RT>
+void mpmt::query_cache<RT>::insert(const std::vector<RT>& token, const std::vector<RT>& shares)
+{
+    if (m_capacity == 0)
+    {
+        return;
+    }
+
+    // 1-选择条目：同哈希的条目直接覆盖，未满时取新条目，已满时按CLOCK淘汰
+    const uint64_t c_hash = hash_of(token);
+    uint64_t slot = 0;
+    const auto c_it = m_index.find(c_hash);
+    if (c_it != m_index.end())
+    {
+        slot = c_it->second;
+    }
+    else if (m_used < m_capacity)
+    {
+        slot = m_used++;
+        if (slot == m_entries.size())
+        {
+            m_entries.emplace_back();
+        }
+        if (m_spare.empty())
+        {
+            m_index.emplace(c_hash, slot);
+        }
+        else
+        {
+            // 复用clear()回收的索引节点
+            auto node = std::move(m_spare.back());
+            m_spare.pop_back();
+            node.key() = c_hash;
+            node.mapped() = slot;
+            m_index.insert(std::move(node));
+        }
+    }
+    else
+    {
+        while (m_entries[m_hand].m_referenced)
+        {
+            m_entries[m_hand].m_referenced = false;
+            m_hand = (m_hand + 1) % m_used;
+        }
+        slot = m_hand;
+        m_hand = (m_hand + 1) % m_used;
+
+        // 复用被淘汰条目的索引节点，避免重新分配
+        auto node = m_index.extract(m_entries[slot].m_hash);
+        node.key() = c_hash;
+        m_index.insert(std::move(node));
+    }
+
+    // 2-写入条目（复用原有缓存区）
+    entry& e = m_entries[slot];
+    e.m_hash = c_hash;
+    e.m_token.assign(token.begin(), token.end());
+    e.m_shares.assign(shares.begin(), shares.end());
+    e.m_referenced = false;
+}
+
+template<typename RT>
+void mpmt::query_cache<RT>::clear() noexcept
+{
+    // 索引节点移入备用列表（resize()已预留容量，不会分配），桶数组保留
+    while (!m_index.empty())
+    {
+        m_spare.push_back(m_index.extract(m_index.begin()));
+    }
+    m_used = 0;
+    m_hand = 0;
+}
+
+template<typename RT>
+void mpmt::query_cache<RT>::resize(uint64_t capacity)
+{
+    if (capacity > mc_MAX_CAPACITY)
+    {
+        throw protocol_exc
+        (
+            protocol_exc::exc_type::INVALID_PARAMETER,
+            "query cache capacity " + std::to_string(capacity) + " exceeds the limit of "
+            + std::to_string(mc_MAX_CAPACITY) + " entries."
+        );
+    }
+    m_index.clear();
+    m_spare.clear();
+    m_used = 0;
+    m_hand = 0;
+    m_capacity = capacity;
+    m_entries.clear();
+    m_entries.shrink_to_fit();
+    m_index.reserve(capacity);
+    m_spare.reserve(capacity);
+}
+
+template<typename RT>
+uint64_t mpmt::query_cache<RT>::hash_of(const std::vector<RT>& token) noexcept
+{
+    return std::hash<std::string_view>{}
+    (
+        std::string_view(reinterpret_cast<const char*>(token.data()), token.size() * sizeof(RT))
+    );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// 显式实例化
+template class mpmt::query_cache<mpmt::ring8>;
+template class mpmt::query_cache<mpmt::ring16>;
+template class mpmt::query_cache<mpmt::ring32>;
+template class mpmt::query_cache<mpmt::ring64>;
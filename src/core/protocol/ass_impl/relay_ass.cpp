@@ -0,0 +1,166 @@
+#include "core/protocol/ass_impl/relay_ass.hpp"
+
+#include <algorithm>
+#include <string>
+
+#include "auxkit/logger.hpp"
+#include "auxkit/profiler.hpp"
+#include "core/exception/protocol_exc.hpp"
+#include "core/protocol/ass_impl/ass_wire.hpp"
+#include "core/protocol/ass_impl/seed_share.hpp"
+#include "core/ring/vcb/vcb_dispatch.hpp"
+
+template<typename RT>
+mpmt::relay_ass<RT>::relay_ass
+(
+    ass_role role,
+    const std::vector<comm_adapter<RT>*>& children,
+    comm_adapter<RT>& parent
+) :
+    mc_role(role),
+    m_children(children),
+    m_parent(parent)
+{}
+
+template<typename RT>
+void mpmt::relay_ass<RT>::forward()
+{
+    MPMT_PROF_SCOPE("relay_ass::forward");
+    if (m_children.empty())
+    {
+        throw protocol_exc
+        (
+            protocol_exc::exc_type::INVALID_STATE,
+            "relay_ass::forward() requires at least one child connection."
+        );
+    }
+
+    try
+    {
+        if (mc_role == ass_role::AS0)
+        {
+            forward_seeds();
+        }
+        else
+        {
+            forward_chunks();
+        }
+    }
+    catch (...)
+    {
+        // 下游断开或报文损坏时断开上游，使上游在接收处失败而不是一直等待
+        m_parent.disconnect();
+        throw;
+    }
+}
+
+template<typename RT>
+void mpmt::relay_ass<RT>::forward_seeds()
+{
+    // 1-接收并校验各下游的种子束，长度须一致
+    std::vector<RT> bundle;
+    uint64_t size = 0;
+    uint64_t records = 0;
+    for (comm_adapter<RT>* child : m_children)
+    {
+        std::vector<RT> message;
+        child->receive(message);
+        for (const seed_share<RT>& share : seed_share<RT>::decode_bundle(message))
+        {
+            if (records++ == 0)
+            {
+                size = share.size();
+            }
+            else if (share.size() != size)
+            {
+                throw protocol_exc
+                (
+                    protocol_exc::exc_type::MESSAGE_CORRUPTION,
+                    "seed share of " + std::to_string(share.size()) + " element(s) does not match the "
+                    + std::to_string(size) + " element(s) of its siblings."
+                );
+            }
+        }
+        bundle.insert(bundle.end(), message.begin(), message.end());
+    }
+
+    // 2-拼接后整体转发
+    m_parent.send(bundle);
+    MPMT_LOG_DEBUG("seed shares relayed", "children", m_children.size(), "records", records);
+}
+
+template<typename RT>
+void mpmt::relay_ass<RT>::forward_chunks()
+{
+    // 1-收齐各下游声明的份额长度并向上游声明
+    const uint64_t c_size = ass_wire::receive_u64(*m_children.front());
+    for (uint64_t j = 1; j < m_children.size(); ++j)
+    {
+        const uint64_t c_child_size = ass_wire::receive_u64(*m_children[j]);
+        if (c_child_size != c_size)
+        {
+            throw protocol_exc
+            (
+                protocol_exc::exc_type::MESSAGE_CORRUPTION,
+                "child share of " + std::to_string(c_child_size) + " element(s) does not match the "
+                + std::to_string(c_size) + " element(s) of its siblings."
+            );
+        }
+    }
+    ass_wire::send_u64(m_parent, c_size);
+
+    // 2-逐个输出块：轮流接收各下游的下一块，取各块剩余长度的最小值，每mc_FUSE_WAY个下游融合累加一次
+    const uint64_t c_children = m_children.size();
+    std::vector<std::vector<RT>> chunks(c_children);
+    std::vector<uint64_t> used(c_children, 0);
+    std::vector<const RT*> srcs(c_children);
+    std::vector<RT> out;
+    for (uint64_t offset = 0; offset < c_size; offset += out.size())
+    {
+        out.assign(std::min(ass_wire::mc_CHUNK_SIZE, c_size - offset), RT(0));
+        uint64_t filled = 0;
+        while (filled < out.size())
+        {
+            uint64_t len = out.size() - filled;
+            for (uint64_t j = 0; j < c_children; ++j)
+            {
+                if (used[j] == chunks[j].size())
+                {
+                    ass_wire::receive_share_chunk(*m_children[j], chunks[j]);
+                    used[j] = 0;
+                    if (chunks[j].empty() || chunks[j].size() > c_size - offset - filled)
+                    {
+                        throw protocol_exc
+                        (
+                            protocol_exc::exc_type::MESSAGE_CORRUPTION,
+                            "received a chunk of " + std::to_string(chunks[j].size()) + " element(s) with "
+                            + std::to_string(c_size - offset - filled) + " element(s) remaining."
+                        );
+                    }
+                }
+                len = std::min<uint64_t>(len, chunks[j].size() - used[j]);
+                srcs[j] = chunks[j].data() + used[j];
+            }
+
+            for (uint64_t first = 0; first < c_children; first += mc_FUSE_WAY)
+            {
+                const uint64_t c_way = std::min<uint64_t>(mc_FUSE_WAY, c_children - first);
+                vcb_dispatch::kernels<RT>().m_add_many(out.data() + filled, srcs.data() + first, c_way, len);
+            }
+            for (uint64_t j = 0; j < c_children; ++j)
+            {
+                used[j] += len;
+            }
+            filled += len;
+        }
+        ass_wire::send_share_chunk(m_parent, out);
+    }
+    MPMT_LOG_DEBUG("masked shares relayed", "children", c_children, "slots", c_size);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// 显式实例化
+template class mpmt::relay_ass<mpmt::ring8>;
+template class mpmt::relay_ass<mpmt::ring16>;
+template class mpmt::relay_ass<mpmt::ring32>;
+template class mpmt::relay_ass<mpmt::ring64>;
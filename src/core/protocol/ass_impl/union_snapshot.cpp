@@ -0,0 +1,86 @@
+#include "core/protocol/ass_impl/union_snapshot.hpp"
+
+#include <stdexcept>
+#include <string>
+
+#include "auxkit/logger.hpp"
+#include "core/exception/mrvf_exc.hpp"
+#include "core/ring/mrvf/mrvf_block_file.hpp"
+
+template<typename RT>
+std::unique_ptr<mpmt::union_snapshot<RT>> mpmt::union_snapshot<RT>::map
+(
+    const std::string& path,
+    const typename mrvf_handler<RT>::config& config
+)
+{
+    std::unique_ptr<union_snapshot<RT>> snap(new union_snapshot<RT>());
+    mrvf_handler<RT> handler(config);
+    if (handler.read_version(path) == mrvf_block_file::mc_VERSION)
+    {
+        // 1-映射文件并校验文件头、块索引与全部块
+        std::unique_ptr<io_mmap> io;
+        try
+        {
+            io = std::make_unique<io_mmap>(path);
+        }
+        catch (const std::runtime_error& e)
+        {
+            throw mrvf_exc(mrvf_exc::exc_type::IOFLOW_ERROR, e.what());
+        }
+        mrvf_block_file blocks(*io, path);
+        if (blocks.packed() || blocks.ring_size() != sizeof(RT))
+        {
+            throw mrvf_exc
+            (
+                mrvf_exc::exc_type::RING_SIZE_MISMATCH,
+                "The file [" + path + "] declares ring as Z_{2^" + std::to_string(blocks.ring_bits())
+                + "}, but the snapshot expects Z_{2^" + std::to_string(sizeof(RT) * 8) + "}."
+            );
+        }
+
+        // 2-判断各块是否未压缩且按序紧密排列，是则数据区即为完整向量
+        bool contiguous = true;
+        const uint64_t c_block_bytes = static_cast<uint64_t>(blocks.block_elems()) * sizeof(RT);
+        for (uint64_t b = 0; b < blocks.num_blocks() && contiguous; ++b)
+        {
+            const mrvf_block_file::block_entry& entry = blocks.entry(b);
+            contiguous = entry.m_codec == mrvf_block_file::codec::RAW
+                && entry.m_offset == mrvf_block_file::mc_HEADER_SIZE + b * c_block_bytes;
+        }
+
+        if (contiguous)
+        {
+            blocks.verify(0, blocks.size());
+            snap->m_size = blocks.size();
+            snap->m_data = reinterpret_cast<const RT*>(io->data() + mrvf_block_file::mc_HEADER_SIZE);
+            snap->m_map = std::move(io);
+            MPMT_LOG_INFO("union snapshot mapped", "slots", snap->m_size);
+            return snap;
+        }
+        MPMT_LOG_INFO("union snapshot falls back to a full load", "blocks", blocks.num_blocks());
+    }
+
+    // 3-v1或布局不连续：完整载入内存
+    snap->m_owned = std::move(handler.load(path).m_rvector);
+    snap->m_size = snap->m_owned.size();
+    snap->m_data = snap->m_owned.data();
+    return snap;
+}
+
+template<typename RT>
+std::unique_ptr<mpmt::union_snapshot<RT>> mpmt::union_snapshot<RT>::adopt(rvector<RT>&& share)
+{
+    std::unique_ptr<union_snapshot<RT>> snap(new union_snapshot<RT>());
+    snap->m_owned = std::move(share);
+    snap->m_size = snap->m_owned.size();
+    snap->m_data = snap->m_owned.data();
+    return snap;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// 显式实例化
+template class mpmt::union_snapshot<mpmt::ring8>;
+template class mpmt::union_snapshot<mpmt::ring16>;
+template class mpmt::union_snapshot<mpmt::ring32>;
+template class mpmt::union_snapshot<mpmt::ring64>;
@@ -0,0 +1,342 @@
+#include "core/protocol/rss_impl/agent_rss.hpp"
+
+#include <algorithm>
+#include <string>
+
+#include "auxkit/logger.hpp"
+#include "auxkit/profiler.hpp"
+#include "core/exception/protocol_exc.hpp"
+#include "core/protocol/ass_impl/ass_wire.hpp"
+#include "core/protocol/ass_impl/seed_share.hpp"
+#include "core/ring/vcb/vcb_dispatch.hpp"
+
+template<typename RT>
+mpmt::agent_rss<RT>::agent_rss
+(
+    rss_role role,
+    const std::vector<comm_adapter<RT>*>& holders,
+    comm_adapter<RT>* querier,
+    comm_adapter<RT>* next,
+    comm_adapter<RT>* prev
+) :
+    mc_role(role),
+    m_holders(holders),
+    m_querier(querier),
+    m_next(next),
+    m_prev(prev),
+    m_union(),
+    m_zero_own(),
+    m_zero_next(),
+    m_zero_offset(0),
+    m_blind()
+{}
+
+template<typename RT>
+void mpmt::agent_rss<RT>::merge()
+{
+    m_union = rss_share<RT>();
+    aggregate();
+}
+
+template<typename RT>
+void mpmt::agent_rss<RT>::update()
+{
+    if (m_union.size() == 0)
+    {
+        throw protocol_exc
+        (
+            protocol_exc::exc_type::INVALID_STATE,
+            "agent_rss::update() requires a merged or loaded union share."
+        );
+    }
+    aggregate();
+}
+
+template<typename RT>
+void mpmt::agent_rss<RT>::aggregate()
+{
+    MPMT_PROF_SCOPE("agent_rss::aggregate");
+
+    // 分量的报文形式由角色决定：P0两个种子，P1种子与稠密，P2稠密与种子（见data_holder_rss）
+    const bool c_first_seeded = mc_role != rss_role::P2;
+    const bool c_second_seeded = mc_role != rss_role::P1;
+    for (comm_adapter<RT>* holder : m_holders)
+    {
+        absorb(*holder, c_first_seeded, m_union.m_first);
+        absorb(*holder, c_second_seeded, m_union.m_second);
+    }
+    MPMT_LOG_DEBUG("holder shares aggregated", "role", static_cast<unsigned>(mc_role), "holders", m_holders.size(), "slots", m_union.size());
+}
+
+template<typename RT>
+void mpmt::agent_rss<RT>::share()
+{
+    throw protocol_exc
+    (
+        protocol_exc::exc_type::UNSUPPORTED_OPERATION,
+        "agents do not provide secret inputs."
+    );
+}
+
+template<typename RT>
+void mpmt::agent_rss<RT>::reveal()
+{
+    MPMT_PROF_SCOPE("agent_rss::reveal");
+    if (m_querier == nullptr)
+    {
+        throw protocol_exc
+        (
+            protocol_exc::exc_type::INVALID_STATE,
+            "agent_rss::reveal() requires a querier connection."
+        );
+    }
+
+    // 1-接收槽位令牌（若干64位槽位下标）
+    const std::vector<RT> token = ass_wire::receive_token(*m_querier);
+    const uint64_t c_count = token.size() * sizeof(RT) / sizeof(uint64_t);
+    std::vector<uint64_t> slots(c_count);
+    ass_wire::decode_bytes(token, 0, reinterpret_cast<uint8_t*>(slots.data()), c_count * sizeof(uint64_t));
+
+    // 2-返回[x_i在各槽位的值][x_{i+1}在各槽位的值]
+    std::vector<RT> gathered(2 * c_count);
+    for (uint64_t i = 0; i < c_count; ++i)
+    {
+        if (slots[i] >= m_union.size())
+        {
+            throw protocol_exc
+            (
+                protocol_exc::exc_type::MESSAGE_CORRUPTION,
+                "query slot " + std::to_string(slots[i]) + " is out of range [0, "
+                + std::to_string(m_union.size()) + ")."
+            );
+        }
+        gathered[i] = m_union.m_first[slots[i]];
+        gathered[c_count + i] = m_union.m_second[slots[i]];
+    }
+    if (m_blind)
+    {
+        m_blind->apply(token, gathered.data(), c_count);
+        m_blind->apply(token, gathered.data() + c_count, c_count);
+    }
+    m_querier->send(gathered);
+}
+
+template<typename RT>
+mpmt::rss_share<RT> mpmt::agent_rss<RT>::multiply(const rss_share<RT>& x, const rss_share<RT>& y)
+{
+    MPMT_PROF_SCOPE("agent_rss::multiply");
+    const uint64_t c_size = x.size();
+    if (x.m_second.size() != c_size || y.m_first.size() != c_size || y.m_second.size() != c_size)
+    {
+        throw protocol_exc
+        (
+            protocol_exc::exc_type::INVALID_PARAMETER,
+            "agent_rss::multiply() requires operands of equal length."
+        );
+    }
+    ensure_zero_keys();
+
+    // 1-本地计算z_i = x_i*(y_i + y_{i+1}) + x_{i+1}*y_i + a_i，三方的交叉项恰好覆盖x*y的全部九项，
+    //   a_i = PRG(k_i) - PRG(k_{i+1})，三方之和为0，使z_i单独看均匀随机
+    const vcb_kernels<RT>& c_kernels = vcb_dispatch::kernels<RT>();
+    rss_share<RT> z{ rvector<RT>(y.m_first), rvector<RT>(c_size) };
+    c_kernels.m_add(z.m_first.data(), y.m_second.data(), c_size);
+    c_kernels.m_mul(z.m_first.data(), x.m_first.data(), c_size);
+    rvector<RT> cross(x.m_second);
+    c_kernels.m_mul(cross.data(), y.m_first.data(), c_size);
+    c_kernels.m_add(z.m_first.data(), cross.data(), c_size);
+
+    // 2-逐块加上零分享后沿环路重分享：z_i发给prev，从next收回z_{i+1}作为第二个分量
+    std::vector<RT> chunk;
+    std::vector<RT> pad;
+    for (uint64_t first = 0; first < c_size; first += ass_wire::mc_CHUNK_SIZE)
+    {
+        const uint64_t c_len = std::min(ass_wire::mc_CHUNK_SIZE, c_size - first);
+        const uint64_t c_byte_offset = m_zero_offset + first * sizeof(RT);
+        chunk.resize(c_len);
+        pad.resize(c_len);
+        m_zero_own->fill(c_byte_offset, reinterpret_cast<uint8_t*>(chunk.data()), c_len * sizeof(RT));
+        m_zero_next->fill(c_byte_offset, reinterpret_cast<uint8_t*>(pad.data()), c_len * sizeof(RT));
+        c_kernels.m_sub(chunk.data(), pad.data(), c_len);
+        c_kernels.m_add(z.m_first.data() + first, chunk.data(), c_len);
+
+        std::copy_n(z.m_first.data() + first, c_len, chunk.data());
+        const std::vector<RT> c_received = exchange(chunk);
+        if (c_received.size() != c_len)
+        {
+            throw protocol_exc
+            (
+                protocol_exc::exc_type::MESSAGE_CORRUPTION,
+                "received a resharing chunk of " + std::to_string(c_received.size()) + " element(s), expected "
+                + std::to_string(c_len) + "."
+            );
+        }
+        std::copy(c_received.begin(), c_received.end(), z.m_second.data() + first);
+    }
+    m_zero_offset += c_size * sizeof(RT);
+    return z;
+}
+
+template<typename RT>
+void mpmt::agent_rss<RT>::set_holders(const std::vector<comm_adapter<RT>*>& holders)
+{
+    m_holders = holders;
+}
+
+template<typename RT>
+void mpmt::agent_rss<RT>::load_union(rss_share<RT>&& share)
+{
+    if (share.m_first.size() != share.m_second.size())
+    {
+        throw protocol_exc
+        (
+            protocol_exc::exc_type::INVALID_PARAMETER,
+            "replicated union share components differ in length."
+        );
+    }
+    m_union = std::move(share);
+}
+
+template<typename RT>
+void mpmt::agent_rss<RT>::multiply()
+{
+    throw protocol_exc
+    (
+        protocol_exc::exc_type::UNSUPPORTED_OPERATION,
+        "secure multiplication takes operands, use multiply(x, y)."
+    );
+}
+
+template<typename RT>
+void mpmt::agent_rss<RT>::subtract()
+{
+    throw protocol_exc
+    (
+        protocol_exc::exc_type::UNSUPPORTED_OPERATION,
+        "secure subtraction is local on replicated shares and not required by the merge."
+    );
+}
+
+template<typename RT>
+void mpmt::agent_rss<RT>::add()
+{
+    throw protocol_exc
+    (
+        protocol_exc::exc_type::UNSUPPORTED_OPERATION,
+        "secure addition is performed locally by aggregate()."
+    );
+}
+
+template<typename RT>
+void mpmt::agent_rss<RT>::ensure_union(uint64_t size)
+{
+    if (m_union.size() == 0)
+    {
+        m_union.m_first = rvector<RT>(size, RT(0));
+        m_union.m_second = rvector<RT>(size, RT(0));
+    }
+    else if (m_union.size() != size)
+    {
+        throw protocol_exc
+        (
+            protocol_exc::exc_type::MESSAGE_CORRUPTION,
+            "holder share of " + std::to_string(size) + " element(s) does not match the union share of "
+            + std::to_string(m_union.size()) + " element(s)."
+        );
+    }
+}
+
+template<typename RT>
+void mpmt::agent_rss<RT>::absorb(comm_adapter<RT>& holder, bool seeded, rvector<RT>& acc)
+{
+    const vcb_kernels<RT>& c_kernels = vcb_dispatch::kernels<RT>();
+    if (seeded)
+    {
+        // 种子分量按区间展开后累加，不物化完整份额
+        std::vector<RT> message;
+        holder.receive(message);
+        const seed_share<RT> c_share = seed_share<RT>::decode(message);
+        ensure_union(c_share.size());
+        std::vector<RT> window(std::min(mc_EXPAND_WINDOW, c_share.size()));
+        for (uint64_t offset = 0; offset < c_share.size(); offset += mc_EXPAND_WINDOW)
+        {
+            const uint64_t c_len = std::min(mc_EXPAND_WINDOW, c_share.size() - offset);
+            c_share.expand_into(offset, window.data(), c_len);
+            c_kernels.m_add(acc.data() + offset, window.data(), c_len);
+        }
+        return;
+    }
+
+    // 稠密分量逐块接收并累加
+    const uint64_t c_size = ass_wire::receive_u64(holder);
+    ensure_union(c_size);
+    uint64_t filled = 0;
+    std::vector<RT> chunk;
+    while (filled < c_size)
+    {
+        holder.receive(chunk);
+        if (chunk.empty() || chunk.size() > c_size - filled)
+        {
+            throw protocol_exc
+            (
+                protocol_exc::exc_type::MESSAGE_CORRUPTION,
+                "received a chunk of " + std::to_string(chunk.size()) + " element(s) with "
+                + std::to_string(c_size - filled) + " element(s) remaining."
+            );
+        }
+        c_kernels.m_add(acc.data() + filled, chunk.data(), chunk.size());
+        filled += chunk.size();
+    }
+}
+
+template<typename RT>
+std::vector<RT> mpmt::agent_rss<RT>::exchange(const std::vector<RT>& out)
+{
+    if (m_next == nullptr || m_prev == nullptr)
+    {
+        throw protocol_exc
+        (
+            protocol_exc::exc_type::INVALID_STATE,
+            "agent_rss needs connections to both neighbouring agents for multiplication."
+        );
+    }
+
+    // 环路P1 -> P0 -> P2 -> P1：P0先接收，发送方总有一方正在接收
+    std::vector<RT> in;
+    if (mc_role == rss_role::P0)
+    {
+        m_next->receive(in);
+        m_prev->send(out);
+    }
+    else
+    {
+        m_prev->send(out);
+        m_next->receive(in);
+    }
+    return in;
+}
+
+template<typename RT>
+void mpmt::agent_rss<RT>::ensure_zero_keys()
+{
+    if (m_zero_own)
+    {
+        return;
+    }
+
+    // 本方密钥k_i发给prev，从next收到k_{i+1}：Pi与Pi-1共享k_i
+    const prg_openssl::seed_type c_own = prg_openssl::fresh_seed();
+    const std::vector<RT> c_received = exchange(ass_wire::encode_bytes<RT>(c_own.data(), c_own.size()));
+    prg_openssl::seed_type next{};
+    ass_wire::decode_bytes(c_received, 0, next.data(), next.size());
+    m_zero_own.emplace(c_own);
+    m_zero_next.emplace(next);
+    m_zero_offset = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// 显式实例化
+template class mpmt::agent_rss<mpmt::ring8>;
+template class mpmt::agent_rss<mpmt::ring16>;
+template class mpmt::agent_rss<mpmt::ring32>;
+template class mpmt::agent_rss<mpmt::ring64>;
@@ -0,0 +1,110 @@
+#include "core/protocol/rss_impl/data_holder_rss.hpp"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "auxkit/profiler.hpp"
+#include "core/exception/protocol_exc.hpp"
+#include "core/protocol/ass_impl/ass_wire.hpp"
+#include "core/protocol/ass_impl/seed_share.hpp"
+#include "core/ring/vcb/vcb_dispatch.hpp"
+
+template<typename RT>
+mpmt::data_holder_rss<RT>::data_holder_rss(comm_adapter<RT>& p0, comm_adapter<RT>& p1, comm_adapter<RT>& p2)
+    :
+    m_agents{ &p0, &p1, &p2 },
+    m_input(),
+    m_bits(),
+    m_seeds()
+{}
+
+template<typename RT>
+void mpmt::data_holder_rss<RT>::set_input(rvector<RT>&& x)
+{
+    m_input = std::move(x);
+    m_bits.reset();
+    m_seeds.clear();
+}
+
+template<typename RT>
+void mpmt::data_holder_rss<RT>::set_input(slot_indicator&& x)
+{
+    m_bits.emplace(std::move(x));
+    m_input = rvector<RT>();
+    m_seeds.clear();
+}
+
+template<typename RT>
+void mpmt::data_holder_rss<RT>::share()
+{
+    MPMT_PROF_SCOPE("data_holder_rss::share");
+    const uint64_t c_size = input_size();
+    if (c_size == 0)
+    {
+        throw protocol_exc
+        (
+            protocol_exc::exc_type::INVALID_STATE,
+            "data_holder_rss::share() called before set_input()."
+        );
+    }
+    comm_adapter<RT>& p0 = *m_agents[0];
+    comm_adapter<RT>& p1 = *m_agents[1];
+    comm_adapter<RT>& p2 = *m_agents[2];
+
+    // 1-x0与x1由种子生成（同一输入只抽取一次）：P0收到两个种子，P1先收到s1，P2的种子分量排在x2之后
+    if (m_seeds.empty())
+    {
+        m_seeds = { prg_openssl::fresh_seed(), prg_openssl::fresh_seed() };
+    }
+    const seed_share<RT> c_x0(m_seeds[0], c_size);
+    const seed_share<RT> c_x1(m_seeds[1], c_size);
+    p0.send(c_x0.encode());
+    p0.send(c_x1.encode());
+    p1.send(c_x1.encode());
+
+    // 2-逐块计算x2 = x - x0 - x1，同一块依次发给P1（第二个分量）与P2（第一个分量）
+    ass_wire::send_u64(p1, c_size);
+    ass_wire::send_u64(p2, c_size);
+    std::vector<RT> chunk;
+    std::vector<RT> pad;
+    for (uint64_t first = 0; first < c_size; first += ass_wire::mc_CHUNK_SIZE)
+    {
+        const uint64_t c_len = std::min(ass_wire::mc_CHUNK_SIZE, c_size - first);
+        chunk.resize(c_len);
+        pad.resize(c_len);
+        if (m_bits)
+        {
+            m_bits->template expand_into<RT>(first, chunk.data(), c_len);
+        }
+        else
+        {
+            std::copy_n(m_input.data() + first, c_len, chunk.data());
+        }
+        for (const seed_share<RT>* mask : { &c_x0, &c_x1 })
+        {
+            mask->expand_into(first, pad.data(), c_len);
+            vcb_dispatch::kernels<RT>().m_sub(chunk.data(), pad.data(), c_len);
+        }
+        p1.send(chunk);
+        p2.send(chunk);
+    }
+    p2.send(c_x0.encode());
+}
+
+template<typename RT>
+void mpmt::data_holder_rss<RT>::reveal()
+{
+    throw protocol_exc
+    (
+        protocol_exc::exc_type::UNSUPPORTED_OPERATION,
+        "data holders do not take part in reveal()."
+    );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// 显式实例化
+template class mpmt::data_holder_rss<mpmt::ring8>;
+template class mpmt::data_holder_rss<mpmt::ring16>;
+template class mpmt::data_holder_rss<mpmt::ring32>;
+template class mpmt::data_holder_rss<mpmt::ring64>;
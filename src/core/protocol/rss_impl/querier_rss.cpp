@@ -0,0 +1,106 @@
+#include "core/protocol/rss_impl/querier_rss.hpp"
+
+#include <algorithm>
+#include <string>
+
+#include "auxkit/profiler.hpp"
+#include "core/exception/protocol_exc.hpp"
+#include "core/protocol/ass_impl/ass_wire.hpp"
+
+template<typename RT>
+mpmt::querier_rss<RT>::querier_rss(comm_adapter<RT>& p0, comm_adapter<RT>& p1, comm_adapter<RT>& p2)
+    :
+    m_agents{ &p0, &p1, &p2 },
+    m_slots(),
+    m_counts(),
+    m_result(false)
+{}
+
+template<typename RT>
+void mpmt::querier_rss<RT>::set_query(const std::vector<uint64_t>& slots)
+{
+    // 规范化槽位，使同一凭据的令牌逐字节相同
+    m_slots = slots;
+    std::sort(m_slots.begin(), m_slots.end());
+    m_slots.erase(std::unique(m_slots.begin(), m_slots.end()), m_slots.end());
+}
+
+template<typename RT>
+void mpmt::querier_rss<RT>::query()
+{
+    MPMT_PROF_SCOPE("querier_rss::query");
+    share();
+    reveal();
+}
+
+template<typename RT>
+void mpmt::querier_rss<RT>::share()
+{
+    if (m_slots.empty())
+    {
+        throw protocol_exc
+        (
+            protocol_exc::exc_type::INVALID_STATE,
+            "querier_rss::share() called before set_query()."
+        );
+    }
+    const std::vector<RT> c_token = ass_wire::encode_bytes<RT>
+    (
+        reinterpret_cast<const uint8_t*>(m_slots.data()),
+        m_slots.size() * sizeof(uint64_t)
+    );
+    for (comm_adapter<RT>* agent : m_agents)
+    {
+        ass_wire::send_token(*agent, c_token);
+    }
+}
+
+template<typename RT>
+void mpmt::querier_rss<RT>::reveal()
+{
+    // 1-收回三方的[x_i][x_{i+1}]
+    const uint64_t c_count = m_slots.size();
+    std::array<std::vector<RT>, c_RSS_PARTIES> shares;
+    for (uint8_t i = 0; i < c_RSS_PARTIES; ++i)
+    {
+        m_agents[i]->receive(shares[i]);
+        if (shares[i].size() != 2 * c_count)
+        {
+            throw protocol_exc
+            (
+                protocol_exc::exc_type::MESSAGE_CORRUPTION,
+                "agent P" + std::to_string(i) + " returned " + std::to_string(shares[i].size())
+                + " element(s) for " + std::to_string(c_count) + " slot(s)."
+            );
+        }
+    }
+
+    // 2-Pi的第二个分量即Pi+1的第一个分量，逐一校验后求和恢复计数
+    m_counts.assign(c_count, RT(0));
+    m_result = true;
+    for (uint64_t j = 0; j < c_count; ++j)
+    {
+        for (uint8_t i = 0; i < c_RSS_PARTIES; ++i)
+        {
+            const uint8_t c_next = static_cast<uint8_t>(rss_next(static_cast<rss_role>(i)));
+            if (shares[i][c_count + j] != shares[c_next][j])
+            {
+                throw protocol_exc
+                (
+                    protocol_exc::exc_type::MESSAGE_CORRUPTION,
+                    "agents P" + std::to_string(i) + " and P" + std::to_string(c_next)
+                    + " returned inconsistent replicated shares for slot " + std::to_string(m_slots[j]) + "."
+                );
+            }
+            m_counts[j] = static_cast<RT>(m_counts[j] + shares[i][j]);
+        }
+        m_result = m_result && m_counts[j] != 0;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// 显式实例化
+template class mpmt::querier_rss<mpmt::ring8>;
+template class mpmt::querier_rss<mpmt::ring16>;
+template class mpmt::querier_rss<mpmt::ring32>;
+template class mpmt::querier_rss<mpmt::ring64>;
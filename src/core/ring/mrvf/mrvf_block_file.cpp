@@ -0,0 +1,704 @@
+#include "core/ring/mrvf/mrvf_block_file.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+
+#include "auxkit/profiler.hpp"
+#include "core/crc/crc64.hpp"
+#include "core/exception/mrvf_exc.hpp"
+
+namespace
+{
+    // 文件头字段偏移
+    constexpr uint64_t mc_OFF_VERSION = 8;
+    constexpr uint64_t mc_OFF_RING_SIZE = mpmt::mrvf_block_file::mc_RING_SIZE_OFFSET;
+    constexpr uint64_t mc_OFF_FLAGS = mpmt::mrvf_block_file::mc_FLAGS_OFFSET;
+    constexpr uint64_t mc_OFF_BLOCK_ELEMS = 12;
+    constexpr uint64_t mc_OFF_SIZE = 16;
+    constexpr uint64_t mc_OFF_NUM_BLOCKS = 24;
+    constexpr uint64_t mc_OFF_INDEX_OFFSET = 32;
+    constexpr uint64_t mc_OFF_INDEX_CRC = 40;
+    constexpr uint64_t mc_OFF_HEADER_CRC = 56;
+    constexpr uint64_t mc_MAX_RVECTOR_SIZE = 1ULL << 50;    // 与v1一致的长度上限
+    constexpr uint64_t mc_STAGE_BYTES = 64ULL << 20;        // 压缩写入时合并写出的暂存长度
+
+    template <typename T>
+    void put(uint8_t* buf, uint64_t offset, T value) noexcept
+    {
+        std::memcpy(buf + offset, &value, sizeof(T));
+    }
+
+    template <typename T>
+    T get(const uint8_t* buf, uint64_t offset) noexcept
+    {
+        T value;
+        std::memcpy(&value, buf + offset, sizeof(T));
+        return value;
+    }
+
+    bool valid_ring_size(uint8_t ring_size) noexcept
+    {
+        return ring_size == 1 || ring_size == 2 || ring_size == 4 || ring_size == 8;
+    }
+
+    bool valid_ring_bits(uint8_t ring_bits) noexcept
+    {
+        return ring_bits >= 1 && ring_bits <= 64;
+    }
+
+    /** @brief 将io_adapter抛出的std::runtime_error转换为mrvf_exc */
+    template <typename FN>
+    void io_guard(FN&& fn)
+    {
+        try
+        {
+            fn();
+        }
+        catch (const mpmt::mrvf_exc&)
+        {
+            throw;
+        }
+        catch (const std::runtime_error& e)
+        {
+            throw mpmt::mrvf_exc(mpmt::mrvf_exc::exc_type::IOFLOW_ERROR, e.what());
+        }
+    }
+}
+
+bool mpmt::mrvf_block_file::probe(const uint8_t* head, uint64_t len) noexcept
+{
+    return len >= sizeof(mc_MAGIC) && std::memcmp(head, mc_MAGIC, sizeof(mc_MAGIC)) == 0;
+}
+
+void mpmt::mrvf_block_file::write
+(
+    io_adapter& io,
+    const std::string& path,
+    uint8_t ring_size,
+    uint32_t block_elems,
+    const uint8_t* data,
+    uint64_t size,
+    bool compress
+)
+{
+    MPMT_PROF_SCOPE("mrvf_block_file::write");
+    if (!valid_ring_size(ring_size)
+        || block_elems == 0
+        || static_cast<uint64_t>(block_elems) * ring_size > UINT32_MAX
+        || size > mc_MAX_RVECTOR_SIZE)
+    {
+        throw mrvf_exc
+        (
+            mrvf_exc::exc_type::IOFLOW_ERROR,
+            "Invalid v2 layout for the file [" + path + "]: ring_size=" + std::to_string(ring_size)
+            + ", block_elems=" + std::to_string(block_elems) + ", rvector_size=" + std::to_string(size) + "."
+        );
+    }
+
+    write_units(io, layout{ ring_size, 0, block_elems, size }, ring_size, block_elems, data, size, compress);
+}
+
+void mpmt::mrvf_block_file::write_bits
+(
+    io_adapter& io,
+    const std::string& path,
+    uint8_t ring_bits,
+    uint32_t block_elems,
+    const uint8_t* data,
+    uint64_t size,
+    bool compress
+)
+{
+    MPMT_PROF_SCOPE("mrvf_block_file::write");
+    if (!valid_ring_bits(ring_bits)
+        || block_elems == 0
+        || block_elems % 8 != 0
+        || static_cast<uint64_t>(block_elems) / 8 * ring_bits > UINT32_MAX
+        || size > mc_MAX_RVECTOR_SIZE)
+    {
+        throw mrvf_exc
+        (
+            mrvf_exc::exc_type::IOFLOW_ERROR,
+            "Invalid v2 bit-width layout for the file [" + path + "]: ring_bits=" + std::to_string(ring_bits)
+            + ", block_elems=" + std::to_string(block_elems) + ", rvector_size=" + std::to_string(size) + "."
+        );
+    }
+
+    // 以字节为存储单元：每块block_elems / 8 * ring_bits字节，末块为剩余的ceil(elems * ring_bits / 8)字节
+    write_units
+    (
+        io,
+        layout{ ring_bits, mc_FLAG_RING_BITS, block_elems, size },
+        1,
+        static_cast<uint32_t>(static_cast<uint64_t>(block_elems) / 8 * ring_bits),
+        data,
+        (size * ring_bits + 7) / 8,
+        compress
+    );
+}
+
+void mpmt::mrvf_block_file::write_units
+(
+    io_adapter& io,
+    const layout& hdr,
+    uint8_t ring_size,
+    uint32_t block_elems,
+    const uint8_t* data,
+    uint64_t size,
+    bool compress
+)
+{
+    const uint64_t c_block_bytes = static_cast<uint64_t>(block_elems) * ring_size;
+    const uint64_t c_num_blocks = (size + block_elems - 1) / block_elems;
+    std::vector<block_entry> index(c_num_blocks);
+    MPMT_PROF_COUNT(MRVF_RAW_BYTES, size * ring_size);
+
+    // 1-不压缩时：定宽块依次紧邻排列，数据区一次写出
+    if (!compress)
+    {
+        for (uint64_t b = 0; b < c_num_blocks; ++b)
+        {
+            const uint64_t c_len = std::min<uint64_t>(block_elems, size - b * block_elems) * ring_size;
+            index[b].m_offset = mc_HEADER_SIZE + b * c_block_bytes;
+            index[b].m_stored_bytes = static_cast<uint32_t>(c_len);
+            index[b].m_codec = codec::RAW;
+            index[b].m_crc64 = crc64::compute(data + b * c_block_bytes, c_len);
+        }
+
+        const uint64_t c_data_bytes = size * ring_size;
+        io_guard([&]
+            {
+                if (c_data_bytes != 0)
+                {
+                    io.write_at(mc_HEADER_SIZE, data, c_data_bytes);
+                }
+            });
+        MPMT_PROF_COUNT(MRVF_STORED_BYTES, c_data_bytes);
+        commit(io, hdr, index, mc_HEADER_SIZE + c_data_bytes);
+        io_guard([&] { io.sync(); });
+        return;
+    }
+
+    // 2-压缩时：逐块选择编码，编码结果合并到暂存区后成批写出
+    std::vector<uint8_t> encoded;
+    std::vector<uint8_t> stage;
+    stage.reserve(static_cast<std::size_t>(std::min(mc_STAGE_BYTES, size * ring_size) + c_block_bytes));
+    uint64_t offset = mc_HEADER_SIZE;
+    uint64_t stage_offset = mc_HEADER_SIZE;
+    for (uint64_t b = 0; b < c_num_blocks; ++b)
+    {
+        const uint64_t c_elems = std::min<uint64_t>(block_elems, size - b * block_elems);
+        const uint8_t* const c_raw = data + b * c_block_bytes;
+        const codec c_codec = mrvf_codec::choose(ring_size, c_raw, c_elems, encoded);
+        const uint8_t* const c_bytes = (c_codec == codec::RAW) ? c_raw : encoded.data();
+        const uint64_t c_len = (c_codec == codec::RAW) ? c_elems * ring_size : encoded.size();
+
+        index[b].m_offset = offset;
+        index[b].m_stored_bytes = static_cast<uint32_t>(c_len);
+        index[b].m_codec = c_codec;
+        index[b].m_crc64 = crc64::compute(c_bytes, c_len);
+        stage.insert(stage.end(), c_bytes, c_bytes + c_len);
+        offset += c_len;
+
+        if (stage.size() >= mc_STAGE_BYTES || b + 1 == c_num_blocks)
+        {
+            io_guard([&] { io.write_at(stage_offset, stage.data(), stage.size()); });
+            stage_offset = offset;
+            stage.clear();
+        }
+    }
+    MPMT_PROF_COUNT(MRVF_STORED_BYTES, offset - mc_HEADER_SIZE);
+    commit(io, hdr, index, offset);
+    io_guard([&] { io.sync(); });
+}
+
+mpmt::mrvf_block_file::mrvf_block_file(io_adapter& io, const std::string& path, bool compress)
+    :
+    m_io(io),
+    mc_path(path),
+    mc_compress(compress),
+    m_layout{ 0, 0, 0, 0 },
+    m_ring_size(0),
+    m_block_elems(0),
+    m_size(0),
+    m_index(),
+    m_data_end(0)
+{
+    // 1-读取并校验文件头
+    uint8_t header[mc_HEADER_SIZE];
+    uint64_t file_size = 0;
+    io_guard([&]
+        {
+            file_size = io.size();
+            if (file_size < mc_HEADER_SIZE + mc_EOF_SIZE)
+            {
+                throw mrvf_exc
+                (
+                    mrvf_exc::exc_type::FILE_CORRUPTION,
+                    "File[" + path + "] is unexpectedly truncated below the v2 header size."
+                );
+            }
+            io.read_at(0, header, mc_HEADER_SIZE);
+        });
+
+    if (!probe(header, mc_HEADER_SIZE) || get<uint16_t>(header, mc_OFF_VERSION) != mc_VERSION)
+    {
+        throw mrvf_exc
+        (
+            mrvf_exc::exc_type::FILE_CORRUPTION,
+            "Invalid v2 header in the file [" + path + "]."
+        );
+    }
+    const uint64_t c_header_crc = crc64::compute(header, mc_OFF_HEADER_CRC);
+    if (c_header_crc != get<uint64_t>(header, mc_OFF_HEADER_CRC))
+    {
+        throw mrvf_exc
+        (
+            mrvf_exc::exc_type::FILE_CORRUPTION,
+            "CRC64 check failed on the header of the file[" + path + "]."
+        );
+    }
+
+    m_layout.m_ring_field = header[mc_OFF_RING_SIZE];
+    m_layout.m_flags = header[mc_OFF_FLAGS];
+    m_layout.m_block_elems = get<uint32_t>(header, mc_OFF_BLOCK_ELEMS);
+    m_layout.m_size = get<uint64_t>(header, mc_OFF_SIZE);
+    const uint64_t c_num_blocks = get<uint64_t>(header, mc_OFF_NUM_BLOCKS);
+    const uint64_t c_index_offset = get<uint64_t>(header, mc_OFF_INDEX_OFFSET);
+
+    // 位宽模式以字节为存储单元，块数与按元素计算的结果一致
+    bool valid_layout = m_layout.m_block_elems != 0 && m_layout.m_size <= mc_MAX_RVECTOR_SIZE;
+    if (packed())
+    {
+        valid_layout = valid_layout
+            && valid_ring_bits(m_layout.m_ring_field)
+            && m_layout.m_block_elems % 8 == 0
+            && static_cast<uint64_t>(m_layout.m_block_elems) / 8 * m_layout.m_ring_field <= UINT32_MAX;
+        m_ring_size = 1;
+        m_block_elems = static_cast<uint32_t>(static_cast<uint64_t>(m_layout.m_block_elems) / 8 * m_layout.m_ring_field);
+        m_size = (m_layout.m_size * m_layout.m_ring_field + 7) / 8;
+    }
+    else
+    {
+        valid_layout = valid_layout && m_layout.m_flags == 0 && valid_ring_size(m_layout.m_ring_field);
+        m_ring_size = m_layout.m_ring_field;
+        m_block_elems = m_layout.m_block_elems;
+        m_size = m_layout.m_size;
+    }
+    if (!valid_layout
+        || c_num_blocks != (m_layout.m_size + m_layout.m_block_elems - 1) / m_layout.m_block_elems
+        || c_index_offset < mc_HEADER_SIZE
+        || c_index_offset > file_size
+        || file_size - c_index_offset != c_num_blocks * mc_ENTRY_SIZE + mc_EOF_SIZE)
+    {
+        throw mrvf_exc
+        (
+            mrvf_exc::exc_type::FILE_CORRUPTION,
+            "Inconsistent v2 layout in the file [" + path + "]: ring_size=" + std::to_string(m_layout.m_ring_field)
+            + ", flags=" + std::to_string(m_layout.m_flags) + ", rvector_size=" + std::to_string(m_layout.m_size)
+            + ", block_elems=" + std::to_string(m_layout.m_block_elems) + ", num_blocks=" + std::to_string(c_num_blocks)
+            + ", index_offset=" + std::to_string(c_index_offset) + ", file size=" + std::to_string(file_size) + "."
+        );
+    }
+
+    // 2-读取并校验块索引与文件尾
+    const uint64_t c_index_bytes = c_num_blocks * mc_ENTRY_SIZE;
+    std::unique_ptr<uint8_t[]> raw = std::make_unique<uint8_t[]>(c_index_bytes + mc_EOF_SIZE);
+    io_guard([&] { io.read_at(c_index_offset, raw.get(), c_index_bytes + mc_EOF_SIZE); });
+    if (crc64::compute(raw.get(), c_index_bytes) != get<uint64_t>(header, mc_OFF_INDEX_CRC))
+    {
+        throw mrvf_exc
+        (
+            mrvf_exc::exc_type::FILE_CORRUPTION,
+            "CRC64 check failed on the block index of the file[" + path + "]."
+        );
+    }
+    if (std::memcmp(raw.get() + c_index_bytes, mc_EOF, mc_EOF_SIZE) != 0)
+    {
+        throw mrvf_exc
+        (
+            mrvf_exc::exc_type::FILE_CORRUPTION,
+            "Invalid end of the file[" + path + "]."
+        );
+    }
+
+    m_index.resize(c_num_blocks);
+    for (uint64_t b = 0; b < c_num_blocks; ++b)
+    {
+        const uint8_t* e = raw.get() + b * mc_ENTRY_SIZE;
+        block_entry& entry = m_index[b];
+        entry.m_offset = get<uint64_t>(e, 0);
+        entry.m_stored_bytes = get<uint32_t>(e, 8);
+        entry.m_codec = static_cast<codec>(e[12]);
+        entry.m_crc64 = get<uint64_t>(e, 16);
+        const uint64_t c_raw = block_length(b) * m_ring_size;
+        if (e[12] >= mrvf_codec::mc_CODEC_COUNT
+            || (entry.m_codec == codec::RAW ? entry.m_stored_bytes != c_raw : entry.m_stored_bytes > c_raw)
+            || entry.m_offset < mc_HEADER_SIZE
+            || entry.m_offset > c_index_offset
+            || entry.m_stored_bytes > c_index_offset - entry.m_offset)
+        {
+            throw mrvf_exc
+            (
+                mrvf_exc::exc_type::FILE_CORRUPTION,
+                "Invalid index entry of block " + std::to_string(b) + " in the file [" + path + "]."
+            );
+        }
+    }
+    m_data_end = c_index_offset;
+}
+
+uint64_t mpmt::mrvf_block_file::stored_bytes() const noexcept
+{
+    uint64_t total = 0;
+    for (const block_entry& entry : m_index)
+    {
+        total += entry.m_stored_bytes;
+    }
+    return total;
+}
+
+void mpmt::mrvf_block_file::read(uint64_t first, uint64_t count, uint8_t* out)
+{
+    MPMT_PROF_SCOPE("mrvf_block_file::read");
+    check_range(first, count);
+    if (count == 0)
+    {
+        return;
+    }
+
+    const uint64_t c_first_block = first / m_block_elems;
+    const uint64_t c_last_block = (first + count - 1) / m_block_elems;
+    auto covered = [&](uint64_t b)
+        {
+            return b * m_block_elems >= first && b * m_block_elems + block_length(b) <= first + count;
+        };
+    std::unique_ptr<uint8_t[]> scratch;
+    uint64_t b = c_first_block;
+    while (b <= c_last_block)
+    {
+        const uint64_t c_block_first = b * m_block_elems;
+        const uint64_t c_from = std::max(first, c_block_first);
+        const uint64_t c_to = std::min(first + count, c_block_first + block_length(b));
+        uint8_t* dst = out + (c_from - first) * m_ring_size;
+
+        // 1-整块覆盖时直接读入输出，文件中相邻的整块合并为一次读取，便于底层实现保持多个请求在途
+        if (covered(b))
+        {
+            uint64_t last = b;
+            while (last < c_last_block
+                && covered(last + 1)
+                && m_index[last + 1].m_offset == m_index[last].m_offset + m_index[last].m_stored_bytes)
+            {
+                ++last;
+            }
+            load_blocks(b, last, dst);
+            b = last + 1;
+            continue;
+        }
+
+        // 2-部分覆盖时经暂存区读出后截取
+        if (!scratch)
+        {
+            scratch = std::make_unique<uint8_t[]>(static_cast<uint64_t>(m_block_elems) * m_ring_size);
+        }
+        load_blocks(b, b, scratch.get());
+        std::memcpy(dst, scratch.get() + (c_from - c_block_first) * m_ring_size, (c_to - c_from) * m_ring_size);
+        ++b;
+    }
+}
+
+void mpmt::mrvf_block_file::verify(uint64_t first, uint64_t count)
+{
+    MPMT_PROF_SCOPE("mrvf_block_file::verify");
+    check_range(first, count);
+    if (count == 0)
+    {
+        return;
+    }
+
+    std::unique_ptr<uint8_t[]> scratch = std::make_unique<uint8_t[]>(static_cast<uint64_t>(m_block_elems) * m_ring_size);
+    for (uint64_t b = first / m_block_elems; b <= (first + count - 1) / m_block_elems; ++b)
+    {
+        load_blocks(b, b, scratch.get());
+    }
+}
+
+void mpmt::mrvf_block_file::patch(uint64_t first, uint64_t count, const uint8_t* data)
+{
+    MPMT_PROF_SCOPE("mrvf_block_file::patch");
+    check_range(first, count);
+    if (count == 0)
+    {
+        return;
+    }
+
+    std::unique_ptr<uint8_t[]> scratch = std::make_unique<uint8_t[]>(static_cast<uint64_t>(m_block_elems) * m_ring_size);
+    for (uint64_t b = first / m_block_elems; b <= (first + count - 1) / m_block_elems; ++b)
+    {
+        const uint64_t c_block_first = b * m_block_elems;
+        const uint64_t c_from = std::max(first, c_block_first);
+        const uint64_t c_to = std::min(first + count, c_block_first + block_length(b));
+
+        // 1-部分覆盖时先读出并校验原块，再叠加新数据
+        const uint8_t* block = nullptr;
+        if (c_from == c_block_first && c_to == c_block_first + block_length(b))
+        {
+            block = data + (c_from - first) * m_ring_size;
+        }
+        else
+        {
+            load_blocks(b, b, scratch.get());
+            std::memcpy
+            (
+                scratch.get() + (c_from - c_block_first) * m_ring_size,
+                data + (c_from - first) * m_ring_size,
+                (c_to - c_from) * m_ring_size
+            );
+            block = scratch.get();
+        }
+
+        // 2-重新编码后写回并更新块索引
+        store_block(b, block, block_length(b));
+    }
+    commit(m_data_end);
+}
+
+void mpmt::mrvf_block_file::append(uint64_t count, const uint8_t* data)
+{
+    MPMT_PROF_SCOPE("mrvf_block_file::append");
+    if (packed())
+    {
+        throw mrvf_exc
+        (
+            mrvf_exc::exc_type::VERSION_UNSUPPORTED,
+            "Appending to the bit-width file [" + mc_path + "] is not supported."
+        );
+    }
+    if (count == 0)
+    {
+        return;
+    }
+    if (count > mc_MAX_RVECTOR_SIZE - m_size)
+    {
+        throw mrvf_exc
+        (
+            mrvf_exc::exc_type::IOFLOW_ERROR,
+            "Appending " + std::to_string(count) + " element(s) to the file [" + mc_path + "] exceeds the maximum length."
+        );
+    }
+
+    const uint64_t c_block_bytes = static_cast<uint64_t>(m_block_elems) * m_ring_size;
+    uint64_t consumed = 0;
+
+    // 1-补齐不足一块的末块
+    if (!m_index.empty() && block_length(m_index.size() - 1) < m_block_elems)
+    {
+        const uint64_t c_last = m_index.size() - 1;
+        const uint64_t c_have = block_length(c_last);
+        std::unique_ptr<uint8_t[]> block = std::make_unique<uint8_t[]>(c_block_bytes);
+        load_blocks(c_last, c_last, block.get());
+        consumed = std::min<uint64_t>(m_block_elems - c_have, count);
+        std::memcpy(block.get() + c_have * m_ring_size, data, consumed * m_ring_size);
+        store_block(c_last, block.get(), c_have + consumed);
+    }
+
+    // 2-其余数据按整块续写在数据区末尾（覆盖原块索引位置）；不压缩时一次写出
+    const uint64_t c_rest = count - consumed;
+    const uint8_t* const c_rest_data = data + consumed * m_ring_size;
+    if (!mc_compress && c_rest != 0)
+    {
+        const uint64_t c_offset = m_data_end;
+        io_guard([&] { m_io.write_at(c_offset, c_rest_data, c_rest * m_ring_size); });
+        m_data_end += c_rest * m_ring_size;
+        for (uint64_t done = 0; done < c_rest; done += m_block_elems)
+        {
+            block_entry entry;
+            entry.m_offset = c_offset + done * m_ring_size;
+            entry.m_stored_bytes = static_cast<uint32_t>(std::min<uint64_t>(m_block_elems, c_rest - done) * m_ring_size);
+            entry.m_codec = codec::RAW;
+            entry.m_crc64 = crc64::compute(c_rest_data + done * m_ring_size, entry.m_stored_bytes);
+            m_index.push_back(entry);
+        }
+    }
+    else
+    {
+        for (uint64_t done = 0; done < c_rest; done += m_block_elems)
+        {
+            // 新块的初始位置为数据区末尾，store_block()据此原位写入
+            m_index.push_back(block_entry{ m_data_end, 0, codec::RAW, 0 });
+            store_block(m_index.size() - 1, c_rest_data + done * m_ring_size, std::min<uint64_t>(m_block_elems, c_rest - done));
+        }
+    }
+    m_size += count;
+    m_layout.m_size = m_size;
+
+    // 3-重写块索引、文件尾与文件头
+    commit(m_data_end);
+}
+
+uint64_t mpmt::mrvf_block_file::block_length(uint64_t block) const noexcept
+{
+    return std::min<uint64_t>(m_block_elems, m_size - block * m_block_elems);
+}
+
+void mpmt::mrvf_block_file::load_blocks(uint64_t first_block, uint64_t last_block, uint8_t* out)
+{
+    const uint64_t c_offset = m_index[first_block].m_offset;
+    const uint64_t c_bytes = m_index[last_block].m_offset + m_index[last_block].m_stored_bytes - c_offset;
+
+    // 1-全部为RAW时直接读入输出，否则读入暂存区后逐块解码
+    bool all_raw = true;
+    for (uint64_t b = first_block; b <= last_block; ++b)
+    {
+        all_raw = all_raw && m_index[b].m_codec == codec::RAW;
+    }
+    std::unique_ptr<uint8_t[]> staged;
+    uint8_t* stored = out;
+    if (!all_raw)
+    {
+        staged = std::make_unique<uint8_t[]>(c_bytes);
+        stored = staged.get();
+    }
+    io_guard([&] { m_io.read_at(c_offset, stored, c_bytes); });
+
+    // 2-逐块校验存储字节
+    for (uint64_t b = first_block; b <= last_block; ++b)
+    {
+        const block_entry& entry = m_index[b];
+        const uint8_t* const c_src = stored + (entry.m_offset - c_offset);
+        const uint64_t c_crc = crc64::compute(c_src, entry.m_stored_bytes);
+        if (c_crc != entry.m_crc64)
+        {
+            throw mrvf_exc
+            (
+                mrvf_exc::exc_type::FILE_CORRUPTION,
+                "CRC64 check failed on block " + std::to_string(b) + " of the file[" + mc_path
+                + "]. Expected checksum=" + std::to_string(entry.m_crc64)
+                + ", but computed checksum=" + std::to_string(c_crc) + "."
+            );
+        }
+        if (all_raw)
+        {
+            continue;
+        }
+
+        // 3-解码到输出中的对应位置
+        uint8_t* const dst = out + (b - first_block) * m_block_elems * m_ring_size;
+        if (entry.m_codec == codec::RAW)
+        {
+            std::memcpy(dst, c_src, entry.m_stored_bytes);
+            continue;
+        }
+        if (!mrvf_codec::available(entry.m_codec))
+        {
+            throw mrvf_exc
+            (
+                mrvf_exc::exc_type::CODEC_UNSUPPORTED,
+                "Block " + std::to_string(b) + " of the file[" + mc_path + "] is encoded with "
+                + mrvf_codec::name(entry.m_codec) + ", which is not available in this build."
+            );
+        }
+        try
+        {
+            mrvf_codec::decode(entry.m_codec, m_ring_size, c_src, entry.m_stored_bytes, dst, block_length(b));
+        }
+        catch (const std::runtime_error& e)
+        {
+            throw mrvf_exc
+            (
+                mrvf_exc::exc_type::FILE_CORRUPTION,
+                "Can not decode block " + std::to_string(b) + " of the file[" + mc_path + "]: " + e.what()
+            );
+        }
+    }
+}
+
+void mpmt::mrvf_block_file::store_block(uint64_t block, const uint8_t* raw, uint64_t elems)
+{
+    std::vector<uint8_t> encoded;
+    const codec c_codec = mc_compress ? mrvf_codec::choose(m_ring_size, raw, elems, encoded) : codec::RAW;
+    const uint8_t* const c_bytes = (c_codec == codec::RAW) ? raw : encoded.data();
+    const uint64_t c_len = (c_codec == codec::RAW) ? elems * m_ring_size : encoded.size();
+    MPMT_PROF_COUNT(MRVF_RAW_BYTES, elems * m_ring_size);
+    MPMT_PROF_COUNT(MRVF_STORED_BYTES, c_len);
+
+    // 位于数据区末尾的块可原位伸缩；其余块放不下时移至数据区末尾，原位置留空
+    block_entry& entry = m_index[block];
+    if (entry.m_offset + entry.m_stored_bytes == m_data_end)
+    {
+        m_data_end = std::max(m_data_end, entry.m_offset + c_len);
+    }
+    else if (c_len > entry.m_stored_bytes)
+    {
+        entry.m_offset = m_data_end;
+        m_data_end += c_len;
+    }
+    io_guard([&] { m_io.write_at(entry.m_offset, c_bytes, c_len); });
+    entry.m_stored_bytes = static_cast<uint32_t>(c_len);
+    entry.m_codec = c_codec;
+    entry.m_crc64 = crc64::compute(c_bytes, c_len);
+}
+
+void mpmt::mrvf_block_file::check_range(uint64_t first, uint64_t count) const
+{
+    if (first > m_size || count > m_size - first)
+    {
+        throw mrvf_exc
+        (
+            mrvf_exc::exc_type::IOFLOW_ERROR,
+            "Range of " + std::to_string(count) + " element(s) starting at " + std::to_string(first)
+            + " exceeds the " + std::to_string(m_size) + " element(s) of the file [" + mc_path + "]."
+        );
+    }
+}
+
+void mpmt::mrvf_block_file::commit(uint64_t index_offset)
+{
+    commit(m_io, m_layout, m_index, index_offset);
+    io_guard([&] { m_io.sync(); });
+}
+
+void mpmt::mrvf_block_file::commit
+(
+    io_adapter& io,
+    const layout& hdr,
+    const std::vector<block_entry>& index,
+    uint64_t index_offset
+)
+{
+    // 1-块索引与文件尾
+    const uint64_t c_index_bytes = index.size() * mc_ENTRY_SIZE;
+    std::unique_ptr<uint8_t[]> raw = std::make_unique<uint8_t[]>(c_index_bytes + mc_EOF_SIZE);
+    std::memset(raw.get(), 0, c_index_bytes);
+    for (uint64_t b = 0; b < index.size(); ++b)
+    {
+        uint8_t* e = raw.get() + b * mc_ENTRY_SIZE;
+        put<uint64_t>(e, 0, index[b].m_offset);
+        put<uint32_t>(e, 8, index[b].m_stored_bytes);
+        e[12] = static_cast<uint8_t>(index[b].m_codec);
+        put<uint64_t>(e, 16, index[b].m_crc64);
+    }
+    std::memcpy(raw.get() + c_index_bytes, mc_EOF, mc_EOF_SIZE);
+
+    // 2-文件头
+    uint8_t header[mc_HEADER_SIZE] = {};
+    std::memcpy(header, mc_MAGIC, sizeof(mc_MAGIC));
+    put<uint16_t>(header, mc_OFF_VERSION, mc_VERSION);
+    header[mc_OFF_RING_SIZE] = hdr.m_ring_field;
+    header[mc_OFF_FLAGS] = hdr.m_flags;
+    put<uint32_t>(header, mc_OFF_BLOCK_ELEMS, hdr.m_block_elems);
+    put<uint64_t>(header, mc_OFF_SIZE, hdr.m_size);
+    put<uint64_t>(header, mc_OFF_NUM_BLOCKS, index.size());
+    put<uint64_t>(header, mc_OFF_INDEX_OFFSET, index_offset);
+    put<uint64_t>(header, mc_OFF_INDEX_CRC, crc64::compute(raw.get(), c_index_bytes));
+    put<uint64_t>(header, mc_OFF_HEADER_CRC, crc64::compute(header, mc_OFF_HEADER_CRC));
+
+    io_guard([&]
+        {
+            io.write_at(index_offset, raw.get(), c_index_bytes + mc_EOF_SIZE);
+            io.write_at(0, header, mc_HEADER_SIZE);
+        });
+}
@@ -0,0 +1,506 @@
+#include "core/ring/mrvf/mrvf_codec.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#if defined(MPMT_HAVE_LZ4)
+#include <lz4.h>
+#endif
+#if defined(MPMT_HAVE_ZSTD)
+#include <zstd.h>
+#endif
+
+namespace
+{
+    constexpr uint64_t mc_MIN_SAVING_DIV = 8;           // 至少节省1/8才采用编码
+    constexpr uint64_t mc_SAMPLE_BYTES = 16 * 1024;     // 通用压缩试压的样本长度
+    constexpr uint64_t mc_LIGHT_HEADER = 1;             // BITPACK头：位宽
+    constexpr uint64_t mc_BASED_HEADER = 9;             // FOR/DELTA头：基准值 + 位宽
+#if defined(MPMT_HAVE_ZSTD)
+    constexpr int mc_ZSTD_LEVEL = 3;                    // zstd压缩级别
+#endif
+
+    using mpmt_codec = mpmt::mrvf_codec::codec;
+
+    uint8_t bit_width(uint64_t value) noexcept
+    {
+        return value == 0 ? 0 : static_cast<uint8_t>(64 - __builtin_clzll(value));
+    }
+
+    uint64_t packed_bytes(uint64_t count, uint8_t width) noexcept
+    {
+        return (count * width + 7) / 8;
+    }
+
+    /** @brief 低位在前的位流写入（仅GCC/Clang，使用unsigned __int128作为累加器） */
+    class bit_writer
+    {
+    public:
+        explicit bit_writer(uint8_t* out) noexcept : m_out(out), m_acc(0), m_bits(0) {}
+
+        void put(uint64_t value, uint8_t width) noexcept
+        {
+            if (width == 0)
+            {
+                return;
+            }
+            m_acc |= static_cast<unsigned __int128>(value) << m_bits;
+            m_bits += width;
+            if (m_bits >= 64)
+            {
+                const uint64_t c_word = static_cast<uint64_t>(m_acc);
+                std::memcpy(m_out, &c_word, 8);
+                m_out += 8;
+                m_acc >>= 64;
+                m_bits -= 64;
+            }
+        }
+
+        void finish() noexcept
+        {
+            for (; m_bits > 0; m_bits = (m_bits > 8) ? m_bits - 8 : 0)
+            {
+                *m_out++ = static_cast<uint8_t>(m_acc);
+                m_acc >>= 8;
+            }
+        }
+
+    private:
+        uint8_t* m_out;
+        unsigned __int128 m_acc;
+        uint32_t m_bits;
+    };
+
+    /** @brief 低位在前的位流读取，越界时抛出异常 */
+    class bit_reader
+    {
+    public:
+        bit_reader(const uint8_t* in, const uint8_t* end) noexcept : m_in(in), m_end(end), m_acc(0), m_bits(0) {}
+
+        uint64_t get(uint8_t width)
+        {
+            if (width == 0)
+            {
+                return 0;
+            }
+            if (m_bits < width)
+            {
+                if (m_end - m_in >= 8)
+                {
+                    uint64_t word;
+                    std::memcpy(&word, m_in, 8);
+                    m_acc |= static_cast<unsigned __int128>(word) << m_bits;
+                    m_in += 8;
+                    m_bits += 64;
+                }
+                else
+                {
+                    for (; m_in < m_end && m_bits < width; ++m_in, m_bits += 8)
+                    {
+                        m_acc |= static_cast<unsigned __int128>(*m_in) << m_bits;
+                    }
+                }
+                if (m_bits < width)
+                {
+                    throw std::runtime_error("Truncated bit-packed block.");
+                }
+            }
+            const uint64_t c_mask = (width == 64) ? ~0ULL : ((1ULL << width) - 1);
+            const uint64_t c_value = static_cast<uint64_t>(m_acc) & c_mask;
+            m_acc >>= width;
+            m_bits -= width;
+            return c_value;
+        }
+
+    private:
+        const uint8_t* m_in;
+        const uint8_t* m_end;
+        unsigned __int128 m_acc;
+        uint32_t m_bits;
+    };
+
+    template <typename T>
+    T load(const uint8_t* in, uint64_t i) noexcept
+    {
+        T value;
+        std::memcpy(&value, in + i * sizeof(T), sizeof(T));
+        return value;
+    }
+
+    template <typename T>
+    void store(uint8_t* out, uint64_t i, T value) noexcept
+    {
+        std::memcpy(out + i * sizeof(T), &value, sizeof(T));
+    }
+
+    /** @brief 相邻差值（按T的位宽回绕后视为有符号数）的zigzag编码 */
+    template <typename T>
+    uint64_t zigzag(T cur, T prev) noexcept
+    {
+        using S = std::make_signed_t<T>;
+        const int64_t c_delta = static_cast<S>(static_cast<T>(cur - prev));
+        return (static_cast<uint64_t>(c_delta) << 1) ^ static_cast<uint64_t>(c_delta >> 63);
+    }
+
+    template <typename T>
+    T unzigzag(T prev, uint64_t zz) noexcept
+    {
+        const int64_t c_delta = static_cast<int64_t>(zz >> 1) ^ -static_cast<int64_t>(zz & 1);
+        return static_cast<T>(prev + static_cast<T>(c_delta));
+    }
+
+    /** @brief 一次扫描得到三种定宽编码所需的位宽 */
+    struct scan_result
+    {
+        uint8_t m_bitpack_width;
+        uint8_t m_for_width;
+        uint8_t m_delta_width;
+        uint64_t m_min;
+    };
+
+    template <typename T>
+    scan_result scan(const uint8_t* in, uint64_t elems) noexcept
+    {
+        T lo = load<T>(in, 0);
+        T hi = lo;
+        uint64_t zz_or = 0;
+        T prev = lo;
+        for (uint64_t i = 1; i < elems; ++i)
+        {
+            const T c_v = load<T>(in, i);
+            lo = std::min(lo, c_v);
+            hi = std::max(hi, c_v);
+            zz_or |= zigzag<T>(c_v, prev);
+            prev = c_v;
+        }
+        return scan_result
+        {
+            bit_width(hi),
+            bit_width(static_cast<uint64_t>(hi - lo)),
+            bit_width(zz_or),
+            static_cast<uint64_t>(lo)
+        };
+    }
+
+    uint64_t light_size(mpmt_codec c, const scan_result& s, uint64_t elems) noexcept
+    {
+        switch (c)
+        {
+        case mpmt_codec::BITPACK:   return mc_LIGHT_HEADER + packed_bytes(elems, s.m_bitpack_width);
+        case mpmt_codec::FOR:       return mc_BASED_HEADER + packed_bytes(elems, s.m_for_width);
+        case mpmt_codec::DELTA:     return mc_BASED_HEADER + packed_bytes(elems - 1, s.m_delta_width);
+        default:                    return ~0ULL;
+        }
+    }
+
+    template <typename T>
+    void encode_light(mpmt_codec c, const scan_result& s, const uint8_t* in, uint64_t elems, std::vector<uint8_t>& out)
+    {
+        out.assign(light_size(c, s, elems), 0);
+        uint8_t* p = out.data();
+        if (c == mpmt_codec::BITPACK)
+        {
+            *p = s.m_bitpack_width;
+            bit_writer bw(p + mc_LIGHT_HEADER);
+            for (uint64_t i = 0; i < elems; ++i)
+            {
+                bw.put(load<T>(in, i), s.m_bitpack_width);
+            }
+            bw.finish();
+        }
+        else if (c == mpmt_codec::FOR)
+        {
+            std::memcpy(p, &s.m_min, 8);
+            p[8] = s.m_for_width;
+            bit_writer bw(p + mc_BASED_HEADER);
+            for (uint64_t i = 0; i < elems; ++i)
+            {
+                bw.put(static_cast<T>(load<T>(in, i) - static_cast<T>(s.m_min)), s.m_for_width);
+            }
+            bw.finish();
+        }
+        else
+        {
+            const uint64_t c_first = load<T>(in, 0);
+            std::memcpy(p, &c_first, 8);
+            p[8] = s.m_delta_width;
+            bit_writer bw(p + mc_BASED_HEADER);
+            for (uint64_t i = 1; i < elems; ++i)
+            {
+                bw.put(zigzag<T>(load<T>(in, i), load<T>(in, i - 1)), s.m_delta_width);
+            }
+            bw.finish();
+        }
+    }
+
+    template <typename T>
+    void decode_light(mpmt_codec c, const uint8_t* in, uint64_t in_bytes, uint8_t* out, uint64_t elems)
+    {
+        const uint64_t c_header = (c == mpmt_codec::BITPACK) ? mc_LIGHT_HEADER : mc_BASED_HEADER;
+        if (in_bytes < c_header)
+        {
+            throw std::runtime_error("Truncated block header.");
+        }
+        const uint8_t c_width = in[c_header - 1];
+        const uint64_t c_count = (c == mpmt_codec::DELTA) ? elems - 1 : elems;
+        if (c_width > sizeof(T) * 8 || in_bytes != c_header + packed_bytes(c_count, c_width))
+        {
+            throw std::runtime_error("Inconsistent bit width " + std::to_string(c_width) + " for the block.");
+        }
+
+        bit_reader br(in + c_header, in + in_bytes);
+        if (c == mpmt_codec::BITPACK)
+        {
+            for (uint64_t i = 0; i < elems; ++i)
+            {
+                store<T>(out, i, static_cast<T>(br.get(c_width)));
+            }
+            return;
+        }
+
+        uint64_t base;
+        std::memcpy(&base, in, 8);
+        if (c == mpmt_codec::FOR)
+        {
+            for (uint64_t i = 0; i < elems; ++i)
+            {
+                store<T>(out, i, static_cast<T>(static_cast<T>(base) + static_cast<T>(br.get(c_width))));
+            }
+            return;
+        }
+
+        T prev = static_cast<T>(base);
+        store<T>(out, 0, prev);
+        for (uint64_t i = 1; i < elems; ++i)
+        {
+            prev = unzigzag<T>(prev, br.get(c_width));
+            store<T>(out, i, prev);
+        }
+    }
+
+    /** @brief 按元素字节数选择模板实参 */
+    template <typename FN>
+    auto dispatch(uint8_t ring_size, FN&& fn)
+    {
+        switch (ring_size)
+        {
+        case 1:     return fn(uint8_t{});
+        case 2:     return fn(uint16_t{});
+        case 4:     return fn(uint32_t{});
+        case 8:     return fn(uint64_t{});
+        default:    throw std::runtime_error("Unsupported ring size " + std::to_string(ring_size) + " for block codecs.");
+        }
+    }
+
+    bool is_light(mpmt_codec c) noexcept
+    {
+        return c == mpmt_codec::BITPACK || c == mpmt_codec::FOR || c == mpmt_codec::DELTA;
+    }
+}
+
+bool mpmt::mrvf_codec::available(codec c) noexcept
+{
+    switch (c)
+    {
+    case codec::RAW:
+    case codec::BITPACK:
+    case codec::FOR:
+    case codec::DELTA:
+        return true;
+#if defined(MPMT_HAVE_LZ4)
+    case codec::LZ4:
+        return true;
+#endif
+#if defined(MPMT_HAVE_ZSTD)
+    case codec::ZSTD:
+        return true;
+#endif
+    default:
+        return false;
+    }
+}
+
+const char* mpmt::mrvf_codec::name(codec c) noexcept
+{
+    switch (c)
+    {
+    case codec::RAW:        return "raw";
+    case codec::BITPACK:    return "bitpack";
+    case codec::FOR:        return "for";
+    case codec::DELTA:      return "delta";
+    case codec::LZ4:        return "lz4";
+    case codec::ZSTD:       return "zstd";
+    default:                return "unknown";
+    }
+}
+
+bool mpmt::mrvf_codec::encode(codec c, uint8_t ring_size, const uint8_t* in, uint64_t elems, std::vector<uint8_t>& out)
+{
+    const uint64_t c_raw = elems * ring_size;
+    if (elems == 0 || c == codec::RAW || !available(c))
+    {
+        return false;
+    }
+
+    if (is_light(c))
+    {
+        return dispatch(ring_size, [&](auto tag)
+            {
+                using T = decltype(tag);
+                const scan_result c_scan = scan<T>(in, elems);
+                if (light_size(c, c_scan, elems) >= c_raw)
+                {
+                    return false;
+                }
+                encode_light<T>(c, c_scan, in, elems, out);
+                return true;
+            });
+    }
+
+#if defined(MPMT_HAVE_LZ4)
+    if (c == codec::LZ4)
+    {
+        if (c_raw > static_cast<uint64_t>(LZ4_MAX_INPUT_SIZE))
+        {
+            return false;
+        }
+        out.resize(static_cast<std::size_t>(LZ4_compressBound(static_cast<int>(c_raw))));
+        const int c_got = LZ4_compress_default
+        (
+            reinterpret_cast<const char*>(in), reinterpret_cast<char*>(out.data()),
+            static_cast<int>(c_raw), static_cast<int>(out.size())
+        );
+        if (c_got <= 0 || static_cast<uint64_t>(c_got) >= c_raw)
+        {
+            return false;
+        }
+        out.resize(static_cast<std::size_t>(c_got));
+        return true;
+    }
+#endif
+#if defined(MPMT_HAVE_ZSTD)
+    if (c == codec::ZSTD)
+    {
+        out.resize(ZSTD_compressBound(c_raw));
+        const std::size_t c_got = ZSTD_compress(out.data(), out.size(), in, c_raw, mc_ZSTD_LEVEL);
+        if (ZSTD_isError(c_got) || c_got >= c_raw)
+        {
+            return false;
+        }
+        out.resize(c_got);
+        return true;
+    }
+#endif
+    return false;
+}
+
+void mpmt::mrvf_codec::decode(codec c, uint8_t ring_size, const uint8_t* in, uint64_t in_bytes, uint8_t* out, uint64_t elems)
+{
+    if (!available(c) || c == codec::RAW)
+    {
+        throw std::runtime_error(std::string("Codec ") + name(c) + " is not available in this build.");
+    }
+    if (elems == 0)
+    {
+        return;
+    }
+
+    if (is_light(c))
+    {
+        dispatch(ring_size, [&](auto tag)
+            {
+                decode_light<decltype(tag)>(c, in, in_bytes, out, elems);
+            });
+        return;
+    }
+
+    const uint64_t c_raw = elems * ring_size;
+#if defined(MPMT_HAVE_LZ4)
+    if (c == codec::LZ4)
+    {
+        const int c_got = LZ4_decompress_safe
+        (
+            reinterpret_cast<const char*>(in), reinterpret_cast<char*>(out),
+            static_cast<int>(in_bytes), static_cast<int>(c_raw)
+        );
+        if (c_got < 0 || static_cast<uint64_t>(c_got) != c_raw)
+        {
+            throw std::runtime_error("Malformed LZ4 block.");
+        }
+        return;
+    }
+#endif
+#if defined(MPMT_HAVE_ZSTD)
+    if (c == codec::ZSTD)
+    {
+        const std::size_t c_got = ZSTD_decompress(out, c_raw, in, in_bytes);
+        if (ZSTD_isError(c_got) || c_got != c_raw)
+        {
+            throw std::runtime_error("Malformed zstd block.");
+        }
+        return;
+    }
+#endif
+    (void)c_raw;
+}
+
+mpmt::mrvf_codec::codec mpmt::mrvf_codec::choose(uint8_t ring_size, const uint8_t* in, uint64_t elems, std::vector<uint8_t>& out)
+{
+    const uint64_t c_raw = elems * ring_size;
+    if (elems == 0)
+    {
+        return codec::RAW;
+    }
+    const uint64_t c_limit = c_raw - c_raw / mc_MIN_SAVING_DIV;
+
+    // 1-定宽编码：一次扫描估算三种编码的大小，取最小者
+    const codec c_light = dispatch(ring_size, [&](auto tag)
+        {
+            using T = decltype(tag);
+            const scan_result c_scan = scan<T>(in, elems);
+            codec best = codec::RAW;
+            uint64_t best_size = c_limit + 1;
+            for (codec c : { codec::BITPACK, codec::FOR, codec::DELTA })
+            {
+                const uint64_t c_size = light_size(c, c_scan, elems);
+                if (c_size < best_size)
+                {
+                    best = c;
+                    best_size = c_size;
+                }
+            }
+            if (best != codec::RAW)
+            {
+                encode_light<T>(best, c_scan, in, elems, out);
+            }
+            return best;
+        });
+    if (c_light != codec::RAW)
+    {
+        return c_light;
+    }
+
+    // 2-通用压缩：先试压样本，样本不可压缩时视为随机数据跳过
+    const uint64_t c_sample_elems = std::min<uint64_t>(elems, mc_SAMPLE_BYTES / ring_size);
+    const uint64_t c_sample_bytes = c_sample_elems * ring_size;
+    for (codec c : { codec::ZSTD, codec::LZ4 })
+    {
+        if (!available(c))
+        {
+            continue;
+        }
+        if (c_sample_elems < elems
+            && (!encode(c, ring_size, in, c_sample_elems, out) || out.size() > c_sample_bytes - c_sample_bytes / mc_MIN_SAVING_DIV))
+        {
+            continue;
+        }
+        if (encode(c, ring_size, in, elems, out) && out.size() <= c_limit)
+        {
+            return c;
+        }
+    }
+    return codec::RAW;
+}
@@ -1,5 +1,31 @@
 #include "core/ring/rvector.hpp"
 
+#include <atomic>
+
+#include "auxkit/profiler.hpp"
+#include "core/numa/numa_pool.hpp"
+#include "core/ring/vcb/vcb_dispatch.hpp"
+
+namespace
+{
+    /**
+     * @brief   对[0, n)逐区间执行fn(first, count)：大向量经numa_pool按节点分区并行，否则在当前线程整体执行
+     * @note    分区边界与numa_memory分配时的绑定边界一致，每个区间由其所在节点的线程处理。
+     */
+    template <typename RT, typename FN>
+    void for_each_part(uint64_t n, FN&& fn)
+    {
+        if (mpmt::numa_memory::partitioned(n * sizeof(RT)))
+        {
+            mpmt::numa_pool::instance().parallel_for(n, sizeof(RT), fn);
+        }
+        else
+        {
+            fn(0, n);
+        }
+    }
+}
+
 template<typename RT>
 mpmt::rvector<RT>::rvector() :
     m_data(nullptr),
@@ -9,7 +35,7 @@ mpmt::rvector<RT>::rvector() :
 template<typename RT>
 mpmt::rvector<RT>::rvector(size_t n) :
     m_size(n),
-    m_data(std::make_unique<RT[]>(n))
+    m_data(numa_memory::make<RT>(n))
 {}
 
 template<typename RT>
@@ -19,7 +45,19 @@ mpmt::rvector<RT>::rvector
     const RT value
 ) : rvector(n)
 {
-    std::fill(m_data.get(), m_data.get() + m_size, value);
+    if constexpr (std::is_same_v<RT, ring1>)
+    {
+        std::fill(m_data.get(), m_data.get() + m_size, value);
+    }
+    else if (value != RT(0))
+    {
+        // 新分配的存储已全零，仅非零初值需要填充
+        RT* dst = m_data.get();
+        for_each_part<RT>(m_size, [dst, value](uint64_t first, uint64_t count)
+        {
+            std::fill(dst + first, dst + first + count, value);
+        });
+    }
 }
 
 template<typename RT>
@@ -34,7 +72,12 @@ mpmt::rvector<RT>::rvector(const rvector& other)
     :
     rvector(other.m_size)
 {
-    std::copy(other.m_data.get(), other.m_data.get() + m_size, m_data.get());
+    const RT* src = other.m_data.get();
+    RT* dst = m_data.get();
+    for_each_part<RT>(m_size, [src, dst](uint64_t first, uint64_t count)
+    {
+        std::copy(src + first, src + first + count, dst + first);
+    });
 }
 
 template<typename RT>
@@ -58,12 +101,29 @@ mpmt::rvector<RT>& mpmt::rvector<RT>::operator=(const rvector<RT>& other)
         }
         else
         {
-            std::copy(other.m_data.get(), other.m_data.get() + m_size, m_data.get());
+            const RT* src = other.m_data.get();
+            RT* dst = m_data.get();
+            for_each_part<RT>(m_size, [src, dst](uint64_t first, uint64_t count)
+            {
+                std::copy(src + first, src + first + count, dst + first);
+            });
         }
     }
     return *this;
 }
 
+template <typename RT>
+mpmt::rvector<RT>& mpmt::rvector<RT>::operator=(rvector<RT>&& other) noexcept
+{
+    if (this != &other)
+    {
+        m_data = std::move(other.m_data);
+        m_size = other.m_size;
+        other.m_size = 0;
+    }
+    return *this;
+}
+
 template<typename RT>
 RT& mpmt::rvector<RT>::operator[](size_t index)
 {
@@ -81,11 +141,24 @@ const RT& mpmt::rvector<RT>::operator[](size_t index) const
 template<typename RT>
 mpmt::rvector<RT>& mpmt::rvector<RT>::operator+=(const rvector<RT>& other)
 {
+    MPMT_PROF_COUNT(RVECTOR_ELEMENTS, m_size);
     MPMT_ASSERT(m_size == other.m_size, "Vector dimension mismatch for addition.");
 
-    for (size_t i = 0;i < m_size;++i)
+    if constexpr (std::is_same_v<RT, ring1>)
     {
-        m_data[i] += other[i];
+        for (size_t i = 0;i < m_size;++i)
+        {
+            m_data[i] += other[i];
+        }
+    }
+    else
+    {
+        RT* dst = m_data.get();
+        const RT* src = other.m_data.get();
+        for_each_part<RT>(m_size, [dst, src](uint64_t first, uint64_t count)
+        {
+            vcb_dispatch::kernels<RT>().m_add(dst + first, src + first, count);
+        });
     }
 
     return *this;
@@ -94,9 +167,21 @@ mpmt::rvector<RT>& mpmt::rvector<RT>::operator+=(const rvector<RT>& other)
 template<typename RT>
 mpmt::rvector<RT>& mpmt::rvector<RT>::operator+=(const RT scalar)
 {
-    for (size_t i = 0;i < m_size;++i)
+    MPMT_PROF_COUNT(RVECTOR_ELEMENTS, m_size);
+    if constexpr (std::is_same_v<RT, ring1>)
     {
-        m_data[i] += scalar;
+        for (size_t i = 0;i < m_size;++i)
+        {
+            m_data[i] += scalar;
+        }
+    }
+    else
+    {
+        RT* dst = m_data.get();
+        for_each_part<RT>(m_size, [dst, scalar](uint64_t first, uint64_t count)
+        {
+            vcb_dispatch::kernels<RT>().m_add_scalar(dst + first, scalar, count);
+        });
     }
 
     return *this;
@@ -105,10 +190,23 @@ mpmt::rvector<RT>& mpmt::rvector<RT>::operator+=(const RT scalar)
 template<typename RT>
 mpmt::rvector<RT>& mpmt::rvector<RT>::operator-=(const rvector<RT>& other)
 {
+    MPMT_PROF_COUNT(RVECTOR_ELEMENTS, m_size);
     MPMT_ASSERT(m_size == other.m_size, "Vector dimension mismatch for subtraction.");
-    for (size_t i = 0;i < m_size;++i)
+    if constexpr (std::is_same_v<RT, ring1>)
+    {
+        for (size_t i = 0;i < m_size;++i)
+        {
+            m_data[i] -= other[i];
+        }
+    }
+    else
     {
-        m_data[i] -= other[i];
+        RT* dst = m_data.get();
+        const RT* src = other.m_data.get();
+        for_each_part<RT>(m_size, [dst, src](uint64_t first, uint64_t count)
+        {
+            vcb_dispatch::kernels<RT>().m_sub(dst + first, src + first, count);
+        });
     }
 
     return *this;
@@ -117,9 +215,21 @@ mpmt::rvector<RT>& mpmt::rvector<RT>::operator-=(const rvector<RT>& other)
 template<typename RT>
 mpmt::rvector<RT>& mpmt::rvector<RT>::operator-=(const RT scalar)
 {
-    for (size_t i = 0;i < m_size;++i)
+    MPMT_PROF_COUNT(RVECTOR_ELEMENTS, m_size);
+    if constexpr (std::is_same_v<RT, ring1>)
     {
-        m_data[i] -= scalar;
+        for (size_t i = 0;i < m_size;++i)
+        {
+            m_data[i] -= scalar;
+        }
+    }
+    else
+    {
+        RT* dst = m_data.get();
+        for_each_part<RT>(m_size, [dst, scalar](uint64_t first, uint64_t count)
+        {
+            vcb_dispatch::kernels<RT>().m_sub_scalar(dst + first, scalar, count);
+        });
     }
 
     return *this;
@@ -128,10 +238,23 @@ mpmt::rvector<RT>& mpmt::rvector<RT>::operator-=(const RT scalar)
 template<typename RT>
 mpmt::rvector<RT>& mpmt::rvector<RT>::operator*=(const rvector<RT>& other)
 {
+    MPMT_PROF_COUNT(RVECTOR_ELEMENTS, m_size);
     MPMT_ASSERT(m_size == other.m_size, "Vector dimension mismatch for multiplication.");
-    for (size_t i = 0;i < m_size;++i)
+    if constexpr (std::is_same_v<RT, ring1>)
     {
-        m_data[i] *= other[i];
+        for (size_t i = 0;i < m_size;++i)
+        {
+            m_data[i] *= other[i];
+        }
+    }
+    else
+    {
+        RT* dst = m_data.get();
+        const RT* src = other.m_data.get();
+        for_each_part<RT>(m_size, [dst, src](uint64_t first, uint64_t count)
+        {
+            vcb_dispatch::kernels<RT>().m_mul(dst + first, src + first, count);
+        });
     }
 
     return *this;
@@ -140,9 +263,87 @@ mpmt::rvector<RT>& mpmt::rvector<RT>::operator*=(const rvector<RT>& other)
 template<typename RT>
 mpmt::rvector<RT>& mpmt::rvector<RT>::operator*=(const RT scalar)
 {
-    for (size_t i = 0;i < m_size;++i)
+    MPMT_PROF_COUNT(RVECTOR_ELEMENTS, m_size);
+    if constexpr (std::is_same_v<RT, ring1>)
+    {
+        for (size_t i = 0;i < m_size;++i)
+        {
+            m_data[i] *= scalar;
+        }
+    }
+    else
+    {
+        RT* dst = m_data.get();
+        for_each_part<RT>(m_size, [dst, scalar](uint64_t first, uint64_t count)
+        {
+            vcb_dispatch::kernels<RT>().m_mul_scalar(dst + first, scalar, count);
+        });
+    }
+
+    return *this;
+}
+
+template<typename RT>
+mpmt::rvector<RT>& mpmt::rvector<RT>::accumulate(const std::vector<const rvector<RT>*>& terms)
+{
+    MPMT_PROF_COUNT(RVECTOR_ELEMENTS, m_size * terms.size());
+    for (const rvector<RT>* term : terms)
+    {
+        MPMT_ASSERT(term->m_size == m_size, "Vector dimension mismatch for addition.");
+    }
+
+    if constexpr (std::is_same_v<RT, ring1>)
+    {
+        for (const rvector<RT>* term : terms)
+        {
+            *this += *term;
+        }
+    }
+    else
+    {
+        RT* dst = m_data.get();
+        for_each_part<RT>(m_size, [dst, &terms](uint64_t first, uint64_t count)
+        {
+            std::vector<const RT*> srcs(terms.size());
+            for (uint64_t j = 0; j < terms.size(); ++j)
+            {
+                srcs[j] = terms[j]->m_data.get() + first;
+            }
+            vcb_dispatch::kernels<RT>().m_add_many(dst + first, srcs.data(), srcs.size(), count);
+        });
+    }
+
+    return *this;
+}
+
+template<typename RT>
+mpmt::rvector<RT>& mpmt::rvector<RT>::multiply(const std::vector<const rvector<RT>*>& factors)
+{
+    MPMT_PROF_COUNT(RVECTOR_ELEMENTS, m_size * factors.size());
+    for (const rvector<RT>* factor : factors)
     {
-        m_data[i] *= scalar;
+        MPMT_ASSERT(factor->m_size == m_size, "Vector dimension mismatch for multiplication.");
+    }
+
+    if constexpr (std::is_same_v<RT, ring1>)
+    {
+        for (const rvector<RT>* factor : factors)
+        {
+            *this *= *factor;
+        }
+    }
+    else
+    {
+        RT* dst = m_data.get();
+        for_each_part<RT>(m_size, [dst, &factors](uint64_t first, uint64_t count)
+        {
+            std::vector<const RT*> srcs(factors.size());
+            for (uint64_t j = 0; j < factors.size(); ++j)
+            {
+                srcs[j] = factors[j]->m_data.get() + first;
+            }
+            vcb_dispatch::kernels<RT>().m_mul_many(dst + first, srcs.data(), srcs.size(), count);
+        });
     }
 
     return *this;
@@ -156,14 +357,31 @@ bool mpmt::rvector<RT>::operator==(const rvector<RT>& other) const
         return false;
     }
 
-    for (size_t i = 0;i < m_size;++i)
+    if constexpr (std::is_same_v<RT, ring1>)
     {
-        if (m_data[i] != other.m_data[i])
+        for (size_t i = 0;i < m_size;++i)
         {
-            return false;
+            if (m_data[i] != other.m_data[i])
+            {
+                return false;
+            }
         }
+        return true;
+    }
+    else
+    {
+        const RT* lhs = m_data.get();
+        const RT* rhs = other.m_data.get();
+        std::atomic<bool> equal{ true };
+        for_each_part<RT>(m_size, [lhs, rhs, &equal](uint64_t first, uint64_t count)
+        {
+            if (!vcb_dispatch::kernels<RT>().m_equal(lhs + first, rhs + first, count))
+            {
+                equal.store(false, std::memory_order_relaxed);
+            }
+        });
+        return equal.load(std::memory_order_relaxed);
     }
-    return true;
 }
 
 template<typename RT>
@@ -175,12 +393,27 @@ bool mpmt::rvector<RT>::operator!=(const rvector<RT>& other) const
 template<typename RT>
 RT mpmt::rvector<RT>::reduce() const noexcept
 {
-    RT reduction = 0;
-    for (size_t i = 0; i < m_size; ++i)
+    MPMT_PROF_COUNT(RVECTOR_ELEMENTS, m_size);
+    if constexpr (std::is_same_v<RT, ring1>)
     {
-        reduction += m_data[i];
+        RT reduction = 0;
+        for (size_t i = 0; i < m_size; ++i)
+        {
+            reduction += m_data[i];
+        }
+        return reduction;
+    }
+    else
+    {
+        // 无符号原子加法按模2^{|RT|}回绕，与环上加法一致
+        const RT* src = m_data.get();
+        std::atomic<RT> reduction{ 0 };
+        for_each_part<RT>(m_size, [src, &reduction](uint64_t first, uint64_t count)
+        {
+            reduction.fetch_add(vcb_dispatch::kernels<RT>().m_reduce(src + first, count), std::memory_order_relaxed);
+        });
+        return reduction.load(std::memory_order_relaxed);
     }
-    return reduction;
 }
 
 template<typename RT>
@@ -189,6 +422,18 @@ size_t mpmt::rvector<RT>::size() const noexcept
     return m_size;
 }
 
+template<typename RT>
+RT* mpmt::rvector<RT>::data() noexcept
+{
+    return m_data.get();
+}
+
+template<typename RT>
+const RT* mpmt::rvector<RT>::data() const noexcept
+{
+    return m_data.get();
+}
+
 template<typename RT>
 mpmt::rvector<RT>::~rvector() { /** 智能指针自动析构 */ }
 
@@ -1 +0,0 @@
-#include "core/ring/rvector.hpp"
\ No newline at end of file
@@ -0,0 +1,134 @@
+#include "core/ring/vcb/vcb_dispatch.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+
+#include "core/exception/vcb_exc.hpp"
+
+std::atomic<uint8_t> mpmt::vcb_dispatch::s_active{ mpmt::vcb_dispatch::mc_UNSET };
+
+mpmt::vcb_isa mpmt::vcb_dispatch::active() noexcept
+{
+    const uint8_t c_active = s_active.load(std::memory_order_acquire);
+    if (c_active != mc_UNSET)
+    {
+        return static_cast<vcb_isa>(c_active);
+    }
+    return initialize();
+}
+
+mpmt::vcb_isa mpmt::vcb_dispatch::detect() noexcept
+{
+#if defined(__x86_64__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw"))
+    {
+        return vcb_isa::AVX512;
+    }
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return vcb_isa::AVX2;
+    }
+    if (__builtin_cpu_supports("sse4.2"))
+    {
+        return vcb_isa::SSE42;
+    }
+#endif
+    return vcb_isa::GENERIC;
+}
+
+bool mpmt::vcb_dispatch::supported(vcb_isa isa) noexcept
+{
+    // 指令集逐级包含，不高于检测结果即可用
+    return static_cast<uint8_t>(isa) <= static_cast<uint8_t>(detect());
+}
+
+void mpmt::vcb_dispatch::select(vcb_isa isa)
+{
+    if (!supported(isa))
+    {
+        throw vcb_exc
+        (
+            vcb_exc::exc_type::UNSUPPORTED_ISA,
+            std::string(name(isa)) + " is not available on this CPU or build; the highest supported is "
+            + name(detect()) + "."
+        );
+    }
+    s_active.store(static_cast<uint8_t>(isa), std::memory_order_release);
+}
+
+void mpmt::vcb_dispatch::select(const std::string& name)
+{
+    vcb_isa isa;
+    if (!parse(name, isa))
+    {
+        throw vcb_exc
+        (
+            vcb_exc::exc_type::INVALID_PARAMETER,
+            "unknown backend [" + name + "], expected auto, generic, sse4.2, avx2 or avx512."
+        );
+    }
+    select(isa);
+}
+
+const char* mpmt::vcb_dispatch::name(vcb_isa isa) noexcept
+{
+    switch (isa)
+    {
+    case vcb_isa::GENERIC:
+        return "generic";
+    case vcb_isa::SSE42:
+        return "sse4.2";
+    case vcb_isa::AVX2:
+        return "avx2";
+    case vcb_isa::AVX512:
+        return "avx512";
+    default:
+        return "unknown";
+    }
+}
+
+mpmt::vcb_isa mpmt::vcb_dispatch::initialize() noexcept
+{
+    // 1-自动检测
+    vcb_isa isa = detect();
+
+    // 2-环境变量覆盖：无法识别或不受支持时给出警告并保持自动选择
+    const char* env = std::getenv("MPMT_VCB");
+    if (env != nullptr)
+    {
+        vcb_isa requested;
+        const bool c_valid = parse(env, requested) && supported(requested);
+        MPMT_WARN(c_valid, "MPMT_VCB names an unknown or unsupported backend, falling back to auto detection.");
+        if (c_valid)
+        {
+            isa = requested;
+        }
+    }
+
+    // 3-并发的首次调用可能重复初始化，但结果一致；不覆盖已由select()写入的值
+    uint8_t expected = mc_UNSET;
+    if (!s_active.compare_exchange_strong(expected, static_cast<uint8_t>(isa), std::memory_order_acq_rel))
+    {
+        return static_cast<vcb_isa>(expected);
+    }
+    return isa;
+}
+
+bool mpmt::vcb_dispatch::parse(const std::string& name, vcb_isa& isa)
+{
+    std::string lower(name);
+    std::transform(lower.begin(), lower.end(), lower.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+    if (lower == "auto")                            { isa = detect(); }
+    else if (lower == "generic")                    { isa = vcb_isa::GENERIC; }
+    else if (lower == "sse4.2" || lower == "sse42") { isa = vcb_isa::SSE42; }
+    else if (lower == "avx2")                       { isa = vcb_isa::AVX2; }
+    else if (lower == "avx512")                     { isa = vcb_isa::AVX512; }
+    else
+    {
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,5 @@
+// AVX2内核：仅在x86-64上编译，编译选项见CMakeLists.txt
+#if defined(__x86_64__)
+#define MPMT_VCB_KERNEL_NS vcb_avx2
+#include "core/ring/vcb/vcb_kernels.tpp"
+#endif
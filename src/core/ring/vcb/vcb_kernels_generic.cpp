@@ -0,0 +1,3 @@
+// 通用内核：按构建的基线指令集编译，所有平台均可用
+#define MPMT_VCB_KERNEL_NS vcb_generic
+#include "core/ring/vcb/vcb_kernels.tpp"
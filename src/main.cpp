@@ -1,11 +1,193 @@
+#include <cstdlib>
+#include <cstring>
+#include <exception>
 #include <iostream>
-#include <openssl/rand.h>
+#include <string>
 
-int main(int argc, char** argv)
+#include "auxkit/logger.hpp"
+#include "auxkit/profiler.hpp"
+#include "auxkit/stack_tracer.hpp"
+#include "core/numa/numa_memory.hpp"
+#include "core/ring/vcb/vcb_dispatch.hpp"
+#include "sim/local_sim.hpp"
+
+namespace
 {
-    (void)argc; (void)argv;
+    void print_usage(const char* prog)
+    {
+        std::cout
+            << "Usage:\n"
+            << "  " << prog << " sim [--holders N] [--set-size S] [--slots M] [--hashes K]\n"
+            << "      [--ring 8|16|32|64] [--queries Q] [--threads T] [--trace FILE] [--log FILE]\n"
+            << "      [--vcb auto|generic|sse4.2|avx2|avx512] [--slow-stack US]\n"
+            << "      [--serve-workers W] [--clients C] [--cache N] [--numa auto|off|partition|interleave]\n"
+            << "      [--relay-fanin F] [--shards M] [--save PREFIX] [--batch B]\n"
+            << "      [--checkpoint PREFIX] [--checkpoint-interval SEC] [--crash-after K] [--backend ass|rss]\n"
+            << "      [--shard-processes 0|1] [--share-bits B]\n"
+            << "      Run data holders, AS0, AS1 and the querier as threads in one process.\n"
+            << "      --serve-workers answers queries from a pool of W agent workers, with C concurrent queriers.\n"
+            << "      --cache keeps up to N answered query tokens per agent (per worker with --serve-workers).\n"
+            << "      --relay-fanin aggregates holder shares through relay trees of fan-in F before the agents.\n"
+            << "      --shards splits the slots across M agent pairs; queries are routed to the owning pairs.\n"
+            << "      --batch opens B queries per round trip through one combined token per agent.\n"
+            << "      --shard-processes 1 runs each shard's agent pair in its own child process connected by pipes.\n"
+            << "      --share-bits shares over Z_{2^B} (B <= ring width, 2^B > holders); holder uploads shrink to B bits.\n"
+            << "      --save writes each agent's union share to PREFIX.as<0|1>[.shard<i>].mrvf and serves from the files.\n"
+            << "      --checkpoint writes crash-consistent merge checkpoints to PREFIX.as<0|1>[.shard<i>].manifest,\n"
+            << "      at most one per SEC seconds per agent (--checkpoint-interval, default 0 = as often as possible).\n"
+            << "      --crash-after interrupts the merge after K holders, restarts the agents from their checkpoints\n"
+            << "      and has every holder resend its shares.\n"
+            << "      --backend rss merges and queries through three agents with 2-out-of-3 replicated shares.\n"
+            << "      --trace writes a Chrome trace JSON (requires a build with MPMT_PROFILE).\n"
+            << "      --log appends JSON-line logs to FILE instead of stderr.\n"
+            << "      --slow-stack samples call stacks of profiled scopes slower than US microseconds into the trace.\n"
+            << "      --vcb overrides the CPU vector backend picked by CPUID (also: MPMT_VCB env).\n"
+            << "      --numa overrides the placement of large vectors picked from sysfs (also: MPMT_NUMA env).\n";
+    }
+
+    int run_sim(int argc, char** argv)
+    {
+        mpmt::local_sim::config cfg{};
+        cfg.m_num_holders = 4;
+        cfg.m_set_size = 100000;
+        cfg.m_num_slots = 1ULL << 22;
+        cfg.m_num_hashes = 3;
+        cfg.m_ring_bits = 32;
+        cfg.m_num_queries = 1000;
+        cfg.m_ingest_threads = 0;
+        std::string trace_path;
+        std::string log_path;
+
+        for (int i = 2; i < argc; ++i)
+        {
+            const std::string c_opt = argv[i];
+            if (i + 1 >= argc)
+            {
+                std::cerr << "Missing value for option " << c_opt << "." << std::endl;
+                return 1;
+            }
+            if (c_opt == "--trace")
+            {
+                trace_path = argv[++i];
+                continue;
+            }
+            if (c_opt == "--log")
+            {
+                log_path = argv[++i];
+                continue;
+            }
+            if (c_opt == "--slow-stack")
+            {
+                utils::profiler::set_stack_sampling(std::strtoull(argv[++i], nullptr, 10) * 1000, 1);
+                continue;
+            }
+            if (c_opt == "--vcb")
+            {
+                mpmt::vcb_dispatch::select(argv[++i]);
+                continue;
+            }
+            if (c_opt == "--numa")
+            {
+                mpmt::numa_memory::select(argv[++i]);
+                continue;
+            }
+            if (c_opt == "--save")
+            {
+                cfg.m_union_path = argv[++i];
+                continue;
+            }
+            if (c_opt == "--backend")
+            {
+                const std::string c_name = argv[++i];
+                if (c_name != "ass" && c_name != "rss")
+                {
+                    std::cerr << "Unknown backend " << c_name << "." << std::endl;
+                    return 1;
+                }
+                cfg.m_backend = c_name == "rss" ? mpmt::local_sim::backend::RSS : mpmt::local_sim::backend::ASS;
+                continue;
+            }
+            if (c_opt == "--checkpoint")
+            {
+                cfg.m_checkpoint_path = argv[++i];
+                continue;
+            }
+            if (c_opt == "--checkpoint-interval")
+            {
+                cfg.m_checkpoint_interval = std::strtod(argv[++i], nullptr);
+                continue;
+            }
+            const unsigned long long c_value = std::strtoull(argv[++i], nullptr, 10);
+            if (c_opt == "--holders")       { cfg.m_num_holders = static_cast<uint32_t>(c_value); }
+            else if (c_opt == "--set-size") { cfg.m_set_size = c_value; }
+            else if (c_opt == "--slots")    { cfg.m_num_slots = c_value; }
+            else if (c_opt == "--hashes")   { cfg.m_num_hashes = static_cast<uint8_t>(c_value); }
+            else if (c_opt == "--ring")     { cfg.m_ring_bits = static_cast<uint8_t>(c_value); }
+            else if (c_opt == "--queries")  { cfg.m_num_queries = c_value; }
+            else if (c_opt == "--threads")  { cfg.m_ingest_threads = static_cast<unsigned>(c_value); }
+            else if (c_opt == "--serve-workers") { cfg.m_serve_workers = static_cast<unsigned>(c_value); }
+            else if (c_opt == "--clients")  { cfg.m_query_clients = static_cast<unsigned>(c_value); }
+            else if (c_opt == "--cache")    { cfg.m_cache_entries = c_value; }
+            else if (c_opt == "--relay-fanin") { cfg.m_relay_fanin = static_cast<uint32_t>(c_value); }
+            else if (c_opt == "--shards")   { cfg.m_num_shards = static_cast<uint32_t>(c_value); }
+            else if (c_opt == "--batch")    { cfg.m_open_batch = c_value; }
+            else if (c_opt == "--crash-after") { cfg.m_crash_after = static_cast<uint32_t>(c_value); }
+            else if (c_opt == "--shard-processes") { cfg.m_shard_processes = c_value != 0; }
+            else if (c_opt == "--share-bits") { cfg.m_share_bits = static_cast<uint8_t>(c_value > 255 ? 255 : c_value); }
+            else
+            {
+                std::cerr << "Unknown option " << c_opt << "." << std::endl;
+                return 1;
+            }
+        }
+
+        if (!utils::logger::start(utils::logger::config{ log_path, utils::logger::level::INFO }))
+        {
+            std::cerr << "Cannot open the log file [" << log_path << "]." << std::endl;
+            return 1;
+        }
 
+        // 后台日志线程在报告输出前停止；构造或运行抛出异常时由log_scope回收
+        std::string text;
+        {
+            const utils::logger::scope log_scope;
+            const mpmt::local_sim sim(cfg);
+            text = sim.format(sim.run());
+        }
+        std::cout << text << std::endl;
+
+        if (!trace_path.empty() && !utils::profiler::save_chrome_trace(trace_path))
+        {
+            std::cerr << "Cannot write the trace file [" << trace_path << "]." << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+}
+
+int main(int argc, char** argv)
+{
     std::cout << "Secure-Multi-Party-Private-Membership-Test." << std::endl;
+    utils::stack_tracer::install_crash_handlers();
+
+    if (argc < 2)
+    {
+        print_usage(argv[0]);
+        return 0;
+    }
 
-    return 0;
-}
\ No newline at end of file
+    try
+    {
+        if (std::strcmp(argv[1], "sim") == 0)
+        {
+            return run_sim(argc, argv);
+        }
+        print_usage(argv[0]);
+        return 1;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,1353 @@
+#include "sim/local_sim.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <csignal>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include "auxkit/logger.hpp"
+#include "auxkit/stack_tracer.hpp"
+#include "core/comm/inproc_impl/comm_inproc.hpp"
+#if !defined(_WIN32)
+#include "core/comm/pipe_impl/comm_pipe.hpp"
+#endif
+#include "core/coro/coro_pool.hpp"
+#include "core/coro/coro_task.hpp"
+#include "core/encode/credential_ingest.hpp"
+#include "core/exception/comm_exc.hpp"
+#include "core/exception/encode_exc.hpp"
+#include "core/exception/protocol_exc.hpp"
+#include "core/hash/siphash_impl/hash_siphash.hpp"
+#include "core/io/durable_file.hpp"
+#include "core/numa/numa_memory.hpp"
+#include "core/protocol/ass_impl/agent_ass.hpp"
+#include "core/protocol/ass_impl/agent_server.hpp"
+#include "core/protocol/ass_impl/ass_wire.hpp"
+#include "core/protocol/ass_impl/data_holder_ass.hpp"
+#include "core/protocol/ass_impl/merge_checkpoint.hpp"
+#include "core/protocol/ass_impl/open_queue.hpp"
+#include "core/protocol/ass_impl/querier_ass.hpp"
+#include "core/protocol/ass_impl/relay_ass.hpp"
+#include "core/protocol/ass_impl/reveal_blind.hpp"
+#include "core/protocol/ass_impl/shard_map.hpp"
+#include "core/protocol/rss_impl/agent_rss.hpp"
+#include "core/protocol/rss_impl/data_holder_rss.hpp"
+#include "core/protocol/rss_impl/querier_rss.hpp"
+#include "core/ring/mrvf/mrvf.hpp"
+#include "core/ring/mrvf/mrvf_handler.hpp"
+#include "core/ring/vcb/vcb_dispatch.hpp"
+
+namespace
+{
+    using sim_clock = std::chrono::steady_clock;
+
+    double seconds_since(const sim_clock::time_point& start)
+    {
+        return std::chrono::duration<double>(sim_clock::now() - start).count();
+    }
+
+    std::string holder_credential(uint32_t holder, uint64_t index)
+    {
+        return "h" + std::to_string(holder) + "_" + std::to_string(index);
+    }
+
+    mpmt::hash_siphash::key_type sim_key()
+    {
+        mpmt::hash_siphash::key_type key{};
+        for (uint64_t i = 0; i < key.size(); ++i)
+        {
+            key[i] = static_cast<uint8_t>(i * 0x3b + 0x11);
+        }
+        return key;
+    }
+
+    /** @brief 代理方共享、查询方不持有的盲化密钥（见reveal_blind） */
+    mpmt::hash_siphash::key_type blind_key()
+    {
+        mpmt::hash_siphash::key_type key{};
+        for (uint64_t i = 0; i < key.size(); ++i)
+        {
+            key[i] = static_cast<uint8_t>(i * 0x5d + 0x27);
+        }
+        return key;
+    }
+
+    /** @brief 代理方逐次响应查询，直至查询方断开连接 */
+    template <typename RT>
+    void serve_until_closed(mpmt::agent_ass<RT>& agent)
+    {
+        try
+        {
+            for (;;)
+            {
+                agent.reveal();
+            }
+        }
+        catch (const mpmt::comm_exc& e)
+        {
+            if (e.get_exc_type() != mpmt::comm_exc::exc_type::CONNECTION_CLOSED)
+            {
+                throw;
+            }
+        }
+    }
+
+#if !defined(_WIN32)
+    /** @brief 分片代理方子进程：正常结束时由wait_all()回收，异常路径上析构时终止并回收，不遗留僵尸进程 */
+    struct child_reaper
+    {
+        std::vector<pid_t> m_pids;
+
+        /** @brief 等待全部子进程退出，返回是否均以状态0退出 */
+        bool wait_all()
+        {
+            bool ok = true;
+            for (const pid_t c_pid : m_pids)
+            {
+                int status = 0;
+                while (::waitpid(c_pid, &status, 0) < 0 && errno == EINTR)
+                {
+                }
+                ok = ok && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+            }
+            m_pids.clear();
+            return ok;
+        }
+
+        ~child_reaper()
+        {
+            for (const pid_t c_pid : m_pids)
+            {
+                ::kill(c_pid, SIGKILL);
+            }
+            wait_all();
+        }
+    };
+#endif
+
+    /**
+     * @brief   聚合树：逐层把至多fanin个连接交给一个中继，直到连接数不超过扇入
+     * @tparam  RT 环类型
+     * @tparam  CT 通道类型（comm_inproc或comm_pipe）
+     * @param   links 代理方一侧的入口连接，返回时为树根一层的连接
+     * @param   senders 与links一一对应的发送端，返回时为树根一层的发送端（用于统计代理方的入口流量）
+     * @param   channels 新建的中继通道（两端均由调用方持有）
+     * @param   relays 新建的中继
+     */
+    template <typename RT, template <typename> class CT>
+    void build_relay_tree
+    (
+        mpmt::ass_role role,
+        uint64_t fanin,
+        std::vector<mpmt::comm_adapter<RT>*>& links,
+        std::vector<CT<RT>*>& senders,
+        std::vector<std::unique_ptr<CT<RT>>>& channels,
+        std::vector<std::unique_ptr<mpmt::relay_ass<RT>>>& relays
+    )
+    {
+        while (fanin != 0 && links.size() > fanin)
+        {
+            std::vector<mpmt::comm_adapter<RT>*> next_links;
+            std::vector<CT<RT>*> next_senders;
+            for (uint64_t first = 0; first < links.size(); first += fanin)
+            {
+                const uint64_t c_last = std::min<uint64_t>(first + fanin, links.size());
+                if (c_last - first == 1)
+                {
+                    // 末组只有一个连接时直接上移一层
+                    next_links.push_back(links[first]);
+                    next_senders.push_back(senders[first]);
+                    continue;
+                }
+                auto up = CT<RT>::make_pair();
+                relays.push_back(std::make_unique<mpmt::relay_ass<RT>>
+                (
+                    role,
+                    std::vector<mpmt::comm_adapter<RT>*>(links.begin() + first, links.begin() + c_last),
+                    *up.first
+                ));
+                next_links.push_back(up.second.get());
+                next_senders.push_back(up.first.get());
+                channels.push_back(std::move(up.first));
+                channels.push_back(std::move(up.second));
+            }
+            links = std::move(next_links);
+            senders = std::move(next_senders);
+        }
+    }
+
+    /** @brief 加法秘密分享的份额位宽 */
+    uint8_t share_bits(const mpmt::local_sim::config& cfg) noexcept
+    {
+        return cfg.m_share_bits == 0 ? cfg.m_ring_bits : cfg.m_share_bits;
+    }
+
+    void tally(mpmt::local_sim::report& out, bool member, bool found)
+    {
+        if (member)
+        {
+            (found ? out.m_true_positives : out.m_false_negatives) += 1;
+        }
+        else
+        {
+            (found ? out.m_false_positives : out.m_true_negatives) += 1;
+        }
+    }
+}
+
+mpmt::local_sim::local_sim(const config& cfg)
+    : mc_config(cfg)
+{
+    if (cfg.m_num_holders == 0 || cfg.m_num_slots == 0)
+    {
+        throw encode_exc
+        (
+            encode_exc::exc_type::INVALID_PARAMETER,
+            "local_sim requires at least one holder and a non-zero number of slots."
+        );
+    }
+    if (cfg.m_ring_bits != 8 && cfg.m_ring_bits != 16 && cfg.m_ring_bits != 32 && cfg.m_ring_bits != 64)
+    {
+        throw encode_exc
+        (
+            encode_exc::exc_type::INVALID_PARAMETER,
+            "local_sim ring width must be 8, 16, 32 or 64 bits, got " + std::to_string(cfg.m_ring_bits) + "."
+        );
+    }
+    if (cfg.m_share_bits > cfg.m_ring_bits)
+    {
+        throw encode_exc
+        (
+            encode_exc::exc_type::INVALID_PARAMETER,
+            "local_sim share width must not exceed the ring width, got " + std::to_string(cfg.m_share_bits) + "."
+        );
+    }
+    // 槽位计数为各持有方指示值之和，须在份额位宽（未指定时为环位宽）内不回绕
+    if (share_bits(cfg) < 64 && (uint64_t(1) << share_bits(cfg)) <= cfg.m_num_holders)
+    {
+        throw encode_exc
+        (
+            encode_exc::exc_type::INVALID_PARAMETER,
+            "local_sim cannot count " + std::to_string(cfg.m_num_holders) + " holder(s) in "
+            + std::to_string(share_bits(cfg)) + "-bit shares."
+        );
+    }
+    if (cfg.m_relay_fanin == 1)
+    {
+        throw encode_exc
+        (
+            encode_exc::exc_type::INVALID_PARAMETER,
+            "local_sim relay fan-in must be 0 (no relays) or at least 2."
+        );
+    }
+    if (cfg.m_num_shards > cfg.m_num_slots)
+    {
+        throw encode_exc
+        (
+            encode_exc::exc_type::INVALID_PARAMETER,
+            "local_sim cannot split " + std::to_string(cfg.m_num_slots) + " slot(s) into "
+            + std::to_string(cfg.m_num_shards) + " shard(s)."
+        );
+    }
+    if (cfg.m_backend == backend::RSS
+        && (cfg.m_serve_workers != 0 || cfg.m_relay_fanin != 0 || cfg.m_num_shards > 1 || cfg.m_open_batch > 1
+            || !cfg.m_union_path.empty() || !cfg.m_checkpoint_path.empty() || cfg.m_crash_after != 0
+            || cfg.m_share_bits != 0))
+    {
+        throw encode_exc
+        (
+            encode_exc::exc_type::INVALID_PARAMETER,
+            "local_sim rss backend supports neither serving workers, relays, shards, batching, saving, checkpoints nor share widths."
+        );
+    }
+    if (cfg.m_shard_processes
+        && (cfg.m_backend != backend::ASS || cfg.m_serve_workers != 0
+            || !cfg.m_union_path.empty() || !cfg.m_checkpoint_path.empty() || cfg.m_crash_after != 0))
+    {
+        throw encode_exc
+        (
+            encode_exc::exc_type::INVALID_PARAMETER,
+            "local_sim shard processes support neither the rss backend, serving workers, saving nor checkpoints."
+        );
+    }
+}
+
+mpmt::local_sim::report mpmt::local_sim::run() const
+{
+    if (mc_config.m_shard_processes)
+    {
+        switch (mc_config.m_ring_bits)
+        {
+        case 8:     return run_processes<ring8>();
+        case 16:    return run_processes<ring16>();
+        case 32:    return run_processes<ring32>();
+        default:    return run_processes<ring64>();
+        }
+    }
+    if (mc_config.m_backend == backend::RSS)
+    {
+        switch (mc_config.m_ring_bits)
+        {
+        case 8:     return run_rss<ring8>();
+        case 16:    return run_rss<ring16>();
+        case 32:    return run_rss<ring32>();
+        default:    return run_rss<ring64>();
+        }
+    }
+    switch (mc_config.m_ring_bits)
+    {
+    case 8:     return run_ring<ring8>();
+    case 16:    return run_ring<ring16>();
+    case 32:    return run_ring<ring32>();
+    default:    return run_ring<ring64>();
+    }
+}
+
+std::vector<mpmt::slot_indicator> mpmt::local_sim::encode_inputs(const credential_ingest& ingest) const
+{
+    std::vector<slot_indicator> inputs;
+    inputs.reserve(mc_config.m_num_holders);
+    for (uint32_t h = 0; h < mc_config.m_num_holders; ++h)
+    {
+        std::string text;
+        for (uint64_t j = 0; j < mc_config.m_set_size; ++j)
+        {
+            text += holder_credential(h, j);
+            text += '\n';
+        }
+        inputs.push_back(ingest.encode_buffer(text.data(), text.size()));
+    }
+    return inputs;
+}
+
+bool mpmt::local_sim::query_slots(const credential_ingest& ingest, uint64_t q, std::vector<uint64_t>& slots) const
+{
+    const bool c_member = (q % 2 == 0) && mc_config.m_set_size != 0;
+    const std::string credential = c_member
+        ? holder_credential(static_cast<uint32_t>(q % mc_config.m_num_holders), (q * 7919) % mc_config.m_set_size)
+        : "absent_" + std::to_string(q);
+    ingest.slots_of(credential.data(), credential.size(), slots.data());
+    return c_member;
+}
+
+template <typename RT>
+void mpmt::local_sim::query_batch
+(
+    const credential_ingest& ingest,
+    querier_ass<RT>& querier,
+    std::vector<uint64_t>& slots,
+    const std::vector<uint64_t>& batch,
+    report& out
+) const
+{
+    if (batch.size() == 1)
+    {
+        const bool c_member = query_slots(ingest, batch.front(), slots);
+        querier.set_query(slots);
+        querier.query();
+        tally(out, c_member, querier.result());
+        return;
+    }
+
+    // 同一批查询登记在一层，一轮通信后统一解析
+    open_queue<RT>& queue = querier.queue();
+    queue.clear();
+    std::vector<typename open_queue<RT>::ticket> tickets;
+    std::vector<bool> members;
+    for (const uint64_t c_q : batch)
+    {
+        members.push_back(query_slots(ingest, c_q, slots));
+        tickets.push_back(queue.defer(slots));
+    }
+    queue.flush();
+    for (uint64_t i = 0; i < batch.size(); ++i)
+    {
+        tally(out, members[i], queue.all_nonzero(tickets[i]));
+    }
+}
+
+template <typename RT>
+mpmt::local_sim::report mpmt::local_sim::run_ring() const
+{
+    report rep{};
+    const uint32_t c_holders = mc_config.m_num_holders;
+
+    // 1-持有方与查询方共享的哈希密钥（模拟中固定，保证结果可复现）
+    const hash_siphash hasher(sim_key());
+    const credential_ingest ingest
+    (
+        credential_ingest::config{ mc_config.m_num_slots, mc_config.m_ingest_threads, mc_config.m_num_hashes },
+        hasher
+    );
+
+    // 2-编码各持有方的凭据集合（保持位压缩，分享时由持有方逐块展开）
+    sim_clock::time_point start = sim_clock::now();
+    std::vector<slot_indicator> inputs = encode_inputs(ingest);
+    rep.m_encode_seconds = seconds_since(start);
+
+    // 3-可选的聚合树：逐层把至多m_relay_fanin个连接交给一个中继，直到代理方的连接数不超过扇入
+    const uint32_t c_shards = std::max<uint32_t>(1, mc_config.m_num_shards);
+    const shard_map c_map(mc_config.m_num_slots, c_shards);
+    using channel = std::unique_ptr<comm_inproc<RT>>;
+    std::vector<channel> relay_channels;
+    std::vector<std::unique_ptr<relay_ass<RT>>> relays;
+    auto build_tree = [&](ass_role role, std::vector<comm_adapter<RT>*>& links, std::vector<comm_inproc<RT>*>& senders)
+    {
+        build_relay_tree<RT, comm_inproc>(role, mc_config.m_relay_fanin, links, senders, relay_channels, relays);
+    };
+
+    // 4-建立进程内通道：每个持有方与每个分片的两个代理方各一条，经聚合树后得到各代理方的入口连接；
+    //   代理方从检查点恢复时整套重建（旧连接上的流量先计入报告）
+    std::vector<channel> dh_to_as0, as0_from_dh, dh_to_as1, as1_from_dh;
+    std::vector<std::vector<comm_adapter<RT>*>> as0_links(c_shards), as1_links(c_shards);
+    std::vector<comm_inproc<RT>*> ingress_senders;
+    auto count_traffic = [&]
+    {
+        for (const channel& sender : dh_to_as0)
+        {
+            rep.m_holder_upload_bytes += sender->bytes_sent();
+        }
+        for (const channel& sender : dh_to_as1)
+        {
+            rep.m_holder_upload_bytes += sender->bytes_sent();
+        }
+        for (const comm_inproc<RT>* sender : ingress_senders)
+        {
+            rep.m_agent_ingress_bytes += sender->bytes_sent();
+        }
+    };
+    auto connect = [&]
+    {
+        relays.clear();
+        relay_channels.clear();
+        ingress_senders.clear();
+        dh_to_as0.clear();
+        as0_from_dh.clear();
+        dh_to_as1.clear();
+        as1_from_dh.clear();
+        for (uint32_t s = 0; s < c_shards; ++s)
+        {
+            for (uint32_t h = 0; h < c_holders; ++h)
+            {
+                auto p0 = comm_inproc<RT>::make_pair();
+                auto p1 = comm_inproc<RT>::make_pair();
+                dh_to_as0.push_back(std::move(p0.first));
+                as0_from_dh.push_back(std::move(p0.second));
+                dh_to_as1.push_back(std::move(p1.first));
+                as1_from_dh.push_back(std::move(p1.second));
+            }
+        }
+        for (uint32_t s = 0; s < c_shards; ++s)
+        {
+            std::vector<comm_inproc<RT>*> as0_senders, as1_senders;
+            as0_links[s].clear();
+            as1_links[s].clear();
+            for (uint32_t h = 0; h < c_holders; ++h)
+            {
+                as0_links[s].push_back(as0_from_dh[s * c_holders + h].get());
+                as1_links[s].push_back(as1_from_dh[s * c_holders + h].get());
+                as0_senders.push_back(dh_to_as0[s * c_holders + h].get());
+                as1_senders.push_back(dh_to_as1[s * c_holders + h].get());
+            }
+            build_tree(ass_role::AS0, as0_links[s], as0_senders);
+            build_tree(ass_role::AS1, as1_links[s], as1_senders);
+            ingress_senders.insert(ingress_senders.end(), as0_senders.begin(), as0_senders.end());
+            ingress_senders.insert(ingress_senders.end(), as1_senders.begin(), as1_senders.end());
+        }
+        rep.m_num_relays = relays.size();
+    };
+    connect();
+
+    // 5-每个分片一对代理方，各自只接收本分片的份额；启用检查点时每个代理方各写一组检查点
+    std::vector<channel> q_as0, as0_from_q, q_as1, as1_from_q;
+    for (uint32_t s = 0; s < c_shards; ++s)
+    {
+        auto p0 = comm_inproc<RT>::make_pair();
+        auto p1 = comm_inproc<RT>::make_pair();
+        q_as0.push_back(std::move(p0.first));
+        as0_from_q.push_back(std::move(p0.second));
+        q_as1.push_back(std::move(p1.first));
+        as1_from_q.push_back(std::move(p1.second));
+    }
+    std::vector<std::unique_ptr<agent_ass<RT>>> as0, as1;
+    auto start_agents = [&]
+    {
+        as0.clear();
+        as1.clear();
+        for (uint32_t s = 0; s < c_shards; ++s)
+        {
+            as0.push_back(std::make_unique<agent_ass<RT>>(ass_role::AS0, as0_links[s], as0_from_q[s].get()));
+            as1.push_back(std::make_unique<agent_ass<RT>>(ass_role::AS1, as1_links[s], as1_from_q[s].get()));
+            as0.back()->set_cache_capacity(mc_config.m_cache_entries);
+            as1.back()->set_cache_capacity(mc_config.m_cache_entries);
+            as0.back()->set_blind_key(blind_key());
+            as1.back()->set_blind_key(blind_key());
+        }
+    };
+    start_agents();
+
+    auto checkpoint_path = [&](ass_role role, uint32_t s)
+    {
+        return mc_config.m_checkpoint_path + (role == ass_role::AS0 ? ".as0" : ".as1")
+            + (c_shards > 1 ? ".shard" + std::to_string(s) : std::string());
+    };
+    std::vector<std::unique_ptr<merge_checkpoint<RT>>> checkpoints;
+    auto flush_checkpoints = [&]
+    {
+        for (const std::unique_ptr<merge_checkpoint<RT>>& checkpoint : checkpoints)
+        {
+            checkpoint->wait();
+            rep.m_checkpoints_written += checkpoint->written();
+        }
+        checkpoints.clear();
+    };
+    auto attach_checkpoints = [&]
+    {
+        flush_checkpoints();
+        if (mc_config.m_checkpoint_path.empty())
+        {
+            return;
+        }
+        const typename merge_checkpoint<RT>::config c_config{ "", mc_config.m_checkpoint_interval };
+        for (uint32_t s = 0; s < c_shards; ++s)
+        {
+            for (agent_ass<RT>* agent : { as0[s].get(), as1[s].get() })
+            {
+                typename merge_checkpoint<RT>::config cfg = c_config;
+                cfg.m_path = checkpoint_path(agent->role(), s);
+                checkpoints.push_back(std::make_unique<merge_checkpoint<RT>>(cfg, agent->role()));
+                agent->set_checkpoint(checkpoints.back().get());
+            }
+        }
+    };
+    if (!mc_config.m_checkpoint_path.empty())
+    {
+        // 每次模拟都是一次新的合并，清除上一次遗留的清单
+        for (uint32_t s = 0; s < c_shards; ++s)
+        {
+            durable_file::remove(merge_checkpoint<RT>::manifest_path(checkpoint_path(ass_role::AS0, s)));
+            durable_file::remove(merge_checkpoint<RT>::manifest_path(checkpoint_path(ass_role::AS1, s)));
+        }
+    }
+    attach_checkpoints();
+
+    // 6-分享与合并：持有方、中继与各分片的代理方并发运行；
+    //   模拟崩溃时第m_crash_after个起的持有方断开连接，代理方在接收处中断，
+    //   随后重启代理方、从各自最近的检查点恢复，全部持有方经新连接重新发送相同的份额
+    std::vector<std::unique_ptr<data_holder_ass<RT>>> holders;
+    auto holder_links = [&](uint32_t h, std::vector<comm_adapter<RT>*>& to_as0, std::vector<comm_adapter<RT>*>& to_as1)
+    {
+        to_as0.clear();
+        to_as1.clear();
+        for (uint32_t s = 0; s < c_shards; ++s)
+        {
+            to_as0.push_back(dh_to_as0[s * c_holders + h].get());
+            to_as1.push_back(dh_to_as1[s * c_holders + h].get());
+        }
+    };
+    for (uint32_t h = 0; h < c_holders; ++h)
+    {
+        std::vector<comm_adapter<RT>*> to_as0, to_as1;
+        holder_links(h, to_as0, to_as1);
+        holders.push_back(std::make_unique<data_holder_ass<RT>>(c_map, to_as0, to_as1));
+        holders.back()->set_share_bits(share_bits(mc_config));
+        holders.back()->set_input(std::move(inputs[h]));
+    }
+    auto run_merge = [&](uint32_t c_live)
+    {
+        std::vector<std::thread> parties;
+        for (uint32_t h = 0; h < c_holders; ++h)
+        {
+            parties.emplace_back([&, h, c_live]
+            {
+                if (h < c_live)
+                {
+                    holders[h]->share();
+                    return;
+                }
+                for (uint32_t s = 0; s < c_shards; ++s)
+                {
+                    dh_to_as0[s * c_holders + h]->disconnect();
+                    dh_to_as1[s * c_holders + h]->disconnect();
+                }
+            });
+        }
+        for (std::unique_ptr<relay_ass<RT>>& relay : relays)
+        {
+            parties.emplace_back([&relay]
+            {
+                try
+                {
+                    relay->forward();
+                }
+                catch (const comm_exc&)
+                {
+                    // 中继已断开上游，由代理方报告中断
+                }
+            });
+        }
+        for (uint32_t s = 0; s < c_shards; ++s)
+        {
+            for (agent_ass<RT>* agent : { as0[s].get(), as1[s].get() })
+            {
+                parties.emplace_back([agent, s]
+                {
+                    try
+                    {
+                        agent->merge();
+                    }
+                    catch (const comm_exc&)
+                    {
+                        MPMT_LOG_WARN("agent merge interrupted", "shard", s, "role", static_cast<unsigned>(agent->role()));
+                    }
+                });
+            }
+        }
+        for (std::thread& th : parties)
+        {
+            th.join();
+        }
+    };
+
+    start = sim_clock::now();
+    const uint32_t c_crash_after = mc_config.m_crash_after;
+    if (c_crash_after != 0 && c_crash_after < c_holders)
+    {
+        run_merge(c_crash_after);
+        count_traffic();
+
+        // 代理方重启：内存中的累加器随崩溃丢失，仅能从检查点恢复
+        flush_checkpoints();
+        as0.clear();
+        as1.clear();
+        connect();
+        start_agents();
+        attach_checkpoints();
+        for (uint32_t s = 0; s < c_shards && !mc_config.m_checkpoint_path.empty(); ++s)
+        {
+            for (agent_ass<RT>* agent : { as0[s].get(), as1[s].get() })
+            {
+                std::optional<typename merge_checkpoint<RT>::resume_point> point
+                    = merge_checkpoint<RT>::load(checkpoint_path(agent->role(), s), agent->role());
+                if (point)
+                {
+                    ++rep.m_resumed_agents;
+                    agent->resume(std::move(*point));
+                }
+            }
+        }
+        for (uint32_t h = 0; h < c_holders; ++h)
+        {
+            std::vector<comm_adapter<RT>*> to_as0, to_as1;
+            holder_links(h, to_as0, to_as1);
+            holders[h]->set_connections(to_as0, to_as1);
+        }
+    }
+    run_merge(c_holders);
+    rep.m_merge_seconds = seconds_since(start);
+    MPMT_LOG_INFO("local merge finished", "holders", c_holders, "shards", c_shards, "relays", rep.m_num_relays, "seconds", rep.m_merge_seconds);
+    count_traffic();
+    flush_checkpoints();
+
+    // 7-可选的持久化：每个分片的每个代理方各写一个mrvf文件
+    const typename mrvf_handler<RT>::config c_mrvf_config{ false, false };
+    auto union_path = [&](ass_role role, uint32_t s)
+    {
+        const std::string c_path = mc_config.m_union_path + (role == ass_role::AS0 ? ".as0.mrvf" : ".as1.mrvf");
+        return c_shards > 1 ? shard_map::path_of(c_path, s) : c_path;
+    };
+    if (!mc_config.m_union_path.empty())
+    {
+        mrvf_handler<RT> handler(c_mrvf_config);
+        for (uint32_t s = 0; s < c_shards; ++s)
+        {
+            handler.save(union_path(ass_role::AS0, s), mrvf<RT>(rvector<RT>(as0[s]->union_share())));
+            handler.save(union_path(ass_role::AS1, s), mrvf<RT>(rvector<RT>(as1[s]->union_share())));
+        }
+        MPMT_LOG_INFO("union shares saved", "shards", c_shards);
+    }
+
+    // 8-查询：一半查询取自持有方集合，一半为不存在的凭据
+    const uint64_t c_queries = mc_config.m_num_queries;
+    const uint64_t c_batch = std::max<uint64_t>(1, mc_config.m_open_batch);
+    auto slots_of = [&](std::vector<uint64_t>& slots, uint64_t q)
+    {
+        return query_slots(ingest, q, slots);
+    };
+
+    // 把第first个起、步长为step的查询按c_batch个一批依次执行，返回轮数
+    auto run_queries = [&](querier_ass<RT>& querier, uint64_t first, uint64_t step, report& out)
+    {
+        std::vector<uint64_t> slots(ingest.num_hashes());
+        std::vector<uint64_t> batch;
+        uint64_t rounds = 0;
+        for (uint64_t q = first; q < c_queries; q += step)
+        {
+            batch.push_back(q);
+            if (batch.size() == c_batch || q + step >= c_queries)
+            {
+                query_batch(ingest, querier, slots, batch, out);
+                batch.clear();
+                ++rounds;
+            }
+        }
+        return rounds;
+    };
+
+    start = sim_clock::now();
+    if (mc_config.m_serve_workers == 0)
+    {
+        // 各代理方线程逐轮响应直至查询方断开（不含查询槽位的分片不参与该轮），查询方在当前线程发起
+        std::vector<std::thread> serving;
+        for (uint32_t s = 0; s < c_shards; ++s)
+        {
+            for (agent_ass<RT>* agent : { as0[s].get(), as1[s].get() })
+            {
+                serving.emplace_back([agent]
+                {
+                    utils::stack_tracer::install_thread_alt_stack();
+                    serve_until_closed(*agent);
+                });
+            }
+        }
+
+        std::vector<comm_adapter<RT>*> to_as0, to_as1;
+        for (uint32_t s = 0; s < c_shards; ++s)
+        {
+            to_as0.push_back(q_as0[s].get());
+            to_as1.push_back(q_as1[s].get());
+        }
+        querier_ass<RT> querier(c_map, to_as0, to_as1);
+        querier.queue().set_share_bits(share_bits(mc_config));
+        rep.m_rounds = run_queries(querier, 0, 1, rep);
+        for (uint32_t s = 0; s < c_shards; ++s)
+        {
+            to_as0[s]->disconnect();
+            to_as1[s]->disconnect();
+        }
+        for (std::thread& th : serving)
+        {
+            th.join();
+        }
+        for (uint32_t s = 0; s < c_shards; ++s)
+        {
+            rep.m_cache_hits += as0[s]->cache().hits();
+        }
+    }
+    else
+    {
+        // 每个分片的代理方以工作线程池并发响应，每个查询方线程持有到各分片各代理方的会话；
+        // 已持久化时由分片文件建立快照，否则接管合并结果的副本
+        const typename agent_server<RT>::config c_server_config
+        {
+            mc_config.m_serve_workers,
+            mc_config.m_cache_entries,
+            numa_memory::active() != numa_policy::OFF,
+            blind_key()
+        };
+        auto snapshot_of = [&](const agent_ass<RT>& agent, uint32_t s)
+        {
+            return mc_config.m_union_path.empty()
+                ? union_snapshot<RT>::adopt(rvector<RT>(agent.union_share()))
+                : union_snapshot<RT>::map(union_path(agent.role(), s), c_mrvf_config);
+        };
+        std::vector<std::unique_ptr<agent_server<RT>>> server0, server1;
+        for (uint32_t s = 0; s < c_shards; ++s)
+        {
+            server0.push_back(std::make_unique<agent_server<RT>>(c_server_config, snapshot_of(*as0[s], s)));
+            server1.push_back(std::make_unique<agent_server<RT>>(c_server_config, snapshot_of(*as1[s], s)));
+        }
+
+        const unsigned c_clients = mc_config.m_query_clients == 0 ? 1 : mc_config.m_query_clients;
+        std::vector<channel> q_to_as0, as0_from_q, q_to_as1, as1_from_q;
+        for (unsigned c = 0; c < c_clients; ++c)
+        {
+            for (uint32_t s = 0; s < c_shards; ++s)
+            {
+                auto p0 = comm_inproc<RT>::make_pair();
+                auto p1 = comm_inproc<RT>::make_pair();
+                q_to_as0.push_back(std::move(p0.first));
+                as0_from_q.push_back(std::move(p0.second));
+                q_to_as1.push_back(std::move(p1.first));
+                as1_from_q.push_back(std::move(p1.second));
+                server0[s]->serve(*as0_from_q.back());
+                server1[s]->serve(*as1_from_q.back());
+            }
+        }
+
+        // 查询方会话以协程运行在少量线程上：等待份额时挂起，线程数不随查询方数增长
+        std::mutex rep_mutex;
+        std::exception_ptr session_failure;     // 首个失败会话的异常
+        const unsigned c_hw = std::max(1u, std::thread::hardware_concurrency());
+        coro_pool client_pool(coro_pool::config{ std::min(c_clients, c_hw) });
+        auto client_session = [&](unsigned c) -> coro_task<void>
+        {
+            report local{};
+            std::vector<comm_adapter<RT>*> to_as0, to_as1;
+            for (uint32_t s = 0; s < c_shards; ++s)
+            {
+                to_as0.push_back(q_to_as0[c * c_shards + s].get());
+                to_as1.push_back(q_to_as1[c * c_shards + s].get());
+            }
+            // 会话失败时记录异常并照常断开，使代理方的服务结束；结束后由调用线程重新抛出
+            std::exception_ptr failure;
+            try
+            {
+                querier_ass<RT> querier(c_map, to_as0, to_as1);
+                querier.queue().set_share_bits(share_bits(mc_config));
+
+                // 与run_queries()相同的分批，每批一轮，等待份额时挂起
+                std::vector<uint64_t> slots(ingest.num_hashes());
+                std::vector<uint64_t> batch;
+                for (uint64_t q = c; q < c_queries; q += c_clients)
+                {
+                    batch.push_back(q);
+                    if (batch.size() != c_batch && q + c_clients < c_queries)
+                    {
+                        continue;
+                    }
+                    if (batch.size() == 1)
+                    {
+                        const bool c_member = slots_of(slots, batch.front());
+                        querier.set_query(slots);
+                        co_await querier.query_async(client_pool);
+                        tally(local, c_member, querier.result());
+                    }
+                    else
+                    {
+                        open_queue<RT>& queue = querier.queue();
+                        queue.clear();
+                        std::vector<typename open_queue<RT>::ticket> tickets;
+                        std::vector<bool> members;
+                        for (const uint64_t c_q : batch)
+                        {
+                            members.push_back(slots_of(slots, c_q));
+                            tickets.push_back(queue.defer(slots));
+                        }
+                        queue.send();
+                        co_await queue.receive_async(client_pool);
+                        for (uint64_t i = 0; i < batch.size(); ++i)
+                        {
+                            tally(local, members[i], queue.all_nonzero(tickets[i]));
+                        }
+                    }
+                    batch.clear();
+                    ++local.m_rounds;
+                }
+            }
+            catch (...)
+            {
+                failure = std::current_exception();
+            }
+            for (uint32_t s = 0; s < c_shards; ++s)
+            {
+                to_as0[s]->disconnect();
+                to_as1[s]->disconnect();
+            }
+
+            std::lock_guard<std::mutex> lock(rep_mutex);
+            if (failure && !session_failure)
+            {
+                session_failure = failure;
+            }
+            rep.m_true_positives += local.m_true_positives;
+            rep.m_false_negatives += local.m_false_negatives;
+            rep.m_false_positives += local.m_false_positives;
+            rep.m_true_negatives += local.m_true_negatives;
+            rep.m_rounds += local.m_rounds;
+        };
+        for (unsigned c = 0; c < c_clients; ++c)
+        {
+            client_pool.spawn(client_session(c));
+        }
+        client_pool.wait_idle();
+        for (uint32_t s = 0; s < c_shards; ++s)
+        {
+            server0[s]->wait_idle();
+            server1[s]->wait_idle();
+            rep.m_cache_hits += server0[s]->cache_hits();
+        }
+        if (session_failure)
+        {
+            std::rethrow_exception(session_failure);
+        }
+        const uint64_t c_tallied = rep.m_true_positives + rep.m_false_negatives + rep.m_false_positives + rep.m_true_negatives;
+        if (c_tallied != c_queries)
+        {
+            throw protocol_exc
+            (
+                protocol_exc::exc_type::INVALID_STATE,
+                "query clients answered " + std::to_string(c_tallied) + " of " + std::to_string(c_queries) + " queries."
+            );
+        }
+    }
+    rep.m_query_seconds = seconds_since(start);
+    MPMT_LOG_INFO("local queries finished", "queries", c_queries, "rounds", rep.m_rounds, "seconds", rep.m_query_seconds);
+
+    return rep;
+}
+
+template <typename RT>
+mpmt::local_sim::report mpmt::local_sim::run_rss() const
+{
+    report rep{};
+    const uint32_t c_holders = mc_config.m_num_holders;
+
+    // 1-编码各持有方的凭据集合，与加法秘密分享后端相同
+    const hash_siphash hasher(sim_key());
+    const credential_ingest ingest
+    (
+        credential_ingest::config{ mc_config.m_num_slots, mc_config.m_ingest_threads, mc_config.m_num_hashes },
+        hasher
+    );
+    sim_clock::time_point start = sim_clock::now();
+    std::vector<slot_indicator> inputs = encode_inputs(ingest);
+    rep.m_encode_seconds = seconds_since(start);
+
+    // 2-建立进程内通道：每个持有方与三个代理方各一条，查询方与三个代理方各一条，代理方两两成环
+    using channel = std::unique_ptr<comm_inproc<RT>>;
+    std::vector<channel> dh_to_p, p_from_dh;
+    std::vector<channel> q_to_p, p_from_q;
+    std::vector<channel> ring_next, ring_prev;
+    for (uint32_t h = 0; h < c_holders; ++h)
+    {
+        for (uint8_t i = 0; i < c_RSS_PARTIES; ++i)
+        {
+            auto p = comm_inproc<RT>::make_pair();
+            dh_to_p.push_back(std::move(p.first));
+            p_from_dh.push_back(std::move(p.second));
+        }
+    }
+    for (uint8_t i = 0; i < c_RSS_PARTIES; ++i)
+    {
+        auto q = comm_inproc<RT>::make_pair();
+        q_to_p.push_back(std::move(q.first));
+        p_from_q.push_back(std::move(q.second));
+        auto r = comm_inproc<RT>::make_pair();      // Pi经first连接Pi+1，Pi+1经second连接Pi
+        ring_next.push_back(std::move(r.first));
+        ring_prev.push_back(std::move(r.second));
+    }
+    std::vector<std::unique_ptr<agent_rss<RT>>> agents;
+    for (uint8_t i = 0; i < c_RSS_PARTIES; ++i)
+    {
+        std::vector<comm_adapter<RT>*> links;
+        for (uint32_t h = 0; h < c_holders; ++h)
+        {
+            links.push_back(p_from_dh[h * c_RSS_PARTIES + i].get());
+        }
+        const uint8_t c_prev = static_cast<uint8_t>(rss_prev(static_cast<rss_role>(i)));
+        agents.push_back(std::make_unique<agent_rss<RT>>
+        (
+            static_cast<rss_role>(i), links, p_from_q[i].get(), ring_next[i].get(), ring_prev[c_prev].get()
+        ));
+        agents.back()->set_blind_key(blind_key());
+    }
+
+    // 3-分享与合并：持有方与三个代理方并发运行
+    start = sim_clock::now();
+    {
+        std::vector<std::thread> parties;
+        for (uint32_t h = 0; h < c_holders; ++h)
+        {
+            parties.emplace_back([&, h]
+            {
+                data_holder_rss<RT> holder
+                (
+                    *dh_to_p[h * c_RSS_PARTIES], *dh_to_p[h * c_RSS_PARTIES + 1], *dh_to_p[h * c_RSS_PARTIES + 2]
+                );
+                holder.set_input(std::move(inputs[h]));
+                holder.share();
+            });
+        }
+        for (std::unique_ptr<agent_rss<RT>>& agent : agents)
+        {
+            parties.emplace_back([&agent] { agent->merge(); });
+        }
+        for (std::thread& th : parties)
+        {
+            th.join();
+        }
+    }
+    rep.m_merge_seconds = seconds_since(start);
+    MPMT_LOG_INFO("local rss merge finished", "holders", c_holders, "seconds", rep.m_merge_seconds);
+    for (const channel& sender : dh_to_p)
+    {
+        rep.m_holder_upload_bytes += sender->bytes_sent();
+    }
+    rep.m_agent_ingress_bytes = rep.m_holder_upload_bytes;
+
+    // 4-查询：三个代理方线程逐次响应，查询方在当前线程发起
+    const uint64_t c_queries = mc_config.m_num_queries;
+    start = sim_clock::now();
+    std::vector<std::thread> serving;
+    for (std::unique_ptr<agent_rss<RT>>& agent : agents)
+    {
+        serving.emplace_back([&agent, c_queries]
+        {
+            utils::stack_tracer::install_thread_alt_stack();
+            for (uint64_t q = 0; q < c_queries; ++q)
+            {
+                agent->reveal();
+            }
+        });
+    }
+    querier_rss<RT> querier(*q_to_p[0], *q_to_p[1], *q_to_p[2]);
+    std::vector<uint64_t> slots(ingest.num_hashes());
+    for (uint64_t q = 0; q < c_queries; ++q)
+    {
+        const bool c_member = query_slots(ingest, q, slots);
+        querier.set_query(slots);
+        querier.query();
+        tally(rep, c_member, querier.result());
+    }
+    for (std::thread& th : serving)
+    {
+        th.join();
+    }
+    rep.m_rounds = c_queries;
+    rep.m_query_seconds = seconds_since(start);
+    MPMT_LOG_INFO("local rss queries finished", "queries", c_queries, "seconds", rep.m_query_seconds);
+
+    return rep;
+}
+
+template <typename RT>
+mpmt::local_sim::report mpmt::local_sim::run_processes() const
+{
+#if defined(_WIN32)
+    throw encode_exc(encode_exc::exc_type::INVALID_PARAMETER, "local_sim shard processes require a POSIX host.");
+#else
+    report rep{};
+    const uint32_t c_holders = mc_config.m_num_holders;
+
+    // 1-编码各持有方的凭据集合，与进程内模拟相同
+    const hash_siphash hasher(sim_key());
+    const credential_ingest ingest
+    (
+        credential_ingest::config{ mc_config.m_num_slots, mc_config.m_ingest_threads, mc_config.m_num_hashes },
+        hasher
+    );
+    sim_clock::time_point start = sim_clock::now();
+    std::vector<slot_indicator> inputs = encode_inputs(ingest);
+    rep.m_encode_seconds = seconds_since(start);
+
+    // 2-在fork()之前建立全部套接字对：每个持有方与每个分片的两个代理方各一条，查询方与每个代理方各一条
+    const uint32_t c_shards = std::max<uint32_t>(1, mc_config.m_num_shards);
+    const shard_map c_map(mc_config.m_num_slots, c_shards);
+    using channel = std::unique_ptr<comm_pipe<RT>>;
+    std::vector<channel> dh_to_as0, as0_from_dh, dh_to_as1, as1_from_dh;
+    std::vector<channel> q_as0, as0_from_q, q_as1, as1_from_q;
+    for (uint32_t s = 0; s < c_shards; ++s)
+    {
+        for (uint32_t h = 0; h < c_holders; ++h)
+        {
+            auto p0 = comm_pipe<RT>::make_pair();
+            auto p1 = comm_pipe<RT>::make_pair();
+            dh_to_as0.push_back(std::move(p0.first));
+            as0_from_dh.push_back(std::move(p0.second));
+            dh_to_as1.push_back(std::move(p1.first));
+            as1_from_dh.push_back(std::move(p1.second));
+        }
+        auto q0 = comm_pipe<RT>::make_pair();
+        auto q1 = comm_pipe<RT>::make_pair();
+        q_as0.push_back(std::move(q0.first));
+        as0_from_q.push_back(std::move(q0.second));
+        q_as1.push_back(std::move(q1.first));
+        as1_from_q.push_back(std::move(q1.second));
+    }
+
+    // 3-可选的聚合树：中继在父进程中以线程运行，经套接字对与下游相连，树根一层的连接交给分片进程
+    std::vector<channel> relay_channels;
+    std::vector<std::unique_ptr<relay_ass<RT>>> relays;
+    std::vector<std::vector<comm_adapter<RT>*>> links0(c_shards), links1(c_shards);
+    std::vector<comm_pipe<RT>*> ingress_senders;
+    for (uint32_t s = 0; s < c_shards; ++s)
+    {
+        std::vector<comm_pipe<RT>*> senders0, senders1;
+        for (uint32_t h = 0; h < c_holders; ++h)
+        {
+            links0[s].push_back(as0_from_dh[s * c_holders + h].get());
+            links1[s].push_back(as1_from_dh[s * c_holders + h].get());
+            senders0.push_back(dh_to_as0[s * c_holders + h].get());
+            senders1.push_back(dh_to_as1[s * c_holders + h].get());
+        }
+        build_relay_tree<RT, comm_pipe>(ass_role::AS0, mc_config.m_relay_fanin, links0[s], senders0, relay_channels, relays);
+        build_relay_tree<RT, comm_pipe>(ass_role::AS1, mc_config.m_relay_fanin, links1[s], senders1, relay_channels, relays);
+        ingress_senders.insert(ingress_senders.end(), senders0.begin(), senders0.end());
+        ingress_senders.insert(ingress_senders.end(), senders1.begin(), senders1.end());
+    }
+    rep.m_num_relays = relays.size();
+
+    // 分片s的代理方使用的端点：树根一层的入口连接与查询方连接
+    auto agent_end = [&](uint32_t s, const comm_adapter<RT>* end)
+    {
+        return end == as0_from_q[s].get() || end == as1_from_q[s].get()
+            || std::find(links0[s].begin(), links0[s].end(), end) != links0[s].end()
+            || std::find(links1[s].begin(), links1[s].end(), end) != links1[s].end();
+    };
+    auto close_ends = [&](const std::function<bool(const comm_adapter<RT>*)>& pred)
+    {
+        for (std::vector<channel>* group : { &dh_to_as0, &as0_from_dh, &dh_to_as1, &as1_from_dh,
+            &q_as0, &as0_from_q, &q_as1, &as1_from_q, &relay_channels })
+        {
+            for (channel& end : *group)
+            {
+                if (end != nullptr && pred(end.get()))
+                {
+                    end.reset();
+                }
+            }
+        }
+    };
+
+    // 4-每个分片fork一个代理方进程，AS0与AS1在其中各占一个线程：合并后回报并集长度，逐次响应查询直至查询方断开，
+    //   最后回报缓存命中次数；子进程只保留本分片代理方一端的描述符，以_exit()退出，不运行父进程的析构
+    auto run_pair = [&](uint32_t s)
+    {
+        relays.clear();
+        close_ends([&](const comm_adapter<RT>* end) { return !agent_end(s, end); });
+
+        std::atomic<bool> failed{ false };
+        auto serve = [&failed, this](ass_role role, const std::vector<comm_adapter<RT>*>& links, comm_pipe<RT>& querier)
+        {
+            utils::stack_tracer::install_thread_alt_stack();
+            try
+            {
+                agent_ass<RT> agent(role, links, &querier);
+                agent.set_cache_capacity(mc_config.m_cache_entries);
+                agent.set_blind_key(blind_key());
+                agent.merge();
+                ass_wire::send_u64(querier, agent.union_share().size());
+                serve_until_closed(agent);
+                ass_wire::send_u64(querier, agent.cache().hits());
+            }
+            catch (const std::exception&)
+            {
+                failed.store(true);
+            }
+        };
+        std::thread as1_thread(serve, ass_role::AS1, std::cref(links1[s]), std::ref(*as1_from_q[s]));
+        serve(ass_role::AS0, links0[s], *as0_from_q[s]);
+        as1_thread.join();
+        ::_exit(failed.load() ? 1 : 0);
+    };
+    child_reaper children;
+    for (uint32_t s = 0; s < c_shards; ++s)
+    {
+        const pid_t c_pid = ::fork();
+        if (c_pid < 0)
+        {
+            throw encode_exc(encode_exc::exc_type::INVALID_PARAMETER, "local_sim cannot fork the process of shard " + std::to_string(s) + ".");
+        }
+        if (c_pid == 0)
+        {
+            run_pair(s);
+        }
+        children.m_pids.push_back(c_pid);
+
+        // 父进程关闭本分片代理方一端的副本，之后fork的子进程不再继承，子进程退出时查询方能读到连接关闭
+        close_ends([&](const comm_adapter<RT>* end) { return agent_end(s, end); });
+    }
+
+    // 5-分享与合并：持有方与中继以线程运行，合并完成以各代理方回报的并集长度为准
+    start = sim_clock::now();
+    {
+        std::vector<std::thread> parties;
+        std::atomic<bool> failed{ false };
+        for (uint32_t h = 0; h < c_holders; ++h)
+        {
+            parties.emplace_back([&, h]
+            {
+                std::vector<comm_adapter<RT>*> to_as0, to_as1;
+                for (uint32_t s = 0; s < c_shards; ++s)
+                {
+                    to_as0.push_back(dh_to_as0[s * c_holders + h].get());
+                    to_as1.push_back(dh_to_as1[s * c_holders + h].get());
+                }
+                try
+                {
+                    data_holder_ass<RT> holder(c_map, to_as0, to_as1);
+                    holder.set_share_bits(share_bits(mc_config));
+                    holder.set_input(std::move(inputs[h]));
+                    holder.share();
+                }
+                catch (const std::exception&)
+                {
+                    failed.store(true);
+                }
+            });
+        }
+        for (std::unique_ptr<relay_ass<RT>>& relay : relays)
+        {
+            parties.emplace_back([&relay, &failed]
+            {
+                try
+                {
+                    relay->forward();
+                }
+                catch (const std::exception&)
+                {
+                    failed.store(true);
+                }
+            });
+        }
+        for (std::thread& th : parties)
+        {
+            th.join();
+        }
+        if (failed.load())
+        {
+            throw comm_exc(comm_exc::exc_type::CONNECTION_CLOSED, "a data holder or relay lost its connection to a shard process.");
+        }
+    }
+    for (uint32_t s = 0; s < c_shards; ++s)
+    {
+        for (comm_pipe<RT>* link : { q_as0[s].get(), q_as1[s].get() })
+        {
+            const uint64_t c_size = ass_wire::receive_u64(*link);
+            if (c_size != c_map.count(s))
+            {
+                throw protocol_exc
+                (
+                    protocol_exc::exc_type::MESSAGE_CORRUPTION,
+                    "shard " + std::to_string(s) + " merged " + std::to_string(c_size) + " slot(s), expected "
+                    + std::to_string(c_map.count(s)) + "."
+                );
+            }
+        }
+    }
+    rep.m_merge_seconds = seconds_since(start);
+    MPMT_LOG_INFO("shard processes merged", "holders", c_holders, "shards", c_shards, "seconds", rep.m_merge_seconds);
+    for (const channel& sender : dh_to_as0)
+    {
+        rep.m_holder_upload_bytes += sender->bytes_sent();
+    }
+    for (const channel& sender : dh_to_as1)
+    {
+        rep.m_holder_upload_bytes += sender->bytes_sent();
+    }
+    for (const comm_pipe<RT>* sender : ingress_senders)
+    {
+        rep.m_agent_ingress_bytes += sender->bytes_sent();
+    }
+
+    // 6-查询：查询方在当前线程按批发起，完毕后断开，代理方进程回报缓存命中次数后退出
+    const uint64_t c_queries = mc_config.m_num_queries;
+    const uint64_t c_batch = std::max<uint64_t>(1, mc_config.m_open_batch);
+    start = sim_clock::now();
+    std::vector<comm_adapter<RT>*> to_as0, to_as1;
+    for (uint32_t s = 0; s < c_shards; ++s)
+    {
+        to_as0.push_back(q_as0[s].get());
+        to_as1.push_back(q_as1[s].get());
+    }
+    querier_ass<RT> querier(c_map, to_as0, to_as1);
+    querier.queue().set_share_bits(share_bits(mc_config));
+    std::vector<uint64_t> slots(ingest.num_hashes());
+    std::vector<uint64_t> batch;
+    for (uint64_t q = 0; q < c_queries; ++q)
+    {
+        batch.push_back(q);
+        if (batch.size() == c_batch || q + 1 == c_queries)
+        {
+            query_batch(ingest, querier, slots, batch, rep);
+            batch.clear();
+            ++rep.m_rounds;
+        }
+    }
+    for (uint32_t s = 0; s < c_shards; ++s)
+    {
+        q_as0[s]->disconnect();
+        q_as1[s]->disconnect();
+        rep.m_cache_hits += ass_wire::receive_u64(*q_as0[s]);
+        ass_wire::receive_u64(*q_as1[s]);
+    }
+    rep.m_query_seconds = seconds_since(start);
+    if (!children.wait_all())
+    {
+        throw comm_exc(comm_exc::exc_type::CONNECTION_CLOSED, "a shard process exited abnormally.");
+    }
+    MPMT_LOG_INFO("shard process queries finished", "queries", c_queries, "rounds", rep.m_rounds, "seconds", rep.m_query_seconds);
+
+    return rep;
+#endif
+}
+
+std::string mpmt::local_sim::format(const report& rep) const
+{
+    std::ostringstream os;
+    os << "holders=" << mc_config.m_num_holders
+        << " set_size=" << mc_config.m_set_size
+        << " slots=" << mc_config.m_num_slots
+        << " k=" << static_cast<int>(mc_config.m_num_hashes)
+        << " ring=Z_{2^" << static_cast<int>(mc_config.m_ring_bits) << "}"
+        << " vcb=" << vcb_dispatch::name(vcb_dispatch::active())
+        << " numa=" << numa_memory::name(numa_memory::active());
+    if (mc_config.m_backend == backend::RSS)
+    {
+        os << " backend=rss";
+    }
+    if (mc_config.m_serve_workers != 0)
+    {
+        os << " serve_workers=" << mc_config.m_serve_workers
+            << " clients=" << (mc_config.m_query_clients == 0 ? 1 : mc_config.m_query_clients);
+    }
+    if (mc_config.m_num_shards > 1)
+    {
+        os << " shards=" << mc_config.m_num_shards;
+    }
+    if (mc_config.m_shard_processes)
+    {
+        os << " shard_processes";
+    }
+    if (mc_config.m_share_bits != 0)
+    {
+        os << " share_bits=" << static_cast<int>(mc_config.m_share_bits);
+    }
+    if (mc_config.m_relay_fanin != 0)
+    {
+        os << " relay_fanin=" << mc_config.m_relay_fanin << " relays=" << rep.m_num_relays;
+    }
+    if (!mc_config.m_checkpoint_path.empty())
+    {
+        os << " checkpoints=" << rep.m_checkpoints_written;
+    }
+    if (mc_config.m_crash_after != 0 && mc_config.m_crash_after < mc_config.m_num_holders)
+    {
+        os << " crash_after=" << mc_config.m_crash_after << " resumed_agents=" << rep.m_resumed_agents;
+    }
+    os << "\n"
+        << "  encode : " << rep.m_encode_seconds << " s\n"
+        << "  merge  : " << rep.m_merge_seconds << " s, holder upload "
+        << rep.m_holder_upload_bytes << " byte(s), agent ingress " << rep.m_agent_ingress_bytes << " byte(s)\n"
+        << "  query  : " << rep.m_query_seconds << " s for " << mc_config.m_num_queries << " quer(ies) in "
+        << rep.m_rounds << " round(s)";
+    if (rep.m_query_seconds > 0)
+    {
+        os << ", " << mc_config.m_num_queries / rep.m_query_seconds << " q/s";
+    }
+    if (mc_config.m_cache_entries != 0)
+    {
+        os << ", cache hits " << rep.m_cache_hits;
+    }
+    os << "\n"
+        << "  result : TP=" << rep.m_true_positives
+        << " FN=" << rep.m_false_negatives
+        << " FP=" << rep.m_false_positives
+        << " TN=" << rep.m_true_negatives;
+    return os.str();
+}
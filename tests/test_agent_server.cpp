@@ -0,0 +1,130 @@
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "core/comm/inproc_impl/comm_inproc.hpp"
+#include "core/protocol/ass_impl/agent_server.hpp"
+#include "core/protocol/ass_impl/ass_wire.hpp"
+#include "core/protocol/ass_impl/union_snapshot.hpp"
+
+/**
+ * @brief   agent_server快照交接的并发测试
+ * @note    发布线程不断publish()新快照，多个查询方同时查询；第v个快照的所有槽位均为v，
+ *          因此一次响应的全部份额须相同（只看到完整的某个快照），同一会话看到的版本单调不减。
+ *          旧快照在宽限期后释放，在ThreadSanitizer或AddressSanitizer下运行可检查读取与释放之间的竞争。
+ */
+namespace
+{
+    using ring = mpmt::ring32;
+
+    constexpr uint64_t c_SLOTS = 4096;
+
+    std::unique_ptr<mpmt::union_snapshot<ring>> snapshot(ring version)
+    {
+        return mpmt::union_snapshot<ring>::adopt(mpmt::rvector<ring>(c_SLOTS, version));
+    }
+
+    /** @brief 发送一个令牌并接收响应 */
+    std::vector<ring> ask(mpmt::comm_adapter<ring>& comm, const std::vector<uint64_t>& slots)
+    {
+        mpmt::ass_wire::send_token
+        (
+            comm,
+            mpmt::ass_wire::encode_bytes<ring>(reinterpret_cast<const uint8_t*>(slots.data()), slots.size() * sizeof(uint64_t))
+        );
+        std::vector<ring> reply;
+        comm.receive(reply);
+        return reply;
+    }
+
+    void run_concurrent_update_and_query(uint64_t cache_entries)
+    {
+        const uint32_t c_clients = 4;
+        const uint32_t c_queries = 300;
+
+        mpmt::agent_server<ring> server({ 2, cache_entries }, snapshot(1));
+        std::vector<std::unique_ptr<mpmt::comm_inproc<ring>>> clients;
+        std::vector<std::unique_ptr<mpmt::comm_inproc<ring>>> sessions;
+        for (uint32_t c = 0; c < c_clients; ++c)
+        {
+            auto [client, session] = mpmt::comm_inproc<ring>::make_pair();
+            server.serve(*session);
+            clients.push_back(std::move(client));
+            sessions.push_back(std::move(session));
+        }
+
+        std::atomic<uint32_t> finished{ 0 };
+        std::atomic<bool> torn{ false };
+        std::atomic<bool> regressed{ false };
+        std::vector<std::thread> queriers;
+        for (uint32_t c = 0; c < c_clients; ++c)
+        {
+            queriers.emplace_back([&, c]
+            {
+                ring last = 0;
+                for (uint32_t q = 0; q < c_queries; ++q)
+                {
+                    // 少量重复的令牌使查询缓存跨纪元命中与清空
+                    const uint64_t c_base = (q % 8) * 61 + c;
+                    const std::vector<ring> c_reply = ask(*clients[c], { c_base, c_base + 1000, c_base + 3000 });
+                    if (c_reply.size() != 3 || c_reply[0] != c_reply[1] || c_reply[1] != c_reply[2])
+                    {
+                        torn.store(true);
+                        return;
+                    }
+                    if (c_reply[0] < last)
+                    {
+                        regressed.store(true);
+                    }
+                    last = c_reply[0];
+                }
+                finished.fetch_add(1);
+            });
+        }
+
+        // 查询进行期间持续发布新快照
+        ring latest = 1;
+        std::thread publisher([&]
+        {
+            while (finished.load() < c_clients)
+            {
+                server.publish(snapshot(++latest));
+                std::this_thread::yield();
+            }
+        });
+        for (std::thread& t : queriers)
+        {
+            t.join();
+        }
+        publisher.join();
+        const ring c_versions = latest;
+        EXPECT_FALSE(torn.load());
+        EXPECT_FALSE(regressed.load());
+        EXPECT_GT(c_versions, 1u);
+        EXPECT_EQ(server.epoch(), static_cast<uint64_t>(c_versions));
+
+        // 发布结束后的查询只看到最后一个快照
+        for (uint32_t c = 0; c < c_clients; ++c)
+        {
+            EXPECT_EQ(ask(*clients[c], { 5, 6 }), std::vector<ring>(2, c_versions));
+        }
+
+        // 计数在响应发出后才累加，会话结束后再核对
+        clients.clear();
+        server.wait_idle();
+        EXPECT_EQ(server.answered(), static_cast<uint64_t>(c_clients) * (c_queries + 1));
+    }
+
+    TEST(agent_server, concurrent_publish_and_query_see_whole_snapshots)
+    {
+        run_concurrent_update_and_query(0);
+    }
+
+    TEST(agent_server, cached_replies_never_outlive_their_snapshot)
+    {
+        run_concurrent_update_and_query(16);
+    }
+}
@@ -0,0 +1,155 @@
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "core/comm/comm_packer.hpp"
+#include "core/comm/inproc_impl/comm_inproc.hpp"
+#include "core/exception/protocol_exc.hpp"
+#include "core/protocol/ass_impl/ass_wire.hpp"
+
+/**
+ * @brief   comm_packer的打包往返与损坏报文测试
+ */
+namespace
+{
+    template <typename DT>
+    class comm_packer_test : public ::testing::Test
+    {
+    protected:
+        using packer = mpmt::comm_packer<DT>;
+
+        std::vector<DT> random_data(uint64_t n, uint8_t width)
+        {
+            const DT c_mask = (width >= packer::mc_DT_BITS) ? static_cast<DT>(~DT(0)) : static_cast<DT>((DT(1) << width) - 1);
+            std::vector<DT> data(n);
+            for (DT& v : data)
+            {
+                v = static_cast<DT>(m_gen() & c_mask);
+            }
+            return data;
+        }
+
+        /** @brief 报文头中写入元素个数 */
+        static void set_count(std::vector<DT>& message, uint64_t n)
+        {
+            for (uint64_t i = 0; i < packer::mc_COUNT_WORDS; ++i)
+            {
+                message[1 + i] = static_cast<DT>(n >> (i * packer::mc_DT_BITS));
+            }
+        }
+
+        std::mt19937_64 m_gen{ 0xc0ffee };
+    };
+
+    using word_types = ::testing::Types<uint8_t, uint16_t, uint32_t, uint64_t>;
+    TYPED_TEST_SUITE(comm_packer_test, word_types);
+
+    TYPED_TEST(comm_packer_test, round_trips_every_width)
+    {
+        using packer = typename TestFixture::packer;
+        for (uint8_t width = 1; width <= packer::mc_DT_BITS; ++width)
+        {
+            for (const uint64_t c_n : { 0ULL, 1ULL, 7ULL, 1000ULL })
+            {
+                const std::vector<TypeParam> c_data = this->random_data(c_n, width);
+                const std::vector<TypeParam> c_message = packer::pack(c_data, true);
+                EXPECT_EQ(packer::unpack(c_message), c_data) << "width " << int(width) << ", n " << c_n;
+                EXPECT_LE(c_message.size(), packer::mc_HEADER_WORDS + c_n);
+            }
+        }
+    }
+
+    TYPED_TEST(comm_packer_test, narrow_values_are_compressed)
+    {
+        using packer = typename TestFixture::packer;
+        const std::vector<TypeParam> c_bits = this->random_data(4096, 1);
+        const std::vector<TypeParam> c_message = packer::pack(c_bits, true);
+        EXPECT_TRUE(packer::is_compressed(c_message));
+        EXPECT_EQ(c_message.size(), packer::mc_HEADER_WORDS + packer::packed_words(c_bits.size(), 1));
+    }
+
+    TYPED_TEST(comm_packer_test, secret_shares_stay_raw)
+    {
+        using packer = typename TestFixture::packer;
+        const std::vector<TypeParam> c_data = this->random_data(100, 1);
+        const std::vector<TypeParam> c_message = packer::pack(c_data, false);
+        EXPECT_FALSE(packer::is_compressed(c_message));
+        EXPECT_EQ(c_message.size(), packer::mc_HEADER_WORDS + c_data.size());
+        EXPECT_EQ(packer::unpack(c_message), c_data);
+    }
+
+    TYPED_TEST(comm_packer_test, rejects_truncated_header)
+    {
+        using packer = typename TestFixture::packer;
+        const std::vector<TypeParam> c_message(packer::mc_HEADER_WORDS - 1, 0);
+        EXPECT_THROW(packer::unpack(c_message), std::invalid_argument);
+    }
+
+    TYPED_TEST(comm_packer_test, rejects_invalid_width_flag)
+    {
+        using packer = typename TestFixture::packer;
+        std::vector<TypeParam> message = packer::pack(this->random_data(10, 3), true);
+        message[0] = static_cast<TypeParam>(packer::mc_DT_BITS);
+        EXPECT_THROW(packer::unpack(message), std::invalid_argument);
+    }
+
+    TYPED_TEST(comm_packer_test, rejects_payload_length_mismatch)
+    {
+        using packer = typename TestFixture::packer;
+        std::vector<TypeParam> message = packer::pack(this->random_data(100, 3), true);
+        message.pop_back();
+        EXPECT_THROW(packer::unpack(message), std::invalid_argument);
+    }
+
+    TYPED_TEST(comm_packer_test, rejects_count_that_would_wrap)
+    {
+        using packer = typename TestFixture::packer;
+        // n * width回绕到与载荷长度相符的小值时，未约束n的实现会分配或越界读取
+        const uint8_t c_width = 4;
+        std::vector<TypeParam> message = packer::pack(this->random_data(8, c_width), true);
+        message[0] = static_cast<TypeParam>(c_width);
+        this->set_count(message, (std::numeric_limits<uint64_t>::max() / c_width) + 1);
+        EXPECT_THROW(packer::unpack(message), std::invalid_argument);
+
+        std::vector<TypeParam> raw = packer::pack(this->random_data(8, 1), false);
+        this->set_count(raw, std::numeric_limits<uint64_t>::max());
+        EXPECT_THROW(packer::unpack(raw), std::invalid_argument);
+    }
+
+    TYPED_TEST(comm_packer_test, token_round_trips_through_adapter)
+    {
+        const std::vector<uint64_t> c_slots = { 3, 17, 4095, 70000 };
+        const std::vector<TypeParam> c_token = mpmt::ass_wire::encode_bytes<TypeParam>
+        (
+            reinterpret_cast<const uint8_t*>(c_slots.data()), c_slots.size() * sizeof(uint64_t)
+        );
+        auto [a, b] = mpmt::comm_inproc<TypeParam>::make_pair();
+        mpmt::ass_wire::send_token(*a, c_token);
+        EXPECT_EQ(mpmt::ass_wire::receive_token(*b), c_token);
+
+        // 损坏的令牌报文以protocol_exc报告，而非std::invalid_argument
+        a->send(std::vector<TypeParam>{ 1 });
+        EXPECT_THROW(mpmt::ass_wire::receive_token(*b), mpmt::protocol_exc);
+    }
+
+    TYPED_TEST(comm_packer_test, narrow_share_chunks_shrink_on_the_wire)
+    {
+        using packer = typename TestFixture::packer;
+        const uint8_t c_bits = 5;
+        const std::vector<TypeParam> c_chunk = this->random_data(1000, c_bits);
+        EXPECT_EQ(mpmt::ass_wire::share_mask<TypeParam>(c_bits), TypeParam(31));
+        EXPECT_EQ(mpmt::ass_wire::share_mask<TypeParam>(packer::mc_DT_BITS), static_cast<TypeParam>(~TypeParam(0)));
+        EXPECT_THROW(mpmt::ass_wire::check_share_bits<TypeParam>(0), mpmt::protocol_exc);
+        EXPECT_THROW(mpmt::ass_wire::check_share_bits<TypeParam>(packer::mc_DT_BITS + 1), mpmt::protocol_exc);
+
+        auto [a, b] = mpmt::comm_inproc<TypeParam>::make_pair();
+        mpmt::ass_wire::send_share_chunk(*a, c_chunk);
+        EXPECT_LE(a->bytes_sent(), (1000 * c_bits + 7) / 8 + 16 * sizeof(TypeParam));
+        std::vector<TypeParam> received;
+        mpmt::ass_wire::receive_share_chunk(*b, received);
+        EXPECT_EQ(received, c_chunk);
+    }
+}
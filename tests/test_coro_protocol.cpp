@@ -0,0 +1,164 @@
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "auxkit/logger.hpp"
+
+#include "core/comm/inproc_impl/comm_inproc.hpp"
+#include "core/coro/coro_pool.hpp"
+#include "core/coro/coro_task.hpp"
+#include "core/protocol/ass_impl/agent_ass.hpp"
+#include "core/protocol/ass_impl/data_holder_ass.hpp"
+#include "core/protocol/ass_impl/querier_ass.hpp"
+
+/**
+ * @brief   协程接口的加法秘密分享端到端测试
+ * @note    数据持有方、两个代理方与查询方全部以协程运行在两个工作线程上，
+ *          槽位数使种子展开跨越多个让出窗口；恢复的计数须与各持有方输入之和一致。
+ */
+namespace
+{
+    using ring = mpmt::ring16;
+
+    mpmt::coro_task<void> holder_session(mpmt::coro_pool& pool, mpmt::data_holder_ass<ring>& holder, std::atomic<uint32_t>& done)
+    {
+        co_await holder.share_async(pool);
+        done.fetch_add(1);
+    }
+
+    mpmt::coro_task<void> agent_session(mpmt::coro_pool& pool, mpmt::agent_ass<ring>& agent, std::atomic<uint32_t>& done)
+    {
+        co_await agent.merge_async(pool);
+        co_await agent.reveal_async(pool);
+        done.fetch_add(1);
+    }
+
+    mpmt::coro_task<void> querier_session(mpmt::coro_pool& pool, mpmt::querier_ass<ring>& querier, std::atomic<uint32_t>& done)
+    {
+        co_await querier.query_async(pool);
+        done.fetch_add(1);
+    }
+
+    mpmt::coro_task<void> failing_session(mpmt::coro_pool& pool, std::atomic<uint32_t>& done)
+    {
+        co_await pool.schedule();
+        done.fetch_add(1);
+        throw std::runtime_error("session 7 lost its querier");
+    }
+
+    TEST(coro_pool, failed_tasks_are_logged_with_their_message)
+    {
+        const std::string c_path = (std::filesystem::temp_directory_path()
+            / ("mpmt_coro_" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()) + ".jsonl")).string();
+        std::filesystem::remove(c_path);
+        ASSERT_TRUE(utils::logger::start({ c_path, utils::logger::level::INFO }));
+
+        // 失败的任务不影响其他任务，wait_idle()照常返回
+        std::atomic<uint32_t> done{ 0 };
+        {
+            mpmt::coro_pool pool({ 2 });
+            for (uint32_t i = 0; i < 16; ++i)
+            {
+                pool.spawn(failing_session(pool, done));
+            }
+            pool.wait_idle();
+        }
+        utils::logger::stop();
+        EXPECT_EQ(done.load(), 16u);
+
+        std::ifstream in(c_path);
+        uint64_t logged = 0;
+        for (std::string line; std::getline(in, line);)
+        {
+            logged += line.find("coroutine task failed") != std::string::npos && line.find("session 7 lost its querier") != std::string::npos;
+        }
+        EXPECT_EQ(logged, 16u);
+        std::filesystem::remove(c_path);
+    }
+
+    TEST(coro_protocol, sessions_share_merge_and_query_on_a_small_pool)
+    {
+        const uint32_t c_holders = 3;
+        const uint64_t c_slots = 100000;
+        std::mt19937_64 gen(11);
+        std::vector<std::vector<ring>> inputs(c_holders, std::vector<ring>(c_slots));
+        for (std::vector<ring>& input : inputs)
+        {
+            for (ring& v : input)
+            {
+                v = static_cast<ring>(gen() & 1);
+            }
+        }
+
+        std::vector<std::unique_ptr<mpmt::comm_inproc<ring>>> ends;
+        std::vector<mpmt::comm_adapter<ring>*> to_as0, to_as1;
+        std::vector<std::unique_ptr<mpmt::data_holder_ass<ring>>> holders;
+        for (uint32_t h = 0; h < c_holders; ++h)
+        {
+            auto p0 = mpmt::comm_inproc<ring>::make_pair();
+            auto p1 = mpmt::comm_inproc<ring>::make_pair();
+            holders.push_back(std::make_unique<mpmt::data_holder_ass<ring>>(*p0.first, *p1.first));
+            holders.back()->set_input(mpmt::rvector<ring>(inputs[h]));
+            to_as0.push_back(p0.second.get());
+            to_as1.push_back(p1.second.get());
+            for (auto* pair : { &p0, &p1 })
+            {
+                ends.push_back(std::move(pair->first));
+                ends.push_back(std::move(pair->second));
+            }
+        }
+        auto q0 = mpmt::comm_inproc<ring>::make_pair();
+        auto q1 = mpmt::comm_inproc<ring>::make_pair();
+        mpmt::agent_ass<ring> as0(mpmt::ass_role::AS0, to_as0, q0.second.get());
+        mpmt::agent_ass<ring> as1(mpmt::ass_role::AS1, to_as1, q1.second.get());
+        mpmt::querier_ass<ring> querier(*q0.first, *q1.first);
+        const std::vector<uint64_t> c_query = { 0, 7, 4096, 65535, c_slots - 1 };
+        querier.set_query(c_query);
+
+        std::atomic<uint32_t> done{ 0 };
+        {
+            mpmt::coro_pool pool({ 2 });
+            pool.spawn(querier_session(pool, querier, done));
+            pool.spawn(agent_session(pool, as0, done));
+            pool.spawn(agent_session(pool, as1, done));
+            for (const auto& holder : holders)
+            {
+                pool.spawn(holder_session(pool, *holder, done));
+            }
+            pool.wait_idle();
+        }
+        ASSERT_EQ(done.load(), c_holders + 3);
+
+        ASSERT_EQ(querier.counts().size(), c_query.size());
+        bool all_nonzero = true;
+        for (uint64_t i = 0; i < c_query.size(); ++i)
+        {
+            ring expected = 0;
+            for (const std::vector<ring>& input : inputs)
+            {
+                expected = static_cast<ring>(expected + input[c_query[i]]);
+            }
+            EXPECT_EQ(querier.counts()[i], expected) << "slot " << c_query[i];
+            all_nonzero = all_nonzero && expected != 0;
+        }
+        EXPECT_EQ(querier.result(), all_nonzero);
+
+        // 两个代理方的并集份额之和为各持有方输入之和
+        for (uint64_t s = 0; s < c_slots; s += 997)
+        {
+            ring expected = 0;
+            for (const std::vector<ring>& input : inputs)
+            {
+                expected = static_cast<ring>(expected + input[s]);
+            }
+            EXPECT_EQ(static_cast<ring>(as0.union_share()[s] + as1.union_share()[s]), expected) << "slot " << s;
+        }
+    }
+}
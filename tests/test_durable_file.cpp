@@ -0,0 +1,88 @@
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "core/io/durable_file.hpp"
+
+/**
+ * @brief   原子替换文件测试
+ * @note    提交后目标文件为临时文件的完整内容且临时文件不再存在；失败时抛出std::runtime_error且不改动目标文件。
+ */
+namespace
+{
+    class durable_file_test : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            m_path = (std::filesystem::temp_directory_path()
+                / ("mpmt_durable_" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()) + "_"
+                    + ::testing::UnitTest::GetInstance()->current_test_info()->name() + ".dat")).string();
+        }
+
+        void TearDown() override
+        {
+            std::filesystem::remove(m_path);
+            std::filesystem::remove(mpmt::durable_file::temp_path(m_path));
+        }
+
+        static void write(const std::string& path, const std::string& text)
+        {
+            std::ofstream(path, std::ios::binary | std::ios::trunc) << text;
+        }
+
+        static std::string read(const std::string& path)
+        {
+            std::ifstream in(path, std::ios::binary);
+            return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        }
+
+        std::string m_path;
+    };
+
+    TEST_F(durable_file_test, temp_path_stays_next_to_the_target)
+    {
+        const std::string c_temp = mpmt::durable_file::temp_path(m_path);
+        EXPECT_NE(c_temp, m_path);
+        EXPECT_EQ(std::filesystem::path(c_temp).parent_path(), std::filesystem::path(m_path).parent_path());
+    }
+
+    TEST_F(durable_file_test, commit_creates_and_then_replaces_the_target)
+    {
+        const std::string c_temp = mpmt::durable_file::temp_path(m_path);
+        write(c_temp, "first");
+        mpmt::durable_file::commit(c_temp, m_path);
+        EXPECT_EQ(read(m_path), "first");
+        EXPECT_FALSE(std::filesystem::exists(c_temp));
+
+        write(c_temp, std::string(100000, 'x'));
+        mpmt::durable_file::commit(c_temp, m_path);
+        EXPECT_EQ(read(m_path), std::string(100000, 'x'));
+        EXPECT_FALSE(std::filesystem::exists(c_temp));
+    }
+
+    TEST_F(durable_file_test, failed_commit_throws_and_keeps_the_target)
+    {
+        write(m_path, "kept");
+        EXPECT_THROW(mpmt::durable_file::commit(mpmt::durable_file::temp_path(m_path), m_path), std::runtime_error);
+        EXPECT_EQ(read(m_path), "kept");
+
+        const std::string c_temp = mpmt::durable_file::temp_path(m_path);
+        write(c_temp, "lost");
+        const std::string c_unreachable = (std::filesystem::path(m_path).parent_path() / "mpmt_missing_dir" / "target").string();
+        EXPECT_THROW(mpmt::durable_file::commit(c_temp, c_unreachable), std::runtime_error);
+        EXPECT_FALSE(std::filesystem::exists(c_unreachable));
+    }
+
+    TEST_F(durable_file_test, remove_ignores_missing_files)
+    {
+        write(m_path, "gone");
+        mpmt::durable_file::remove(m_path);
+        EXPECT_FALSE(std::filesystem::exists(m_path));
+        mpmt::durable_file::remove(m_path);
+    }
+}
@@ -0,0 +1,201 @@
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "core/io/direct_impl/io_direct.hpp"
+#include "core/ring/mrvf/mrvf_handler.hpp"
+
+/**
+ * @brief   绕过页缓存的文件读写测试
+ * @note    1. io_direct本身：非对齐的偏移与长度、跨多个在途片段的大块读写、截断到逻辑长度，与普通文件读出的字节逐一比较。
+ *          2. 经mrvf_handler（m_use_direct_io为true）保存v2文件，整体、区间与校验读取的结果须与原数据一致，
+ *             并由不使用直接读写的处理器读回；长度覆盖单元素到跨多块，压缩与原始存储各一遍。
+ *          3. 平台不支持时（supported()为false）第1部分跳过，第2部分经退化路径仍须得到同样的结果。
+ */
+namespace
+{
+    std::string temp_file(const std::string& tag)
+    {
+        return (std::filesystem::temp_directory_path()
+            / ("mpmt_direct_" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()) + "_"
+                + ::testing::UnitTest::GetInstance()->current_test_info()->name() + tag)).string();
+    }
+
+    std::vector<uint8_t> read_bytes(const std::string& path)
+    {
+        std::ifstream in(path, std::ios::binary);
+        return std::vector<uint8_t>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+
+    class io_direct_test : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            if (!mpmt::io_direct::supported())
+            {
+                GTEST_SKIP() << "io_direct is not supported on this platform";
+            }
+            m_path = temp_file(".bin");
+        }
+
+        void TearDown() override
+        {
+            std::filesystem::remove(m_path);
+        }
+
+        std::vector<uint8_t> random_bytes(uint64_t n)
+        {
+            std::vector<uint8_t> bytes(n);
+            for (uint8_t& b : bytes)
+            {
+                b = static_cast<uint8_t>(m_gen());
+            }
+            return bytes;
+        }
+
+        std::string m_path;
+        std::mt19937_64 m_gen{ 37 };
+    };
+
+    TEST_F(io_direct_test, unaligned_writes_read_back_and_truncate_to_logical_size)
+    {
+        std::vector<uint8_t> expected;
+        auto write = [&expected](mpmt::io_direct& io, uint64_t offset, const std::vector<uint8_t>& data)
+        {
+            io.write_at(offset, data.data(), data.size());
+            if (expected.size() < offset + data.size())
+            {
+                expected.resize(offset + data.size(), 0);
+            }
+            std::copy(data.begin(), data.end(), expected.begin() + static_cast<std::ptrdiff_t>(offset));
+        };
+        {
+            // 小片段与浅队列，使一次读写拆成多个在途请求
+            mpmt::io_direct io(m_path, mpmt::io_mode::CREATE, 2, 4096);
+            write(io, 0, random_bytes(1));
+            write(io, 100, random_bytes(10000));
+            write(io, 8190, random_bytes(3));
+            write(io, 7, random_bytes((1 << 20) + 123));
+            write(io, expected.size() + 5000, random_bytes(4096));
+            EXPECT_EQ(io.size(), expected.size());
+
+            std::vector<uint8_t> back(expected.size());
+            io.read_at(0, back.data(), back.size());
+            EXPECT_TRUE(back == expected) << io.backend();
+            io.sync();
+        }
+        EXPECT_TRUE(read_bytes(m_path) == expected);
+
+        // 读写打开已有文件，改写跨扇区的中段
+        {
+            mpmt::io_direct io(m_path, mpmt::io_mode::READ_WRITE);
+            EXPECT_EQ(io.size(), expected.size());
+            write(io, 4000, random_bytes(200));
+        }
+        EXPECT_TRUE(read_bytes(m_path) == expected);
+
+        mpmt::io_direct io(m_path, mpmt::io_mode::READ);
+        for (const std::pair<uint64_t, uint64_t> c_range : { std::pair<uint64_t, uint64_t>{ 4095, 2 }, { 1, 65536 }, { 12345, 678901 }, { expected.size() - 1, 1 } })
+        {
+            std::vector<uint8_t> part(c_range.second);
+            io.read_at(c_range.first, part.data(), part.size());
+            EXPECT_TRUE(std::equal(part.begin(), part.end(), expected.begin() + static_cast<std::ptrdiff_t>(c_range.first)))
+                << "offset " << c_range.first << " length " << c_range.second;
+        }
+    }
+
+    TEST_F(io_direct_test, rejects_unaligned_chunks_and_missing_files)
+    {
+        EXPECT_THROW(mpmt::io_direct(m_path, mpmt::io_mode::CREATE, 4, 1000), std::runtime_error);
+        EXPECT_THROW(mpmt::io_direct(m_path + ".missing", mpmt::io_mode::READ), std::runtime_error);
+    }
+
+    template <typename RT>
+    class io_direct_mrvf_test : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            m_path = temp_file(".mrvf");
+        }
+
+        void TearDown() override
+        {
+            std::filesystem::remove(m_path);
+        }
+
+        static typename mpmt::mrvf_handler<RT>::config direct_config(bool compress)
+        {
+            typename mpmt::mrvf_handler<RT>::config cfg{ false, false };
+            cfg.m_block_elems = 1000;
+            cfg.m_use_direct_io = true;
+            cfg.m_compress = compress;
+            return cfg;
+        }
+
+        /** @brief 一半为随机值、一半为小值的数据，使压缩时两种块编码都出现 */
+        std::vector<RT> values(uint64_t n)
+        {
+            std::vector<RT> out(n);
+            for (uint64_t i = 0; i < n; ++i)
+            {
+                out[i] = static_cast<RT>((i / 3000) % 2 == 0 ? m_gen() : m_gen() % 5);
+            }
+            return out;
+        }
+
+        std::string m_path;
+        std::mt19937_64 m_gen{ 41 };
+    };
+
+    using word_rings = ::testing::Types<mpmt::ring8, mpmt::ring16, mpmt::ring64>;
+    TYPED_TEST_SUITE(io_direct_mrvf_test, word_rings);
+
+    TYPED_TEST(io_direct_mrvf_test, round_trips_through_direct_and_buffered_handlers)
+    {
+        using RT = TypeParam;
+        const uint64_t c_lengths[] = { 1, 2, 999, 1000, 1001, 4095, 4097, 65536, 65537, 262143, 300007, 1000001 };
+        for (const bool c_compress : { false, true })
+        {
+            mpmt::mrvf_handler<RT> direct(TestFixture::direct_config(c_compress));
+            mpmt::mrvf_handler<RT> stream(typename mpmt::mrvf_handler<RT>::config{ false, false });
+            mpmt::mrvf_handler<RT> mapped(typename mpmt::mrvf_handler<RT>::config{ true, false });
+            for (const uint64_t c_n : c_lengths)
+            {
+                const std::vector<RT> c_values = this->values(c_n);
+                const mpmt::rvector<RT> c_expected(c_values);
+                direct.save(this->m_path, mpmt::mrvf<RT>(mpmt::rvector<RT>(c_expected)));
+                const std::string c_case = "length " + std::to_string(c_n) + (c_compress ? " compressed" : " raw");
+
+                EXPECT_TRUE(direct.load(this->m_path).m_rvector == c_expected) << c_case;
+                EXPECT_TRUE(stream.load(this->m_path).m_rvector == c_expected) << c_case;
+                EXPECT_TRUE(mapped.load(this->m_path).m_rvector == c_expected) << c_case;
+
+                // 区间：首元素、跨块边界、末尾与整体
+                for (const std::pair<uint64_t, uint64_t> c_range : { std::pair<uint64_t, uint64_t>{ 0, 1 }, { c_n / 3, c_n / 2 }, { c_n - 1, 1 }, { 0, c_n } })
+                {
+                    const mpmt::rvector<RT> c_part = direct.load_range(this->m_path, c_range.first, c_range.second);
+                    ASSERT_EQ(c_part.size(), c_range.second) << c_case;
+                    for (uint64_t i = 0; i < c_range.second; ++i)
+                    {
+                        ASSERT_EQ(c_part[i], c_values[c_range.first + i]) << c_case << " range at " << c_range.first << " index " << i;
+                    }
+                    EXPECT_NO_THROW(direct.verify(this->m_path, c_range.first, c_range.second)) << c_case;
+                }
+            }
+
+            // 普通写入的文件由直接读写的处理器读回
+            const mpmt::rvector<RT> c_expected(this->values(70001));
+            stream.save(this->m_path, mpmt::mrvf<RT>(mpmt::rvector<RT>(c_expected)));
+            EXPECT_TRUE(direct.load(this->m_path).m_rvector == c_expected);
+        }
+    }
+}
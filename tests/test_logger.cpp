@@ -0,0 +1,71 @@
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "auxkit/logger.hpp"
+
+/**
+ * @brief   日志队列的按需分配、线程退出后回收与停止时不丢记录的测试
+ */
+namespace
+{
+    uint64_t count_lines(const std::string& path, const std::string& word)
+    {
+        std::ifstream in(path);
+        uint64_t n = 0;
+        for (std::string line; std::getline(in, line);)
+        {
+            n += (line.find(word) != std::string::npos) ? 1 : 0;
+        }
+        return n;
+    }
+
+    TEST(logger, short_lived_thread_queues_are_reclaimed)
+    {
+        const std::string c_path = (std::filesystem::temp_directory_path()
+            / ("mpmt_logger_" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()) + ".jsonl")).string();
+        std::filesystem::remove(c_path);
+        ASSERT_TRUE(utils::logger::start({ c_path, utils::logger::level::INFO }));
+        const uint64_t c_base = utils::logger::queue_bytes();
+
+        // 每个线程只记录一条：只占用一段槽位，线程退出并被读空后整块释放
+        const uint32_t c_threads = 200;
+        for (uint32_t t = 0; t < c_threads; ++t)
+        {
+            std::thread([t] { MPMT_LOG_INFO("short lived thread", "thread", t); }).join();
+        }
+        const auto c_deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (utils::logger::queue_bytes() > c_base && std::chrono::steady_clock::now() < c_deadline)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        EXPECT_EQ(utils::logger::queue_bytes(), c_base);
+
+        // 并发写入的记录在stop()之后全部写出
+        std::vector<std::thread> writers;
+        for (uint32_t t = 0; t < 4; ++t)
+        {
+            writers.emplace_back([]
+            {
+                for (uint32_t i = 0; i < 500; ++i)
+                {
+                    MPMT_LOG_INFO("concurrent writer", "i", i);
+                }
+            });
+        }
+        for (std::thread& th : writers)
+        {
+            th.join();
+        }
+        utils::logger::stop();
+        EXPECT_EQ(utils::logger::queue_bytes(), c_base);
+        EXPECT_EQ(count_lines(c_path, "short lived thread"), c_threads);
+        EXPECT_EQ(count_lines(c_path, "concurrent writer") + utils::logger::dropped(), 4u * 500u);
+        std::filesystem::remove(c_path);
+    }
+}
@@ -0,0 +1,339 @@
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "core/comm/inproc_impl/comm_inproc.hpp"
+#include "core/exception/mrvf_exc.hpp"
+#include "core/exception/protocol_exc.hpp"
+#include "core/protocol/ass_impl/agent_ass.hpp"
+#include "core/protocol/ass_impl/data_holder_ass.hpp"
+#include "core/protocol/ass_impl/merge_checkpoint.hpp"
+
+/**
+ * @brief   合并检查点的清单校验、代际轮换与中断恢复测试
+ * @note    恢复用例先按参考合并得到两个代理方的并集份额，再构造部分累加的检查点（AS1为已累加的前若干组连接，
+ *          AS0为已展开的槽位前缀），经提交、载入与resume()后让持有方经新连接重新发送，结果须与参考逐元素一致。
+ */
+namespace
+{
+    using ring = mpmt::ring32;
+    using checkpoint = mpmt::merge_checkpoint<ring>;
+
+    constexpr uint32_t c_HOLDERS = 10;          // AS1按8个一组累加，共两组
+    constexpr uint64_t c_SLOTS = 50000;         // AS0按16384个槽位一个区间展开，共四个区间
+
+    /** @brief 持有方经一组新连接发送一次份额后，代理方一侧的连接 */
+    struct session
+    {
+        std::vector<std::unique_ptr<mpmt::comm_inproc<ring>>> m_ends;
+        std::vector<mpmt::comm_adapter<ring>*> m_to_as0;
+        std::vector<mpmt::comm_adapter<ring>*> m_to_as1;
+    };
+
+    class merge_checkpoint_test : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            m_dir = std::filesystem::temp_directory_path()
+                / ("mpmt_ckpt_" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()) + "_"
+                    + ::testing::UnitTest::GetInstance()->current_test_info()->name());
+            std::filesystem::remove_all(m_dir);
+            std::filesystem::create_directories(m_dir);
+            m_prefix = (m_dir / "ck").string();
+        }
+
+        void TearDown() override
+        {
+            m_holders.clear();
+            m_sessions.clear();
+            std::filesystem::remove_all(m_dir);
+        }
+
+        /** @brief 创建持有方并设置随机0/1输入 */
+        void make_holders()
+        {
+            std::mt19937_64 gen(49);
+            m_expected = std::vector<ring>(c_SLOTS, 0);
+            m_sessions.push_back(std::make_unique<session>());
+            for (uint32_t h = 0; h < c_HOLDERS; ++h)
+            {
+                std::vector<ring> input(c_SLOTS);
+                for (uint64_t i = 0; i < c_SLOTS; ++i)
+                {
+                    input[i] = static_cast<ring>(gen() & 1);
+                    m_expected[i] = static_cast<ring>(m_expected[i] + input[i]);
+                }
+                auto p0 = mpmt::comm_inproc<ring>::make_pair();
+                auto p1 = mpmt::comm_inproc<ring>::make_pair();
+                m_holders.push_back(std::make_unique<mpmt::data_holder_ass<ring>>(*p0.first, *p1.first));
+                m_holders.back()->set_input(mpmt::rvector<ring>(input));
+                for (auto* pair : { &p0, &p1 })
+                {
+                    m_sessions.back()->m_ends.push_back(std::move(pair->first));
+                    m_sessions.back()->m_ends.push_back(std::move(pair->second));
+                }
+            }
+        }
+
+        /** @brief 全部持有方经新连接重新发送份额 */
+        session& reshare()
+        {
+            m_sessions.push_back(std::make_unique<session>());
+            session& s = *m_sessions.back();
+            for (const std::unique_ptr<mpmt::data_holder_ass<ring>>& holder : m_holders)
+            {
+                auto p0 = mpmt::comm_inproc<ring>::make_pair();
+                auto p1 = mpmt::comm_inproc<ring>::make_pair();
+                holder->set_connections({ p0.first.get() }, { p1.first.get() });
+                s.m_to_as0.push_back(p0.second.get());
+                s.m_to_as1.push_back(p1.second.get());
+                for (auto* pair : { &p0, &p1 })
+                {
+                    s.m_ends.push_back(std::move(pair->first));
+                    s.m_ends.push_back(std::move(pair->second));
+                }
+            }
+            for (const std::unique_ptr<mpmt::data_holder_ass<ring>>& holder : m_holders)
+            {
+                holder->share();
+            }
+            return s;
+        }
+
+        /** @brief 以给定连接合并，可先从检查点恢复，可附带检查点写入器 */
+        static mpmt::rvector<ring> merge
+        (
+            mpmt::ass_role role,
+            const std::vector<mpmt::comm_adapter<ring>*>& links,
+            std::optional<checkpoint::resume_point> point = std::nullopt,
+            checkpoint* writer = nullptr
+        )
+        {
+            mpmt::agent_ass<ring> agent(role, links, nullptr);
+            if (point)
+            {
+                agent.resume(std::move(*point));
+            }
+            agent.set_checkpoint(writer);
+            agent.merge();
+            return mpmt::rvector<ring>(agent.union_share());
+        }
+
+        /** @brief 提交一个检查点后销毁写入器 */
+        void commit(mpmt::ass_role role, const mpmt::rvector<ring>& acc, const mpmt::merge_progress& progress) const
+        {
+            checkpoint writer({ m_prefix, 0.0 }, role);
+            writer.commit(acc, progress);
+        }
+
+        /** @brief 改写清单中的一个字段，value为空时删除该行 */
+        void rewrite_manifest(const std::string& key, const std::string& value) const
+        {
+            const std::string c_path = checkpoint::manifest_path(m_prefix);
+            std::ifstream in(c_path);
+            std::stringstream out;
+            std::string line;
+            while (std::getline(in, line))
+            {
+                if (line.compare(0, key.size() + 1, key + " ") != 0)
+                {
+                    out << line << '\n';
+                }
+                else if (!value.empty())
+                {
+                    out << key << ' ' << value << '\n';
+                }
+            }
+            in.close();
+            std::ofstream(c_path, std::ios::trunc) << out.str();
+        }
+
+        std::vector<std::string> files() const
+        {
+            std::vector<std::string> names;
+            for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(m_dir))
+            {
+                names.push_back(entry.path().filename().string());
+            }
+            std::sort(names.begin(), names.end());
+            return names;
+        }
+
+        std::filesystem::path m_dir;
+        std::string m_prefix;
+        std::vector<ring> m_expected;
+        std::vector<std::unique_ptr<mpmt::data_holder_ass<ring>>> m_holders;
+        std::vector<std::unique_ptr<session>> m_sessions;
+    };
+
+    TEST_F(merge_checkpoint_test, missing_manifest_loads_nothing)
+    {
+        EXPECT_FALSE(checkpoint::load(m_prefix, mpmt::ass_role::AS0).has_value());
+    }
+
+    TEST_F(merge_checkpoint_test, manifest_is_validated_on_load)
+    {
+        const mpmt::rvector<ring> c_acc(1000, 7);
+        commit(mpmt::ass_role::AS0, c_acc, { 4, 1, 500 });
+
+        const std::optional<checkpoint::resume_point> c_point = checkpoint::load(m_prefix, mpmt::ass_role::AS0);
+        ASSERT_TRUE(c_point.has_value());
+        EXPECT_TRUE(c_point->m_union == c_acc);
+        EXPECT_EQ(c_point->m_progress.m_links, 4u);
+        EXPECT_EQ(c_point->m_progress.m_folded, 1u);
+        EXPECT_EQ(c_point->m_progress.m_slots_done, 500u);
+
+        // 角色与环位宽不符
+        EXPECT_THROW(checkpoint::load(m_prefix, mpmt::ass_role::AS1), mpmt::protocol_exc);
+        EXPECT_THROW(mpmt::merge_checkpoint<mpmt::ring16>::load(m_prefix, mpmt::ass_role::AS0), mpmt::protocol_exc);
+        EXPECT_THROW(checkpoint({ m_prefix, 0.0 }, mpmt::ass_role::AS1), mpmt::protocol_exc);
+
+        // 进度越界、字段缺失或格式错误、长度与快照不符
+        const std::string c_manifest = [this]
+        {
+            std::ifstream in(checkpoint::manifest_path(m_prefix));
+            return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        }();
+        const std::vector<std::pair<std::string, std::string>> c_corruptions =
+        {
+            { "folded", "5" }, { "slots_done", "1001" }, { "links", "" }, { "union", "" },
+            { "generation", "abc" }, { "slots", "999" },
+        };
+        for (const std::pair<std::string, std::string>& c_edit : c_corruptions)
+        {
+            rewrite_manifest(c_edit.first, c_edit.second);
+            EXPECT_THROW(checkpoint::load(m_prefix, mpmt::ass_role::AS0), mpmt::protocol_exc) << c_edit.first << " = " << c_edit.second;
+            std::ofstream(checkpoint::manifest_path(m_prefix), std::ios::trunc) << c_manifest;
+        }
+
+        // 快照缺失
+        rewrite_manifest("union", "ck.gen9.mrvf");
+        EXPECT_THROW(checkpoint::load(m_prefix, mpmt::ass_role::AS0), mpmt::mrvf_exc);
+
+        // 首行不是清单标识：载入与构造写入器都拒绝
+        std::ofstream(checkpoint::manifest_path(m_prefix), std::ios::trunc) << "not a manifest\n";
+        EXPECT_THROW(checkpoint::load(m_prefix, mpmt::ass_role::AS0), mpmt::protocol_exc);
+        EXPECT_THROW(checkpoint({ m_prefix, 0.0 }, mpmt::ass_role::AS0), mpmt::protocol_exc);
+    }
+
+    TEST_F(merge_checkpoint_test, generations_turn_over_and_continue_after_restart)
+    {
+        {
+            checkpoint writer({ m_prefix, 0.0 }, mpmt::ass_role::AS1);
+            for (ring g = 1; g <= 3; ++g)
+            {
+                writer.commit(mpmt::rvector<ring>(64, g), { 2, 1, 0 });
+            }
+            EXPECT_EQ(writer.written(), 3u);
+            EXPECT_EQ(files(), (std::vector<std::string>{ "ck.gen3.mrvf", "ck.manifest" }));
+
+            // 间隔为0时空闲即接受
+            EXPECT_TRUE(writer.offer(mpmt::rvector<ring>(64, 4), { 2, 2, 0 }));
+            writer.wait();
+            EXPECT_EQ(writer.written(), 4u);
+        }
+        EXPECT_EQ(files(), (std::vector<std::string>{ "ck.gen4.mrvf", "ck.manifest" }));
+
+        // 重启后从清单的代数继续编号，提交后删除上一代快照
+        checkpoint writer({ m_prefix, 3600.0 }, mpmt::ass_role::AS1);
+        EXPECT_FALSE(writer.offer(mpmt::rvector<ring>(64, 5), { 2, 2, 0 }));
+        writer.commit(mpmt::rvector<ring>(64, 5), { 2, 2, 0 });
+        EXPECT_EQ(files(), (std::vector<std::string>{ "ck.gen5.mrvf", "ck.manifest" }));
+        const std::optional<checkpoint::resume_point> c_point = checkpoint::load(m_prefix, mpmt::ass_role::AS1);
+        ASSERT_TRUE(c_point.has_value());
+        EXPECT_TRUE(c_point->m_union == mpmt::rvector<ring>(64, 5));
+    }
+
+    TEST_F(merge_checkpoint_test, startup_removes_unreferenced_snapshots)
+    {
+        commit(mpmt::ass_role::AS0, mpmt::rvector<ring>(64, 1), { 1, 0, 0 });
+
+        // 提交清单后、删除上一代快照前崩溃的遗留，以及其他前缀或不符合命名的文件
+        for (const char* c_name : { "ck.gen0.mrvf", "ck.gen7.mrvf.tmp", "ck.gen1.mrvf.tmp", "ck.manifest.tmp",
+            "ck.gen.mrvf", "ck.gen2.mrvf.bak", "ckx.gen2.mrvf", "other.gen2.mrvf" })
+        {
+            std::ofstream(m_dir / c_name) << "stale";
+        }
+        {
+            checkpoint writer({ m_prefix, 0.0 }, mpmt::ass_role::AS0);
+        }
+        EXPECT_EQ(files(), (std::vector<std::string>{ "ck.gen.mrvf", "ck.gen1.mrvf", "ck.gen2.mrvf.bak", "ck.manifest", "ckx.gen2.mrvf", "other.gen2.mrvf" }));
+        ASSERT_TRUE(checkpoint::load(m_prefix, mpmt::ass_role::AS0).has_value());
+
+        // 没有清单时各代快照均未被引用
+        std::filesystem::remove(checkpoint::manifest_path(m_prefix));
+        {
+            checkpoint writer({ m_prefix, 0.0 }, mpmt::ass_role::AS0);
+        }
+        EXPECT_EQ(files(), (std::vector<std::string>{ "ck.gen.mrvf", "ck.gen2.mrvf.bak", "ckx.gen2.mrvf", "other.gen2.mrvf" }));
+    }
+
+    TEST_F(merge_checkpoint_test, as1_resumes_after_folded_groups)
+    {
+        make_holders();
+        const mpmt::rvector<ring> c_ref0 = merge(mpmt::ass_role::AS0, reshare().m_to_as0);
+        const mpmt::rvector<ring> c_ref1 = merge(mpmt::ass_role::AS1, reshare().m_to_as1);
+        for (uint64_t i = 0; i < c_SLOTS; ++i)
+        {
+            ASSERT_EQ(static_cast<ring>(c_ref0[i] + c_ref1[i]), m_expected[i]) << "slot " << i;
+        }
+
+        // 第一组8个连接已累加的检查点
+        const std::vector<mpmt::comm_adapter<ring>*> c_links = reshare().m_to_as1;
+        const mpmt::rvector<ring> c_first_group = merge(mpmt::ass_role::AS1, { c_links.begin(), c_links.begin() + 8 });
+        commit(mpmt::ass_role::AS1, c_first_group, { c_HOLDERS, 8, 0 });
+
+        // 恢复后只接收其余连接，并在结束时提交完整的检查点
+        {
+            checkpoint writer({ m_prefix, 0.0 }, mpmt::ass_role::AS1);
+            const mpmt::rvector<ring> c_resumed = merge(mpmt::ass_role::AS1, reshare().m_to_as1, checkpoint::load(m_prefix, mpmt::ass_role::AS1), &writer);
+            EXPECT_TRUE(c_resumed == c_ref1);
+        }
+        std::optional<checkpoint::resume_point> point = checkpoint::load(m_prefix, mpmt::ass_role::AS1);
+        ASSERT_TRUE(point.has_value());
+        EXPECT_EQ(point->m_progress.m_folded, c_HOLDERS);
+        EXPECT_TRUE(point->m_union == c_ref1);
+
+        // AS1按连接推进，不能从部分槽位区间恢复；连接数须与检查点一致
+        point->m_progress = { c_HOLDERS, 8, 100 };
+        EXPECT_THROW(merge(mpmt::ass_role::AS1, reshare().m_to_as1, std::move(point)), mpmt::protocol_exc);
+        const std::vector<mpmt::comm_adapter<ring>*> c_more = reshare().m_to_as1;
+        EXPECT_THROW(merge(mpmt::ass_role::AS1, { c_more.begin(), c_more.begin() + 9 }, checkpoint::load(m_prefix, mpmt::ass_role::AS1)), mpmt::protocol_exc);
+    }
+
+    TEST_F(merge_checkpoint_test, as0_resumes_from_a_partial_slot_range)
+    {
+        make_holders();
+        const mpmt::rvector<ring> c_ref0 = merge(mpmt::ass_role::AS0, reshare().m_to_as0);
+
+        // 前两个区间已展开的检查点，其后的槽位仍为0；再取一个不在区间边界上的前缀
+        for (const uint64_t c_done : { uint64_t{ 2 * 16384 }, uint64_t{ 12345 } })
+        {
+            mpmt::rvector<ring> partial(c_ref0);
+            for (uint64_t i = c_done; i < c_SLOTS; ++i)
+            {
+                partial[i] = 0;
+            }
+            commit(mpmt::ass_role::AS0, partial, { c_HOLDERS, 0, c_done });
+
+            checkpoint writer({ m_prefix, 0.0 }, mpmt::ass_role::AS0);
+            const mpmt::rvector<ring> c_resumed = merge(mpmt::ass_role::AS0, reshare().m_to_as0, checkpoint::load(m_prefix, mpmt::ass_role::AS0), &writer);
+            EXPECT_TRUE(c_resumed == c_ref0) << "resumed after " << c_done << " slot(s)";
+        }
+        const std::optional<checkpoint::resume_point> c_point = checkpoint::load(m_prefix, mpmt::ass_role::AS0);
+        ASSERT_TRUE(c_point.has_value());
+        EXPECT_EQ(c_point->m_progress.m_folded, c_HOLDERS);
+        EXPECT_EQ(c_point->m_progress.m_slots_done, 0u);
+        EXPECT_TRUE(c_point->m_union == c_ref0);
+    }
+}
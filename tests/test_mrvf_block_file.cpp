@@ -0,0 +1,195 @@
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "core/crc/crc64.hpp"
+#include "core/exception/mrvf_exc.hpp"
+#include "core/io/stream_impl/io_stream.hpp"
+#include "core/ring/mrvf/mrvf_block_file.hpp"
+#include "core/ring/mrvf/mrvf_handler.hpp"
+
+/**
+ * @brief   mrvf v2分块文件的往返、原位改写与损坏检测测试
+ */
+namespace
+{
+    using ring = mpmt::ring32;
+
+    constexpr uint64_t c_OFF_INDEX_OFFSET = 32;     // 文件头中index_offset字段的偏移
+    constexpr uint64_t c_OFF_INDEX_CRC = 40;        // 文件头中index_crc64字段的偏移
+    constexpr uint64_t c_OFF_HEADER_CRC = 56;       // 文件头中header_crc64字段的偏移
+
+    class mrvf_block_file_test : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            m_path = (std::filesystem::temp_directory_path()
+                / ("mpmt_mrvf_" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()) + "_"
+                    + ::testing::UnitTest::GetInstance()->current_test_info()->name() + ".mrvf")).string();
+        }
+
+        void TearDown() override
+        {
+            std::filesystem::remove(m_path);
+        }
+
+        static mpmt::mrvf_handler<ring>::config v2_config()
+        {
+            mpmt::mrvf_handler<ring>::config cfg{ false, false };
+            cfg.m_block_elems = 1024;
+            cfg.m_compress = true;
+            return cfg;
+        }
+
+        std::vector<ring> random_values(uint64_t n, ring mask)
+        {
+            std::vector<ring> values(n);
+            for (ring& v : values)
+            {
+                v = static_cast<ring>(m_gen()) & mask;
+            }
+            return values;
+        }
+
+        std::vector<uint8_t> read_file() const
+        {
+            std::ifstream in(m_path, std::ios::binary);
+            return std::vector<uint8_t>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        }
+
+        void write_file(const std::vector<uint8_t>& bytes) const
+        {
+            std::ofstream out(m_path, std::ios::binary | std::ios::trunc);
+            out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        }
+
+        /** @brief 改写字节后重新计算块索引与文件头的校验和，使只有被测的字段不一致 */
+        static void reseal(std::vector<uint8_t>& bytes)
+        {
+            uint64_t index_offset = 0;
+            std::memcpy(&index_offset, bytes.data() + c_OFF_INDEX_OFFSET, sizeof(index_offset));
+            const uint64_t c_index_crc = mpmt::crc64::compute(bytes.data() + index_offset, bytes.size() - index_offset - 8);
+            std::memcpy(bytes.data() + c_OFF_INDEX_CRC, &c_index_crc, sizeof(c_index_crc));
+            const uint64_t c_header_crc = mpmt::crc64::compute(bytes.data(), c_OFF_HEADER_CRC);
+            std::memcpy(bytes.data() + c_OFF_HEADER_CRC, &c_header_crc, sizeof(c_header_crc));
+        }
+
+        std::string m_path;
+        std::mt19937_64 m_gen{ 0x5eed };
+    };
+
+    TEST_F(mrvf_block_file_test, round_trips_whole_vector_and_ranges)
+    {
+        mpmt::mrvf_handler<ring> handler(v2_config());
+        const std::vector<ring> c_values = random_values(5000, 0xff);
+        handler.save(m_path, mpmt::mrvf<ring>(mpmt::rvector<ring>(c_values)));
+        EXPECT_EQ(handler.read_version(m_path), mpmt::mrvf_block_file::mc_VERSION);
+
+        EXPECT_TRUE(handler.load(m_path).m_rvector == mpmt::rvector<ring>(c_values));
+        const mpmt::rvector<ring> c_range = handler.load_range(m_path, 1000, 2100);
+        EXPECT_TRUE(c_range == mpmt::rvector<ring>(std::vector<ring>(c_values.begin() + 1000, c_values.begin() + 3100)));
+        EXPECT_NO_THROW(handler.verify(m_path, 0, c_values.size()));
+        EXPECT_THROW(handler.load_range(m_path, 4990, 11), mpmt::mrvf_exc);
+    }
+
+    TEST_F(mrvf_block_file_test, relocated_blocks_leave_holes_reclaimed_by_save)
+    {
+        mpmt::mrvf_handler<ring> handler(v2_config());
+        std::vector<ring> values(4096, 0);
+        handler.save(m_path, mpmt::mrvf<ring>(mpmt::rvector<ring>(values)));
+        const uint64_t c_saved_size = std::filesystem::file_size(m_path);
+
+        // 全零块压缩得很短，改写为随机值后放不下原位置，移至数据区末尾
+        const std::vector<ring> c_noise = random_values(1024, ~ring(0));
+        handler.patch(m_path, 1024, mpmt::rvector<ring>(c_noise));
+        std::copy(c_noise.begin(), c_noise.end(), values.begin() + 1024);
+        EXPECT_GT(std::filesystem::file_size(m_path), c_saved_size);
+        {
+            mpmt::io_stream io(m_path, mpmt::io_mode::READ);
+            const mpmt::mrvf_block_file c_blocks(io, m_path);
+            EXPECT_GT(c_blocks.hole_bytes(), 0u);
+            EXPECT_GT(c_blocks.entry(1).m_offset, c_blocks.entry(3).m_offset);
+        }
+        EXPECT_TRUE(handler.load(m_path).m_rvector == mpmt::rvector<ring>(values));
+        EXPECT_NO_THROW(handler.verify(m_path, 0, values.size()));
+
+        // 重新保存后块连续排列，空洞被回收
+        handler.save(m_path, handler.load(m_path));
+        mpmt::io_stream io(m_path, mpmt::io_mode::READ);
+        const mpmt::mrvf_block_file c_blocks(io, m_path);
+        EXPECT_EQ(c_blocks.hole_bytes(), 0u);
+        EXPECT_TRUE(handler.load(m_path).m_rvector == mpmt::rvector<ring>(values));
+    }
+
+    TEST_F(mrvf_block_file_test, detects_corrupted_block_index_and_truncation)
+    {
+        mpmt::mrvf_handler<ring> handler(v2_config());
+        handler.save(m_path, mpmt::mrvf<ring>(mpmt::rvector<ring>(random_values(3000, ~ring(0)))));
+        const std::vector<uint8_t> c_good = read_file();
+        uint64_t index_offset = 0;
+        std::memcpy(&index_offset, c_good.data() + c_OFF_INDEX_OFFSET, sizeof(index_offset));
+
+        // 数据块中的一个字节：只有覆盖它的块校验失败
+        std::vector<uint8_t> bytes = c_good;
+        bytes[mpmt::mrvf_block_file::mc_HEADER_SIZE + 5] ^= 0x40;
+        write_file(bytes);
+        EXPECT_THROW(handler.verify(m_path, 0, 10), mpmt::mrvf_exc);
+        EXPECT_NO_THROW(handler.verify(m_path, 2048, 10));
+        EXPECT_THROW(handler.load(m_path), mpmt::mrvf_exc);
+
+        // 块偏移接近2^64：offset + stored_bytes回绕，校验和重新计算后打开时（读取数据块之前）仍须被拒绝
+        bytes = c_good;
+        const uint64_t c_wrapping = ~0ULL - 16;
+        std::memcpy(bytes.data() + index_offset, &c_wrapping, sizeof(c_wrapping));
+        reseal(bytes);
+        write_file(bytes);
+        {
+            mpmt::io_stream io(m_path, mpmt::io_mode::READ);
+            EXPECT_THROW(mpmt::mrvf_block_file(io, m_path), mpmt::mrvf_exc);
+        }
+
+        // index_offset接近2^64：index_offset + 索引长度回绕
+        bytes = c_good;
+        const uint64_t c_far = ~0ULL - 8;
+        std::memcpy(bytes.data() + c_OFF_INDEX_OFFSET, &c_far, sizeof(c_far));
+        const uint64_t c_header_crc = mpmt::crc64::compute(bytes.data(), c_OFF_HEADER_CRC);
+        std::memcpy(bytes.data() + c_OFF_HEADER_CRC, &c_header_crc, sizeof(c_header_crc));
+        write_file(bytes);
+        EXPECT_THROW(handler.load(m_path), mpmt::mrvf_exc);
+
+        // 块索引被改动（索引校验和不符）与文件被截断
+        bytes = c_good;
+        bytes[index_offset + 3] ^= 0x01;
+        write_file(bytes);
+        EXPECT_THROW(handler.load(m_path), mpmt::mrvf_exc);
+        bytes = c_good;
+        bytes.resize(bytes.size() - 4);
+        write_file(bytes);
+        EXPECT_THROW(handler.load(m_path), mpmt::mrvf_exc);
+    }
+
+    TEST_F(mrvf_block_file_test, bit_width_mode_round_trips)
+    {
+        using ring12 = mpmt::ring_k<12>;
+        mpmt::mrvf_handler<ring12>::config cfg{ false, false };
+        cfg.m_block_elems = 512;
+        mpmt::mrvf_handler<ring12> handler(cfg);
+        std::vector<uint64_t> raw(3001);
+        for (uint64_t& v : raw)
+        {
+            v = m_gen() & 0xfff;
+        }
+        const std::vector<ring12> c_values(raw.begin(), raw.end());
+        handler.save(m_path, mpmt::mrvf<ring12>(mpmt::rvector<ring12>(c_values)));
+        EXPECT_LT(std::filesystem::file_size(m_path), 3001u * 2);
+        EXPECT_TRUE(handler.load(m_path).m_rvector == mpmt::rvector<ring12>(c_values));
+        const mpmt::rvector<ring12> c_range = handler.load_range(m_path, 777, 1000);
+        EXPECT_TRUE(c_range == mpmt::rvector<ring12>(std::vector<ring12>(c_values.begin() + 777, c_values.begin() + 1777)));
+    }
+}
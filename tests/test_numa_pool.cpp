@@ -0,0 +1,244 @@
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "core/numa/numa_memory.hpp"
+#include "core/numa/numa_pool.hpp"
+#include "core/numa/numa_topology.hpp"
+#include "core/ring/rvector.hpp"
+
+/**
+ * @brief   NUMA拓扑解析、分区边界与按节点线程池测试
+ * @note    拓扑由临时目录中伪造的sysfs节点构造（两个计算节点与一个纯内存节点），不依赖本机实际的节点数；
+ *          各放置策略下的向量运算结果须与单线程执行（OFF）逐元素一致。
+ */
+namespace
+{
+    /** @brief 以逗号分隔的CPU列表文本 */
+    std::string cpulist_text(const std::vector<uint32_t>& cpus)
+    {
+        std::string text;
+        for (const uint32_t c_cpu : cpus)
+        {
+            text += (text.empty() ? "" : ",") + std::to_string(c_cpu);
+        }
+        return text + "\n";
+    }
+
+    class numa_fake_sysfs_test : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+#if !defined(__linux__)
+            GTEST_SKIP() << "sysfs topology is only read on Linux";
+#endif
+            m_root = std::filesystem::temp_directory_path()
+                / ("mpmt_numa_" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()) + "_"
+                    + ::testing::UnitTest::GetInstance()->current_test_info()->name());
+            std::filesystem::remove_all(m_root);
+
+            // 不存在的根目录退化为单节点，其CPU即本进程允许运行的全部CPU
+            m_allowed = mpmt::numa_topology((m_root / "missing").string()).nodes().at(0).m_cpus;
+            const uint64_t c_half = std::max<uint64_t>(1, m_allowed.size() / 2);
+            const std::vector<uint32_t> c_low(m_allowed.begin(), m_allowed.begin() + c_half);
+            const std::vector<uint32_t> c_high = m_allowed.size() > 1
+                ? std::vector<uint32_t>(m_allowed.begin() + c_half, m_allowed.end())
+                : m_allowed;
+
+            // node0与node3为计算节点，node1无CPU，possible等非节点条目被忽略
+            write("node0/cpulist", cpulist_text(c_low));
+            write("node1/cpulist", "\n");
+            write("node3/cpulist", cpulist_text(c_high));
+            write("nodeX/cpulist", cpulist_text(m_allowed));
+            write("possible", "0-3\n");
+            m_expected = { c_low, c_high };
+        }
+
+        void TearDown() override
+        {
+            std::filesystem::remove_all(m_root);
+        }
+
+        void write(const std::string& rel, const std::string& text) const
+        {
+            const std::filesystem::path c_path = m_root / rel;
+            std::filesystem::create_directories(c_path.parent_path());
+            std::ofstream(c_path) << text;
+        }
+
+        std::filesystem::path m_root;
+        std::vector<uint32_t> m_allowed;
+        std::vector<std::vector<uint32_t>> m_expected;
+    };
+
+    TEST(numa_topology, parse_cpulist_ranges_and_singletons)
+    {
+        using mpmt::numa_topology;
+        EXPECT_EQ(numa_topology::parse_cpulist("0-3,8,10-11\n"), (std::vector<uint32_t>{ 0, 1, 2, 3, 8, 10, 11 }));
+        EXPECT_EQ(numa_topology::parse_cpulist("5,1-2,2"), (std::vector<uint32_t>{ 1, 2, 5 }));
+        EXPECT_EQ(numa_topology::parse_cpulist("7"), (std::vector<uint32_t>{ 7 }));
+        EXPECT_EQ(numa_topology::parse_cpulist("0-1,\n"), (std::vector<uint32_t>{ 0, 1 }));
+        EXPECT_TRUE(numa_topology::parse_cpulist("").empty());
+        EXPECT_TRUE(numa_topology::parse_cpulist("\n").empty());
+    }
+
+    TEST_F(numa_fake_sysfs_test, topology_keeps_compute_nodes_in_id_order)
+    {
+        const mpmt::numa_topology c_topo(m_root.string());
+        ASSERT_EQ(c_topo.num_nodes(), 2u);
+        EXPECT_EQ(c_topo.nodes()[0].m_id, 0u);
+        EXPECT_EQ(c_topo.nodes()[1].m_id, 3u);
+        EXPECT_EQ(c_topo.nodes()[0].m_cpus, m_expected[0]);
+        EXPECT_EQ(c_topo.nodes()[1].m_cpus, m_expected[1]);
+
+        EXPECT_EQ(c_topo.node_index_of(m_expected[0].front()), 0);
+        if (m_allowed.size() > 1)
+        {
+            EXPECT_EQ(c_topo.node_index_of(m_expected[1].back()), 1);
+        }
+        EXPECT_EQ(c_topo.node_index_of(~0U), -1);
+    }
+
+    TEST(numa_memory, partition_is_page_aligned_and_covers_every_element)
+    {
+        const uint64_t c_elem_bytes[] = { 1, 2, 4, 8, 16, 3, 8192 };
+        const uint64_t c_elems[] = { 0, 1, 1023, 1024, 4097, 1 << 20, 3000001 };
+        const uint32_t c_parts[] = { 1, 2, 3, 7, 64 };
+        for (const uint64_t c_bytes : c_elem_bytes)
+        {
+            const uint64_t c_per_page = std::max<uint64_t>(1, mpmt::numa_memory::mc_PAGE_SIZE / c_bytes);
+            for (const uint64_t c_n : c_elems)
+            {
+                for (const uint32_t c_p : c_parts)
+                {
+                    uint64_t next = 0;
+                    for (uint32_t k = 0; k < c_p; ++k)
+                    {
+                        const std::pair<uint64_t, uint64_t> c_range = mpmt::numa_memory::partition(c_n, c_bytes, k, c_p);
+                        ASSERT_EQ(c_range.first, next) << "bytes " << c_bytes << " elems " << c_n << " part " << k << "/" << c_p;
+                        ASSERT_LE(c_range.first, c_range.second);
+                        if (c_range.first != c_n)
+                        {
+                            EXPECT_EQ(c_range.first % c_per_page, 0u);
+                        }
+                        next = c_range.second;
+                    }
+                    EXPECT_EQ(next, c_n);
+                }
+            }
+        }
+    }
+
+    TEST_F(numa_fake_sysfs_test, parallel_for_covers_each_element_once)
+    {
+        const mpmt::numa_topology c_topo(m_root.string());
+        mpmt::numa_pool pool(c_topo, 2);
+        EXPECT_EQ(pool.num_threads(), std::min<uint64_t>(2, m_expected[0].size()) + std::min<uint64_t>(2, m_expected[1].size()));
+
+        const uint64_t c_sizes[] = { 1, 511, 512, 4097, 100003, 1 << 20 };
+        for (const uint64_t c_elem_bytes : { 1ULL, 8ULL })
+        {
+            for (const uint64_t c_n : c_sizes)
+            {
+                std::vector<std::atomic<uint8_t>> hits(c_n);
+                std::atomic<uint64_t> calls{ 0 };
+                pool.parallel_for(c_n, c_elem_bytes, [&hits, &calls](uint64_t first, uint64_t count)
+                {
+                    calls.fetch_add(1);
+                    for (uint64_t i = first; i < first + count; ++i)
+                    {
+                        hits[i].fetch_add(1, std::memory_order_relaxed);
+                    }
+                });
+                EXPECT_LE(calls.load(), pool.num_threads());
+                for (uint64_t i = 0; i < c_n; ++i)
+                {
+                    ASSERT_EQ(hits[i].load(), 1u) << "index " << i << " of " << c_n << ", element bytes " << c_elem_bytes;
+                }
+            }
+        }
+
+        // 空区间不调用任务；池内线程中的嵌套调用在当前线程整体执行
+        bool called = false;
+        pool.parallel_for(0, 8, [&called](uint64_t, uint64_t) { called = true; });
+        EXPECT_FALSE(called);
+
+        std::atomic<uint64_t> nested_calls{ 0 };
+        std::atomic<uint64_t> nested_elems{ 0 };
+        pool.parallel_for(1 << 16, 8, [&pool, &nested_calls, &nested_elems](uint64_t, uint64_t)
+        {
+            pool.parallel_for(1000, 8, [&nested_calls, &nested_elems](uint64_t first, uint64_t count)
+            {
+                EXPECT_EQ(first, 0u);
+                nested_calls.fetch_add(1);
+                nested_elems.fetch_add(count);
+            });
+        });
+        EXPECT_EQ(nested_elems.load(), nested_calls.load() * 1000);
+    }
+
+    TEST(numa_memory, policies_give_identical_results)
+    {
+        using ring = mpmt::ring64;
+        // 超过mc_MIN_BYTES才采用映射分配与分区并行
+        const uint64_t c_n = mpmt::numa_memory::mc_MIN_BYTES / sizeof(ring) + 4099;
+
+        std::mt19937_64 gen(20241019);
+        std::vector<ring> a(c_n);
+        std::vector<ring> b(c_n);
+        for (uint64_t i = 0; i < c_n; ++i)
+        {
+            a[i] = gen();
+            b[i] = gen();
+        }
+        const ring c_scalar = gen();
+
+        const mpmt::numa_policy c_saved = mpmt::numa_memory::active();
+        std::vector<std::vector<ring>> results;
+        std::vector<ring> sums;
+        for (const mpmt::numa_policy c_policy : { mpmt::numa_policy::OFF, mpmt::numa_policy::PARTITION, mpmt::numa_policy::INTERLEAVE })
+        {
+            mpmt::numa_memory::select(c_policy);
+            EXPECT_EQ(mpmt::numa_memory::partitioned(c_n * sizeof(ring)), c_policy != mpmt::numa_policy::OFF);
+
+            const mpmt::rvector<ring> c_va(a);
+            const mpmt::rvector<ring> c_vb(b);
+            mpmt::rvector<ring> out(c_n);
+            EXPECT_EQ(out.reduce(), 0u);
+            out = c_va;
+            out *= c_vb;
+            out += c_va;
+            out -= c_scalar;
+            out.accumulate({ &c_va, &c_vb });
+            out.multiply({ &c_vb });
+            ASSERT_TRUE(mpmt::rvector<ring>(out) == out);
+
+            std::vector<ring> flat(c_n);
+            for (uint64_t i = 0; i < c_n; ++i)
+            {
+                flat[i] = out[i];
+            }
+            results.push_back(std::move(flat));
+            sums.push_back(out.reduce());
+        }
+        mpmt::numa_memory::select(c_saved);
+
+        for (uint64_t i = 0; i < c_n; ++i)
+        {
+            const ring c_ref = static_cast<ring>(((a[i] * b[i] + a[i] - c_scalar) + a[i] + b[i]) * b[i]);
+            ASSERT_EQ(results[0][i], c_ref) << "index " << i;
+        }
+        for (uint64_t p = 1; p < results.size(); ++p)
+        {
+            EXPECT_TRUE(results[p] == results[0]) << mpmt::numa_memory::name(static_cast<mpmt::numa_policy>(p));
+            EXPECT_EQ(sums[p], sums[0]);
+        }
+    }
+}
@@ -0,0 +1,79 @@
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "auxkit/profiler.hpp"
+
+/**
+ * @brief   性能分析器线程缓存区的按需增长与回收测试
+ */
+namespace
+{
+    uint64_t occurrences(const std::string& text, const std::string& word)
+    {
+        uint64_t n = 0;
+        for (std::size_t pos = text.find(word); pos != std::string::npos; pos = text.find(word, pos + word.size()))
+        {
+            ++n;
+        }
+        return n;
+    }
+
+    TEST(profiler, buffers_grow_on_demand_and_are_recycled_after_reset)
+    {
+        const uint32_t c_threads = 16;
+        utils::profiler::reset();
+        const uint64_t c_base = utils::profiler::buffer_bytes();
+
+        // 只记录一个事件的线程只占用首段，远小于一整块缓存区
+        for (uint32_t t = 0; t < c_threads; ++t)
+        {
+            std::thread([] { utils::profiler::record("short_lived_thread", 10, 20); }).join();
+        }
+        const uint64_t c_grown = utils::profiler::buffer_bytes() - c_base;
+        EXPECT_GT(c_grown, 0u);
+        EXPECT_LE(c_grown, c_threads * 16u * 1024u);
+
+        // 已退出线程的事件保留至导出
+        EXPECT_EQ(occurrences(utils::profiler::export_chrome_trace(), "short_lived_thread"), c_threads);
+        EXPECT_EQ(utils::profiler::dropped_events(), 0u);
+
+        // reset()释放已退出线程的存储，之后的线程接管回收的缓存区
+        utils::profiler::reset();
+        EXPECT_EQ(utils::profiler::buffer_bytes(), c_base);
+        for (uint32_t round = 0; round < 4; ++round)
+        {
+            for (uint32_t t = 0; t < c_threads; ++t)
+            {
+                std::thread([] { utils::profiler::record("recycled_thread", 10, 20); }).join();
+            }
+            EXPECT_EQ(utils::profiler::buffer_bytes() - c_base, c_grown);
+            utils::profiler::reset();
+        }
+
+        // 只累加计数器的线程退出后立即回收，计数值保留
+        for (uint32_t t = 0; t < c_threads; ++t)
+        {
+            std::thread([] { utils::profiler::add(utils::profiler::counter::CRC_BYTES, 3); }).join();
+        }
+        EXPECT_EQ(utils::profiler::counter_value(utils::profiler::counter::CRC_BYTES), 3u * c_threads);
+        EXPECT_EQ(utils::profiler::buffer_bytes(), c_base);
+    }
+
+    TEST(profiler, long_thread_spills_into_later_segments)
+    {
+        utils::profiler::reset();
+        const uint64_t c_events = 5000;
+        std::thread([c_events]
+        {
+            for (uint64_t i = 0; i < c_events; ++i)
+            {
+                utils::profiler::record("spilling_thread", i, i + 1);
+            }
+        }).join();
+        EXPECT_EQ(occurrences(utils::profiler::export_chrome_trace(), "spilling_thread"), c_events);
+        EXPECT_EQ(utils::profiler::dropped_events(), 0u);
+        utils::profiler::reset();
+    }
+}
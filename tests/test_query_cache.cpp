@@ -0,0 +1,61 @@
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "core/exception/protocol_exc.hpp"
+#include "core/protocol/ass_impl/query_cache.hpp"
+
+/**
+ * @brief   代理方查询缓存的命中、淘汰、清空与容量校验测试
+ */
+namespace
+{
+    using ring = mpmt::ring32;
+
+    std::vector<ring> token(uint64_t i)
+    {
+        return { static_cast<ring>(i), static_cast<ring>(i >> 32), 7 };
+    }
+
+    TEST(query_cache, hits_evicts_and_reuses_after_clear)
+    {
+        mpmt::query_cache<ring> cache(4);
+        for (uint64_t i = 0; i < 4; ++i)
+        {
+            cache.insert(token(i), { static_cast<ring>(i * 10) });
+        }
+        ASSERT_NE(cache.find(token(2)), nullptr);
+        EXPECT_EQ(*cache.find(token(2)), std::vector<ring>{ 20 });
+
+        // 已满时按CLOCK淘汰一个未被引用的条目，被引用的令牌2保留
+        cache.insert(token(9), { 90 });
+        EXPECT_EQ(cache.size(), 4u);
+        ASSERT_NE(cache.find(token(2)), nullptr);
+        ASSERT_NE(cache.find(token(9)), nullptr);
+
+        // 清空后旧条目不可见，重新插入复用回收的条目与索引节点
+        for (int round = 0; round < 3; ++round)
+        {
+            cache.clear();
+            EXPECT_EQ(cache.size(), 0u);
+            EXPECT_EQ(cache.find(token(2)), nullptr);
+            for (uint64_t i = 0; i < 4; ++i)
+            {
+                cache.insert(token(i + 100), { static_cast<ring>(i) });
+            }
+            EXPECT_EQ(cache.size(), 4u);
+            ASSERT_NE(cache.find(token(103)), nullptr);
+            EXPECT_EQ(*cache.find(token(103)), std::vector<ring>{ 3 });
+        }
+    }
+
+    TEST(query_cache, rejects_capacity_above_limit)
+    {
+        EXPECT_THROW(mpmt::query_cache<ring>(mpmt::query_cache<ring>::mc_MAX_CAPACITY + 1), mpmt::protocol_exc);
+        mpmt::query_cache<ring> cache(2);
+        EXPECT_THROW(cache.resize(~0ULL), mpmt::protocol_exc);
+        EXPECT_NO_THROW(cache.resize(0));
+        cache.insert(token(1), { 1 });
+        EXPECT_EQ(cache.find(token(1)), nullptr);
+    }
+}
@@ -0,0 +1,123 @@
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "core/comm/inproc_impl/comm_inproc.hpp"
+#include "core/protocol/ass_impl/agent_ass.hpp"
+#include "core/protocol/ass_impl/querier_ass.hpp"
+#include "core/protocol/ass_impl/reveal_blind.hpp"
+
+/**
+ * @brief   查询响应盲化与进程内队列容量测试
+ */
+namespace
+{
+    using ring = mpmt::ring16;
+
+    mpmt::hash_siphash::key_type blind_key()
+    {
+        mpmt::hash_siphash::key_type key{};
+        for (uint64_t i = 0; i < key.size(); ++i)
+        {
+            key[i] = static_cast<uint8_t>(0xa5 ^ i);
+        }
+        return key;
+    }
+
+    TEST(reveal_blind, querier_learns_only_zero_or_nonzero)
+    {
+        // 槽位计数0..63，按随机份额分给两个代理方
+        const uint64_t c_slots = 64;
+        std::mt19937_64 gen(7);
+        std::vector<ring> share0(c_slots), share1(c_slots);
+        for (uint64_t i = 0; i < c_slots; ++i)
+        {
+            share0[i] = static_cast<ring>(gen());
+            share1[i] = static_cast<ring>(i - share0[i]);
+        }
+
+        auto p0 = mpmt::comm_inproc<ring>::make_pair();
+        auto p1 = mpmt::comm_inproc<ring>::make_pair();
+        mpmt::agent_ass<ring> as0(mpmt::ass_role::AS0, {}, p0.second.get());
+        mpmt::agent_ass<ring> as1(mpmt::ass_role::AS1, {}, p1.second.get());
+        as0.load_union(mpmt::rvector<ring>(share0));
+        as1.load_union(mpmt::rvector<ring>(share1));
+        as0.set_blind_key(blind_key());
+        as1.set_blind_key(blind_key());
+
+        mpmt::querier_ass<ring> querier(*p0.first, *p1.first);
+        std::vector<uint64_t> all(c_slots);
+        for (uint64_t i = 0; i < c_slots; ++i)
+        {
+            all[i] = i;
+        }
+        querier.set_query(all);
+        querier.share();
+        as0.reveal();
+        as1.reveal();
+        querier.reveal();
+
+        const std::vector<ring>& c_blinded = querier.counts();
+        ASSERT_EQ(c_blinded.size(), c_slots);
+        uint64_t unchanged = 0;
+        for (uint64_t i = 0; i < c_slots; ++i)
+        {
+            EXPECT_EQ(c_blinded[i] == 0, i == 0) << "slot " << i;
+            // 奇数计数盲化后仍为奇数，偶数计数的最低置位不变
+            const uint64_t c_value = c_blinded[i];
+            EXPECT_EQ(c_value & (~c_value + 1), i & (~i + 1)) << "slot " << i;
+            unchanged += (c_blinded[i] == i) ? 1 : 0;
+        }
+        EXPECT_LE(unchanged, 2u);
+        EXPECT_FALSE(querier.result());
+
+        // 同一令牌的响应确定，可以缓存
+        querier.share();
+        as0.reveal();
+        as1.reveal();
+        querier.reveal();
+        EXPECT_EQ(querier.counts(), c_blinded);
+    }
+
+    TEST(comm_inproc, send_blocks_when_queue_is_full)
+    {
+        auto [a, b] = mpmt::comm_inproc<uint64_t>::make_pair(64);
+        a->send(std::vector<uint64_t>(8, 1));       // 恰好填满
+        std::atomic<bool> sent{ false };
+        std::thread sender([&]
+        {
+            a->send(std::vector<uint64_t>(4, 2));
+            sent.store(true);
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        EXPECT_FALSE(sent.load());
+
+        std::vector<uint64_t> message;
+        b->receive(message);
+        EXPECT_EQ(message.size(), 8u);
+        sender.join();
+        EXPECT_TRUE(sent.load());
+        b->receive(message);
+        EXPECT_EQ(message, std::vector<uint64_t>(4, 2));
+
+        // 队列为空时单条超出容量的消息也能发送
+        a->send(std::vector<uint64_t>(100, 3));
+        b->receive(message);
+        EXPECT_EQ(message.size(), 100u);
+    }
+
+    TEST(comm_inproc, destroyed_reader_releases_blocked_sender)
+    {
+        auto [a, b] = mpmt::comm_inproc<uint64_t>::make_pair(8);
+        a->send(std::vector<uint64_t>(1, 1));
+        std::thread sender([&] { a->send(std::vector<uint64_t>(1, 2)); });
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        b.reset();
+        sender.join();
+        SUCCEED();
+    }
+}
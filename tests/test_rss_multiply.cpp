@@ -0,0 +1,173 @@
+#include <array>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "core/comm/inproc_impl/comm_inproc.hpp"
+#include "core/exception/protocol_exc.hpp"
+#include "core/protocol/ass_impl/ass_wire.hpp"
+#include "core/protocol/rss_impl/agent_rss.hpp"
+
+/**
+ * @brief   agent_rss::multiply()的三方重构测试
+ * @note    三个代理方经进程内连接组成环路，各自在独立线程上乘法；重构z = x * y并校验复制分量一致、
+ *          链式乘积正确、三方零分享的PRG偏移保持同步。长度覆盖单元素与跨分块边界。
+ */
+namespace
+{
+    template <typename RT>
+    class rss_multiply_test : public ::testing::Test
+    {
+    protected:
+        static constexpr uint32_t mc_PARTIES = 3;
+
+        void SetUp() override
+        {
+            // Pi经m_next[i]连接Pi+1，对端m_prev[i+1]
+            for (uint32_t i = 0; i < mc_PARTIES; ++i)
+            {
+                auto pair = mpmt::comm_inproc<RT>::make_pair();
+                m_next[i] = std::move(pair.first);
+                m_prev[(i + 1) % mc_PARTIES] = std::move(pair.second);
+            }
+            for (uint32_t i = 0; i < mc_PARTIES; ++i)
+            {
+                m_agents[i] = std::make_unique<mpmt::agent_rss<RT>>
+                (
+                    static_cast<mpmt::rss_role>(i), std::vector<mpmt::comm_adapter<RT>*>{}, nullptr,
+                    m_next[i].get(), m_prev[i].get()
+                );
+            }
+        }
+
+        /** @brief 将明文拆为三个加法分量，Pi持有(x_i, x_{i+1}) */
+        std::array<mpmt::rss_share<RT>, 3> share(const std::vector<RT>& plain)
+        {
+            std::array<std::vector<RT>, 3> parts{ std::vector<RT>(plain.size()), std::vector<RT>(plain.size()), plain };
+            for (uint64_t k = 0; k < plain.size(); ++k)
+            {
+                parts[0][k] = static_cast<RT>(m_gen());
+                parts[1][k] = static_cast<RT>(m_gen());
+                parts[2][k] = static_cast<RT>(plain[k] - parts[0][k] - parts[1][k]);
+            }
+            std::array<mpmt::rss_share<RT>, 3> shares;
+            for (uint32_t i = 0; i < mc_PARTIES; ++i)
+            {
+                shares[i] = mpmt::rss_share<RT>{ mpmt::rvector<RT>(parts[i]), mpmt::rvector<RT>(parts[(i + 1) % mc_PARTIES]) };
+            }
+            return shares;
+        }
+
+        /** @brief 三方并发执行一次乘法 */
+        std::array<mpmt::rss_share<RT>, 3> multiply(const std::array<mpmt::rss_share<RT>, 3>& x, const std::array<mpmt::rss_share<RT>, 3>& y)
+        {
+            std::array<mpmt::rss_share<RT>, 3> z;
+            std::vector<std::thread> threads;
+            for (uint32_t i = 0; i < mc_PARTIES; ++i)
+            {
+                threads.emplace_back([&, i] { z[i] = m_agents[i]->multiply(x[i], y[i]); });
+            }
+            for (std::thread& t : threads)
+            {
+                t.join();
+            }
+            return z;
+        }
+
+        /** @brief 重构明文，并校验Pi的第二个分量等于Pi+1的第一个分量 */
+        std::vector<RT> reconstruct(const std::array<mpmt::rss_share<RT>, 3>& z)
+        {
+            const uint64_t c_size = z[0].size();
+            std::vector<RT> plain(c_size);
+            for (uint64_t k = 0; k < c_size; ++k)
+            {
+                for (uint32_t i = 0; i < mc_PARTIES; ++i)
+                {
+                    EXPECT_EQ(z[i].m_second[k], z[(i + 1) % mc_PARTIES].m_first[k]) << "party " << i << ", element " << k;
+                }
+                plain[k] = static_cast<RT>(z[0].m_first[k] + z[1].m_first[k] + z[2].m_first[k]);
+            }
+            return plain;
+        }
+
+        std::vector<RT> random_plain(uint64_t n)
+        {
+            std::vector<RT> plain(n);
+            for (RT& v : plain)
+            {
+                v = static_cast<RT>(m_gen());
+            }
+            // 各宽度的最大值相乘覆盖窄类型的整型提升溢出
+            plain[0] = static_cast<RT>(~RT(0));
+            return plain;
+        }
+
+        void check_offsets(uint64_t expected)
+        {
+            for (uint32_t i = 0; i < mc_PARTIES; ++i)
+            {
+                EXPECT_EQ(m_agents[i]->zero_offset(), expected) << "party " << i;
+            }
+        }
+
+        void run(uint64_t n)
+        {
+            const std::vector<RT> c_x = random_plain(n);
+            const std::vector<RT> c_y = random_plain(n);
+            const auto c_xs = share(c_x);
+            const auto c_ys = share(c_y);
+
+            // 1-z = x * y
+            const auto c_zs = multiply(c_xs, c_ys);
+            const std::vector<RT> c_z = reconstruct(c_zs);
+            for (uint64_t k = 0; k < n; ++k)
+            {
+                ASSERT_EQ(c_z[k], static_cast<RT>(static_cast<uint64_t>(c_x[k]) * c_y[k])) << "element " << k;
+            }
+            check_offsets(n * sizeof(RT));
+
+            // 2-链式乘积w = z * x，输入为上一次乘法的输出份额
+            const auto c_ws = multiply(c_zs, c_xs);
+            const std::vector<RT> c_w = reconstruct(c_ws);
+            for (uint64_t k = 0; k < n; ++k)
+            {
+                ASSERT_EQ(c_w[k], static_cast<RT>(static_cast<uint64_t>(c_z[k]) * c_x[k])) << "element " << k;
+            }
+            check_offsets(2 * n * sizeof(RT));
+        }
+
+        std::mt19937_64 m_gen{ 0x5eed };
+        std::array<std::unique_ptr<mpmt::comm_inproc<RT>>, 3> m_next;
+        std::array<std::unique_ptr<mpmt::comm_inproc<RT>>, 3> m_prev;
+        std::array<std::unique_ptr<mpmt::agent_rss<RT>>, 3> m_agents;
+    };
+
+    using ring_types = ::testing::Types<mpmt::ring8, mpmt::ring16, mpmt::ring32, mpmt::ring64>;
+    TYPED_TEST_SUITE(rss_multiply_test, ring_types);
+
+    TYPED_TEST(rss_multiply_test, single_element)
+    {
+        this->run(1);
+    }
+
+    TYPED_TEST(rss_multiply_test, within_one_chunk)
+    {
+        this->run(1000);
+    }
+
+    TYPED_TEST(rss_multiply_test, across_chunk_boundary)
+    {
+        this->run(mpmt::ass_wire::mc_CHUNK_SIZE + 1);
+    }
+
+    TYPED_TEST(rss_multiply_test, rejects_mismatched_lengths)
+    {
+        const auto c_xs = this->share(this->random_plain(4));
+        const auto c_ys = this->share(this->random_plain(5));
+        EXPECT_THROW(this->m_agents[0]->multiply(c_xs[0], c_ys[0]), mpmt::protocol_exc);
+        this->check_offsets(0);
+    }
+}
@@ -0,0 +1,156 @@
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "core/ring/rvector.hpp"
+
+/**
+ * @brief   rvector<ring_k<K>>紧密存储的参考值测试
+ * @note    各运算与按K位掩码的uint64_t参考实现逐元素比较，并检查末字的填充位保持为0；
+ *          长度覆盖空向量、单元素、展开段（mc_CHUNK）边界两侧与多段。
+ */
+namespace
+{
+    const uint64_t c_SIZES[] = { 0, 1, 63, 64, 511, 512, 513, 5000 };
+
+    template <typename RK>
+    class rvector_packed_test : public ::testing::Test
+    {
+    protected:
+        using value_type = RK;
+        static constexpr uint64_t mc_MASK = RK::mc_MASK;
+
+        std::vector<uint64_t> random_reference(uint64_t n)
+        {
+            std::vector<uint64_t> ref(n);
+            for (uint64_t& v : ref)
+            {
+                v = m_gen() & mc_MASK;
+            }
+            return ref;
+        }
+
+        static mpmt::rvector<RK> make(const std::vector<uint64_t>& ref)
+        {
+            return mpmt::rvector<RK>(std::vector<RK>(ref.begin(), ref.end()));
+        }
+
+        /** @brief 逐元素与参考值比较，并检查填充位 */
+        static void expect_matches(const mpmt::rvector<RK>& vec, const std::vector<uint64_t>& ref)
+        {
+            ASSERT_EQ(vec.size(), ref.size());
+            for (uint64_t i = 0; i < ref.size(); ++i)
+            {
+                ASSERT_EQ(static_cast<uint64_t>(vec[i].value()), ref[i]) << "K=" << RK::mc_BITS << " index " << i << " of " << ref.size();
+            }
+            const uint64_t c_bits = ref.size() * RK::mc_BITS;
+            if (c_bits % 64 != 0)
+            {
+                EXPECT_EQ(vec.data()[c_bits / 64] >> (c_bits % 64), 0u) << "K=" << RK::mc_BITS << " padding of " << ref.size();
+            }
+        }
+
+        std::mt19937_64 m_gen{ 0x9ac4ed };
+    };
+
+    using ring_widths = ::testing::Types
+    <
+        mpmt::ring_k<1>, mpmt::ring_k<3>, mpmt::ring_k<8>, mpmt::ring_k<13>, mpmt::ring_k<16>,
+        mpmt::ring_k<31>, mpmt::ring_k<32>, mpmt::ring_k<40>, mpmt::ring_k<63>, mpmt::ring_k<64>
+    >;
+    TYPED_TEST_SUITE(rvector_packed_test, ring_widths);
+
+    TYPED_TEST(rvector_packed_test, arithmetic_matches_masked_reference)
+    {
+        using RK = TypeParam;
+        const uint64_t c_mask = RK::mc_MASK;
+        for (const uint64_t c_n : c_SIZES)
+        {
+            const std::vector<uint64_t> c_a = this->random_reference(c_n);
+            const std::vector<uint64_t> c_b = this->random_reference(c_n);
+            const uint64_t c_scalar = this->m_gen() & c_mask;
+            const mpmt::rvector<RK> c_vb = TestFixture::make(c_b);
+            std::vector<uint64_t> ref(c_n);
+
+            mpmt::rvector<RK> vec = TestFixture::make(c_a);
+            vec += c_vb;
+            for (uint64_t i = 0; i < c_n; ++i) { ref[i] = (c_a[i] + c_b[i]) & c_mask; }
+            TestFixture::expect_matches(vec, ref);
+
+            vec = TestFixture::make(c_a);
+            vec -= c_vb;
+            for (uint64_t i = 0; i < c_n; ++i) { ref[i] = (c_a[i] - c_b[i]) & c_mask; }
+            TestFixture::expect_matches(vec, ref);
+
+            vec = TestFixture::make(c_a);
+            vec *= c_vb;
+            for (uint64_t i = 0; i < c_n; ++i) { ref[i] = (c_a[i] * c_b[i]) & c_mask; }
+            TestFixture::expect_matches(vec, ref);
+
+            vec = TestFixture::make(c_a);
+            vec += RK(c_scalar);
+            for (uint64_t i = 0; i < c_n; ++i) { ref[i] = (c_a[i] + c_scalar) & c_mask; }
+            TestFixture::expect_matches(vec, ref);
+
+            vec = TestFixture::make(c_a);
+            vec -= RK(c_scalar);
+            for (uint64_t i = 0; i < c_n; ++i) { ref[i] = (c_a[i] - c_scalar) & c_mask; }
+            TestFixture::expect_matches(vec, ref);
+
+            vec = TestFixture::make(c_a);
+            vec *= RK(c_scalar);
+            for (uint64_t i = 0; i < c_n; ++i) { ref[i] = (c_a[i] * c_scalar) & c_mask; }
+            TestFixture::expect_matches(vec, ref);
+
+            uint64_t sum = 0;
+            for (const uint64_t v : c_a) { sum += v; }
+            EXPECT_EQ(static_cast<uint64_t>(TestFixture::make(c_a).reduce().value()), sum & c_mask) << "reduce of " << c_n;
+        }
+    }
+
+    TYPED_TEST(rvector_packed_test, fill_copy_set_and_equality)
+    {
+        using RK = TypeParam;
+        for (const uint64_t c_n : c_SIZES)
+        {
+            // 初值超出K位时截取低K位，填充位不被置位
+            const mpmt::rvector<RK> c_filled(c_n, RK(~0ULL));
+            TestFixture::expect_matches(c_filled, std::vector<uint64_t>(c_n, RK::mc_MASK));
+            TestFixture::expect_matches(mpmt::rvector<RK>(c_n), std::vector<uint64_t>(c_n, 0));
+
+            const std::vector<uint64_t> c_a = this->random_reference(c_n);
+            const mpmt::rvector<RK> c_va = TestFixture::make(c_a);
+            TestFixture::expect_matches(c_va, c_a);
+
+            mpmt::rvector<RK> copy(c_va);
+            TestFixture::expect_matches(copy, c_a);
+            EXPECT_TRUE(copy == c_va);
+            mpmt::rvector<RK> assigned;
+            assigned = c_va;
+            EXPECT_TRUE(assigned == c_va);
+            const mpmt::rvector<RK> c_moved(std::move(assigned));
+            EXPECT_TRUE(c_moved == c_va);
+
+            // 逐元素改写：相邻元素不受影响，差一个元素即不相等
+            if (c_n != 0)
+            {
+                std::vector<uint64_t> ref = c_a;
+                for (uint64_t i = 0; i < c_n; i += 7)
+                {
+                    ref[i] = ~ref[i] & RK::mc_MASK;
+                    copy[i] = RK(ref[i]);
+                }
+                TestFixture::expect_matches(copy, ref);
+                EXPECT_TRUE(copy != c_va);
+                copy[0] = RK(c_a[0]);
+                for (uint64_t i = 7; i < c_n; i += 7)
+                {
+                    copy[i] = RK(c_a[i]);
+                }
+                EXPECT_TRUE(copy == c_va);
+            }
+            EXPECT_FALSE(c_va == mpmt::rvector<RK>(c_n + 1));
+        }
+    }
+}
@@ -0,0 +1,278 @@
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "core/encode/credential_ingest.hpp"
+#include "core/encode/set_layout.hpp"
+#include "core/exception/encode_exc.hpp"
+#include "core/hash/siphash_impl/hash_siphash.hpp"
+
+/**
+ * @brief   双重哈希下标、Bloom编码与Cuckoo布局测试
+ */
+namespace
+{
+    mpmt::hash_siphash::key_type test_key()
+    {
+        mpmt::hash_siphash::key_type key{};
+        for (uint64_t i = 0; i < key.size(); ++i)
+        {
+            key[i] = static_cast<uint8_t>(i * 0x3b + 0x11);
+        }
+        return key;
+    }
+
+    /** @brief 生成n个互不相同的凭据字符串，长度覆盖0-7字节尾部的各种情形 */
+    std::vector<std::string> credentials(const std::string& prefix, uint64_t n)
+    {
+        std::vector<std::string> out;
+        out.reserve(n);
+        for (uint64_t i = 0; i < n; ++i)
+        {
+            out.push_back(prefix + std::to_string(i) + std::string(i % 11, 'x'));
+        }
+        return out;
+    }
+
+    struct key_view
+    {
+        std::vector<const uint8_t*> m_keys;
+        std::vector<uint64_t> m_lens;
+
+        explicit key_view(const std::vector<std::string>& items)
+        {
+            for (const std::string& s : items)
+            {
+                m_keys.push_back(reinterpret_cast<const uint8_t*>(s.data()));
+                m_lens.push_back(s.size());
+            }
+        }
+    };
+
+    /** @brief SipHash参考实现的测试向量：密钥为00 01 ... 0f，消息为00 01 ... (len-1) */
+    TEST(hash_layout, siphash_reference_vectors)
+    {
+        mpmt::hash_siphash::key_type key{};
+        uint8_t message[15];
+        for (uint64_t i = 0; i < key.size(); ++i)
+        {
+            key[i] = static_cast<uint8_t>(i);
+        }
+        for (uint64_t i = 0; i < sizeof(message); ++i)
+        {
+            message[i] = static_cast<uint8_t>(i);
+        }
+        const mpmt::hash_siphash hasher(key);
+
+        EXPECT_EQ(hasher.hash(message, 0), 0x726fdb47dd0e0e31ULL);
+        EXPECT_EQ(hasher.hash(message, 15), 0xa129ca6149be45e5ULL);
+
+        uint64_t wide[2];
+        hasher.hash128(message, 0, wide);
+        EXPECT_EQ(wide[0], 0xe6a825ba047f81a3ULL);
+        EXPECT_EQ(wide[1], 0x930255c71472f66dULL);
+        hasher.hash128(message, 15, wide);
+        EXPECT_EQ(wide[0], 0x11a8b03399e99354ULL);
+        EXPECT_EQ(wide[1], 0xd9c3cf970fec087eULL);
+
+        // 批量路径与标量路径得到相同的参考值
+        const uint8_t* keys[2] = { message, message };
+        const uint64_t lens[2] = { 0, 15 };
+        uint64_t h64[2];
+        uint64_t h128[4];
+        hasher.hash_batch(keys, lens, 2, h64);
+        hasher.hash128_batch(keys, lens, 2, h128);
+        EXPECT_EQ(h64[0], 0x726fdb47dd0e0e31ULL);
+        EXPECT_EQ(h64[1], 0xa129ca6149be45e5ULL);
+        EXPECT_EQ(h128[2], 0x11a8b03399e99354ULL);
+        EXPECT_EQ(h128[3], 0xd9c3cf970fec087eULL);
+    }
+
+    TEST(hash_layout, batch_matches_scalar)
+    {
+        const mpmt::hash_siphash hasher(test_key());
+        const std::vector<std::string> c_items = credentials("user", 37);
+        const key_view c_view(c_items);
+        std::vector<uint64_t> h64(c_items.size());
+        std::vector<uint64_t> h128(2 * c_items.size());
+        hasher.hash_batch(c_view.m_keys.data(), c_view.m_lens.data(), c_items.size(), h64.data());
+        hasher.hash128_batch(c_view.m_keys.data(), c_view.m_lens.data(), c_items.size(), h128.data());
+        for (uint64_t i = 0; i < c_items.size(); ++i)
+        {
+            uint64_t wide[2];
+            hasher.hash128(c_view.m_keys[i], c_view.m_lens[i], wide);
+            EXPECT_EQ(h64[i], hasher.hash(c_view.m_keys[i], c_view.m_lens[i])) << "item " << i;
+            EXPECT_EQ(h128[2 * i], wide[0]) << "item " << i;
+            EXPECT_EQ(h128[2 * i + 1], wide[1]) << "item " << i;
+        }
+    }
+
+    TEST(hash_layout, indices_are_distinct_for_prime_slots)
+    {
+        const mpmt::hash_siphash hasher(test_key());
+        const std::vector<std::string> c_items = credentials("user", 2000);
+        const key_view c_view(c_items);
+        for (const uint64_t c_slots : { uint64_t(2), uint64_t(5), uint64_t(4099) })
+        {
+            const uint8_t c_k = static_cast<uint8_t>(std::min<uint64_t>(4, c_slots));
+            std::vector<uint64_t> idx(c_items.size() * c_k);
+            hasher.indices_batch(c_view.m_keys.data(), c_view.m_lens.data(), c_items.size(), c_k, c_slots, idx.data());
+            for (uint64_t i = 0; i < c_items.size(); ++i)
+            {
+                std::vector<uint64_t> own(idx.begin() + i * c_k, idx.begin() + (i + 1) * c_k);
+                for (const uint64_t c_slot : own)
+                {
+                    ASSERT_LT(c_slot, c_slots);
+                }
+                std::sort(own.begin(), own.end());
+                EXPECT_EQ(std::adjacent_find(own.begin(), own.end()), own.end()) << "m=" << c_slots << " item " << i;
+            }
+        }
+    }
+
+    TEST(hash_layout, single_slot_maps_to_zero)
+    {
+        const mpmt::hash_siphash hasher(test_key());
+        const std::string c_item = "alice";
+        const uint8_t* key = reinterpret_cast<const uint8_t*>(c_item.data());
+        const uint64_t c_len = c_item.size();
+        uint64_t idx[3] = { 7, 7, 7 };
+        hasher.indices_batch(&key, &c_len, 1, 3, 1, idx);
+        EXPECT_EQ(idx[0], 0u);
+        EXPECT_EQ(idx[1], 0u);
+        EXPECT_EQ(idx[2], 0u);
+    }
+
+    TEST(bloom_layout, members_always_hit_and_fpr_near_estimate)
+    {
+        const mpmt::hash_siphash hasher(test_key());
+        const uint64_t c_n = 2000;
+        const uint64_t c_slots = 20011;
+        const uint8_t c_k = mpmt::bloom_layout::optimal_hashes(c_n, c_slots);
+        EXPECT_EQ(c_k, 7);
+
+        const std::vector<std::string> c_members = credentials("member", c_n);
+        std::string csv;
+        for (const std::string& s : c_members)
+        {
+            csv += s + ",extra\r\n";
+        }
+        const mpmt::credential_ingest ingest({ c_slots, 1, c_k }, hasher);
+        const mpmt::slot_indicator c_bits = ingest.encode_buffer(csv.data(), csv.size());
+
+        std::vector<uint64_t> slots(c_k);
+        for (const std::string& s : c_members)
+        {
+            ingest.slots_of(s.data(), s.size(), slots.data());
+            for (const uint64_t c_slot : slots)
+            {
+                ASSERT_TRUE(c_bits.test(c_slot)) << s;
+            }
+        }
+
+        const std::vector<std::string> c_others = credentials("outsider", 20000);
+        uint64_t hits = 0;
+        for (const std::string& s : c_others)
+        {
+            ingest.slots_of(s.data(), s.size(), slots.data());
+            hits += std::all_of(slots.begin(), slots.end(), [&](uint64_t slot) { return c_bits.test(slot); }) ? 1 : 0;
+        }
+        const double c_expected = mpmt::bloom_layout::expected_fpr(c_n, c_slots, c_k);
+        const double c_observed = static_cast<double>(hits) / c_others.size();
+        EXPECT_LT(c_observed, 3.0 * c_expected + 0.002);
+    }
+
+    TEST(bloom_layout, last_line_without_newline_stays_in_range)
+    {
+        const mpmt::hash_siphash hasher(test_key());
+        const mpmt::credential_ingest ingest({ 1024, 1, 3 }, hasher);
+
+        // 只传入"alice\nbob"的前缀，末行无换行符；区间之后的字节不得被读入
+        const std::string c_buffer = "alice\nbob\ncarol";
+        const mpmt::slot_indicator c_bits = ingest.encode_buffer(c_buffer.data(), 9);
+        std::vector<uint64_t> slots(3);
+        for (const std::string c_member : { "alice", "bob" })
+        {
+            ingest.slots_of(c_member.data(), c_member.size(), slots.data());
+            for (const uint64_t c_slot : slots)
+            {
+                EXPECT_TRUE(c_bits.test(c_slot)) << c_member;
+            }
+        }
+        const mpmt::slot_indicator c_both = ingest.encode_buffer("alice\nbob", 9);
+        EXPECT_EQ(c_bits.count(), c_both.count());
+    }
+
+    TEST(bloom_layout, degenerate_parameters)
+    {
+        EXPECT_EQ(mpmt::bloom_layout::expected_fpr(10, 0, 3), 1.0);
+        EXPECT_EQ(mpmt::bloom_layout::expected_fpr(10, 100, 0), 1.0);
+        EXPECT_EQ(mpmt::bloom_layout::expected_fpr(0, 100, 3), 0.0);
+        EXPECT_EQ(mpmt::bloom_layout::optimal_hashes(0, 100), 1);
+        EXPECT_EQ(mpmt::bloom_layout::optimal_hashes(1000, 10), 1);
+        EXPECT_EQ(mpmt::bloom_layout::optimal_hashes(1, 1000), 64);
+    }
+
+    template <typename RT>
+    class cuckoo_layout_test : public ::testing::Test
+    {};
+
+    using cuckoo_rings = ::testing::Types<mpmt::ring8, mpmt::ring16, mpmt::ring32, mpmt::ring64>;
+    TYPED_TEST_SUITE(cuckoo_layout_test, cuckoo_rings);
+
+    TYPED_TEST(cuckoo_layout_test, members_found_in_candidate_slots)
+    {
+        using RT = TypeParam;
+        const mpmt::hash_siphash hasher(test_key());
+        const uint64_t c_n = 3000;
+        const mpmt::cuckoo_layout<RT> c_layout({ 4099, 3, 500 }, hasher);
+        const std::vector<std::string> c_members = credentials("member", c_n);
+        const key_view c_view(c_members);
+        const mpmt::rvector<RT> c_table = c_layout.encode(c_view.m_keys.data(), c_view.m_lens.data(), c_n);
+        ASSERT_EQ(c_table.size(), 4099u);
+
+        uint64_t occupied = 0;
+        for (uint64_t s = 0; s < c_table.size(); ++s)
+        {
+            occupied += (c_table.data()[s] != RT(0)) ? 1 : 0;
+        }
+        EXPECT_EQ(occupied, c_n);
+
+        uint64_t slots[3];
+        for (uint64_t i = 0; i < c_n; ++i)
+        {
+            const RT c_fp = c_layout.locate(c_view.m_keys[i], c_view.m_lens[i], slots);
+            ASSERT_NE(c_fp, RT(0));
+            EXPECT_TRUE
+            (
+                c_table.data()[slots[0]] == c_fp || c_table.data()[slots[1]] == c_fp || c_table.data()[slots[2]] == c_fp
+            ) << "member " << i;
+        }
+
+        // 非成员的误判率不应明显超过估计值（ring8下估计值较大）
+        const std::vector<std::string> c_others = credentials("outsider", 5000);
+        uint64_t hits = 0;
+        for (const std::string& s : c_others)
+        {
+            const RT c_fp = c_layout.locate(reinterpret_cast<const uint8_t*>(s.data()), s.size(), slots);
+            hits += (c_table.data()[slots[0]] == c_fp || c_table.data()[slots[1]] == c_fp || c_table.data()[slots[2]] == c_fp) ? 1 : 0;
+        }
+        EXPECT_LE(static_cast<double>(hits) / c_others.size(), 2.0 * c_layout.expected_fpr(c_n) + 0.002);
+    }
+
+    TYPED_TEST(cuckoo_layout_test, rejects_invalid_configuration_and_overload)
+    {
+        using RT = TypeParam;
+        const mpmt::hash_siphash hasher(test_key());
+        EXPECT_THROW((mpmt::cuckoo_layout<RT>({ 0, 2, 10 }, hasher)), mpmt::encode_exc);
+        EXPECT_THROW((mpmt::cuckoo_layout<RT>({ 16, 1, 10 }, hasher)), mpmt::encode_exc);
+
+        const mpmt::cuckoo_layout<RT> c_layout({ 16, 2, 10 }, hasher);
+        const std::vector<std::string> c_items = credentials("member", 17);
+        const key_view c_view(c_items);
+        EXPECT_THROW(c_layout.encode(c_view.m_keys.data(), c_view.m_lens.data(), c_items.size()), mpmt::encode_exc);
+    }
+}
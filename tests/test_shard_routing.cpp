@@ -0,0 +1,186 @@
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include "core/comm/inproc_impl/comm_inproc.hpp"
+#include "core/comm/pipe_impl/comm_pipe.hpp"
+#include "core/exception/comm_exc.hpp"
+#include "core/protocol/ass_impl/ass_wire.hpp"
+#include "core/protocol/ass_impl/open_queue.hpp"
+#include "core/protocol/ass_impl/shard_map.hpp"
+#include "sim/local_sim.hpp"
+
+/**
+ * @brief   分片部署测试：open_queue只联系持有查询槽位的代理方对，comm_pipe跨进程收发，
+ *          分片代理方对以子进程运行时的端到端结果与进程内模拟一致
+ */
+namespace
+{
+    using ring = mpmt::ring32;
+
+    TEST(shard_routing, skips_pairs_without_queried_slots)
+    {
+        const uint32_t c_shards = 3;
+        const mpmt::shard_map c_map(300, c_shards);
+        std::vector<std::unique_ptr<mpmt::comm_inproc<ring>>> q_side, agent_side;
+        std::vector<mpmt::comm_adapter<ring>*> to_as0, to_as1;
+        for (uint32_t i = 0; i < 2 * c_shards; ++i)
+        {
+            auto pair = mpmt::comm_inproc<ring>::make_pair();
+            q_side.push_back(std::move(pair.first));
+            agent_side.push_back(std::move(pair.second));
+            (i < c_shards ? to_as0 : to_as1).push_back(q_side.back().get());
+        }
+
+        // 全部槽位只落在分片1
+        mpmt::open_queue<ring> queue(c_map, to_as0, to_as1);
+        const uint64_t c_first = c_map.first(1);
+        const auto c_ticket = queue.defer({ c_first + 1, c_first + 5 });
+        queue.send();
+
+        std::vector<ring> message;
+        for (uint32_t s = 0; s < c_shards; ++s)
+        {
+            for (const uint32_t c_end : { s, c_shards + s })
+            {
+                const bool c_received = agent_side[c_end]->try_receive(message, [] {});
+                EXPECT_EQ(c_received, s == 1) << "shard " << s;
+                if (c_received)
+                {
+                    EXPECT_EQ(mpmt::ass_wire::unpack_token(message), queue.token(1));
+                    agent_side[c_end]->send(std::vector<ring>{ 1, 0 });
+                }
+            }
+        }
+        queue.receive();
+        EXPECT_EQ(queue.counts(c_ticket), (std::vector<ring>{ 2, 0 }));
+    }
+
+    TEST(comm_pipe, round_trips_across_processes)
+    {
+        auto [parent, child] = mpmt::comm_pipe<uint64_t>::make_pair();
+        const pid_t c_pid = ::fork();
+        ASSERT_GE(c_pid, 0);
+        if (c_pid == 0)
+        {
+            // 子进程：回显每条报文（逐元素加1），直至对端断开
+            parent.reset();
+            int status = 0;
+            try
+            {
+                for (;;)
+                {
+                    std::vector<uint64_t> message;
+                    child->receive(message);
+                    for (uint64_t& v : message)
+                    {
+                        ++v;
+                    }
+                    child->send(message);
+                }
+            }
+            catch (const mpmt::comm_exc& e)
+            {
+                status = e.get_exc_type() == mpmt::comm_exc::exc_type::CONNECTION_CLOSED ? 0 : 1;
+            }
+            ::_exit(status);
+        }
+        child.reset();
+
+        // 大于套接字缓冲区的报文检验部分读写
+        for (const uint64_t c_n : { 0ULL, 1ULL, 3ULL, 1ULL << 20 })
+        {
+            std::vector<uint64_t> sent(c_n);
+            for (uint64_t i = 0; i < c_n; ++i)
+            {
+                sent[i] = i * 0x9e3779b97f4a7c15ULL;
+            }
+            parent->send(sent);
+            std::vector<uint64_t> echoed;
+            parent->receive(echoed);
+            ASSERT_EQ(echoed.size(), c_n);
+            for (uint64_t i = 0; i < c_n; ++i)
+            {
+                ASSERT_EQ(echoed[i], sent[i] + 1);
+            }
+        }
+        parent->send(uint64_t{ 41 });
+        uint64_t value = 0;
+        parent->receive(value);
+        EXPECT_EQ(value, 42u);
+
+        parent->disconnect();
+        std::vector<uint64_t> tail;
+        EXPECT_THROW(parent->receive(tail), mpmt::comm_exc);
+        int status = -1;
+        ASSERT_EQ(::waitpid(c_pid, &status, 0), c_pid);
+        EXPECT_TRUE(WIFEXITED(status));
+        EXPECT_EQ(WEXITSTATUS(status), 0);
+    }
+
+    mpmt::local_sim::config sim_config(uint32_t shards, uint64_t batch, uint8_t ring_bits)
+    {
+        mpmt::local_sim::config cfg{};
+        cfg.m_num_holders = 6;
+        cfg.m_set_size = 50;
+        cfg.m_num_slots = 1031;
+        cfg.m_num_hashes = 3;
+        cfg.m_ring_bits = ring_bits;
+        cfg.m_num_queries = 40;
+        cfg.m_ingest_threads = 1;
+        cfg.m_num_shards = shards;
+        cfg.m_open_batch = batch;
+        return cfg;
+    }
+
+    TEST(shard_processes, match_the_in_process_simulation)
+    {
+        for (const uint8_t c_bits : { 8, 32 })
+        {
+            for (const uint64_t c_batch : { 1, 6 })
+            {
+                mpmt::local_sim::config cfg = sim_config(4, c_batch, c_bits);
+                const mpmt::local_sim::report c_local = mpmt::local_sim(cfg).run();
+                cfg.m_shard_processes = true;
+                const mpmt::local_sim::report c_forked = mpmt::local_sim(cfg).run();
+
+                EXPECT_EQ(c_forked.m_false_negatives, 0u);
+                EXPECT_EQ(c_forked.m_true_positives, c_local.m_true_positives);
+                EXPECT_EQ(c_forked.m_false_positives, c_local.m_false_positives);
+                EXPECT_EQ(c_forked.m_true_negatives, c_local.m_true_negatives);
+                EXPECT_EQ(c_forked.m_rounds, c_local.m_rounds);
+                EXPECT_EQ(c_forked.m_holder_upload_bytes, c_local.m_holder_upload_bytes);
+            }
+        }
+    }
+
+    TEST(shard_processes, relay_trees_over_pipes_match_the_in_process_simulation)
+    {
+        // 6个持有方、扇入2：每侧两层中继，代理方只与树根一层的2个节点相连
+        for (const uint32_t c_shards : { 1, 3 })
+        {
+            mpmt::local_sim::config cfg = sim_config(c_shards, 1, 16);
+            cfg.m_relay_fanin = 2;
+            const mpmt::local_sim::report c_local = mpmt::local_sim(cfg).run();
+            cfg.m_shard_processes = true;
+            const mpmt::local_sim::report c_forked = mpmt::local_sim(cfg).run();
+
+            EXPECT_EQ(c_forked.m_false_negatives, 0u);
+            EXPECT_EQ(c_forked.m_true_positives, c_local.m_true_positives);
+            EXPECT_EQ(c_forked.m_false_positives, c_local.m_false_positives);
+            EXPECT_EQ(c_forked.m_true_negatives, c_local.m_true_negatives);
+            EXPECT_EQ(c_forked.m_num_relays, c_local.m_num_relays);
+            EXPECT_GT(c_forked.m_num_relays, 0u);
+            EXPECT_EQ(c_forked.m_holder_upload_bytes, c_local.m_holder_upload_bytes);
+            EXPECT_EQ(c_forked.m_agent_ingress_bytes, c_local.m_agent_ingress_bytes);
+            EXPECT_LT(c_forked.m_agent_ingress_bytes, c_forked.m_holder_upload_bytes);
+        }
+    }
+}
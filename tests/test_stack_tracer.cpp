@@ -0,0 +1,110 @@
+#include <csignal>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "auxkit/stack_tracer.hpp"
+
+/**
+ * @brief   调用栈采集、符号化与致命信号处理测试
+ * @note    信号处理以死亡测试验证：子进程中触发信号，检查输出并确认进程仍按原信号终止。
+ */
+namespace
+{
+    TEST(stack_tracer, capture_and_symbolize_agree)
+    {
+        utils::stack_tracer::trace tr;
+        const uint32_t c_frames = utils::stack_tracer::capture(tr);
+        ASSERT_GT(c_frames, 1u);
+        EXPECT_EQ(c_frames, tr.m_size);
+
+        const std::vector<std::string> c_lines = utils::stack_tracer::symbolize(tr);
+        ASSERT_EQ(c_lines.size(), tr.m_size);
+        bool demangled = false;
+        for (const std::string& line : c_lines)
+        {
+            EXPECT_FALSE(line.empty());
+            demangled = demangled || line.find("testing::") != std::string::npos;
+        }
+        // 调用方链上有GoogleTest的函数，以-rdynamic链接时应解析出其还原后的名称
+        EXPECT_TRUE(demangled);
+
+        utils::stack_tracer::trace shorter;
+        EXPECT_EQ(utils::stack_tracer::capture(shorter, 1) + 1, c_frames);
+    }
+
+#if defined(__linux__)
+    /** @brief 每层占用一个4KB的栈帧，直到栈溢出 */
+    uint64_t overflow(uint64_t depth)
+    {
+        volatile char frame[4096];
+        frame[0] = static_cast<char>(depth);
+        if (depth == ~0ULL)
+        {
+            return frame[0];
+        }
+        return overflow(depth + 1) + static_cast<uint64_t>(frame[0]);
+    }
+
+    TEST(stack_tracer_death, crash_handler_reports_and_keeps_the_signal)
+    {
+        ::testing::FLAGS_gtest_death_test_style = "threadsafe";
+        EXPECT_EXIT
+        (
+            {
+                utils::stack_tracer::install_crash_handlers();
+                std::raise(SIGSEGV);
+            },
+            ::testing::KilledBySignal(SIGSEGV),
+            "Fatal SIGSEGV.*\nRaw stack trace"
+        );
+    }
+
+    TEST(stack_tracer_death, worker_thread_stack_overflow_is_reported)
+    {
+        ::testing::FLAGS_gtest_death_test_style = "threadsafe";
+        EXPECT_EXIT
+        (
+            {
+                utils::stack_tracer::install_crash_handlers();
+                std::thread worker([]
+                {
+                    if (utils::stack_tracer::install_thread_alt_stack())
+                    {
+                        overflow(0);
+                    }
+                });
+                worker.join();
+            },
+            ::testing::KilledBySignal(SIGSEGV),
+            "Fatal SIGSEGV at address"
+        );
+    }
+
+    TEST(stack_tracer, each_thread_installs_its_own_alt_stack)
+    {
+        ASSERT_TRUE(utils::stack_tracer::install_crash_handlers());
+        stack_t own{};
+        ASSERT_EQ(sigaltstack(nullptr, &own), 0);
+        ASSERT_EQ(own.ss_flags & SS_DISABLE, 0);
+
+        // 工作线程起初没有备用信号栈，设置后得到独立的一块；线程反复创建与退出时随之撤销与释放
+        for (int round = 0; round < 4; ++round)
+        {
+            std::thread worker([&own]
+            {
+                stack_t ss{};
+                ASSERT_EQ(sigaltstack(nullptr, &ss), 0);
+                EXPECT_NE(ss.ss_flags & SS_DISABLE, 0);
+                ASSERT_TRUE(utils::stack_tracer::install_thread_alt_stack());
+                ASSERT_EQ(sigaltstack(nullptr, &ss), 0);
+                EXPECT_EQ(ss.ss_flags & SS_DISABLE, 0);
+                EXPECT_NE(ss.ss_sp, own.ss_sp);
+            });
+            worker.join();
+        }
+    }
+#endif
+}